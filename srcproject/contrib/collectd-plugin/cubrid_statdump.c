@@ -137,6 +137,17 @@ cubrid_statdump_read ()
   /* Execution statistics for network communication */
   value_t net_num_requests[1];
 
+  /* Latency histograms */
+  MNT_LAT_STATS lat_stats;
+  MNT_LAT_HISTOGRAM *histogram;
+  char lat_name[DATA_MAX_NAME_LEN];
+  value_t lat_count[1];
+  value_t lat_avg[1];
+  value_t lat_p50[1];
+  value_t lat_p99[1];
+  value_t lat_max[1];
+  int i;
+
   MNT_SERVER_EXEC_GLOBAL_STATS *mystat;
   mystat = malloc (sizeof (MNT_SERVER_EXEC_GLOBAL_STATS));
 
@@ -277,6 +288,29 @@ cubrid_statdump_read ()
 
   submit ("net_num_requests", submit_name, net_num_requests, 1);
 
+  if (mnt_server_copy_latency_stats (&lat_stats) == NO_ERROR)
+    {
+      for (i = 0; i < lat_stats.num_histograms; i++)
+	{
+	  histogram = &lat_stats.histograms[i];
+	  snprintf (lat_name, sizeof (lat_name), "%s_%s", submit_name,
+		    histogram->name);
+
+	  lat_count[0].gauge = histogram->count;
+	  lat_avg[0].gauge = histogram->total_usec / histogram->count;
+	  lat_p50[0].gauge = mnt_lat_percentile (histogram, 50);
+	  lat_p99[0].gauge = mnt_lat_percentile (histogram, 99);
+	  lat_max[0].gauge = histogram->max_usec;
+
+	  submit ("latency_count", lat_name, lat_count, 1);
+	  submit ("latency_avg_usec", lat_name, lat_avg, 1);
+	  submit ("latency_p50_usec", lat_name, lat_p50, 1);
+	  submit ("latency_p99_usec", lat_name, lat_p99, 1);
+	  submit ("latency_max_usec", lat_name, lat_max, 1);
+	}
+      mnt_lat_free_stats (&lat_stats);
+    }
+
   histo_clear_global_stats ();
   histo_stop ();
   free (mystat);
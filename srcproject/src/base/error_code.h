@@ -1291,7 +1291,9 @@
 
 #define S2S_CONN_UNEXPECT_DATATYPE                  -1040
 
-#define ER_LAST_ERROR                               -1041
+#define ER_QPROC_ASYNC_CLIENT_TIMEOUT               -1041
+
+#define ER_LAST_ERROR                               -1042
 
 
 /*
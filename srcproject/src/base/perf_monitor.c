@@ -58,6 +58,7 @@
 
 #include "thread_impl.h"
 #include "log_impl.h"
+#include "object_representation.h"
 
 #if !defined(CS_MODE)
 #include <string.h>
@@ -72,6 +73,8 @@
 #include "thread_impl.h"
 #include "connection_error.h"
 #endif /* SERVER_MODE */
+#include "critical_section.h"
+#include "network.h"
 
 #if !defined(SERVER_MODE)
 #undef MUTEX_INIT
@@ -276,6 +279,7 @@ void
 mnt_print_global_stats (FILE * stream)
 {
   MNT_SERVER_EXEC_GLOBAL_STATS *stats;
+  MNT_LAT_STATS lat_stats;
 
   if (stream == NULL)
     stream = stdout;
@@ -284,6 +288,12 @@ mnt_print_global_stats (FILE * stream)
   if (stats != NULL)
     {
       mnt_server_dump_global_stats (stats, stream);
+
+      if (mnt_server_copy_latency_stats (&lat_stats) == NO_ERROR)
+	{
+	  mnt_lat_dump_stats (&lat_stats, stream);
+	  mnt_lat_free_stats (&lat_stats);
+	}
     }
 }
 #endif /* CS_MODE || SA_MODE */
@@ -1417,6 +1427,22 @@ static const char *mnt_Stats_name[MNT_SIZE_OF_SERVER_EXEC_STATS] = {
   "Num_adaptive_flush_pages",
   "Num_adaptive_flush_log_pages",
   "Num_adaptive_flush_max_pages",
+  "Num_data_page_hash_opt_hits",
+  "Num_data_page_hash_opt_retries",
+  "Num_data_page_hash_opt_fallbacks",
+  "Num_data_page_lru_victims",
+  "Num_data_page_lru_steals",
+  "Num_data_page_lru_victim_search",
+  "Num_data_page_prefetch_requests",
+  "Num_data_page_prefetch_reads",
+  "Num_deadlock_detected_within_1ms",
+  "Num_deadlock_detected_within_10ms",
+  "Num_deadlock_detected_within_100ms",
+  "Num_deadlock_detected_within_1s",
+  "Num_deadlock_detected_over_1s",
+  "Num_sort_parallel_runs",
+  "Num_query_parallel_scans",
+  "Num_query_spill_pages",
   "Data_page_buffer_hit_ratio"
 };
 
@@ -1458,6 +1484,20 @@ static struct mnt_server_table mnt_Server_table = {
    0,
    /* flush control statistics */
    0, 0, 0,
+   /* page buffer hash chain lookup */
+   0, 0, 0,
+   /* page buffer LRU shard victim selection */
+   0, 0, 0,
+   /* page buffer read-ahead */
+   0, 0,
+   /* Deadlock time-to-detect histogram */
+   0, 0, 0, 0, 0,
+   /* Sort statistics */
+   0,
+   /* Parallel scan */
+   0,
+   /* Query work memory */
+   0,
    /* other statistics */
    0}
 #if defined (SERVER_MODE)
@@ -1465,6 +1505,48 @@ static struct mnt_server_table mnt_Server_table = {
 #endif /* SERVER_MODE */
 };
 
+/*
+ * Latency histograms on the server
+ *
+ * Every histogram is replicated into MNT_LAT_NUM_SLOTS slots and a thread
+ * records into the slot of its thread index, so concurrent waiters seldom
+ * touch the same cache lines. Updates are atomic since two threads may
+ * still share a slot. The slots are summed only when somebody reads them.
+ */
+#if defined (SERVER_MODE)
+#define MNT_LAT_NUM_SLOTS       16
+#else /* SERVER_MODE */
+#define MNT_LAT_NUM_SLOTS       1
+#endif /* SERVER_MODE */
+#define MNT_LAT_CACHE_LINE_SIZE 64
+
+/* csect waits keep one more histogram for sections outside css_Csect_array */
+#define MNT_LAT_NUM_CSECTS      (CSECT_LAST + 1)
+#define MNT_LAT_NUM_HISTOGRAMS \
+  (MNT_LAT_CSECT_WAIT + MNT_LAT_NUM_CSECTS + NET_SERVER_REQUEST_END)
+
+typedef struct mnt_lat_counter MNT_LAT_COUNTER;
+struct mnt_lat_counter
+{
+  UINT64 count;
+  UINT64 total_usec;
+  UINT64 max_usec;
+  UINT64 pad[5];		/* fill up the first cache line */
+  UINT64 buckets[MNT_LAT_NUM_BUCKETS];
+};
+
+/* the slots are never freed: recording threads do not synchronize with
+ * mnt_server_final () */
+static char *mnt_Lat_area = NULL;
+static MNT_LAT_COUNTER *mnt_Lat_slots[MNT_LAT_NUM_SLOTS];
+static const char *mnt_Lat_names[MNT_LAT_NUM_HISTOGRAMS];
+
+static void mnt_lat_init (void);
+static int mnt_lat_index (MNT_LAT_KIND kind, int id);
+static int mnt_lat_bucket (UINT64 usec);
+static void mnt_lat_reset (void);
+static void mnt_lat_get_name (int index, char *buf, int size);
+
 
 /*
  * mnt_server_init - Initialize monitoring resources in the server
@@ -1503,6 +1585,8 @@ mnt_server_init (int num_tran_indices)
     }
   mnt_Server_table.num_tran_indices = num_tran_indices;
   mnt_Num_tran_exec_stats = 0;
+
+  mnt_lat_init ();
   MUTEX_UNLOCK (mnt_Server_table.lock);
 
   return NO_ERROR;
@@ -1628,13 +1712,29 @@ void
 xmnt_server_stop_stats (THREAD_ENTRY * thread_p)
 {
   int tran_index;
-#if defined (SERVER_MODE)
-  int rv;
-#endif /* SERVER_MODE */
 
   tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
   assert (tran_index >= 0);
 
+  mnt_server_stop_tran_stats (tran_index);
+}
+
+/*
+ * mnt_server_stop_tran_stats - Stop collecting server execution statistics
+ *                              for the given transaction index
+ *   return: none
+ *   tran_index(in): transaction index
+ *
+ * Note: Used to release the statistics of a transaction whose client went
+ *       away without stopping them.
+ */
+void
+mnt_server_stop_tran_stats (int tran_index)
+{
+#if defined (SERVER_MODE)
+  int rv;
+#endif /* SERVER_MODE */
+
   MUTEX_LOCK (rv, mnt_Server_table.lock);
   if (mnt_Server_table.num_tran_indices > tran_index
       && mnt_Server_table.stats[tran_index] != NULL)
@@ -1739,6 +1839,29 @@ mnt_server_reflect_local_stats (THREAD_ENTRY * thread_p)
 
   global_stats->net_num_requests += p->net_num_requests;
 
+  global_stats->qm_num_spill_pages += p->qm_num_spill_pages;
+
+  global_stats->qm_num_parallel_scans += p->qm_num_parallel_scans;
+
+  global_stats->sort_num_parallel_runs += p->sort_num_parallel_runs;
+
+  global_stats->lk_num_dl_detect_1ms += p->lk_num_dl_detect_1ms;
+  global_stats->lk_num_dl_detect_10ms += p->lk_num_dl_detect_10ms;
+  global_stats->lk_num_dl_detect_100ms += p->lk_num_dl_detect_100ms;
+  global_stats->lk_num_dl_detect_1s += p->lk_num_dl_detect_1s;
+  global_stats->lk_num_dl_detect_over_1s += p->lk_num_dl_detect_over_1s;
+
+  global_stats->pb_num_prefetch_requests += p->pb_num_prefetch_requests;
+  global_stats->pb_num_prefetch_reads += p->pb_num_prefetch_reads;
+
+  global_stats->pb_num_lru_victims += p->pb_num_lru_victims;
+  global_stats->pb_num_lru_steals += p->pb_num_lru_steals;
+  global_stats->pb_num_lru_victim_search += p->pb_num_lru_victim_search;
+
+  global_stats->pb_num_hash_opt_hits += p->pb_num_hash_opt_hits;
+  global_stats->pb_num_hash_opt_retries += p->pb_num_hash_opt_retries;
+  global_stats->pb_num_hash_opt_fallbacks += p->pb_num_hash_opt_fallbacks;
+
   mnt_server_calc_stats (p);
   mnt_server_check_stats_threshold (LOG_FIND_THREAD_TRAN_INDEX (thread_p), p);
   mnt_server_reset_stats_internal (p);
@@ -1932,6 +2055,29 @@ xmnt_server_copy_global_stats (THREAD_ENTRY * thread_p,
 
       global_stats->net_num_requests += p->net_num_requests;
 
+      global_stats->qm_num_spill_pages += p->qm_num_spill_pages;
+
+      global_stats->qm_num_parallel_scans += p->qm_num_parallel_scans;
+
+      global_stats->sort_num_parallel_runs += p->sort_num_parallel_runs;
+
+      global_stats->lk_num_dl_detect_1ms += p->lk_num_dl_detect_1ms;
+      global_stats->lk_num_dl_detect_10ms += p->lk_num_dl_detect_10ms;
+      global_stats->lk_num_dl_detect_100ms += p->lk_num_dl_detect_100ms;
+      global_stats->lk_num_dl_detect_1s += p->lk_num_dl_detect_1s;
+      global_stats->lk_num_dl_detect_over_1s += p->lk_num_dl_detect_over_1s;
+
+      global_stats->pb_num_prefetch_requests += p->pb_num_prefetch_requests;
+      global_stats->pb_num_prefetch_reads += p->pb_num_prefetch_reads;
+
+      global_stats->pb_num_lru_victims += p->pb_num_lru_victims;
+      global_stats->pb_num_lru_steals += p->pb_num_lru_steals;
+      global_stats->pb_num_lru_victim_search += p->pb_num_lru_victim_search;
+
+      global_stats->pb_num_hash_opt_hits += p->pb_num_hash_opt_hits;
+      global_stats->pb_num_hash_opt_retries += p->pb_num_hash_opt_retries;
+      global_stats->pb_num_hash_opt_fallbacks += p->pb_num_hash_opt_fallbacks;
+
       mnt_server_calc_stats (p);
       mnt_server_check_stats_threshold (i, p);
       mnt_server_reset_stats_internal (p);
@@ -2036,6 +2182,29 @@ mnt_server_reset_stats_internal (MNT_SERVER_EXEC_STATS * stats)
 
   stats->net_num_requests = 0;
 
+  stats->qm_num_spill_pages = 0;
+
+  stats->qm_num_parallel_scans = 0;
+
+  stats->sort_num_parallel_runs = 0;
+
+  stats->lk_num_dl_detect_1ms = 0;
+  stats->lk_num_dl_detect_10ms = 0;
+  stats->lk_num_dl_detect_100ms = 0;
+  stats->lk_num_dl_detect_1s = 0;
+  stats->lk_num_dl_detect_over_1s = 0;
+
+  stats->pb_num_prefetch_requests = 0;
+  stats->pb_num_prefetch_reads = 0;
+
+  stats->pb_num_lru_victims = 0;
+  stats->pb_num_lru_steals = 0;
+  stats->pb_num_lru_victim_search = 0;
+
+  stats->pb_num_hash_opt_hits = 0;
+  stats->pb_num_hash_opt_retries = 0;
+  stats->pb_num_hash_opt_fallbacks = 0;
+
   stats->pb_hit_ratio = 0;
 }
 
@@ -2083,6 +2252,8 @@ xmnt_server_reset_global_stats (void)
 
   MUTEX_LOCK (rv, mnt_Server_table.lock);
 
+  mnt_lat_reset ();
+
   global_stats->file_num_creates = 0;
   global_stats->file_num_removes = 0;
   global_stats->file_num_ioreads = 0;
@@ -2142,6 +2313,29 @@ xmnt_server_reset_global_stats (void)
 
   global_stats->net_num_requests = 0;
 
+  global_stats->qm_num_spill_pages = 0;
+
+  global_stats->qm_num_parallel_scans = 0;
+
+  global_stats->sort_num_parallel_runs = 0;
+
+  global_stats->lk_num_dl_detect_1ms = 0;
+  global_stats->lk_num_dl_detect_10ms = 0;
+  global_stats->lk_num_dl_detect_100ms = 0;
+  global_stats->lk_num_dl_detect_1s = 0;
+  global_stats->lk_num_dl_detect_over_1s = 0;
+
+  global_stats->pb_num_prefetch_requests = 0;
+  global_stats->pb_num_prefetch_reads = 0;
+
+  global_stats->pb_num_lru_victims = 0;
+  global_stats->pb_num_lru_steals = 0;
+  global_stats->pb_num_lru_victim_search = 0;
+
+  global_stats->pb_num_hash_opt_hits = 0;
+  global_stats->pb_num_hash_opt_retries = 0;
+  global_stats->pb_num_hash_opt_fallbacks = 0;
+
   global_stats->pb_hit_ratio = 0;
 
   MUTEX_UNLOCK (mnt_Server_table.lock);
@@ -2236,12 +2430,14 @@ mnt_x_file_ioreads (THREAD_ENTRY * thread_p)
 }
 
 /*
- * mnt_x_file_iowrites - Increase file_num_iowrites counter of the current
+ * mnt_x_file_iowrites - Add the number of pages written to
+ *                    file_num_iowrites counter of the current
  *                    transaction index
  *   return: none
+ *   num_pages(in): number of pages written
  */
 void
-mnt_x_file_iowrites (THREAD_ENTRY * thread_p)
+mnt_x_file_iowrites (THREAD_ENTRY * thread_p, int num_pages)
 {
   MNT_SERVER_EXEC_STATS *stats;
 
@@ -2252,7 +2448,7 @@ mnt_x_file_iowrites (THREAD_ENTRY * thread_p)
        * We will suffer lost update for these counters.
        * You may use atomic operation instead.
        */
-      stats->file_num_iowrites++;
+      stats->file_num_iowrites += num_pages;
     }
 }
 
@@ -3177,75 +3373,926 @@ mnt_x_net_requests (THREAD_ENTRY * thread_p)
       stats->net_num_requests++;
     }
 }
-#endif /* SERVER_MODE || SA_MODE */
 
 /*
- * mnt_server_dump_stats - Print the given server statistics
+ * mnt_x_qm_spill_pages - Increase qm_num_spill_pages counter
+ *                        of the current transaction index
  *   return: none
- *   stats(in) server statistics to print
- *   stream(in): if NULL is given, stdout is used
  */
 void
-mnt_server_dump_stats (const MNT_SERVER_EXEC_STATS * stats, FILE * stream)
+mnt_x_qm_spill_pages (THREAD_ENTRY * thread_p)
 {
-  unsigned int i, *stats_ptr;
+  MNT_SERVER_EXEC_STATS *stats;
 
-  if (stream == NULL)
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
     {
-      stream = stdout;
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->qm_num_spill_pages++;
     }
+}
 
-  fprintf (stream, "\n *** SERVER EXECUTION STATISTICS *** \n");
+/*
+ * mnt_x_qm_parallel_scans - Increase qm_num_parallel_scans counter
+ *                           of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_qm_parallel_scans (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
 
-  stats_ptr = (unsigned int *) stats;
-  for (i = 0; i < MNT_SIZE_OF_SERVER_EXEC_STATS - 1; i++)
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
     {
-      if (mnt_Stats_name[i])
-	{
-	  fprintf (stream, "%-29s = %10u\n", mnt_Stats_name[i], *stats_ptr++);
-	}
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->qm_num_parallel_scans++;
     }
+}
 
-  fprintf (stream, "\n *** OTHER STATISTICS *** \n");
+/*
+ * mnt_x_sort_parallel_runs - Increase sort_num_parallel_runs counter
+ *                            of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_sort_parallel_runs (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
 
-  fprintf (stream, "Data_page_buffer_hit_ratio    = %10.2f\n",
-	   (float) stats->pb_hit_ratio / 100);
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->sort_num_parallel_runs++;
+    }
 }
 
 /*
- * mnt_server_dump_global_stats - Print the given server global statistics
+ * mnt_x_lk_dl_detect_1ms - Increase lk_num_dl_detect_1ms counter
+ *                          of the current transaction index
  *   return: none
- *   stats(in) server statistics to print
- *   stream(in): if NULL is given, stdout is used
  */
 void
-mnt_server_dump_global_stats (const MNT_SERVER_EXEC_GLOBAL_STATS * stats,
-			      FILE * stream)
+mnt_x_lk_dl_detect_1ms (THREAD_ENTRY * thread_p)
 {
-  unsigned int i;
-  UINT64 *stats_ptr;
+  MNT_SERVER_EXEC_STATS *stats;
 
-  if (stream == NULL)
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
     {
-      stream = stdout;
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->lk_num_dl_detect_1ms++;
     }
+}
 
-  fprintf (stream, "\n *** SERVER EXECUTION GLOBAL STATISTICS *** \n");
+/*
+ * mnt_x_lk_dl_detect_10ms - Increase lk_num_dl_detect_10ms counter
+ *                           of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_lk_dl_detect_10ms (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
 
-  stats_ptr = (UINT64 *) stats;
-  for (i = 0; i < MNT_SIZE_OF_SERVER_EXEC_GLOBAL_STATS - 1; i++)
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
     {
-      if (mnt_Stats_name[i])
-	{
-	  fprintf (stream, "%-29s = %10llu\n", mnt_Stats_name[i],
-		   (unsigned long long) *stats_ptr++);
-	}
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->lk_num_dl_detect_10ms++;
     }
+}
 
-  fprintf (stream, "\n *** OTHER STATISTICS *** \n");
+/*
+ * mnt_x_lk_dl_detect_100ms - Increase lk_num_dl_detect_100ms counter
+ *                            of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_lk_dl_detect_100ms (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
 
-  fprintf (stream, "Data_page_buffer_hit_ratio    = %10.2f\n",
-	   (float) stats->pb_hit_ratio / 100);
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->lk_num_dl_detect_100ms++;
+    }
+}
+
+/*
+ * mnt_x_lk_dl_detect_1s - Increase lk_num_dl_detect_1s counter
+ *                         of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_lk_dl_detect_1s (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
+
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->lk_num_dl_detect_1s++;
+    }
+}
+
+/*
+ * mnt_x_lk_dl_detect_over_1s - Increase lk_num_dl_detect_over_1s counter
+ *                              of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_lk_dl_detect_over_1s (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
+
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->lk_num_dl_detect_over_1s++;
+    }
+}
+
+/*
+ * mnt_x_pb_prefetch_requests - Increase pb_num_prefetch_requests counter
+ *                              of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_pb_prefetch_requests (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
+
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->pb_num_prefetch_requests++;
+    }
+}
+
+/*
+ * mnt_x_pb_prefetch_reads - Increase pb_num_prefetch_reads counter
+ *                           of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_pb_prefetch_reads (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
+
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->pb_num_prefetch_reads++;
+    }
+}
+
+/*
+ * mnt_x_pb_lru_victims - Increase pb_num_lru_victims counter
+ *                        of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_pb_lru_victims (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
+
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->pb_num_lru_victims++;
+    }
+}
+
+/*
+ * mnt_x_pb_lru_steals - Increase pb_num_lru_steals counter
+ *                       of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_pb_lru_steals (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
+
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->pb_num_lru_steals++;
+    }
+}
+
+/*
+ * mnt_x_pb_lru_victim_search - Add the number of BCBs examined while
+ *                              searching LRU victims to the current
+ *                              transaction index
+ *   return: none
+ *   num_bcbs(in): number of examined BCBs
+ */
+void
+mnt_x_pb_lru_victim_search (THREAD_ENTRY * thread_p, unsigned int num_bcbs)
+{
+  MNT_SERVER_EXEC_STATS *stats;
+
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      stats->pb_num_lru_victim_search += num_bcbs;
+    }
+}
+
+/*
+ * mnt_x_pb_hash_opt_hits - Increase pb_num_hash_opt_hits counter
+ *                          of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_pb_hash_opt_hits (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
+
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->pb_num_hash_opt_hits++;
+    }
+}
+
+/*
+ * mnt_x_pb_hash_opt_retries - Increase pb_num_hash_opt_retries counter
+ *                             of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_pb_hash_opt_retries (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
+
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->pb_num_hash_opt_retries++;
+    }
+}
+
+/*
+ * mnt_x_pb_hash_opt_fallbacks - Increase pb_num_hash_opt_fallbacks counter
+ *                               of the current transaction index
+ *   return: none
+ */
+void
+mnt_x_pb_hash_opt_fallbacks (THREAD_ENTRY * thread_p)
+{
+  MNT_SERVER_EXEC_STATS *stats;
+
+  stats = mnt_server_get_stats (thread_p);
+  if (stats != NULL)
+    {
+      /*
+       * We will suffer lost update for these counters.
+       * You may use atomic operation instead.
+       */
+      stats->pb_num_hash_opt_fallbacks++;
+    }
+}
+
+/*
+ * mnt_lat_init - Allocate the latency histogram slots
+ *   return: none
+ *
+ * Note: The caller holds mnt_Server_table.lock. On a second call the
+ *       histograms are only cleared.
+ */
+static void
+mnt_lat_init (void)
+{
+  size_t slot_size;
+  char *area;
+  int i;
+
+  if (mnt_Lat_area != NULL)
+    {
+      mnt_lat_reset ();
+      return;
+    }
+
+  slot_size = MNT_LAT_NUM_HISTOGRAMS * sizeof (MNT_LAT_COUNTER);
+  area = (char *) malloc (MNT_LAT_NUM_SLOTS * slot_size
+			  + MNT_LAT_CACHE_LINE_SIZE);
+  if (area == NULL)
+    {
+      /* histograms are not recorded */
+      return;
+    }
+
+  for (i = 0; i < MNT_LAT_NUM_SLOTS; i++)
+    {
+      mnt_Lat_slots[i] =
+	(MNT_LAT_COUNTER *) (PTR_ALIGN (area, MNT_LAT_CACHE_LINE_SIZE)
+			     + i * slot_size);
+    }
+  memset (mnt_Lat_slots[0], 0, MNT_LAT_NUM_SLOTS * slot_size);
+
+  MEMORY_BARRIER ();
+  mnt_Lat_area = area;
+}
+
+/*
+ * mnt_lat_reset - Clear all latency histograms
+ *   return: none
+ *
+ * Note: Events recorded while clearing may be partially lost.
+ */
+static void
+mnt_lat_reset (void)
+{
+  if (mnt_Lat_area != NULL)
+    {
+      memset (mnt_Lat_slots[0], 0,
+	      MNT_LAT_NUM_SLOTS * MNT_LAT_NUM_HISTOGRAMS
+	      * sizeof (MNT_LAT_COUNTER));
+    }
+}
+
+/*
+ * mnt_lat_index - Map a histogram kind and id to its position in a slot
+ *   return: histogram index, or -1 if there is none
+ *   kind(in):
+ *   id(in): CSECT_* index or NET_SERVER_* request, ignored otherwise
+ */
+static int
+mnt_lat_index (MNT_LAT_KIND kind, int id)
+{
+  switch (kind)
+    {
+    case MNT_LAT_CSECT_WAIT:
+      if (id < 0 || id >= CSECT_LAST)
+	{
+	  id = CSECT_LAST;
+	}
+      return MNT_LAT_CSECT_WAIT + id;
+
+    case MNT_LAT_NET_REQUEST:
+      if (id <= NET_SERVER_REQUEST_START || id >= NET_SERVER_REQUEST_END)
+	{
+	  return -1;
+	}
+      return MNT_LAT_CSECT_WAIT + MNT_LAT_NUM_CSECTS + id;
+
+    case MNT_LAT_PGBUF_FIX_WAIT:
+    case MNT_LAT_LOCK_WAIT:
+    case MNT_LAT_LOG_FLUSH:
+    case MNT_LAT_FILE_SYNC:
+      return kind;
+
+    default:
+      return -1;
+    }
+}
+
+/*
+ * mnt_lat_bucket - Find the log-linear bucket of a latency
+ *   return: bucket index
+ *   usec(in): latency in microseconds
+ */
+static int
+mnt_lat_bucket (UINT64 usec)
+{
+  int msb = 1;
+
+  if (usec < 2)
+    {
+      return (int) usec;
+    }
+
+  while ((usec >> (msb + 1)) != 0)
+    {
+      msb++;
+    }
+  if (msb >= MNT_LAT_NUM_BUCKETS / 2)
+    {
+      return MNT_LAT_NUM_BUCKETS - 1;
+    }
+
+  return 2 * msb + (int) ((usec >> (msb - 1)) & 1);
+}
+
+/*
+ * mnt_lat_set_name - Register the display name of a csect or request
+ *                    histogram
+ *   return: none
+ *   kind(in):
+ *   id(in):
+ *   name(in): static string
+ */
+void
+mnt_lat_set_name (MNT_LAT_KIND kind, int id, const char *name)
+{
+  int index;
+
+  index = mnt_lat_index (kind, id);
+  if (index >= 0 && (kind != MNT_LAT_CSECT_WAIT || id < CSECT_LAST))
+    {
+      mnt_Lat_names[index] = name;
+    }
+}
+
+/*
+ * mnt_lat_get_name - Make the display name of a histogram
+ *   return: none
+ *   index(in): histogram index
+ *   buf(out):
+ *   size(in): size of buf
+ */
+static void
+mnt_lat_get_name (int index, char *buf, int size)
+{
+  const char *name = mnt_Lat_names[index];
+  int id;
+
+  switch (index)
+    {
+    case MNT_LAT_PGBUF_FIX_WAIT:
+      snprintf (buf, size, "Page_fix_wait");
+      return;
+    case MNT_LAT_LOCK_WAIT:
+      snprintf (buf, size, "Lock_wait");
+      return;
+    case MNT_LAT_LOG_FLUSH:
+      snprintf (buf, size, "Log_flush");
+      return;
+    case MNT_LAT_FILE_SYNC:
+      snprintf (buf, size, "File_sync");
+      return;
+    default:
+      break;
+    }
+
+  id = index - MNT_LAT_CSECT_WAIT;
+  if (id < MNT_LAT_NUM_CSECTS)
+    {
+      snprintf (buf, size, "Csect_wait_%s",
+		(name != NULL) ? name : "OTHERS");
+      return;
+    }
+
+  id -= MNT_LAT_NUM_CSECTS;
+  if (name != NULL && strncmp (name, "NET_SERVER_", 11) == 0)
+    {
+      snprintf (buf, size, "Request_%s", name + 11);
+    }
+  else
+    {
+      snprintf (buf, size, "Request_%d", id);
+    }
+}
+
+/*
+ * mnt_lat_record - Add a wait or service time to a latency histogram
+ *   return: none
+ *   kind(in):
+ *   id(in): CSECT_* index or NET_SERVER_* request, ignored otherwise
+ *   start_time(in): when the wait started; it ends now
+ */
+void
+mnt_lat_record (THREAD_ENTRY * thread_p, MNT_LAT_KIND kind, int id,
+		const struct timeval *start_time)
+{
+  struct timeval end_time;
+  MNT_LAT_COUNTER *counter;
+  INT64 elapsed;
+  UINT64 usec, max_usec;
+  int index, slot = 0;
+
+  if (mnt_Lat_area == NULL)
+    {
+      return;
+    }
+
+  index = mnt_lat_index (kind, id);
+  if (index < 0)
+    {
+      return;
+    }
+
+  gettimeofday (&end_time, NULL);
+  elapsed = ((INT64) (end_time.tv_sec - start_time->tv_sec) * 1000000
+	     + (end_time.tv_usec - start_time->tv_usec));
+  usec = (elapsed > 0) ? (UINT64) elapsed : 0;
+
+#if defined (SERVER_MODE)
+  if (thread_p == NULL)
+    {
+      thread_p = thread_get_thread_entry_info ();
+    }
+  if (thread_p != NULL)
+    {
+      slot = thread_p->index % MNT_LAT_NUM_SLOTS;
+    }
+#endif /* SERVER_MODE */
+
+  counter = mnt_Lat_slots[slot] + index;
+  ATOMIC_INC_64 (&counter->count, 1);
+  ATOMIC_INC_64 (&counter->total_usec, usec);
+  ATOMIC_INC_64 (&counter->buckets[mnt_lat_bucket (usec)], 1);
+
+  max_usec = counter->max_usec;
+  while (usec > max_usec
+	 && !ATOMIC_CAS_64 (&counter->max_usec, max_usec, usec))
+    {
+      max_usec = counter->max_usec;
+    }
+}
+
+/*
+ * xmnt_server_copy_latency_stats - Pack the non-empty latency histograms
+ *   return: packed histograms allocated with malloc, or NULL
+ *   length_p(out): length of the packed area
+ *
+ * Note: The area holds the number of histograms followed by the name,
+ *       count, total, max and buckets of each one. See
+ *       mnt_lat_unpack_stats ().
+ */
+char *
+xmnt_server_copy_latency_stats (THREAD_ENTRY * thread_p, int *length_p)
+{
+  MNT_LAT_COUNTER *sum;
+  MNT_LAT_COUNTER *counter;
+  char name[MNT_LAT_NAME_LENGTH];
+  char *area, *ptr;
+  int index, slot, b, num_histograms = 0;
+  size_t size;
+
+  *length_p = 0;
+  if (mnt_Lat_area == NULL)
+    {
+      return NULL;
+    }
+
+  sum = (MNT_LAT_COUNTER *) calloc (MNT_LAT_NUM_HISTOGRAMS,
+				    sizeof (MNT_LAT_COUNTER));
+  if (sum == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      MNT_LAT_NUM_HISTOGRAMS * sizeof (MNT_LAT_COUNTER));
+      return NULL;
+    }
+
+  for (slot = 0; slot < MNT_LAT_NUM_SLOTS; slot++)
+    {
+      for (index = 0; index < MNT_LAT_NUM_HISTOGRAMS; index++)
+	{
+	  counter = mnt_Lat_slots[slot] + index;
+	  if (counter->count == 0)
+	    {
+	      continue;
+	    }
+	  sum[index].count += counter->count;
+	  sum[index].total_usec += counter->total_usec;
+	  sum[index].max_usec = MAX (sum[index].max_usec, counter->max_usec);
+	  for (b = 0; b < MNT_LAT_NUM_BUCKETS; b++)
+	    {
+	      sum[index].buckets[b] += counter->buckets[b];
+	    }
+	}
+    }
+
+  size = OR_INT_SIZE;
+  for (index = 0; index < MNT_LAT_NUM_HISTOGRAMS; index++)
+    {
+      if (sum[index].count > 0)
+	{
+	  num_histograms++;
+	}
+    }
+  size += num_histograms * (OR_INT_SIZE + MNT_LAT_NAME_LENGTH
+			    + MAX_ALIGNMENT
+			    + (3 + MNT_LAT_NUM_BUCKETS) * OR_INT64_SIZE);
+
+  area = (char *) malloc (size);
+  if (area == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      size);
+      free_and_init (sum);
+      return NULL;
+    }
+
+  ptr = or_pack_int (area, num_histograms);
+  for (index = 0; index < MNT_LAT_NUM_HISTOGRAMS; index++)
+    {
+      if (sum[index].count == 0)
+	{
+	  continue;
+	}
+      mnt_lat_get_name (index, name, sizeof (name));
+      ptr = or_pack_string (ptr, name);
+      ptr = or_pack_int64 (ptr, (INT64) sum[index].count);
+      ptr = or_pack_int64 (ptr, (INT64) sum[index].total_usec);
+      ptr = or_pack_int64 (ptr, (INT64) sum[index].max_usec);
+      for (b = 0; b < MNT_LAT_NUM_BUCKETS; b++)
+	{
+	  ptr = or_pack_int64 (ptr, (INT64) sum[index].buckets[b]);
+	}
+    }
+  free_and_init (sum);
+
+  *length_p = (int) (ptr - area);
+  return area;
+}
+#endif /* SERVER_MODE || SA_MODE */
+
+/*
+ * mnt_server_dump_stats - Print the given server statistics
+ *   return: none
+ *   stats(in) server statistics to print
+ *   stream(in): if NULL is given, stdout is used
+ */
+void
+mnt_server_dump_stats (const MNT_SERVER_EXEC_STATS * stats, FILE * stream)
+{
+  unsigned int i, *stats_ptr;
+
+  if (stream == NULL)
+    {
+      stream = stdout;
+    }
+
+  fprintf (stream, "\n *** SERVER EXECUTION STATISTICS *** \n");
+
+  stats_ptr = (unsigned int *) stats;
+  for (i = 0; i < MNT_SIZE_OF_SERVER_EXEC_STATS - 1; i++)
+    {
+      if (mnt_Stats_name[i])
+	{
+	  fprintf (stream, "%-29s = %10u\n", mnt_Stats_name[i], *stats_ptr++);
+	}
+    }
+
+  fprintf (stream, "\n *** OTHER STATISTICS *** \n");
+
+  fprintf (stream, "Data_page_buffer_hit_ratio    = %10.2f\n",
+	   (float) stats->pb_hit_ratio / 100);
+}
+
+/*
+ * mnt_server_dump_global_stats - Print the given server global statistics
+ *   return: none
+ *   stats(in) server statistics to print
+ *   stream(in): if NULL is given, stdout is used
+ */
+void
+mnt_server_dump_global_stats (const MNT_SERVER_EXEC_GLOBAL_STATS * stats,
+			      FILE * stream)
+{
+  unsigned int i;
+  UINT64 *stats_ptr;
+
+  if (stream == NULL)
+    {
+      stream = stdout;
+    }
+
+  fprintf (stream, "\n *** SERVER EXECUTION GLOBAL STATISTICS *** \n");
+
+  stats_ptr = (UINT64 *) stats;
+  for (i = 0; i < MNT_SIZE_OF_SERVER_EXEC_GLOBAL_STATS - 1; i++)
+    {
+      if (mnt_Stats_name[i])
+	{
+	  fprintf (stream, "%-29s = %10llu\n", mnt_Stats_name[i],
+		   (unsigned long long) *stats_ptr++);
+	}
+    }
+
+  fprintf (stream, "\n *** OTHER STATISTICS *** \n");
+
+  fprintf (stream, "Data_page_buffer_hit_ratio    = %10.2f\n",
+	   (float) stats->pb_hit_ratio / 100);
+}
+
+/*
+ * mnt_lat_unpack_stats - Unpack the histograms sent by
+ *                        xmnt_server_copy_latency_stats ()
+ *   return: NO_ERROR or error code
+ *   buf(in): packed histograms
+ *   length(in): length of buf
+ *   stats(out): free with mnt_lat_free_stats ()
+ */
+int
+mnt_lat_unpack_stats (char *buf, int length, MNT_LAT_STATS * stats)
+{
+  MNT_LAT_HISTOGRAM *histogram;
+  char *ptr, *name;
+  INT64 value;
+  int i, b, num_histograms;
+
+  stats->num_histograms = 0;
+  stats->histograms = NULL;
+
+  if (buf == NULL || length < OR_INT_SIZE)
+    {
+      return NO_ERROR;
+    }
+
+  ptr = or_unpack_int (buf, &num_histograms);
+  if (num_histograms <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  stats->histograms =
+    (MNT_LAT_HISTOGRAM *) malloc (num_histograms
+				  * sizeof (MNT_LAT_HISTOGRAM));
+  if (stats->histograms == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      num_histograms * sizeof (MNT_LAT_HISTOGRAM));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  for (i = 0; i < num_histograms; i++)
+    {
+      histogram = &stats->histograms[i];
+
+      ptr = or_unpack_string_nocopy (ptr, &name);
+      strncpy (histogram->name, (name != NULL) ? name : "",
+	       MNT_LAT_NAME_LENGTH - 1);
+      histogram->name[MNT_LAT_NAME_LENGTH - 1] = '\0';
+
+      ptr = or_unpack_int64 (ptr, &value);
+      histogram->count = (UINT64) value;
+      ptr = or_unpack_int64 (ptr, &value);
+      histogram->total_usec = (UINT64) value;
+      ptr = or_unpack_int64 (ptr, &value);
+      histogram->max_usec = (UINT64) value;
+      for (b = 0; b < MNT_LAT_NUM_BUCKETS; b++)
+	{
+	  ptr = or_unpack_int64 (ptr, &value);
+	  histogram->buckets[b] = (UINT64) value;
+	}
+    }
+  stats->num_histograms = num_histograms;
+
+  return NO_ERROR;
+}
+
+/*
+ * mnt_lat_free_stats - Free the histograms of mnt_lat_unpack_stats ()
+ *   return: none
+ *   stats(in):
+ */
+void
+mnt_lat_free_stats (MNT_LAT_STATS * stats)
+{
+  if (stats->histograms != NULL)
+    {
+      free_and_init (stats->histograms);
+    }
+  stats->num_histograms = 0;
+}
+
+/*
+ * mnt_lat_percentile - Estimate a percentile of a latency histogram
+ *   return: latency in microseconds
+ *   histogram(in):
+ *   percent(in): 0 - 100
+ *
+ * Note: The result is the upper bound of the bucket holding the percentile,
+ *       so it may be above the true value by the width of one bucket.
+ */
+UINT64
+mnt_lat_percentile (const MNT_LAT_HISTOGRAM * histogram, int percent)
+{
+  UINT64 rank, seen = 0, upper;
+  int b;
+
+  if (histogram->count == 0)
+    {
+      return 0;
+    }
+
+  rank = (histogram->count * percent + 99) / 100;
+  if (rank == 0)
+    {
+      rank = 1;
+    }
+
+  for (b = 0; b < MNT_LAT_NUM_BUCKETS - 1; b++)
+    {
+      seen += histogram->buckets[b];
+      if (seen >= rank)
+	{
+	  break;
+	}
+    }
+  if (b == MNT_LAT_NUM_BUCKETS - 1)
+    {
+      return histogram->max_usec;
+    }
+
+  if (b < 2)
+    {
+      upper = b;
+    }
+  else
+    {
+      upper = ((UINT64) (3 + (b & 1)) << (b / 2 - 1)) - 1;
+    }
+
+  return MIN (upper, histogram->max_usec);
+}
+
+/*
+ * mnt_lat_dump_stats - Print latency histograms
+ *   return: none
+ *   stats(in):
+ *   stream(in): if NULL is given, stdout is used
+ */
+void
+mnt_lat_dump_stats (const MNT_LAT_STATS * stats, FILE * stream)
+{
+  const MNT_LAT_HISTOGRAM *histogram;
+  int i;
+
+  if (stream == NULL)
+    {
+      stream = stdout;
+    }
+
+  fprintf (stream, "\n *** LATENCY HISTOGRAMS (usec) *** \n");
+  if (stats->num_histograms == 0)
+    {
+      fprintf (stream, "No waits recorded\n");
+      return;
+    }
+
+  fprintf (stream, "%-36s %10s %10s %10s %10s %10s %10s\n", "Name",
+	   "Count", "Avg", "P50", "P90", "P99", "Max");
+  for (i = 0; i < stats->num_histograms; i++)
+    {
+      histogram = &stats->histograms[i];
+      fprintf (stream, "%-36s %10llu %10llu %10llu %10llu %10llu %10llu\n",
+	       histogram->name, (unsigned long long) histogram->count,
+	       (unsigned long long) (histogram->total_usec
+				     / histogram->count),
+	       (unsigned long long) mnt_lat_percentile (histogram, 50),
+	       (unsigned long long) mnt_lat_percentile (histogram, 90),
+	       (unsigned long long) mnt_lat_percentile (histogram, 99),
+	       (unsigned long long) histogram->max_usec);
+    }
 }
 
 /*
@@ -210,6 +210,36 @@ struct mnt_server_exec_stats
   unsigned int fc_num_log_pages;
   unsigned int fc_tokens;
 
+  /* page buffer hash chain lookup */
+  unsigned int pb_num_hash_opt_hits;
+  unsigned int pb_num_hash_opt_retries;
+  unsigned int pb_num_hash_opt_fallbacks;
+
+  /* page buffer LRU shard victim selection */
+  unsigned int pb_num_lru_victims;
+  unsigned int pb_num_lru_steals;
+  unsigned int pb_num_lru_victim_search;
+
+  /* page buffer read-ahead */
+  unsigned int pb_num_prefetch_requests;
+  unsigned int pb_num_prefetch_reads;
+
+  /* Deadlock time-to-detect histogram */
+  unsigned int lk_num_dl_detect_1ms;
+  unsigned int lk_num_dl_detect_10ms;
+  unsigned int lk_num_dl_detect_100ms;
+  unsigned int lk_num_dl_detect_1s;
+  unsigned int lk_num_dl_detect_over_1s;
+
+  /* Sort statistics */
+  unsigned int sort_num_parallel_runs;
+
+  /* Parallel scan */
+  unsigned int qm_num_parallel_scans;
+
+  /* Query work memory */
+  unsigned int qm_num_spill_pages;
+
   /* Other statistics */
   unsigned int pb_hit_ratio;
   /* ((pb_num_fetches - pb_num_ioreads) x 100 / pb_num_fetches) x 100 */
@@ -220,7 +250,7 @@ struct mnt_server_exec_stats
 };
 
 /* number of field of MNT_SEVER_EXEC_STATS structure */
-#define MNT_SIZE_OF_SERVER_EXEC_STATS 51
+#define MNT_SIZE_OF_SERVER_EXEC_STATS 67
 
 typedef struct mnt_server_exec_global_stats MNT_SERVER_EXEC_GLOBAL_STATS;
 struct mnt_server_exec_global_stats
@@ -292,13 +322,43 @@ struct mnt_server_exec_global_stats
   UINT64 fc_num_log_pages;
   UINT64 fc_tokens;
 
+  /* page buffer hash chain lookup */
+  UINT64 pb_num_hash_opt_hits;
+  UINT64 pb_num_hash_opt_retries;
+  UINT64 pb_num_hash_opt_fallbacks;
+
+  /* page buffer LRU shard victim selection */
+  UINT64 pb_num_lru_victims;
+  UINT64 pb_num_lru_steals;
+  UINT64 pb_num_lru_victim_search;
+
+  /* page buffer read-ahead */
+  UINT64 pb_num_prefetch_requests;
+  UINT64 pb_num_prefetch_reads;
+
+  /* Deadlock time-to-detect histogram */
+  UINT64 lk_num_dl_detect_1ms;
+  UINT64 lk_num_dl_detect_10ms;
+  UINT64 lk_num_dl_detect_100ms;
+  UINT64 lk_num_dl_detect_1s;
+  UINT64 lk_num_dl_detect_over_1s;
+
+  /* Sort statistics */
+  UINT64 sort_num_parallel_runs;
+
+  /* Parallel scan */
+  UINT64 qm_num_parallel_scans;
+
+  /* Query work memory */
+  UINT64 qm_num_spill_pages;
+
   /* Other statistics */
   UINT64 pb_hit_ratio;
   /* ((pb_num_fetches - pb_num_ioreads) x 100 / pb_num_fetches) x 100 */
 };
 
 /* number of field of MNT_SERVER_EXEC_GLOBAL_STATS structure */
-#define MNT_SIZE_OF_SERVER_EXEC_GLOBAL_STATS 51
+#define MNT_SIZE_OF_SERVER_EXEC_GLOBAL_STATS 67
 
 extern void mnt_server_dump_stats (const MNT_SERVER_EXEC_STATS * stats,
 				   FILE * stream);
@@ -309,6 +369,53 @@ extern void mnt_get_current_times (time_t * cpu_usr_time,
 				   time_t * cpu_sys_time,
 				   time_t * elapsed_time);
 
+/*
+ * Latency histograms
+ *
+ * Wait and service times are kept in log-linear buckets: two buckets per
+ * power of two microseconds, so bucket b >= 2 covers
+ * [(2 + (b & 1)) << (b / 2 - 1), (3 + (b & 1)) << (b / 2 - 1)) usec.
+ * The last bucket also collects everything above about 70 minutes.
+ */
+#define MNT_LAT_NUM_BUCKETS     64
+#define MNT_LAT_NAME_LENGTH     64
+
+typedef enum
+{
+  MNT_LAT_PGBUF_FIX_WAIT = 0,	/* page latch waits in pgbuf_block_bcb */
+  MNT_LAT_LOCK_WAIT,		/* lock waits in lock_suspend */
+  MNT_LAT_LOG_FLUSH,		/* log append page flushes */
+  MNT_LAT_FILE_SYNC,		/* fsync of database and log volumes */
+  MNT_LAT_CSECT_WAIT,		/* csect_enter waits, one per CSECT_* */
+  MNT_LAT_NET_REQUEST,		/* service time, one per NET_SERVER_* */
+  MNT_LAT_NUM_KINDS
+} MNT_LAT_KIND;
+
+typedef struct mnt_lat_histogram MNT_LAT_HISTOGRAM;
+struct mnt_lat_histogram
+{
+  char name[MNT_LAT_NAME_LENGTH];
+  UINT64 count;
+  UINT64 total_usec;
+  UINT64 max_usec;
+  UINT64 buckets[MNT_LAT_NUM_BUCKETS];
+};
+
+/* A copy of the non-empty server histograms */
+typedef struct mnt_lat_stats MNT_LAT_STATS;
+struct mnt_lat_stats
+{
+  int num_histograms;
+  MNT_LAT_HISTOGRAM *histograms;
+};
+
+extern int mnt_lat_unpack_stats (char *buf, int length,
+				 MNT_LAT_STATS * stats);
+extern void mnt_lat_free_stats (MNT_LAT_STATS * stats);
+extern UINT64 mnt_lat_percentile (const MNT_LAT_HISTOGRAM * histogram,
+				  int percent);
+extern void mnt_lat_dump_stats (const MNT_LAT_STATS * stats, FILE * stream);
+
 #if defined(CS_MODE) || defined(SA_MODE)
 /* Client execution statistic structure */
 typedef struct mnt_exec_stats MNT_EXEC_STATS;
@@ -466,8 +573,8 @@ extern int mnt_Num_tran_exec_stats;
   if (mnt_Num_tran_exec_stats > 0) mnt_x_file_removes(thread_p)
 #define mnt_file_ioreads(thread_p) \
   if (mnt_Num_tran_exec_stats > 0) mnt_x_file_ioreads(thread_p)
-#define mnt_file_iowrites(thread_p) \
-  if (mnt_Num_tran_exec_stats > 0) mnt_x_file_iowrites(thread_p)
+#define mnt_file_iowrites(thread_p, num_pages) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_file_iowrites(thread_p, num_pages)
 #define mnt_file_iosynches(thread_p) \
   if (mnt_Num_tran_exec_stats > 0) mnt_x_file_iosynches(thread_p)
 
@@ -585,19 +692,70 @@ extern int mnt_Num_tran_exec_stats;
 #define mnt_net_requests(thread_p) \
   if (mnt_Num_tran_exec_stats > 0) mnt_x_net_requests(thread_p)
 
+/* page buffer hash chain lookup */
+#define mnt_pb_hash_opt_hits(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_pb_hash_opt_hits(thread_p)
+#define mnt_pb_hash_opt_retries(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_pb_hash_opt_retries(thread_p)
+#define mnt_pb_hash_opt_fallbacks(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_pb_hash_opt_fallbacks(thread_p)
+
+/* page buffer LRU shard victim selection */
+#define mnt_pb_lru_victims(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_pb_lru_victims(thread_p)
+#define mnt_pb_lru_steals(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_pb_lru_steals(thread_p)
+#define mnt_pb_lru_victim_search(thread_p, num_bcbs) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_pb_lru_victim_search(thread_p, num_bcbs)
+
+/* page buffer read-ahead */
+#define mnt_pb_prefetch_requests(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_pb_prefetch_requests(thread_p)
+#define mnt_pb_prefetch_reads(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_pb_prefetch_reads(thread_p)
+
+/* Deadlock time-to-detect histogram */
+#define mnt_lk_dl_detect_1ms(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_lk_dl_detect_1ms(thread_p)
+#define mnt_lk_dl_detect_10ms(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_lk_dl_detect_10ms(thread_p)
+#define mnt_lk_dl_detect_100ms(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_lk_dl_detect_100ms(thread_p)
+#define mnt_lk_dl_detect_1s(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_lk_dl_detect_1s(thread_p)
+#define mnt_lk_dl_detect_over_1s(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_lk_dl_detect_over_1s(thread_p)
+
+/* Sort statistics */
+#define mnt_sort_parallel_runs(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_sort_parallel_runs(thread_p)
+
+/* Parallel scan */
+#define mnt_qm_parallel_scans(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_qm_parallel_scans(thread_p)
+
+/* Query work memory */
+#define mnt_qm_spill_pages(thread_p) \
+  if (mnt_Num_tran_exec_stats > 0) mnt_x_qm_spill_pages(thread_p)
+
 
 extern void mnt_server_reflect_local_stats (THREAD_ENTRY * thread_p);
 extern MNT_SERVER_EXEC_STATS *mnt_server_get_stats (THREAD_ENTRY * thread_p);
 
 extern int mnt_server_init (int num_tran_indices);
 extern void mnt_server_final (void);
+extern void mnt_server_stop_tran_stats (int tran_index);
+
+extern void mnt_lat_set_name (MNT_LAT_KIND kind, int id, const char *name);
+extern void mnt_lat_record (THREAD_ENTRY * thread_p, MNT_LAT_KIND kind,
+			    int id, const struct timeval *start_time);
 #if defined(ENABLE_UNUSED_FUNCTION)
 extern void mnt_server_print_stats (THREAD_ENTRY * thread_p, FILE * stream);
 #endif
 extern void mnt_x_file_creates (THREAD_ENTRY * thread_p);
 extern void mnt_x_file_removes (THREAD_ENTRY * thread_p);
 extern void mnt_x_file_ioreads (THREAD_ENTRY * thread_p);
-extern void mnt_x_file_iowrites (THREAD_ENTRY * thread_p);
+extern void mnt_x_file_iowrites (THREAD_ENTRY * thread_p, int num_pages);
 extern void mnt_x_file_iosynches (THREAD_ENTRY * thread_p);
 extern void mnt_x_pb_fetches (THREAD_ENTRY * thread_p);
 extern void mnt_x_pb_dirties (THREAD_ENTRY * thread_p);
@@ -641,6 +799,23 @@ extern void mnt_x_qm_nljoins (THREAD_ENTRY * thread_p);
 extern void mnt_x_qm_mjoins (THREAD_ENTRY * thread_p);
 extern void mnt_x_qm_objfetches (THREAD_ENTRY * thread_p);
 extern void mnt_x_net_requests (THREAD_ENTRY * thread_p);
+extern void mnt_x_pb_hash_opt_hits (THREAD_ENTRY * thread_p);
+extern void mnt_x_pb_hash_opt_retries (THREAD_ENTRY * thread_p);
+extern void mnt_x_pb_hash_opt_fallbacks (THREAD_ENTRY * thread_p);
+extern void mnt_x_pb_lru_victims (THREAD_ENTRY * thread_p);
+extern void mnt_x_pb_lru_steals (THREAD_ENTRY * thread_p);
+extern void mnt_x_pb_lru_victim_search (THREAD_ENTRY * thread_p,
+					unsigned int num_bcbs);
+extern void mnt_x_pb_prefetch_requests (THREAD_ENTRY * thread_p);
+extern void mnt_x_pb_prefetch_reads (THREAD_ENTRY * thread_p);
+extern void mnt_x_lk_dl_detect_1ms (THREAD_ENTRY * thread_p);
+extern void mnt_x_lk_dl_detect_10ms (THREAD_ENTRY * thread_p);
+extern void mnt_x_lk_dl_detect_100ms (THREAD_ENTRY * thread_p);
+extern void mnt_x_lk_dl_detect_1s (THREAD_ENTRY * thread_p);
+extern void mnt_x_lk_dl_detect_over_1s (THREAD_ENTRY * thread_p);
+extern void mnt_x_sort_parallel_runs (THREAD_ENTRY * thread_p);
+extern void mnt_x_qm_parallel_scans (THREAD_ENTRY * thread_p);
+extern void mnt_x_qm_spill_pages (THREAD_ENTRY * thread_p);
 
 extern void mnt_x_fc_stats (THREAD_ENTRY * thread_p, unsigned int num_pages,
 			    unsigned int num_log_pages, unsigned int tokens);
@@ -650,7 +825,7 @@ extern void mnt_x_fc_stats (THREAD_ENTRY * thread_p, unsigned int num_pages,
 #define mnt_file_creates(thread_p)
 #define mnt_file_removes(thread_p)
 #define mnt_file_ioreads(thread_p)
-#define mnt_file_iowrites(thread_p)
+#define mnt_file_iowrites(thread_p, num_pages)
 #define mnt_file_iosynches(thread_p)
 
 #define mnt_pb_fetches(thread_p)
@@ -702,7 +877,33 @@ extern void mnt_x_fc_stats (THREAD_ENTRY * thread_p, unsigned int num_pages,
 
 #define mnt_net_requests(hread_p)
 
+#define mnt_qm_spill_pages(thread_p)
+
+#define mnt_qm_parallel_scans(thread_p)
+
+#define mnt_sort_parallel_runs(thread_p)
+
+#define mnt_lk_dl_detect_1ms(thread_p)
+#define mnt_lk_dl_detect_10ms(thread_p)
+#define mnt_lk_dl_detect_100ms(thread_p)
+#define mnt_lk_dl_detect_1s(thread_p)
+#define mnt_lk_dl_detect_over_1s(thread_p)
+
+#define mnt_pb_prefetch_requests(thread_p)
+#define mnt_pb_prefetch_reads(thread_p)
+
+#define mnt_pb_lru_victims(thread_p)
+#define mnt_pb_lru_steals(thread_p)
+#define mnt_pb_lru_victim_search(thread_p, num_bcbs)
+
+#define mnt_pb_hash_opt_hits(thread_p)
+#define mnt_pb_hash_opt_retries(thread_p)
+#define mnt_pb_hash_opt_fallbacks(thread_p)
+
 #define mnt_fc_stats (thread_p, num_pages, num_log_pages, num_tokens)
+
+#define mnt_lat_set_name(kind, id, name)
+#define mnt_lat_record(thread_p, kind, id, start_time)
 #endif /* CS_MODE */
 
 #endif /* _PERF_MONITOR_H_ */
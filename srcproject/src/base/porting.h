@@ -375,6 +375,45 @@ extern int drand48_r (struct drand48_data *buffer, double *result);
 
 extern double round (double d);
 #endif
+/*
+ * atomic operations
+ *
+ * ATOMIC_INC_32/64 return the new value, ATOMIC_CAS_* return true when
+ * the swap was done and ATOMIC_TAS_32 returns the old value.
+ * All of them imply a full memory barrier.
+ */
+#if defined(WINDOWS)
+#define ATOMIC_INC_32(ptr, amount) \
+	(InterlockedExchangeAdd ((volatile LONG *) (ptr), (amount)) + (amount))
+#define ATOMIC_INC_64(ptr, amount) \
+	(InterlockedExchangeAdd64 ((volatile LONGLONG *) (ptr), (amount)) \
+	 + (amount))
+#define ATOMIC_CAS_32(ptr, cmp_val, swap_val) \
+	(InterlockedCompareExchange ((volatile LONG *) (ptr), \
+				     (swap_val), (cmp_val)) == (cmp_val))
+#define ATOMIC_CAS_64(ptr, cmp_val, swap_val) \
+	(InterlockedCompareExchange64 ((volatile LONGLONG *) (ptr), \
+				       (swap_val), (cmp_val)) == (cmp_val))
+#define ATOMIC_CAS_ADDR(ptr, cmp_val, swap_val) \
+	(InterlockedCompareExchangePointer ((volatile PVOID *) (ptr), \
+					    (swap_val), (cmp_val)) \
+	 == (PVOID) (cmp_val))
+#define ATOMIC_TAS_32(ptr, val) \
+	InterlockedExchange ((volatile LONG *) (ptr), (val))
+#define MEMORY_BARRIER()	MemoryBarrier ()
+#else /* WINDOWS */
+#define ATOMIC_INC_32(ptr, amount)	__sync_add_and_fetch ((ptr), (amount))
+#define ATOMIC_INC_64(ptr, amount)	__sync_add_and_fetch ((ptr), (amount))
+#define ATOMIC_CAS_32(ptr, cmp_val, swap_val) \
+	__sync_bool_compare_and_swap ((ptr), (cmp_val), (swap_val))
+#define ATOMIC_CAS_64(ptr, cmp_val, swap_val) \
+	__sync_bool_compare_and_swap ((ptr), (cmp_val), (swap_val))
+#define ATOMIC_CAS_ADDR(ptr, cmp_val, swap_val) \
+	__sync_bool_compare_and_swap ((ptr), (cmp_val), (swap_val))
+#define ATOMIC_TAS_32(ptr, val)	__sync_lock_test_and_set ((ptr), (val))
+#define MEMORY_BARRIER()	__sync_synchronize ()
+#endif /* WINDOWS */
+
 extern unsigned int get_my_host_id (void);
 extern unsigned int get_host_main_ip (const char *hostname);
 extern bool is_valid_ip (unsigned int host_ip);
@@ -670,6 +670,51 @@ static int prm_max_conn_pool_size_default = 8;
 static int prm_max_conn_pool_size_upper = 64;
 static int prm_max_conn_pool_size_lower = 4;
 
+float PRM_PB_BULK_READ_RATIO = FLT_MIN;
+static float prm_pb_bulk_read_ratio_default = 0.25f;
+static float prm_pb_bulk_read_ratio_upper = 1.0f;
+static float prm_pb_bulk_read_ratio_lower = 0.0f;
+
+int PRM_PB_READ_AHEAD_PAGES = INT_MIN;
+static int prm_pb_read_ahead_pages_default = 16;
+static int prm_pb_read_ahead_pages_upper = 256;
+static int prm_pb_read_ahead_pages_lower = 0;
+
+int PRM_PB_NUM_FLUSH_THREADS = INT_MIN;
+static int prm_pb_num_flush_threads_default = 2;
+static int prm_pb_num_flush_threads_upper = 16;
+static int prm_pb_num_flush_threads_lower = 1;
+
+int PRM_MAX_PARALLEL_WORKERS = INT_MIN;
+static int prm_max_parallel_workers_default = 4;
+static int prm_max_parallel_workers_upper = 16;
+static int prm_max_parallel_workers_lower = 0;
+
+int PRM_CSS_NUM_IO_THREADS = INT_MIN;
+static int prm_css_num_io_threads_default = 2;
+static int prm_css_num_io_threads_upper = 16;
+static int prm_css_num_io_threads_lower = 0;
+
+int PRM_WORK_MEM_PAGES = INT_MIN;
+static int prm_work_mem_pages_default = 16384;
+static int prm_work_mem_pages_upper = 1048576;
+static int prm_work_mem_pages_lower = 0;
+
+int PRM_QUERY_WORK_MEM_PAGES = INT_MIN;
+static int prm_query_work_mem_pages_default = 1024;
+static int prm_query_work_mem_pages_upper = 1048576;
+static int prm_query_work_mem_pages_lower = 0;
+
+int PRM_ASYNC_QUERY_LEAD_PAGES = INT_MIN;
+static int prm_async_query_lead_pages_default = 256;
+static int prm_async_query_lead_pages_upper = INT_MAX;
+static int prm_async_query_lead_pages_lower = 0;
+
+int PRM_ASYNC_QUERY_CLIENT_WAIT_SECS = INT_MIN;
+static int prm_async_query_client_wait_secs_default = 600;
+static int prm_async_query_client_wait_secs_upper = INT_MAX;
+static int prm_async_query_client_wait_secs_lower = 1;
+
 typedef struct sysprm_param SYSPRM_PARAM;
 struct sysprm_param
 {
@@ -1561,6 +1606,68 @@ static SYSPRM_PARAM prm_Def[] = {
    (void *) &prm_max_conn_pool_size_upper,
    (void *) &prm_max_conn_pool_size_lower,
    (char *) NULL},
+  {PRM_NAME_PB_BULK_READ_RATIO,
+   (PRM_FLOAT | PRM_DEFAULT | PRM_FOR_SERVER | PRM_USER_CHANGE),
+   (void *) &prm_pb_bulk_read_ratio_default,
+   (void *) &PRM_PB_BULK_READ_RATIO,
+   (void *) &prm_pb_bulk_read_ratio_upper,
+   (void *) &prm_pb_bulk_read_ratio_lower,
+   (char *) NULL},
+  {PRM_NAME_PB_READ_AHEAD_PAGES,
+   (PRM_INTEGER | PRM_DEFAULT | PRM_FOR_SERVER),
+   (void *) &prm_pb_read_ahead_pages_default,
+   (void *) &PRM_PB_READ_AHEAD_PAGES,
+   (void *) &prm_pb_read_ahead_pages_upper,
+   (void *) &prm_pb_read_ahead_pages_lower,
+   (char *) NULL},
+  {PRM_NAME_PB_NUM_FLUSH_THREADS,
+   (PRM_INTEGER | PRM_DEFAULT | PRM_FOR_SERVER),
+   (void *) &prm_pb_num_flush_threads_default,
+   (void *) &PRM_PB_NUM_FLUSH_THREADS,
+   (void *) &prm_pb_num_flush_threads_upper,
+   (void *) &prm_pb_num_flush_threads_lower,
+   (char *) NULL},
+  {PRM_NAME_MAX_PARALLEL_WORKERS,
+   (PRM_INTEGER | PRM_DEFAULT | PRM_FOR_SERVER),
+   (void *) &prm_max_parallel_workers_default,
+   (void *) &PRM_MAX_PARALLEL_WORKERS,
+   (void *) &prm_max_parallel_workers_upper,
+   (void *) &prm_max_parallel_workers_lower,
+   (char *) NULL},
+  {PRM_NAME_CSS_NUM_IO_THREADS,
+   (PRM_INTEGER | PRM_DEFAULT | PRM_FOR_SERVER),
+   (void *) &prm_css_num_io_threads_default,
+   (void *) &PRM_CSS_NUM_IO_THREADS,
+   (void *) &prm_css_num_io_threads_upper,
+   (void *) &prm_css_num_io_threads_lower,
+   (char *) NULL},
+  {PRM_NAME_WORK_MEM_PAGES,
+   (PRM_INTEGER | PRM_DEFAULT | PRM_FOR_SERVER),
+   (void *) &prm_work_mem_pages_default,
+   (void *) &PRM_WORK_MEM_PAGES,
+   (void *) &prm_work_mem_pages_upper, (void *) &prm_work_mem_pages_lower,
+   (char *) NULL},
+  {PRM_NAME_QUERY_WORK_MEM_PAGES,
+   (PRM_INTEGER | PRM_DEFAULT | PRM_FOR_SERVER),
+   (void *) &prm_query_work_mem_pages_default,
+   (void *) &PRM_QUERY_WORK_MEM_PAGES,
+   (void *) &prm_query_work_mem_pages_upper,
+   (void *) &prm_query_work_mem_pages_lower,
+   (char *) NULL},
+  {PRM_NAME_ASYNC_QUERY_LEAD_PAGES,
+   (PRM_INTEGER | PRM_DEFAULT | PRM_FOR_SERVER),
+   (void *) &prm_async_query_lead_pages_default,
+   (void *) &PRM_ASYNC_QUERY_LEAD_PAGES,
+   (void *) &prm_async_query_lead_pages_upper,
+   (void *) &prm_async_query_lead_pages_lower,
+   (char *) NULL},
+  {PRM_NAME_ASYNC_QUERY_CLIENT_WAIT_SECS,
+   (PRM_INTEGER | PRM_DEFAULT | PRM_FOR_SERVER),
+   (void *) &prm_async_query_client_wait_secs_default,
+   (void *) &PRM_ASYNC_QUERY_CLIENT_WAIT_SECS,
+   (void *) &prm_async_query_client_wait_secs_upper,
+   (void *) &prm_async_query_client_wait_secs_lower,
+   (char *) NULL},
   /* All the compound parameters *must* be at the end of the array so that the
      changes they cause are not overridden by other parameters (for example in
      sysprm_load_and_init the parameters are set to their default in the order
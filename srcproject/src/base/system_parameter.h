@@ -478,6 +478,33 @@ extern const char *PRM_SERVICE_SERVICE_LIST;
 #define PRM_NAME_SERVICE_SERVER_LIST "service::server"
 extern const char *PRM_SERVICE_SERVER_LIST;
 
+#define PRM_NAME_PB_BULK_READ_RATIO "bulk_read_buffer_ratio"
+extern float PRM_PB_BULK_READ_RATIO;
+
+#define PRM_NAME_PB_READ_AHEAD_PAGES "read_ahead_pages"
+extern int PRM_PB_READ_AHEAD_PAGES;
+
+#define PRM_NAME_PB_NUM_FLUSH_THREADS "page_flush_thread_count"
+extern int PRM_PB_NUM_FLUSH_THREADS;
+
+#define PRM_NAME_MAX_PARALLEL_WORKERS "max_parallel_workers"
+extern int PRM_MAX_PARALLEL_WORKERS;
+
+#define PRM_NAME_CSS_NUM_IO_THREADS "connection_io_thread_count"
+extern int PRM_CSS_NUM_IO_THREADS;
+
+#define PRM_NAME_WORK_MEM_PAGES "work_memory_size_in_pages"
+extern int PRM_WORK_MEM_PAGES;
+
+#define PRM_NAME_QUERY_WORK_MEM_PAGES "query_work_memory_size_in_pages"
+extern int PRM_QUERY_WORK_MEM_PAGES;
+
+#define PRM_NAME_ASYNC_QUERY_LEAD_PAGES "async_query_max_lead_pages"
+extern int PRM_ASYNC_QUERY_LEAD_PAGES;
+
+#define PRM_NAME_ASYNC_QUERY_CLIENT_WAIT_SECS "async_query_client_wait_secs"
+extern int PRM_ASYNC_QUERY_CLIENT_WAIT_SECS;
+
 extern int sysprm_load_and_init (const char *db_name, const char *conf_file);
 extern int sysprm_reload_and_init (const char *db_name,
 				   const char *conf_file);
@@ -353,6 +353,8 @@ extern int xqmgr_drop_query_plan (THREAD_ENTRY * thread_p,
 extern int xqmgr_drop_all_query_plans (THREAD_ENTRY * thread_p);
 extern void xqmgr_dump_query_plans (THREAD_ENTRY * thread_p, FILE * outfp);
 extern void xqmgr_dump_query_cache (THREAD_ENTRY * thread_p, FILE * outfp);
+extern int xqmgr_set_query_profile (THREAD_ENTRY * thread_p, bool on);
+extern void xqmgr_dump_query_profile (THREAD_ENTRY * thread_p, FILE * outfp);
 
 extern int xqmgr_get_query_info (THREAD_ENTRY * thread_p, QUERY_ID query_id);
 #if defined (SERVER_MODE)
@@ -372,6 +374,8 @@ extern void xmnt_server_copy_global_stats (THREAD_ENTRY * thread_p,
 					   to_stats);
 extern void xmnt_server_reset_stats (THREAD_ENTRY * thread_p);
 extern void xmnt_server_reset_global_stats (void);
+extern char *xmnt_server_copy_latency_stats (THREAD_ENTRY * thread_p,
+					    int *length_p);
 
 /* catalog manager interface */
 
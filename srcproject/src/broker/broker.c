@@ -487,6 +487,7 @@ main (int argc, char *argv[])
 		    UTS_STATUS_IDLE;
 		  shm_appl->as_info[add_as_index].service_flag = SERVICE_ON;
 		  shm_appl->as_info[add_as_index].reset_flag = FALSE;
+		  uw_shm_push_idle_cas (shm_appl, add_as_index);
 		  (shm_br->br_info[br_index].appl_server_num)++;
 		  (shm_appl->num_appl_server)++;
 		}
@@ -767,6 +768,7 @@ dispatch_thr_f (void *arg)
   T_MAX_HEAP_NODE *job_queue;
   T_MAX_HEAP_NODE cur_job;
   int as_index, i;
+  struct timeval start_time, end_time;
 #if !defined(WINDOWS)
   SOCKET srv_sock_fd;
   int retry_count;
@@ -811,6 +813,7 @@ dispatch_thr_f (void *arg)
       hold_job = 1;
       max_heap_incr_priority (job_queue);
 
+      gettimeofday (&start_time, NULL);
       while (1)
 	{
 	  MUTEX_LOCK (service_flag_mutex);
@@ -822,9 +825,16 @@ dispatch_thr_f (void *arg)
 	  else
 	    break;
 	}
+      gettimeofday (&end_time, NULL);
 
       hold_job = 0;
 
+      /* only this thread updates the dispatch counters */
+      shm_appl->num_dispatch++;
+      shm_appl->dispatch_usec +=
+	((INT64) (end_time.tv_sec - start_time.tv_sec) * 1000000
+	 + (end_time.tv_usec - start_time.tv_usec));
+
 #if !defined(WIN_FW)
       shm_appl->as_info[as_index].clt_major_version =
 	cur_job.clt_major_version;
@@ -876,6 +886,7 @@ dispatch_thr_f (void *arg)
 		{
 		  CAS_SEND_ERROR_CODE (cur_job.clt_sock_fd,
 				       CAS_ER_FREE_SERVER);
+		  uw_shm_push_idle_cas (shm_appl, as_index);
 		}
 	    }
 	  else
@@ -888,6 +899,7 @@ dispatch_thr_f (void *arg)
 	{
 	  CAS_SEND_ERROR_CODE (cur_job.clt_sock_fd, CAS_ER_FREE_SERVER);
 	  shm_appl->as_info[as_index].uts_status = UTS_STATUS_IDLE;
+	  uw_shm_push_idle_cas (shm_appl, as_index);
 	}
       CLOSE_SOCKET (cur_job.clt_sock_fd);
 #endif /* ifdef !WINDOWS */
@@ -946,6 +958,7 @@ service_thr_f (void *arg)
 	{
 	  CAS_SEND_ERROR_CODE (clt_sock_fd, CAS_ER_FREE_SERVER);
 	  shm_appl->as_info[self_index].uts_status = UTS_STATUS_IDLE;
+	  uw_shm_push_idle_cas (shm_appl, self_index);
 	  CLOSE_SOCKET (cur_job.clt_sock_fd);
 	  continue;
 	}
@@ -1363,10 +1376,12 @@ static THREAD_FUNC
 cas_monitor_thr_f (void *ar)
 {
   int i, new_pid, tmp_num_busy_uts;
+  int loop_count = 0;
 
   while (process_flag)
     {
       tmp_num_busy_uts = 0;
+      loop_count++;
       for (i = 0; i < shm_br->br_info[br_index].appl_server_max_num; i++)
 	{
 	  if (shm_appl->as_info[i].service_flag != SERVICE_ON)
@@ -1377,10 +1392,29 @@ cas_monitor_thr_f (void *ar)
 	  else if (shm_appl->as_info[i].uts_status == UTS_STATUS_BUSY_WAIT)
 	    {
 	      if (time (NULL) - shm_appl->as_info[i].last_access_time > 10)
-		shm_appl->as_info[i].uts_status = UTS_STATUS_IDLE;
+		{
+		  shm_appl->as_info[i].uts_status = UTS_STATUS_IDLE;
+		  uw_shm_push_idle_cas (shm_appl, i);
+		}
 	      else
 		tmp_num_busy_uts++;
 	    }
+#else
+	  else if (shm_appl->as_info[i].uts_status == UTS_STATUS_IDLE
+		   && loop_count % 10 == 0
+		   && kill (shm_appl->as_info[i].pid, 0) < 0)
+	    {
+	      /*
+	       * The dispatcher does not probe idle CAS any more; take a dead
+	       * one away from it and restart it below.
+	       */
+	      MUTEX_LOCK (service_flag_mutex);
+	      if (shm_appl->as_info[i].uts_status == UTS_STATUS_IDLE)
+		{
+		  shm_appl->as_info[i].uts_status = UTS_STATUS_RESTART;
+		}
+	      MUTEX_UNLOCK (service_flag_mutex);
+	    }
 #endif
 
 /*      if (shm_appl->as_info[i].service_flag != SERVICE_ON)
@@ -1395,6 +1429,7 @@ cas_monitor_thr_f (void *ar)
 		{
 		  restart_appl_server (i);
 		  shm_appl->as_info[i].uts_status = UTS_STATUS_IDLE;
+		  uw_shm_push_idle_cas (shm_appl, i);
 		}
 	      else
 		{
@@ -1408,6 +1443,7 @@ cas_monitor_thr_f (void *ar)
 		    {
 		      restart_appl_server (i);
 		      shm_appl->as_info[i].uts_status = UTS_STATUS_IDLE;
+		      uw_shm_push_idle_cas (shm_appl, i);
 		    }
 		}
 #endif
@@ -1418,6 +1454,7 @@ cas_monitor_thr_f (void *ar)
 	      new_pid = run_appl_server (i);
 	      shm_appl->as_info[i].pid = new_pid;
 	      shm_appl->as_info[i].uts_status = UTS_STATUS_IDLE;
+	      uw_shm_push_idle_cas (shm_appl, i);
 	    }
 	}
       num_busy_uts = tmp_num_busy_uts;
@@ -1831,18 +1868,28 @@ find_idle_cas (void)
   wait_cas_id = -1;
   max_wait_time = 0;
 
-  for (i = 0; i < shm_br->br_info[br_index].appl_server_max_num; i++)
+  /*
+   * Idle CAS put themselves in the idle CAS list. Dead CAS are restarted by
+   * cas_monitor_thr_f(), so they need not be probed here.
+   */
+  while ((i = uw_shm_pop_idle_cas (shm_appl)) >= 0)
+    {
+      if (shm_appl->as_info[i].service_flag == SERVICE_ON
+	  && shm_appl->as_info[i].uts_status == UTS_STATUS_IDLE)
+	{
+	  idle_cas_id = i;
+	  break;
+	}
+    }
+
+  for (i = 0; idle_cas_id < 0
+       && i < shm_br->br_info[br_index].appl_server_max_num; i++)
     {
       if (shm_appl->as_info[i].service_flag != SERVICE_ON)
 	{
 	  continue;
 	}
-#if !defined (WINDOWS)
-      if (shm_appl->as_info[i].uts_status == UTS_STATUS_IDLE
-	  && kill (shm_appl->as_info[i].pid, 0) == 0)
-#else
       if (shm_appl->as_info[i].uts_status == UTS_STATUS_IDLE)
-#endif
 	{
 	  idle_cas_id = i;
 	  wait_cas_id = -1;
@@ -1887,7 +1934,7 @@ find_idle_cas (void)
 	OpenProcess (SYNCHRONIZE, FALSE, shm_appl->as_info[idle_cas_id].pid);
       if (h_proc == NULL)
 	{
-	  shm_appl->as_info[i].uts_status = UTS_STATUS_RESTART;
+	  shm_appl->as_info[idle_cas_id].uts_status = UTS_STATUS_RESTART;
 	  idle_cas_id = -1;
 	}
       else
@@ -589,6 +589,7 @@ admin_restart_cmd (int master_shm_id, const char *broker, int as_index)
   shm_appl->as_info[as_index].database_name[0] = '\0';
   shm_appl->as_info[as_index].database_host[0] = '\0';
   shm_appl->as_info[as_index].last_connect_time = 0;
+  uw_shm_push_idle_cas (shm_appl, as_index);
 
   /* mutex exit section */
   shm_appl->as_info[as_index].mutex_flag[SHM_MUTEX_ADMIN] = FALSE;
@@ -1607,6 +1608,10 @@ br_activate (T_BROKER_INFO * br_info, int master_shm_id,
 
   shm_appl->suspend_mode = SUSPEND_NONE;
   shm_appl->job_queue_size = br_info->job_queue_size;
+  shm_appl->appl_server_max_sessions = br_info->appl_server_max_sessions;
+  shm_appl->idle_cas_head = 0;	/* empty idle CAS list */
+  shm_appl->num_dispatch = 0;
+  shm_appl->dispatch_usec = 0;
   shm_appl->job_queue[0].id = 0;	/* initialize max heap */
   strcpy (shm_appl->log_dir, br_info->log_dir);
   strcpy (shm_appl->err_log_dir, br_info->err_log_dir);
@@ -1990,6 +1995,7 @@ as_activate (T_APPL_SERVER_INFO * as_info, int as_index,
   as_info->psize = getsize (as_info->pid);
   as_info->uts_status = UTS_STATUS_IDLE;
   as_info->service_flag = SERVICE_ON;
+  uw_shm_push_idle_cas (shm_appl, as_index);
 }
 
 static void
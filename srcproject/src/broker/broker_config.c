@@ -54,6 +54,8 @@
 #define DEFAULT_ADMIN_LOG_FILE		"log/broker/cubrid_broker.log"
 #define DEFAULT_SESSION_TIMEOUT		300	/* seconds */
 #define DEFAULT_JOB_QUEUE_SIZE		500
+#define DEFAULT_APPL_SERVER_MAX_SESSIONS	1
+#define MAX_APPL_SERVER_MAX_SESSIONS	256
 #define DEFAULT_APPL_SERVER		"CAS"
 #define DEFAULT_EMPTY_STRING		"\0"
 #define DEFAULT_FILE_UPLOAD_DELIMITER   "^^"
@@ -479,6 +481,11 @@ broker_config_read_internal (const char *conf_file,
 	ini_getuint_max (ini, sec_name, "JOB_QUEUE_SIZE",
 			 DEFAULT_JOB_QUEUE_SIZE, JOB_QUEUE_MAX_SIZE, &lineno);
 
+      br_info[num_brs].appl_server_max_sessions =
+	ini_getuint_max (ini, sec_name, "APPL_SERVER_MAX_SESSIONS",
+			 DEFAULT_APPL_SERVER_MAX_SESSIONS,
+			 MAX_APPL_SERVER_MAX_SESSIONS, &lineno);
+
       br_info[num_brs].time_to_kill =
 	ini_getuint (ini, sec_name, "TIME_TO_KILL", DEFAULT_TIME_TO_KILL,
 		     &lineno);
@@ -893,6 +900,8 @@ broker_config_dump (FILE * fp, const T_BROKER_INFO * br_info,
 	  fprintf (fp, "AUTO_ADD_APPL_SERVER\t=%s\n", tmp_str);
 	}
       fprintf (fp, "JOB_QUEUE_SIZE\t\t=%d\n", br_info[i].job_queue_size);
+      fprintf (fp, "APPL_SERVER_MAX_SESSIONS=%d\n",
+	       br_info[i].appl_server_max_sessions);
       fprintf (fp, "TIME_TO_KILL\t\t=%d\n", br_info[i].time_to_kill);
       tmp_str = get_conf_string (br_info[i].access_log, tbl_on_off);
       if (tmp_str)
@@ -131,6 +131,7 @@ struct t_broker_info
   int appl_server_max_size;
   int session_timeout;
   int job_queue_size;
+  int appl_server_max_sessions;
   int time_to_kill;
   int err_code;
   int os_err_code;
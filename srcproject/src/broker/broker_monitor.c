@@ -92,6 +92,9 @@ struct br_monitoring_item
   INT64 lts;
   INT64 lqs;
   INT64 eqs;
+  INT64 num_disp;
+  INT64 disp_usec;
+  INT64 dus;
 };
 
 static void str_to_screen (const char *msg);
@@ -645,6 +648,8 @@ appl_monitor (char *br_vector)
 		{
 		  str_out (" KEEP_CONNECTION:%s", "AUTO");
 		}
+	      str_out (", APPL_SERVER_MAX_SESSIONS:%d",
+		       shm_appl->appl_server_max_sessions);
 
 	      if (shm_appl->access_mode == READ_WRITE_ACCESS_MODE)
 		{
@@ -917,6 +922,7 @@ br_monitor (char *br_vector)
   INT64 num_tx_cur = 0, num_qx_cur = 0;
   INT64 num_lt_cur = 0, num_lq_cur = 0, num_eq_cur = 0;
   INT64 tps = 0, qps = 0, lts = 0, lqs = 0, eqs = 0;
+  INT64 num_disp_cur = 0, disp_usec_cur = 0, dus = 0;
   static unsigned int tty_print_header = 0;
   double elapsed_time;
 
@@ -937,6 +943,10 @@ br_monitor (char *br_vector)
   buf_len += sprintf (buf + buf_len, "%8s", "LONG-T");
   buf_len += sprintf (buf + buf_len, "%8s", "LONG-Q");
   buf_len += sprintf (buf + buf_len, "%6s", "ERR-Q");
+  if (full_info_flag)
+    {
+      buf_len += sprintf (buf + buf_len, "%8s", "DISP-US");
+    }
 
   if (tty_mode == false || (tty_print_header++ % 20 == 0))
     {
@@ -1019,6 +1029,8 @@ br_monitor (char *br_vector)
 		  num_lq_cur += shm_appl->as_info[j].num_long_queries;
 		  num_eq_cur += shm_appl->as_info[j].num_error_queries;
 		}
+	      num_disp_cur = shm_appl->num_dispatch;
+	      disp_usec_cur = shm_appl->dispatch_usec;
 	      if (elapsed_time > 0)
 		{
 		  tps = ((num_tx_cur - br_mnt_olds[i].num_tx) / elapsed_time);
@@ -1026,18 +1038,31 @@ br_monitor (char *br_vector)
 		  lts = ((num_lt_cur - br_mnt_olds[i].num_lt) / elapsed_time);
 		  lqs = ((num_lq_cur - br_mnt_olds[i].num_lq) / elapsed_time);
 		  eqs = ((num_eq_cur - br_mnt_olds[i].num_eq) / elapsed_time);
+		  /* average time to pick an idle CAS over the interval */
+		  if (num_disp_cur > br_mnt_olds[i].num_disp)
+		    {
+		      dus = ((disp_usec_cur - br_mnt_olds[i].disp_usec)
+			     / (num_disp_cur - br_mnt_olds[i].num_disp));
+		    }
+		  else
+		    {
+		      dus = 0;
+		    }
 
 		  br_mnt_olds[i].num_tx = num_tx_cur;
 		  br_mnt_olds[i].num_qx = num_qx_cur;
 		  br_mnt_olds[i].num_lt = num_lt_cur;
 		  br_mnt_olds[i].num_lq = num_lq_cur;
 		  br_mnt_olds[i].num_eq = num_eq_cur;
+		  br_mnt_olds[i].num_disp = num_disp_cur;
+		  br_mnt_olds[i].disp_usec = disp_usec_cur;
 
 		  br_mnt_olds[i].tps = tps;
 		  br_mnt_olds[i].qps = qps;
 		  br_mnt_olds[i].lts = lts;
 		  br_mnt_olds[i].lqs = lqs;
 		  br_mnt_olds[i].eqs = eqs;
+		  br_mnt_olds[i].dus = dus;
 		}
 	      else
 		{
@@ -1046,6 +1071,7 @@ br_monitor (char *br_vector)
 		  lts = br_mnt_olds[i].lts;
 		  lqs = br_mnt_olds[i].lqs;
 		  eqs = br_mnt_olds[i].eqs;
+		  dus = br_mnt_olds[i].dus;
 		}
 	      str_out (" %4ld", tps);
 	      str_out (" %4ld", qps);
@@ -1054,6 +1080,10 @@ br_monitor (char *br_vector)
 	      str_out (" %4ld/%-.1f", lqs,
 		       (shm_appl->long_query_time / 1000.0));
 	      str_out (" %4ld", eqs);
+	      if (full_info_flag)
+		{
+		  str_out (" %7ld", dus);
+		}
 	      print_newline ();
 
 	      if (shm_appl->suspend_mode != SUSPEND_NONE)
@@ -312,6 +312,69 @@ uw_shm_detach (void *p)
 }
 #endif
 
+/*
+ * uw_shm_push_idle_cas - put a CAS in the idle CAS list
+ *   return: void
+ *   shm_appl(in/out):
+ *   as_index(in):
+ *
+ * Note: The list is a stack linked through as_info[].idle_next, and is
+ *   shared by the broker and the CAS processes. The head carries a tag
+ *   which is bumped on every change, so that a stale compare-and-swap
+ *   always fails. A CAS which is already in the list is not put again.
+ */
+void
+uw_shm_push_idle_cas (T_SHM_APPL_SERVER * shm_appl, int as_index)
+{
+  T_APPL_SERVER_INFO *as_info_p = &(shm_appl->as_info[as_index]);
+  INT64 head, new_head;
+
+  if (!ATOMIC_CAS_32 (&as_info_p->idle_listed, 0, 1))
+    {
+      return;
+    }
+
+  do
+    {
+      head = shm_appl->idle_cas_head;
+      as_info_p->idle_next = (int) (head & 0xFFFFFFFF);
+      new_head = ((((head >> 32) + 1) & 0xFFFFFFFF) << 32) | (as_index + 1);
+    }
+  while (!ATOMIC_CAS_64 (&shm_appl->idle_cas_head, head, new_head));
+}
+
+/*
+ * uw_shm_pop_idle_cas - take a CAS from the idle CAS list
+ *   return: as_index, or -1 if the list is empty
+ *   shm_appl(in/out):
+ *
+ * Note: Only the dispatcher of the broker may call this. The CAS may have
+ *   been taken by other means since it was put in the list, so the caller
+ *   must check its status.
+ */
+int
+uw_shm_pop_idle_cas (T_SHM_APPL_SERVER * shm_appl)
+{
+  INT64 head, new_head;
+  int as_index;
+
+  do
+    {
+      head = shm_appl->idle_cas_head;
+      as_index = (int) (head & 0xFFFFFFFF) - 1;
+      if (as_index < 0)
+	{
+	  return -1;
+	}
+      new_head = ((((head >> 32) + 1) & 0xFFFFFFFF) << 32)
+	| (unsigned int) shm_appl->as_info[as_index].idle_next;
+    }
+  while (!ATOMIC_CAS_64 (&shm_appl->idle_cas_head, head, new_head));
+
+  shm_appl->as_info[as_index].idle_listed = 0;
+  return as_index;
+}
+
 #if defined(WINDOWS)
 int
 uw_shm_get_magic_number ()
@@ -222,6 +222,8 @@ struct t_appl_server_info
   char database_name[32];
   char database_host[MAXHOSTNAMELEN + 1];
   time_t last_connect_time;
+  int idle_next;		/* next idle CAS in the list (as_index + 1) */
+  int idle_listed;		/* is this CAS in the idle list ? */
 };
 
 typedef struct t_shm_appl_server T_SHM_APPL_SERVER;
@@ -260,9 +262,13 @@ struct t_shm_appl_server
   int suspend_mode;
   int max_string_length;
   int job_queue_size;
+  int appl_server_max_sessions;	/* client sessions kept by a CAS */
   int sql_log_max_size;
   int long_query_time;		/* msec */
   int long_transaction_time;	/* msec */
+  INT64 idle_cas_head;		/* idle CAS list: (tag << 32) | (as_index + 1) */
+  INT64 num_dispatch;		/* number of dispatched requests */
+  INT64 dispatch_usec;		/* time to find a CAS for them */
   INT64 dummy1;
   T_MAX_HEAP_NODE job_queue[JOB_QUEUE_MAX_SIZE + 1];
   INT64 dummy2;
@@ -297,6 +303,8 @@ void *uw_shm_open (int shm_key, int which_shm, T_SHM_MODE shm_mode);
 void *uw_shm_create (int shm_key, int size, int which_shm);
 int uw_shm_destroy (int shm_key);
 void uw_shm_detach (void *);
+void uw_shm_push_idle_cas (T_SHM_APPL_SERVER * shm_appl, int as_index);
+int uw_shm_pop_idle_cas (T_SHM_APPL_SERVER * shm_appl);
 #if defined(WINDOWS)
 int uw_shm_get_magic_number ();
 #endif
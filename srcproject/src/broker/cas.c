@@ -37,6 +37,7 @@
 #include <dbgHelp.h>
 #else /* WINDOWS */
 #include <unistd.h>
+#include <sys/time.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <sys/socket.h>
@@ -77,6 +78,31 @@
 #include "environment_variable.h"
 #endif /* !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
 
+#if !defined(LIBCAS_FOR_JSP) && !defined(CAS_FOR_ORACLE) \
+  && !defined(CAS_FOR_MYSQL)
+#define CAS_WAIT_CURRENT	(-1)
+#define CAS_WAIT_TIMEOUT	(-2)
+
+/* a client connection parked on this CAS while another client is served */
+typedef struct t_cas_session T_CAS_SESSION;
+struct t_cas_session
+{
+  SOCKET sock_fd;
+  int client_ip_addr;
+  char clt_major_version;
+  char clt_minor_version;
+  char clt_patch_version;
+  char cas_client_type;
+  int isolation_level;
+  int lock_timeout;
+  time_t last_access_time;
+  struct timeval start_time;
+  char db_name[SRV_CON_DBNAME_SIZE];
+  char db_user[SRV_CON_DBUSER_SIZE];
+  char db_passwd[SRV_CON_DBPASSWD_SIZE];
+};
+#endif /* !LIBCAS_FOR_JSP && !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
+
 static int process_request (SOCKET sock_fd, T_NET_BUF * net_buf,
 			    T_REQ_INFO * req_info);
 
@@ -91,6 +117,19 @@ static void query_cancel (int signo);
 static int net_read_int_keep_con_auto (SOCKET clt_sock_fd,
 				       MSG_HEADER * client_msg_header,
 				       T_REQ_INFO * req_info);
+#if !defined(CAS_FOR_ORACLE) && !defined(CAS_FOR_MYSQL)
+static bool cas_park_session (SOCKET sock_fd, int client_ip_addr,
+			      struct timeval *start_time, char *db_name,
+			      char *db_user, char *db_passwd);
+static void cas_close_parked_session (int index);
+static void cas_close_parked_sessions (void);
+static int cas_wait_for_sessions (SOCKET clt_sock_fd);
+static void cas_end_session (SOCKET sock_fd, int client_ip_addr,
+			     struct timeval *start_time);
+static int cas_switch_session (SOCKET * sock_fd, int *client_ip_addr,
+			       struct timeval *start_time, char *db_name,
+			       char *db_user, char *db_passwd);
+#endif /* !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
 #else /* !LIBCAS_FOR_JSP */
 extern int libcas_main (SOCKET jsp_sock_fd);
 extern void *libcas_get_db_result_set (int h_id);
@@ -247,6 +286,12 @@ static T_REQ_INFO req_info;
 #ifndef LIBCAS_FOR_JSP
 static SOCKET srv_sock_fd;
 static int cas_req_count = 1;
+#if !defined(CAS_FOR_ORACLE) && !defined(CAS_FOR_MYSQL)
+static T_CAS_SESSION *parked_sessions = NULL;
+static int max_parked_sessions = 0;
+static int num_parked_sessions = 0;
+static int ready_session_index = -1;
+#endif /* !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
 #endif /* !LIBCAS_FOR_JSP */
 
 #ifndef LIBCAS_FOR_JSP
@@ -273,6 +318,7 @@ main (int argc, char *argv[])
 #endif /* WINDOWS */
   char broker_info[BROKER_INFO_SIZE];
   int client_ip_addr;
+  bool client_parked;
   char dummy_info[CAS_INFO_SIZE] = { CAS_INFO_STATUS_INACTIVE,
     CAS_INFO_RESERVED_DEFAULT,
     CAS_INFO_RESERVED_DEFAULT,
@@ -373,6 +419,7 @@ main (int argc, char *argv[])
 #if !defined(WINDOWS)
       retry:
 #endif
+	client_parked = false;
 	br_sock_fd = net_connect_client (srv_sock_fd);
 
 	if (IS_INVALID_SOCKET (br_sock_fd))
@@ -600,10 +647,31 @@ main (int argc, char *argv[])
 		as_info->glo_flag = 0;
 #endif /* WINDOWS */
 		as_info->last_access_time = time (NULL);
+#if !defined(CAS_FOR_ORACLE) && !defined(CAS_FOR_MYSQL)
+		if (err_code < 0
+		    && cas_switch_session (&client_sock_fd, &client_ip_addr,
+					   &cas_start_time, db_name, db_user,
+					   db_passwd) == 0)
+		  {
+		    err_code = 0;
+		  }
+#endif /* !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
 	      }
 
 	    prev_cas_info[CAS_INFO_STATUS] = CAS_INFO_RESERVED_DEFAULT;
 
+#if !defined(CAS_FOR_ORACLE) && !defined(CAS_FOR_MYSQL)
+	    if (as_info->cur_keep_con == KEEP_CON_AUTO
+		&& as_info->con_status == CON_STATUS_CLOSE_AND_CONNECT)
+	      {
+		/* keep the client while the broker hands over a new one */
+		client_parked =
+		  cas_park_session (client_sock_fd, client_ip_addr,
+				    &cas_start_time, db_name, db_user,
+				    db_passwd);
+	      }
+#endif /* !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
+
 	    if (as_info->cur_statement_pooling)
 	      {
 		hm_srv_handle_free_all ();
@@ -629,7 +697,7 @@ main (int argc, char *argv[])
 	    cas_log_error_handler_end ();
 #endif /* !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
 
-	    if (shm_appl->access_log == ON)
+	    if (shm_appl->access_log == ON && !client_parked)
 	      {
 		cas_access_log (&cas_start_time, shm_as_index,
 				client_ip_addr);
@@ -637,7 +705,10 @@ main (int argc, char *argv[])
 
 	  }
 
-	CLOSE_SOCKET (client_sock_fd);
+	if (!client_parked)
+	  {
+	    CLOSE_SOCKET (client_sock_fd);
+	  }
 
       error1:
 #if defined(WINDOWS)
@@ -654,6 +725,15 @@ main (int argc, char *argv[])
 	cas_error_log_close (true);
 #endif
 
+#if !defined(CAS_FOR_ORACLE) && !defined(CAS_FOR_MYSQL)
+	if (is_server_aborted ()
+	    || as_info->con_status != CON_STATUS_CLOSE_AND_CONNECT)
+	  {
+	    /* parked clients reconnect through the broker */
+	    cas_close_parked_sessions ();
+	  }
+#endif /* !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
+
 	if (is_server_aborted ())
 	  {
 	    as_info->uts_status = UTS_STATUS_RESTART;
@@ -666,7 +746,10 @@ main (int argc, char *argv[])
 	    if (restart_is_needed ())
 	      as_info->uts_status = UTS_STATUS_RESTART;
 	    else
-	      as_info->uts_status = UTS_STATUS_IDLE;
+	      {
+		as_info->uts_status = UTS_STATUS_IDLE;
+		uw_shm_push_idle_cas (shm_appl, shm_as_index);
+	      }
 	  }
 	cas_req_count++;
       }
@@ -828,6 +911,14 @@ process_request (SOCKET clt_sock_fd, T_NET_BUF * net_buf,
   if (err_code < 0)
     {
       const char *cas_log_msg = NULL;
+#if !defined(LIBCAS_FOR_JSP) && !defined(CAS_FOR_ORACLE) \
+  && !defined(CAS_FOR_MYSQL)
+      if (ready_session_index >= 0)
+	{
+	  /* a parked client is served next, the current one stays */
+	  return -1;
+	}
+#endif /* !LIBCAS_FOR_JSP && !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
       NET_WRITE_ERROR_CODE (clt_sock_fd, req_info->client_version,
 			    cas_msg_header.info_ptr, CAS_ERROR_INDICATOR,
 			    CAS_ER_COMMUNICATION);
@@ -1158,6 +1249,32 @@ net_read_int_keep_con_auto (SOCKET clt_sock_fd,
 	  break;
 	}
 
+#if !defined(CAS_FOR_ORACLE) && !defined(CAS_FOR_MYSQL)
+      if (as_info->con_status == CON_STATUS_OUT_TRAN
+	  && num_parked_sessions > 0)
+	{
+	  int ready = cas_wait_for_sessions (clt_sock_fd);
+
+	  if (ready >= 0)
+	    {
+	      ready_session_index = ready;
+	      new_req_sock_fd = INVALID_SOCKET;
+	      return -1;
+	    }
+	  else if (ready == CAS_WAIT_TIMEOUT)
+	    {
+	      if (restart_is_needed ())
+		{
+		  cas_log_debug (ARG_FILE_LINE, "net_read_int_keep_con_auto: "
+				 "restart_is_needed()");
+		  ret_value = -1;
+		  break;
+		}
+	      continue;
+	    }
+	}
+#endif /* !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
+
       if (net_read_header (clt_sock_fd, client_msg_header) < 0)
 	{
 	  /* if in-transaction state, return network error */
@@ -1215,6 +1332,318 @@ net_read_int_keep_con_auto (SOCKET clt_sock_fd,
 
   return ret_value;
 }
+
+#if !defined(CAS_FOR_ORACLE) && !defined(CAS_FOR_MYSQL)
+/*
+ * cas_park_session () - keep an idle client connected to this CAS
+ *   return: true if the client was parked
+ *   sock_fd(in): socket of the client
+ *   client_ip_addr(in): address of the client
+ *   start_time(in): time the client connected
+ *   db_name(in): database of the client
+ *   db_user(in): user of the client
+ *   db_passwd(in): password of the client
+ *
+ * Note: Only a client out of transaction which holds no server handle can
+ *   be parked. The handle ids it knows would be reused by the next client
+ *   otherwise.
+ */
+static bool
+cas_park_session (SOCKET sock_fd, int client_ip_addr,
+		  struct timeval *start_time, char *db_name, char *db_user,
+		  char *db_passwd)
+{
+  T_CAS_SESSION *session;
+
+  if (shm_appl->appl_server_max_sessions <= 1
+      || hm_srv_handle_count () > 0 || is_xa_prepared ())
+    {
+      return false;
+    }
+
+  if (parked_sessions == NULL)
+    {
+      max_parked_sessions = shm_appl->appl_server_max_sessions - 1;
+      parked_sessions =
+	(T_CAS_SESSION *) MALLOC (sizeof (T_CAS_SESSION) *
+				  max_parked_sessions);
+      if (parked_sessions == NULL)
+	{
+	  return false;
+	}
+    }
+
+  if (num_parked_sessions >= max_parked_sessions)
+    {
+      return false;
+    }
+
+  session = &parked_sessions[num_parked_sessions++];
+  session->sock_fd = sock_fd;
+  session->client_ip_addr = client_ip_addr;
+  session->clt_major_version = as_info->clt_major_version;
+  session->clt_minor_version = as_info->clt_minor_version;
+  session->clt_patch_version = as_info->clt_patch_version;
+  session->cas_client_type = as_info->cas_client_type;
+  ux_get_tran_setting (&session->lock_timeout, &session->isolation_level);
+  session->last_access_time = as_info->last_access_time;
+  session->start_time = *start_time;
+  strcpy (session->db_name, db_name);
+  strcpy (session->db_user, db_user);
+  strcpy (session->db_passwd, db_passwd);
+
+  cas_log_write_and_end (0, false, "PARK CLIENT %s, %d parked",
+			 as_info->clt_ip_addr, num_parked_sessions);
+
+  return true;
+}
+
+/*
+ * cas_close_parked_session () - disconnect a parked client
+ *   return: none
+ *   index(in): index of the client in parked_sessions
+ */
+static void
+cas_close_parked_session (int index)
+{
+  T_CAS_SESSION *session = &parked_sessions[index];
+
+  if (shm_appl->access_log == ON)
+    {
+      cas_access_log (&session->start_time, shm_as_index,
+		      session->client_ip_addr);
+    }
+  CLOSE_SOCKET (session->sock_fd);
+
+  parked_sessions[index] = parked_sessions[--num_parked_sessions];
+}
+
+/*
+ * cas_close_parked_sessions () - disconnect all the parked clients
+ *   return: none
+ */
+static void
+cas_close_parked_sessions (void)
+{
+  while (num_parked_sessions > 0)
+    {
+      cas_close_parked_session (num_parked_sessions - 1);
+    }
+  ready_session_index = -1;
+}
+
+/*
+ * cas_wait_for_sessions () - wait for a request from the current client or
+ *			      from a parked one
+ *   return: CAS_WAIT_CURRENT, CAS_WAIT_TIMEOUT, or the index of the parked
+ *	     client to serve
+ *   clt_sock_fd(in): socket of the current client
+ *
+ * Note: The current client wins over the parked ones. Among the parked
+ *   clients the one idle for the longest time is served first. Parked
+ *   clients idle for more than session_timeout are disconnected.
+ */
+static int
+cas_wait_for_sessions (SOCKET clt_sock_fd)
+{
+  fd_set read_mask;
+  struct timeval timeout_val;
+  SOCKET max_fd;
+  time_t cur_time;
+  int i, n, ready;
+
+  cur_time = time (NULL);
+  for (i = num_parked_sessions - 1; i >= 0; i--)
+    {
+      if (shm_appl->session_timeout >= 0
+	  && (cur_time - parked_sessions[i].last_access_time
+	      > shm_appl->session_timeout))
+	{
+	  cas_log_write_and_end (0, false, "SESSION TIMEOUT parked client");
+	  cas_close_parked_session (i);
+	}
+    }
+
+  FD_ZERO (&read_mask);
+  FD_SET (clt_sock_fd, &read_mask);
+  FD_SET (srv_sock_fd, &read_mask);
+  max_fd = (clt_sock_fd > srv_sock_fd) ? clt_sock_fd : srv_sock_fd;
+  for (i = 0; i < num_parked_sessions; i++)
+    {
+      FD_SET (parked_sessions[i].sock_fd, &read_mask);
+      if (parked_sessions[i].sock_fd > max_fd)
+	{
+	  max_fd = parked_sessions[i].sock_fd;
+	}
+    }
+
+  timeout_val.tv_sec = 1;
+  timeout_val.tv_usec = 0;
+  n = select ((int) max_fd + 1, &read_mask, NULL, NULL, &timeout_val);
+  if (n < 0)
+    {
+      /* let net_read_header() deal with it */
+      return CAS_WAIT_CURRENT;
+    }
+  if (n == 0)
+    {
+      return CAS_WAIT_TIMEOUT;
+    }
+
+  if (FD_ISSET (clt_sock_fd, &read_mask)
+      || FD_ISSET (srv_sock_fd, &read_mask))
+    {
+      return CAS_WAIT_CURRENT;
+    }
+
+  ready = CAS_WAIT_TIMEOUT;
+  for (i = 0; i < num_parked_sessions; i++)
+    {
+      if (FD_ISSET (parked_sessions[i].sock_fd, &read_mask)
+	  && (ready < 0
+	      || (parked_sessions[i].last_access_time
+		  < parked_sessions[ready].last_access_time)))
+	{
+	  ready = i;
+	}
+    }
+
+  return ready;
+}
+
+/*
+ * cas_end_session () - disconnect the current client
+ *   return: none
+ *   sock_fd(in): socket of the client
+ *   client_ip_addr(in): address of the client
+ *   start_time(in): time the client connected
+ */
+static void
+cas_end_session (SOCKET sock_fd, int client_ip_addr,
+		 struct timeval *start_time)
+{
+  if (as_info->cur_statement_pooling)
+    {
+      hm_srv_handle_free_all ();
+    }
+  ux_end_tran (CCI_TRAN_ROLLBACK, false);
+
+  CON_STATUS_LOCK (&(shm_appl->as_info[shm_as_index]), CON_STATUS_LOCK_CAS);
+  if (as_info->con_status == CON_STATUS_IN_TRAN)
+    {
+      as_info->con_status = CON_STATUS_OUT_TRAN;
+    }
+  CON_STATUS_UNLOCK (&(shm_appl->as_info[shm_as_index]), CON_STATUS_LOCK_CAS);
+
+  if (shm_appl->access_log == ON)
+    {
+      cas_access_log (start_time, shm_as_index, client_ip_addr);
+    }
+  CLOSE_SOCKET (sock_fd);
+  cas_log_write_and_end (0, true, "disconnect");
+}
+
+/*
+ * cas_switch_session () - make a parked client the current one
+ *   return: 0 if a parked client is now served, -1 otherwise
+ *   sock_fd(in/out): socket of the current client
+ *   client_ip_addr(in/out): address of the current client
+ *   start_time(in/out): time the current client connected
+ *   db_name(in/out): database of the current client
+ *   db_user(in/out): user of the current client
+ *   db_passwd(in/out): password of the current client
+ *
+ * Note: Called when process_request() gives up the current client, either
+ *   because a parked client sent a request between two transactions of the
+ *   current one, or because the current client went away. A client still
+ *   connected is parked in turn if it can be, and disconnected otherwise.
+ *   Nothing is switched when the CAS has to hand over to the broker, reset
+ *   or restart.
+ */
+static int
+cas_switch_session (SOCKET * sock_fd, int *client_ip_addr,
+		    struct timeval *start_time, char *db_name,
+		    char *db_user, char *db_passwd)
+{
+  T_CAS_SESSION session;
+  int index, lock_timeout, isolation_level;
+  char *t;
+
+  index = ready_session_index;
+  ready_session_index = -1;
+
+  if (num_parked_sessions == 0
+      || as_info->con_status == CON_STATUS_CLOSE
+      || as_info->con_status == CON_STATUS_CLOSE_AND_CONNECT
+      || as_info->reset_flag == TRUE || is_server_aborted ()
+      || is_xa_prepared () || restart_is_needed ())
+    {
+      return -1;
+    }
+
+  /* take the parked client out first so that its slot can be reused */
+  session = parked_sessions[(index >= 0) ? index : 0];
+  parked_sessions[(index >= 0) ? index : 0] =
+    parked_sessions[--num_parked_sessions];
+
+  if (index < 0
+      || !cas_park_session (*sock_fd, *client_ip_addr, start_time,
+			    db_name, db_user, db_passwd))
+    {
+      cas_end_session (*sock_fd, *client_ip_addr, start_time);
+    }
+
+  *sock_fd = session.sock_fd;
+  *client_ip_addr = session.client_ip_addr;
+  *start_time = session.start_time;
+
+  as_info->clt_major_version = session.clt_major_version;
+  as_info->clt_minor_version = session.clt_minor_version;
+  as_info->clt_patch_version = session.clt_patch_version;
+  as_info->cas_client_type = session.cas_client_type;
+  cas_client_type = session.cas_client_type;
+  req_info.client_version =
+    CAS_MAKE_VER (session.clt_major_version, session.clt_minor_version,
+		  session.clt_patch_version);
+  set_cas_info_size ();
+
+  t = ut_uchar2ipstr ((unsigned char *) client_ip_addr);
+  strncpy (as_info->clt_ip_addr, t, 19);
+  cas_log_write_and_end (0, false, "RESUME CLIENT %s", t);
+
+  if (strcmp (db_name, session.db_name) != 0
+      || strcmp (db_user, session.db_user) != 0
+      || strcmp (db_passwd, session.db_passwd) != 0)
+    {
+      strcpy (db_name, session.db_name);
+      strcpy (db_user, session.db_user);
+      strcpy (db_passwd, session.db_passwd);
+      if (ux_database_connect (db_name, db_user, db_passwd, NULL) < 0)
+	{
+	  return -1;
+	}
+      cas_log_write_and_end (0, false, "connect db %s user %s", db_name,
+			     db_user);
+    }
+
+  ux_get_tran_setting (&lock_timeout, &isolation_level);
+  if (isolation_level != session.isolation_level)
+    {
+      ux_set_isolation_level (session.isolation_level, NULL);
+    }
+  if (lock_timeout != session.lock_timeout)
+    {
+      ux_set_lock_timeout (session.lock_timeout);
+    }
+
+  req_info.need_rollback = TRUE;
+  errors_in_transaction = 0;
+  prev_cas_info[CAS_INFO_STATUS] = CAS_INFO_RESERVED_DEFAULT;
+  as_info->last_access_time = time (NULL);
+
+  return 0;
+}
+#endif /* !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
 #endif /* !LIBCAS_FOR_JSP */
 
 void
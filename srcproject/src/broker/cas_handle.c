@@ -167,6 +167,22 @@ hm_srv_handle_free_all ()
   max_handle_id = 0;
 }
 
+int
+hm_srv_handle_count ()
+{
+  int i, count = 0;
+
+  for (i = 0; i < max_handle_id; i++)
+    {
+      if (srv_handle_table[i] != NULL)
+	{
+	  count++;
+	}
+    }
+
+  return count;
+}
+
 #if defined (ENABLE_UNUSED_FUNCTION)
 void
 hm_srv_handle_set_pooled ()
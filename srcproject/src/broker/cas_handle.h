@@ -179,6 +179,7 @@ extern int hm_new_srv_handle (T_SRV_HANDLE ** new_handle,
 			      unsigned int seq_num);
 extern void hm_srv_handle_free (int h_id);
 extern void hm_srv_handle_free_all (void);
+extern int hm_srv_handle_count (void);
 extern T_SRV_HANDLE *hm_find_srv_handle (int h_id);
 extern void hm_qresult_clear (T_QUERY_RESULT * q_result);
 extern void hm_qresult_end (T_SRV_HANDLE * srv_handle, char free_flag);
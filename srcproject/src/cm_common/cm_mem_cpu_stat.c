@@ -959,6 +959,37 @@ static STATDUMP_PROP statdump_offset[] = {
   {"Num_adaptive_flush_log_pages",
    offsetof (T_CM_DB_EXEC_STAT, fc_num_log_pages)},
   {"Num_adaptive_flush_max_pages", offsetof (T_CM_DB_EXEC_STAT, fc_tokens)},
+  {"Num_data_page_hash_opt_hits",
+   offsetof (T_CM_DB_EXEC_STAT, pb_num_hash_opt_hits)},
+  {"Num_data_page_hash_opt_retries",
+   offsetof (T_CM_DB_EXEC_STAT, pb_num_hash_opt_retries)},
+  {"Num_data_page_hash_opt_fallbacks",
+   offsetof (T_CM_DB_EXEC_STAT, pb_num_hash_opt_fallbacks)},
+  {"Num_data_page_lru_victims",
+   offsetof (T_CM_DB_EXEC_STAT, pb_num_lru_victims)},
+  {"Num_data_page_lru_steals",
+   offsetof (T_CM_DB_EXEC_STAT, pb_num_lru_steals)},
+  {"Num_data_page_lru_victim_search",
+   offsetof (T_CM_DB_EXEC_STAT, pb_num_lru_victim_search)},
+  {"Num_data_page_prefetch_requests",
+   offsetof (T_CM_DB_EXEC_STAT, pb_num_prefetch_requests)},
+  {"Num_data_page_prefetch_reads",
+   offsetof (T_CM_DB_EXEC_STAT, pb_num_prefetch_reads)},
+  {"Num_deadlock_detected_within_1ms",
+   offsetof (T_CM_DB_EXEC_STAT, lk_num_dl_detect_1ms)},
+  {"Num_deadlock_detected_within_10ms",
+   offsetof (T_CM_DB_EXEC_STAT, lk_num_dl_detect_10ms)},
+  {"Num_deadlock_detected_within_100ms",
+   offsetof (T_CM_DB_EXEC_STAT, lk_num_dl_detect_100ms)},
+  {"Num_deadlock_detected_within_1s",
+   offsetof (T_CM_DB_EXEC_STAT, lk_num_dl_detect_1s)},
+  {"Num_deadlock_detected_over_1s",
+   offsetof (T_CM_DB_EXEC_STAT, lk_num_dl_detect_over_1s)},
+  {"Num_sort_parallel_runs",
+   offsetof (T_CM_DB_EXEC_STAT, sort_num_parallel_runs)},
+  {"Num_query_parallel_scans",
+   offsetof (T_CM_DB_EXEC_STAT, qm_num_parallel_scans)},
+  {"Num_query_spill_pages", offsetof (T_CM_DB_EXEC_STAT, qm_num_spill_pages)},
   {"Data_page_buffer_hit_ratio", offsetof (T_CM_DB_EXEC_STAT, pb_hit_ratio)},
 };
 
@@ -325,6 +325,36 @@ extern "C"
     unsigned int fc_num_log_pages;
     unsigned int fc_num_pages;
     unsigned int fc_tokens;
+
+    /* page buffer hash chain lookup */
+    unsigned int pb_num_hash_opt_hits;
+    unsigned int pb_num_hash_opt_retries;
+    unsigned int pb_num_hash_opt_fallbacks;
+
+    /* page buffer LRU shard victim selection */
+    unsigned int pb_num_lru_victims;
+    unsigned int pb_num_lru_steals;
+    unsigned int pb_num_lru_victim_search;
+
+    /* Execution statistics for page read-ahead */
+    unsigned int pb_num_prefetch_requests;
+    unsigned int pb_num_prefetch_reads;
+
+    /* Deadlock time-to-detect histogram */
+    unsigned int lk_num_dl_detect_1ms;
+    unsigned int lk_num_dl_detect_10ms;
+    unsigned int lk_num_dl_detect_100ms;
+    unsigned int lk_num_dl_detect_1s;
+    unsigned int lk_num_dl_detect_over_1s;
+
+    /* Sort statistics */
+    unsigned int sort_num_parallel_runs;
+
+    /* Parallel scan */
+    unsigned int qm_num_parallel_scans;
+
+    /* Query work memory */
+    unsigned int qm_num_spill_pages;
   } T_CM_DB_EXEC_STAT;
 
   int cm_get_db_proc_stat (const char *db_name, T_CM_DB_PROC_STAT * stat,
@@ -148,6 +148,38 @@ net_pack_stats (char *buf, MNT_SERVER_EXEC_STATS * stats)
   ptr += OR_INT_SIZE;
   OR_PUT_INT (ptr, stats->fc_tokens);
   ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->pb_num_hash_opt_hits);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->pb_num_hash_opt_retries);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->pb_num_hash_opt_fallbacks);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->pb_num_lru_victims);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->pb_num_lru_steals);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->pb_num_lru_victim_search);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->pb_num_prefetch_requests);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->pb_num_prefetch_reads);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->lk_num_dl_detect_1ms);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->lk_num_dl_detect_10ms);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->lk_num_dl_detect_100ms);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->lk_num_dl_detect_1s);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->lk_num_dl_detect_over_1s);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->sort_num_parallel_runs);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->qm_num_parallel_scans);
+  ptr += OR_INT_SIZE;
+  OR_PUT_INT (ptr, stats->qm_num_spill_pages);
+  ptr += OR_INT_SIZE;
   OR_PUT_INT (ptr, stats->pb_hit_ratio);
   ptr += OR_INT_SIZE;
 
@@ -270,6 +302,38 @@ net_unpack_stats (char *buf, MNT_SERVER_EXEC_STATS * stats)
   ptr += OR_INT_SIZE;
   stats->fc_tokens = OR_GET_INT (ptr);
   ptr += OR_INT_SIZE;
+  stats->pb_num_hash_opt_hits = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->pb_num_hash_opt_retries = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->pb_num_hash_opt_fallbacks = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->pb_num_lru_victims = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->pb_num_lru_steals = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->pb_num_lru_victim_search = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->pb_num_prefetch_requests = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->pb_num_prefetch_reads = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->lk_num_dl_detect_1ms = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->lk_num_dl_detect_10ms = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->lk_num_dl_detect_100ms = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->lk_num_dl_detect_1s = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->lk_num_dl_detect_over_1s = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->sort_num_parallel_runs = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->qm_num_parallel_scans = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
+  stats->qm_num_spill_pages = OR_GET_INT (ptr);
+  ptr += OR_INT_SIZE;
   stats->pb_hit_ratio = OR_GET_INT (ptr);
   ptr += OR_INT_SIZE;
 
@@ -391,6 +455,38 @@ net_pack_global_stats (char *buf, MNT_SERVER_EXEC_GLOBAL_STATS * stats)
   ptr += OR_INT64_SIZE;
   OR_PUT_INT64 (ptr, stats->fc_tokens);
   ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->pb_num_hash_opt_hits);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->pb_num_hash_opt_retries);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->pb_num_hash_opt_fallbacks);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->pb_num_lru_victims);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->pb_num_lru_steals);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->pb_num_lru_victim_search);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->pb_num_prefetch_requests);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->pb_num_prefetch_reads);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->lk_num_dl_detect_1ms);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->lk_num_dl_detect_10ms);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->lk_num_dl_detect_100ms);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->lk_num_dl_detect_1s);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->lk_num_dl_detect_over_1s);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->sort_num_parallel_runs);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->qm_num_parallel_scans);
+  ptr += OR_INT64_SIZE;
+  OR_PUT_INT64 (ptr, stats->qm_num_spill_pages);
+  ptr += OR_INT64_SIZE;
   OR_PUT_INT64 (ptr, stats->pb_hit_ratio);
   ptr += OR_INT64_SIZE;
 
@@ -511,6 +607,38 @@ net_unpack_global_stats (char *buf, MNT_SERVER_EXEC_GLOBAL_STATS * stats)
   ptr += OR_INT64_SIZE;
   stats->fc_tokens = OR_GET_INT64 (ptr);
   ptr += OR_INT64_SIZE;
+  stats->pb_num_hash_opt_hits = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->pb_num_hash_opt_retries = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->pb_num_hash_opt_fallbacks = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->pb_num_lru_victims = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->pb_num_lru_steals = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->pb_num_lru_victim_search = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->pb_num_prefetch_requests = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->pb_num_prefetch_reads = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->lk_num_dl_detect_1ms = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->lk_num_dl_detect_10ms = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->lk_num_dl_detect_100ms = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->lk_num_dl_detect_1s = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->lk_num_dl_detect_over_1s = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->sort_num_parallel_runs = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->qm_num_parallel_scans = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
+  stats->qm_num_spill_pages = OR_GET_INT64 (ptr);
+  ptr += OR_INT64_SIZE;
   stats->pb_hit_ratio = OR_GET_INT64 (ptr);
   ptr += OR_INT64_SIZE;
 
@@ -222,6 +222,13 @@ enum net_server_request
   NET_SERVER_SERIAL_GET_CACHE_RANGE,
 
   NET_SERVER_LOG_SET_SUPPRESS_REPL_ON_TRANSACTION,
+
+  NET_SERVER_QM_QUERY_SET_PROFILE,
+  NET_SERVER_QM_QUERY_DUMP_PROFILE,
+
+  NET_SERVER_MNT_SERVER_COPY_LATENCY_STATS,
+
+  NET_SERVER_BATCH,
   /*
    * This is the last entry. It is also used for the end of an
    * array of statistics information on client/server communication.
@@ -241,6 +248,18 @@ enum net_server_request
   NET_SERVER_PING_WITH_HANDSHAKE = 999,
 };
 
+/*
+ * Requests which may be packed into one NET_SERVER_BATCH request.
+ * Each of them must send exactly one reply to the client.
+ */
+#define NET_IS_BATCHABLE_REQUEST(request) \
+  ((request) == NET_SERVER_QM_QUERY_END \
+   || (request) == NET_SERVER_LC_FIND_CLASSOID \
+   || (request) == NET_SERVER_SERIAL_GET_REAL_OID)
+
+/* max number of requests in one NET_SERVER_BATCH request */
+#define NET_BATCH_MAX_REQUESTS 64
+
 /* Server/client capabilities */
 #define NET_CAP_BACKWARD_COMPATIBLE     0x80000000
 #define NET_CAP_FORWARD_COMPATIBLE      0x40000000
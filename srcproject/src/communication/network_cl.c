@@ -645,6 +645,14 @@ net_histo_setup_names (void)
     "NET_SERVER_QM_QUERY_DUMP_PLANS";
   net_Req_buffer[NET_SERVER_QM_QUERY_DUMP_CACHE].name =
     "NET_SERVER_QM_QUERY_DUMP_CACHE";
+  net_Req_buffer[NET_SERVER_QM_QUERY_SET_PROFILE].name =
+    "NET_SERVER_QM_QUERY_SET_PROFILE";
+  net_Req_buffer[NET_SERVER_QM_QUERY_DUMP_PROFILE].name =
+    "NET_SERVER_QM_QUERY_DUMP_PROFILE";
+
+  net_Req_buffer[NET_SERVER_MNT_SERVER_COPY_LATENCY_STATS].name =
+    "NET_SERVER_MNT_SERVER_COPY_LATENCY_STATS";
+  net_Req_buffer[NET_SERVER_BATCH].name = "NET_SERVER_BATCH";
 
   net_Req_buffer[NET_SERVER_LS_GET_LIST_FILE_PAGE].name =
     "NET_SERVER_LS_GET_LIST_FILE_PAGE";
@@ -1149,6 +1157,32 @@ net_client_request (int request, char *argbuf, int argsize, char *replybuf,
       /* skip to send SERVER_QM_QUERY_END request */
       save_query_id = NULL_QUERY_ID;
     }
+  else if (save_query_id != NULL_QUERY_ID
+	   && NET_IS_BATCHABLE_REQUEST (request)
+	   && databuf == NULL && replydata == NULL)
+    {
+      NET_BATCH_REQUEST batch[2];
+      OR_ALIGNED_BUF (OR_PTR_SIZE) a_request;
+      OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
+
+      /* send the delayed SERVER_QM_QUERY_END request along with this one */
+      (void) or_pack_ptr (OR_ALIGNED_BUF_START (a_request), save_query_id);
+      save_query_id = NULL_QUERY_ID;
+
+      batch[0].request = NET_SERVER_QM_QUERY_END;
+      batch[0].argbuf = OR_ALIGNED_BUF_START (a_request);
+      batch[0].argsize = OR_ALIGNED_BUF_SIZE (a_request);
+      batch[0].replybuf = OR_ALIGNED_BUF_START (a_reply);
+      batch[0].replysize = OR_ALIGNED_BUF_SIZE (a_reply);
+
+      batch[1].request = request;
+      batch[1].argbuf = argbuf;
+      batch[1].argsize = argsize;
+      batch[1].replybuf = replybuf;
+      batch[1].replysize = replysize;
+
+      return net_client_request_batch (2, batch);
+    }
   else if (save_query_id != NULL_QUERY_ID)
     {
       int status = ER_FAILED;
@@ -1187,6 +1221,128 @@ net_client_request (int request, char *argbuf, int argsize, char *replybuf,
 				       replydata, replydatasize));
 }
 
+/*
+ * net_client_request_batch -
+ *
+ * return: error status
+ *
+ *   num_requests(in): number of requests
+ *   requests(in/out): requests and their reply buffers
+ *
+ * Note: The requests are packed into one NET_SERVER_BATCH request, which the
+ *    server serves in order, and all replies are received in one round trip.
+ *    Only requests for which NET_IS_BATCHABLE_REQUEST() is true, and which
+ *    send no data buffer and expect one reply, may be batched.
+ */
+int
+net_client_request_batch (int num_requests, NET_BATCH_REQUEST * requests)
+{
+  unsigned int rc;
+  int request_size, size, error, req_error, i;
+  char *request, *ptr, *reply;
+
+  if (num_requests == 1)
+    {
+      return (net_client_request_internal (requests[0].request,
+					   requests[0].argbuf,
+					   requests[0].argsize,
+					   requests[0].replybuf,
+					   requests[0].replysize,
+					   NULL, 0, NULL, 0));
+    }
+
+  if (net_Server_name[0] == '\0')
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_NET_SERVER_CRASHED, 0);
+      return -1;
+    }
+
+  assert (num_requests > 1 && num_requests <= NET_BATCH_MAX_REQUESTS);
+
+  request_size = OR_INT_SIZE;
+  for (i = 0; i < num_requests; i++)
+    {
+      assert (NET_IS_BATCHABLE_REQUEST (requests[i].request));
+      request_size = (DB_ALIGN (request_size, MAX_ALIGNMENT)
+		      + OR_INT_SIZE * 2 + requests[i].argsize);
+    }
+
+  request = (char *) malloc (request_size);
+  if (request == NULL)
+    {
+      return set_server_error (CANT_ALLOC_BUFFER);
+    }
+  memset (request, 0, request_size);
+
+  ptr = or_pack_int (request, num_requests);
+  for (i = 0; i < num_requests; i++)
+    {
+      ptr = PTR_ALIGN (ptr, MAX_ALIGNMENT);
+      ptr = or_pack_int (ptr, requests[i].request);
+      ptr = or_pack_int (ptr, requests[i].argsize);
+      if (requests[i].argsize > 0)
+	{
+	  memcpy (ptr, requests[i].argbuf, requests[i].argsize);
+	  ptr += requests[i].argsize;
+	}
+#if defined(HISTO)
+      if (net_Histo_setup)
+	{
+	  net_histo_add_entry (requests[i].request, requests[i].argsize);
+	}
+#endif /* HISTO */
+    }
+
+  rc = css_send_req_to_server (net_Server_host, NET_SERVER_BATCH,
+			       request, request_size, NULL, 0, NULL, 0);
+  free_and_init (request);
+  if (rc == 0)
+    {
+      return set_server_error (css_Errno);
+    }
+
+  /*
+   * The replies come in the order of the requests. They are received into
+   * buffers allocated by the connection layer, so that nothing is left
+   * queued on the request id if the batch is cut short.
+   */
+  error = NO_ERROR;
+  for (i = 0; i < num_requests; i++)
+    {
+      reply = NULL;
+      req_error = css_receive_data_from_server (rc, &reply, &size);
+      if (req_error != NO_ERROR)
+	{
+	  if (reply != NULL)
+	    {
+	      free_and_init (reply);
+	    }
+	  return set_server_error (req_error);
+	}
+
+      if (size != requests[i].replysize && error == NO_ERROR)
+	{
+	  error = ER_NET_DATASIZE_MISMATCH;
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error, 2,
+		  requests[i].replysize, size);
+	}
+      if (reply != NULL)
+	{
+	  memcpy (requests[i].replybuf, reply,
+		  MIN (size, requests[i].replysize));
+	  free_and_init (reply);
+	}
+#if defined(HISTO)
+      if (net_Histo_setup)
+	{
+	  net_histo_request_finished (requests[i].request, size);
+	}
+#endif /* HISTO */
+    }
+
+  return error;
+}
+
 #if defined(ENABLE_UNUSED_FUNCTION)
 /*
  * net_client_request_send_large_data -
@@ -6229,6 +6229,92 @@ qmgr_dump_query_cache (FILE * outfp)
 #endif /* !CS_MODE */
 }
 
+/*
+ * qmgr_set_query_profile - Turn the profile of the following queries on
+ *                          or off
+ *
+ * return: NO_ERROR, or ER_code
+ *
+ *   on(in):
+ *
+ * NOTE:
+ */
+int
+qmgr_set_query_profile (bool on)
+{
+#if defined(CS_MODE)
+  int status = ER_FAILED;
+  int req_error;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_request;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
+  char *request;
+  char *reply;
+
+  request = OR_ALIGNED_BUF_START (a_request);
+  reply = OR_ALIGNED_BUF_START (a_reply);
+
+  or_pack_int (request, (int) on);
+  req_error = net_client_request (NET_SERVER_QM_QUERY_SET_PROFILE,
+				  request, OR_ALIGNED_BUF_SIZE (a_request),
+				  reply, OR_ALIGNED_BUF_SIZE (a_reply),
+				  NULL, 0, NULL, 0);
+  if (!req_error)
+    {
+      or_unpack_int (reply, &status);
+    }
+
+  return status;
+#else /* CS_MODE */
+  int status;
+
+  ENTER_SERVER ();
+
+  status = xqmgr_set_query_profile (NULL, on);
+
+  EXIT_SERVER ();
+
+  return status;
+#endif /* !CS_MODE */
+}
+
+/*
+ * qmgr_dump_query_profile - Dump the profile of the last query
+ *
+ * return:
+ *
+ *   outfp(in):
+ *
+ * NOTE:
+ */
+void
+qmgr_dump_query_profile (FILE * outfp)
+{
+#if defined(CS_MODE)
+  int req_error;
+
+  if (outfp == NULL)
+    {
+      outfp = stdout;
+    }
+
+  req_error =
+    net_client_request_recv_stream (NET_SERVER_QM_QUERY_DUMP_PROFILE, NULL,
+				    0, NULL, 0, NULL, 0, outfp);
+#else /* CS_MODE */
+
+  if (outfp == NULL)
+    {
+      outfp = stdout;
+    }
+
+  ENTER_SERVER ();
+
+  xqmgr_dump_query_profile (NULL, outfp);
+
+  EXIT_SERVER ();
+#endif /* !CS_MODE */
+}
+
 /*
  * qmgr_get_query_info -
  *
@@ -6861,6 +6947,56 @@ mnt_server_copy_global_stats (MNT_SERVER_EXEC_GLOBAL_STATS * to_stats)
 #endif /* !CS_MODE */
 }
 
+/*
+ * mnt_server_copy_latency_stats -
+ *
+ * return: NO_ERROR or error code
+ *
+ *   to_stats(out): free with mnt_lat_free_stats ()
+ *
+ * NOTE:
+ */
+int
+mnt_server_copy_latency_stats (MNT_LAT_STATS * to_stats)
+{
+  int error;
+  int length = 0;
+  char *area = NULL;
+#if defined(CS_MODE)
+  int req_error;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
+  char *reply;
+
+  reply = OR_ALIGNED_BUF_START (a_reply);
+
+  req_error = net_client_request2 (NET_SERVER_MNT_SERVER_COPY_LATENCY_STATS,
+				   NULL, 0, reply,
+				   OR_ALIGNED_BUF_SIZE (a_reply),
+				   NULL, 0, &area, &length);
+  if (req_error)
+    {
+      to_stats->num_histograms = 0;
+      to_stats->histograms = NULL;
+      return ER_FAILED;
+    }
+#else /* CS_MODE */
+
+  ENTER_SERVER ();
+
+  area = xmnt_server_copy_latency_stats (NULL, &length);
+
+  EXIT_SERVER ();
+#endif /* !CS_MODE */
+
+  error = mnt_lat_unpack_stats (area, length, to_stats);
+  if (area != NULL)
+    {
+      free_and_init (area);
+    }
+
+  return error;
+}
+
 /*
  * catalog_is_acceptable_new_representation -
  *
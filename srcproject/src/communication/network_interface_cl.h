@@ -40,6 +40,17 @@
 #include "connection_defs.h"
 #include "log_writer.h"
 
+/* one request of a NET_SERVER_BATCH request */
+typedef struct net_batch_request NET_BATCH_REQUEST;
+struct net_batch_request
+{
+  int request;			/* NET_SERVER_xxx */
+  char *argbuf;			/* argument buffer */
+  int argsize;			/* size of argbuf */
+  char *replybuf;		/* reply buffer */
+  int replysize;		/* size of expected reply */
+};
+
 typedef struct server_info SERVER_INFO;
 struct server_info
 {
@@ -319,6 +330,8 @@ extern int qmgr_drop_query_plan (const char *query_str, const OID * user_oid,
 extern int qmgr_drop_all_query_plans (void);
 extern void qmgr_dump_query_plans (FILE * outfp);
 extern void qmgr_dump_query_cache (FILE * outfp);
+extern int qmgr_set_query_profile (bool on);
+extern void qmgr_dump_query_profile (FILE * outfp);
 extern int qmgr_get_query_info (DB_QUERY_RESULT * query_result, int *done,
 				int *count, int *error, char **error_string);
 extern int qmgr_sync_query (DB_QUERY_RESULT * query_result, int wait);
@@ -336,6 +349,7 @@ extern void mnt_server_reset_global_stats (void);
 extern void mnt_server_copy_stats (MNT_SERVER_EXEC_STATS * to_stats);
 extern void mnt_server_copy_global_stats (MNT_SERVER_EXEC_GLOBAL_STATS *
 					  to_stats);
+extern int mnt_server_copy_latency_stats (MNT_LAT_STATS * to_stats);
 extern int catalog_is_acceptable_new_representation (OID * class_id,
 						     HFID * hfid,
 						     int *can_accept);
@@ -383,6 +397,8 @@ extern int net_client_request (int request, char *argbuf, int argsize,
 			       char *replybuf, int replysize, char *databuf,
 			       int datasize, char *replydata,
 			       int replydatasize);
+extern int net_client_request_batch (int num_requests,
+				     NET_BATCH_REQUEST * requests);
 #if defined(ENABLE_UNUSED_FUNCTION)
 extern int net_client_request_send_large_data (int request, char *argbuf,
 					       int argsize, char *replybuf,
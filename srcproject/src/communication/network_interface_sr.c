@@ -5603,6 +5603,123 @@ sqmgr_dump_query_plans (THREAD_ENTRY * thread_p, unsigned int rid,
   db_private_free_and_init (thread_p, buffer);
 }
 
+/*
+ * sqmgr_set_query_profile -
+ *
+ * return:
+ *
+ *   rid(in):
+ *   request(in):
+ *   reqlen(in):
+ *
+ * NOTE:
+ */
+void
+sqmgr_set_query_profile (THREAD_ENTRY * thread_p, unsigned int rid,
+			 char *request, int reqlen)
+{
+  int status, on;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
+  char *reply = OR_ALIGNED_BUF_START (a_reply);
+
+  (void) or_unpack_int (request, &on);
+
+  status = xqmgr_set_query_profile (thread_p, (bool) on);
+  if (status != NO_ERROR)
+    {
+      return_error_to_client (thread_p, rid);
+    }
+
+  (void) or_pack_int (reply, status);
+  css_send_data_to_client (thread_p->conn_entry, rid, reply,
+			   OR_ALIGNED_BUF_SIZE (a_reply));
+}
+
+/*
+ * sqmgr_dump_query_profile -
+ *
+ * return:
+ *
+ *   rid(in):
+ *   request(in):
+ *   reqlen(in):
+ *
+ * NOTE:
+ */
+void
+sqmgr_dump_query_profile (THREAD_ENTRY * thread_p, unsigned int rid,
+			  char *request, int reqlen)
+{
+  FILE *outfp;
+  int file_size;
+  char *buffer;
+  int buffer_size;
+  int send_size;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
+  char *reply = OR_ALIGNED_BUF_START (a_reply);
+
+  (void) or_unpack_int (request, &buffer_size);
+
+  buffer = (char *) db_private_alloc (thread_p, buffer_size);
+  if (buffer == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY,
+	      1, buffer_size);
+      css_send_abort_to_client (thread_p->conn_entry, rid);
+      return;
+    }
+
+  outfp = tmpfile ();
+  if (outfp == NULL)
+    {
+      er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			   ER_GENERIC_ERROR, 0);
+      css_send_abort_to_client (thread_p->conn_entry, rid);
+      db_private_free_and_init (thread_p, buffer);
+      return;
+    }
+
+  xqmgr_dump_query_profile (thread_p, outfp);
+  file_size = ftell (outfp);
+
+  /*
+   * Send the file in pieces
+   */
+  rewind (outfp);
+
+  (void) or_pack_int (reply, (int) file_size);
+  css_send_data_to_client (thread_p->conn_entry, rid, reply,
+			   OR_ALIGNED_BUF_SIZE (a_reply));
+
+  while (file_size > 0)
+    {
+      if (file_size > buffer_size)
+	{
+	  send_size = buffer_size;
+	}
+      else
+	{
+	  send_size = file_size;
+	}
+
+      file_size -= send_size;
+      if (fread (buffer, 1, send_size, outfp) == 0)
+	{
+	  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			       ER_GENERIC_ERROR, 0);
+	  css_send_abort_to_client (thread_p->conn_entry, rid);
+	  /*
+	   * Continue sending the stuff that was prmoised to client. In this case
+	   * junk (i.e., whatever it is in the buffers) is sent.
+	   */
+	}
+      css_send_data_to_client (thread_p->conn_entry, rid, buffer, send_size);
+    }
+
+  fclose (outfp);
+  db_private_free_and_init (thread_p, buffer);
+}
+
 /*
  * sqmgr_dump_query_cache -
  *
@@ -6263,6 +6380,42 @@ smnt_server_copy_global_stats (THREAD_ENTRY * thread_p, unsigned int rid,
 			   OR_ALIGNED_BUF_SIZE (a_reply));
 }
 
+/*
+ * smnt_server_copy_latency_stats -
+ *
+ * return:
+ *
+ *   rid(in):
+ *   request(in):
+ *   reqlen(in):
+ *
+ * NOTE:
+ */
+void
+smnt_server_copy_latency_stats (THREAD_ENTRY * thread_p, unsigned int rid,
+				char *request, int reqlen)
+{
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
+  char *reply = OR_ALIGNED_BUF_START (a_reply);
+  char *buffer;
+  int buffer_length;
+
+  buffer = xmnt_server_copy_latency_stats (thread_p, &buffer_length);
+  if (buffer == NULL)
+    {
+      buffer_length = 0;
+    }
+
+  (void) or_pack_int (reply, buffer_length);
+  css_send_reply_and_data_to_client (thread_p->conn_entry, rid, reply,
+				     OR_ALIGNED_BUF_SIZE (a_reply), buffer,
+				     buffer_length);
+  if (buffer != NULL)
+    {
+      free_and_init (buffer);
+    }
+}
+
 /*
  * sct_can_accept_new_repr -
  *
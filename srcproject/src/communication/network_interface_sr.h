@@ -282,6 +282,12 @@ extern void sqmgr_dump_query_plans (THREAD_ENTRY * thread_p, unsigned int rid,
 				    char *request, int reqlen);
 extern void sqmgr_dump_query_cache (THREAD_ENTRY * thread_p, unsigned int rid,
 				    char *request, int reqlen);
+extern void sqmgr_set_query_profile (THREAD_ENTRY * thread_p,
+				     unsigned int rid, char *request,
+				     int reqlen);
+extern void sqmgr_dump_query_profile (THREAD_ENTRY * thread_p,
+				      unsigned int rid, char *request,
+				      int reqlen);
 extern void sqmgr_get_query_info (THREAD_ENTRY * thread_p, unsigned int rid,
 				  char *request, int reqlen);
 extern void sqmgr_sync_query (THREAD_ENTRY * thread_p, unsigned int rid,
@@ -316,6 +322,9 @@ extern void smnt_server_copy_stats (THREAD_ENTRY * thread_p, unsigned int rid,
 extern void smnt_server_copy_global_stats (THREAD_ENTRY * thread_p,
 					   unsigned int rid, char *request,
 					   int reqlen);
+extern void smnt_server_copy_latency_stats (THREAD_ENTRY * thread_p,
+					    unsigned int rid, char *request,
+					    int reqlen);
 extern void sct_can_accept_new_repr (THREAD_ENTRY * thread_p,
 				     unsigned int rid, char *request,
 				     int reqlen);
@@ -83,6 +83,11 @@ static void net_server_histo_add_entry (int request, int data_sent);
 #endif /* CUBRID_DEBUG */
 
 static void net_server_init (void);
+static int net_server_call_request (THREAD_ENTRY * thread_p,
+				    unsigned int rid, int request, int size,
+				    char *buffer);
+static void net_server_batch (THREAD_ENTRY * thread_p, unsigned int rid,
+			      char *request, int reqlen);
 static int net_server_request (THREAD_ENTRY * thread_p, unsigned int rid,
 			       int request, int size, char *buffer);
 static int net_server_conn_down (THREAD_ENTRY * thread_p, CSS_THREAD_ARG arg);
@@ -858,6 +863,18 @@ net_server_init (void)
   net_Requests[NET_SERVER_QM_QUERY_DUMP_CACHE].name =
     "NET_SERVER_QM_QUERY_DUMP_CACHE";
 
+  net_Requests[NET_SERVER_QM_QUERY_SET_PROFILE].action_attribute = 0;
+  net_Requests[NET_SERVER_QM_QUERY_SET_PROFILE].processing_function =
+    sqmgr_set_query_profile;
+  net_Requests[NET_SERVER_QM_QUERY_SET_PROFILE].name =
+    "NET_SERVER_QM_QUERY_SET_PROFILE";
+
+  net_Requests[NET_SERVER_QM_QUERY_DUMP_PROFILE].action_attribute = 0;
+  net_Requests[NET_SERVER_QM_QUERY_DUMP_PROFILE].processing_function =
+    sqmgr_dump_query_profile;
+  net_Requests[NET_SERVER_QM_QUERY_DUMP_PROFILE].name =
+    "NET_SERVER_QM_QUERY_DUMP_PROFILE";
+
   /*
    * query file
    */
@@ -1064,6 +1081,24 @@ net_server_init (void)
     smnt_server_reset_global_stats;
   net_Requests[NET_SERVER_MNT_SERVER_RESET_GLOBAL_STATS].name =
     "NET_SERVER_MNT_SERVER_RESET_GLOBAL_STATS";
+
+  net_Requests[NET_SERVER_MNT_SERVER_COPY_LATENCY_STATS].action_attribute =
+    CHECK_AUTHORIZATION;
+  net_Requests[NET_SERVER_MNT_SERVER_COPY_LATENCY_STATS].processing_function =
+    smnt_server_copy_latency_stats;
+  net_Requests[NET_SERVER_MNT_SERVER_COPY_LATENCY_STATS].name =
+    "NET_SERVER_MNT_SERVER_COPY_LATENCY_STATS";
+
+  net_Requests[NET_SERVER_BATCH].processing_function = net_server_batch;
+  net_Requests[NET_SERVER_BATCH].name = "NET_SERVER_BATCH";
+
+  for (i = 0; i < DIM (net_Requests); i++)
+    {
+      if (net_Requests[i].processing_function != NULL)
+	{
+	  mnt_lat_set_name (MNT_LAT_NET_REQUEST, i, net_Requests[i].name);
+	}
+    }
 }
 
 #if defined(CUBRID_DEBUG)
@@ -1139,8 +1174,9 @@ net_server_histo_add_entry (int request, int data_sent)
 #endif /* CUBRID_DEBUG */
 
 /*
- * net_server_request () - The main server request dispatch handler
- *   return: error status
+ * net_server_call_request () - Check the action attributes of a request and
+ *                              call its processing function
+ *   return: NO_ERROR, or ER_FAILED if the request was refused
  *   thrd(in): this thread handle
  *   rid(in): CSS request id
  *   request(in): request constant
@@ -1148,58 +1184,19 @@ net_server_histo_add_entry (int request, int data_sent)
  *   buffer(in): argument buffer
  */
 static int
-net_server_request (THREAD_ENTRY * thread_p, unsigned int rid, int request,
-		    int size, char *buffer)
+net_server_call_request (THREAD_ENTRY * thread_p, unsigned int rid,
+			 int request, int size, char *buffer)
 {
   net_server_func func;
-  int status = CSS_NO_ERRORS;
   int error_code;
   CSS_CONN_ENTRY *conn;
+  struct timeval request_start_time;
 #if defined (DIAG_DEVEL)
   struct timeval diag_start_time, diag_end_time, diag_elapsed_time;
 #endif /* DIAG_DEVEL */
 
-  if (buffer == NULL && size > 0)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_NET_CANT_ALLOC_BUFFER, 0);
-      return_error_to_client (thread_p, rid);
-      status = CSS_UNPLANNED_SHUTDOWN;
-      goto end;
-    }
-
-  /* handle some special requests */
-  if (request == NET_SERVER_PING_WITH_HANDSHAKE)
-    {
-      status = server_ping_with_handshake (thread_p, rid, buffer, size);
-      goto end;
-    }
-  else if (request == NET_SERVER_SHUTDOWN)
-    {
-      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE, ER_NET_SERVER_SHUTDOWN, 0);
-      /* When this actually does a shutdown, change to CSS_PLANNED_SHUTDOWN */
-      status = CSS_UNPLANNED_SHUTDOWN;
-      goto end;
-    }
-
-  if (request <= NET_SERVER_REQUEST_START
-      || request >= NET_SERVER_REQUEST_END)
-    {
-      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE, ER_NET_UNKNOWN_SERVER_REQ,
-	      0);
-      return_error_to_client (thread_p, rid);
-      goto end;
-    }
-#if defined(CUBRID_DEBUG)
-  net_server_histo_add_entry (request, size);
-#endif /* CUBRID_DEBUG */
   conn = thread_p->conn_entry;
   assert (conn != NULL);
-  /* check if the conn is valid */
-  if (IS_INVALID_SOCKET (conn->fd) || conn->status != CONN_OPEN)
-    {
-      /* have nothing to do because the client has gone */
-      goto end;
-    }
 
   /* check the defined action attribute */
   if (net_Requests[request].action_attribute & CHECK_DB_MODIFICATION)
@@ -1222,11 +1219,11 @@ net_server_request (THREAD_ENTRY * thread_p, unsigned int rid, int request,
 	  if (error_code != NO_ERROR)
 	    {
 	      er_log_debug (ARG_FILE_LINE,
-			    "net_server_request(): CHECK_DB_MODIFICATION error"
-			    " request %s\n", net_Requests[request].name);
+			    "net_server_call_request(): CHECK_DB_MODIFICATION"
+			    " error request %s\n", net_Requests[request].name);
 	      return_error_to_client (thread_p, rid);
 	      css_send_abort_to_client (conn, rid);
-	      goto end;
+	      return ER_FAILED;
 	    }
 	}
     }
@@ -1235,12 +1232,12 @@ net_server_request (THREAD_ENTRY * thread_p, unsigned int rid, int request,
       if (!logtb_am_i_dba_client (thread_p))
 	{
 	  er_log_debug (ARG_FILE_LINE,
-			"net_server_request(): CHECK_AUTHORIZATION error"
+			"net_server_call_request(): CHECK_AUTHORIZATION error"
 			" request %s\n", net_Requests[request].name);
 	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_AU_DBA_ONLY, 1, "");
 	  return_error_to_client (thread_p, rid);
 	  css_send_abort_to_client (conn, rid);
-	  goto end;
+	  return ER_FAILED;
 	}
     }
 #if defined (DIAG_DEVEL)
@@ -1265,7 +1262,10 @@ net_server_request (THREAD_ENTRY * thread_p, unsigned int rid, int request,
   assert (func != NULL);
   if (func)
     {
+      gettimeofday (&request_start_time, NULL);
       (*func) (thread_p, rid, buffer, size);
+      mnt_lat_record (thread_p, MNT_LAT_NET_REQUEST, request,
+		      &request_start_time);
     }
 
   /* check the defined action attribute */
@@ -1290,6 +1290,145 @@ net_server_request (THREAD_ENTRY * thread_p, unsigned int rid, int request,
       conn->in_transaction = false;
     }
 
+
+  return NO_ERROR;
+}
+
+/*
+ * net_server_batch () - Serve a batch of requests
+ *   return:
+ *   thrd(in): this thread handle
+ *   rid(in): CSS request id
+ *   request(in): packed sub-requests
+ *   reqlen(in): size of request
+ *
+ * Note: The sub-requests are served in order by this thread, without going
+ *       back to the job queue, and each of them sends its reply on the
+ *       request id of the batch. Only requests which send exactly one reply
+ *       may be batched; see NET_IS_BATCHABLE_REQUEST().
+ */
+static void
+net_server_batch (THREAD_ENTRY * thread_p, unsigned int rid, char *request,
+		  int reqlen)
+{
+  int num_requests, sub_request, sub_size, i;
+  char *ptr, *end;
+
+  if (request == NULL || reqlen < OR_INT_SIZE)
+    {
+      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE, ER_NET_UNKNOWN_SERVER_REQ,
+	      0);
+      return_error_to_client (thread_p, rid);
+      css_send_abort_to_client (thread_p->conn_entry, rid);
+      return;
+    }
+
+  end = request + reqlen;
+
+  /* validate the whole batch before serving any of it */
+  ptr = or_unpack_int (request, &num_requests);
+  ptr = PTR_ALIGN (ptr, MAX_ALIGNMENT);
+  for (i = 0; i < num_requests; i++)
+    {
+      if (ptr + OR_INT_SIZE * 2 > end)
+	{
+	  break;
+	}
+      ptr = or_unpack_int (ptr, &sub_request);
+      ptr = or_unpack_int (ptr, &sub_size);
+      if (!NET_IS_BATCHABLE_REQUEST (sub_request)
+	  || sub_size < 0 || ptr + sub_size > end)
+	{
+	  break;
+	}
+      ptr = PTR_ALIGN (ptr + sub_size, MAX_ALIGNMENT);
+    }
+
+  if (num_requests <= 0 || num_requests > NET_BATCH_MAX_REQUESTS
+      || i < num_requests)
+    {
+      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE, ER_NET_UNKNOWN_SERVER_REQ,
+	      0);
+      return_error_to_client (thread_p, rid);
+      css_send_abort_to_client (thread_p->conn_entry, rid);
+      return;
+    }
+
+  ptr = PTR_ALIGN (request + OR_INT_SIZE, MAX_ALIGNMENT);
+  for (i = 0; i < num_requests; i++)
+    {
+      ptr = or_unpack_int (ptr, &sub_request);
+      ptr = or_unpack_int (ptr, &sub_size);
+      if (net_server_call_request (thread_p, rid, sub_request, sub_size,
+				   (sub_size > 0) ? ptr : NULL) != NO_ERROR)
+	{
+	  /* the client gives up the rest of the batch */
+	  return;
+	}
+      ptr = PTR_ALIGN (ptr + sub_size, MAX_ALIGNMENT);
+    }
+}
+
+/*
+ * net_server_request () - The main server request dispatch handler
+ *   return: error status
+ *   thrd(in): this thread handle
+ *   rid(in): CSS request id
+ *   request(in): request constant
+ *   size(in): size of argument buffer
+ *   buffer(in): argument buffer
+ */
+static int
+net_server_request (THREAD_ENTRY * thread_p, unsigned int rid, int request,
+		    int size, char *buffer)
+{
+  int status = CSS_NO_ERRORS;
+  CSS_CONN_ENTRY *conn;
+
+  if (buffer == NULL && size > 0)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_NET_CANT_ALLOC_BUFFER, 0);
+      return_error_to_client (thread_p, rid);
+      status = CSS_UNPLANNED_SHUTDOWN;
+      goto end;
+    }
+
+  /* handle some special requests */
+  if (request == NET_SERVER_PING_WITH_HANDSHAKE)
+    {
+      status = server_ping_with_handshake (thread_p, rid, buffer, size);
+      goto end;
+    }
+  else if (request == NET_SERVER_SHUTDOWN)
+    {
+      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE, ER_NET_SERVER_SHUTDOWN, 0);
+      /* When this actually does a shutdown, change to CSS_PLANNED_SHUTDOWN */
+      status = CSS_UNPLANNED_SHUTDOWN;
+      goto end;
+    }
+
+  if (request <= NET_SERVER_REQUEST_START
+      || request >= NET_SERVER_REQUEST_END)
+    {
+      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE, ER_NET_UNKNOWN_SERVER_REQ,
+	      0);
+      return_error_to_client (thread_p, rid);
+      goto end;
+    }
+#if defined(CUBRID_DEBUG)
+  net_server_histo_add_entry (request, size);
+#endif /* CUBRID_DEBUG */
+  conn = thread_p->conn_entry;
+  assert (conn != NULL);
+  /* check if the conn is valid */
+  if (IS_INVALID_SOCKET (conn->fd) || conn->status != CONN_OPEN)
+    {
+      /* have nothing to do because the client has gone */
+      goto end;
+    }
+
+  (void) net_server_call_request (thread_p, rid, request, size, buffer);
+
 end:
   if (buffer != NULL && size > 0)
     {
@@ -374,6 +374,27 @@ struct css_queue_entry
 #endif
 };
 
+#if defined(SERVER_MODE)
+/*
+ * A packet read piece by piece by a connection I/O daemon. A request is
+ * queued only once its header, the header of its data and the data have
+ * all arrived, so the daemon never waits for a slow client.
+ */
+typedef struct css_read_state CSS_READ_STATE;
+struct css_read_state
+{
+  int phase;			/* CSS_READ_HEADER, ... */
+  int offset;			/* bytes of the current part read so far */
+  int length;			/* length of the current packet */
+  bool length_read;		/* the length has been read */
+  NET_HEADER header;		/* command, data or error header */
+  NET_HEADER data_header;	/* header of the data of a command */
+  char *body;			/* data of the packet */
+  int body_size;
+  bool from_buffer;		/* being queued from here, not the socket */
+};
+#endif /* SERVER_MODE */
+
 /*
  * This data structure is the interface between the client and the
  * communication software to identify the data connection.
@@ -395,6 +416,9 @@ struct css_conn_entry
   CSS_CRITICAL_SECTION csect;
   bool stop_talk;		/* block and stop this connection */
   unsigned short stop_phase;
+  int io_index;			/* epoll I/O thread watching the socket,
+				   -1 if none */
+  CSS_READ_STATE read_state;	/* packet read by the I/O thread */
 
   char *version_string;		/* client version string */
 
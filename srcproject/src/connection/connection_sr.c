@@ -145,6 +145,15 @@ CSS_THREAD_FN css_Connection_error_handler = NULL;
 
 static CSS_BUFFER *css_Buffer_free_list[CSS_BUFFER_ALLOC_COUNT] = { NULL };
 
+/* what a connection I/O daemon is reading (CSS_READ_STATE phase) */
+enum
+{
+  CSS_READ_HEADER = 0,
+  CSS_READ_DATA_HEADER,
+  CSS_READ_BODY,
+  CSS_READ_HANDOFF		/* header read; a worker goes on from here */
+};
+
 
 /*make the s2s connection pooling here*/
 #ifdef PACKET_TRACE
@@ -278,6 +287,19 @@ static int css_send_magic (CSS_CONN_ENTRY * conn);
 static void css_clean_free_list ();
 static int css_net_transmit_package (CSS_CONN_ENTRY * conn,
 				     const NET_HEADER * header);
+static int css_check_read_header (CSS_CONN_ENTRY * conn,
+				  NET_HEADER * header, int rc);
+static int css_queue_read_packet (CSS_CONN_ENTRY * conn, NET_HEADER * header,
+				  int *type);
+static int css_read_data_header (CSS_CONN_ENTRY * conn, NET_HEADER * header);
+static int css_recv_packet_body (CSS_CONN_ENTRY * conn, char *buffer,
+				 int *size);
+static void css_skip_packet_body (CSS_CONN_ENTRY * conn, int size);
+#if defined(LINUX)
+static int css_recv_nowait (CSS_CONN_ENTRY * conn, char *ptr, int nbytes);
+static int css_recv_packet_nowait (CSS_CONN_ENTRY * conn, char *buffer,
+				   int size);
+#endif /* LINUX */
 /*
  * get_next_client_id() -
  *   return: client id
@@ -339,6 +361,8 @@ css_initialize_conn (CSS_CONN_ENTRY * conn, SOCKET fd)
   conn->reset_on_commit = false;
   conn->stop_talk = false;
   conn->stop_phase = THREAD_WORKER_STOP_PHASE_0;
+  conn->io_index = -1;
+  memset (&conn->read_state, 0, sizeof (conn->read_state));
   conn->version_string = NULL;
   conn->free_queue_list = NULL;
   conn->free_queue_count = 0;
@@ -466,6 +490,11 @@ css_shutdown_conn (CSS_CONN_ENTRY * conn)
 	}
     }
 
+#if defined(LINUX)
+  /* drop a packet an I/O daemon has partially read */
+  css_clear_read_state (conn);
+#endif /* LINUX */
+
   csect_exit_critical_section (&conn->csect);
 }
 
@@ -1270,7 +1299,20 @@ css_read_header (CSS_CONN_ENTRY * conn, const NET_HEADER * local_header)
     }
   while (rc == INTERRUPTED_READ);
 
-  if (rc == NO_ERRORS && ntohl (local_header->type) == CLOSE_TYPE)
+  return css_check_read_header (conn, (NET_HEADER *) local_header, rc);
+}
+
+/*
+ * css_check_read_header() - check a header read from the client
+ *   return: rc, or CONNECTION_CLOSED
+ *   conn(in): connection entry
+ *   header(in/out): network header
+ *   rc(in): result of reading the header
+ */
+static int
+css_check_read_header (CSS_CONN_ENTRY * conn, NET_HEADER * header, int rc)
+{
+  if (rc == NO_ERRORS && ntohl (header->type) == CLOSE_TYPE)
     {
       return (CONNECTION_CLOSED);
     }
@@ -1279,11 +1321,10 @@ css_read_header (CSS_CONN_ENTRY * conn, const NET_HEADER * local_header)
       return (CONNECTION_CLOSED);
     }
 
-  ((NET_HEADER *) local_header)->transaction_id =
-    htonl (log_get_local_by_global_tran_id
-	   (ntohl (local_header->transaction_id)));
-  conn->transaction_id = ntohl (local_header->transaction_id);
-  conn->db_error = (int) ntohl (local_header->db_error);
+  header->transaction_id =
+    htonl (log_get_local_by_global_tran_id (ntohl (header->transaction_id)));
+  conn->transaction_id = ntohl (header->transaction_id);
+  conn->db_error = (int) ntohl (header->db_error);
 
   return (rc);
 }
@@ -1336,14 +1377,32 @@ css_read_and_queue (CSS_CONN_ENTRY * conn, int *type)
       return rc;
     }
 
+  return css_queue_read_packet (conn, &header, type);
+}
+
+/*
+ * css_queue_read_packet() - queue a packet whose header has been read
+ *   return: 0 if success, or error code
+ *   conn(in): connection entry
+ *   header(in): network header
+ *   type(out): request type
+ *
+ * Note: The rest of the packet is read from the socket, or taken from
+ *       conn->read_state when an I/O daemon has read it already.
+ */
+static int
+css_queue_read_packet (CSS_CONN_ENTRY * conn, NET_HEADER * header, int *type)
+{
+  int rc;
+
   /* 
    * handling for packet routine control
    */
-  if (COMMAND_TYPE == ntohl (header.type)
-      && NET_PROXY_SET_ROUTER == ntohs (header.function_code))
+  if (COMMAND_TYPE == ntohl (header->type)
+      && NET_PROXY_SET_ROUTER == ntohs (header->function_code))
     {
       unsigned short rid;
-      int pak_node_id = ntohl (header.node_id);
+      int pak_node_id = ntohl (header->node_id);
 
       /*
        * Step 1: if no change then no action, return directly.
@@ -1371,7 +1430,7 @@ css_read_and_queue (CSS_CONN_ENTRY * conn, int *type)
 	{
 	  conn->trans_conn =
 	    css_open_connection_to_remote_server (ntohl
-						  (header.transaction_id),
+						  (header->transaction_id),
 						  pak_node_id, &rid);
 	  if (conn->trans_conn == NULL)
 	    {
@@ -1390,13 +1449,13 @@ css_read_and_queue (CSS_CONN_ENTRY * conn, int *type)
   if (conn->trans_conn != NULL)
     {
       LOG_TDES *tdes;
-      int tran_index = (int) ntohl (header.transaction_id);
+      int tran_index = (int) ntohl (header->transaction_id);
 
       if (tran_index != NULL_TRANID)
 	{
 	  if ((tdes = LOG_FIND_TDES (tran_index)) != NULL)
 	    {
-	      header.transaction_id = htonl (tdes->global_tran_id);
+	      header->transaction_id = htonl (tdes->global_tran_id);
 	    }
 	  else
 	    {
@@ -1406,7 +1465,7 @@ css_read_and_queue (CSS_CONN_ENTRY * conn, int *type)
 	    }
 	}
 
-      rc = css_net_transmit_package (conn, &header);
+      rc = css_net_transmit_package (conn, header);
       if (rc != NO_ERRORS)
 	{
 	  er_log_debug (ARG_FILE_LINE,
@@ -1416,11 +1475,381 @@ css_read_and_queue (CSS_CONN_ENTRY * conn, int *type)
       return rc;
     }
 
-  *type = ntohl (header.type);
-  css_queue_packet (conn, (int) ntohl (header.type),
-		    (unsigned short) ntohl (header.request_id),
-		    &header, sizeof (NET_HEADER));
-  return (rc);
+  *type = ntohl (header->type);
+  css_queue_packet (conn, (int) ntohl (header->type),
+		    (unsigned short) ntohl (header->request_id),
+		    header, sizeof (NET_HEADER));
+  return NO_ERRORS;
+}
+
+#if defined(LINUX)
+/*
+ * css_read_and_queue_nowait() - Read what has arrived of a packet from the
+ *                               connection and queue the packet once it is
+ *                               complete.
+ *   return: 0 if success, or error code
+ *   conn(in): connection entry
+ *   type(out): request type, 0 while the packet is incomplete
+ *
+ * Note: This is css_read_and_queue () for a connection I/O daemon, which
+ *       serves many connections and so must never wait for one client.
+ *       The socket is read with MSG_DONTWAIT into conn->read_state; the
+ *       header of a command, the header of its data and the data are
+ *       queued together once all of them have arrived.
+ *       NET_PROXY_SET_ROUTER and the packets forwarded to a remote server
+ *       block on the remote server, so they are only read up to their
+ *       header and left to a worker (see css_read_is_handed_off ()).
+ */
+int
+css_read_and_queue_nowait (CSS_CONN_ENTRY * conn, int *type)
+{
+  CSS_READ_STATE *rs;
+  NET_HEADER *header;
+  int rc, packet_type;
+
+  *type = 0;
+  if (!conn || conn->status != CONN_OPEN)
+    {
+      return (ERROR_ON_READ);
+    }
+
+  if (conn->stop_talk == true)
+    {
+      return (CONNECTION_CLOSED);
+    }
+
+  rs = &conn->read_state;
+
+  if (rs->phase == CSS_READ_HANDOFF)
+    {
+      /* waiting for a worker */
+      return (NO_ERRORS);
+    }
+
+  if (rs->phase == CSS_READ_HEADER)
+    {
+      rc = css_recv_packet_nowait (conn, (char *) &rs->header,
+				   sizeof (NET_HEADER));
+      if (rc == NO_ERRORS)
+	{
+	  rc = css_check_read_header (conn, &rs->header, rc);
+	}
+      if (rc != NO_ERRORS)
+	{
+	  return (rc == NO_DATA_AVAILABLE) ? NO_ERRORS : rc;
+	}
+
+      packet_type = ntohl (rs->header.type);
+      if ((packet_type == COMMAND_TYPE
+	   && ntohs (rs->header.function_code) == NET_PROXY_SET_ROUTER)
+	  || conn->trans_conn != NULL)
+	{
+	  rs->phase = CSS_READ_HANDOFF;
+	  return NO_ERRORS;
+	}
+
+      if (packet_type == COMMAND_TYPE && ntohl (rs->header.buffer_size) > 0)
+	{
+	  rs->phase = CSS_READ_DATA_HEADER;
+	}
+      else if (packet_type == DATA_TYPE || packet_type == ERROR_TYPE)
+	{
+	  rs->phase = CSS_READ_BODY;
+	}
+    }
+
+  if (rs->phase == CSS_READ_DATA_HEADER)
+    {
+      /* checked by css_read_data_header () when it is queued */
+      rc = css_recv_packet_nowait (conn, (char *) &rs->data_header,
+				   sizeof (NET_HEADER));
+      if (rc != NO_ERRORS)
+	{
+	  return (rc == NO_DATA_AVAILABLE) ? NO_ERRORS : rc;
+	}
+
+      packet_type = ntohl (rs->data_header.type);
+      if (packet_type == DATA_TYPE || packet_type == ERROR_TYPE)
+	{
+	  rs->phase = CSS_READ_BODY;
+	}
+      else
+	{
+	  rs->phase = CSS_READ_HEADER;
+	}
+    }
+
+  if (rs->phase == CSS_READ_BODY)
+    {
+      if (ntohl (rs->header.type) == COMMAND_TYPE)
+	{
+	  header = &rs->data_header;
+	}
+      else
+	{
+	  header = &rs->header;
+	}
+
+      if ((int) ntohl (header->buffer_size) > 0)
+	{
+	  rc = css_recv_packet_nowait (conn, NULL,
+				       (int) ntohl (header->buffer_size));
+	}
+      else
+	{
+	  /* what css_skip_packet_body () reads of an empty packet */
+	  rc = css_recv_nowait (conn, (char *) &rs->length, sizeof (int));
+	}
+      if (rc != NO_ERRORS)
+	{
+	  return (rc == NO_DATA_AVAILABLE) ? NO_ERRORS : rc;
+	}
+    }
+
+  /* the whole packet has arrived */
+  rs->phase = CSS_READ_HEADER;
+  rs->from_buffer = true;
+  rc = css_queue_read_packet (conn, &rs->header, type);
+  rs->from_buffer = false;
+
+  css_clear_read_state (conn);
+
+  return rc;
+}
+
+/*
+ * css_read_is_handed_off() - check if the packet being read has to be
+ *                            queued by a worker
+ *   return: true if so
+ *   conn(in): connection entry
+ */
+bool
+css_read_is_handed_off (CSS_CONN_ENTRY * conn)
+{
+  return (conn->read_state.phase == CSS_READ_HANDOFF);
+}
+
+/*
+ * css_queue_handed_off_packet() - queue the packet whose header an I/O
+ *                                 daemon has read and handed off
+ *   return: 0 if success, or error code
+ *   conn(in): connection entry
+ *   type(out): request type
+ *
+ * Note: Called by a worker. The rest of the packet is read from the socket
+ *       and a router change or a forwarded packet may wait for the remote
+ *       server.
+ */
+int
+css_queue_handed_off_packet (CSS_CONN_ENTRY * conn, int *type)
+{
+  NET_HEADER header;
+
+  assert (conn->read_state.phase == CSS_READ_HANDOFF);
+
+  *type = 0;
+  header = conn->read_state.header;
+  css_clear_read_state (conn);
+
+  return css_queue_read_packet (conn, &header, type);
+}
+
+/*
+ * css_clear_read_state() - drop a packet partially read by an I/O daemon
+ *   return: void
+ *   conn(in): connection entry
+ */
+void
+css_clear_read_state (CSS_CONN_ENTRY * conn)
+{
+  CSS_READ_STATE *rs = &conn->read_state;
+
+  if (rs->body != NULL)
+    {
+      free_and_init (rs->body);
+    }
+  rs->body_size = 0;
+  rs->phase = CSS_READ_HEADER;
+  rs->offset = 0;
+  rs->length_read = false;
+}
+
+/*
+ * css_recv_nowait() - read what has arrived of a part of a packet
+ *   return: NO_ERRORS if the part is complete, NO_DATA_AVAILABLE if more
+ *           of it has to arrive, or ERROR_ON_READ
+ *   conn(in): connection entry
+ *   ptr(out): buffer of the part
+ *   nbytes(in): size of the part
+ */
+static int
+css_recv_nowait (CSS_CONN_ENTRY * conn, char *ptr, int nbytes)
+{
+  CSS_READ_STATE *rs = &conn->read_state;
+  int n;
+
+  while (rs->offset < nbytes)
+    {
+      n = recv (conn->fd, ptr + rs->offset, nbytes - rs->offset,
+		MSG_DONTWAIT);
+      if (n == 0)
+	{
+	  return ERROR_ON_READ;	/* EOF */
+	}
+      else if (n < 0)
+	{
+	  if (errno == EINTR)
+	    {
+	      continue;
+	    }
+	  if (errno == EAGAIN || errno == EWOULDBLOCK)
+	    {
+	      return NO_DATA_AVAILABLE;
+	    }
+	  return ERROR_ON_READ;
+	}
+      rs->offset += n;
+    }
+
+  rs->offset = 0;
+  return NO_ERRORS;
+}
+
+/*
+ * css_recv_packet_nowait() - read what has arrived of a packet
+ *   return: NO_ERRORS if the packet is complete, NO_DATA_AVAILABLE if more
+ *           of it has to arrive, or error code
+ *   conn(in): connection entry
+ *   buffer(out): buffer of the packet, NULL to read it into
+ *                conn->read_state.body
+ *   size(in): size of the packet
+ *
+ * Note: Like css_net_recv (), the length of the packet is read first and
+ *       empty packets are skipped. A length other than the one announced
+ *       by the header is not sent by our clients and is an error.
+ */
+static int
+css_recv_packet_nowait (CSS_CONN_ENTRY * conn, char *buffer, int size)
+{
+  CSS_READ_STATE *rs = &conn->read_state;
+  int rc;
+
+  while (rs->length_read == false)
+    {
+      rc = css_recv_nowait (conn, (char *) &rs->length, sizeof (int));
+      if (rc != NO_ERRORS)
+	{
+	  return rc;
+	}
+      rs->length = ntohl (rs->length);
+      rs->length_read = (rs->length != 0);
+    }
+
+  if (rs->length != size)
+    {
+      return READ_LENGTH_MISMATCH;
+    }
+
+  if (buffer == NULL)
+    {
+      if (rs->body == NULL)
+	{
+	  rs->body = (char *) malloc (size);
+	  if (rs->body == NULL)
+	    {
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+		      ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) size);
+	      return CANT_ALLOC_BUFFER;
+	    }
+	  rs->body_size = size;
+	}
+      buffer = rs->body;
+    }
+
+  rc = css_recv_nowait (conn, buffer, size);
+  if (rc == NO_ERRORS)
+    {
+      rs->length_read = false;
+    }
+
+  return rc;
+}
+#endif /* LINUX */
+
+/*
+ * css_read_data_header() - read the header of the data of a command
+ *   return: 0 if success, or error code
+ *   conn(in): connection entry
+ *   header(out): network header
+ */
+static int
+css_read_data_header (CSS_CONN_ENTRY * conn, NET_HEADER * header)
+{
+  if (conn->read_state.from_buffer)
+    {
+      memcpy (header, &conn->read_state.data_header, sizeof (NET_HEADER));
+      return css_check_read_header (conn, header, NO_ERRORS);
+    }
+
+  return css_read_header (conn, header);
+}
+
+/*
+ * css_recv_packet_body() - read the data of a data or error packet
+ *   return: 0 if success, or error code
+ *   conn(in): connection entry
+ *   buffer(out): buffer for the data
+ *   size(in/out): size of buffer, bytes read
+ */
+static int
+css_recv_packet_body (CSS_CONN_ENTRY * conn, char *buffer, int *size)
+{
+  CSS_READ_STATE *rs = &conn->read_state;
+  int rc;
+
+  if (rs->from_buffer)
+    {
+      if (rs->body_size > *size)
+	{
+	  memcpy (buffer, rs->body, *size);
+	  return RECORD_TRUNCATED;
+	}
+
+      if (rs->body_size > 0)
+	{
+	  memcpy (buffer, rs->body, rs->body_size);
+	}
+      *size = rs->body_size;
+      return NO_ERRORS;
+    }
+
+  do
+    {
+      /* timeout in mili-second in css_net_recv() */
+      rc = css_net_recv (conn->fd, buffer, size,
+			 PRM_TCP_CONNECTION_TIMEOUT * 1000);
+    }
+  while (rc == INTERRUPTED_READ);
+
+  return rc;
+}
+
+/*
+ * css_skip_packet_body() - read and drop the data of a packet
+ *   return: void
+ *   conn(in): connection entry
+ *   size(in): size of the data
+ */
+static void
+css_skip_packet_body (CSS_CONN_ENTRY * conn, int size)
+{
+  if (conn->read_state.from_buffer)
+    {
+      /* read already */
+      return;
+    }
+
+  css_read_remaining_bytes (conn->fd, sizeof (int) + size);
 }
 
 /*
@@ -1970,13 +2399,7 @@ css_queue_data_packet (CSS_CONN_ENTRY * conn, unsigned short request_id,
   /* receive data into buffer and queue data if there's no waiting thread */
   if (buffer != NULL)
     {
-      do
-	{
-	  /* timeout in mili-second in css_net_recv() */
-	  rc = css_net_recv (conn->fd, buffer, &size,
-			     PRM_TCP_CONNECTION_TIMEOUT * 1000);
-	}
-      while (rc == INTERRUPTED_READ);
+      rc = css_recv_packet_body (conn, buffer, &size);
 
       if (rc == NO_ERRORS || rc == RECORD_TRUNCATED)
 	{
@@ -2007,7 +2430,7 @@ css_queue_data_packet (CSS_CONN_ENTRY * conn, unsigned short request_id,
   else
     {
       rc = CANT_ALLOC_BUFFER;
-      css_read_remaining_bytes (conn->fd, sizeof (int) + size);
+      css_skip_packet_body (conn, size);
       if (!css_is_request_aborted (conn, request_id))
 	{
 	  if (data_wait == NULL)
@@ -2049,13 +2472,7 @@ css_queue_error_packet (CSS_CONN_ENTRY * conn, unsigned short request_id,
 
   if (buffer != NULL)
     {
-      do
-	{
-	  /* timeout in mili-second in css_net_recv() */
-	  rc = css_net_recv (conn->fd, buffer, &size,
-			     PRM_TCP_CONNECTION_TIMEOUT * 1000);
-	}
-      while (rc == INTERRUPTED_READ);
+      rc = css_recv_packet_body (conn, buffer, &size);
 
       if (rc == NO_ERRORS || rc == RECORD_TRUNCATED)
 	{
@@ -2072,7 +2489,7 @@ css_queue_error_packet (CSS_CONN_ENTRY * conn, unsigned short request_id,
   else
     {
       rc = CANT_ALLOC_BUFFER;
-      css_read_remaining_bytes (conn->fd, sizeof (int) + size);
+      css_skip_packet_body (conn, size);
       if (!css_is_request_aborted (conn, request_id))
 	{
 	  css_add_queue_entry (conn, &conn->error_queue, request_id, NULL, 0,
@@ -2098,10 +2515,9 @@ css_queue_command_packet (CSS_CONN_ENTRY * conn, unsigned short request_id,
 
   if (css_is_request_aborted (conn, request_id))
     {
-      return;
+      p = NULL;
     }
-
-  if (conn->free_net_header_list != NULL)
+  else if (conn->free_net_header_list != NULL)
     {
       p = (NET_HEADER *) conn->free_net_header_list;
       conn->free_net_header_list = (char *) (*(UINTPTR *) p);
@@ -2118,13 +2534,19 @@ css_queue_command_packet (CSS_CONN_ENTRY * conn, unsigned short request_id,
       css_add_queue_entry (conn, &conn->request_queue, request_id, (char *) p,
 			   size, NO_ERRORS, conn->transaction_id,
 			   conn->db_error);
-      if (ntohl (header->buffer_size) > 0)
-	{
-	  css_read_header (conn, &data_header);
-	  css_queue_packet (conn, (int) ntohl (data_header.type),
-			    (unsigned short) ntohl (data_header.request_id),
-			    &data_header, sizeof (NET_HEADER));
-	}
+    }
+
+  /*
+   * If the command is not queued, its data is left on the socket for the
+   * next read; an I/O daemon has read it already and queues it here.
+   */
+  if ((p != NULL || conn->read_state.from_buffer)
+      && ntohl (header->buffer_size) > 0)
+    {
+      css_read_data_header (conn, &data_header);
+      css_queue_packet (conn, (int) ntohl (data_header.type),
+			(unsigned short) ntohl (data_header.request_id),
+			&data_header, sizeof (NET_HEADER));
     }
 }
 
@@ -3041,13 +3463,7 @@ css_net_transmit_package (CSS_CONN_ENTRY * rcv_conn,
 	  rc = CANT_ALLOC_BUFFER;
 	  return rc;
 	}
-      do
-	{
-	  /* timeout in mili-second in css_net_recv() */
-	  rc = css_net_recv (rcv_conn->fd, buffer, &size,
-			     PRM_TCP_CONNECTION_TIMEOUT * 1000);
-	}
-      while (rc == INTERRUPTED_READ);
+      rc = css_recv_packet_body (rcv_conn, buffer, &size);
 
       rc = css_net_send (rcv_conn->trans_conn, buffer, size,
 			 PRM_TCP_CONNECTION_TIMEOUT * 1000);
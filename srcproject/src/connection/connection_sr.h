@@ -81,6 +81,12 @@ extern int css_read_header (CSS_CONN_ENTRY * conn,
 extern int css_receive_request (CSS_CONN_ENTRY * conn, unsigned short *rid,
 				int *request, int *buffer_size);
 extern int css_read_and_queue (CSS_CONN_ENTRY * conn, int *type);
+#if defined(LINUX)
+extern int css_read_and_queue_nowait (CSS_CONN_ENTRY * conn, int *type);
+extern bool css_read_is_handed_off (CSS_CONN_ENTRY * conn);
+extern int css_queue_handed_off_packet (CSS_CONN_ENTRY * conn, int *type);
+extern void css_clear_read_state (CSS_CONN_ENTRY * conn);
+#endif /* LINUX */
 extern int css_receive_data (CSS_CONN_ENTRY * conn, unsigned short req_id,
 			     char **buffer, int *buffer_size);
 
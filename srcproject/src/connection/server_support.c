@@ -39,6 +39,9 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #endif /* !WINDOWS */
+#if defined(LINUX)
+#include <sys/epoll.h>
+#endif /* LINUX */
 #include <assert.h>
 
 #include "porting.h"
@@ -151,6 +154,16 @@ static HA_LOG_APPLIER_STATE_TABLE
 };
 static int ha_Log_applier_state_num = 0;
 
+#if defined(LINUX)
+/* max # of socket events taken by one epoll_wait () call */
+#define CSS_IO_MAX_EVENTS 64
+
+/* one epoll set per connection I/O daemon; css_Num_io_threads is 0 when the
+   client connections are served by css_connection_handler_thread () */
+static int *css_Io_epoll_fd = NULL;
+static int css_Num_io_threads = 0;
+#endif /* LINUX */
+
 static int css_free_job_entry_func (void *data, void *dummy);
 static void css_empty_job_queue (void);
 static void css_setup_server_loop (void);
@@ -173,6 +186,22 @@ static void dummy_sigurg_handler (int sig);
 static int css_connection_handler_thread (THREAD_ENTRY * thrd,
 					  CSS_CONN_ENTRY * conn);
 static int css_internal_connection_handler (CSS_CONN_ENTRY * conn);
+#if defined(LINUX)
+static void css_init_connection_io (void);
+static void css_final_connection_io (void);
+static int css_register_connection_io (CSS_CONN_ENTRY * conn);
+static void css_unregister_connection_io (THREAD_ENTRY * thread_p,
+					  CSS_CONN_ENTRY * conn);
+static void css_close_connection_io (THREAD_ENTRY * thread_p,
+				     CSS_CONN_ENTRY * conn, int status);
+static void css_sweep_connection_io (THREAD_ENTRY * thread_p, int io_index);
+static int css_connection_io_close_handler (THREAD_ENTRY * thread_p,
+					    CSS_THREAD_ARG arg);
+static void css_handoff_connection_io (THREAD_ENTRY * thread_p,
+				       CSS_CONN_ENTRY * conn);
+static int css_connection_io_handoff_handler (THREAD_ENTRY * thread_p,
+					      CSS_THREAD_ARG arg);
+#endif /* LINUX */
 static int css_internal_request_handler (THREAD_ENTRY * thrd,
 					 CSS_THREAD_ARG arg);
 static int css_test_for_client_errors (CSS_CONN_ENTRY * conn,
@@ -534,6 +563,10 @@ css_setup_server_loop (void)
 
   if (!IS_INVALID_SOCKET (css_Pipe_to_master))
     {
+#if defined(LINUX)
+      css_init_connection_io ();
+#endif /* LINUX */
+
       /* startup worker/daemon threads */
       r = thread_start_workers ();
       if (r != NO_ERROR)
@@ -556,6 +589,10 @@ css_setup_server_loop (void)
       thread_stop_active_workers (THREAD_WORKER_STOP_PHASE_1);
       thread_stop_active_daemons ();
 
+#if defined(LINUX)
+      css_final_connection_io ();
+#endif /* LINUX */
+
       css_close_server_connection_socket ();
 
 #if defined(WINDOWS)
@@ -1479,6 +1516,14 @@ css_internal_connection_handler (CSS_CONN_ENTRY * conn)
 
   css_insert_into_active_conn_list (conn);
 
+#if defined(LINUX)
+  if (css_Num_io_threads > 0 && css_register_connection_io (conn) == NO_ERROR)
+    {
+      /* an I/O daemon reads the requests; no thread is tied to conn */
+      return 1;
+    }
+#endif /* LINUX */
+
   job = css_make_job_entry (conn,
 			    (CSS_THREAD_FN) css_connection_handler_thread,
 			    (CSS_THREAD_ARG) conn,
@@ -1493,6 +1538,445 @@ css_internal_connection_handler (CSS_CONN_ENTRY * conn)
   return 1;
 }
 
+#if defined(LINUX)
+/*
+ * css_init_connection_io() - create the epoll sets of the connection I/O
+ *                            daemons
+ *   return:
+ *
+ * Note: If they cannot be created, css_Num_io_threads stays 0 and every
+ *       connection gets its own css_connection_handler_thread ().
+ */
+static void
+css_init_connection_io (void)
+{
+  int num_io_threads, i;
+  size_t size;
+
+  num_io_threads = thread_num_conn_io_threads ();
+  if (num_io_threads <= 0)
+    {
+      return;
+    }
+
+  size = num_io_threads * sizeof (int);
+  css_Io_epoll_fd = (int *) malloc (size);
+  if (css_Io_epoll_fd == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      size);
+      return;
+    }
+
+  for (i = 0; i < num_io_threads; i++)
+    {
+      css_Io_epoll_fd[i] = epoll_create (PRM_CSS_MAX_CLIENTS + 1);
+      if (css_Io_epoll_fd[i] < 0)
+	{
+	  er_log_debug (ARG_FILE_LINE, "css_init_connection_io: "
+			"epoll_create() error %d\n", errno);
+	  while (--i >= 0)
+	    {
+	      close (css_Io_epoll_fd[i]);
+	    }
+	  free_and_init (css_Io_epoll_fd);
+	  return;
+	}
+    }
+
+  css_Num_io_threads = num_io_threads;
+}
+
+/*
+ * css_final_connection_io() - close the epoll sets
+ *   return:
+ *
+ * Note: Called after the I/O daemons have stopped.
+ */
+static void
+css_final_connection_io (void)
+{
+  int i;
+
+  for (i = 0; i < css_Num_io_threads; i++)
+    {
+      close (css_Io_epoll_fd[i]);
+    }
+  css_Num_io_threads = 0;
+
+  if (css_Io_epoll_fd != NULL)
+    {
+      free_and_init (css_Io_epoll_fd);
+    }
+}
+
+/*
+ * css_register_connection_io() - hand a new client connection to an I/O
+ *                                daemon
+ *   return: NO_ERROR or ER_FAILED
+ *   conn(in):
+ */
+static int
+css_register_connection_io (CSS_CONN_ENTRY * conn)
+{
+  struct epoll_event ev;
+  int io_index;
+
+  io_index = conn->idx % css_Num_io_threads;
+
+  memset (&ev, 0, sizeof (ev));
+  ev.events = EPOLLIN | EPOLLRDHUP;
+  ev.data.ptr = conn;
+
+  /* set before the daemon can see an event of conn */
+  conn->io_index = io_index;
+  if (epoll_ctl (css_Io_epoll_fd[io_index], EPOLL_CTL_ADD, conn->fd, &ev) < 0)
+    {
+      er_log_debug (ARG_FILE_LINE, "css_register_connection_io: "
+		    "epoll_ctl() error %d\n", errno);
+      conn->io_index = -1;
+      return ER_FAILED;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * css_unregister_connection_io() - stop watching the socket of conn
+ *   return:
+ *   thread_p(in):
+ *   conn(in):
+ *
+ * Note: The socket may have been closed by a worker (css_shutdown_conn),
+ *       in which case the kernel has already dropped it from the set. The
+ *       conn critical section keeps the fd from being closed and reused
+ *       under us. A packet handed off to a worker is kept for it.
+ */
+static void
+css_unregister_connection_io (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn)
+{
+  struct epoll_event ev;
+
+  csect_enter_critical_section (thread_p, &conn->csect, INF_WAIT);
+
+  if (!IS_INVALID_SOCKET (conn->fd))
+    {
+      /* ev is ignored, but must not be NULL before Linux 2.6.9 */
+      memset (&ev, 0, sizeof (ev));
+      (void) epoll_ctl (css_Io_epoll_fd[conn->io_index], EPOLL_CTL_DEL,
+			conn->fd, &ev);
+    }
+  conn->io_index = -1;
+  if (!css_read_is_handed_off (conn))
+    {
+      css_clear_read_state (conn);
+    }
+
+  csect_exit_critical_section (&conn->csect);
+}
+
+/*
+ * css_close_connection_io() - unregister a broken connection and have a
+ *                             worker clean it up
+ *   return:
+ *   thread_p(in):
+ *   conn(in):
+ *   status(in): why the connection is closed
+ */
+static void
+css_close_connection_io (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn,
+			int status)
+{
+  CSS_JOB_ENTRY *job;
+
+  er_log_debug (ARG_FILE_LINE, "css_close_connection_io: "
+		"status %d conn { status %d transaction_id %d "
+		"db_error %d stop_talk %d stop_phase %d }\n",
+		status, conn->status, conn->transaction_id,
+		conn->db_error, conn->stop_talk, conn->stop_phase);
+
+  css_unregister_connection_io (thread_p, conn);
+
+  job = css_make_job_entry (conn, css_connection_io_close_handler,
+			    (CSS_THREAD_ARG) conn, -1);
+  assert (job != NULL);
+
+  if (job != NULL)
+    {
+      css_add_to_job_queue (job);
+    }
+}
+
+/*
+ * css_connection_io_close_handler() - call the connection error handler for
+ *                                     a connection an I/O daemon gave up
+ *   return:
+ *   thread_p(in):
+ *   arg(in): connection entry
+ *
+ * Note: Like all jobs, this is entered with thread_p->tran_index_lock held,
+ *       which the connection error handler expects.
+ */
+static int
+css_connection_io_close_handler (THREAD_ENTRY * thread_p, CSS_THREAD_ARG arg)
+{
+  CSS_CONN_ENTRY *conn;
+
+  if (thread_p == NULL)
+    {
+      thread_p = thread_get_thread_entry_info ();
+    }
+
+  conn = (CSS_CONN_ENTRY *) arg;
+
+  (*css_Connection_error_handler) (thread_p, conn);
+
+  return 0;
+}
+
+/*
+ * css_handoff_connection_io() - give a connection which talks to a remote
+ *                               server to a thread of its own
+ *   return:
+ *   thread_p(in):
+ *   conn(in):
+ *
+ * Note: Routing the connection to a remote server and forwarding packets
+ *       to it wait for the remote server, which an I/O daemon must never
+ *       do. The connection leaves the daemon for good.
+ */
+static void
+css_handoff_connection_io (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn)
+{
+  CSS_JOB_ENTRY *job;
+
+  css_unregister_connection_io (thread_p, conn);
+
+  job = css_make_job_entry (conn, css_connection_io_handoff_handler,
+			    (CSS_THREAD_ARG) conn, -1);
+  assert (job != NULL);
+
+  if (job != NULL)
+    {
+      css_add_to_job_queue (job);
+    }
+}
+
+/*
+ * css_connection_io_handoff_handler() - queue the packet an I/O daemon has
+ *                                       handed off and go on serving its
+ *                                       connection
+ *   return:
+ *   thread_p(in):
+ *   arg(in): connection entry
+ *
+ * Note: Like all jobs, this is entered with thread_p->tran_index_lock held.
+ */
+static int
+css_connection_io_handoff_handler (THREAD_ENTRY * thread_p,
+				   CSS_THREAD_ARG arg)
+{
+  CSS_CONN_ENTRY *conn;
+  CSS_JOB_ENTRY *job;
+  int type, status;
+
+  if (thread_p == NULL)
+    {
+      thread_p = thread_get_thread_entry_info ();
+    }
+
+  conn = (CSS_CONN_ENTRY *) arg;
+
+  status = css_queue_handed_off_packet (conn, &type);
+  if (status != NO_ERRORS)
+    {
+      er_log_debug (ARG_FILE_LINE, "css_connection_io_handoff_handler: "
+		    "css_queue_handed_off_packet() error %d\n", status);
+      (*css_Connection_error_handler) (thread_p, conn);
+      return 0;
+    }
+
+  if (type == COMMAND_TYPE)
+    {
+      job = css_make_job_entry (conn, css_Request_handler,
+				(CSS_THREAD_ARG) conn, -1);
+      if (job)
+	{
+	  css_add_to_job_queue (job);
+	}
+    }
+
+  return css_connection_handler_thread (thread_p, conn);
+}
+
+/*
+ * css_sweep_connection_io() - periodic checks of the connections of an I/O
+ *                             daemon
+ *   return:
+ *   thread_p(in):
+ *   io_index(in):
+ *
+ * Note: This does what css_connection_handler_thread () does when its
+ *       select () times out: it lets go of connections stopped by
+ *       css_block_all_active_conn (), closes the ones shut down by a worker
+ *       and refuses idle clients when the server is becoming standby.
+ *       Dead peers are reported by epoll itself, so css_peer_alive () is not
+ *       needed here.
+ */
+static void
+css_sweep_connection_io (THREAD_ENTRY * thread_p, int io_index)
+{
+  CSS_CONN_ENTRY *conn;
+  int status;
+
+  csect_enter_critical_section_as_reader (thread_p, &css_Active_conn_csect,
+					  INF_WAIT);
+
+  for (conn = css_Active_conn_anchor; conn != NULL; conn = conn->next)
+    {
+      if (conn->io_index != io_index)
+	{
+	  continue;
+	}
+
+      if (conn->stop_talk == true)
+	{
+	  css_unregister_connection_io (thread_p, conn);
+	  continue;
+	}
+
+      if (css_check_conn (conn) != NO_ERROR)
+	{
+	  status = CONNECTION_CLOSED;
+	}
+      else if (ha_Server_state == HA_SERVER_STATE_TO_BE_STANDBY
+	       && conn->in_transaction == false
+	       && thread_has_threads (thread_p, conn->transaction_id,
+				      conn->client_id) == 0)
+	{
+	  status = REQUEST_REFUSED;
+	}
+      else
+	{
+	  continue;
+	}
+
+      css_close_connection_io (thread_p, conn, status);
+    }
+
+  csect_exit_critical_section (&css_Active_conn_csect);
+}
+
+/*
+ * css_connection_io_handler() - Accept/process requests from the clients
+ *                               of a connection I/O daemon
+ *   return:
+ *   thread_p(in): the I/O daemon
+ *   io_index(in): which epoll set it serves
+ *
+ * Note: Instead of one css_connection_handler_thread () per client, a few
+ *       daemons wait on the sockets of all clients with epoll, read each
+ *       request as it arrives and queue it to the job queue, so an idle
+ *       client costs no thread. The sockets are read without blocking and
+ *       a request is put together in conn->read_state as its pieces come,
+ *       so a slow client does not hold up the others. A connection routed
+ *       to a remote server is handed to a css_connection_handler_thread ().
+ */
+void
+css_connection_io_handler (THREAD_ENTRY * thread_p, int io_index)
+{
+  struct epoll_event events[CSS_IO_MAX_EVENTS];
+  CSS_CONN_ENTRY *conn;
+  CSS_JOB_ENTRY *job;
+  time_t last_sweep_time, now;
+  int n, i, type, status;
+
+  if (io_index >= css_Num_io_threads)
+    {
+      /* css_init_connection_io () failed; nothing to serve */
+      return;
+    }
+
+  last_sweep_time = time (NULL);
+
+  while (thread_p->shutdown == false)
+    {
+      n = epoll_wait (css_Io_epoll_fd[io_index], events, CSS_IO_MAX_EVENTS,
+		      1000);
+      if (n < 0)
+	{
+	  if (errno == EINTR)
+	    {
+	      continue;
+	    }
+	  er_log_debug (ARG_FILE_LINE, "css_connection_io_handler: "
+			"epoll_wait() error %d\n", errno);
+	  break;
+	}
+
+      for (i = 0; i < n; i++)
+	{
+	  conn = (CSS_CONN_ENTRY *) events[i].data.ptr;
+	  if (conn->io_index != io_index)
+	    {
+	      /* unregistered earlier in this round */
+	      continue;
+	    }
+
+	  if (conn->stop_talk == true)
+	    {
+	      /* blocked by css_block_all_active_conn () */
+	      css_unregister_connection_io (thread_p, conn);
+	      continue;
+	    }
+
+	  if (css_check_conn (conn) != NO_ERROR)
+	    {
+	      status = CONNECTION_CLOSED;
+	    }
+	  else if (events[i].events & (EPOLLIN | EPOLLRDHUP))
+	    {
+	      /* read what has arrived of a request and enqueue it to appr.
+	         queue once it is complete; never wait for the client */
+	      status = css_read_and_queue_nowait (conn, &type);
+	      if (status == NO_ERRORS && type == COMMAND_TYPE)
+		{
+		  /* if new command request has arrived,
+		     make new job and add it to job queue */
+		  job = css_make_job_entry (conn, css_Request_handler,
+					    (CSS_THREAD_ARG) conn, -1);
+		  if (job)
+		    {
+		      css_add_to_job_queue (job);
+		    }
+		}
+	      else if (status == NO_ERRORS && css_read_is_handed_off (conn))
+		{
+		  css_handoff_connection_io (thread_p, conn);
+		}
+	    }
+	  else
+	    {
+	      /* EPOLLERR or EPOLLHUP */
+	      status = ERROR_ON_READ;
+	    }
+
+	  if (status != NO_ERRORS)
+	    {
+	      css_close_connection_io (thread_p, conn, status);
+	    }
+	}
+
+      now = time (NULL);
+      if (now != last_sweep_time)
+	{
+	  css_sweep_connection_io (thread_p, io_index);
+	  last_sweep_time = now;
+	}
+    }
+}
+#endif /* LINUX */
+
 /*
  * css_internal_request_handler() -
  *   return:
@@ -33,6 +33,10 @@
 
 extern void css_block_all_active_conn (unsigned short stop_phase);
 extern void css_broadcast_shutdown_thread (void);
+#if defined(LINUX)
+extern void css_connection_io_handler (THREAD_ENTRY * thread_p,
+				       int io_index);
+#endif /* LINUX */
 
 #if defined(WINDOWS)
 extern unsigned __stdcall css_oob_handler_thread (void *arg);
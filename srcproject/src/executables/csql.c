@@ -154,6 +154,7 @@ enum
 { HISTO_OFF, HISTO_ON, HISTO_ALL };
 static int csql_Is_histo_on = HISTO_OFF;
 static bool csql_Is_time_on = false;
+static bool csql_Is_profile_on = false;
 
 static jmp_buf csql_Jmp_buf;
 
@@ -940,6 +941,30 @@ start_csql (CSQL_ARGUMENT * csql_arg)
 	    }
 	  break;
 
+	case S_CMD_PROFILE:
+	  if (!strcasecmp (argument, "on"))
+	    {
+	      if (qmgr_set_query_profile (true) == NO_ERROR)
+		{
+		  csql_Is_profile_on = true;
+		}
+	      else
+		{
+		  fprintf (csql_Output_fp, "Error on profile command\n");
+		}
+	    }
+	  else if (!strcasecmp (argument, "off"))
+	    {
+	      (void) qmgr_set_query_profile (false);
+	      csql_Is_profile_on = false;
+	    }
+	  else
+	    {
+	      fprintf (csql_Output_fp, "PROFILE IS %s\n",
+		       (csql_Is_profile_on ? "ON" : "OFF"));
+	    }
+	  break;
+
 	case S_CMD_HISTO:
 	  if (histo_is_supported ())
 	    {
@@ -1786,6 +1811,11 @@ csql_execute_statements (const CSQL_ARGUMENT * csql_arg, int type,
 		   elapsed_time.tv_sec, elapsed_time.tv_usec);
 	}
 
+      if (csql_Is_profile_on)
+	{
+	  qmgr_dump_query_profile (csql_Output_fp);
+	}
+
       if (csql_arg->auto_commit && PRM_CSQL_AUTO_COMMIT
 	  && stmt_type != CUBRID_STMT_COMMIT_WORK
 	  && stmt_type != CUBRID_STMT_ROLLBACK_WORK)
@@ -226,6 +226,7 @@ typedef enum
   S_CMD_ECHO,
   S_CMD_DATE,
   S_CMD_TIME,
+  S_CMD_PROFILE,
 
 /* Histogram profile stuff */
   S_CMD_HISTO,
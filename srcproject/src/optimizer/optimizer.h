@@ -164,6 +164,7 @@ extern const char *qo_plan_set_cost_fn (const char *, int);
 extern int qo_plan_get_cost_fn (const char *);
 extern PT_NODE *qo_plan_iscan_sort_list (QO_PLAN *);
 extern bool qo_plan_skip_orderby (QO_PLAN * plan);
+extern bool qo_plan_use_hash_aggregate (QO_PLAN * plan);
 extern void qo_set_cost (DB_OBJECT * target, DB_VALUE * result,
 			 DB_VALUE * plan, DB_VALUE * cost);
 
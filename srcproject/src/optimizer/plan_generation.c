@@ -217,6 +217,14 @@ make_mergelist_proc (QO_ENV * env,
   ls_merge = &merge->proc.mergelist.ls_merge;
 
   ls_merge->join_type = plan->plan_un.join.join_type;
+  if (plan->plan_un.join.join_method == QO_JOINMETHOD_HASH_JOIN)
+    {
+      ls_merge->join_method = QFILE_HASH_JOIN;
+    }
+  else
+    {
+      ls_merge->join_method = QFILE_MERGE_JOIN;
+    }
 
   for (i = bitset_iterate (&(plan->plan_un.join.join_terms), &bi);
        i != -1; i = bitset_next_member (&bi))
@@ -266,8 +274,18 @@ make_mergelist_proc (QO_ENV * env,
       goto exit_on_error;
     }
 
-  left_order = left->orderby_list = make_sort_list_after_eqclass (env, ncols);
-  rght_order = rght->orderby_list = make_sort_list_after_eqclass (env, ncols);
+  if (ls_merge->join_method == QFILE_HASH_JOIN)
+    {
+      /* hash join reads both lists as they are */
+      left_order = rght_order = NULL;
+    }
+  else
+    {
+      left_order = left->orderby_list =
+	make_sort_list_after_eqclass (env, ncols);
+      rght_order = rght->orderby_list =
+	make_sort_list_after_eqclass (env, ncols);
+    }
 
   cnt = 0;			/* init */
   left_epos = rght_epos = 0;	/* init */
@@ -349,6 +367,12 @@ make_mergelist_proc (QO_ENV * env,
 
       ls_merge->ls_inner_unique[cnt] = false;	/* currently, unused */
 
+      if (ls_merge->join_method == QFILE_HASH_JOIN)
+	{
+	  cnt++;
+	  continue;
+	}
+
       if (left_order == NULL)
 	{
 	  er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
@@ -963,7 +987,9 @@ add_sort_spec (QO_ENV * env, XASL_NODE * xasl, QO_PLAN * plan,
     {
       if (xasl
 	  && subplan->plan_type == QO_PLANTYPE_JOIN
-	  && subplan->plan_un.join.join_method == QO_JOINMETHOD_MERGE_JOIN)
+	  && (subplan->plan_un.join.join_method == QO_JOINMETHOD_MERGE_JOIN
+	      || (subplan->plan_un.join.join_method
+		  == QO_JOINMETHOD_HASH_JOIN)))
 	{
 	  PT_NODE *instnum_pred;
 
@@ -1801,6 +1827,7 @@ gen_outer (QO_ENV * env,
 	  break;
 
 	case QO_JOINMETHOD_MERGE_JOIN:
+	case QO_JOINMETHOD_HASH_JOIN:
 	  /*
 	   * The optimizer isn't supposed to produce plans in which a
 	   * merge join isn't "shielded" by a sort (temp file) plan,
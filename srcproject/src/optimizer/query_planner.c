@@ -62,6 +62,11 @@
 #define TEMP_SETUP_COST 5.0
 #define NONGROUPED_SCAN_COST 0.1
 
+/* hash GROUP BY/DISTINCT: minimum input rows per group, and the assumed
+   size of a group state in bytes */
+#define HASH_AGGREGATE_MIN_GROUP_ROWS 4.0
+#define HASH_AGGREGATE_GROUP_SIZE 256.0
+
 #define	qo_scan_walk	qo_generic_walk
 #define	qo_worst_walk	qo_generic_walk
 
@@ -94,6 +99,7 @@ static void qo_join_free (QO_PLAN *);
 
 static void qo_scan_fprint (QO_PLAN *, FILE *, int);
 static void qo_sort_fprint (QO_PLAN *, FILE *, int);
+static bool qo_sort_is_topn (QO_PLAN *);
 static void qo_join_fprint (QO_PLAN *, FILE *, int);
 static void qo_follow_fprint (QO_PLAN *, FILE *, int);
 static void qo_worst_fprint (QO_PLAN *, FILE *, int);
@@ -123,6 +129,7 @@ static void qo_sscan_cost (QO_PLAN *);
 static void qo_iscan_cost (QO_PLAN *);
 static void qo_sort_cost (QO_PLAN *);
 static void qo_mjoin_cost (QO_PLAN *);
+static void qo_hjoin_cost (QO_PLAN *);
 static void qo_follow_cost (QO_PLAN *);
 static void qo_worst_cost (QO_PLAN *);
 static void qo_zero_cost (QO_PLAN *);
@@ -267,6 +274,17 @@ static QO_PLAN_VTBL qo_merge_join_plan_vtbl = {
   "Merge join"
 };
 
+static QO_PLAN_VTBL qo_hash_join_plan_vtbl = {
+  "h-join",
+  qo_join_fprint,
+  qo_join_walk,
+  qo_join_free,
+  qo_hjoin_cost,
+  qo_hjoin_cost,
+  qo_join_info,
+  "Hash join"
+};
+
 static QO_PLAN_VTBL qo_follow_plan_vtbl = {
   "follow",
   qo_follow_fprint,
@@ -307,6 +325,7 @@ QO_PLAN_VTBL *all_vtbls[] = {
   &qo_nl_join_plan_vtbl,
   &qo_idx_join_plan_vtbl,
   &qo_merge_join_plan_vtbl,
+  &qo_hash_join_plan_vtbl,
   &qo_follow_plan_vtbl,
   &qo_set_follow_plan_vtbl,
   &qo_worst_plan_vtbl
@@ -984,6 +1003,90 @@ qo_top_plan_new (QO_PLAN * plan)
   return plan;
 }
 
+/*
+ * qo_plan_use_hash_aggregate () - check if the GROUP BY or DISTINCT of the
+ *				   top-level plan may be done by hashing
+ *   return: true/false
+ *   plan(in): QO_PLAN
+ *
+ * Note: Hashing pays off when there are few groups compared with the
+ *       input rows. The number of groups is estimated from the partial key
+ *       counts of the indexes on the grouping columns; if any column has
+ *       no index statistics, the sort-based processing is kept.
+ */
+bool
+qo_plan_use_hash_aggregate (QO_PLAN * plan)
+{
+  QO_ENV *env;
+  PT_NODE *tree, *group_by, *col, *expr;
+  SORT_TYPE sort_type;
+  double ngroups, ncard;
+  int icard;
+
+  /* find the top-level GROUP BY or DISTINCT sort plan */
+  for (; plan && plan->plan_type == QO_PLANTYPE_SORT;
+       plan = plan->plan_un.sort.subplan)
+    {
+      if (plan->plan_un.sort.sort_type == SORT_GROUPBY
+	  || plan->plan_un.sort.sort_type == SORT_DISTINCT)
+	{
+	  break;
+	}
+    }
+
+  if (plan == NULL || plan->plan_type != QO_PLANTYPE_SORT
+      || plan->info == NULL || (env = (plan->info)->env) == NULL
+      || (tree = QO_ENV_PT_TREE (env)) == NULL
+      || tree->node_type != PT_SELECT)
+    {
+      return false;
+    }
+
+  sort_type = plan->plan_un.sort.sort_type;
+  group_by = tree->info.query.q.select.group_by;
+  if (sort_type == SORT_GROUPBY)
+    {
+      if (group_by == NULL || group_by->with_rollup)
+	{
+	  return false;
+	}
+      col = group_by;
+    }
+  else
+    {
+      /* the groups of DISTINCT over aggregated rows can not be estimated */
+      if (group_by != NULL)
+	{
+	  return false;
+	}
+      col = tree->info.query.q.select.list;
+    }
+
+  ngroups = 1.0;
+  for (; col; col = col->next)
+    {
+      expr = (sort_type == SORT_GROUPBY) ? col->info.sort_spec.expr : col;
+      if (expr == NULL
+	  || (expr->node_type != PT_NAME && expr->node_type != PT_DOT_))
+	{
+	  return false;
+	}
+
+      icard = qo_index_cardinality (env, expr);
+      if (icard <= 0)
+	{
+	  return false;
+	}
+      ngroups *= (double) icard;
+    }
+
+  ncard = (plan->plan_un.sort.subplan->info)->cardinality;
+
+  return (ngroups * HASH_AGGREGATE_MIN_GROUP_ROWS <= ncard
+	  && ngroups * HASH_AGGREGATE_GROUP_SIZE <=
+	  (double) PRM_SR_NBUFFERS * (double) IO_PAGESIZE) ? true : false;
+}
+
 /*
  * qo_generic_walk () -
  *   return:
@@ -1833,6 +1936,30 @@ qo_sort_walk (QO_PLAN * plan,
     (*parent_fn) (plan, parent_data);
 }
 
+/*
+ * qo_sort_is_topn () - check if the ORDER BY sort may keep only its first
+ *			tuples in memory
+ *   return: true/false
+ *   plan(in): sort plan
+ *
+ * Note: The executor derives the number of tuples from the orderby_num()
+ *       predicate and sorts with a bounded heap if they fit in the sort
+ *       buffer. pt_is_orderby_topn () tells if the generated XASL allows it.
+ */
+static bool
+qo_sort_is_topn (QO_PLAN * plan)
+{
+  QO_ENV *env;
+
+  if (plan->plan_un.sort.sort_type != SORT_ORDERBY
+      || plan->info == NULL || (env = (plan->info)->env) == NULL)
+    {
+      return false;
+    }
+
+  return pt_is_orderby_topn (QO_ENV_PARSER (env), QO_ENV_PT_TREE (env));
+}
+
 static void
 qo_sort_fprint (QO_PLAN * plan, FILE * f, int howfar)
 {
@@ -1848,7 +1975,7 @@ qo_sort_fprint (QO_PLAN * plan, FILE * f, int howfar)
       break;
 
     case SORT_ORDERBY:
-      fprintf (f, "(order by)");
+      fprintf (f, qo_sort_is_topn (plan) ? "(order by top-n)" : "(order by)");
       break;
 
     case SORT_DISTINCT:
@@ -1900,7 +2027,8 @@ qo_sort_info (QO_PLAN * plan, FILE * f, int howfar)
 
     case SORT_ORDERBY:
       fprintf (f, "\n%*c%s(%s)", (int) howfar, ' ',
-	       (plan->vtbl)->info_string, "order by");
+	       (plan->vtbl)->info_string,
+	       qo_sort_is_topn (plan) ? "order by top-n" : "order by");
       howfar += INDENT_INCR;
       break;
 
@@ -2133,6 +2261,24 @@ qo_join_new (QO_INFO * info,
 	inner = qo_sort_new (inner, inner->order, SORT_TEMP);
 
       break;
+
+    case QO_JOINMETHOD_HASH_JOIN:
+
+      plan->vtbl = &qo_hash_join_plan_vtbl;
+
+      /* The probe reads the outer list in its stored order, but the
+         inner tuples come out of hash buckets, so the result does not
+         carry any useful order. */
+      plan->order = QO_UNORDERED;
+
+      /* Both operands are read from list files like merge join, but
+         they need not be sorted. */
+      if (outer->plan_type != QO_PLANTYPE_SORT)
+	outer = qo_sort_new (outer, QO_UNORDERED, SORT_TEMP);
+      if (inner->plan_type != QO_PLANTYPE_SORT)
+	inner = qo_sort_new (inner, QO_UNORDERED, SORT_TEMP);
+
+      break;
     }				/* switch (join_method) */
 
   node =
@@ -2201,7 +2347,8 @@ qo_join_new (QO_INFO * info,
      We could push the cost into the merge plan itself, I suppose, but
      a rational implementation wouldn't impose this cost, and so I have
      hope that one day we'll be able to eliminate it. */
-  if (join_method == QO_JOINMETHOD_MERGE_JOIN)
+  if (join_method == QO_JOINMETHOD_MERGE_JOIN
+      || join_method == QO_JOINMETHOD_HASH_JOIN)
     plan = qo_sort_new (plan, plan->order, SORT_TEMP);
 #endif /* MERGE_ALWAYS_MAKES_LISTFILE */
 
@@ -2552,6 +2699,60 @@ qo_mjoin_cost (QO_PLAN * planp)
   planp->variable_io_cost = outer->variable_io_cost + inner->variable_io_cost;
 }				/* qo_mjoin_cost() */
 
+/*
+ * qo_hjoin_cost () -
+ *   return:
+ *   planp(in):
+ *
+ * Note: The inner list is read once to build the hash table and the outer
+ *       list once to probe it. When the inner list does not fit in the
+ *       sort buffer, both lists are split into partitions on temp volumes
+ *       and read once more. An inner list that would not fit even when
+ *       split into the most partitions has to be split again, so the
+ *       hash join is not used for it.
+ */
+static void
+qo_hjoin_cost (QO_PLAN * planp)
+{
+  QO_PLAN *inner;
+  QO_PLAN *outer;
+  double inner_pages, outer_pages;
+
+  inner = planp->plan_un.join.inner;
+  outer = planp->plan_un.join.outer;
+  /* CPU and IO costs which are fixed against join */
+  planp->fixed_cpu_cost = outer->fixed_cpu_cost + inner->fixed_cpu_cost;
+  planp->fixed_io_cost = outer->fixed_io_cost + inner->fixed_io_cost;
+  /* CPU and IO costs which are variable according to the join plan */
+  planp->variable_cpu_cost = outer->variable_cpu_cost +
+    inner->variable_cpu_cost;
+  /* build and probe cost */
+  planp->variable_cpu_cost += ((outer->info)->cardinality +
+			       (inner->info)->cardinality) *
+    (double) QO_CPU_WEIGHT;
+  planp->variable_io_cost = outer->variable_io_cost + inner->variable_io_cost;
+
+  inner_pages = ((inner->info)->cardinality *
+		 (double) (inner->info)->projected_size) /
+    (double) IO_PAGESIZE;
+  if (inner_pages > (double) QFILE_HASH_JOIN_MAX_PARTITIONS *
+      (double) PRM_SR_NBUFFERS)
+    {
+      planp->variable_cpu_cost = QO_INFINITY;
+      planp->variable_io_cost = QO_INFINITY;
+      return;
+    }
+
+  if (inner_pages > (double) PRM_SR_NBUFFERS)
+    {
+      /* partitioning cost: write and read both operands once more */
+      outer_pages = ((outer->info)->cardinality *
+		     (double) (outer->info)->projected_size) /
+	(double) IO_PAGESIZE;
+      planp->variable_io_cost += 2.0 * (inner_pages + MAX (1.0, outer_pages));
+    }
+}				/* qo_hjoin_cost() */
+
 /*
  * qo_follow_new () -
  *   return:
@@ -4876,6 +5077,117 @@ exit:
   return n;
 }
 
+/*
+ * examine_hash_join () -
+ *   return:
+ *   info(in):
+ *   join_type(in):
+ *   outer(in):
+ *   inner(in):
+ *   sm_join_terms(in):
+ *   duj_terms(in):
+ *   afj_terms(in):
+ *   sarged_terms(in):
+ *   pinned_subqueries(in):
+ *
+ * Note: A hash join uses the same equi-join edges as a merge join, but
+ *       neither operand has to be sorted. Only inner and left outer joins
+ *       are supported, and a left outer join must not have any during join
+ *       term other than the hashed edges.
+ */
+static int
+examine_hash_join (QO_INFO * info,
+		   JOIN_TYPE join_type,
+		   QO_INFO * outer,
+		   QO_INFO * inner,
+		   BITSET * sm_join_terms,
+		   BITSET * duj_terms,
+		   BITSET * afj_terms,
+		   BITSET * sarged_terms, BITSET * pinned_subqueries)
+{
+  int n = 0;
+  QO_PLAN *outer_plan, *inner_plan;
+  QO_NODE *inner_node;
+  int t;
+  BITSET_ITERATOR iter;
+  BITSET other_duj_terms;
+
+  bitset_init (&other_duj_terms, info->env);
+
+  if (join_type != JOIN_INNER && join_type != JOIN_LEFT)
+    {
+      goto exit;
+    }
+
+  /* the timing assumptions required by the fake terms are only satisfied
+   * by nested loops, as for merge join
+   */
+  if (bitset_intersects (sarged_terms, &(info->env->fake_terms)))
+    {
+      goto exit;
+    }
+
+  for (t = bitset_iterate (sm_join_terms, &iter); t != -1;
+       t = bitset_next_member (&iter))
+    {
+      if (QO_TERM_CLASS (QO_ENV_TERM (info->env, t)) == QO_TC_PATH)
+	{
+	  /* object references do not hash */
+	  goto exit;
+	}
+    }
+
+  if (join_type == JOIN_LEFT)
+    {
+      bitset_assign (&other_duj_terms, duj_terms);
+      bitset_difference (&other_duj_terms, sm_join_terms);
+      if (!bitset_is_empty (&other_duj_terms))
+	{
+	  goto exit;
+	}
+    }
+
+  /* At here, inner is single class spec */
+  inner_node =
+    QO_ENV_NODE (inner->env, bitset_first_member (&(inner->nodes)));
+
+  if (QO_NODE_HINT (inner_node)
+      & (PT_HINT_USE_NL | PT_HINT_USE_IDX | PT_HINT_USE_MERGE))
+    {
+      /* join hint: force nl-join, idx-join, m-join;
+       */
+      goto exit;
+    }
+
+  if ((outer_plan = qo_find_best_plan_on_info (outer, QO_UNORDERED,
+					       1.0)) == NULL)
+    {
+      goto exit;
+    }
+  if ((inner_plan = qo_find_best_plan_on_info (inner, QO_UNORDERED,
+					       1.0)) == NULL)
+    {
+      goto exit;
+    }
+
+  n = qo_check_plan_on_info (info,
+			     qo_join_new (info,
+					  join_type,
+					  QO_JOINMETHOD_HASH_JOIN,
+					  outer_plan,
+					  inner_plan,
+					  sm_join_terms,
+					  duj_terms,
+					  afj_terms,
+					  sarged_terms, pinned_subqueries));
+
+exit:
+
+  bitset_delset (&other_duj_terms);
+
+  return n;
+}
+
 /*
  * qo_examine_correlated_index () -
  *   return: int
@@ -6105,6 +6417,17 @@ planner_visit_node (QO_PLANNER * planner,
 					&duj_terms,
 					&afj_terms,
 					&sarged_terms, &pinned_subqueries);
+
+	    /* STEP 5-5: examine hash-join
+	     */
+	    kept += examine_hash_join (new_info,
+				       join_type,
+				       head_info,
+				       tail_info,
+				       &sm_join_terms,
+				       &duj_terms,
+				       &afj_terms,
+				       &sarged_terms, &pinned_subqueries);
 	  }
 #endif /* MERGE_JOINS */
       }
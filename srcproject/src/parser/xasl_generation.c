@@ -83,6 +83,12 @@ typedef struct set_numbering_node_etc_info
   DB_VALUE **ordbynum_valp;
 } SET_NUMBERING_NODE_ETC_INFO;
 
+typedef struct ordbynum_topn_info
+{
+  bool has_ordbynum;		/* orderby_num() is referred to */
+  bool has_modulus;		/* a compared operand holds a modulus */
+} ORDBYNUM_TOPN_INFO;
+
 typedef struct pred_regu_variable_p_list_node *PRED_REGU_VARIABLE_P_LIST,
   PRED_REGU_VARIABLE_P_LIST_NODE;
 struct pred_regu_variable_p_list_node
@@ -184,6 +190,9 @@ static REGU_VARIABLE *pt_make_regu_subquery (PARSER_CONTEXT * parser,
 static PT_NODE *pt_set_numbering_node_etc_pre (PARSER_CONTEXT * parser,
 					       PT_NODE * node, void *arg,
 					       int *continue_walk);
+static PT_NODE *pt_find_ordbynum_modulus_pre (PARSER_CONTEXT * parser,
+					      PT_NODE * node, void *arg,
+					      int *continue_walk);
 static REGU_VARIABLE *pt_make_regu_numbering (PARSER_CONTEXT * parser,
 					      const PT_NODE * node);
 static void pt_to_misc_operand (REGU_VARIABLE * regu,
@@ -2065,6 +2074,144 @@ pt_to_pred_expr (PARSER_CONTEXT * parser, PT_NODE * node)
   return pt_to_pred_expr_with_arg (parser, node, NULL);
 }
 
+/*
+ * pt_find_ordbynum_modulus_pre () - look for orderby_num() and for the
+ *				     modulus operator in an ORDER BY FOR term
+ *   return:
+ *   parser(in):
+ *   node(in):
+ *   arg(in/out): ORDBYNUM_TOPN_INFO
+ *   continue_walk(in/out):
+ */
+static PT_NODE *
+pt_find_ordbynum_modulus_pre (PARSER_CONTEXT * parser, PT_NODE * node,
+			      void *arg, int *continue_walk)
+{
+  ORDBYNUM_TOPN_INFO *info = (ORDBYNUM_TOPN_INFO *) arg;
+
+  if (PT_IS_QUERY_NODE_TYPE (node->node_type))
+    {
+      *continue_walk = PT_LIST_WALK;
+    }
+  else if (node->node_type == PT_EXPR)
+    {
+      if (node->info.expr.op == PT_ORDERBY_NUM)
+	{
+	  info->has_ordbynum = true;
+	}
+      else if (node->info.expr.op == PT_MODULUS)
+	{
+	  info->has_modulus = true;
+	}
+    }
+
+  return node;
+}
+
+/*
+ * pt_is_orderby_topn () - check if the XASL generated for a query lets the
+ *			   executor keep only the first tuples of its ORDER BY
+ *   return: true/false
+ *   parser(in):
+ *   query(in): PT_SELECT node
+ *
+ * Note: This follows the rules of pt_to_pred_expr_with_arg () and of
+ *       qexec_orderby_distinct (): the query must not be DISTINCT, its
+ *       ORDER BY FOR predicate must refer to orderby_num() and must not set
+ *       PT_PRED_ARG_ORDBYNUM_CONTINUE, i.e. it has no OR term, no NOT, <>,
+ *       NOT BETWEEN, multi-range BETWEEN, IN, =SOME, <>SOME or LIKE term and
+ *       its compared operands hold no modulus.
+ */
+bool
+pt_is_orderby_topn (PARSER_CONTEXT * parser, PT_NODE * query)
+{
+  PT_NODE *node, *save_node, *save_next;
+  ORDBYNUM_TOPN_INFO info, operand_info;
+
+  if (query == NULL || query->node_type != PT_SELECT
+      || query->info.query.all_distinct == PT_DISTINCT
+      || query->info.query.orderby_for == NULL)
+    {
+      return false;
+    }
+
+  info.has_ordbynum = false;
+  info.has_modulus = false;
+
+  for (node = query->info.query.orderby_for; node; node = node->next)
+    {
+      save_node = node;
+
+      CAST_POINTER_TO_NODE (node);
+
+      if (node->or_next)
+	{
+	  return false;
+	}
+
+      if (node->node_type != PT_EXPR)
+	{
+	  node = save_node;
+	  continue;
+	}
+
+      switch (node->info.expr.op)
+	{
+	case PT_OR:
+	case PT_NOT:
+	case PT_SETNEQ:
+	case PT_NE:
+	case PT_NOT_BETWEEN:
+	case PT_IS_NOT_IN:
+	case PT_IS_IN:
+	case PT_EQ_SOME:
+	case PT_NE_SOME:
+	case PT_NOT_LIKE:
+	case PT_LIKE:
+	  return false;
+
+	case PT_BETWEEN:
+	case PT_RANGE:
+	  if (node->info.expr.arg2 && node->info.expr.arg2->or_next)
+	    {
+	      return false;
+	    }
+	  break;
+
+	default:
+	  break;
+	}
+
+      /* the operands of AND and XOR are converted on their own and do not
+         report back the modulus operator */
+      save_next = node->next;
+      node->next = NULL;
+      if (node->info.expr.op == PT_AND || node->info.expr.op == PT_XOR)
+	{
+	  operand_info.has_ordbynum = false;
+	  operand_info.has_modulus = false;
+	  (void) parser_walk_tree (parser, node, pt_find_ordbynum_modulus_pre,
+				   &operand_info, NULL, NULL);
+	  info.has_ordbynum |= operand_info.has_ordbynum;
+	}
+      else
+	{
+	  (void) parser_walk_tree (parser, node, pt_find_ordbynum_modulus_pre,
+				   &info, NULL, NULL);
+	}
+      node->next = save_next;
+
+      if (info.has_modulus)
+	{
+	  return false;
+	}
+
+      node = save_node;
+    }
+
+  return info.has_ordbynum;
+}
+
 
 
 
@@ -12447,6 +12594,12 @@ pt_to_buildlist_proc (PARSER_CONTEXT * parser, PT_NODE * select_node,
 	  orderby_ok = ((xasl->orderby_list != NULL) || orderby_skip);
 	}
 
+      /* check group by/distinct opt */
+      if (qo_plan && qo_plan_use_hash_aggregate (qo_plan) == true)
+	{
+	  XASL_SET_FLAG (xasl, XASL_USE_HASH_AGGREGATE);
+	}
+
       /* union fields for BUILDLIST_PROC_NODE - BUILDLIST_PROC */
       if (select_node->info.query.q.select.group_by)
 	{
@@ -114,6 +114,7 @@ extern REGU_VARIABLE *pt_to_regu_variable (PARSER_CONTEXT * p, PT_NODE * node,
 extern PRED_EXPR *pt_to_pred_expr (PARSER_CONTEXT * p, PT_NODE * node);
 extern PRED_EXPR *pt_to_pred_expr_with_arg (PARSER_CONTEXT * p,
 					    PT_NODE * node, int *argp);
+extern bool pt_is_orderby_topn (PARSER_CONTEXT * parser, PT_NODE * query);
 extern XASL_NODE *parser_generate_xasl (PARSER_CONTEXT * p, PT_NODE * node);
 extern PARSER_VARCHAR *pt_print_node_value (PARSER_CONTEXT * parser,
 					    const PT_NODE * val);
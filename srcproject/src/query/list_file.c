@@ -209,6 +209,13 @@ static void qfile_set_dirty_page_and_skip_logging (THREAD_ENTRY * thread_p,
 static bool qfile_is_first_tuple (QFILE_LIST_ID * list_id_p);
 static bool qfile_is_last_page_full (QFILE_LIST_ID * list_id_p,
 				     int tuple_length, bool is_ovf_page);
+static bool qfile_is_stream_client_waiting (QFILE_LIST_ID * list_id_p,
+					    PAGE_PTR page_p,
+					    bool is_ovf_page);
+#if defined (SERVER_MODE)
+static int qfile_wait_for_stream_client (THREAD_ENTRY * thread_p,
+					 QFILE_LIST_ID * list_id_p);
+#endif /* SERVER_MODE */
 static void qfile_set_dirty_page (THREAD_ENTRY * thread_p, PAGE_PTR page_p,
 				  int free_page, QMGR_TEMP_FILE * vfid_p);
 static PAGE_PTR qfile_allocate_new_page (THREAD_ENTRY * thread_p,
@@ -1491,6 +1498,127 @@ qfile_is_last_page_full (QFILE_LIST_ID * list_id_p, int tuple_length,
   return result;
 }
 
+/*
+ * qfile_is_stream_client_waiting () - Is a client already waiting for the
+ *                                     first page of a streamed result ?
+ *   return: bool
+ *   list_id(in): List File Identifier
+ *   page_ptr(in): Last page of the list file
+ *   is_ovf_page(in):
+ *
+ * Note: The first page of a streamed result is handed off as soon as it
+ *       holds a tuple and the client is waiting for it, so that the first
+ *       rows do not wait for a full page to be produced.
+ */
+static bool
+qfile_is_stream_client_waiting (QFILE_LIST_ID * list_id_p, PAGE_PTR page_p,
+				bool is_ovf_page)
+{
+#if defined (SERVER_MODE)
+  QMGR_TEMP_FILE *tfile_vfid_p = list_id_p->tfile_vfid;
+
+  return (!is_ovf_page && tfile_vfid_p != NULL
+	  && tfile_vfid_p->stream_lead_pages > 0
+	  && list_id_p->page_cnt == 1
+	  && tfile_vfid_p->membuf_thread_p != NULL
+	  && QFILE_GET_TUPLE_COUNT (page_p) > 0);
+#else /* SERVER_MODE */
+  return false;
+#endif /* SERVER_MODE */
+}
+
+#if defined (SERVER_MODE)
+/*
+ * qfile_wait_for_stream_client () - Wait until the client has caught up with
+ *                                   a streamed result
+ *   return: NO_ERROR, ER_FAILED if the query is interrupted, or
+ *           ER_QPROC_ASYNC_CLIENT_TIMEOUT
+ *   list_id(in): List File Identifier
+ *
+ * Note: An async query may not produce more than async_query_max_lead_pages
+ *       pages that have not been sent to the client yet. This bounds the
+ *       temp space and the work done for results the client never reads.
+ *       The producer sleeps on stream_cond, which is signalled when the
+ *       client fetches pages or ends the query. A client that does not fetch
+ *       anything for async_query_client_wait_secs fails the query.
+ */
+static int
+qfile_wait_for_stream_client (THREAD_ENTRY * thread_p,
+			      QFILE_LIST_ID * list_id_p)
+{
+  QMGR_TEMP_FILE *tfile_vfid_p = list_id_p->tfile_vfid;
+  time_t deadline;
+  int sent_pages;
+  int rv;
+#if defined(WINDOWS)
+  int to;
+#else /* WINDOWS */
+  struct timespec to;
+#endif /* WINDOWS */
+
+  if (tfile_vfid_p == NULL || tfile_vfid_p->stream_lead_pages <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  sent_pages = tfile_vfid_p->stream_sent_pages;
+  deadline = time (NULL) + PRM_ASYNC_QUERY_CLIENT_WAIT_SECS;
+
+  while (true)
+    {
+      /* qmgr_interrupt_query () takes the query locks; not under membuf_mutex */
+      if (qmgr_interrupt_query (thread_p, list_id_p->query_id) == true)
+	{
+	  return ER_FAILED;
+	}
+
+      MUTEX_LOCK (rv, tfile_vfid_p->membuf_mutex);
+
+      /*
+       * Go on when the client caught up, when the client waits for the page
+       * under construction, or when the limit is lifted because the client
+       * waits for the query to end.
+       */
+      if (list_id_p->page_cnt - tfile_vfid_p->stream_sent_pages
+	  <= tfile_vfid_p->stream_lead_pages
+	  || tfile_vfid_p->membuf_thread_p != NULL
+	  || tfile_vfid_p->stream_lead_pages <= 0)
+	{
+	  MUTEX_UNLOCK (tfile_vfid_p->membuf_mutex);
+	  return NO_ERROR;
+	}
+
+      if (tfile_vfid_p->stream_sent_pages != sent_pages)
+	{
+	  /* the client is still reading; restart the clock */
+	  sent_pages = tfile_vfid_p->stream_sent_pages;
+	  deadline = time (NULL) + PRM_ASYNC_QUERY_CLIENT_WAIT_SECS;
+	}
+      else if (time (NULL) >= deadline)
+	{
+	  MUTEX_UNLOCK (tfile_vfid_p->membuf_mutex);
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+		  ER_QPROC_ASYNC_CLIENT_TIMEOUT, 1,
+		  PRM_ASYNC_QUERY_CLIENT_WAIT_SECS);
+	  return ER_QPROC_ASYNC_CLIENT_TIMEOUT;
+	}
+
+      /* wake up every second to check for an interrupt */
+#if defined(WINDOWS)
+      to = 1000;
+#else /* WINDOWS */
+      to.tv_sec = time (NULL) + 1;
+      to.tv_nsec = 0;
+#endif /* WINDOWS */
+      (void) COND_TIMEDWAIT (tfile_vfid_p->stream_cond,
+			     tfile_vfid_p->membuf_mutex, to);
+#if !defined(WINDOWS)
+      MUTEX_UNLOCK (tfile_vfid_p->membuf_mutex);
+#endif /* !WINDOWS */
+    }
+}
+#endif /* SERVER_MODE */
+
 static void
 qfile_set_dirty_page (THREAD_ENTRY * thread_p, PAGE_PTR page_p, int free_page,
 		      QMGR_TEMP_FILE * vfid_p)
@@ -1511,6 +1639,14 @@ qfile_allocate_new_page (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id_p,
   PAGE_PTR new_page_p;
   VPID new_vpid;
 
+#if defined (SERVER_MODE)
+  if (page_p != NULL && !is_ovf_page
+      && qfile_wait_for_stream_client (thread_p, list_id_p) != NO_ERROR)
+    {
+      return NULL;
+    }
+#endif /* SERVER_MODE */
+
   new_page_p = qmgr_get_new_page (thread_p, &new_vpid, list_id_p->tfile_vfid);
   if (new_page_p == NULL)
     {
@@ -1604,7 +1740,8 @@ qfile_allocate_new_page_if_need (THREAD_ENTRY * thread_p,
   PAGE_PTR new_page_p;
 
   if (qfile_is_first_tuple (list_id_p)
-      || qfile_is_last_page_full (list_id_p, tuple_length, is_ovf_page))
+      || qfile_is_last_page_full (list_id_p, tuple_length, is_ovf_page)
+      || qfile_is_stream_client_waiting (list_id_p, *page_p, is_ovf_page))
     {
       new_page_p = qfile_allocate_new_page (thread_p, list_id_p, *page_p,
 					    is_ovf_page);
@@ -2184,6 +2321,7 @@ xqfile_get_list_file_page (THREAD_ENTRY * thread_p, QUERY_ID query_id,
   QMGR_WAIT_ARGS arg;
   int error = NO_ERROR;
   int rv;
+  int num_pages = 0;
 #endif /* SERVER_MODE */
 
   *page_size_p = 0;
@@ -2344,6 +2482,9 @@ xqfile_get_list_file_page (THREAD_ENTRY * thread_p, QUERY_ID query_id,
 #endif /* 0 */
 		      slept = true;
 
+		      /* do not let the producer wait for us in turn */
+		      COND_SIGNAL (tfile_vfid_p->stream_cond);
+
 		      thread_suspend_with_other_mutex (tfile_vfid_p->
 						       membuf_thread_p,
 						       &tfile_vfid_p->
@@ -2483,6 +2624,9 @@ get_page:
       qmgr_free_old_page (thread_p, page_p, tfile_vfid_p);
 
       *page_size_p += DB_PAGESIZE;
+#if defined(SERVER_MODE)
+      num_pages++;
+#endif /* SERVER_MODE */
 
       /* next page to append does not exists, stop appending */
       if (next_vpid.pageid == NULL_PAGEID)
@@ -2495,6 +2639,17 @@ get_page:
 
   *page_size_p += one_page_size - DB_PAGESIZE;
 
+#if defined(SERVER_MODE)
+  /* let a streaming query that waits for the client go on */
+  if (tfile_vfid_p != NULL && tfile_vfid_p->stream_lead_pages > 0)
+    {
+      MUTEX_LOCK (rv, tfile_vfid_p->membuf_mutex);
+      tfile_vfid_p->stream_sent_pages += num_pages;
+      COND_SIGNAL (tfile_vfid_p->stream_cond);
+      MUTEX_UNLOCK (tfile_vfid_p->membuf_mutex);
+    }
+#endif /* SERVER_MODE */
+
   return NO_ERROR;
 }
 
@@ -4061,13 +4216,15 @@ qfile_clear_sort_info (SORT_INFO * sort_info_p)
  *   put_fn(in):
  *   cmp_fn(in):
  *   extra_arg(in):
+ *   limit(in): number of leading tuples of the sorted order that are
+ *              needed, or NO_SORT_LIMIT
  */
 QFILE_LIST_ID *
 qfile_sort_list_with_func (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id_p,
 			   SORT_LIST * sort_list_p, QUERY_OPTIONS option,
 			   int flag, SORT_GET_FUNC * get_func,
 			   SORT_PUT_FUNC * put_func, SORT_CMP_FUNC * cmp_func,
-			   void *extra_arg)
+			   void *extra_arg, int limit)
 {
   QFILE_LIST_ID *srlist_id;
   QFILE_LIST_SCAN_ID t_scan_id;
@@ -4133,7 +4290,8 @@ qfile_sort_list_with_func (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id_p,
 
   sort_result =
     sort_listfile (thread_p, NULL_VOLID, estimated_pages, get_func, &info,
-		   put_func, &info, cmp_func, &info.key_info, dup_option);
+		   put_func, &info, cmp_func, &info.key_info, dup_option,
+		   limit);
 
   if (sort_result < 0)
     {
@@ -4194,7 +4352,8 @@ qfile_sort_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id_p,
   ls_flag = (option == Q_DISTINCT) ? QFILE_FLAG_DISTINCT : QFILE_FLAG_ALL;
 
   return qfile_sort_list_with_func (thread_p, list_id_p, sort_list_p, option,
-				    ls_flag, NULL, NULL, NULL, NULL);
+				    ls_flag, NULL, NULL, NULL, NULL,
+				    NO_SORT_LIMIT);
 }
 
 /*
@@ -4904,6 +5063,8 @@ qfile_open_list_scan (QFILE_LIST_ID * list_id_p,
   scan_id_p->tplrec.size = 0;
   scan_id_p->tplrec.tpl = NULL;
 
+  scan_id_p->bulk_read = pgbuf_is_bulk_read_size (list_id_p->page_cnt);
+
   return NO_ERROR;
 }
 
@@ -4937,7 +5098,18 @@ qfile_scan_list (THREAD_ENTRY * thread_p, QFILE_LIST_SCAN_ID * scan_id_p,
 {
   SCAN_CODE qp_scan;
 
+  if (scan_id_p->bulk_read)
+    {
+      pgbuf_start_bulk_read (thread_p);
+    }
+
   qp_scan = (*scan_func) (thread_p, scan_id_p);
+
+  if (scan_id_p->bulk_read)
+    {
+      pgbuf_end_bulk_read (thread_p);
+    }
+
   if (qp_scan == S_SUCCESS)
     {
       qp_scan = qfile_retrieve_tuple (thread_p, scan_id_p, tuple_record_p,
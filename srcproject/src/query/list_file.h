@@ -147,7 +147,7 @@ extern QFILE_LIST_ID *qfile_sort_list_with_func (THREAD_ENTRY * thread_p,
 						 SORT_GET_FUNC * get_fn,
 						 SORT_PUT_FUNC * put_fn,
 						 SORT_CMP_FUNC * cmp_fn,
-						 void *extra_arg);
+						 void *extra_arg, int limit);
 extern QFILE_LIST_ID *qfile_sort_list (THREAD_ENTRY * thread_p,
 				       QFILE_LIST_ID * list_id,
 				       SORT_LIST * sort_list,
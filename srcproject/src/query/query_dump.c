@@ -233,6 +233,8 @@ qdump_print_list_merge_info (QFILE_LIST_MERGE_INFO * merge_info_p)
     }
 
   fprintf (foutput, "[join type:%d]", merge_info_p->join_type);
+  fprintf (foutput, "[join method:%s]",
+	   merge_info_p->join_method == QFILE_HASH_JOIN ? "hash" : "merge");
   fprintf (foutput, "[single fetch:%d]\n", merge_info_p->single_fetch);
 
   qdump_print_column ("outer column position", merge_info_p->ls_column_cnt,
@@ -2392,6 +2394,13 @@ qdump_print_xasl (XASL_NODE * xasl_p)
 	  nflag++;
 	}
 
+      if (XASL_IS_FLAGED (xasl_p, XASL_USE_HASH_AGGREGATE))
+	{
+	  XASL_CLEAR_FLAG (xasl_p, XASL_USE_HASH_AGGREGATE);
+	  fprintf (foutput, "%sXASL_USE_HASH_AGGREGATE", (nflag ? "|" : ""));
+	  nflag++;
+	}
+
       if (xasl_p->flag)
 	{
 	  fprintf (foutput, "%d%s", xasl_p->flag, (nflag ? "|" : ""));
@@ -45,6 +45,24 @@
 
 #define UNKNOWN_CARD   -2	/* Unknown cardinality of a set member */
 
+/* max number of comparisons of a batch predicate */
+#define EVAL_BATCH_MAX_TERMS 8
+
+/* milliseconds of a day; a DATETIME is compared as date * this + time */
+#define EVAL_BATCH_MSECS_PER_DAY 86400000
+
+/* keep the rows of sel[] whose column value satisfies "op bound" */
+#define EVAL_BATCH_SELECT(col, op, bound) \
+  do \
+    { \
+      for (i = 0, n = 0; i < nsel; i++) \
+	{ \
+	  sel[n] = sel[i]; \
+	  n += ((col)[sel[i]] op (bound)); \
+	} \
+    } \
+  while (0)
+
 static DB_LOGICAL eval_negative (DB_LOGICAL res);
 static DB_LOGICAL eval_logical_result (DB_LOGICAL res1, DB_LOGICAL res2);
 static DB_LOGICAL eval_value_rel_cmp (DB_VALUE * dbval1, DB_VALUE * dbval2,
@@ -119,6 +137,12 @@ static DB_LOGICAL eval_sort_list_to_sort_list (THREAD_ENTRY * thread_p,
 static DB_LOGICAL eval_set_list_cmp (THREAD_ENTRY * thread_p,
 				     COMP_EVAL_TERM * et_comp, VAL_DESCR * vd,
 				     DB_VALUE * dbval1, DB_VALUE * dbval2);
+static bool eval_batch_collect_terms (PRED_EXPR * pr,
+				      EVAL_BATCH_TERM * terms, int *nterms);
+static EVAL_BATCH_KIND eval_batch_value (DB_VALUE * dbval, INT64 * ival,
+					 double *dval);
+static int eval_batch_term_select (EVAL_BATCH_TERM * term, int *sel,
+				   int nsel);
 
 /*
  * eval_negative () - negate the result
@@ -2818,3 +2842,413 @@ eval_key_filter (THREAD_ENTRY * thread_p, DB_VALUE * value,
 
   return ev_res;
 }
+
+/*
+ * eval_batch_collect_terms () - collect the comparisons of a predicate
+ *                               that can be evaluated in batch
+ *   return: true if the whole predicate can be evaluated in batch
+ *   pr(in): Predicate Expression Tree
+ *   terms(out): comparisons of the predicate, or NULL to count them
+ *   nterms(in/out): number of comparisons collected
+ *
+ * Note: Only conjunctions of comparisons (=, <>, <, <=, >, >=) between an
+ *       attribute and a constant or host variable are evaluated in batch.
+ */
+static bool
+eval_batch_collect_terms (PRED_EXPR * pr, EVAL_BATCH_TERM * terms,
+			  int *nterms)
+{
+  COMP_EVAL_TERM *et_comp;
+  REGU_VARIABLE *attr, *value;
+  REL_OP rel_op;
+
+  if (pr->type == T_PRED)
+    {
+      return (pr->pe.pred.bool_op == B_AND
+	      && eval_batch_collect_terms (pr->pe.pred.lhs, terms, nterms)
+	      && eval_batch_collect_terms (pr->pe.pred.rhs, terms, nterms));
+    }
+
+  if (pr->type != T_EVAL_TERM
+      || pr->pe.eval_term.et_type != T_COMP_EVAL_TERM
+      || *nterms >= EVAL_BATCH_MAX_TERMS)
+    {
+      return false;
+    }
+
+  et_comp = &pr->pe.eval_term.et.et_comp;
+  if (et_comp->lhs == NULL || et_comp->rhs == NULL)
+    {
+      return false;
+    }
+
+  if (et_comp->lhs->type == TYPE_ATTR_ID)
+    {
+      attr = et_comp->lhs;
+      value = et_comp->rhs;
+      rel_op = et_comp->rel_op;
+    }
+  else
+    {
+      /* value rel_op attr is evaluated as attr reversed_rel_op value */
+      attr = et_comp->rhs;
+      value = et_comp->lhs;
+      switch (et_comp->rel_op)
+	{
+	case R_GT:
+	  rel_op = R_LT;
+	  break;
+	case R_GE:
+	  rel_op = R_LE;
+	  break;
+	case R_LT:
+	  rel_op = R_GT;
+	  break;
+	case R_LE:
+	  rel_op = R_GE;
+	  break;
+	default:
+	  rel_op = et_comp->rel_op;
+	  break;
+	}
+    }
+
+  if (attr->type != TYPE_ATTR_ID
+      || (value->type != TYPE_DBVAL && value->type != TYPE_CONSTANT
+	  && value->type != TYPE_POS_VALUE))
+    {
+      return false;
+    }
+
+  switch (rel_op)
+    {
+    case R_EQ:
+    case R_NE:
+    case R_GT:
+    case R_GE:
+    case R_LT:
+    case R_LE:
+      break;
+    default:
+      return false;
+    }
+
+  if (terms != NULL)
+    {
+      terms[*nterms].attr = attr;
+      terms[*nterms].value = value;
+      terms[*nterms].rel_op = rel_op;
+      terms[*nterms].kind = EVAL_BATCH_NONE;
+    }
+  (*nterms)++;
+
+  return true;
+}
+
+/*
+ * eval_batch_value () - get a value as compared by a batch predicate
+ *   return: kind of the value, EVAL_BATCH_NONE if it is not compared in
+ *           batch
+ *   dbval(in): value, not NULL
+ *   ival(out): value of an integral kind
+ *   dval(out): value of EVAL_BATCH_DOUBLE kind
+ */
+static EVAL_BATCH_KIND
+eval_batch_value (DB_VALUE * dbval, INT64 * ival, double *dval)
+{
+  DB_DATETIME *datetime;
+
+  switch (DB_VALUE_DOMAIN_TYPE (dbval))
+    {
+    case DB_TYPE_SHORT:
+      *ival = DB_GET_SHORT (dbval);
+      return EVAL_BATCH_INT;
+
+    case DB_TYPE_INTEGER:
+      *ival = DB_GET_INT (dbval);
+      return EVAL_BATCH_INT;
+
+    case DB_TYPE_BIGINT:
+      *ival = DB_GET_BIGINT (dbval);
+      return EVAL_BATCH_INT;
+
+    case DB_TYPE_FLOAT:
+      *dval = DB_GET_FLOAT (dbval);
+      return EVAL_BATCH_DOUBLE;
+
+    case DB_TYPE_DOUBLE:
+      *dval = DB_GET_DOUBLE (dbval);
+      return EVAL_BATCH_DOUBLE;
+
+    case DB_TYPE_DATE:
+      *ival = *DB_GET_DATE (dbval);
+      return EVAL_BATCH_DATE;
+
+    case DB_TYPE_DATETIME:
+      datetime = DB_GET_DATETIME (dbval);
+      *ival = ((INT64) datetime->date * EVAL_BATCH_MSECS_PER_DAY
+	       + datetime->time);
+      return EVAL_BATCH_DATETIME;
+
+    default:
+      return EVAL_BATCH_NONE;
+    }
+}
+
+/*
+ * eval_batch_term_select () - apply a comparison to the selected rows
+ *   return: number of rows still selected
+ *   term(in): comparison
+ *   sel(in/out): selection vector, the rows in the batch still selected
+ *   nsel(in): number of rows in sel
+ */
+static int
+eval_batch_term_select (EVAL_BATCH_TERM * term, int *sel, int nsel)
+{
+  int i, n = nsel;
+
+  if (term->kind == EVAL_BATCH_DOUBLE)
+    {
+      switch (term->rel_op)
+	{
+	case R_EQ:
+	  EVAL_BATCH_SELECT (term->dcol, ==, term->dbound);
+	  break;
+	case R_NE:
+	  EVAL_BATCH_SELECT (term->dcol, !=, term->dbound);
+	  break;
+	case R_GT:
+	  EVAL_BATCH_SELECT (term->dcol, >, term->dbound);
+	  break;
+	case R_GE:
+	  EVAL_BATCH_SELECT (term->dcol, >=, term->dbound);
+	  break;
+	case R_LT:
+	  EVAL_BATCH_SELECT (term->dcol, <, term->dbound);
+	  break;
+	case R_LE:
+	  EVAL_BATCH_SELECT (term->dcol, <=, term->dbound);
+	  break;
+	default:
+	  break;
+	}
+    }
+  else
+    {
+      switch (term->rel_op)
+	{
+	case R_EQ:
+	  EVAL_BATCH_SELECT (term->icol, ==, term->ibound);
+	  break;
+	case R_NE:
+	  EVAL_BATCH_SELECT (term->icol, !=, term->ibound);
+	  break;
+	case R_GT:
+	  EVAL_BATCH_SELECT (term->icol, >, term->ibound);
+	  break;
+	case R_GE:
+	  EVAL_BATCH_SELECT (term->icol, >=, term->ibound);
+	  break;
+	case R_LT:
+	  EVAL_BATCH_SELECT (term->icol, <, term->ibound);
+	  break;
+	case R_LE:
+	  EVAL_BATCH_SELECT (term->icol, <=, term->ibound);
+	  break;
+	default:
+	  break;
+	}
+    }
+
+  return n;
+}
+
+/*
+ * eval_batch_pred_create () - make a batch predicate of a scan predicate
+ *   return: batch predicate, or NULL if the predicate cannot be evaluated
+ *           in batch
+ *   pr(in): Predicate Expression Tree
+ */
+EVAL_BATCH_PRED *
+eval_batch_pred_create (THREAD_ENTRY * thread_p, PRED_EXPR * pr)
+{
+  EVAL_BATCH_PRED *batch;
+  int nterms = 0;
+
+  if (pr == NULL || !eval_batch_collect_terms (pr, NULL, &nterms))
+    {
+      return NULL;
+    }
+
+  batch = (EVAL_BATCH_PRED *) db_private_alloc (thread_p,
+						sizeof (EVAL_BATCH_PRED));
+  if (batch == NULL)
+    {
+      return NULL;
+    }
+
+  batch->terms = (EVAL_BATCH_TERM *)
+    db_private_alloc (thread_p, nterms * sizeof (EVAL_BATCH_TERM));
+  if (batch->terms == NULL)
+    {
+      db_private_free_and_init (thread_p, batch);
+      return NULL;
+    }
+
+  batch->nterms = 0;
+  (void) eval_batch_collect_terms (pr, batch->terms, &batch->nterms);
+  batch->nrows = 0;
+  batch->all_false = false;
+
+  return batch;
+}
+
+/*
+ * eval_batch_pred_free () - free a batch predicate
+ *   return: none
+ *   batch(in): batch predicate
+ */
+void
+eval_batch_pred_free (THREAD_ENTRY * thread_p, EVAL_BATCH_PRED * batch)
+{
+  if (batch->terms)
+    {
+      db_private_free_and_init (thread_p, batch->terms);
+    }
+  db_private_free (thread_p, batch);
+}
+
+/*
+ * eval_batch_pred_start () - start a new batch of rows
+ *   return: NO_ERROR, or ER_code
+ *   batch(in/out): batch predicate
+ *   vd(in): Value descriptor for positional values
+ *
+ * Note: The values the attributes are compared with are fetched once for
+ *       the batch.
+ */
+int
+eval_batch_pred_start (THREAD_ENTRY * thread_p, EVAL_BATCH_PRED * batch,
+		       VAL_DESCR * vd)
+{
+  EVAL_BATCH_TERM *term;
+  DB_VALUE *peek_val;
+  int t;
+
+  batch->nrows = 0;
+  batch->all_false = false;
+
+  for (t = 0; t < batch->nterms; t++)
+    {
+      term = &batch->terms[t];
+      if (fetch_peek_dbval (thread_p, term->value, vd, NULL, NULL, NULL,
+			    &peek_val) != NO_ERROR)
+	{
+	  return ER_FAILED;
+	}
+
+      if (db_value_is_null (peek_val))
+	{
+	  /* the comparison is unknown for every row */
+	  batch->all_false = true;
+	  term->kind = EVAL_BATCH_NONE;
+	}
+      else
+	{
+	  term->kind = eval_batch_value (peek_val, &term->ibound,
+					 &term->dbound);
+	}
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * eval_batch_pred_add_row () - add a row to the batch
+ *   return: NO_ERROR, or ER_code
+ *   batch(in/out): batch predicate
+ *   vd(in): Value descriptor for positional values
+ *
+ * Note: The attribute values of the row are read from the attribute cache
+ *       of the scan, where they must have been read already. A row that
+ *       has a NULL attribute does not qualify; a row with a value of
+ *       another kind than the value it is compared with is left to the
+ *       predicate itself.
+ */
+int
+eval_batch_pred_add_row (THREAD_ENTRY * thread_p, EVAL_BATCH_PRED * batch,
+			 VAL_DESCR * vd)
+{
+  EVAL_BATCH_TERM *term;
+  DB_VALUE *peek_val;
+  int row, t;
+
+  row = batch->nrows++;
+  if (batch->all_false)
+    {
+      batch->result[row] = V_FALSE;
+      return NO_ERROR;
+    }
+
+  batch->result[row] = V_TRUE;
+  for (t = 0; t < batch->nterms; t++)
+    {
+      term = &batch->terms[t];
+      if (fetch_peek_dbval (thread_p, term->attr, vd, NULL, NULL, NULL,
+			    &peek_val) != NO_ERROR)
+	{
+	  return ER_FAILED;
+	}
+
+      if (db_value_is_null (peek_val))
+	{
+	  batch->result[row] = V_FALSE;
+	  break;
+	}
+
+      if (term->kind == EVAL_BATCH_NONE
+	  || eval_batch_value (peek_val, &term->icol[row],
+			       &term->dcol[row]) != term->kind)
+	{
+	  batch->result[row] = V_UNKNOWN;
+	}
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * eval_batch_pred_evaluate () - evaluate the predicate over the batch
+ *   return: none
+ *   batch(in/out): batch predicate
+ *
+ * Note: Each comparison is applied to a column of the batch at a time,
+ *       narrowing a selection vector of the rows still qualified. The
+ *       rows left to the predicate itself keep V_UNKNOWN as result.
+ */
+void
+eval_batch_pred_evaluate (EVAL_BATCH_PRED * batch)
+{
+  int sel[EVAL_BATCH_SIZE];
+  int nsel, i, t;
+
+  for (i = 0, nsel = 0; i < batch->nrows; i++)
+    {
+      sel[nsel] = i;
+      if (batch->result[i] == V_TRUE)
+	{
+	  batch->result[i] = V_FALSE;
+	  nsel++;
+	}
+    }
+
+  for (t = 0; t < batch->nterms && nsel > 0; t++)
+    {
+      nsel = eval_batch_term_select (&batch->terms[t], sel, nsel);
+    }
+
+  for (i = 0; i < nsel; i++)
+    {
+      batch->result[sel[i]] = V_TRUE;
+    }
+}
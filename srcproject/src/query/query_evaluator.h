@@ -465,6 +465,47 @@ struct filter_info
   int btree_num_attrs;		/* number of attributes of the index key */
 };
 
+/* number of rows a batch predicate is evaluated over at a time */
+#define EVAL_BATCH_SIZE 128
+
+/* kinds of values compared by a batch predicate */
+typedef enum
+{
+  EVAL_BATCH_NONE = 0,		/* cannot be compared in batch */
+  EVAL_BATCH_INT,		/* SHORT, INTEGER, BIGINT */
+  EVAL_BATCH_DOUBLE,		/* FLOAT, DOUBLE */
+  EVAL_BATCH_DATE,
+  EVAL_BATCH_DATETIME
+} EVAL_BATCH_KIND;
+
+/* comparison of an attribute with a value that is fixed during a batch;
+   the attribute values of the rows are laid out as columns */
+typedef struct eval_batch_term EVAL_BATCH_TERM;
+struct eval_batch_term
+{
+  REGU_VARIABLE *attr;		/* attribute of the scanned class */
+  REGU_VARIABLE *value;		/* constant or host variable */
+  REL_OP rel_op;		/* attr rel_op value */
+  EVAL_BATCH_KIND kind;		/* kind of value in the current batch */
+  INT64 ibound;			/* value, when of an integral kind */
+  double dbound;		/* value, when of EVAL_BATCH_DOUBLE kind */
+  INT64 icol[EVAL_BATCH_SIZE];	/* attribute of the rows, integral kinds */
+  double dcol[EVAL_BATCH_SIZE];	/* attribute of the rows, EVAL_BATCH_DOUBLE */
+};
+
+/* conjunction of comparisons evaluated over a batch of rows at a time */
+typedef struct eval_batch_pred EVAL_BATCH_PRED;
+struct eval_batch_pred
+{
+  EVAL_BATCH_TERM *terms;	/* comparisons of the conjunction */
+  int nterms;
+  int nrows;			/* number of rows in the batch */
+  bool all_false;		/* a value is NULL, so no row qualifies */
+  /* V_TRUE or V_FALSE for the rows decided by the batch, V_UNKNOWN for
+     the rows that must be evaluated by the predicate itself */
+  char result[EVAL_BATCH_SIZE];
+};
+
 /* pseudocolumns offsets in tuple (from end) */
 #define	PCOL_ISCYCLE_TUPLE_OFFSET	1
 #define	PCOL_ISLEAF_TUPLE_OFFSET	2
@@ -495,5 +536,14 @@ extern DB_LOGICAL eval_data_filter (THREAD_ENTRY * thread_p, OID * oid,
 				    RECDES * recdes, FILTER_INFO * filter);
 extern DB_LOGICAL eval_key_filter (THREAD_ENTRY * thread_p, DB_VALUE * value,
 				   FILTER_INFO * filter);
+extern EVAL_BATCH_PRED *eval_batch_pred_create (THREAD_ENTRY * thread_p,
+						PRED_EXPR * pr);
+extern void eval_batch_pred_free (THREAD_ENTRY * thread_p,
+				  EVAL_BATCH_PRED * batch);
+extern int eval_batch_pred_start (THREAD_ENTRY * thread_p,
+				  EVAL_BATCH_PRED * batch, VAL_DESCR * vd);
+extern int eval_batch_pred_add_row (THREAD_ENTRY * thread_p,
+				    EVAL_BATCH_PRED * batch, VAL_DESCR * vd);
+extern void eval_batch_pred_evaluate (EVAL_BATCH_PRED * batch);
 
 #endif /* _QUERY_EVALUATOR_H_ */
@@ -30,6 +30,7 @@
 #include <string.h>
 #include <math.h>
 #include <search.h>
+#include <stdarg.h>
 #include <sys/timeb.h>
 
 #include "porting.h"
@@ -98,6 +99,21 @@
 /* used for tuple string id */
 #define CONNECTBY_TUPLE_INDEX_STRING_MEM  64
 
+/* maximum number of times a hash join partition is split again */
+#define QEXEC_HASH_JOIN_MAX_LEVELS      3
+
+/* hash GROUP BY/DISTINCT table: initial buckets and arena block size */
+#define QEXEC_HASH_AGG_INITIAL_BUCKETS  1024
+#define QEXEC_HASH_AGG_BLOCK_SIZE       (64 * 1024)
+
+/* smallest sort record assumed when bounding the rows of a top-N sort */
+#define QEXEC_TOPN_MIN_ROW_SIZE         64
+
+/* parallel heap scan: min # of heap pages per thread and # of pages the
+   threads take from the heap at a time */
+#define QEXEC_PARALLEL_SCAN_MIN_PAGES   256
+#define QEXEC_PARALLEL_SCAN_RANGE_PAGES 16
+
 
 #define QEXEC_CLEAR_AGG_LIST_VALUE(agg_list) \
   do \
@@ -221,6 +237,100 @@ struct parent_pos_info
   PARENT_POS_INFO *stack;
 };
 
+/* an inner tuple on the build side of a hash join */
+typedef struct hash_join_entry HASH_JOIN_ENTRY;
+struct hash_join_entry
+{
+  HASH_JOIN_ENTRY *next;	/* next entry of the same bucket */
+  unsigned int hash_key;	/* hash key of the join columns */
+  QFILE_TUPLE tpl;		/* copy of the inner tuple */
+};
+
+/* join column information shared by the partitioning, build and probe */
+typedef struct hash_join_info HASH_JOIN_INFO;
+struct hash_join_info
+{
+  QFILE_LIST_MERGE_INFO *merge_infop;
+  int nvals;			/* join columns count */
+  TP_DOMAIN **outer_domp;	/* outer join column domains */
+  TP_DOMAIN **inner_domp;	/* inner join column domains */
+  DB_TYPE *hash_type;		/* how to hash each join column */
+  char **outer_valp;		/* outer join column values */
+  char **inner_valp;		/* inner join column values */
+};
+
+/* accumulator of an aggregate for one group of a hash aggregation */
+typedef struct hash_agg_state HASH_AGG_STATE;
+struct hash_agg_state
+{
+  DB_VALUE value;
+  DB_VALUE value2;
+  int curr_cnt;
+};
+
+/* a group (or a distinct row) of a hash aggregation */
+typedef struct hash_agg_entry HASH_AGG_ENTRY;
+struct hash_agg_entry
+{
+  HASH_AGG_ENTRY *next;		/* next entry of the same bucket */
+  unsigned int hash_key;	/* hash key of the grouping columns */
+  QFILE_TUPLE tpl;		/* first input tuple of the group */
+  HASH_AGG_STATE *states;	/* accumulators of the aggregates */
+};
+
+/* arena block the hash aggregation entries are allocated from */
+typedef struct hash_agg_block HASH_AGG_BLOCK;
+struct hash_agg_block
+{
+  HASH_AGG_BLOCK *next;
+  int size;			/* bytes available after the header */
+  int used;			/* bytes allocated after the header */
+};
+
+typedef struct hash_agg_table HASH_AGG_TABLE;
+struct hash_agg_table
+{
+  SORTKEY_INFO *key_info;	/* grouping columns */
+  DB_TYPE *hash_type;		/* how to hash each grouping column */
+  HASH_AGG_ENTRY **buckets;
+  int nbuckets;
+  int nentries;
+  int nstates;			/* accumulators count of an entry */
+  HASH_AGG_BLOCK *blocks;	/* arena of the entries */
+  size_t mem_size;		/* bytes allocated for the table */
+  size_t max_mem_size;		/* bytes the table is allowed to use */
+};
+
+#if defined (SERVER_MODE)
+typedef struct qexec_parallel_scan_task QEXEC_PARALLEL_SCAN_TASK;
+struct qexec_parallel_scan_task
+{				/* a thread of a parallel heap scan */
+  XASL_NODE *xasl;		/* plan of the requester, NULL for helpers */
+  XASL_STATE *xasl_state;
+  QFILE_TUPLE_RECORD *tplrec;
+  XASL_SCAN_FNC_PTR func_vector;
+
+  /* helpers unpack a private copy of the plan from the XASL stream */
+  char *xasl_stream;
+  int xasl_stream_size;
+
+  HEAP_PAGE_DISPATCHER *dispatcher;
+  char *agg_state;		/* packed partial aggregates of a helper */
+  SCAN_CODE result;
+  int error;
+};
+#endif /* SERVER_MODE */
+
+/* text buffer the profile of a query is formatted into */
+typedef struct qexec_profile_buf QEXEC_PROFILE_BUF;
+struct qexec_profile_buf
+{
+  char *text;			/* NUL terminated text, allocated with malloc */
+  int length;			/* length of the text */
+  int size;			/* allocated size of the text */
+};
+
+
 /* XASL cache related things */
 
 /* counters */
@@ -363,6 +473,20 @@ static XASL_CACHE_CLO_INFO xasl_clo_cache = {
 /* XASL cache entry pool */
 static XASL_CACHE_ENTRY_POOL xasl_cache_entry_pool = { NULL, 0, -1 };
 
+#if defined(SERVER_MODE)
+/*
+ * Lookups run with the XASL cache section held as a reader, so the
+ * transaction index arrays of the entries are protected by a small set of
+ * latches instead. An entry is mapped to a latch by its address; pooled
+ * entries are 4K apart, so the page bits are folded in as well.
+ */
+#define XASL_ENT_LATCH_COUNT 32
+#define XASL_ENT_LATCH(ent) \
+  (xasl_ent_latch[((((size_t) (ent)) >> 4) ^ (((size_t) (ent)) >> 12)) \
+		  % XASL_ENT_LATCH_COUNT])
+static MUTEX_T xasl_ent_latch[XASL_ENT_LATCH_COUNT];
+#endif /* SERVER_MODE */
+
 /*
  *  XASL_CACHE_ENTRY memory structure :=
  *      [|ent structure itself|TRANID array(tran_id_array)
@@ -443,6 +567,8 @@ static DB_LOGICAL qexec_eval_ordbynum_pred (THREAD_ENTRY * thread_p,
 					    ORDBYNUM_INFO * ordby_info);
 static int qexec_ordby_put_next (THREAD_ENTRY * thread_p,
 				 const RECDES * recdes, void *arg);
+static int qexec_get_orderby_limit (THREAD_ENTRY * thread_p,
+				    ORDBYNUM_INFO * ordby_info);
 static int qexec_orderby_distinct (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
 				   QUERY_OPTIONS option,
 				   XASL_STATE * xasl_state);
@@ -497,6 +623,36 @@ static int qexec_gby_put_next (THREAD_ENTRY * thread_p, const RECDES * recdes,
 static int qexec_groupby (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
 			  XASL_STATE * xasl_state,
 			  QFILE_TUPLE_RECORD * tplrec);
+static int qexec_hash_agg_init (THREAD_ENTRY * thread_p,
+				HASH_AGG_TABLE * table,
+				SORTKEY_INFO * key_info, int nstates);
+static void qexec_hash_agg_clear (THREAD_ENTRY * thread_p,
+				  HASH_AGG_TABLE * table);
+static void *qexec_hash_agg_alloc (THREAD_ENTRY * thread_p,
+				   HASH_AGG_TABLE * table, int size);
+static int qexec_hash_agg_key (HASH_AGG_TABLE * table, QFILE_TUPLE tpl,
+			       unsigned int *hash_key);
+static int qexec_hash_agg_compare (SORTKEY_INFO * key_info,
+				   QFILE_TUPLE tpl0, QFILE_TUPLE tpl1);
+static HASH_AGG_ENTRY *qexec_hash_agg_find (HASH_AGG_TABLE * table,
+					    QFILE_TUPLE tpl,
+					    unsigned int hash_key);
+static int qexec_hash_agg_insert (THREAD_ENTRY * thread_p,
+				  HASH_AGG_TABLE * table, QFILE_TUPLE tpl,
+				  unsigned int hash_key,
+				  HASH_AGG_ENTRY ** entry);
+static int qexec_hash_agg_sort (THREAD_ENTRY * thread_p,
+				HASH_AGG_TABLE * table,
+				HASH_AGG_ENTRY *** sorted_entries);
+static bool qexec_hash_gby_is_eligible (GROUPBY_STATE * gbstate);
+static void qexec_hash_gby_save_aggs (GROUPBY_STATE * gbstate,
+				      HASH_AGG_ENTRY * entry);
+static void qexec_hash_gby_restore_aggs (GROUPBY_STATE * gbstate,
+					 HASH_AGG_ENTRY * entry);
+static int qexec_hash_groupby (THREAD_ENTRY * thread_p,
+			       GROUPBY_STATE * gbstate,
+			       QFILE_LIST_ID * list_id, bool * is_done);
+static int qexec_hash_distinct (THREAD_ENTRY * thread_p, XASL_NODE * xasl);
 static int qexec_collection_has_null (DB_VALUE * colval);
 static DB_VALUE_COMPARE_RESULT qexec_cmp_tpl_vals_merge (QFILE_TUPLE *
 							 left_tval,
@@ -534,6 +690,39 @@ static QFILE_LIST_ID *qexec_merge_list_outer (THREAD_ENTRY * thread_p,
 					      other_outer_join_pred,
 					      XASL_STATE * xasl_state,
 					      int ls_flag);
+static DB_TYPE qexec_hash_join_type (TP_DOMAIN * outer_domp,
+				     TP_DOMAIN * inner_domp);
+static unsigned int qexec_hash_join_bytes (unsigned int hash_key,
+					   const char *bytes, int size);
+static int qexec_hash_join_value (char *tval, TP_DOMAIN * domp,
+				  DB_TYPE hash_type, unsigned int *hash_key,
+				  bool * is_null);
+static int qexec_hash_join_key (HASH_JOIN_INFO * info, QFILE_TUPLE tpl,
+				int *columns, TP_DOMAIN ** domp, char **valp,
+				unsigned int *hash_key, bool * is_null);
+static unsigned int qexec_hash_join_seed (unsigned int hash_key, int level);
+static int qexec_hash_join_split (THREAD_ENTRY * thread_p,
+				  HASH_JOIN_INFO * info,
+				  QFILE_LIST_ID * list_idp, bool is_outer,
+				  int level, int nparts,
+				  QFILE_LIST_ID ** part_list_idp);
+static int qexec_hash_join_partition (THREAD_ENTRY * thread_p,
+				      HASH_JOIN_INFO * info,
+				      QFILE_LIST_ID * outer_list_idp,
+				      QFILE_LIST_ID * inner_list_idp,
+				      int level, QFILE_LIST_ID * list_idp,
+				      QFILE_TUPLE_RECORD * tplrec);
+static int qexec_hash_join_lists (THREAD_ENTRY * thread_p,
+				  HASH_JOIN_INFO * info,
+				  QFILE_LIST_ID * outer_list_idp,
+				  QFILE_LIST_ID * inner_list_idp,
+				  int level, QFILE_LIST_ID * list_idp,
+				  QFILE_TUPLE_RECORD * tplrec);
+static QFILE_LIST_ID *qexec_hash_join_list (THREAD_ENTRY * thread_p,
+					    QFILE_LIST_ID * outer_list_idp,
+					    QFILE_LIST_ID * inner_list_idp,
+					    QFILE_LIST_MERGE_INFO *
+					    merge_infop, int ls_flag);
 static int qexec_merge_listfiles (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
 				  XASL_STATE * xasl_state);
 static int qexec_open_scan (THREAD_ENTRY * thread_p,
@@ -559,6 +748,39 @@ static SCAN_CODE qexec_merge_fnc (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
 				  XASL_STATE * xasl_state,
 				  QFILE_TUPLE_RECORD * tplrec,
 				  XASL_SCAN_FNC_PTR ignore);
+#if defined (SERVER_MODE)
+static int qexec_get_parallel_scan_degree (THREAD_ENTRY * thread_p,
+					   XASL_NODE * xasl,
+					   XASL_STATE * xasl_state,
+					   char **xasl_stream,
+					   int *xasl_stream_size);
+static SCAN_CODE qexec_execute_parallel_scan (THREAD_ENTRY * thread_p,
+					      XASL_NODE * xasl,
+					      XASL_STATE * xasl_state,
+					      QFILE_TUPLE_RECORD * tplrec,
+					      XASL_SCAN_FNC_PTR func_vector,
+					      int degree, char *xasl_stream,
+					      int xasl_stream_size);
+static void qexec_parallel_scan_task (THREAD_ENTRY * thread_p, void *arg);
+static int qexec_parallel_scan_helper (THREAD_ENTRY * thread_p,
+				       QEXEC_PARALLEL_SCAN_TASK * task);
+#endif /* SERVER_MODE */
+static int qexec_execute_mainblock_internal (THREAD_ENTRY * thread_p,
+					     XASL_NODE * xasl,
+					     XASL_STATE * xasl_state);
+static int qexec_profile_printf (QEXEC_PROFILE_BUF * buf,
+				 const char *fmt, ...);
+static const char *qexec_profile_xasl_type (XASL_NODE * xasl);
+static int qexec_profile_stats (QEXEC_PROFILE_BUF * buf,
+				const SCAN_STATS * stats);
+static int qexec_profile_spec (THREAD_ENTRY * thread_p,
+			       QEXEC_PROFILE_BUF * buf,
+			       ACCESS_SPEC_TYPE * spec, int depth);
+static int qexec_profile_xasl (THREAD_ENTRY * thread_p,
+			       QEXEC_PROFILE_BUF * buf, XASL_NODE * xasl,
+			       const char *label, int depth);
+static char *qexec_format_profile (THREAD_ENTRY * thread_p,
+				   XASL_NODE * xasl);
 static int qexec_setup_list_id (XASL_NODE * xasl);
 static int qexec_execute_update (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
 				 XASL_STATE * xasl_state);
@@ -2170,6 +2392,64 @@ qexec_ordby_put_next (THREAD_ENTRY * thread_p, const RECDES * recdes,
   return (error == NO_ERROR) ? NO_ERROR : er_errid ();
 }
 
+/*
+ * qexec_get_orderby_limit () - get the number of leading sorted tuples the
+ *				orderby_num() predicate may accept
+ *   return: the number of tuples, or NO_SORT_LIMIT
+ *   ordby_info(in): orderby_num() information
+ *
+ * Note: A predicate without the "continue scan" flag is a conjunction of
+ * comparisons and so accepts a single range of orderby_num() values,
+ * e.g. "orderby_num() between 11 and 20" or the one made for LIMIT. The
+ * predicate is evaluated for 1, 2, ... until it has been true and turns
+ * false; only that many tuples of the sorted order are needed, which lets
+ * the sort keep just those in memory. Give up when the range does not end
+ * before the tuples would stop fitting in the sort buffer.
+ */
+static int
+qexec_get_orderby_limit (THREAD_ENTRY * thread_p, ORDBYNUM_INFO * ordby_info)
+{
+  DB_VALUE saved_val;
+  DB_LOGICAL ev_res;
+  int max_limit, limit, k;
+  bool found = false;
+
+  if (ordby_info->ordbynum_val == NULL || ordby_info->ordbynum_pred == NULL
+      || (ordby_info->ordbynum_flag & XASL_ORDBYNUM_FLAG_SCAN_CONTINUE))
+    {
+      return NO_SORT_LIMIT;
+    }
+
+  max_limit = (PRM_SR_NBUFFERS * IO_PAGESIZE) / QEXEC_TOPN_MIN_ROW_SIZE;
+  limit = NO_SORT_LIMIT;
+
+  saved_val = *ordby_info->ordbynum_val;
+  for (k = 1; k <= max_limit + 1; k++)
+    {
+      DB_MAKE_INT (ordby_info->ordbynum_val, k);
+      ev_res = eval_pred (thread_p, ordby_info->ordbynum_pred,
+			  &ordby_info->xasl_state->vd, NULL);
+      if (ev_res == V_TRUE)
+	{
+	  found = true;
+	}
+      else if (ev_res == V_ERROR)
+	{
+	  /* let the sort report it on the first tuple */
+	  er_clear ();
+	  break;
+	}
+      else if (found)
+	{
+	  limit = k - 1;
+	  break;
+	}
+    }
+  *ordby_info->ordbynum_val = saved_val;
+
+  return limit;
+}
+
 /*
  * qexec_orderby_distinct () -
  *   return: NO_ERROR, or ER_code
@@ -2202,11 +2482,23 @@ qexec_orderby_distinct (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
   ORDBYNUM_INFO ordby_info;
   REGU_VARIABLE_LIST regu_list;
   SORT_PUT_FUNC *put_fn;
+  int limit;
 
   outptr_list = (xasl->type == BUILDLIST_PROC
 		 && xasl->proc.buildlist.groupby_list) ? xasl->proc.buildlist.
     g_outptr_list : xasl->outptr_list;
 
+  if (option == Q_DISTINCT && XASL_IS_FLAGED (xasl, XASL_USE_HASH_AGGREGATE)
+      && xasl->type == BUILDLIST_PROC
+      && xasl->proc.buildlist.groupby_list == NULL)
+    {
+      /* drop the duplicates by hashing before sorting */
+      if (qexec_hash_distinct (thread_p, xasl) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+    }
+
   if (order_list != NULL || option == Q_DISTINCT)
     {
 
@@ -2334,10 +2626,16 @@ qexec_orderby_distinct (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
 	      QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
 	    }
 
+	  limit = NO_SORT_LIMIT;
+	  if (option != Q_DISTINCT)
+	    {
+	      limit = qexec_get_orderby_limit (thread_p, &ordby_info);
+	    }
+
 	  list_id = qfile_sort_list_with_func (thread_p, list_id,
 					       orderby_list, option, ls_flag,
 					       NULL, put_fn, NULL,
-					       &ordby_info);
+					       &ordby_info, limit);
 	  if (list_id == NULL)
 	    {
 	      if (orderby_alloc == true)
@@ -3106,930 +3404,2366 @@ exit_on_error:
 }
 
 /*
- * qexec_groupby () -
+ * qexec_hash_agg_init () - Initialize a hash aggregation table
  *   return: NO_ERROR, or ER_code
- *   xasl(in)   :
- *   xasl_state(in)     : XASL tree state information
- *   tplrec(out) : Tuple record descriptor to store result tuples
+ *   table(in)  : hash aggregation table
+ *   key_info(in)       : grouping columns
+ *   nstates(in)        : accumulators count of an entry
  *
- * Note: Apply the group_by clause to the given list file to group it
- * using the specified group_by parameters.
+ * Note: The table may use as much memory as the sort buffer would.
  */
 static int
-qexec_groupby (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
-	       XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * tplrec)
+qexec_hash_agg_init (THREAD_ENTRY * thread_p, HASH_AGG_TABLE * table,
+		     SORTKEY_INFO * key_info, int nstates)
 {
-  QFILE_LIST_ID *list_id = xasl->list_id;
-  BUILDLIST_PROC_NODE *buildlist = &xasl->proc.buildlist;
-  GROUPBY_STATE gbstate;
-  QFILE_LIST_SCAN_ID input_scan_id;
-  int ls_flag = 0;
-
-  if (buildlist->groupby_list == NULL)
-    {
-      return NO_ERROR;
-    }
+  int i;
 
-  /* initialize groupby_num() value */
-  if (buildlist->g_grbynum_val && DB_IS_NULL (buildlist->g_grbynum_val))
+  table->key_info = key_info;
+  table->hash_type = NULL;
+  table->buckets = NULL;
+  table->nbuckets = QEXEC_HASH_AGG_INITIAL_BUCKETS;
+  table->nentries = 0;
+  table->nstates = nstates;
+  table->blocks = NULL;
+  table->mem_size = 0;
+  table->max_mem_size = (size_t) PRM_SR_NBUFFERS * DB_PAGESIZE;
+
+  table->buckets =
+    (HASH_AGG_ENTRY **) db_private_alloc (thread_p,
+					  table->nbuckets *
+					  sizeof (HASH_AGG_ENTRY *));
+  if (table->buckets == NULL)
     {
-      DB_MAKE_INT (buildlist->g_grbynum_val, 0);
+      return ER_FAILED;
     }
+  memset (table->buckets, 0, table->nbuckets * sizeof (HASH_AGG_ENTRY *));
+  table->mem_size += table->nbuckets * sizeof (HASH_AGG_ENTRY *);
 
-  if (qexec_initialize_groupby_state (&gbstate, buildlist->groupby_list,
-				      buildlist->g_having_pred,
-				      buildlist->g_grbynum_pred,
-				      buildlist->g_grbynum_val,
-				      buildlist->g_grbynum_flag,
-				      buildlist->eptr_list,
-				      buildlist->g_agg_list,
-				      buildlist->g_regu_list,
-				      buildlist->g_val_list,
-				      buildlist->g_outptr_list,
-				      buildlist->g_with_rollup,
-				      xasl_state,
-				      &list_id->type_list, tplrec) == NULL)
+  table->hash_type = (DB_TYPE *) db_private_alloc (thread_p,
+						   key_info->nkeys *
+						   sizeof (DB_TYPE));
+  if (table->hash_type == NULL)
     {
-      GOTO_EXIT_ON_ERROR;
+      return ER_FAILED;
     }
 
-  /*
-   * Create a new listfile to receive the results.
-   */
-  {
-    QFILE_TUPLE_VALUE_TYPE_LIST output_type_list;
-    QFILE_LIST_ID *output_list_id;
-
-    if (qdata_get_valptr_type_list (buildlist->g_outptr_list,
-				    &output_type_list) != NO_ERROR)
-      {
-	GOTO_EXIT_ON_ERROR;
-      }
-    /* If it does not have 'order by'(xasl->orderby_list),
-       then the list file to be open at here will be the last one.
-       Otherwise, the last list file will be open at
-       qexec_orderby_distinct().
-       (Note that only one that can have 'group by' is BUILDLIST_PROC type.)
-       And, the top most XASL is the other condition for the list file
-       to be the last result file. */
-
-    QFILE_SET_FLAG (ls_flag, QFILE_FLAG_ALL);
-    if (XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL)
-	&& XASL_IS_FLAGED (xasl, XASL_TO_BE_CACHED)
-	&& (xasl->orderby_list == NULL
-	    || XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST))
-	&& xasl->option != Q_DISTINCT)
-      {
-	QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
-      }
-
-    output_list_id = qfile_open_list (thread_p, &output_type_list,
-				      buildlist->after_groupby_list,
-				      xasl_state->query_id, ls_flag);
-    if (output_list_id == NULL)
-      {
-	if (output_type_list.domp)
-	  {
-	    db_private_free_and_init (thread_p, output_type_list.domp);
-	  }
-
-	GOTO_EXIT_ON_ERROR;
-      }
-
-    if (output_type_list.domp)
-      {
-	db_private_free_and_init (thread_p, output_type_list.domp);
-      }
-
-    gbstate.output_file = output_list_id;
-  }
-
-  if (list_id->tuple_cnt == 0)
+  for (i = 0; i < key_info->nkeys; i++)
     {
-      /* empty unsorted list file, no need to proceed */
-      qfile_destroy_list (thread_p, list_id);
-      qfile_close_list (thread_p, gbstate.output_file);
-      qfile_copy_list_id (list_id, gbstate.output_file, true);
-      qexec_clear_groupby_state (thread_p, &gbstate);	/* will free gbstate.output_file */
-
-      return NO_ERROR;
+      table->hash_type[i] = qexec_hash_join_type (key_info->key[i].col_dom,
+						  key_info->key[i].col_dom);
     }
 
-  /*
-   * Open a scan on the unsorted input file
-   */
-  if (qfile_open_list_scan (list_id, &input_scan_id) != NO_ERROR)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
-  gbstate.input_scan = &input_scan_id;
+  return NO_ERROR;
+}
 
-  /*
-   * Now load up the sort module and set it off...
-   */
-  gbstate.key_info.use_original =
-    (gbstate.key_info.nkeys != list_id->type_list.type_cnt);
-  gbstate.cmp_fn = (gbstate.key_info.use_original == 1
-		    ? &qfile_compare_partial_sort_record
-		    : &qfile_compare_all_sort_record);
-
-  if (sort_listfile (thread_p, NULL_VOLID,
-		     qfile_get_estimated_pages_for_sorting (list_id,
-							    &gbstate.
-							    key_info),
-		     &qexec_gby_get_next, &gbstate, &qexec_gby_put_next,
-		     &gbstate, gbstate.cmp_fn, &gbstate.key_info,
-		     SORT_DUP) != NO_ERROR)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
+/*
+ * qexec_hash_agg_clear () - Free a hash aggregation table
+ *   return:
+ *   table(in)  : hash aggregation table
+ */
+static void
+qexec_hash_agg_clear (THREAD_ENTRY * thread_p, HASH_AGG_TABLE * table)
+{
+  HASH_AGG_BLOCK *block;
+  HASH_AGG_ENTRY *entry;
+  int i, k;
 
-  /*
-   * There may be one unfinished group in the output, since the sort_listfile
-   * interface doesn't include a finalization function.  If so, finish
-   * off that group.
-   */
-  if (gbstate.input_recs != 0)
+  if (table->buckets)
     {
-      qexec_gby_finalize_group (thread_p, &gbstate);
-      if (gbstate.g_rollup_agg_list)
+      /* free the accumulators not handed over to the aggregates */
+      for (k = 0; k < table->nbuckets; k++)
 	{
-	  int i;
-	  for (i = gbstate.rollup_levels - 1; i >= 0; i--)
+	  for (entry = table->buckets[k]; entry; entry = entry->next)
 	    {
-	      qexec_gby_finalize_rollup_group (thread_p, &gbstate, i);
+	      if (entry->states == NULL)
+		{
+		  continue;
+		}
+	      for (i = 0; i < table->nstates; i++)
+		{
+		  pr_clear_value (&entry->states[i].value);
+		  pr_clear_value (&entry->states[i].value2);
+		}
 	    }
 	}
+      db_private_free_and_init (thread_p, table->buckets);
     }
 
-  qfile_close_list (thread_p, gbstate.output_file);
-#if 0				/* SortCache */
-  /* free currently fixed page */
-  if (gbstate.fixed_page != NULL)
+  if (table->hash_type)
     {
-      QFILE_LIST_ID *list_idp;
+      db_private_free_and_init (thread_p, table->hash_type);
+    }
 
-      list_idp = &(gbstate.input_scan->list_id);
-      qmgr_free_old_page (gbstate.fixed_page, list_idp->tfile_vfid);
-      gbstate.fixed_page = NULL;
+  while ((block = table->blocks) != NULL)
+    {
+      table->blocks = block->next;
+      db_private_free_and_init (thread_p, block);
     }
-#endif
-  qfile_destroy_list (thread_p, list_id);
-  qfile_copy_list_id (list_id, gbstate.output_file, true);
-  /* qexec_clear_groupby_state() will free gbstate.output_file */
 
-wrapup:
-  {
-    int result;
-    /* SORT_PUT_STOP set by 'qexec_gby_finalize_group()' isn't error */
-    result = (gbstate.state == NO_ERROR || gbstate.state == SORT_PUT_STOP)
-      ? NO_ERROR : ER_FAILED;
-    qexec_clear_groupby_state (thread_p, &gbstate);
-    return result;
-  }
+  table->nentries = 0;
+  table->mem_size = 0;
+}
 
-exit_on_error:
+/*
+ * qexec_hash_agg_alloc () - Allocate memory from the arena of a hash
+ *			     aggregation table
+ *   return: allocated memory, or NULL
+ *   table(in)  : hash aggregation table
+ *   size(in)   : bytes to allocate
+ *
+ * Note: The memory is freed all at once by qexec_hash_agg_clear().
+ */
+static void *
+qexec_hash_agg_alloc (THREAD_ENTRY * thread_p, HASH_AGG_TABLE * table,
+		      int size)
+{
+  HASH_AGG_BLOCK *block;
+  int header_size, block_size;
+  char *ptr;
 
-  gbstate.state = er_errid ();
-  if (gbstate.state == NO_ERROR || gbstate.state == SORT_PUT_STOP)
+  header_size = DB_ALIGN (sizeof (HASH_AGG_BLOCK), MAX_ALIGNMENT);
+  size = DB_ALIGN (size, MAX_ALIGNMENT);
+
+  block = table->blocks;
+  if (block == NULL || block->used + size > block->size)
     {
-      gbstate.state = ER_FAILED;
+      block_size = MAX (QEXEC_HASH_AGG_BLOCK_SIZE, size);
+      block = (HASH_AGG_BLOCK *) db_private_alloc (thread_p,
+						   header_size + block_size);
+      if (block == NULL)
+	{
+	  return NULL;
+	}
+      block->size = block_size;
+      block->used = 0;
+      block->next = table->blocks;
+      table->blocks = block;
+      table->mem_size += header_size + block_size;
     }
 
-  goto wrapup;
+  ptr = (char *) block + header_size + block->used;
+  block->used += size;
+
+  return ptr;
 }
 
 /*
- * qexec_collection_has_null () -
- *   return: 1 iff collection has an element with a NULL in it
- *   colval(in) : DB_VALUE of a collection
+ * qexec_hash_agg_key () - Hash the grouping columns of a tuple
+ *   return: NO_ERROR, or ER_code
+ *   table(in)  : hash aggregation table
+ *   tpl(in)    : tuple
+ *   hash_key(out)      : hash key of the tuple
  */
 static int
-qexec_collection_has_null (DB_VALUE * colval)
+qexec_hash_agg_key (HASH_AGG_TABLE * table, QFILE_TUPLE tpl,
+		    unsigned int *hash_key)
 {
-  DB_VALUE elem;
-  DB_COLLECTION *col;
-  long i;
-  int result = 0;
+  SORTKEY_INFO *key_info = table->key_info;
+  char *tval;
+  unsigned int col_hash_key;
+  bool is_null;
+  int i;
 
-  col = db_get_set (colval);
-  for (i = 0; i < db_set_size (col) && !result; i++)
-    {
-      if (db_set_get (col, i, &elem) < NO_ERROR)
-	{
-	  return 1;
-	  /* flag an error as a NULL, DON'T clear elem with unknown state */
-	}
-      if (PRIM_IS_NULL (&elem))
-	{
-	  return 1;		/* found a NULL, can stop looking, clear unecessary */
-	}
+  *hash_key = 0;
 
-      if (pr_is_set_type (PRIM_TYPE (&elem))
-	  && qexec_collection_has_null (&elem))
+  for (i = 0; i < key_info->nkeys; i++)
+    {
+      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tpl, key_info->key[i].col,
+					     tval);
+      if (qexec_hash_join_value (tval, key_info->key[i].col_dom,
+				 table->hash_type[i], &col_hash_key,
+				 &is_null) != NO_ERROR)
 	{
-	  /* this is for nested set types, need to fall thru to clear */
-	  result = 1;
+	  return ER_FAILED;
 	}
 
-      pr_clear_value (&elem);
+      /* NULLs are grouped together */
+      *hash_key = *hash_key * 31 + (is_null ? 0 : col_hash_key);
     }
 
-  return 0;
+  return NO_ERROR;
 }
 
 /*
- * qexec_cmp_tpl_vals_merge () -
- *   return:
- *        DB_UNK: return error
- *   left_tval(in)      : left tuple values
- *   left_dom(in)       : Domains of left_tval
- *   rght_tval(in)      : right tuple values
- *   rght_dom(in)       : Domains of rght_tval
- *   tval_cnt(in)       : tuple values count
+ * qexec_hash_agg_compare () - Compare the grouping columns of two tuples
+ *   return: negative, zero or positive as for the sort
+ *   key_info(in)       : grouping columns
+ *   tpl0(in)   :
+ *   tpl1(in)   :
  *
- * Note: This routine checks if two tuple values are equal. Coercion
- * is done if necessary. This must give a totally
- * ordered result, but never return equal for
- * a NULL comparison. The result of this comparison
- * will tell the merge routine whether to advance the
- * left or right file to the next tuple. DB_UNK
- * cannot be returned because it is ambiguous as
- * to which side is collated later. If two
- * NULL's or two collections both containing NULL
- * are encountered, then it may pick either side
- * as the lessor side, that tuple will be discarded,
- * then the next comparison will discard the other side.
+ * Note: The columns are compared as qfile_compare_partial_sort_record()
+ * does, so that the groups are told apart and ordered as the sort would.
  */
-static DB_VALUE_COMPARE_RESULT
-qexec_cmp_tpl_vals_merge (QFILE_TUPLE * left_tval, TP_DOMAIN ** left_dom,
-			  QFILE_TUPLE * rght_tval, TP_DOMAIN ** rght_dom,
-			  int tval_cnt)
+static int
+qexec_hash_agg_compare (SORTKEY_INFO * key_info, QFILE_TUPLE tpl0,
+			QFILE_TUPLE tpl1)
 {
-  OR_BUF buf;
-  DB_VALUE left_dbval, rght_dbval;
-  int i, cmp, left_len, rght_len;
-  bool left_is_set, rght_is_set;
-
-  cmp = DB_UNK;			/* init */
+  char *fp0, *fp1;
+  int i, o0, o1;
+  int order = 0;
 
-  for (i = 0; i < tval_cnt; i++)
+  for (i = 0; i < key_info->nkeys; i++)
     {
-      /* get tpl values into db_values for the comparison
-       */
+      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tpl0, key_info->key[i].col,
+					     fp0);
+      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tpl1, key_info->key[i].col,
+					     fp1);
 
-      /* zero length means NULL */
-      if ((left_len = QFILE_GET_TUPLE_VALUE_LENGTH (left_tval[i])) == 0)
-	{
-	  cmp = DB_LT;
-	  break;
-	}
-      rght_len = QFILE_GET_TUPLE_VALUE_LENGTH (rght_tval[i]);
-      if (rght_len == 0)
-	{
-	  cmp = DB_GT;
-	  break;
-	}
+      o0 = (QFILE_GET_TUPLE_VALUE_FLAG (fp0) == V_BOUND) ? 1 : 0;
+      o1 = (QFILE_GET_TUPLE_VALUE_FLAG (fp1) == V_BOUND) ? 1 : 0;
 
-      or_init (&buf, (char *) (left_tval[i] + QFILE_TUPLE_VALUE_HEADER_SIZE),
-	       left_len);
-      /* Do not copy the string--just use the pointer.  The pr_ routines
-       * for strings and sets have different semantics for length.
-       */
-      left_is_set = pr_is_set_type (left_dom[i]->type->id) ? true : false;
-      if ((*(left_dom[i]->type->readval)) (&buf, &left_dbval, left_dom[i], -1,
-					   left_is_set, NULL, 0) != NO_ERROR)
+      if (o0 && o1)
 	{
-	  cmp = DB_UNK;		/* is error */
-	  break;
+	  order = (*key_info->key[i].sort_f) (fp0 +
+					      QFILE_TUPLE_VALUE_HEADER_LENGTH,
+					      fp1 +
+					      QFILE_TUPLE_VALUE_HEADER_LENGTH,
+					      key_info->key[i].col_dom, 0, 0,
+					      1, NULL);
 	}
-      if (DB_IS_NULL (&left_dbval))
+      else
 	{
-	  cmp = DB_LT;
-	  break;
+	  order = o0 ? 1 : o1 ? -1 : 0;
 	}
 
-      or_init (&buf, (char *) (rght_tval[i] + QFILE_TUPLE_VALUE_HEADER_SIZE),
-	       rght_len);
-      /* Do not copy the string--just use the pointer.  The pr_ routines
-       * for strings and sets have different semantics for length.
-       */
-      rght_is_set = pr_is_set_type (rght_dom[i]->type->id) ? true : false;
-      if ((*(rght_dom[i]->type->readval)) (&buf, &rght_dbval, rght_dom[i], -1,
-					   rght_is_set, NULL, 0) != NO_ERROR)
+      order = key_info->key[i].is_desc ? (0 - order) : order;
+
+      if (order != 0)
 	{
-	  cmp = DB_UNK;		/* is error */
 	  break;
 	}
-      if (DB_IS_NULL (&rght_dbval))
+    }
+
+  return order;
+}
+
+/*
+ * qexec_hash_agg_find () - Find the entry of the group of a tuple
+ *   return: entry, or NULL
+ *   table(in)  : hash aggregation table
+ *   tpl(in)    : tuple
+ *   hash_key(in)       : hash key of the tuple
+ */
+static HASH_AGG_ENTRY *
+qexec_hash_agg_find (HASH_AGG_TABLE * table, QFILE_TUPLE tpl,
+		     unsigned int hash_key)
+{
+  HASH_AGG_ENTRY *entry;
+
+  for (entry = table->buckets[hash_key % table->nbuckets]; entry;
+       entry = entry->next)
+    {
+      if (entry->hash_key == hash_key
+	  && qexec_hash_agg_compare (table->key_info, entry->tpl, tpl) == 0)
 	{
-	  cmp = DB_GT;
-	  break;
+	  return entry;
 	}
+    }
 
-      /* both left_dbval, rght_dbval is non-null */
-      cmp = tp_value_compare (&left_dbval, &rght_dbval, 1, 0);
+  return NULL;
+}
 
-      if (left_is_set)
+/*
+ * qexec_hash_agg_insert () - Add an entry for the group of a tuple
+ *   return: NO_ERROR, or ER_code
+ *   table(in)  : hash aggregation table
+ *   tpl(in)    : tuple; copied into the entry
+ *   hash_key(in)       : hash key of the tuple
+ *   new_entry(out)     : new entry, or NULL if the memory budget of the
+ *			  table is exhausted
+ */
+static int
+qexec_hash_agg_insert (THREAD_ENTRY * thread_p, HASH_AGG_TABLE * table,
+		       QFILE_TUPLE tpl, unsigned int hash_key,
+		       HASH_AGG_ENTRY ** new_entry)
+{
+  HASH_AGG_ENTRY **buckets, *entry;
+  int tpl_len, nbuckets, i, k;
+
+  *new_entry = NULL;
+
+  if (table->mem_size > table->max_mem_size)
+    {
+      return NO_ERROR;
+    }
+
+  /* keep the bucket chains short */
+  if (table->nentries >= table->nbuckets * 2)
+    {
+      nbuckets = table->nbuckets * 2;
+      buckets = (HASH_AGG_ENTRY **) db_private_alloc (thread_p,
+						      nbuckets *
+						      sizeof (HASH_AGG_ENTRY
+							      *));
+      if (buckets == NULL)
 	{
-	  if (cmp == DB_UNK && qexec_collection_has_null (&left_dbval))
-	    {
-	      cmp = DB_LT;
-	    }
-	  pr_clear_value (&left_dbval);
+	  return ER_FAILED;
 	}
-      if (rght_is_set)
+      memset (buckets, 0, nbuckets * sizeof (HASH_AGG_ENTRY *));
+
+      for (k = 0; k < table->nbuckets; k++)
 	{
-	  if (cmp == DB_UNK && qexec_collection_has_null (&rght_dbval))
+	  while ((entry = table->buckets[k]) != NULL)
 	    {
-	      cmp = DB_GT;
+	      table->buckets[k] = entry->next;
+	      entry->next = buckets[entry->hash_key % nbuckets];
+	      buckets[entry->hash_key % nbuckets] = entry;
 	    }
-	  pr_clear_value (&rght_dbval);
 	}
 
-      if (cmp == DB_EQ)
-	{
-	  continue;		/* step into the next tval */
-	}
+      db_private_free_and_init (thread_p, table->buckets);
+      table->mem_size += (nbuckets - table->nbuckets)
+	* sizeof (HASH_AGG_ENTRY *);
+      table->buckets = buckets;
+      table->nbuckets = nbuckets;
+    }
 
-      if (cmp == DB_LT || cmp == DB_GT)
+  entry = (HASH_AGG_ENTRY *) qexec_hash_agg_alloc (thread_p, table,
+						   sizeof (HASH_AGG_ENTRY));
+  if (entry == NULL)
+    {
+      return ER_FAILED;
+    }
+
+  tpl_len = QFILE_GET_TUPLE_LENGTH (tpl);
+  entry->tpl = (QFILE_TUPLE) qexec_hash_agg_alloc (thread_p, table, tpl_len);
+  if (entry->tpl == NULL)
+    {
+      return ER_FAILED;
+    }
+  memcpy (entry->tpl, tpl, tpl_len);
+
+  entry->states = NULL;
+  if (table->nstates > 0)
+    {
+      entry->states =
+	(HASH_AGG_STATE *) qexec_hash_agg_alloc (thread_p, table,
+						 table->nstates *
+						 sizeof (HASH_AGG_STATE));
+      if (entry->states == NULL)
 	{
-	  ;			/* OK */
+	  return ER_FAILED;
 	}
-      else
-	{			/* is error */
-	  cmp = DB_UNK;
+      for (i = 0; i < table->nstates; i++)
+	{
+	  DB_MAKE_NULL (&entry->states[i].value);
+	  DB_MAKE_NULL (&entry->states[i].value2);
+	  entry->states[i].curr_cnt = 0;
 	}
-
-      /* at here, immediately return */
-      break;
     }
 
-  return (DB_VALUE_COMPARE_RESULT) cmp;
+  entry->hash_key = hash_key;
+  entry->next = table->buckets[hash_key % table->nbuckets];
+  table->buckets[hash_key % table->nbuckets] = entry;
+  table->nentries++;
+
+  *new_entry = entry;
+
+  return NO_ERROR;
 }
 
 /*
- * qexec_size_remaining () -
- *   return: int
- *   tplrec1(in)        : First tuple descriptor
- *   tplrec2(in)        : Second tuple descriptor
- *   merge_info(in)     : Tuple merge information
- *   k(in)      : column to start at
- *
- * Note: This routine calculates the size needed to store the
- *  remaining tuple to copy.
- * If either tuple is a NULL pointer, assume that the space
- * for an UNBOUND (header) will be needed.
+ * qexec_hash_agg_sort () - Sort the entries of a hash aggregation table
+ *   return: NO_ERROR, or ER_code
+ *   table(in)  : hash aggregation table
+ *   sorted_entries(out)        : entries in the order of the grouping
+ *				  columns; to be freed by the caller
  */
-static long
-qexec_size_remaining (QFILE_TUPLE_RECORD * tplrec1,
-		      QFILE_TUPLE_RECORD * tplrec2,
-		      QFILE_LIST_MERGE_INFO * merge_info, int k)
+static int
+qexec_hash_agg_sort (THREAD_ENTRY * thread_p, HASH_AGG_TABLE * table,
+		     HASH_AGG_ENTRY *** sorted_entries)
 {
-  int i, tpl_size;
-  char *t_valhp;
+  HASH_AGG_ENTRY **base, **entries, **tmp, **swap, *entry;
+  int n, width, lo, mid, hi, i, j, k;
 
-  tpl_size = 0;
-  for (i = k; i < merge_info->ls_pos_cnt; i++)
+  *sorted_entries = NULL;
+  n = table->nentries;
+
+  base = (HASH_AGG_ENTRY **) db_private_alloc (thread_p,
+					       2 * MAX (n, 1) *
+					       sizeof (HASH_AGG_ENTRY *));
+  if (base == NULL)
     {
-      tpl_size += QFILE_TUPLE_VALUE_HEADER_SIZE;
-      if (merge_info->ls_outer_inner_list[i] == QFILE_OUTER_LIST)
+      return ER_FAILED;
+    }
+  entries = base;
+  tmp = base + MAX (n, 1);
+
+  for (k = 0, i = 0; k < table->nbuckets; k++)
+    {
+      for (entry = table->buckets[k]; entry; entry = entry->next)
 	{
-	  if (tplrec1)
-	    {
-	      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tplrec1->tpl,
-						     merge_info->
-						     ls_pos_list[i], t_valhp);
-	      tpl_size += QFILE_GET_TUPLE_VALUE_LENGTH (t_valhp);
-	    }
+	  entries[i++] = entry;
 	}
-      else
+    }
+
+  /* bottom-up merge sort; the groups are few, so this stays in memory */
+  for (width = 1; width < n; width *= 2)
+    {
+      for (lo = 0; lo < n; lo += 2 * width)
 	{
-	  if (tplrec2)
+	  mid = MIN (lo + width, n);
+	  hi = MIN (lo + 2 * width, n);
+	  for (i = lo, j = mid, k = lo; k < hi; k++)
 	    {
-	      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tplrec2->tpl,
-						     merge_info->
-						     ls_pos_list[i], t_valhp);
-	      tpl_size += QFILE_GET_TUPLE_VALUE_LENGTH (t_valhp);
+	      if (i < mid
+		  && (j >= hi
+		      || qexec_hash_agg_compare (table->key_info,
+						 entries[i]->tpl,
+						 entries[j]->tpl) <= 0))
+		{
+		  tmp[k] = entries[i++];
+		}
+	      else
+		{
+		  tmp[k] = entries[j++];
+		}
 	    }
 	}
+      swap = entries;
+      entries = tmp;
+      tmp = swap;
     }
 
-  return tpl_size;
+  if (entries != base)
+    {
+      memcpy (base, entries, n * sizeof (HASH_AGG_ENTRY *));
+    }
+
+  *sorted_entries = base;
+
+  return NO_ERROR;
 }
 
 /*
- * qexec_merge_tuple () -
- *   return: NO_ERROR, or ER_code
- *   tplrec1(in)        : First tuple descriptor
- *   tplrec2(in)        : Second tuple descriptor
- *   merge_info(in)     : Tuple merge information
- *   tplrec(in) : Result tuple descriptor
+ * qexec_hash_gby_is_eligible () - Check if a GROUP BY may be done by hashing
+ *   return: true/false
+ *   gbstate(in)        :
  *
- * Note: This routine merges the given two list files tuples using
- * the given list merge information and stores the result into
- * result tuple descriptor.
+ * Note: Only the aggregates whose whole state is their value and count are
+ * kept per group; DISTINCT aggregates and WITH ROLLUP use the sort.
  */
-static int
-qexec_merge_tuple (QFILE_TUPLE_RECORD * tplrec1, QFILE_TUPLE_RECORD * tplrec2,
-		   QFILE_LIST_MERGE_INFO * merge_info,
-		   QFILE_TUPLE_RECORD * tplrec)
+static bool
+qexec_hash_gby_is_eligible (GROUPBY_STATE * gbstate)
 {
-  QFILE_TUPLE tplp;
-  char *t_valhp;
-  int t_val_size;
-  int tpl_size, offset;
-  int k;
-  INT32 ls_unbound[2] = { 0, 0 };
-
-  /* merge two tuples, and form a new tuple */
-  tplp = tplrec->tpl;
-  offset = 0;
-  QFILE_PUT_TUPLE_LENGTH (tplp, QFILE_TUPLE_LENGTH_SIZE);	/* set tuple length */
-  tplp += QFILE_TUPLE_LENGTH_SIZE;
-  offset += QFILE_TUPLE_LENGTH_SIZE;
-
-  QFILE_PUT_TUPLE_VALUE_FLAG ((char *) ls_unbound, V_UNBOUND);
-  QFILE_PUT_TUPLE_VALUE_LENGTH ((char *) ls_unbound, 0);
+  AGGREGATE_TYPE *agg_p;
+  int i;
 
-  /* copy tuple values from the first and second list file tuples */
-  for (k = 0; k < merge_info->ls_pos_cnt; k++)
+  if (gbstate->g_rollup_agg_list != NULL)
     {
+      return false;
+    }
 
-      if (merge_info->ls_outer_inner_list[k] == QFILE_OUTER_LIST)
+  for (agg_p = gbstate->g_agg_list; agg_p; agg_p = agg_p->next)
+    {
+      switch (agg_p->function)
 	{
-	  if (tplrec1)
-	    {
-	      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tplrec1->tpl,
-						     merge_info->
-						     ls_pos_list[k], t_valhp);
-	    }
-	  else
-	    {
-	      t_valhp = (char *) ls_unbound;
-	    }
+	case PT_COUNT_STAR:
+	case PT_COUNT:
+	case PT_SUM:
+	case PT_AVG:
+	case PT_MIN:
+	case PT_MAX:
+	case PT_GROUPBY_NUM:
+	  break;
+	default:
+	  return false;
 	}
-      else
-	{			/* copy from the second tuple */
-	  if (tplrec2)
-	    {
-	      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tplrec2->tpl,
-						     merge_info->
-						     ls_pos_list[k], t_valhp);
-	    }
-	  else
-	    {
-	      t_valhp = (char *) ls_unbound;
-	    }
+
+      if (agg_p->option == Q_DISTINCT)
+	{
+	  return false;
 	}
+    }
 
-      t_val_size =
-	QFILE_TUPLE_VALUE_HEADER_SIZE +
-	QFILE_GET_TUPLE_VALUE_LENGTH (t_valhp);
-      if ((tplrec->size - offset) < t_val_size)
-	{			/* no space left */
-	  tpl_size = offset +
-	    qexec_size_remaining (tplrec1, tplrec2, merge_info, k);
-	  if (qfile_reallocate_tuple (tplrec, tpl_size) != NO_ERROR)
-	    {
-	      return ER_FAILED;
-	    }
-	  tplp = (QFILE_TUPLE) tplrec->tpl + offset;
+  for (i = 0; i < gbstate->key_info.nkeys; i++)
+    {
+      if (pr_is_set_type (gbstate->key_info.key[i].col_dom->type->id))
+	{
+	  return false;
 	}
+    }
 
-      memcpy (tplp, t_valhp, t_val_size);
-      tplp += t_val_size;
-      offset += t_val_size;
-    }				/* for */
+  return true;
+}
 
-  /* set tuple length */
-  QFILE_PUT_TUPLE_LENGTH (tplrec->tpl, offset);
+/*
+ * qexec_hash_gby_save_aggs () - Move the aggregate values into a group
+ *   return:
+ *   gbstate(in)        :
+ *   entry(in)  : group entry
+ *
+ * Note: The aggregates are left with NULLs of the same types, so that
+ * qdata_initialize_aggregate_list() can start the next group.
+ */
+static void
+qexec_hash_gby_save_aggs (GROUPBY_STATE * gbstate, HASH_AGG_ENTRY * entry)
+{
+  AGGREGATE_TYPE *agg_p;
+  HASH_AGG_STATE *state;
 
-  return NO_ERROR;
+  for (agg_p = gbstate->g_agg_list, state = entry->states; agg_p;
+       agg_p = agg_p->next, state++)
+    {
+      /* groupby_num() is not accumulated per group */
+      if (agg_p->function == PT_GROUPBY_NUM)
+	{
+	  continue;
+	}
+
+      state->value = *agg_p->value;
+      (void) db_value_domain_init (agg_p->value,
+				   DB_VALUE_DOMAIN_TYPE (&state->value),
+				   DB_DEFAULT_PRECISION, DB_DEFAULT_SCALE);
+      if (agg_p->value2)
+	{
+	  state->value2 = *agg_p->value2;
+	  (void) db_value_domain_init (agg_p->value2,
+				       DB_VALUE_DOMAIN_TYPE (&state->value2),
+				       DB_DEFAULT_PRECISION,
+				       DB_DEFAULT_SCALE);
+	}
+      state->curr_cnt = agg_p->curr_cnt;
+    }
 }
 
 /*
- * qexec_merge_tuple_add_list () - Merge a tuple, and add it to the list file
+ * qexec_hash_gby_restore_aggs () - Move the values of a group back into
+ *				    the aggregates
+ *   return:
+ *   gbstate(in)        :
+ *   entry(in)  : group entry
+ */
+static void
+qexec_hash_gby_restore_aggs (GROUPBY_STATE * gbstate, HASH_AGG_ENTRY * entry)
+{
+  AGGREGATE_TYPE *agg_p;
+  HASH_AGG_STATE *state;
+
+  for (agg_p = gbstate->g_agg_list, state = entry->states; agg_p;
+       agg_p = agg_p->next, state++)
+    {
+      if (agg_p->function == PT_GROUPBY_NUM)
+	{
+	  continue;
+	}
+
+      *agg_p->value = state->value;
+      if (agg_p->value2)
+	{
+	  *agg_p->value2 = state->value2;
+	}
+      agg_p->curr_cnt = state->curr_cnt;
+    }
+}
+
+/*
+ * qexec_hash_groupby () - Group a list file by hashing
  *   return: NO_ERROR, or ER_code
- *   list_id(in)        : List file to insert into
- *   tplrec1(in)        : First tuple descriptor
- *   tplrec2(in)        : Second tuple descriptor
- *   merge_info(in)     : Tuple merge information
- *   tplrec(in) : Result tuple descriptor
+ *   gbstate(in)        :
+ *   list_id(in)        : unsorted input list file
+ *   is_done(out)       : false if the groups did not fit in memory
+ *
+ * Note: The accumulators of each group are kept in a hash table while the
+ * input is scanned once. The groups are then sorted and finalized in the
+ * order the sort-based grouping would produce. If the groups outgrow the
+ * memory budget, nothing is output and the caller falls back to the sort,
+ * which spills to temporary files.
  */
 static int
-qexec_merge_tuple_add_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id,
-			    QFILE_TUPLE_RECORD * tplrec1,
-			    QFILE_TUPLE_RECORD * tplrec2,
-			    QFILE_LIST_MERGE_INFO * merge_info,
-			    QFILE_TUPLE_RECORD * tplrec)
+qexec_hash_groupby (THREAD_ENTRY * thread_p, GROUPBY_STATE * gbstate,
+		    QFILE_LIST_ID * list_id, bool * is_done)
 {
-  int ret;
-  QFILE_TUPLE_DESCRIPTOR *tdp;
-  int tplrec1_max_size;
-  int tplrec2_max_size;
+  HASH_AGG_TABLE table;
+  HASH_AGG_ENTRY *entry, **entries = NULL;
+  AGGREGATE_TYPE *agg_p;
+  QFILE_LIST_SCAN_ID scan_id;
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  SCAN_CODE scan;
+  unsigned int hash_key;
+  int nstates, i;
+  int error = NO_ERROR;
 
-  /* get tuple descriptor */
-  tdp = &(list_id->tpl_descr);
+  *is_done = false;
+  scan_id.status = S_CLOSED;
 
-  if (tplrec1)
+  for (nstates = 0, agg_p = gbstate->g_agg_list; agg_p; agg_p = agg_p->next)
     {
-      tplrec1_max_size = QFILE_GET_TUPLE_LENGTH (tplrec1->tpl);
+      nstates++;
     }
-  else
+
+  if (qexec_hash_agg_init (thread_p, &table, &gbstate->key_info,
+			   nstates) != NO_ERROR)
     {
-      tplrec1_max_size =
-	QFILE_TUPLE_VALUE_HEADER_SIZE * (merge_info->ls_pos_cnt);
+      goto exit_on_error;
     }
 
-  if (tplrec2)
+  if (qfile_open_list_scan (list_id, &scan_id) != NO_ERROR)
     {
-      tplrec2_max_size = QFILE_GET_TUPLE_LENGTH (tplrec2->tpl);
+      goto exit_on_error;
     }
-  else
+
+  while ((scan = qfile_scan_list_next (thread_p, &scan_id, &tplrec, PEEK))
+	 == S_SUCCESS)
     {
-      tplrec2_max_size =
-	QFILE_TUPLE_VALUE_HEADER_SIZE * (merge_info->ls_pos_cnt);
-    }
+      if (qexec_hash_agg_key (&table, tplrec.tpl, &hash_key) != NO_ERROR)
+	{
+	  goto exit_on_error;
+	}
 
-  tdp->tpl_size =
-    DB_ALIGN (tplrec1_max_size + tplrec2_max_size, MAX_ALIGNMENT);
+      entry = qexec_hash_agg_find (&table, tplrec.tpl, hash_key);
+      if (entry == NULL)
+	{
+	  if (qexec_hash_agg_insert (thread_p, &table, tplrec.tpl, hash_key,
+				     &entry) != NO_ERROR)
+	    {
+	      goto exit_on_error;
+	    }
+	  if (entry == NULL)
+	    {
+	      /* out of the memory budget; leave it to the sort */
+	      goto exit_on_end;
+	    }
 
-  if (tdp->tpl_size < QFILE_MAX_TUPLE_SIZE_IN_PAGE)
-    {				/* SMALL QFILE_TUPLE */
-      /* set tuple descriptor */
-      tdp->tplrec1 = tplrec1;
-      tdp->tplrec2 = tplrec2;
-      tdp->merge_info = merge_info;
+	  if (qdata_initialize_aggregate_list (thread_p, gbstate->g_agg_list,
+					       gbstate->xasl_state->
+					       query_id) != NO_ERROR)
+	    {
+	      goto exit_on_error;
+	    }
+	}
+      else
+	{
+	  qexec_hash_gby_restore_aggs (gbstate, entry);
+	}
 
-      /* build merged tuple into the list file page */
-      ret = qfile_generate_tuple_into_list (thread_p, list_id, T_MERGE);
-    }
-  else
-    {				/* BIG QFILE_TUPLE */
-      /* merge two tuples, and form a new tuple */
-      ret = qexec_merge_tuple (tplrec1, tplrec2, merge_info, tplrec);
-      if (ret != NO_ERROR)
+      qexec_gby_agg_tuple (thread_p, gbstate, tplrec.tpl, PEEK);
+      qexec_hash_gby_save_aggs (gbstate, entry);
+      if (gbstate->state != NO_ERROR)
 	{
-	  return ret;
+	  goto exit_on_error;
 	}
+    }
 
-      /* add merged tuple to the resultant list file */
-      ret = qfile_add_tuple_to_list (thread_p, list_id, tplrec->tpl);
+  if (scan != S_END)
+    {
+      goto exit_on_error;
     }
+  qfile_close_scan (thread_p, &scan_id);
 
-  return ret;
-}
+  /* output the groups in the order of the grouping columns */
+  if (qexec_hash_agg_sort (thread_p, &table, &entries) != NO_ERROR)
+    {
+      goto exit_on_error;
+    }
 
-/* pre-defined vars:    list_idp,
- *                      merge_infop,
- *                      nvals
- *                      tplrec
- *                      indp
- *                      valp
- *                      scan
- *                      sid
- */
-/****************************** COMMON MACRO ********************************/
-#define QEXEC_MERGE_ADD_MERGETUPLE(thread_p, t1, t2)                         \
-    do {                                                                     \
-        if (qexec_merge_tuple_add_list((thread_p), list_idp, (t1), (t2),     \
-                              merge_infop, &tplrec) != NO_ERROR) {           \
-            goto exit_on_error;                                              \
-        }                                                                    \
-    } while (0)
+  *is_done = true;
 
-#define QEXEC_MERGE_PVALS(pre)                                               \
-    do {                                                                     \
-        int _v;                                                              \
-        for (_v = 0; _v < nvals; _v++) {                                     \
-            do {                                                             \
-                QFILE_GET_TUPLE_VALUE_HEADER_POSITION((pre##_tplrec).tpl,    \
-                                        (pre##_indp)[_v],                    \
-                                        (pre##_valp)[_v]);                   \
-            } while (0);                                                     \
-        }                                                                    \
-    } while (0)
+  for (i = 0; i < table.nentries; i++)
+    {
+      entry = entries[i];
 
-/**************************** INNER MERGE MACRO *****************************/
-#define QEXEC_MERGE_NEXT_SCAN(thread_p, pre, e)                              \
-    do {                                                                     \
-        pre##_scan = qfile_scan_list_next((thread_p), &(pre##_sid), &(pre##_tplrec), PEEK); \
-        if ((e) && pre##_scan == S_END)                                      \
-            goto exit_on_end;                                                \
-        if (pre##_scan == S_ERROR)                                           \
-            goto exit_on_error;                                              \
-    } while (0)
+      /* the group values are referred to by the output and HAVING */
+      if (fetch_val_list (thread_p, gbstate->g_regu_list,
+			  &gbstate->xasl_state->vd, NULL, NULL,
+			  entry->tpl, PEEK) != NO_ERROR)
+	{
+	  goto exit_on_error;
+	}
 
-#define QEXEC_MERGE_PREV_SCAN(thread_p, pre)                                 \
-    do {                                                                     \
-        pre##_scan = qfile_scan_list_prev((thread_p), &(pre##_sid), &(pre##_tplrec), PEEK); \
-        if (pre##_scan == S_ERROR)                                           \
-            goto exit_on_error;                                              \
-    } while (0)
+      /* the accumulators are freed by qexec_gby_finalize_group() */
+      qexec_hash_gby_restore_aggs (gbstate, entry);
+      entry->states = NULL;
 
-#define QEXEC_MERGE_NEXT_SCAN_PVALS(thread_p, pre, e)                        \
-    do {                                                                     \
-        QEXEC_MERGE_NEXT_SCAN((thread_p), pre, e);                           \
-        if (pre##_scan == S_SUCCESS) {                                       \
-            QEXEC_MERGE_PVALS(pre);                                          \
-        }                                                                    \
-    } while (0)
+      qexec_gby_finalize_group (thread_p, gbstate);
+      if (gbstate->state == SORT_PUT_STOP)
+	{
+	  break;
+	}
+      if (gbstate->state != NO_ERROR)
+	{
+	  goto exit_on_error;
+	}
+    }
 
-#define QEXEC_MERGE_REV_SCAN_PVALS(thread_p, pre)                            \
-    do {                                                                     \
-        QEXEC_MERGE_PREV_SCAN((thread_p), pre);                                          \
-        if (pre##_scan == S_SUCCESS) {                                       \
-            QEXEC_MERGE_PVALS(pre);                                          \
-        }                                                                    \
-    } while (0)
+exit_on_end:
+  qfile_close_scan (thread_p, &scan_id);
 
-/*  rename scan_next_scan to scan_next_scan_proxy */
-/**************************** OUTER MERGE MACRO *****************************/
-#define QEXEC_MERGE_OUTER_NEXT_SCAN(thread_p, pre, e)                        \
-    do {                                                                     \
-        pre##_sid->qualification = QPROC_QUALIFIED_OR_NOT; /* init */        \
-        pre##_scan = scan_next_scan((thread_p), pre##_sid);                  \
-        if ((e) && pre##_scan == S_END)                                      \
-            goto exit_on_end;                                                \
-        if (pre##_scan == S_ERROR)                                           \
-            goto exit_on_error;                                              \
-    } while (0)
+  if (entries)
+    {
+      db_private_free_and_init (thread_p, entries);
+    }
+  qexec_hash_agg_clear (thread_p, &table);
 
-#define QEXEC_MERGE_OUTER_PREV_SCAN(thread_p, pre)                           \
-    do {                                                                     \
-        pre##_sid->qualification = QPROC_QUALIFIED_OR_NOT; /* init */        \
-        pre##_scan = scan_prev_scan((thread_p), pre##_sid);                  \
-        if (pre##_scan == S_ERROR)                                           \
-            goto exit_on_error;                                              \
-    } while (0)
+  return error;
 
-#define QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS(thread_p, pre, e)                  \
-    do {                                                                     \
-        QEXEC_MERGE_OUTER_NEXT_SCAN((thread_p), pre, e);                     \
-        if (pre##_scan == S_SUCCESS) {                                       \
-            QEXEC_MERGE_PVALS(pre);                                          \
-        }                                                                    \
-    } while (0)
-
-#define QEXEC_MERGE_OUTER_PREV_SCAN_PVALS(thread_p, pre)                     \
-    do {                                                                     \
-        QEXEC_MERGE_OUTER_PREV_SCAN((thread_p), pre);                        \
-        if (pre##_scan == S_SUCCESS) {                                       \
-            QEXEC_MERGE_PVALS(pre);                                          \
-        }                                                                    \
-    } while (0)
+exit_on_error:
+  error = ER_FAILED;
+  goto exit_on_end;
+}
 
 /*
- * qexec_merge_list () -
- *   return: QFILE_LIST_ID *, or NULL
- *   outer_list_idp(in) : First (left) list file to be merged
- *   inner_list_idp(in) : Second (right) list file to be merged
- *   merge_infop(in)    : List file merge information
- *   ls_flag(in)        :
- *
- * Note: This routine merges the given two sorted list files using
- * the given list file merge information and returns the result
- * list file identifier.
+ * qexec_hash_distinct () - Eliminate the duplicate rows of a list file by
+ *			    hashing
+ *   return: NO_ERROR, or ER_code
+ *   xasl(in)   :
  *
- * Note: The routine assumes that the join column data types for both list
- * files are same.
+ * Note: The distinct rows are kept in their original order, so that the
+ * sort done for DISTINCT afterwards only has the distinct rows to sort.
+ * If the rows outgrow the memory budget, the list file is left as it is.
  */
-static QFILE_LIST_ID *
-qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
-		  QFILE_LIST_ID * inner_list_idp,
-		  QFILE_LIST_MERGE_INFO * merge_infop, int ls_flag)
+static int
+qexec_hash_distinct (THREAD_ENTRY * thread_p, XASL_NODE * xasl)
 {
-  /* outer -> left scan, inner -> right scan */
-
-  /* pred-efined vars */
-  QFILE_LIST_ID *list_idp = NULL;
-  int nvals;
+  QFILE_LIST_ID *list_id = xasl->list_id;
+  QFILE_LIST_ID *distinct_list_id = NULL;
+  SORTKEY_INFO key_info;
+  HASH_AGG_TABLE table;
+  HASH_AGG_ENTRY *entry;
+  QFILE_LIST_SCAN_ID scan_id;
   QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
-  QFILE_TUPLE_RECORD outer_tplrec = { NULL, 0 };
-  QFILE_TUPLE_RECORD inner_tplrec = { NULL, 0 };
-  int *outer_indp, *inner_indp;
-  char **outer_valp = NULL, **inner_valp = NULL;
-  SCAN_CODE outer_scan = S_END, inner_scan = S_END;
-  QFILE_LIST_SCAN_ID outer_sid, inner_sid;
-
-  TP_DOMAIN **outer_domp = NULL, **inner_domp = NULL;
-  QFILE_TUPLE_VALUE_TYPE_LIST type_list;
-  int k, cnt, group_cnt, already_compared;
-  SCAN_DIRECTION direction;
-  QFILE_TUPLE_POSITION inner_tplpos;
-  DB_VALUE_COMPARE_RESULT val_cmp;
-
-  /* get merge columns count */
-  nvals = merge_infop->ls_column_cnt;
-
-  /* get indicator of merge columns */
-  outer_indp = merge_infop->ls_outer_column;
-  inner_indp = merge_infop->ls_inner_column;
-
-  /* form the typelist for the resultant list file */
-  type_list.type_cnt = merge_infop->ls_pos_cnt;
-  type_list.domp = (TP_DOMAIN **) malloc (type_list.type_cnt *
-					  sizeof (TP_DOMAIN *));
-  if (type_list.domp == NULL)
-    {
-      goto exit_on_error;
-    }
-
-  for (k = 0; k < type_list.type_cnt; k++)
-    {
-      type_list.domp[k] =
-	(merge_infop->ls_outer_inner_list[k] == QFILE_OUTER_LIST)
-	? outer_list_idp->type_list.domp[merge_infop->ls_pos_list[k]]
-	: inner_list_idp->type_list.domp[merge_infop->ls_pos_list[k]];
-    }
-
-  outer_sid.status = S_CLOSED;
-  inner_sid.status = S_CLOSED;
+  SCAN_CODE scan;
+  unsigned int hash_key;
+  bool is_done = false;
+  int i;
+  int error = NO_ERROR;
 
-  /* open a scan on the outer(inner) list file */
-  if (qfile_open_list_scan (outer_list_idp, &outer_sid) != NO_ERROR
-      || qfile_open_list_scan (inner_list_idp, &inner_sid) != NO_ERROR)
+  if (list_id->tuple_cnt < 2)
     {
-      goto exit_on_error;
+      return NO_ERROR;
     }
 
-  /* open the result list file; same query id with outer(inner) list file */
-  list_idp = qfile_open_list (thread_p, &type_list, NULL,
-			      outer_list_idp->query_id, ls_flag);
-  if (list_idp == NULL)
+  for (i = 0; i < list_id->type_list.type_cnt; i++)
     {
-      goto exit_on_error;
+      if (pr_is_set_type (list_id->type_list.domp[i]->type->id))
+	{
+	  return NO_ERROR;
+	}
     }
 
-  if (outer_list_idp->tuple_cnt == 0 || inner_list_idp->tuple_cnt == 0)
+  if (qfile_initialize_sort_key_info (&key_info, NULL,
+				      &list_id->type_list) == NULL)
     {
-      goto exit_on_end;
+      return ER_FAILED;
     }
 
-  /* allocate the area to store the merged tuple */
-  if (qfile_reallocate_tuple (&tplrec, DB_PAGESIZE) != NO_ERROR)
-    {
-      goto exit_on_error;
-    }
+  scan_id.status = S_CLOSED;
 
-  /* merge column domain info */
-  outer_domp = (TP_DOMAIN **) db_private_alloc (thread_p,
-						nvals * sizeof (TP_DOMAIN *));
-  if (outer_domp == NULL)
+  if (qexec_hash_agg_init (thread_p, &table, &key_info, 0) != NO_ERROR)
     {
       goto exit_on_error;
     }
 
-  inner_domp = (TP_DOMAIN **) db_private_alloc (thread_p,
-						nvals * sizeof (TP_DOMAIN *));
-  if (inner_domp == NULL)
+  distinct_list_id = qfile_open_list (thread_p, &list_id->type_list, NULL,
+				      list_id->query_id, QFILE_FLAG_ALL);
+  if (distinct_list_id == NULL)
     {
       goto exit_on_error;
     }
 
-  for (k = 0; k < nvals; k++)
-    {
-      outer_domp[k] =
-	outer_list_idp->type_list.domp[merge_infop->ls_outer_column[k]];
-      inner_domp[k] =
-	inner_list_idp->type_list.domp[merge_infop->ls_inner_column[k]];
-    }
-
-  /* merge column val pointer */
-  outer_valp = (char **) db_private_alloc (thread_p, nvals * sizeof (char *));
-  if (outer_valp == NULL)
+  if (qfile_open_list_scan (list_id, &scan_id) != NO_ERROR)
     {
       goto exit_on_error;
     }
 
-  inner_valp = (char **) db_private_alloc (thread_p, nvals * sizeof (char *));
-  if (inner_valp == NULL)
+  while ((scan = qfile_scan_list_next (thread_p, &scan_id, &tplrec, PEEK))
+	 == S_SUCCESS)
     {
-      goto exit_on_error;
-    }
-
-  /* When a list file is sorted on a column, all the NULL values appear at
-     the beginning of the list. So, we know that all the following values
-     in the inner/outer column are BOUND(not NULL) values.
-     Depending on the join type, we must skip or join with a NULL opposite
-     row, when a NULL is encountered. */
+      if (qexec_hash_agg_key (&table, tplrec.tpl, &hash_key) != NO_ERROR)
+	{
+	  goto exit_on_error;
+	}
 
-  /* move the outer(left) scan to the first tuple */
-  while (1)
-    {
-      /* move to the next outer tuple and
-         position tuple values (to merge columns) */
-      QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, outer, true);
+      if (qexec_hash_agg_find (&table, tplrec.tpl, hash_key) != NULL)
+	{
+	  continue;		/* a duplicate */
+	}
 
-      for (k = 0; k < nvals; k++)
+      if (qexec_hash_agg_insert (thread_p, &table, tplrec.tpl, hash_key,
+				 &entry) != NO_ERROR)
 	{
-	  if (QFILE_GET_TUPLE_VALUE_FLAG (outer_valp[k]) == V_UNBOUND)
-	    {
-	      break;
-	    }
+	  goto exit_on_error;
 	}
-      if (k >= nvals)
-	{			/* not found V_UNBOUND. exit loop */
-	  break;
+      if (entry == NULL)
+	{
+	  /* out of the memory budget; leave it to the sort */
+	  goto exit_on_end;
 	}
-    }
-
-  /* move the inner(right) scan to the first tuple */
-  while (1)
-    {
-      /* move to the next inner tuple and
-         position tuple values (to merge columns) */
-      QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, inner, true);
 
-      for (k = 0; k < nvals; k++)
+      if (qfile_add_tuple_to_list (thread_p, distinct_list_id,
+				   tplrec.tpl) != NO_ERROR)
 	{
-	  if (QFILE_GET_TUPLE_VALUE_FLAG (inner_valp[k]) == V_UNBOUND)
-	    {
-	      break;
-	    }
-	}
-      if (k >= nvals)
-	{			/* not found V_UNBOUND. exit loop */
-	  break;
+	  goto exit_on_error;
 	}
+    }
 
+  if (scan != S_END)
+    {
+      goto exit_on_error;
     }
 
-  /* set the comparison function to be called */
-  direction = S_FORWARD;
-  group_cnt = 0;
-  already_compared = false;
-  val_cmp = DB_UNK;
+  is_done = true;
 
-  while (1)
+exit_on_end:
+  qfile_close_scan (thread_p, &scan_id);
+  qexec_hash_agg_clear (thread_p, &table);
+  qfile_clear_sort_key_info (&key_info);
+
+  if (distinct_list_id)
     {
-      /* compare two tuple values, if they have not been compared yet */
-      if (!already_compared)
+      qfile_close_list (thread_p, distinct_list_id);
+      if (is_done)
 	{
-	  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
-					      inner_valp, inner_domp, nvals);
-	  if (val_cmp == DB_UNK)
-	    {			/* is error */
-	      goto exit_on_error;
-	    }
+	  /* replace the list file by its distinct rows */
+	  qfile_destroy_list (thread_p, list_id);
+	  qfile_copy_list_id (list_id, distinct_list_id, true);
 	}
-      already_compared = false;	/* re-init */
-
-      /* value of the outer is less than value of the inner */
-      if (val_cmp == DB_LT)
+      else
 	{
-	  /* move the outer(left) scan to the next tuple and
-	     position tuple values (to merge columns) */
-	  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, outer, true);
-	  direction = S_FORWARD;
-	  group_cnt = 0;
-
-	  continue;
+	  qfile_destroy_list (thread_p, distinct_list_id);
 	}
+      qfile_free_list_id (distinct_list_id);
+    }
 
-      /* value of the outer is greater than value of the inner */
-      if (val_cmp == DB_GT)
-	{
-	  /* move the inner(right) scan to the next tuple and
-	     position tuple values (to merge columns) */
-	  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, inner, true);
-	  direction = S_FORWARD;
-	  group_cnt = 0;
+  return error;
 
-	  continue;
-	}
+exit_on_error:
+  error = ER_FAILED;
+  is_done = false;
+  goto exit_on_end;
+}
 
-      if (val_cmp != DB_EQ)
-	{			/* error ? */
-	  goto exit_on_error;
-	}
+/*
+ * qexec_groupby () -
+ *   return: NO_ERROR, or ER_code
+ *   xasl(in)   :
+ *   xasl_state(in)     : XASL tree state information
+ *   tplrec(out) : Tuple record descriptor to store result tuples
+ *
+ * Note: Apply the group_by clause to the given list file to group it
+ * using the specified group_by parameters.
+ */
+static int
+qexec_groupby (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
+	       XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * tplrec)
+{
+  QFILE_LIST_ID *list_id = xasl->list_id;
+  BUILDLIST_PROC_NODE *buildlist = &xasl->proc.buildlist;
+  GROUPBY_STATE gbstate;
+  QFILE_LIST_SCAN_ID input_scan_id;
+  int ls_flag = 0;
+  bool is_done = false;
 
-      /* values of the outer and inner are equal, do a scan group processing
-       */
-      if (direction == S_FORWARD)
-	{
-	  /* move forwards within a group
-	   */
-	  cnt = 0;
-	  /* group_cnt has the number of tuples in the group */
-	  while (1)
-	    {
-	      /* merge the fetched tuples(left and right) */
-	      QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec,
+  if (buildlist->groupby_list == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  /* initialize groupby_num() value */
+  if (buildlist->g_grbynum_val && DB_IS_NULL (buildlist->g_grbynum_val))
+    {
+      DB_MAKE_INT (buildlist->g_grbynum_val, 0);
+    }
+
+  if (qexec_initialize_groupby_state (&gbstate, buildlist->groupby_list,
+				      buildlist->g_having_pred,
+				      buildlist->g_grbynum_pred,
+				      buildlist->g_grbynum_val,
+				      buildlist->g_grbynum_flag,
+				      buildlist->eptr_list,
+				      buildlist->g_agg_list,
+				      buildlist->g_regu_list,
+				      buildlist->g_val_list,
+				      buildlist->g_outptr_list,
+				      buildlist->g_with_rollup,
+				      xasl_state,
+				      &list_id->type_list, tplrec) == NULL)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+
+  /*
+   * Create a new listfile to receive the results.
+   */
+  {
+    QFILE_TUPLE_VALUE_TYPE_LIST output_type_list;
+    QFILE_LIST_ID *output_list_id;
+
+    if (qdata_get_valptr_type_list (buildlist->g_outptr_list,
+				    &output_type_list) != NO_ERROR)
+      {
+	GOTO_EXIT_ON_ERROR;
+      }
+    /* If it does not have 'order by'(xasl->orderby_list),
+       then the list file to be open at here will be the last one.
+       Otherwise, the last list file will be open at
+       qexec_orderby_distinct().
+       (Note that only one that can have 'group by' is BUILDLIST_PROC type.)
+       And, the top most XASL is the other condition for the list file
+       to be the last result file. */
+
+    QFILE_SET_FLAG (ls_flag, QFILE_FLAG_ALL);
+    if (XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL)
+	&& XASL_IS_FLAGED (xasl, XASL_TO_BE_CACHED)
+	&& (xasl->orderby_list == NULL
+	    || XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST))
+	&& xasl->option != Q_DISTINCT)
+      {
+	QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
+      }
+
+    output_list_id = qfile_open_list (thread_p, &output_type_list,
+				      buildlist->after_groupby_list,
+				      xasl_state->query_id, ls_flag);
+    if (output_list_id == NULL)
+      {
+	if (output_type_list.domp)
+	  {
+	    db_private_free_and_init (thread_p, output_type_list.domp);
+	  }
+
+	GOTO_EXIT_ON_ERROR;
+      }
+
+    if (output_type_list.domp)
+      {
+	db_private_free_and_init (thread_p, output_type_list.domp);
+      }
+
+    gbstate.output_file = output_list_id;
+  }
+
+  if (list_id->tuple_cnt == 0)
+    {
+      /* empty unsorted list file, no need to proceed */
+      qfile_destroy_list (thread_p, list_id);
+      qfile_close_list (thread_p, gbstate.output_file);
+      qfile_copy_list_id (list_id, gbstate.output_file, true);
+      qexec_clear_groupby_state (thread_p, &gbstate);	/* will free gbstate.output_file */
+
+      return NO_ERROR;
+    }
+
+  /*
+   * With few groups, group by hashing instead of sorting the input
+   */
+  if (XASL_IS_FLAGED (xasl, XASL_USE_HASH_AGGREGATE)
+      && qexec_hash_gby_is_eligible (&gbstate))
+    {
+      if (qexec_hash_groupby (thread_p, &gbstate, list_id, &is_done) !=
+	  NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+    }
+
+  if (!is_done)
+    {
+      /*
+       * Open a scan on the unsorted input file
+       */
+      if (qfile_open_list_scan (list_id, &input_scan_id) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+      gbstate.input_scan = &input_scan_id;
+
+      /*
+       * Now load up the sort module and set it off...
+       */
+      gbstate.key_info.use_original =
+	(gbstate.key_info.nkeys != list_id->type_list.type_cnt);
+      gbstate.cmp_fn = (gbstate.key_info.use_original == 1
+			? &qfile_compare_partial_sort_record
+			: &qfile_compare_all_sort_record);
+
+      if (sort_listfile (thread_p, NULL_VOLID,
+			 qfile_get_estimated_pages_for_sorting (list_id,
+								&gbstate.
+								key_info),
+			 &qexec_gby_get_next, &gbstate, &qexec_gby_put_next,
+			 &gbstate, gbstate.cmp_fn, &gbstate.key_info,
+			 SORT_DUP, NO_SORT_LIMIT) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+    }
+
+  /*
+   * There may be one unfinished group in the output, since the sort_listfile
+   * interface doesn't include a finalization function.  If so, finish
+   * off that group.
+   */
+  if (gbstate.input_recs != 0)
+    {
+      qexec_gby_finalize_group (thread_p, &gbstate);
+      if (gbstate.g_rollup_agg_list)
+	{
+	  int i;
+	  for (i = gbstate.rollup_levels - 1; i >= 0; i--)
+	    {
+	      qexec_gby_finalize_rollup_group (thread_p, &gbstate, i);
+	    }
+	}
+    }
+
+  qfile_close_list (thread_p, gbstate.output_file);
+#if 0				/* SortCache */
+  /* free currently fixed page */
+  if (gbstate.fixed_page != NULL)
+    {
+      QFILE_LIST_ID *list_idp;
+
+      list_idp = &(gbstate.input_scan->list_id);
+      qmgr_free_old_page (gbstate.fixed_page, list_idp->tfile_vfid);
+      gbstate.fixed_page = NULL;
+    }
+#endif
+  qfile_destroy_list (thread_p, list_id);
+  qfile_copy_list_id (list_id, gbstate.output_file, true);
+  /* qexec_clear_groupby_state() will free gbstate.output_file */
+
+wrapup:
+  {
+    int result;
+    /* SORT_PUT_STOP set by 'qexec_gby_finalize_group()' isn't error */
+    result = (gbstate.state == NO_ERROR || gbstate.state == SORT_PUT_STOP)
+      ? NO_ERROR : ER_FAILED;
+    qexec_clear_groupby_state (thread_p, &gbstate);
+    return result;
+  }
+
+exit_on_error:
+
+  gbstate.state = er_errid ();
+  if (gbstate.state == NO_ERROR || gbstate.state == SORT_PUT_STOP)
+    {
+      gbstate.state = ER_FAILED;
+    }
+
+  goto wrapup;
+}
+
+/*
+ * qexec_collection_has_null () -
+ *   return: 1 iff collection has an element with a NULL in it
+ *   colval(in) : DB_VALUE of a collection
+ */
+static int
+qexec_collection_has_null (DB_VALUE * colval)
+{
+  DB_VALUE elem;
+  DB_COLLECTION *col;
+  long i;
+  int result = 0;
+
+  col = db_get_set (colval);
+  for (i = 0; i < db_set_size (col) && !result; i++)
+    {
+      if (db_set_get (col, i, &elem) < NO_ERROR)
+	{
+	  return 1;
+	  /* flag an error as a NULL, DON'T clear elem with unknown state */
+	}
+      if (PRIM_IS_NULL (&elem))
+	{
+	  return 1;		/* found a NULL, can stop looking, clear unecessary */
+	}
+
+      if (pr_is_set_type (PRIM_TYPE (&elem))
+	  && qexec_collection_has_null (&elem))
+	{
+	  /* this is for nested set types, need to fall thru to clear */
+	  result = 1;
+	}
+
+      pr_clear_value (&elem);
+    }
+
+  return 0;
+}
+
+/*
+ * qexec_cmp_tpl_vals_merge () -
+ *   return:
+ *        DB_UNK: return error
+ *   left_tval(in)      : left tuple values
+ *   left_dom(in)       : Domains of left_tval
+ *   rght_tval(in)      : right tuple values
+ *   rght_dom(in)       : Domains of rght_tval
+ *   tval_cnt(in)       : tuple values count
+ *
+ * Note: This routine checks if two tuple values are equal. Coercion
+ * is done if necessary. This must give a totally
+ * ordered result, but never return equal for
+ * a NULL comparison. The result of this comparison
+ * will tell the merge routine whether to advance the
+ * left or right file to the next tuple. DB_UNK
+ * cannot be returned because it is ambiguous as
+ * to which side is collated later. If two
+ * NULL's or two collections both containing NULL
+ * are encountered, then it may pick either side
+ * as the lessor side, that tuple will be discarded,
+ * then the next comparison will discard the other side.
+ */
+static DB_VALUE_COMPARE_RESULT
+qexec_cmp_tpl_vals_merge (QFILE_TUPLE * left_tval, TP_DOMAIN ** left_dom,
+			  QFILE_TUPLE * rght_tval, TP_DOMAIN ** rght_dom,
+			  int tval_cnt)
+{
+  OR_BUF buf;
+  DB_VALUE left_dbval, rght_dbval;
+  int i, cmp, left_len, rght_len;
+  bool left_is_set, rght_is_set;
+
+  cmp = DB_UNK;			/* init */
+
+  for (i = 0; i < tval_cnt; i++)
+    {
+      /* get tpl values into db_values for the comparison
+       */
+
+      /* zero length means NULL */
+      if ((left_len = QFILE_GET_TUPLE_VALUE_LENGTH (left_tval[i])) == 0)
+	{
+	  cmp = DB_LT;
+	  break;
+	}
+      rght_len = QFILE_GET_TUPLE_VALUE_LENGTH (rght_tval[i]);
+      if (rght_len == 0)
+	{
+	  cmp = DB_GT;
+	  break;
+	}
+
+      or_init (&buf, (char *) (left_tval[i] + QFILE_TUPLE_VALUE_HEADER_SIZE),
+	       left_len);
+      /* Do not copy the string--just use the pointer.  The pr_ routines
+       * for strings and sets have different semantics for length.
+       */
+      left_is_set = pr_is_set_type (left_dom[i]->type->id) ? true : false;
+      if ((*(left_dom[i]->type->readval)) (&buf, &left_dbval, left_dom[i], -1,
+					   left_is_set, NULL, 0) != NO_ERROR)
+	{
+	  cmp = DB_UNK;		/* is error */
+	  break;
+	}
+      if (DB_IS_NULL (&left_dbval))
+	{
+	  cmp = DB_LT;
+	  break;
+	}
+
+      or_init (&buf, (char *) (rght_tval[i] + QFILE_TUPLE_VALUE_HEADER_SIZE),
+	       rght_len);
+      /* Do not copy the string--just use the pointer.  The pr_ routines
+       * for strings and sets have different semantics for length.
+       */
+      rght_is_set = pr_is_set_type (rght_dom[i]->type->id) ? true : false;
+      if ((*(rght_dom[i]->type->readval)) (&buf, &rght_dbval, rght_dom[i], -1,
+					   rght_is_set, NULL, 0) != NO_ERROR)
+	{
+	  cmp = DB_UNK;		/* is error */
+	  break;
+	}
+      if (DB_IS_NULL (&rght_dbval))
+	{
+	  cmp = DB_GT;
+	  break;
+	}
+
+      /* both left_dbval, rght_dbval is non-null */
+      cmp = tp_value_compare (&left_dbval, &rght_dbval, 1, 0);
+
+      if (left_is_set)
+	{
+	  if (cmp == DB_UNK && qexec_collection_has_null (&left_dbval))
+	    {
+	      cmp = DB_LT;
+	    }
+	  pr_clear_value (&left_dbval);
+	}
+      if (rght_is_set)
+	{
+	  if (cmp == DB_UNK && qexec_collection_has_null (&rght_dbval))
+	    {
+	      cmp = DB_GT;
+	    }
+	  pr_clear_value (&rght_dbval);
+	}
+
+      if (cmp == DB_EQ)
+	{
+	  continue;		/* step into the next tval */
+	}
+
+      if (cmp == DB_LT || cmp == DB_GT)
+	{
+	  ;			/* OK */
+	}
+      else
+	{			/* is error */
+	  cmp = DB_UNK;
+	}
+
+      /* at here, immediately return */
+      break;
+    }
+
+  return (DB_VALUE_COMPARE_RESULT) cmp;
+}
+
+/*
+ * qexec_size_remaining () -
+ *   return: int
+ *   tplrec1(in)        : First tuple descriptor
+ *   tplrec2(in)        : Second tuple descriptor
+ *   merge_info(in)     : Tuple merge information
+ *   k(in)      : column to start at
+ *
+ * Note: This routine calculates the size needed to store the
+ *  remaining tuple to copy.
+ * If either tuple is a NULL pointer, assume that the space
+ * for an UNBOUND (header) will be needed.
+ */
+static long
+qexec_size_remaining (QFILE_TUPLE_RECORD * tplrec1,
+		      QFILE_TUPLE_RECORD * tplrec2,
+		      QFILE_LIST_MERGE_INFO * merge_info, int k)
+{
+  int i, tpl_size;
+  char *t_valhp;
+
+  tpl_size = 0;
+  for (i = k; i < merge_info->ls_pos_cnt; i++)
+    {
+      tpl_size += QFILE_TUPLE_VALUE_HEADER_SIZE;
+      if (merge_info->ls_outer_inner_list[i] == QFILE_OUTER_LIST)
+	{
+	  if (tplrec1)
+	    {
+	      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tplrec1->tpl,
+						     merge_info->
+						     ls_pos_list[i], t_valhp);
+	      tpl_size += QFILE_GET_TUPLE_VALUE_LENGTH (t_valhp);
+	    }
+	}
+      else
+	{
+	  if (tplrec2)
+	    {
+	      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tplrec2->tpl,
+						     merge_info->
+						     ls_pos_list[i], t_valhp);
+	      tpl_size += QFILE_GET_TUPLE_VALUE_LENGTH (t_valhp);
+	    }
+	}
+    }
+
+  return tpl_size;
+}
+
+/*
+ * qexec_merge_tuple () -
+ *   return: NO_ERROR, or ER_code
+ *   tplrec1(in)        : First tuple descriptor
+ *   tplrec2(in)        : Second tuple descriptor
+ *   merge_info(in)     : Tuple merge information
+ *   tplrec(in) : Result tuple descriptor
+ *
+ * Note: This routine merges the given two list files tuples using
+ * the given list merge information and stores the result into
+ * result tuple descriptor.
+ */
+static int
+qexec_merge_tuple (QFILE_TUPLE_RECORD * tplrec1, QFILE_TUPLE_RECORD * tplrec2,
+		   QFILE_LIST_MERGE_INFO * merge_info,
+		   QFILE_TUPLE_RECORD * tplrec)
+{
+  QFILE_TUPLE tplp;
+  char *t_valhp;
+  int t_val_size;
+  int tpl_size, offset;
+  int k;
+  INT32 ls_unbound[2] = { 0, 0 };
+
+  /* merge two tuples, and form a new tuple */
+  tplp = tplrec->tpl;
+  offset = 0;
+  QFILE_PUT_TUPLE_LENGTH (tplp, QFILE_TUPLE_LENGTH_SIZE);	/* set tuple length */
+  tplp += QFILE_TUPLE_LENGTH_SIZE;
+  offset += QFILE_TUPLE_LENGTH_SIZE;
+
+  QFILE_PUT_TUPLE_VALUE_FLAG ((char *) ls_unbound, V_UNBOUND);
+  QFILE_PUT_TUPLE_VALUE_LENGTH ((char *) ls_unbound, 0);
+
+  /* copy tuple values from the first and second list file tuples */
+  for (k = 0; k < merge_info->ls_pos_cnt; k++)
+    {
+
+      if (merge_info->ls_outer_inner_list[k] == QFILE_OUTER_LIST)
+	{
+	  if (tplrec1)
+	    {
+	      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tplrec1->tpl,
+						     merge_info->
+						     ls_pos_list[k], t_valhp);
+	    }
+	  else
+	    {
+	      t_valhp = (char *) ls_unbound;
+	    }
+	}
+      else
+	{			/* copy from the second tuple */
+	  if (tplrec2)
+	    {
+	      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tplrec2->tpl,
+						     merge_info->
+						     ls_pos_list[k], t_valhp);
+	    }
+	  else
+	    {
+	      t_valhp = (char *) ls_unbound;
+	    }
+	}
+
+      t_val_size =
+	QFILE_TUPLE_VALUE_HEADER_SIZE +
+	QFILE_GET_TUPLE_VALUE_LENGTH (t_valhp);
+      if ((tplrec->size - offset) < t_val_size)
+	{			/* no space left */
+	  tpl_size = offset +
+	    qexec_size_remaining (tplrec1, tplrec2, merge_info, k);
+	  if (qfile_reallocate_tuple (tplrec, tpl_size) != NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
+	  tplp = (QFILE_TUPLE) tplrec->tpl + offset;
+	}
+
+      memcpy (tplp, t_valhp, t_val_size);
+      tplp += t_val_size;
+      offset += t_val_size;
+    }				/* for */
+
+  /* set tuple length */
+  QFILE_PUT_TUPLE_LENGTH (tplrec->tpl, offset);
+
+  return NO_ERROR;
+}
+
+/*
+ * qexec_merge_tuple_add_list () - Merge a tuple, and add it to the list file
+ *   return: NO_ERROR, or ER_code
+ *   list_id(in)        : List file to insert into
+ *   tplrec1(in)        : First tuple descriptor
+ *   tplrec2(in)        : Second tuple descriptor
+ *   merge_info(in)     : Tuple merge information
+ *   tplrec(in) : Result tuple descriptor
+ */
+static int
+qexec_merge_tuple_add_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id,
+			    QFILE_TUPLE_RECORD * tplrec1,
+			    QFILE_TUPLE_RECORD * tplrec2,
+			    QFILE_LIST_MERGE_INFO * merge_info,
+			    QFILE_TUPLE_RECORD * tplrec)
+{
+  int ret;
+  QFILE_TUPLE_DESCRIPTOR *tdp;
+  int tplrec1_max_size;
+  int tplrec2_max_size;
+
+  /* get tuple descriptor */
+  tdp = &(list_id->tpl_descr);
+
+  if (tplrec1)
+    {
+      tplrec1_max_size = QFILE_GET_TUPLE_LENGTH (tplrec1->tpl);
+    }
+  else
+    {
+      tplrec1_max_size =
+	QFILE_TUPLE_VALUE_HEADER_SIZE * (merge_info->ls_pos_cnt);
+    }
+
+  if (tplrec2)
+    {
+      tplrec2_max_size = QFILE_GET_TUPLE_LENGTH (tplrec2->tpl);
+    }
+  else
+    {
+      tplrec2_max_size =
+	QFILE_TUPLE_VALUE_HEADER_SIZE * (merge_info->ls_pos_cnt);
+    }
+
+  tdp->tpl_size =
+    DB_ALIGN (tplrec1_max_size + tplrec2_max_size, MAX_ALIGNMENT);
+
+  if (tdp->tpl_size < QFILE_MAX_TUPLE_SIZE_IN_PAGE)
+    {				/* SMALL QFILE_TUPLE */
+      /* set tuple descriptor */
+      tdp->tplrec1 = tplrec1;
+      tdp->tplrec2 = tplrec2;
+      tdp->merge_info = merge_info;
+
+      /* build merged tuple into the list file page */
+      ret = qfile_generate_tuple_into_list (thread_p, list_id, T_MERGE);
+    }
+  else
+    {				/* BIG QFILE_TUPLE */
+      /* merge two tuples, and form a new tuple */
+      ret = qexec_merge_tuple (tplrec1, tplrec2, merge_info, tplrec);
+      if (ret != NO_ERROR)
+	{
+	  return ret;
+	}
+
+      /* add merged tuple to the resultant list file */
+      ret = qfile_add_tuple_to_list (thread_p, list_id, tplrec->tpl);
+    }
+
+  return ret;
+}
+
+/* pre-defined vars:    list_idp,
+ *                      merge_infop,
+ *                      nvals
+ *                      tplrec
+ *                      indp
+ *                      valp
+ *                      scan
+ *                      sid
+ */
+/****************************** COMMON MACRO ********************************/
+#define QEXEC_MERGE_ADD_MERGETUPLE(thread_p, t1, t2)                         \
+    do {                                                                     \
+        if (qexec_merge_tuple_add_list((thread_p), list_idp, (t1), (t2),     \
+                              merge_infop, &tplrec) != NO_ERROR) {           \
+            goto exit_on_error;                                              \
+        }                                                                    \
+    } while (0)
+
+#define QEXEC_MERGE_PVALS(pre)                                               \
+    do {                                                                     \
+        int _v;                                                              \
+        for (_v = 0; _v < nvals; _v++) {                                     \
+            do {                                                             \
+                QFILE_GET_TUPLE_VALUE_HEADER_POSITION((pre##_tplrec).tpl,    \
+                                        (pre##_indp)[_v],                    \
+                                        (pre##_valp)[_v]);                   \
+            } while (0);                                                     \
+        }                                                                    \
+    } while (0)
+
+/**************************** INNER MERGE MACRO *****************************/
+#define QEXEC_MERGE_NEXT_SCAN(thread_p, pre, e)                              \
+    do {                                                                     \
+        pre##_scan = qfile_scan_list_next((thread_p), &(pre##_sid), &(pre##_tplrec), PEEK); \
+        if ((e) && pre##_scan == S_END)                                      \
+            goto exit_on_end;                                                \
+        if (pre##_scan == S_ERROR)                                           \
+            goto exit_on_error;                                              \
+    } while (0)
+
+#define QEXEC_MERGE_PREV_SCAN(thread_p, pre)                                 \
+    do {                                                                     \
+        pre##_scan = qfile_scan_list_prev((thread_p), &(pre##_sid), &(pre##_tplrec), PEEK); \
+        if (pre##_scan == S_ERROR)                                           \
+            goto exit_on_error;                                              \
+    } while (0)
+
+#define QEXEC_MERGE_NEXT_SCAN_PVALS(thread_p, pre, e)                        \
+    do {                                                                     \
+        QEXEC_MERGE_NEXT_SCAN((thread_p), pre, e);                           \
+        if (pre##_scan == S_SUCCESS) {                                       \
+            QEXEC_MERGE_PVALS(pre);                                          \
+        }                                                                    \
+    } while (0)
+
+#define QEXEC_MERGE_REV_SCAN_PVALS(thread_p, pre)                            \
+    do {                                                                     \
+        QEXEC_MERGE_PREV_SCAN((thread_p), pre);                                          \
+        if (pre##_scan == S_SUCCESS) {                                       \
+            QEXEC_MERGE_PVALS(pre);                                          \
+        }                                                                    \
+    } while (0)
+
+/*  rename scan_next_scan to scan_next_scan_proxy */
+/**************************** OUTER MERGE MACRO *****************************/
+#define QEXEC_MERGE_OUTER_NEXT_SCAN(thread_p, pre, e)                        \
+    do {                                                                     \
+        pre##_sid->qualification = QPROC_QUALIFIED_OR_NOT; /* init */        \
+        pre##_scan = scan_next_scan((thread_p), pre##_sid);                  \
+        if ((e) && pre##_scan == S_END)                                      \
+            goto exit_on_end;                                                \
+        if (pre##_scan == S_ERROR)                                           \
+            goto exit_on_error;                                              \
+    } while (0)
+
+#define QEXEC_MERGE_OUTER_PREV_SCAN(thread_p, pre)                           \
+    do {                                                                     \
+        pre##_sid->qualification = QPROC_QUALIFIED_OR_NOT; /* init */        \
+        pre##_scan = scan_prev_scan((thread_p), pre##_sid);                  \
+        if (pre##_scan == S_ERROR)                                           \
+            goto exit_on_error;                                              \
+    } while (0)
+
+#define QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS(thread_p, pre, e)                  \
+    do {                                                                     \
+        QEXEC_MERGE_OUTER_NEXT_SCAN((thread_p), pre, e);                     \
+        if (pre##_scan == S_SUCCESS) {                                       \
+            QEXEC_MERGE_PVALS(pre);                                          \
+        }                                                                    \
+    } while (0)
+
+#define QEXEC_MERGE_OUTER_PREV_SCAN_PVALS(thread_p, pre)                     \
+    do {                                                                     \
+        QEXEC_MERGE_OUTER_PREV_SCAN((thread_p), pre);                        \
+        if (pre##_scan == S_SUCCESS) {                                       \
+            QEXEC_MERGE_PVALS(pre);                                          \
+        }                                                                    \
+    } while (0)
+
+/*
+ * qexec_merge_list () -
+ *   return: QFILE_LIST_ID *, or NULL
+ *   outer_list_idp(in) : First (left) list file to be merged
+ *   inner_list_idp(in) : Second (right) list file to be merged
+ *   merge_infop(in)    : List file merge information
+ *   ls_flag(in)        :
+ *
+ * Note: This routine merges the given two sorted list files using
+ * the given list file merge information and returns the result
+ * list file identifier.
+ *
+ * Note: The routine assumes that the join column data types for both list
+ * files are same.
+ */
+static QFILE_LIST_ID *
+qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
+		  QFILE_LIST_ID * inner_list_idp,
+		  QFILE_LIST_MERGE_INFO * merge_infop, int ls_flag)
+{
+  /* outer -> left scan, inner -> right scan */
+
+  /* pred-efined vars */
+  QFILE_LIST_ID *list_idp = NULL;
+  int nvals;
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  QFILE_TUPLE_RECORD outer_tplrec = { NULL, 0 };
+  QFILE_TUPLE_RECORD inner_tplrec = { NULL, 0 };
+  int *outer_indp, *inner_indp;
+  char **outer_valp = NULL, **inner_valp = NULL;
+  SCAN_CODE outer_scan = S_END, inner_scan = S_END;
+  QFILE_LIST_SCAN_ID outer_sid, inner_sid;
+
+  TP_DOMAIN **outer_domp = NULL, **inner_domp = NULL;
+  QFILE_TUPLE_VALUE_TYPE_LIST type_list;
+  int k, cnt, group_cnt, already_compared;
+  SCAN_DIRECTION direction;
+  QFILE_TUPLE_POSITION inner_tplpos;
+  DB_VALUE_COMPARE_RESULT val_cmp;
+
+  /* get merge columns count */
+  nvals = merge_infop->ls_column_cnt;
+
+  /* get indicator of merge columns */
+  outer_indp = merge_infop->ls_outer_column;
+  inner_indp = merge_infop->ls_inner_column;
+
+  /* form the typelist for the resultant list file */
+  type_list.type_cnt = merge_infop->ls_pos_cnt;
+  type_list.domp = (TP_DOMAIN **) malloc (type_list.type_cnt *
+					  sizeof (TP_DOMAIN *));
+  if (type_list.domp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  for (k = 0; k < type_list.type_cnt; k++)
+    {
+      type_list.domp[k] =
+	(merge_infop->ls_outer_inner_list[k] == QFILE_OUTER_LIST)
+	? outer_list_idp->type_list.domp[merge_infop->ls_pos_list[k]]
+	: inner_list_idp->type_list.domp[merge_infop->ls_pos_list[k]];
+    }
+
+  outer_sid.status = S_CLOSED;
+  inner_sid.status = S_CLOSED;
+
+  /* open a scan on the outer(inner) list file */
+  if (qfile_open_list_scan (outer_list_idp, &outer_sid) != NO_ERROR
+      || qfile_open_list_scan (inner_list_idp, &inner_sid) != NO_ERROR)
+    {
+      goto exit_on_error;
+    }
+
+  /* open the result list file; same query id with outer(inner) list file */
+  list_idp = qfile_open_list (thread_p, &type_list, NULL,
+			      outer_list_idp->query_id, ls_flag);
+  if (list_idp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  if (outer_list_idp->tuple_cnt == 0 || inner_list_idp->tuple_cnt == 0)
+    {
+      goto exit_on_end;
+    }
+
+  /* allocate the area to store the merged tuple */
+  if (qfile_reallocate_tuple (&tplrec, DB_PAGESIZE) != NO_ERROR)
+    {
+      goto exit_on_error;
+    }
+
+  /* merge column domain info */
+  outer_domp = (TP_DOMAIN **) db_private_alloc (thread_p,
+						nvals * sizeof (TP_DOMAIN *));
+  if (outer_domp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  inner_domp = (TP_DOMAIN **) db_private_alloc (thread_p,
+						nvals * sizeof (TP_DOMAIN *));
+  if (inner_domp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  for (k = 0; k < nvals; k++)
+    {
+      outer_domp[k] =
+	outer_list_idp->type_list.domp[merge_infop->ls_outer_column[k]];
+      inner_domp[k] =
+	inner_list_idp->type_list.domp[merge_infop->ls_inner_column[k]];
+    }
+
+  /* merge column val pointer */
+  outer_valp = (char **) db_private_alloc (thread_p, nvals * sizeof (char *));
+  if (outer_valp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  inner_valp = (char **) db_private_alloc (thread_p, nvals * sizeof (char *));
+  if (inner_valp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  /* When a list file is sorted on a column, all the NULL values appear at
+     the beginning of the list. So, we know that all the following values
+     in the inner/outer column are BOUND(not NULL) values.
+     Depending on the join type, we must skip or join with a NULL opposite
+     row, when a NULL is encountered. */
+
+  /* move the outer(left) scan to the first tuple */
+  while (1)
+    {
+      /* move to the next outer tuple and
+         position tuple values (to merge columns) */
+      QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, outer, true);
+
+      for (k = 0; k < nvals; k++)
+	{
+	  if (QFILE_GET_TUPLE_VALUE_FLAG (outer_valp[k]) == V_UNBOUND)
+	    {
+	      break;
+	    }
+	}
+      if (k >= nvals)
+	{			/* not found V_UNBOUND. exit loop */
+	  break;
+	}
+    }
+
+  /* move the inner(right) scan to the first tuple */
+  while (1)
+    {
+      /* move to the next inner tuple and
+         position tuple values (to merge columns) */
+      QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, inner, true);
+
+      for (k = 0; k < nvals; k++)
+	{
+	  if (QFILE_GET_TUPLE_VALUE_FLAG (inner_valp[k]) == V_UNBOUND)
+	    {
+	      break;
+	    }
+	}
+      if (k >= nvals)
+	{			/* not found V_UNBOUND. exit loop */
+	  break;
+	}
+
+    }
+
+  /* set the comparison function to be called */
+  direction = S_FORWARD;
+  group_cnt = 0;
+  already_compared = false;
+  val_cmp = DB_UNK;
+
+  while (1)
+    {
+      /* compare two tuple values, if they have not been compared yet */
+      if (!already_compared)
+	{
+	  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
+					      inner_valp, inner_domp, nvals);
+	  if (val_cmp == DB_UNK)
+	    {			/* is error */
+	      goto exit_on_error;
+	    }
+	}
+      already_compared = false;	/* re-init */
+
+      /* value of the outer is less than value of the inner */
+      if (val_cmp == DB_LT)
+	{
+	  /* move the outer(left) scan to the next tuple and
+	     position tuple values (to merge columns) */
+	  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, outer, true);
+	  direction = S_FORWARD;
+	  group_cnt = 0;
+
+	  continue;
+	}
+
+      /* value of the outer is greater than value of the inner */
+      if (val_cmp == DB_GT)
+	{
+	  /* move the inner(right) scan to the next tuple and
+	     position tuple values (to merge columns) */
+	  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, inner, true);
+	  direction = S_FORWARD;
+	  group_cnt = 0;
+
+	  continue;
+	}
+
+      if (val_cmp != DB_EQ)
+	{			/* error ? */
+	  goto exit_on_error;
+	}
+
+      /* values of the outer and inner are equal, do a scan group processing
+       */
+      if (direction == S_FORWARD)
+	{
+	  /* move forwards within a group
+	   */
+	  cnt = 0;
+	  /* group_cnt has the number of tuples in the group */
+	  while (1)
+	    {
+	      /* merge the fetched tuples(left and right) */
+	      QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec,
+					  &inner_tplrec);
+
+	      cnt++;		/* increase the counter of processed tuples */
+
+	      /* if the group is formed for the first time */
+	      if (group_cnt == 0)
+		{
+		  /* move the inner(right) scan to the next tuple and
+		     position tuple values (to merge columns) */
+		  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, inner,
+					       false /* do not exit */ );
+		  if (inner_scan == S_END)
+		    {
+		      break;
+		    }
+
+		  /* and compare */
+		  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp,
+						      outer_domp,
+						      inner_valp,
+						      inner_domp, nvals);
+		  if (val_cmp != DB_EQ)
+		    {
+		      if (val_cmp == DB_UNK)
+			{	/* is error */
+			  goto exit_on_error;
+			}
+
+		      break;	/* found the bottom of the group */
+		    }
+		}
+	      else
+		{		/* group_cnt > 0 */
+		  if (cnt >= group_cnt)
+		    {
+		      break;	/* reached the bottom of the group */
+		    }
+
+		  /* move the inner(right) scan to the next tuple */
+		  QEXEC_MERGE_NEXT_SCAN (thread_p, inner, true);
+		}
+	    }			/* while (1) */
+
+	  /* move the outer to the next tuple and position tuple values */
+	  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, outer, true);
+
+	  /* if the group is formed for the first time */
+	  if (group_cnt == 0)
+	    {
+	      /* save the position of inner scan;
+	         it is the bottom of the group */
+	      qfile_save_current_scan_tuple_position (&inner_sid,
+						      &inner_tplpos);
+
+	      if (inner_scan == S_END)
+		{
+		  /* move the inner to the previous tuple and
+		     position tuple values */
+		  QEXEC_MERGE_REV_SCAN_PVALS (thread_p, inner);
+
+		  /* set group count and direction */
+		  group_cnt = cnt;
+		  direction = S_BACKWARD;
+		}
+	      else
+		{
+		  /* and compare */
+		  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
+						      inner_valp, inner_domp,
+						      nvals);
+		  if (val_cmp == DB_UNK)
+		    {		/* is error */
+		      goto exit_on_error;
+		    }
+
+		  if (val_cmp == DB_LT)
+		    {
+		      /* move the inner to the previous tuple and
+		         position tuple values */
+		      QEXEC_MERGE_REV_SCAN_PVALS (thread_p, inner);
+
+		      /* and compare */
+		      val_cmp =
+			qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
+						  inner_valp, inner_domp,
+						  nvals);
+		      if (val_cmp == DB_UNK)
+			{	/* is error */
+			  goto exit_on_error;
+			}
+
+		      if (val_cmp == DB_EQ)
+			{
+			  /* next value is the same, so prepare for further
+			     group scan operations */
+
+			  /* set group count and direction */
+			  group_cnt = cnt;
+			  direction = S_BACKWARD;
+			}
+		      else
+			{
+			  /* move the inner to the current tuple and
+			     position tuple values */
+			  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, inner, true);
+
+			  val_cmp = DB_LT;	/* restore comparison */
+			}
+		    }
+
+		  /* comparison has already been done */
+		  already_compared = true;
+		}
+	    }
+	  else
+	    {
+	      /* set further scan direction */
+	      direction = S_BACKWARD;
+	    }
+	}
+      else
+	{			/* (direction == S_BACKWARD) */
+	  /* move backwards within a group
+	   */
+	  cnt = group_cnt;
+	  /* group_cnt has the number of tuples in the group */
+	  while (1)
+	    {
+	      /* merge the fetched tuples(left and right) */
+	      QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec,
 					  &inner_tplrec);
 
+	      cnt--;		/* decrease the counter of the processed tuples */
+
+	      if (cnt <= 0)
+		{
+		  break;	/* finish the group */
+		}
+
+	      /* if not yet reached the top of the group */
+	      /* move the inner(right) scan to the previous tuple */
+	      QEXEC_MERGE_PREV_SCAN (thread_p, inner);
+
+	      /* all of the inner tuples in the group have the same
+	         value at the merge column, so we don't need to
+	         compare with the value of the outer one; just count
+	         the number of the tuples in the group */
+	    }			/* while (1) */
+
+	  /* position tuple values (to merge columns) */
+	  QEXEC_MERGE_PVALS (inner);
+
+	  /* move the outer(left) scan to the next tuple and
+	     position tuple values */
+	  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, outer, true);
+
+	  /* and compare */
+	  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
+					      inner_valp, inner_domp, nvals);
+	  if (val_cmp == DB_UNK)
+	    {			/* is error */
+	      goto exit_on_error;
+	    }
+
+	  if (val_cmp != DB_EQ)
+	    {
+	      /* jump to the previously set scan position */
+	      inner_scan =
+		qfile_jump_scan_tuple_position (thread_p, &inner_sid,
+						&inner_tplpos, &inner_tplrec,
+						PEEK);
+	      /* is saved position the end of scan? */
+	      if (inner_scan == S_END)
+		{
+		  goto exit_on_end;
+		}
+
+	      /* and position tuple values */
+	      QEXEC_MERGE_PVALS (inner);
+
+	      /* reset group count */
+	      group_cnt = 0;
+	    }
+	  else
+	    {
+	      /* comparison has already been done */
+	      already_compared = true;
+	    }
+
+	  /* set further scan direction */
+	  direction = S_FORWARD;
+
+	}			/* (direction == S_BACKWARD) */
+
+    }				/* while (1) */
+
+exit_on_end:
+  free_and_init (type_list.domp);
+  qfile_close_scan (thread_p, &outer_sid);
+  qfile_close_scan (thread_p, &inner_sid);
+
+  if (tplrec.tpl)
+    {
+      db_private_free_and_init (thread_p, tplrec.tpl);
+    }
+
+  if (outer_domp)
+    {
+      db_private_free_and_init (thread_p, outer_domp);
+    }
+  if (outer_valp)
+    {
+      db_private_free_and_init (thread_p, outer_valp);
+    }
+
+  if (inner_domp)
+    {
+      db_private_free_and_init (thread_p, inner_domp);
+    }
+  if (inner_valp)
+    {
+      db_private_free_and_init (thread_p, inner_valp);
+    }
+
+  if (list_idp)
+    {
+      qfile_close_list (thread_p, list_idp);
+    }
+
+  return list_idp;
+
+exit_on_error:
+  if (list_idp)
+    {
+      qfile_close_list (thread_p, list_idp);
+      qfile_free_list_id (list_idp);
+    }
+
+  list_idp = NULL;
+  goto exit_on_end;
+}
+
+/*
+ * qexec_merge_list_outer () -
+ *   return:
+ *   xasl(in)           :
+ *   merge_infop(in)    :
+ *   other_outer_join_pred(in)  :
+ *   xasl_state(in)     :
+ *   ls_flag(in)        :
+ */
+static QFILE_LIST_ID *
+qexec_merge_list_outer (THREAD_ENTRY * thread_p, SCAN_ID * outer_sid,
+			SCAN_ID * inner_sid,
+			QFILE_LIST_MERGE_INFO * merge_infop,
+			PRED_EXPR * other_outer_join_pred,
+			XASL_STATE * xasl_state, int ls_flag)
+{
+  /* outer -> left scan, inner -> right scan */
+
+  /* pre-defined vars: */
+  QFILE_LIST_ID *list_idp = NULL;
+  int nvals;
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  QFILE_TUPLE_RECORD outer_tplrec = { NULL, 0 };
+  QFILE_TUPLE_RECORD inner_tplrec = { NULL, 0 };
+  int *outer_indp, *inner_indp;
+  char **outer_valp = NULL, **inner_valp = NULL;
+  SCAN_CODE outer_scan = S_END, inner_scan = S_END;
+
+  TP_DOMAIN **outer_domp = NULL, **inner_domp = NULL;
+  QFILE_LIST_ID *outer_list_idp, *inner_list_idp;
+  QFILE_TUPLE_VALUE_TYPE_LIST type_list;
+  int k, cnt, group_cnt, merge_cnt, already_compared;
+  SCAN_DIRECTION direction;
+  SCAN_POS inner_scanpos;
+  bool all_lefts, all_rghts;
+  DB_LOGICAL ev_res;
+  DB_VALUE_COMPARE_RESULT val_cmp;
+
+  direction = S_FORWARD;	/* init */
+  val_cmp = DB_NE;		/* init - mark as not yet compared */
+
+  /* determine all lefts or all rights option depending on join type */
+  all_lefts = (merge_infop->join_type == JOIN_LEFT ||
+	       merge_infop->join_type == JOIN_OUTER) ? true : false;
+  all_rghts = (merge_infop->join_type == JOIN_RIGHT ||
+	       merge_infop->join_type == JOIN_OUTER) ? true : false;
+
+  /* QFILE_LIST_ID pointer from SCAN_ID */
+  outer_list_idp = outer_sid->s.llsid.list_id;
+  inner_list_idp = inner_sid->s.llsid.list_id;
+
+  /* get merge columns count */
+  nvals = merge_infop->ls_column_cnt;
+
+  /* get indicator of merge columns */
+  outer_indp = merge_infop->ls_outer_column;
+  inner_indp = merge_infop->ls_inner_column;
+
+  /* form the typelist for the resultant list file */
+  type_list.type_cnt = merge_infop->ls_pos_cnt;
+  type_list.domp = (TP_DOMAIN **) malloc (type_list.type_cnt *
+					  sizeof (TP_DOMAIN *));
+  if (type_list.domp == NULL)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+
+  for (k = 0; k < type_list.type_cnt; k++)
+    {
+      type_list.domp[k] =
+	(merge_infop->ls_outer_inner_list[k] == QFILE_OUTER_LIST)
+	? outer_list_idp->type_list.domp[merge_infop->ls_pos_list[k]]
+	: inner_list_idp->type_list.domp[merge_infop->ls_pos_list[k]];
+    }
+
+  /* open the result list file; same query id with outer(inner) list file */
+  list_idp =
+    qfile_open_list (thread_p, &type_list, NULL, outer_list_idp->query_id,
+		     ls_flag);
+  if (list_idp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  if (all_lefts && outer_list_idp->tuple_cnt == 0)
+    {
+      all_lefts = false;
+      goto exit_on_end;
+    }
+  if (all_rghts && inner_list_idp->tuple_cnt == 0)
+    {
+      all_rghts = false;
+      goto exit_on_end;
+    }
+
+  /* allocate the area to store the merged tuple */
+  if (qfile_reallocate_tuple (&tplrec, DB_PAGESIZE) != NO_ERROR)
+    {
+      goto exit_on_error;
+    }
+
+  /* merge column domain info */
+  outer_domp = (TP_DOMAIN **) db_private_alloc (thread_p,
+						nvals * sizeof (TP_DOMAIN *));
+  if (outer_domp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  inner_domp = (TP_DOMAIN **) db_private_alloc (thread_p,
+						nvals * sizeof (TP_DOMAIN *));
+  if (inner_domp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  for (k = 0; k < nvals; k++)
+    {
+      outer_domp[k] =
+	outer_list_idp->type_list.domp[merge_infop->ls_outer_column[k]];
+      inner_domp[k] =
+	inner_list_idp->type_list.domp[merge_infop->ls_inner_column[k]];
+    }
+
+  /* merge column val pointer */
+  outer_valp = (char **) db_private_alloc (thread_p, nvals * sizeof (char *));
+  if (outer_valp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  inner_valp = (char **) db_private_alloc (thread_p, nvals * sizeof (char *));
+  if (inner_valp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  /* start scans */
+  if (scan_start_scan (thread_p, outer_sid) != NO_ERROR
+      || scan_start_scan (thread_p, inner_sid) != NO_ERROR)
+    {
+      goto exit_on_error;
+    }
+
+  /* set tuple record pointer in QFILE_LIST_SCAN_ID */
+  outer_sid->s.llsid.tplrecp = &outer_tplrec;
+  inner_sid->s.llsid.tplrecp = &inner_tplrec;
+
+
+  /* When a list file is sorted on a column, all the NULL value appear at
+     the beginning of the list. So, we know that all the following values
+     in the outer/inner column are BOUND(not NULL) value. And we can process
+     all NULL values before the merging process. */
+
+  /* move the outer(left) scan to the first tuple */
+  while (1)
+    {
+      /* fetch a next tuple from outer(left) list file and
+         position tuple values (to merge columns) */
+      QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, outer, true);
+
+      if (outer_sid->qualification == QPROC_QUALIFIED)
+	{
+	  for (k = 0; k < nvals; k++)
+	    {
+	      if (QFILE_GET_TUPLE_VALUE_FLAG (outer_valp[k]) == V_UNBOUND)
+		{
+		  break;
+		}
+	    }
+	  if (k >= nvals)
+	    {			/* not found V_UNBOUND */
+	      break;		/* found valid tuple. exit loop */
+	    }
+	}
+
+      /* depending on the join type, join with a NULL opposite row
+         when a NULL or a not-qualified is encountered, or skip it. */
+      if (all_lefts)
+	{
+	  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec, NULL);
+	}
+    }
+
+  /* move the inner(right) scan to the first tuple */
+  while (1)
+    {
+      /* move the inner(right) scan to the first tuple and
+         position tuple values (to merge columns) */
+      QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, inner, true);
+
+      if (inner_sid->qualification == QPROC_QUALIFIED)
+	{
+	  for (k = 0; k < nvals; k++)
+	    {
+	      if (QFILE_GET_TUPLE_VALUE_FLAG (inner_valp[k]) == V_UNBOUND)
+		{
+		  break;
+		}
+	    }
+	  if (k >= nvals)
+	    {			/* not found V_UNBOUND */
+	      break;		/* found valid tuple. exit loop */
+	    }
+	}
+
+      /* depending on the join type, join with a NULL opposite row
+         when a NULL is encountered, or skip it. */
+      if (all_rghts)
+	{
+	  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, NULL, &inner_tplrec);
+	}
+    }
+
+  /* set the comparison function to be called */
+  direction = S_FORWARD;
+  group_cnt = 0;
+  already_compared = false;
+  val_cmp = DB_UNK;
+
+  while (1)
+    {
+      /* compare two tuple values, if they have not been compared yet */
+      if (!already_compared)
+	{
+	  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
+					      inner_valp, inner_domp, nvals);
+	  if (val_cmp == DB_UNK)
+	    {			/* is error */
+	      goto exit_on_error;
+	    }
+	}
+      already_compared = false;	/* re-init */
+
+      /* value of the outer is less than value of the inner */
+      if (val_cmp == DB_LT)
+	{
+	  /* depending on the join type, join with a NULL opposite row
+	     when it does not match */
+	  if (all_lefts)
+	    {
+	      /* merge the fetched tuple(left) and NULL tuple(right) */
+	      QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec, NULL);
+	    }
+
+	  /* move the outer(left) scan to the next tuple and
+	     position tuple values (to merge columns) */
+	  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, outer, true);
+	  direction = S_FORWARD;
+	  group_cnt = 0;
+
+	  continue;
+	}
+
+      /* value of the outer is greater than value of the inner */
+      if (val_cmp == DB_GT)
+	{
+	  /* depending on the join type, join with a NULL opposite row
+	     when a NULL is encountered, or skip it. */
+	  if (all_rghts)
+	    {
+	      /* merge the fetched tuple(right) and NULL tuple(left) */
+	      QEXEC_MERGE_ADD_MERGETUPLE (thread_p, NULL, &inner_tplrec);
+	    }
+
+	  /* move the inner(right) scan to the next tuple and
+	     position tuple values (to merge columns) */
+	  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, inner, true);
+	  direction = S_FORWARD;
+	  group_cnt = 0;
+
+	  continue;
+	}
+
+      if (val_cmp != DB_EQ)
+	{			/* error ? */
+	  goto exit_on_error;
+	}
+
+      /* values of the outer and inner are equal, do a scan group processing
+       */
+      if (direction == S_FORWARD)
+	{
+	  /* move forwards within a group
+	   */
+	  merge_cnt = cnt = 0;
+	  /* group_cnt has the number of tuples in the group */
+	  while (1)
+	    {
+	      /* evaluate other outer join predicate */
+	      ev_res = V_UNKNOWN;
+	      if (other_outer_join_pred != NULL)
+		{
+		  ev_res = eval_pred (thread_p, other_outer_join_pred,
+				      &xasl_state->vd, NULL);
+		  if (ev_res == V_ERROR)
+		    {
+		      goto exit_on_error;
+		    }
+		}
+
+	      /* is qualified */
+	      if (other_outer_join_pred == NULL || ev_res == V_TRUE)
+		{
+		  /* merge the fetched tuples(left and right) */
+		  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec,
+					      &inner_tplrec);
+
+		  merge_cnt++;	/* increase the counter of merged tuples */
+
+		  /* if scan works in a single_fetch mode and first
+		   * qualified scan item has now been fetched,
+		   * return immediately.
+		   */
+		  if (merge_infop->single_fetch == QPROC_SINGLE_OUTER)
+		    {
+		      goto exit_on_end;
+		    }
+		}
+
 	      cnt++;		/* increase the counter of processed tuples */
 
 	      /* if the group is formed for the first time */
 	      if (group_cnt == 0)
 		{
+		  /* not qualified */
+		  if (!(other_outer_join_pred == NULL || ev_res == V_TRUE))
+		    {
+		      /* depending on the join type, join with a NULL
+		         opposite row when a NULL or a not-qualified is
+		         encountered, or skip it. */
+		      if (all_rghts)
+			{
+			  /* merge the fetched tuple(right) and NULL
+			     tuple(left) */
+			  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, NULL,
+						      &inner_tplrec);
+			}
+		    }
+
 		  /* move the inner(right) scan to the next tuple and
 		     position tuple values (to merge columns) */
-		  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, inner,
-					       false /* do not exit */ );
+		  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, inner, false	/* do not exit */
+		    );
 		  if (inner_scan == S_END)
 		    {
+		      if (merge_cnt == 0)
+			{	/* not merged */
+			  /* depending on the join type, join with a NULL
+			     opposite row when a NULL or a not-qualified is
+			     encountered, or skip it. */
+			  if (all_lefts)
+			    {
+			      /* merge the fetched tuple(left) and NULL
+			         tuple(right) */
+			      QEXEC_MERGE_ADD_MERGETUPLE (thread_p,
+							  &outer_tplrec,
+							  NULL);
+			    }
+			}
 		      break;
 		    }
 
@@ -4045,6 +5779,21 @@ qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
 			  goto exit_on_error;
 			}
 
+		      if (merge_cnt == 0)
+			{	/* not merged */
+			  /* depending on the join type, join with a NULL
+			     opposite row when a NULL or a not-qualified is
+			     encountered, or skip it. */
+			  if (all_lefts)
+			    {
+			      /* merge the fetched tuple(left) and NULL
+			         tuple(right) */
+			      QEXEC_MERGE_ADD_MERGETUPLE (thread_p,
+							  &outer_tplrec,
+							  NULL);
+			    }
+			}
+
 		      break;	/* found the bottom of the group */
 		    }
 		}
@@ -4056,26 +5805,25 @@ qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
 		    }
 
 		  /* move the inner(right) scan to the next tuple */
-		  QEXEC_MERGE_NEXT_SCAN (thread_p, inner, true);
+		  QEXEC_MERGE_OUTER_NEXT_SCAN (thread_p, inner, true);
 		}
 	    }			/* while (1) */
 
 	  /* move the outer to the next tuple and position tuple values */
-	  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, outer, true);
+	  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, outer, true);
 
 	  /* if the group is formed for the first time */
 	  if (group_cnt == 0)
 	    {
 	      /* save the position of inner scan;
 	         it is the bottom of the group */
-	      qfile_save_current_scan_tuple_position (&inner_sid,
-						      &inner_tplpos);
+	      scan_save_scan_pos (inner_sid, &inner_scanpos);
 
 	      if (inner_scan == S_END)
 		{
 		  /* move the inner to the previous tuple and
 		     position tuple values */
-		  QEXEC_MERGE_REV_SCAN_PVALS (thread_p, inner);
+		  QEXEC_MERGE_OUTER_PREV_SCAN_PVALS (thread_p, inner);
 
 		  /* set group count and direction */
 		  group_cnt = cnt;
@@ -4096,7 +5844,7 @@ qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
 		    {
 		      /* move the inner to the previous tuple and
 		         position tuple values */
-		      QEXEC_MERGE_REV_SCAN_PVALS (thread_p, inner);
+		      QEXEC_MERGE_OUTER_PREV_SCAN_PVALS (thread_p, inner);
 
 		      /* and compare */
 		      val_cmp =
@@ -4121,7 +5869,8 @@ qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
 			{
 			  /* move the inner to the current tuple and
 			     position tuple values */
-			  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, inner, true);
+			  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, inner,
+							     true);
 
 			  val_cmp = DB_LT;	/* restore comparison */
 			}
@@ -4145,9 +5894,25 @@ qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
 	  /* group_cnt has the number of tuples in the group */
 	  while (1)
 	    {
-	      /* merge the fetched tuples(left and right) */
-	      QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec,
-					  &inner_tplrec);
+	      /* evaluate other outer join predicate */
+	      ev_res = V_UNKNOWN;
+	      if (other_outer_join_pred != NULL)
+		{
+		  ev_res = eval_pred (thread_p, other_outer_join_pred,
+				      &xasl_state->vd, NULL);
+		  if (ev_res == V_ERROR)
+		    {
+		      goto exit_on_error;
+		    }
+		}
+
+	      /* is qualified */
+	      if (other_outer_join_pred == NULL || ev_res == V_TRUE)
+		{
+		  /* merge the fetched tuples(left and right) */
+		  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec,
+					      &inner_tplrec);
+		}
 
 	      cnt--;		/* decrease the counter of the processed tuples */
 
@@ -4158,7 +5923,7 @@ qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
 
 	      /* if not yet reached the top of the group */
 	      /* move the inner(right) scan to the previous tuple */
-	      QEXEC_MERGE_PREV_SCAN (thread_p, inner);
+	      QEXEC_MERGE_OUTER_PREV_SCAN (thread_p, inner);
 
 	      /* all of the inner tuples in the group have the same
 	         value at the merge column, so we don't need to
@@ -4171,7 +5936,7 @@ qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
 
 	  /* move the outer(left) scan to the next tuple and
 	     position tuple values */
-	  QEXEC_MERGE_NEXT_SCAN_PVALS (thread_p, outer, true);
+	  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, outer, true);
 
 	  /* and compare */
 	  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
@@ -4185,13 +5950,11 @@ qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
 	    {
 	      /* jump to the previously set scan position */
 	      inner_scan =
-		qfile_jump_scan_tuple_position (thread_p, &inner_sid,
-						&inner_tplpos, &inner_tplrec,
-						PEEK);
+		scan_jump_scan_pos (thread_p, inner_sid, &inner_scanpos);
 	      /* is saved position the end of scan? */
 	      if (inner_scan == S_END)
 		{
-		  goto exit_on_end;
+		  goto exit_on_end;	/* inner(right) is exhausted */
 		}
 
 	      /* and position tuple values */
@@ -4211,12 +5974,58 @@ qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
 
 	}			/* (direction == S_BACKWARD) */
 
-    }				/* while (1) */
+    }				/* while (1) */
+
+exit_on_end:
+  /* inner(right) is at the end. is there more to the outer(left) ? */
+  if (all_lefts)
+    {
+      while (outer_scan != S_END)
+	{
+	  /* merge the fetched tuple(left) and NULL tuple(right) */
+	  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec, NULL);
+
+	  /* move the outer to the next tuple */
+	  QEXEC_MERGE_OUTER_NEXT_SCAN (thread_p, outer,
+				       false /* do not exit */ );
+	}
+    }				/* if (all_lefts) */
+
+  /* outer(left) is at the end. is there more to the inner(right) ? */
+  if (all_rghts)
+    {
+      if (direction == S_FORWARD)
+	{
+	  if (val_cmp == DB_NE)
+	    {			/* mark as not yet compared */
+	      val_cmp = DB_UNK;	/* clear */
+
+	      /* move the inner(right) scan to the first tuple and
+	         position tuple values (to merge columns) */
+	      QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, inner, true);
+	    }
+	}
+      else
+	{			/* direction == S_BACKWARD */
+	  inner_scan =
+	    scan_jump_scan_pos (thread_p, inner_sid, &inner_scanpos);
+	}
+      while (inner_scan != S_END)
+	{
+	  /* merge the fetched tuple(right) and NULL tuple(left) */
+	  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, NULL, &inner_tplrec);
+
+	  /* move the inner to the next tuple */
+	  QEXEC_MERGE_OUTER_NEXT_SCAN (thread_p, inner,
+				       false /* do not exit */ );
+	}
+    }				/* if (all_rghts) */
 
-exit_on_end:
   free_and_init (type_list.domp);
-  qfile_close_scan (thread_p, &outer_sid);
-  qfile_close_scan (thread_p, &inner_sid);
+  scan_end_scan (thread_p, outer_sid);
+  scan_end_scan (thread_p, inner_sid);
+  outer_sid->s.llsid.tplrecp = NULL;
+  inner_sid->s.llsid.tplrecp = NULL;
 
   if (tplrec.tpl)
     {
@@ -4256,653 +6065,911 @@ exit_on_error:
     }
 
   list_idp = NULL;
+
+  direction = S_FORWARD;
+  val_cmp = DB_UNK;		/* mark as error */
+  all_lefts = all_rghts = false;
+
   goto exit_on_end;
 }
 
 /*
- * qexec_merge_list_outer () -
- *   return:
- *   xasl(in)           :
- *   merge_infop(in)    :
- *   other_outer_join_pred(in)  :
- *   xasl_state(in)     :
- *   ls_flag(in)        :
+ * qexec_hash_join_type () - Decide how a pair of join columns is hashed
+ *   return: the type the column values are hashed as, or DB_TYPE_NULL
+ *   outer_domp(in)     : outer join column domain
+ *   inner_domp(in)     : inner join column domain
+ *
+ * Note: Values that compare equal must hash equal. The integer types and
+ * the fixed/variable character types are hashed in a common form; any
+ * other pair must have the very same type. A column returning DB_TYPE_NULL
+ * does not contribute to the hash key and is only checked on the probe.
  */
-static QFILE_LIST_ID *
-qexec_merge_list_outer (THREAD_ENTRY * thread_p, SCAN_ID * outer_sid,
-			SCAN_ID * inner_sid,
-			QFILE_LIST_MERGE_INFO * merge_infop,
-			PRED_EXPR * other_outer_join_pred,
-			XASL_STATE * xasl_state, int ls_flag)
+static DB_TYPE
+qexec_hash_join_type (TP_DOMAIN * outer_domp, TP_DOMAIN * inner_domp)
 {
-  /* outer -> left scan, inner -> right scan */
-
-  /* pre-defined vars: */
-  QFILE_LIST_ID *list_idp = NULL;
-  int nvals;
-  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
-  QFILE_TUPLE_RECORD outer_tplrec = { NULL, 0 };
-  QFILE_TUPLE_RECORD inner_tplrec = { NULL, 0 };
-  int *outer_indp, *inner_indp;
-  char **outer_valp = NULL, **inner_valp = NULL;
-  SCAN_CODE outer_scan = S_END, inner_scan = S_END;
-
-  TP_DOMAIN **outer_domp = NULL, **inner_domp = NULL;
-  QFILE_LIST_ID *outer_list_idp, *inner_list_idp;
-  QFILE_TUPLE_VALUE_TYPE_LIST type_list;
-  int k, cnt, group_cnt, merge_cnt, already_compared;
-  SCAN_DIRECTION direction;
-  SCAN_POS inner_scanpos;
-  bool all_lefts, all_rghts;
-  DB_LOGICAL ev_res;
-  DB_VALUE_COMPARE_RESULT val_cmp;
-
-  direction = S_FORWARD;	/* init */
-  val_cmp = DB_NE;		/* init - mark as not yet compared */
-
-  /* determine all lefts or all rights option depending on join type */
-  all_lefts = (merge_infop->join_type == JOIN_LEFT ||
-	       merge_infop->join_type == JOIN_OUTER) ? true : false;
-  all_rghts = (merge_infop->join_type == JOIN_RIGHT ||
-	       merge_infop->join_type == JOIN_OUTER) ? true : false;
-
-  /* QFILE_LIST_ID pointer from SCAN_ID */
-  outer_list_idp = outer_sid->s.llsid.list_id;
-  inner_list_idp = inner_sid->s.llsid.list_id;
-
-  /* get merge columns count */
-  nvals = merge_infop->ls_column_cnt;
+  DB_TYPE type[2];
+  int i;
 
-  /* get indicator of merge columns */
-  outer_indp = merge_infop->ls_outer_column;
-  inner_indp = merge_infop->ls_inner_column;
+  type[0] = outer_domp->type->id;
+  type[1] = inner_domp->type->id;
 
-  /* form the typelist for the resultant list file */
-  type_list.type_cnt = merge_infop->ls_pos_cnt;
-  type_list.domp = (TP_DOMAIN **) malloc (type_list.type_cnt *
-					  sizeof (TP_DOMAIN *));
-  if (type_list.domp == NULL)
+  for (i = 0; i < 2; i++)
     {
-      GOTO_EXIT_ON_ERROR;
+      switch (type[i])
+	{
+	case DB_TYPE_SHORT:
+	case DB_TYPE_INTEGER:
+	case DB_TYPE_BIGINT:
+	  type[i] = DB_TYPE_BIGINT;
+	  break;
+	case DB_TYPE_CHAR:
+	case DB_TYPE_VARCHAR:
+	  type[i] = DB_TYPE_VARCHAR;
+	  break;
+	case DB_TYPE_NCHAR:
+	case DB_TYPE_VARNCHAR:
+	  type[i] = DB_TYPE_VARNCHAR;
+	  break;
+	case DB_TYPE_FLOAT:
+	case DB_TYPE_DOUBLE:
+	case DB_TYPE_MONETARY:
+	case DB_TYPE_DATE:
+	case DB_TYPE_TIME:
+	case DB_TYPE_TIMESTAMP:
+	case DB_TYPE_DATETIME:
+	case DB_TYPE_NUMERIC:
+	  break;
+	default:
+	  return DB_TYPE_NULL;
+	}
     }
 
-  for (k = 0; k < type_list.type_cnt; k++)
+  if (type[0] != type[1])
     {
-      type_list.domp[k] =
-	(merge_infop->ls_outer_inner_list[k] == QFILE_OUTER_LIST)
-	? outer_list_idp->type_list.domp[merge_infop->ls_pos_list[k]]
-	: inner_list_idp->type_list.domp[merge_infop->ls_pos_list[k]];
+      return DB_TYPE_NULL;
     }
 
-  /* open the result list file; same query id with outer(inner) list file */
-  list_idp =
-    qfile_open_list (thread_p, &type_list, NULL, outer_list_idp->query_id,
-		     ls_flag);
-  if (list_idp == NULL)
+  /* numerics of different scales have different representations */
+  if (type[0] == DB_TYPE_NUMERIC && outer_domp->scale != inner_domp->scale)
     {
-      goto exit_on_error;
+      return DB_TYPE_NULL;
     }
 
-  if (all_lefts && outer_list_idp->tuple_cnt == 0)
-    {
-      all_lefts = false;
-      goto exit_on_end;
-    }
-  if (all_rghts && inner_list_idp->tuple_cnt == 0)
-    {
-      all_rghts = false;
-      goto exit_on_end;
-    }
+  return type[0];
+}
 
-  /* allocate the area to store the merged tuple */
-  if (qfile_reallocate_tuple (&tplrec, DB_PAGESIZE) != NO_ERROR)
-    {
-      goto exit_on_error;
-    }
+/*
+ * qexec_hash_join_bytes () - Fold a byte string into a hash key
+ *   return: the new hash key
+ *   hash_key(in)       : hash key so far
+ *   bytes(in)          :
+ *   size(in)           :
+ */
+static unsigned int
+qexec_hash_join_bytes (unsigned int hash_key, const char *bytes, int size)
+{
+  int i;
 
-  /* merge column domain info */
-  outer_domp = (TP_DOMAIN **) db_private_alloc (thread_p,
-						nvals * sizeof (TP_DOMAIN *));
-  if (outer_domp == NULL)
+  for (i = 0; i < size; i++)
     {
-      goto exit_on_error;
+      hash_key = (hash_key ^ (unsigned char) bytes[i]) * 16777619;
     }
 
-  inner_domp = (TP_DOMAIN **) db_private_alloc (thread_p,
-						nvals * sizeof (TP_DOMAIN *));
-  if (inner_domp == NULL)
+  return hash_key;
+}
+
+/*
+ * qexec_hash_join_value () - Hash a join column value of a tuple
+ *   return: NO_ERROR, or ER_code
+ *   tval(in)   : tuple value
+ *   domp(in)   : domain of the value
+ *   hash_type(in)      : how to hash the value
+ *   hash_key(out)      : hash key of the value
+ *   is_null(out)       : true if the value is NULL
+ */
+static int
+qexec_hash_join_value (char *tval, TP_DOMAIN * domp, DB_TYPE hash_type,
+		       unsigned int *hash_key, bool * is_null)
+{
+  OR_BUF buf;
+  DB_VALUE dbval;
+  DB_BIGINT bigint;
+  double dbl;
+  char *str;
+  int len;
+
+  *hash_key = 0;
+  *is_null = false;
+
+  /* zero length means NULL */
+  len = QFILE_GET_TUPLE_VALUE_LENGTH (tval);
+  if (len == 0)
     {
-      goto exit_on_error;
+      *is_null = true;
+      return NO_ERROR;
     }
 
-  for (k = 0; k < nvals; k++)
+  if (hash_type == DB_TYPE_NULL)
     {
-      outer_domp[k] =
-	outer_list_idp->type_list.domp[merge_infop->ls_outer_column[k]];
-      inner_domp[k] =
-	inner_list_idp->type_list.domp[merge_infop->ls_inner_column[k]];
+      /* not hashed; no need to read the value */
+      return NO_ERROR;
     }
 
-  /* merge column val pointer */
-  outer_valp = (char **) db_private_alloc (thread_p, nvals * sizeof (char *));
-  if (outer_valp == NULL)
+  or_init (&buf, (char *) (tval + QFILE_TUPLE_VALUE_HEADER_SIZE), len);
+  /* Do not copy the string--just use the pointer. */
+  if ((*(domp->type->readval)) (&buf, &dbval, domp, -1,
+				pr_is_set_type (domp->type->id) ? true :
+				false, NULL, 0) != NO_ERROR)
     {
-      goto exit_on_error;
+      return ER_FAILED;
     }
 
-  inner_valp = (char **) db_private_alloc (thread_p, nvals * sizeof (char *));
-  if (inner_valp == NULL)
+  if (DB_IS_NULL (&dbval))
     {
-      goto exit_on_error;
+      *is_null = true;
+      return NO_ERROR;
     }
 
-  /* start scans */
-  if (scan_start_scan (thread_p, outer_sid) != NO_ERROR
-      || scan_start_scan (thread_p, inner_sid) != NO_ERROR)
+  switch (hash_type)
     {
-      goto exit_on_error;
+    case DB_TYPE_BIGINT:
+      switch (DB_VALUE_TYPE (&dbval))
+	{
+	case DB_TYPE_SHORT:
+	  bigint = DB_GET_SHORT (&dbval);
+	  break;
+	case DB_TYPE_INTEGER:
+	  bigint = DB_GET_INTEGER (&dbval);
+	  break;
+	default:
+	  bigint = DB_GET_BIGINT (&dbval);
+	  break;
+	}
+      *hash_key = qexec_hash_join_bytes (2166136261u, (char *) &bigint,
+					 sizeof (bigint));
+      break;
+
+    case DB_TYPE_VARCHAR:
+    case DB_TYPE_VARNCHAR:
+      /* trailing blanks are not significant to the comparison */
+      str = DB_GET_STRING (&dbval);
+      len = DB_GET_STRING_SIZE (&dbval);
+      while (len > 0 && str[len - 1] == ' ')
+	{
+	  len--;
+	}
+      *hash_key = qexec_hash_join_bytes (2166136261u, str, len);
+      break;
+
+    case DB_TYPE_NUMERIC:
+      /* of the same scale, as decided by qexec_hash_join_type () */
+      *hash_key = qexec_hash_join_bytes (2166136261u,
+					 (char *) DB_GET_NUMERIC (&dbval),
+					 DB_NUMERIC_BUF_SIZE);
+      break;
+
+    case DB_TYPE_FLOAT:
+    case DB_TYPE_DOUBLE:
+    case DB_TYPE_MONETARY:
+      if (hash_type == DB_TYPE_FLOAT)
+	{
+	  dbl = DB_GET_FLOAT (&dbval);
+	}
+      else if (hash_type == DB_TYPE_DOUBLE)
+	{
+	  dbl = DB_GET_DOUBLE (&dbval);
+	}
+      else
+	{
+	  dbl = DB_GET_MONETARY (&dbval)->amount;
+	}
+      if (dbl == 0.0)
+	{
+	  /* -0.0 compares equal to 0.0 */
+	  dbl = 0.0;
+	}
+      *hash_key = qexec_hash_join_bytes (2166136261u, (char *) &dbl,
+					 sizeof (dbl));
+      break;
+
+    default:
+      *hash_key = mht_valhash (&dbval, 0xFFFFFFFF);
+      break;
     }
 
-  /* set tuple record pointer in QFILE_LIST_SCAN_ID */
-  outer_sid->s.llsid.tplrecp = &outer_tplrec;
-  inner_sid->s.llsid.tplrecp = &inner_tplrec;
+  pr_clear_value (&dbval);
 
+  return NO_ERROR;
+}
 
-  /* When a list file is sorted on a column, all the NULL value appear at
-     the beginning of the list. So, we know that all the following values
-     in the outer/inner column are BOUND(not NULL) value. And we can process
-     all NULL values before the merging process. */
+/*
+ * qexec_hash_join_key () - Hash the join columns of a tuple
+ *   return: NO_ERROR, or ER_code
+ *   info(in)   : hash join information
+ *   tpl(in)    : tuple
+ *   columns(in)        : join column positions within the tuple
+ *   domp(in)   : join column domains
+ *   valp(out)  : join column values within the tuple
+ *   hash_key(out)      : hash key of the tuple
+ *   is_null(out)       : true if any join column is NULL
+ *
+ * Note: A tuple having a NULL join column never joins.
+ */
+static int
+qexec_hash_join_key (HASH_JOIN_INFO * info, QFILE_TUPLE tpl, int *columns,
+		     TP_DOMAIN ** domp, char **valp, unsigned int *hash_key,
+		     bool * is_null)
+{
+  unsigned int col_hash_key;
+  int k;
 
-  /* move the outer(left) scan to the first tuple */
-  while (1)
-    {
-      /* fetch a next tuple from outer(left) list file and
-         position tuple values (to merge columns) */
-      QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, outer, true);
+  *hash_key = 0;
+  *is_null = false;
 
-      if (outer_sid->qualification == QPROC_QUALIFIED)
+  for (k = 0; k < info->nvals; k++)
+    {
+      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tpl, columns[k], valp[k]);
+      if (qexec_hash_join_value (valp[k], domp[k], info->hash_type[k],
+				 &col_hash_key, is_null) != NO_ERROR)
 	{
-	  for (k = 0; k < nvals; k++)
-	    {
-	      if (QFILE_GET_TUPLE_VALUE_FLAG (outer_valp[k]) == V_UNBOUND)
-		{
-		  break;
-		}
-	    }
-	  if (k >= nvals)
-	    {			/* not found V_UNBOUND */
-	      break;		/* found valid tuple. exit loop */
-	    }
+	  return ER_FAILED;
 	}
-
-      /* depending on the join type, join with a NULL opposite row
-         when a NULL or a not-qualified is encountered, or skip it. */
-      if (all_lefts)
+      if (*is_null)
 	{
-	  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec, NULL);
+	  return NO_ERROR;
 	}
+
+      *hash_key = *hash_key * 31 + col_hash_key;
     }
 
-  /* move the inner(right) scan to the first tuple */
-  while (1)
-    {
-      /* move the inner(right) scan to the first tuple and
-         position tuple values (to merge columns) */
-      QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, inner, true);
+  return NO_ERROR;
+}
 
-      if (inner_sid->qualification == QPROC_QUALIFIED)
-	{
-	  for (k = 0; k < nvals; k++)
-	    {
-	      if (QFILE_GET_TUPLE_VALUE_FLAG (inner_valp[k]) == V_UNBOUND)
-		{
-		  break;
-		}
-	    }
-	  if (k >= nvals)
-	    {			/* not found V_UNBOUND */
-	      break;		/* found valid tuple. exit loop */
-	    }
-	}
+/*
+ * qexec_hash_join_seed () - Mix a hash key with the seed of a level
+ *   return: hash key of the level
+ *   hash_key(in)       : hash key of the join columns
+ *   level(in)  : partitioning level
+ *
+ * Note: Each partitioning level, and the hash table built below the last
+ * one, uses its own seed, so that the tuples gathered in one partition
+ * spread over all the partitions (or buckets) of the next level.
+ */
+static unsigned int
+qexec_hash_join_seed (unsigned int hash_key, int level)
+{
+  hash_key ^= 0x9e3779b9u * (unsigned int) (level + 1);
+  hash_key ^= hash_key >> 16;
+  hash_key *= 0x85ebca6bu;
+  hash_key ^= hash_key >> 13;
+  hash_key *= 0xc2b2ae35u;
+  hash_key ^= hash_key >> 16;
+
+  return hash_key;
+}
 
-      /* depending on the join type, join with a NULL opposite row
-         when a NULL is encountered, or skip it. */
-      if (all_rghts)
+/*
+ * qexec_hash_join_split () - Split a list file into hash partitions
+ *   return: NO_ERROR, or ER_code
+ *   info(in)   : hash join information
+ *   list_idp(in)       : list file to split
+ *   is_outer(in)       : true for the outer (probe) list file
+ *   level(in)  : partitioning level
+ *   nparts(in) : partitions count
+ *   part_list_idp(out) : partition list files
+ *
+ * Note: Tuples are spilled into partitions by their hash key so that
+ * joining tuples land in partitions of the same number. Tuples having a
+ * NULL join column are dropped, except the outer ones of a left outer join
+ * which still have to be emitted.
+ */
+static int
+qexec_hash_join_split (THREAD_ENTRY * thread_p, HASH_JOIN_INFO * info,
+		       QFILE_LIST_ID * list_idp, bool is_outer, int level,
+		       int nparts, QFILE_LIST_ID ** part_list_idp)
+{
+  QFILE_LIST_SCAN_ID sid;
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  SCAN_CODE scan;
+  unsigned int hash_key;
+  bool is_null;
+  int *columns;
+  TP_DOMAIN **domp;
+  char **valp;
+  int i;
+
+  columns = (is_outer) ? info->merge_infop->ls_outer_column
+    : info->merge_infop->ls_inner_column;
+  domp = (is_outer) ? info->outer_domp : info->inner_domp;
+  valp = (is_outer) ? info->outer_valp : info->inner_valp;
+
+  for (i = 0; i < nparts; i++)
+    {
+      part_list_idp[i] = qfile_open_list (thread_p, &list_idp->type_list,
+					  NULL, list_idp->query_id,
+					  QFILE_FLAG_ALL);
+      if (part_list_idp[i] == NULL)
 	{
-	  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, NULL, &inner_tplrec);
+	  return ER_FAILED;
 	}
     }
 
-  /* set the comparison function to be called */
-  direction = S_FORWARD;
-  group_cnt = 0;
-  already_compared = false;
-  val_cmp = DB_UNK;
+  if (qfile_open_list_scan (list_idp, &sid) != NO_ERROR)
+    {
+      return ER_FAILED;
+    }
 
-  while (1)
+  while ((scan = qfile_scan_list_next (thread_p, &sid, &tplrec, PEEK))
+	 == S_SUCCESS)
     {
-      /* compare two tuple values, if they have not been compared yet */
-      if (!already_compared)
+      if (qexec_hash_join_key (info, tplrec.tpl, columns, domp, valp,
+			       &hash_key, &is_null) != NO_ERROR)
 	{
-	  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
-					      inner_valp, inner_domp, nvals);
-	  if (val_cmp == DB_UNK)
-	    {			/* is error */
-	      goto exit_on_error;
-	    }
+	  scan = S_ERROR;
+	  break;
 	}
-      already_compared = false;	/* re-init */
 
-      /* value of the outer is less than value of the inner */
-      if (val_cmp == DB_LT)
+      if (is_null)
 	{
-	  /* depending on the join type, join with a NULL opposite row
-	     when it does not match */
-	  if (all_lefts)
+	  if (!is_outer || info->merge_infop->join_type != JOIN_LEFT)
 	    {
-	      /* merge the fetched tuple(left) and NULL tuple(right) */
-	      QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec, NULL);
+	      continue;
 	    }
-
-	  /* move the outer(left) scan to the next tuple and
-	     position tuple values (to merge columns) */
-	  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, outer, true);
-	  direction = S_FORWARD;
-	  group_cnt = 0;
-
-	  continue;
+	  hash_key = 0;
 	}
 
-      /* value of the outer is greater than value of the inner */
-      if (val_cmp == DB_GT)
+      i = qexec_hash_join_seed (hash_key, level) % nparts;
+      if (qfile_add_tuple_to_list (thread_p, part_list_idp[i],
+				   tplrec.tpl) != NO_ERROR)
 	{
-	  /* depending on the join type, join with a NULL opposite row
-	     when a NULL is encountered, or skip it. */
-	  if (all_rghts)
-	    {
-	      /* merge the fetched tuple(right) and NULL tuple(left) */
-	      QEXEC_MERGE_ADD_MERGETUPLE (thread_p, NULL, &inner_tplrec);
-	    }
-
-	  /* move the inner(right) scan to the next tuple and
-	     position tuple values (to merge columns) */
-	  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, inner, true);
-	  direction = S_FORWARD;
-	  group_cnt = 0;
-
-	  continue;
-	}
-
-      if (val_cmp != DB_EQ)
-	{			/* error ? */
-	  goto exit_on_error;
+	  scan = S_ERROR;
+	  break;
 	}
+    }
 
-      /* values of the outer and inner are equal, do a scan group processing
-       */
-      if (direction == S_FORWARD)
-	{
-	  /* move forwards within a group
-	   */
-	  merge_cnt = cnt = 0;
-	  /* group_cnt has the number of tuples in the group */
-	  while (1)
-	    {
-	      /* evaluate other outer join predicate */
-	      ev_res = V_UNKNOWN;
-	      if (other_outer_join_pred != NULL)
-		{
-		  ev_res = eval_pred (thread_p, other_outer_join_pred,
-				      &xasl_state->vd, NULL);
-		  if (ev_res == V_ERROR)
-		    {
-		      goto exit_on_error;
-		    }
-		}
-
-	      /* is qualified */
-	      if (other_outer_join_pred == NULL || ev_res == V_TRUE)
-		{
-		  /* merge the fetched tuples(left and right) */
-		  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec,
-					      &inner_tplrec);
-
-		  merge_cnt++;	/* increase the counter of merged tuples */
-
-		  /* if scan works in a single_fetch mode and first
-		   * qualified scan item has now been fetched,
-		   * return immediately.
-		   */
-		  if (merge_infop->single_fetch == QPROC_SINGLE_OUTER)
-		    {
-		      goto exit_on_end;
-		    }
-		}
+  qfile_close_scan (thread_p, &sid);
 
-	      cnt++;		/* increase the counter of processed tuples */
+  for (i = 0; i < nparts; i++)
+    {
+      qfile_close_list (thread_p, part_list_idp[i]);
+    }
 
-	      /* if the group is formed for the first time */
-	      if (group_cnt == 0)
-		{
-		  /* not qualified */
-		  if (!(other_outer_join_pred == NULL || ev_res == V_TRUE))
-		    {
-		      /* depending on the join type, join with a NULL
-		         opposite row when a NULL or a not-qualified is
-		         encountered, or skip it. */
-		      if (all_rghts)
-			{
-			  /* merge the fetched tuple(right) and NULL
-			     tuple(left) */
-			  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, NULL,
-						      &inner_tplrec);
-			}
-		    }
+  return (scan == S_END) ? NO_ERROR : ER_FAILED;
+}
 
-		  /* move the inner(right) scan to the next tuple and
-		     position tuple values (to merge columns) */
-		  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, inner, false	/* do not exit */
-		    );
-		  if (inner_scan == S_END)
-		    {
-		      if (merge_cnt == 0)
-			{	/* not merged */
-			  /* depending on the join type, join with a NULL
-			     opposite row when a NULL or a not-qualified is
-			     encountered, or skip it. */
-			  if (all_lefts)
-			    {
-			      /* merge the fetched tuple(left) and NULL
-			         tuple(right) */
-			      QEXEC_MERGE_ADD_MERGETUPLE (thread_p,
-							  &outer_tplrec,
-							  NULL);
-			    }
-			}
-		      break;
-		    }
+/*
+ * qexec_hash_join_partition () - Hash join a pair of list files
+ *   return: NO_ERROR, or ER_code
+ *   info(in)   : hash join information
+ *   outer_list_idp(in) : outer (probe) list file
+ *   inner_list_idp(in) : inner (build) list file
+ *   level(in)  : partitioning level
+ *   list_idp(in)       : result list file
+ *   tplrec(in) : area to form a big merged tuple
+ *
+ * Note: The inner tuples are loaded into an in-memory hash table which is
+ * then probed by every outer tuple. The joined tuples are added to the
+ * result list file; for a left outer join, the outer tuples without any
+ * match are added with unbound inner columns.
+ * The hash table never holds more than one sort buffer of inner tuples.
+ * When the inner list file does not fit, it is loaded one sort buffer at a
+ * time and the outer list file is probed once per load; for a left outer
+ * join, a bitmap then remembers which outer tuples found a match.
+ */
+static int
+qexec_hash_join_partition (THREAD_ENTRY * thread_p, HASH_JOIN_INFO * info,
+			   QFILE_LIST_ID * outer_list_idp,
+			   QFILE_LIST_ID * inner_list_idp, int level,
+			   QFILE_LIST_ID * list_idp,
+			   QFILE_TUPLE_RECORD * tplrec)
+{
+  QFILE_LIST_MERGE_INFO *merge_infop = info->merge_infop;
+  QFILE_LIST_SCAN_ID outer_sid, inner_sid;
+  QFILE_TUPLE_RECORD outer_tplrec = { NULL, 0 };
+  QFILE_TUPLE_RECORD inner_tplrec = { NULL, 0 };
+  HASH_JOIN_ENTRY **buckets = NULL;
+  HASH_JOIN_ENTRY *entry;
+  SCAN_CODE scan;
+  DB_VALUE_COMPARE_RESULT val_cmp;
+  unsigned int hash_key;
+  unsigned char *matched = NULL;
+  size_t mem_size, max_mem_size;
+  int nbuckets = 0, nentries, tpl_len, outer_idx, k;
+  bool is_null, is_matched, is_last_load;
+  int error = NO_ERROR;
 
-		  /* and compare */
-		  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp,
-						      outer_domp,
-						      inner_valp,
-						      inner_domp, nvals);
-		  if (val_cmp != DB_EQ)
-		    {
-		      if (val_cmp == DB_UNK)
-			{	/* is error */
-			  goto exit_on_error;
-			}
+  outer_sid.status = S_CLOSED;
+  inner_sid.status = S_CLOSED;
 
-		      if (merge_cnt == 0)
-			{	/* not merged */
-			  /* depending on the join type, join with a NULL
-			     opposite row when a NULL or a not-qualified is
-			     encountered, or skip it. */
-			  if (all_lefts)
-			    {
-			      /* merge the fetched tuple(left) and NULL
-			         tuple(right) */
-			      QEXEC_MERGE_ADD_MERGETUPLE (thread_p,
-							  &outer_tplrec,
-							  NULL);
-			    }
-			}
+  if (outer_list_idp->tuple_cnt == 0
+      || (inner_list_idp->tuple_cnt == 0
+	  && merge_infop->join_type == JOIN_INNER))
+    {
+      return NO_ERROR;
+    }
 
-		      break;	/* found the bottom of the group */
-		    }
-		}
-	      else
-		{		/* group_cnt > 0 */
-		  if (cnt >= group_cnt)
-		    {
-		      break;	/* reached the bottom of the group */
-		    }
+  max_mem_size = (size_t) PRM_SR_NBUFFERS * DB_PAGESIZE;
 
-		  /* move the inner(right) scan to the next tuple */
-		  QEXEC_MERGE_OUTER_NEXT_SCAN (thread_p, inner, true);
-		}
-	    }			/* while (1) */
+  nbuckets = (int) MIN ((size_t) MAX (inner_list_idp->tuple_cnt, 1),
+			max_mem_size / sizeof (HASH_JOIN_ENTRY));
+  buckets = (HASH_JOIN_ENTRY **) db_private_alloc (thread_p,
+						   nbuckets *
+						   sizeof (HASH_JOIN_ENTRY *));
+  if (buckets == NULL)
+    {
+      goto exit_on_error;
+    }
+  memset (buckets, 0, nbuckets * sizeof (HASH_JOIN_ENTRY *));
 
-	  /* move the outer to the next tuple and position tuple values */
-	  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, outer, true);
+  if (qfile_open_list_scan (inner_list_idp, &inner_sid) != NO_ERROR)
+    {
+      goto exit_on_error;
+    }
 
-	  /* if the group is formed for the first time */
-	  if (group_cnt == 0)
+  do
+    {
+      /* build the hash table on the next sort buffer of inner tuples */
+      mem_size = 0;
+      nentries = 0;
+      scan = S_SUCCESS;
+      while (mem_size < max_mem_size
+	     && (scan = qfile_scan_list_next (thread_p, &inner_sid,
+					      &inner_tplrec,
+					      PEEK)) == S_SUCCESS)
+	{
+	  if (qexec_hash_join_key (info, inner_tplrec.tpl,
+				   merge_infop->ls_inner_column,
+				   info->inner_domp, info->inner_valp,
+				   &hash_key, &is_null) != NO_ERROR)
 	    {
-	      /* save the position of inner scan;
-	         it is the bottom of the group */
-	      scan_save_scan_pos (inner_sid, &inner_scanpos);
-
-	      if (inner_scan == S_END)
-		{
-		  /* move the inner to the previous tuple and
-		     position tuple values */
-		  QEXEC_MERGE_OUTER_PREV_SCAN_PVALS (thread_p, inner);
+	      goto exit_on_error;
+	    }
 
-		  /* set group count and direction */
-		  group_cnt = cnt;
-		  direction = S_BACKWARD;
-		}
-	      else
-		{
-		  /* and compare */
-		  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
-						      inner_valp, inner_domp,
-						      nvals);
-		  if (val_cmp == DB_UNK)
-		    {		/* is error */
-		      goto exit_on_error;
-		    }
+	  if (is_null)
+	    {
+	      continue;
+	    }
 
-		  if (val_cmp == DB_LT)
-		    {
-		      /* move the inner to the previous tuple and
-		         position tuple values */
-		      QEXEC_MERGE_OUTER_PREV_SCAN_PVALS (thread_p, inner);
+	  tpl_len = QFILE_GET_TUPLE_LENGTH (inner_tplrec.tpl);
+	  entry = (HASH_JOIN_ENTRY *) db_private_alloc (thread_p,
+							sizeof
+							(HASH_JOIN_ENTRY) +
+							tpl_len);
+	  if (entry == NULL)
+	    {
+	      goto exit_on_error;
+	    }
+	  entry->hash_key = hash_key;
+	  entry->tpl = (QFILE_TUPLE) (entry + 1);
+	  memcpy (entry->tpl, inner_tplrec.tpl, tpl_len);
 
-		      /* and compare */
-		      val_cmp =
-			qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
-						  inner_valp, inner_domp,
-						  nvals);
-		      if (val_cmp == DB_UNK)
-			{	/* is error */
-			  goto exit_on_error;
-			}
+	  k = qexec_hash_join_seed (hash_key, level) % nbuckets;
+	  entry->next = buckets[k];
+	  buckets[k] = entry;
 
-		      if (val_cmp == DB_EQ)
-			{
-			  /* next value is the same, so prepare for further
-			     group scan operations */
+	  mem_size += sizeof (HASH_JOIN_ENTRY) + tpl_len;
+	  nentries++;
+	}
 
-			  /* set group count and direction */
-			  group_cnt = cnt;
-			  direction = S_BACKWARD;
-			}
-		      else
-			{
-			  /* move the inner to the current tuple and
-			     position tuple values */
-			  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, inner,
-							     true);
+      if (scan != S_SUCCESS && scan != S_END)
+	{
+	  goto exit_on_error;
+	}
+      is_last_load = (scan == S_END);
 
-			  val_cmp = DB_LT;	/* restore comparison */
-			}
-		    }
+      if (nentries == 0
+	  && (!is_last_load || merge_infop->join_type != JOIN_LEFT))
+	{
+	  /* nothing to join, nor unmatched outer tuples to emit yet */
+	  continue;
+	}
 
-		  /* comparison has already been done */
-		  already_compared = true;
-		}
-	    }
-	  else
+      if (!is_last_load && merge_infop->join_type == JOIN_LEFT
+	  && matched == NULL)
+	{
+	  matched = (unsigned char *) db_private_alloc (thread_p,
+							(outer_list_idp->
+							 tuple_cnt + 7) / 8);
+	  if (matched == NULL)
 	    {
-	      /* set further scan direction */
-	      direction = S_BACKWARD;
+	      goto exit_on_error;
 	    }
+	  memset (matched, 0, (outer_list_idp->tuple_cnt + 7) / 8);
 	}
-      else
-	{			/* (direction == S_BACKWARD) */
-	  /* move backwards within a group
-	   */
-	  cnt = group_cnt;
-	  /* group_cnt has the number of tuples in the group */
-	  while (1)
+
+      /* probe the hash table with the outer list file */
+      if (qfile_open_list_scan (outer_list_idp, &outer_sid) != NO_ERROR)
+	{
+	  goto exit_on_error;
+	}
+
+      outer_idx = 0;
+      while ((scan = qfile_scan_list_next (thread_p, &outer_sid,
+					   &outer_tplrec, PEEK)) == S_SUCCESS)
+	{
+	  if (qexec_hash_join_key (info, outer_tplrec.tpl,
+				   merge_infop->ls_outer_column,
+				   info->outer_domp, info->outer_valp,
+				   &hash_key, &is_null) != NO_ERROR)
 	    {
-	      /* evaluate other outer join predicate */
-	      ev_res = V_UNKNOWN;
-	      if (other_outer_join_pred != NULL)
+	      goto exit_on_error;
+	    }
+
+	  is_matched = false;
+	  entry = (is_null) ? NULL
+	    : buckets[qexec_hash_join_seed (hash_key, level) % nbuckets];
+	  for (; entry != NULL; entry = entry->next)
+	    {
+	      if (entry->hash_key != hash_key)
 		{
-		  ev_res = eval_pred (thread_p, other_outer_join_pred,
-				      &xasl_state->vd, NULL);
-		  if (ev_res == V_ERROR)
-		    {
-		      goto exit_on_error;
-		    }
+		  continue;
 		}
 
-	      /* is qualified */
-	      if (other_outer_join_pred == NULL || ev_res == V_TRUE)
+	      for (k = 0; k < info->nvals; k++)
 		{
-		  /* merge the fetched tuples(left and right) */
-		  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec,
-					      &inner_tplrec);
+		  QFILE_GET_TUPLE_VALUE_HEADER_POSITION (entry->tpl,
+							 merge_infop->
+							 ls_inner_column[k],
+							 info->inner_valp[k]);
 		}
 
-	      cnt--;		/* decrease the counter of the processed tuples */
-
-	      if (cnt <= 0)
+	      val_cmp =
+		qexec_cmp_tpl_vals_merge ((QFILE_TUPLE *) info->outer_valp,
+					  info->outer_domp,
+					  (QFILE_TUPLE *) info->inner_valp,
+					  info->inner_domp, info->nvals);
+	      if (val_cmp == DB_UNK)
 		{
-		  break;	/* finish the group */
+		  goto exit_on_error;
+		}
+	      if (val_cmp != DB_EQ)
+		{
+		  continue;
 		}
 
-	      /* if not yet reached the top of the group */
-	      /* move the inner(right) scan to the previous tuple */
-	      QEXEC_MERGE_OUTER_PREV_SCAN (thread_p, inner);
-
-	      /* all of the inner tuples in the group have the same
-	         value at the merge column, so we don't need to
-	         compare with the value of the outer one; just count
-	         the number of the tuples in the group */
-	    }			/* while (1) */
-
-	  /* position tuple values (to merge columns) */
-	  QEXEC_MERGE_PVALS (inner);
-
-	  /* move the outer(left) scan to the next tuple and
-	     position tuple values */
-	  QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, outer, true);
+	      inner_tplrec.tpl = entry->tpl;
+	      inner_tplrec.size = QFILE_GET_TUPLE_LENGTH (entry->tpl);
+	      if (qexec_merge_tuple_add_list (thread_p, list_idp,
+					      &outer_tplrec, &inner_tplrec,
+					      merge_infop,
+					      tplrec) != NO_ERROR)
+		{
+		  goto exit_on_error;
+		}
+	      is_matched = true;
+	    }
 
-	  /* and compare */
-	  val_cmp = qexec_cmp_tpl_vals_merge (outer_valp, outer_domp,
-					      inner_valp, inner_domp, nvals);
-	  if (val_cmp == DB_UNK)
-	    {			/* is error */
-	      goto exit_on_error;
+	  if (matched != NULL)
+	    {
+	      if (is_matched)
+		{
+		  matched[outer_idx / 8] |= (1 << (outer_idx % 8));
+		}
+	      else
+		{
+		  is_matched = (matched[outer_idx / 8]
+				& (1 << (outer_idx % 8))) ? true : false;
+		}
 	    }
+	  outer_idx++;
 
-	  if (val_cmp != DB_EQ)
+	  if (!is_matched && is_last_load
+	      && merge_infop->join_type == JOIN_LEFT)
 	    {
-	      /* jump to the previously set scan position */
-	      inner_scan =
-		scan_jump_scan_pos (thread_p, inner_sid, &inner_scanpos);
-	      /* is saved position the end of scan? */
-	      if (inner_scan == S_END)
+	      if (qexec_merge_tuple_add_list (thread_p, list_idp,
+					      &outer_tplrec, NULL,
+					      merge_infop,
+					      tplrec) != NO_ERROR)
 		{
-		  goto exit_on_end;	/* inner(right) is exhausted */
+		  goto exit_on_error;
 		}
+	    }
+	}
 
-	      /* and position tuple values */
-	      QEXEC_MERGE_PVALS (inner);
+      if (scan != S_END)
+	{
+	  goto exit_on_error;
+	}
+      qfile_close_scan (thread_p, &outer_sid);
 
-	      /* reset group count */
-	      group_cnt = 0;
+      /* release the loaded inner tuples before loading the next ones */
+      for (k = 0; k < nbuckets; k++)
+	{
+	  while ((entry = buckets[k]) != NULL)
+	    {
+	      buckets[k] = entry->next;
+	      db_private_free_and_init (thread_p, entry);
 	    }
-	  else
+	}
+    }
+  while (!is_last_load);
+
+exit_on_end:
+  qfile_close_scan (thread_p, &outer_sid);
+  qfile_close_scan (thread_p, &inner_sid);
+
+  if (buckets)
+    {
+      for (k = 0; k < nbuckets; k++)
+	{
+	  while ((entry = buckets[k]) != NULL)
 	    {
-	      /* comparison has already been done */
-	      already_compared = true;
+	      buckets[k] = entry->next;
+	      db_private_free_and_init (thread_p, entry);
 	    }
+	}
+      db_private_free_and_init (thread_p, buckets);
+    }
+  if (matched)
+    {
+      db_private_free_and_init (thread_p, matched);
+    }
 
-	  /* set further scan direction */
-	  direction = S_FORWARD;
+  return error;
 
-	}			/* (direction == S_BACKWARD) */
+exit_on_error:
+  error = ER_FAILED;
+  goto exit_on_end;
+}
 
-    }				/* while (1) */
+/*
+ * qexec_hash_join_lists () - Hash join a pair of list files by partitions
+ *   return: NO_ERROR, or ER_code
+ *   info(in)   : hash join information
+ *   outer_list_idp(in) : outer (probe) list file
+ *   inner_list_idp(in) : inner (build) list file
+ *   level(in)  : partitioning level
+ *   list_idp(in)       : result list file
+ *   tplrec(in) : area to form a big merged tuple
+ *
+ * Note: When the inner list file is larger than the sort buffer, both list
+ * files are split into hash partitions on temporary volumes and the
+ * partitions are joined pair by pair. An inner partition which is still
+ * larger than the sort buffer is split again with the seed of the next
+ * level, up to QEXEC_HASH_JOIN_MAX_LEVELS times. A partition left too
+ * large, or which hardly shrinks because most of its tuples share one join
+ * key, is joined by qexec_hash_join_partition () one sort buffer at a time.
+ */
+static int
+qexec_hash_join_lists (THREAD_ENTRY * thread_p, HASH_JOIN_INFO * info,
+		       QFILE_LIST_ID * outer_list_idp,
+		       QFILE_LIST_ID * inner_list_idp, int level,
+		       QFILE_LIST_ID * list_idp, QFILE_TUPLE_RECORD * tplrec)
+{
+  QFILE_LIST_ID **outer_part_list_idp = NULL, **inner_part_list_idp = NULL;
+  int nparts, i;
+  int error = NO_ERROR;
+
+  if (inner_list_idp->page_cnt <= PRM_SR_NBUFFERS
+      || level >= QEXEC_HASH_JOIN_MAX_LEVELS)
+    {
+      return qexec_hash_join_partition (thread_p, info, outer_list_idp,
+					inner_list_idp, level, list_idp,
+					tplrec);
+    }
+
+  /* keep each in-memory hash table within about one sort buffer */
+  nparts = MIN ((inner_list_idp->page_cnt + PRM_SR_NBUFFERS - 1)
+		/ PRM_SR_NBUFFERS, QFILE_HASH_JOIN_MAX_PARTITIONS);
+
+  outer_part_list_idp =
+    (QFILE_LIST_ID **) db_private_alloc (thread_p,
+					 nparts * sizeof (QFILE_LIST_ID *));
+  inner_part_list_idp =
+    (QFILE_LIST_ID **) db_private_alloc (thread_p,
+					 nparts * sizeof (QFILE_LIST_ID *));
+  if (outer_part_list_idp == NULL || inner_part_list_idp == NULL)
+    {
+      goto exit_on_error;
+    }
+  memset (outer_part_list_idp, 0, nparts * sizeof (QFILE_LIST_ID *));
+  memset (inner_part_list_idp, 0, nparts * sizeof (QFILE_LIST_ID *));
+
+  if (qexec_hash_join_split (thread_p, info, outer_list_idp, true, level,
+			     nparts, outer_part_list_idp) != NO_ERROR
+      || qexec_hash_join_split (thread_p, info, inner_list_idp, false, level,
+				nparts, inner_part_list_idp) != NO_ERROR)
+    {
+      goto exit_on_error;
+    }
+
+  for (i = 0; i < nparts; i++)
+    {
+      if (inner_part_list_idp[i]->page_cnt <= inner_list_idp->page_cnt / 2)
+	{
+	  error = qexec_hash_join_lists (thread_p, info,
+					 outer_part_list_idp[i],
+					 inner_part_list_idp[i], level + 1,
+					 list_idp, tplrec);
+	}
+      else
+	{
+	  /* splitting it again would not make it much smaller */
+	  error = qexec_hash_join_partition (thread_p, info,
+					     outer_part_list_idp[i],
+					     inner_part_list_idp[i],
+					     level + 1, list_idp, tplrec);
+	}
+      if (error != NO_ERROR)
+	{
+	  goto exit_on_error;
+	}
+
+      /* release the partitions as soon as they have been joined */
+      qfile_destroy_list (thread_p, outer_part_list_idp[i]);
+      qfile_free_list_id (outer_part_list_idp[i]);
+      outer_part_list_idp[i] = NULL;
+      qfile_destroy_list (thread_p, inner_part_list_idp[i]);
+      qfile_free_list_id (inner_part_list_idp[i]);
+      inner_part_list_idp[i] = NULL;
+    }
 
 exit_on_end:
-  /* inner(right) is at the end. is there more to the outer(left) ? */
-  if (all_lefts)
+  for (i = 0; i < nparts; i++)
     {
-      while (outer_scan != S_END)
+      if (outer_part_list_idp && outer_part_list_idp[i])
 	{
-	  /* merge the fetched tuple(left) and NULL tuple(right) */
-	  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, &outer_tplrec, NULL);
+	  qfile_close_list (thread_p, outer_part_list_idp[i]);
+	  qfile_destroy_list (thread_p, outer_part_list_idp[i]);
+	  qfile_free_list_id (outer_part_list_idp[i]);
+	}
+      if (inner_part_list_idp && inner_part_list_idp[i])
+	{
+	  qfile_close_list (thread_p, inner_part_list_idp[i]);
+	  qfile_destroy_list (thread_p, inner_part_list_idp[i]);
+	  qfile_free_list_id (inner_part_list_idp[i]);
+	}
+    }
+  if (outer_part_list_idp)
+    {
+      db_private_free_and_init (thread_p, outer_part_list_idp);
+    }
+  if (inner_part_list_idp)
+    {
+      db_private_free_and_init (thread_p, inner_part_list_idp);
+    }
+
+  return error;
+
+exit_on_error:
+  error = ER_FAILED;
+  goto exit_on_end;
+}
+
+/*
+ * qexec_hash_join_list () - Hash join two list files
+ *   return: result list file identifier, or NULL
+ *   outer_list_idp(in) : outer list file
+ *   inner_list_idp(in) : inner list file
+ *   merge_infop(in)    : list file merge information
+ *   ls_flag(in)        :
+ *
+ * Note: Unlike qexec_merge_list(), the list files need not be sorted.
+ * Large list files are joined by hash partitions, see
+ * qexec_hash_join_lists ().
+ */
+static QFILE_LIST_ID *
+qexec_hash_join_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
+		      QFILE_LIST_ID * inner_list_idp,
+		      QFILE_LIST_MERGE_INFO * merge_infop, int ls_flag)
+{
+  QFILE_LIST_ID *list_idp = NULL;
+  QFILE_TUPLE_VALUE_TYPE_LIST type_list;
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  HASH_JOIN_INFO info;
+  int nvals, k;
+
+  /* get merge columns count */
+  nvals = merge_infop->ls_column_cnt;
+
+  memset (&info, 0, sizeof (HASH_JOIN_INFO));
+  info.merge_infop = merge_infop;
+  info.nvals = nvals;
+
+  /* form the typelist for the resultant list file */
+  type_list.type_cnt = merge_infop->ls_pos_cnt;
+  type_list.domp = (TP_DOMAIN **) malloc (type_list.type_cnt *
+					  sizeof (TP_DOMAIN *));
+  if (type_list.domp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  for (k = 0; k < type_list.type_cnt; k++)
+    {
+      type_list.domp[k] =
+	(merge_infop->ls_outer_inner_list[k] == QFILE_OUTER_LIST)
+	? outer_list_idp->type_list.domp[merge_infop->ls_pos_list[k]]
+	: inner_list_idp->type_list.domp[merge_infop->ls_pos_list[k]];
+    }
+
+  /* open the result list file; same query id with outer(inner) list file */
+  list_idp = qfile_open_list (thread_p, &type_list, NULL,
+			      outer_list_idp->query_id, ls_flag);
+  if (list_idp == NULL)
+    {
+      goto exit_on_error;
+    }
 
-	  /* move the outer to the next tuple */
-	  QEXEC_MERGE_OUTER_NEXT_SCAN (thread_p, outer,
-				       false /* do not exit */ );
-	}
-    }				/* if (all_lefts) */
+  if (outer_list_idp->tuple_cnt == 0
+      || (inner_list_idp->tuple_cnt == 0
+	  && merge_infop->join_type == JOIN_INNER))
+    {
+      goto exit_on_end;
+    }
 
-  /* outer(left) is at the end. is there more to the inner(right) ? */
-  if (all_rghts)
+  /* allocate the area to store the merged tuple */
+  if (qfile_reallocate_tuple (&tplrec, DB_PAGESIZE) != NO_ERROR)
     {
-      if (direction == S_FORWARD)
-	{
-	  if (val_cmp == DB_NE)
-	    {			/* mark as not yet compared */
-	      val_cmp = DB_UNK;	/* clear */
+      goto exit_on_error;
+    }
 
-	      /* move the inner(right) scan to the first tuple and
-	         position tuple values (to merge columns) */
-	      QEXEC_MERGE_OUTER_NEXT_SCAN_PVALS (thread_p, inner, true);
-	    }
-	}
-      else
-	{			/* direction == S_BACKWARD */
-	  inner_scan =
-	    scan_jump_scan_pos (thread_p, inner_sid, &inner_scanpos);
-	}
-      while (inner_scan != S_END)
-	{
-	  /* merge the fetched tuple(right) and NULL tuple(left) */
-	  QEXEC_MERGE_ADD_MERGETUPLE (thread_p, NULL, &inner_tplrec);
+  /* merge column domain info, hash type and val pointer */
+  info.outer_domp = (TP_DOMAIN **) db_private_alloc (thread_p,
+						     nvals *
+						     sizeof (TP_DOMAIN *));
+  info.inner_domp = (TP_DOMAIN **) db_private_alloc (thread_p,
+						     nvals *
+						     sizeof (TP_DOMAIN *));
+  info.hash_type = (DB_TYPE *) db_private_alloc (thread_p,
+						 nvals * sizeof (DB_TYPE));
+  info.outer_valp = (char **) db_private_alloc (thread_p,
+						nvals * sizeof (char *));
+  info.inner_valp = (char **) db_private_alloc (thread_p,
+						nvals * sizeof (char *));
+  if (info.outer_domp == NULL || info.inner_domp == NULL
+      || info.hash_type == NULL || info.outer_valp == NULL
+      || info.inner_valp == NULL)
+    {
+      goto exit_on_error;
+    }
 
-	  /* move the inner to the next tuple */
-	  QEXEC_MERGE_OUTER_NEXT_SCAN (thread_p, inner,
-				       false /* do not exit */ );
-	}
-    }				/* if (all_rghts) */
+  for (k = 0; k < nvals; k++)
+    {
+      info.outer_domp[k] =
+	outer_list_idp->type_list.domp[merge_infop->ls_outer_column[k]];
+      info.inner_domp[k] =
+	inner_list_idp->type_list.domp[merge_infop->ls_inner_column[k]];
+      info.hash_type[k] = qexec_hash_join_type (info.outer_domp[k],
+						info.inner_domp[k]);
+    }
 
-  free_and_init (type_list.domp);
-  scan_end_scan (thread_p, outer_sid);
-  scan_end_scan (thread_p, inner_sid);
-  outer_sid->s.llsid.tplrecp = NULL;
-  inner_sid->s.llsid.tplrecp = NULL;
+  if (qexec_hash_join_lists (thread_p, &info, outer_list_idp,
+			     inner_list_idp, 0, list_idp,
+			     &tplrec) != NO_ERROR)
+    {
+      goto exit_on_error;
+    }
+
+exit_on_end:
+  if (type_list.domp)
+    {
+      free_and_init (type_list.domp);
+    }
 
   if (tplrec.tpl)
     {
       db_private_free_and_init (thread_p, tplrec.tpl);
     }
-
-  if (outer_domp)
+  if (info.outer_domp)
     {
-      db_private_free_and_init (thread_p, outer_domp);
+      db_private_free_and_init (thread_p, info.outer_domp);
     }
-  if (outer_valp)
+  if (info.inner_domp)
     {
-      db_private_free_and_init (thread_p, outer_valp);
+      db_private_free_and_init (thread_p, info.inner_domp);
     }
-
-  if (inner_domp)
+  if (info.hash_type)
     {
-      db_private_free_and_init (thread_p, inner_domp);
+      db_private_free_and_init (thread_p, info.hash_type);
     }
-  if (inner_valp)
+  if (info.outer_valp)
     {
-      db_private_free_and_init (thread_p, inner_valp);
+      db_private_free_and_init (thread_p, info.outer_valp);
+    }
+  if (info.inner_valp)
+    {
+      db_private_free_and_init (thread_p, info.inner_valp);
     }
 
   if (list_idp)
@@ -4920,11 +6987,6 @@ exit_on_error:
     }
 
   list_idp = NULL;
-
-  direction = S_FORWARD;
-  val_cmp = DB_UNK;		/* mark as error */
-  all_lefts = all_rghts = false;
-
   goto exit_on_end;
 }
 
@@ -4993,7 +7055,15 @@ qexec_merge_listfiles (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
       QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
     }
 
-  if (merge_infop->join_type == JOIN_INNER)
+  if (merge_infop->join_method == QFILE_HASH_JOIN)
+    {
+      /* call list file hash join routine; the optimizer chooses a hash
+         join only when no other predicate is evaluated during the join */
+      list_id = qexec_hash_join_list (thread_p, outer_xasl->list_id,
+				      inner_xasl->list_id, merge_infop,
+				      ls_flag);
+    }
+  else if (merge_infop->join_type == JOIN_INNER)
     {
       /* call list file merge routine */
       list_id = qexec_merge_list (thread_p, outer_xasl->list_id,
@@ -5255,6 +7325,10 @@ qexec_open_scan (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * curr_spec,
       goto exit_on_error;
     }				/* switch */
 
+  /* gather the statistics of the scan if the query is profiled */
+  s_id->stats.on = (vd != NULL && vd->xasl_state != NULL
+		    && vd->xasl_state->profile);
+
   return NO_ERROR;
 
 exit_on_error:
@@ -9968,16 +12042,394 @@ exit_on_error:
 
 
 
-/*
- *    qexec_execute_cleanup :
- *    thread_p  [in]  :
-*/
-static int
-qexec_execute_cleanup (THREAD_ENTRY * thread_p)
-{
-  return NO_ERROR;
-};
+/*
+ *    qexec_execute_cleanup :
+ *    thread_p  [in]  :
+*/
+static int
+qexec_execute_cleanup (THREAD_ENTRY * thread_p)
+{
+  return NO_ERROR;
+};
+
+
+#if defined (SERVER_MODE)
+/*
+ * qexec_get_parallel_scan_degree () - number of threads to scan the main
+ *                                     block with
+ *   return: degree of the scan; 1 if it is not done in parallel
+ *   xasl(in): XASL tree of the main block
+ *   xasl_state(in): XASL state information
+ *   xasl_stream(out): XASL stream the helpers unpack their plan from
+ *   xasl_stream_size(out): size of the XASL stream
+ *
+ * Note: Only the aggregates without GROUP BY of a top most block that
+ *       sequentially scans a single large heap are scanned in parallel.
+ *       The partial results of such a scan are merged by
+ *       qdata_merge_aggregate_list (); the rows of any other block must
+ *       be produced in order by the thread that owns its list files.
+ */
+static int
+qexec_get_parallel_scan_degree (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
+				XASL_STATE * xasl_state, char **xasl_stream,
+				int *xasl_stream_size)
+{
+  ACCESS_SPEC_TYPE *specp;
+  AGGREGATE_TYPE *agg_p;
+  QMGR_QUERY_ENTRY *query_p;
+  int degree, npages;
+
+  degree = thread_num_parallel_workers () + 1;
+  if (degree <= 1)
+    {
+      return 1;
+    }
+
+  if (xasl->type != BUILDVALUE_PROC
+      || !XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL)
+      || xasl->proc.buildvalue.agg_list == NULL
+      || xasl->proc.buildvalue.is_always_false
+      || xasl->scan_ptr != NULL || xasl->merge_spec != NULL
+      || xasl->aptr_list != NULL || xasl->bptr_list != NULL
+      || xasl->dptr_list != NULL || xasl->fptr_list != NULL
+      || xasl->after_join_pred != NULL || xasl->if_pred != NULL
+      || xasl->instnum_pred != NULL || xasl->instnum_val != NULL
+      || xasl->selected_upd_list != NULL || xasl->composite_locking
+      || XASL_IS_FLAGED (xasl, XASL_HAS_CONNECT_BY))
+    {
+      return 1;
+    }
+
+  specp = xasl->spec_list;
+  if (specp == NULL || specp->next != NULL
+      || specp->type != TARGET_CLASS || specp->access != SEQUENTIAL
+      || specp->s_id.type != S_HEAP_SCAN || specp->s_id.grouped
+      || specp->single_fetch != QPROC_NO_SINGLE_INNER
+      || specp->s.cls_node.node_id != DB_CLUSTER_NODE_LOCAL
+      || QEXEC_EMPTY_ACCESS_SPEC_SCAN (specp))
+    {
+      return 1;
+    }
+
+  for (agg_p = xasl->proc.buildvalue.agg_list; agg_p; agg_p = agg_p->next)
+    {
+      switch (agg_p->function)
+	{
+	case PT_COUNT_STAR:
+	case PT_COUNT:
+	case PT_SUM:
+	case PT_AVG:
+	case PT_MIN:
+	case PT_MAX:
+	  break;
+	default:
+	  return 1;
+	}
+
+      if (agg_p->option == Q_DISTINCT || agg_p->flag_agg_optimize)
+	{
+	  return 1;
+	}
+    }
+
+  npages = file_get_numpages (thread_p, &ACCESS_SPEC_HFID (specp).vfid);
+  degree = MIN (degree, npages / QEXEC_PARALLEL_SCAN_MIN_PAGES);
+  if (degree <= 1)
+    {
+      return 1;
+    }
+
+  query_p = qmgr_get_query_entry (thread_p, xasl_state->query_id,
+				  NULL_TRAN_INDEX);
+  if (query_p == NULL || query_p->xasl != xasl
+      || query_p->xasl_data == NULL)
+    {
+      return 1;
+    }
+
+  *xasl_stream = query_p->xasl_data;
+  *xasl_stream_size = query_p->xasl_size;
+
+  return degree;
+}
+
+/*
+ * qexec_execute_parallel_scan () - scan the main block with several threads
+ *   return: SCAN_CODE (S_SUCCESS, S_ERROR)
+ *   xasl(in): XASL tree of the main block
+ *   xasl_state(in): XASL state information
+ *   tplrec(in): tuple record
+ *   func_vector(in): scan functions of the main block
+ *   degree(in): number of threads
+ *   xasl_stream(in): XASL stream of the query
+ *   xasl_stream_size(in): size of the XASL stream
+ *
+ * Note: The threads take ranges of pages from a shared page dispatcher
+ *       until the heap is exhausted, so a thread that is slowed down gets
+ *       fewer pages. The requester scans with its own plan; every helper
+ *       aggregates into a private copy, and the partial aggregates are
+ *       merged into xasl once all the threads are done.
+ *
+ *       The helpers run under the transaction of the requester, so they
+ *       must not use the lock manager: the requester locks the class for
+ *       the whole parallel scan, and the helpers only latch heap pages.
+ */
+static SCAN_CODE
+qexec_execute_parallel_scan (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
+			     XASL_STATE * xasl_state,
+			     QFILE_TUPLE_RECORD * tplrec,
+			     XASL_SCAN_FNC_PTR func_vector, int degree,
+			     char *xasl_stream, int xasl_stream_size)
+{
+  HEAP_PAGE_DISPATCHER dispatcher;
+  HEAP_SCAN_ID *hsidp;
+  QEXEC_PARALLEL_SCAN_TASK *tasks;
+  void **args;
+  LOCK class_lock = NULL_LOCK;
+  int scanid_bit = -1;
+  bool is_class_locked = false;
+  SCAN_CODE qp_scan = S_SUCCESS;
+  int error = NO_ERROR;
+  int i;
+
+  tasks = (QEXEC_PARALLEL_SCAN_TASK *)
+    db_private_alloc (thread_p, degree * sizeof (QEXEC_PARALLEL_SCAN_TASK));
+  args = (void **) db_private_alloc (thread_p, degree * sizeof (void *));
+  if (tasks == NULL || args == NULL)
+    {
+      qp_scan = S_ERROR;
+      goto end;
+    }
+
+  /*
+   * Lock the class before any helper reads a page, and keep it until the
+   * last helper is done; the scan of the requester may end first.
+   */
+  if (lock_scan (thread_p, &ACCESS_SPEC_CLS_OID (xasl->spec_list), false,
+		 xasl->spec_list->lock_hint, &class_lock,
+		 &scanid_bit) != LK_GRANTED)
+    {
+      qp_scan = S_ERROR;
+      goto end;
+    }
+  is_class_locked = true;
+
+  if (scan_init_page_dispatcher (&dispatcher,
+				 &ACCESS_SPEC_HFID (xasl->spec_list),
+				 QEXEC_PARALLEL_SCAN_RANGE_PAGES) != NO_ERROR)
+    {
+      qp_scan = S_ERROR;
+      goto end;
+    }
+
+  for (i = 0; i < degree; i++)
+    {
+      tasks[i].xasl = (i == 0) ? xasl : NULL;
+      tasks[i].xasl_state = xasl_state;
+      tasks[i].tplrec = tplrec;
+      tasks[i].func_vector = func_vector;
+      tasks[i].xasl_stream = xasl_stream;
+      tasks[i].xasl_stream_size = xasl_stream_size;
+      tasks[i].dispatcher = &dispatcher;
+      tasks[i].agg_state = NULL;
+      tasks[i].result = S_SUCCESS;
+      tasks[i].error = NO_ERROR;
+      args[i] = &tasks[i];
+    }
+
+  hsidp = &xasl->spec_list->s_id.s.hsid;
+  hsidp->dispatcher = &dispatcher;
+
+  thread_run_parallel (thread_p, qexec_parallel_scan_task, args, degree);
+
+  hsidp->dispatcher = NULL;
+  scan_end_page_dispatcher (&dispatcher);
+
+  for (i = 0; i < degree; i++)
+    {
+      if (tasks[i].result != S_SUCCESS)
+	{
+	  qp_scan = S_ERROR;
+	  if (error == NO_ERROR)
+	    {
+	      error = tasks[i].error;
+	    }
+	}
+      else if (tasks[i].agg_state != NULL && qp_scan == S_SUCCESS)
+	{
+	  if (qdata_merge_aggregate_list (thread_p,
+					  xasl->proc.buildvalue.agg_list,
+					  tasks[i].agg_state) != NO_ERROR)
+	    {
+	      qp_scan = S_ERROR;
+	    }
+	}
+
+      if (tasks[i].agg_state != NULL)
+	{
+	  free_and_init (tasks[i].agg_state);
+	}
+    }
+
+  if (qp_scan != S_SUCCESS && er_errid () == NO_ERROR)
+    {
+      /* the error of a helper was set in its own thread */
+      if (error == ER_INTERRUPTED)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_INTERRUPTED, 0);
+	}
+      else
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
+	}
+    }
+
+  /* monitor */
+  mnt_qm_parallel_scans (thread_p);
+
+end:
+  if (is_class_locked)
+    {
+      lock_unlock_scan (thread_p, &ACCESS_SPEC_CLS_OID (xasl->spec_list),
+			scanid_bit, END_SCAN);
+    }
+  if (args)
+    {
+      db_private_free_and_init (thread_p, args);
+    }
+  if (tasks)
+    {
+      db_private_free_and_init (thread_p, tasks);
+    }
+
+  return qp_scan;
+}
+
+/*
+ * qexec_parallel_scan_task () - a thread of a parallel heap scan
+ *   return: none
+ *   arg(in/out): QEXEC_PARALLEL_SCAN_TASK
+ */
+static void
+qexec_parallel_scan_task (THREAD_ENTRY * thread_p, void *arg)
+{
+  QEXEC_PARALLEL_SCAN_TASK *task = (QEXEC_PARALLEL_SCAN_TASK *) arg;
+
+  if (task->xasl != NULL)
+    {
+      /* the requester scans with the plan of the query */
+      task->result = (*task->func_vector[0]) (thread_p, task->xasl,
+					      task->xasl_state, task->tplrec,
+					      &task->func_vector[1]);
+    }
+  else if (!scan_is_page_dispatcher_done (task->dispatcher))
+    {
+      if (qexec_parallel_scan_helper (thread_p, task) != NO_ERROR)
+	{
+	  task->result = S_ERROR;
+	}
+    }
+
+  if (task->result != S_SUCCESS)
+    {
+      task->error = er_errid ();
+    }
+}
+
+/*
+ * qexec_parallel_scan_helper () - scan pages of a parallel heap scan with
+ *                                 a private copy of the plan
+ *   return: NO_ERROR, or ER_code
+ *   task(in/out): the task of the helper thread
+ *
+ * Note: The plan is unpacked into a private heap of the thread, which is
+ *       destroyed with it; only the packed partial aggregates, allocated
+ *       with malloc, outlive the helper.
+ */
+static int
+qexec_parallel_scan_helper (THREAD_ENTRY * thread_p,
+			    QEXEC_PARALLEL_SCAN_TASK * task)
+{
+  XASL_NODE *xasl = NULL;
+  XASL_STATE xasl_state;
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  ACCESS_SPEC_TYPE *specp;
+  void *xasl_buf_info = NULL;
+  HL_HEAPID old_pri_heap_id;
+  int size;
+  int error = NO_ERROR;
+
+  old_pri_heap_id = db_replace_private_heap (thread_p);
+
+  xasl_state = *task->xasl_state;	/* bitwise copy */
+  /* the helper's scans are thrown away with its plan */
+  xasl_state.profile = false;
+
+  if (stx_map_stream_to_xasl (thread_p, &xasl, task->xasl_stream,
+			      task->xasl_stream_size, &xasl_buf_info) != NO_ERROR)
+    {
+      error = ER_FAILED;
+      goto end;
+    }
+
+  error = qdata_initialize_aggregate_list (thread_p,
+					   xasl->proc.buildvalue.agg_list,
+					   xasl_state.query_id);
+  if (error != NO_ERROR)
+    {
+      goto end;
+    }
+
+  if (qexec_open_scans (thread_p, xasl, &xasl_state, true, true) == ER_FAILED)
+    {
+      error = ER_FAILED;
+      goto end;
+    }
+
+  specp = xasl->spec_list;
+  specp->s_id.s.hsid.dispatcher = task->dispatcher;
+  /* the requester holds the class lock; see qexec_execute_parallel_scan () */
+  specp->s_id.s.hsid.skip_lock = true;
+  XASL_SPEC_INIT_FLAG (specp);
+
+  if (qexec_intprt_fnc (thread_p, xasl, &xasl_state, &tplrec, NULL)
+      != S_SUCCESS)
+    {
+      error = ER_FAILED;
+    }
+
+  scan_end_scan_proxy (thread_p, xasl, xasl->spec_list);
+  qexec_close_scan_proxy (thread_p, xasl, xasl->spec_list);
+  xasl->curr_spec = NULL;
+
+  if (error == NO_ERROR)
+    {
+      task->agg_state = qdata_pack_aggregate_list (thread_p,
+						   xasl->proc.buildvalue.
+						   agg_list, &size);
+      if (task->agg_state == NULL)
+	{
+	  error = ER_FAILED;
+	}
+    }
+
+end:
+  if (xasl != NULL)
+    {
+      (void) qexec_clear_xasl (thread_p, xasl, true);
+    }
+  if (xasl_buf_info != NULL)
+    {
+      stx_free_xasl_unpack_info (xasl_buf_info);
+    }
+
+  /* everything else of the helper goes away with its private heap */
+  db_destroy_private_heap (thread_p, 0);
+  (void) db_change_private_heap (thread_p, old_pri_heap_id);
 
+  return error;
+}
+#endif /* SERVER_MODE */
 
 /*
  * qexec_execute_mainblock () -
@@ -9985,10 +12437,39 @@ qexec_execute_cleanup (THREAD_ENTRY * thread_p)
  *   xasl(in)   : XASL Tree pointer
  *   xasl_state(in)     : XASL state information
  *
+ * Note: When the query is profiled, what the execution of the block took
+ *       is added to the statistics of the XASL node.
  */
 int
 qexec_execute_mainblock (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
 			 XASL_STATE * xasl_state)
+{
+  SCAN_STATS begin;
+  int error;
+
+  if (!xasl_state->profile)
+    {
+      return qexec_execute_mainblock_internal (thread_p, xasl, xasl_state);
+    }
+
+  scan_stats_begin (thread_p, &begin);
+  error = qexec_execute_mainblock_internal (thread_p, xasl, xasl_state);
+  scan_stats_end (thread_p, &begin, &xasl->stats);
+  xasl->stats.num_starts++;
+
+  return error;
+}
+
+/*
+ * qexec_execute_mainblock_internal () -
+ *   return: NO_ERROR, or ER_code
+ *   xasl(in)   : XASL Tree pointer
+ *   xasl_state(in)     : XASL state information
+ *
+ */
+static int
+qexec_execute_mainblock_internal (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
+				  XASL_STATE * xasl_state)
 {
   XASL_NODE *xptr, *xptr2;
   QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
@@ -10005,6 +12486,11 @@ qexec_execute_mainblock (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
   int old_waitsecs;
   int error;
   ACCESS_SPEC_TYPE *tmp_spec = NULL;
+#if defined (SERVER_MODE)
+  int parallel_degree;
+  char *xasl_stream = NULL;
+  int xasl_stream_size = 0;
+#endif /* SERVER_MODE */
 
   /* create new instant heap memory and save old */
 
@@ -10331,9 +12817,26 @@ qexec_execute_mainblock (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
 	    }
 	  tmp_spec = xasl->spec_list;
 	  XASL_SPEC_INIT_FLAG (tmp_spec);
-	  /* call the first xasl interpreter function */
-	  qp_scan = (*func_vector[0]) (thread_p, xasl, xasl_state, &tplrec,
-				       &func_vector[1]);
+#if defined (SERVER_MODE)
+	  parallel_degree =
+	    qexec_get_parallel_scan_degree (thread_p, xasl, xasl_state,
+					    &xasl_stream, &xasl_stream_size);
+	  if (parallel_degree > 1)
+	    {
+	      qp_scan = qexec_execute_parallel_scan (thread_p, xasl,
+						     xasl_state, &tplrec,
+						     func_vector,
+						     parallel_degree,
+						     xasl_stream,
+						     xasl_stream_size);
+	    }
+	  else
+#endif /* SERVER_MODE */
+	    {
+	      /* call the first xasl interpreter function */
+	      qp_scan = (*func_vector[0]) (thread_p, xasl, xasl_state,
+					   &tplrec, &func_vector[1]);
+	    }
 
 	  if (XASL_IS_FLAGED (xasl, XASL_HAS_CONNECT_BY))
 	    {
@@ -10692,6 +13195,10 @@ qexec_execute_query (THREAD_ENTRY * thread_p, XASL_NODE * xasl, int dbval_cnt,
   /* initialize error line */
   xasl_state.qp_xasl_line = 0;
 
+  /* gather the execution statistics if the client asked for them */
+  xasl_state.profile = qmgr_is_query_profile_on (thread_p);
+  qmgr_start_work_mem_stats (thread_p);
+
   tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
 
   do
@@ -10884,12 +13391,317 @@ qexec_execute_query (THREAD_ENTRY * thread_p, XASL_NODE * xasl, int dbval_cnt,
   }
 #endif /* CUBRID_DEBUG */
 
+  /* keep the profile for the client before the XASL tree goes away */
+  if (xasl_state.profile)
+    {
+      qmgr_save_query_profile (thread_p,
+			       qexec_format_profile (thread_p, xasl));
+    }
+
   /* clear XASL tree */
   (void) qexec_clear_xasl (thread_p, xasl, true);
 
   return list_id;
 }
 
+/*
+ * qexec_profile_printf () - Append formatted text to the profile
+ *   return: NO_ERROR, or ER_code
+ *   buf(in/out): profile text buffer
+ *   fmt(in): printf format
+ */
+static int
+qexec_profile_printf (QEXEC_PROFILE_BUF * buf, const char *fmt, ...)
+{
+  va_list ap;
+  char *text;
+  int n, size;
+
+  while (1)
+    {
+      va_start (ap, fmt);
+      n = vsnprintf (buf->text + buf->length, buf->size - buf->length,
+		     fmt, ap);
+      va_end (ap);
+
+      if (n >= 0 && n < buf->size - buf->length)
+	{
+	  buf->length += n;
+	  return NO_ERROR;
+	}
+
+      size = (n >= 0) ? MAX (buf->size * 2, buf->length + n + 1)
+	: buf->size * 2;
+      text = (char *) realloc (buf->text, size);
+      if (text == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+		  ER_OUT_OF_VIRTUAL_MEMORY, 1, size);
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+      buf->text = text;
+      buf->size = size;
+    }
+}
+
+/*
+ * qexec_profile_xasl_type () - Name of an XASL node in the profile
+ *   return: type name
+ *   xasl(in):
+ */
+static const char *
+qexec_profile_xasl_type (XASL_NODE * xasl)
+{
+  switch (xasl->type)
+    {
+    case BUILDLIST_PROC:
+      return "buildlist_proc";
+    case BUILDVALUE_PROC:
+      return "buildvalue_proc";
+    case UNION_PROC:
+      return "union_proc";
+    case DIFFERENCE_PROC:
+      return "difference_proc";
+    case INTERSECTION_PROC:
+      return "intersection_proc";
+    case OBJFETCH_PROC:
+      return "objfetch_proc";
+    case SETFETCH_PROC:
+      return "setfetch_proc";
+    case SCAN_PROC:
+      return "scan_proc";
+    case MERGELIST_PROC:
+      return "mergelist_proc";
+    case UPDATE_PROC:
+      return "update_proc";
+    case DELETE_PROC:
+      return "delete_proc";
+    case INSERT_PROC:
+      return "insert_proc";
+    case CONNECTBY_PROC:
+      return "connectby_proc";
+    default:
+      return "unknown";
+    }
+}
+
+/*
+ * qexec_profile_stats () - Append the statistics of a node or scan
+ *   return: NO_ERROR, or ER_code
+ *   buf(in/out): profile text buffer
+ *   stats(in):
+ */
+static int
+qexec_profile_stats (QEXEC_PROFILE_BUF * buf, const SCAN_STATS * stats)
+{
+  return qexec_profile_printf (buf, " (time: %.3f ms, starts: %u,"
+			       " fetch: %lld, ioread: %lld, lock wait: %lld",
+			       (double) stats->elapsed_usec / 1000.0,
+			       stats->num_starts,
+			       (long long) stats->num_fetches,
+			       (long long) stats->num_ioreads,
+			       (long long) stats->num_lock_waits);
+}
+
+/*
+ * qexec_profile_spec () - Append the profile of an access spec
+ *   return: NO_ERROR, or ER_code
+ *   buf(in/out): profile text buffer
+ *   spec(in): access spec
+ *   depth(in): nesting level, for the indentation
+ */
+static int
+qexec_profile_spec (THREAD_ENTRY * thread_p, QEXEC_PROFILE_BUF * buf,
+		    ACCESS_SPEC_TYPE * spec, int depth)
+{
+  SCAN_STATS *stats = &spec->s_id.stats;
+  char *class_name = NULL, *index_name = NULL;
+  int error;
+
+  if (spec->type == TARGET_CLASS || spec->type == TARGET_CLASS_ATTR)
+    {
+      class_name = heap_get_class_name (thread_p,
+					&ACCESS_SPEC_CLS_OID (spec));
+      if (spec->access == INDEX && spec->indexptr != NULL)
+	{
+	  (void) heap_get_indexinfo_of_btid (thread_p,
+					     &ACCESS_SPEC_CLS_OID (spec),
+					     &spec->indexptr->indx_id.i.btid,
+					     NULL, NULL, NULL, NULL,
+					     &index_name);
+	}
+    }
+
+  switch (spec->type)
+    {
+    case TARGET_CLASS:
+      error = qexec_profile_printf (buf, "%*s%s scan on %s%s%s", depth * 2,
+				    "",
+				    (spec->access == INDEX) ? "index" : "heap",
+				    class_name ? class_name : "?",
+				    index_name ? "." : "",
+				    index_name ? index_name : "");
+      break;
+    case TARGET_CLASS_ATTR:
+      error = qexec_profile_printf (buf, "%*sclass attribute scan on %s",
+				    depth * 2, "",
+				    class_name ? class_name : "?");
+      break;
+    case TARGET_LIST:
+      error = qexec_profile_printf (buf, "%*slist scan", depth * 2, "");
+      break;
+    case TARGET_SET:
+      error = qexec_profile_printf (buf, "%*sset scan", depth * 2, "");
+      break;
+    case TARGET_METHOD:
+      error = qexec_profile_printf (buf, "%*smethod scan", depth * 2, "");
+      break;
+    default:
+      error = qexec_profile_printf (buf, "%*sscan", depth * 2, "");
+      break;
+    }
+
+  if (class_name != NULL)
+    {
+      free_and_init (class_name);
+    }
+  if (index_name != NULL)
+    {
+      free_and_init (index_name);
+    }
+
+  if (error == NO_ERROR)
+    {
+      error = qexec_profile_stats (buf, stats);
+    }
+  if (error == NO_ERROR)
+    {
+      error = qexec_profile_printf (buf, ", read: %lld, qualified: %lld)\n",
+				    (long long) stats->read_rows,
+				    (long long) stats->qualified_rows);
+    }
+
+  return error;
+}
+
+/*
+ * qexec_profile_xasl () - Append the profile of an XASL node and the nodes
+ *                         under it
+ *   return: NO_ERROR, or ER_code
+ *   buf(in/out): profile text buffer
+ *   xasl(in): XASL node
+ *   label(in): how the node hangs from its parent, NULL for the top
+ *   depth(in): nesting level, for the indentation
+ *
+ * Note: Nodes which are not executed as a block of their own (scan_ptr,
+ *       object fetches) have no statistics; the scans under them have.
+ */
+static int
+qexec_profile_xasl (THREAD_ENTRY * thread_p, QEXEC_PROFILE_BUF * buf,
+		    XASL_NODE * xasl, const char *label, int depth)
+{
+  ACCESS_SPEC_TYPE *spec;
+  XASL_NODE *xptr;
+  int error;
+
+  error = qexec_profile_printf (buf, "%*s%s%s%s", depth * 2, "",
+				label ? label : "", label ? ": " : "",
+				qexec_profile_xasl_type (xasl));
+  if (error == NO_ERROR && xasl->stats.num_starts > 0)
+    {
+      error = qexec_profile_stats (buf, &xasl->stats);
+      if (error == NO_ERROR)
+	{
+	  error = qexec_profile_printf (buf, ", rows: %d)",
+					xasl->list_id ?
+					xasl->list_id->tuple_cnt : 0);
+	}
+    }
+  if (error == NO_ERROR)
+    {
+      error = qexec_profile_printf (buf, "\n");
+    }
+
+  for (spec = xasl->spec_list; spec && error == NO_ERROR; spec = spec->next)
+    {
+      error = qexec_profile_spec (thread_p, buf, spec, depth + 1);
+    }
+  if (xasl->merge_spec && error == NO_ERROR)
+    {
+      error = qexec_profile_spec (thread_p, buf, xasl->merge_spec, depth + 1);
+    }
+
+  for (xptr = xasl->aptr_list; xptr && error == NO_ERROR; xptr = xptr->next)
+    {
+      error = qexec_profile_xasl (thread_p, buf, xptr, "aptr", depth + 1);
+    }
+  for (xptr = xasl->bptr_list; xptr && error == NO_ERROR; xptr = xptr->next)
+    {
+      error = qexec_profile_xasl (thread_p, buf, xptr, "bptr", depth + 1);
+    }
+  for (xptr = xasl->scan_ptr; xptr && error == NO_ERROR; xptr = xptr->next)
+    {
+      error = qexec_profile_xasl (thread_p, buf, xptr, "scan", depth + 1);
+    }
+  for (xptr = xasl->dptr_list; xptr && error == NO_ERROR; xptr = xptr->next)
+    {
+      error = qexec_profile_xasl (thread_p, buf, xptr, "dptr", depth + 1);
+    }
+  for (xptr = xasl->fptr_list; xptr && error == NO_ERROR; xptr = xptr->next)
+    {
+      error = qexec_profile_xasl (thread_p, buf, xptr, "fptr", depth + 1);
+    }
+  if (xasl->connect_by_ptr && error == NO_ERROR)
+    {
+      error = qexec_profile_xasl (thread_p, buf, xasl->connect_by_ptr,
+				  "connect by", depth + 1);
+    }
+
+  return error;
+}
+
+/*
+ * qexec_format_profile () - Format the profile of an executed query
+ *   return: profile text allocated with malloc, or NULL on failure
+ *   xasl(in): XASL tree of the query, before it is cleared
+ */
+static char *
+qexec_format_profile (THREAD_ENTRY * thread_p, XASL_NODE * xasl)
+{
+  QEXEC_PROFILE_BUF buf;
+  int peak_pages, spill_pages;
+
+  buf.size = ONE_K;
+  buf.length = 0;
+  buf.text = (char *) malloc (buf.size);
+  if (buf.text == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+	      ER_OUT_OF_VIRTUAL_MEMORY, 1, buf.size);
+      return NULL;
+    }
+  buf.text[0] = '\0';
+
+  if (qexec_profile_printf (&buf, "Query profile:\n") != NO_ERROR
+      || qexec_profile_xasl (thread_p, &buf, xasl, NULL, 1) != NO_ERROR)
+    {
+      free_and_init (buf.text);
+      return NULL;
+    }
+
+  qmgr_get_work_mem_stats (thread_p, &peak_pages, &spill_pages);
+  if (qexec_profile_printf (&buf, "  work memory (peak: %lld bytes, "
+			    "spilled: %lld bytes)\n",
+			    (long long) peak_pages * DB_PAGESIZE,
+			    (long long) spill_pages * DB_PAGESIZE) != NO_ERROR)
+    {
+      free_and_init (buf.text);
+      return NULL;
+    }
+
+  return buf.text;
+}
+
 #if defined(CUBRID_DEBUG)
 /*
  * get_xasl_dumper_linked_in () -
@@ -11001,6 +13813,12 @@ qexec_initialize_xasl_cache (THREAD_ENTRY * thread_p)
       xasl_ent_cache.qstr_ht = mht_create ("XASL stream cache (query string)",
 					   xasl_ent_cache.max_entries,
 					   mht_1strhash, mht_strcmpeq);
+#if defined(SERVER_MODE)
+      for (i = 0; i < XASL_ENT_LATCH_COUNT; i++)
+	{
+	  MUTEX_INIT (xasl_ent_latch[i]);
+	}
+#endif /* SERVER_MODE */
     }
   /* memory hash table for XASL stream cache referencing by xasl file id */
   if (xasl_ent_cache.xid_ht)
@@ -11125,9 +13943,9 @@ int
 qexec_finalize_xasl_cache (THREAD_ENTRY * thread_p)
 {
   int ret = NO_ERROR;
-#if defined (ENABLE_UNUSED_FUNCTION)
+#if defined (ENABLE_UNUSED_FUNCTION) || defined(SERVER_MODE)
   int i;
-#endif /* ENABLE_UNUSED_FUNCTION */
+#endif /* ENABLE_UNUSED_FUNCTION || SERVER_MODE */
 
   if (xasl_ent_cache.max_entries <= 0)
     {
@@ -11146,6 +13964,12 @@ qexec_finalize_xasl_cache (THREAD_ENTRY * thread_p)
 			     qexec_free_xasl_cache_ent, NULL);
       mht_destroy (xasl_ent_cache.qstr_ht);
       xasl_ent_cache.qstr_ht = NULL;
+#if defined(SERVER_MODE)
+      for (i = 0; i < XASL_ENT_LATCH_COUNT; i++)
+	{
+	  MUTEX_DESTROY (xasl_ent_latch[i]);
+	}
+#endif /* SERVER_MODE */
     }
 
   /* memory hash table for XASL stream cache referencing by xasl file id */
@@ -11830,9 +14654,11 @@ qexec_lookup_xasl_cache_ent (THREAD_ENTRY * thread_p, const char *qstr,
   const int *rep_idp;
   int id;
   int i;
+  bool as_writer = false;
 #if defined(SERVER_MODE)
   int tran_index;
   int num_elements;
+  int rv;
 #endif
 
   if (xasl_ent_cache.max_entries <= 0)
@@ -11840,19 +14666,38 @@ qexec_lookup_xasl_cache_ent (THREAD_ENTRY * thread_p, const char *qstr,
       return NULL;
     }
 
-  if (csect_enter (thread_p, CSECT_QPROC_XASL_CACHE, INF_WAIT) != NO_ERROR)
+retry:
+  /* a plain lookup only reads the hash tables; the section is entered
+     exclusively only when an entry has to be removed on the way */
+  if (as_writer)
     {
-      return NULL;
+      if (csect_enter (thread_p, CSECT_QPROC_XASL_CACHE, INF_WAIT) !=
+	  NO_ERROR)
+	{
+	  return NULL;
+	}
+    }
+  else
+    {
+      if (csect_enter_as_reader (thread_p, CSECT_QPROC_XASL_CACHE,
+				 INF_WAIT) != NO_ERROR)
+	{
+	  return NULL;
+	}
+      ATOMIC_INC_32 (&xasl_ent_cache.counter.lookup, 1);	/* counter */
     }
 
   /* look up the hash table with the key */
   ent = (XASL_CACHE_ENTRY *) mht_get (xasl_ent_cache.qstr_ht, qstr);
-  xasl_ent_cache.counter.lookup++;	/* counter */
   if (ent)
     {
       /* check if it is marked to be deleted */
       if (ent->deletion_marker)
 	{
+	  if (!as_writer)
+	    {
+	      goto promote;
+	    }
 	  (void) qexec_delete_xasl_cache_ent (thread_p, ent, NULL);
 	  ent = NULL;
 	  goto end;
@@ -11870,6 +14715,10 @@ qexec_lookup_xasl_cache_ent (THREAD_ENTRY * thread_p, const char *qstr,
 			ent->time_created.tv_sec) >
 	      PRM_XASL_PLAN_CACHE_TIMEOUT))
 	{
+	  if (!as_writer)
+	    {
+	      goto promote;
+	    }
 	  /* delete the entry which is timed out */
 	  (void) qexec_delete_xasl_cache_ent (thread_p, ent, NULL);
 	  ent = NULL;
@@ -11886,6 +14735,10 @@ qexec_lookup_xasl_cache_ent (THREAD_ENTRY * thread_p, const char *qstr,
 						      &id) != NO_ERROR
 		  || id != *rep_idp)
 		{
+		  if (!as_writer)
+		    {
+		      goto promote;
+		    }
 		  /* delete the entry if any referenced class was changed */
 		  (void) qexec_delete_xasl_cache_ent (thread_p, ent, NULL);
 		  ent = NULL;
@@ -11900,6 +14753,7 @@ qexec_lookup_xasl_cache_ent (THREAD_ENTRY * thread_p, const char *qstr,
 	     and adjust timestamp and reference counter */
 #if defined(SERVER_MODE)
 	  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+	  MUTEX_LOCK (rv, XASL_ENT_LATCH (ent));
 	  if ((ssize_t) ent->last_ta_idx < MAX_NTRANS)
 	    {
 	      num_elements = (int) ent->last_ta_idx;
@@ -11907,26 +14761,36 @@ qexec_lookup_xasl_cache_ent (THREAD_ENTRY * thread_p, const char *qstr,
 				     &num_elements);
 	      ent->last_ta_idx = num_elements;
 	    }
+	  MUTEX_UNLOCK (XASL_ENT_LATCH (ent));
 #endif
+	  /* racing readers may overwrite each other's timestamp;
+	     it is only a hint for the victim selection */
 	  (void) gettimeofday (&ent->time_last_used, NULL);
-	  ent->ref_count++;
+	  ATOMIC_INC_32 (&ent->ref_count, 1);
 
 	}
     }
 
   if (ent)
     {
-      xasl_ent_cache.counter.hit++;	/* counter */
+      ATOMIC_INC_32 (&xasl_ent_cache.counter.hit, 1);	/* counter */
     }
   else
     {
-      xasl_ent_cache.counter.miss++;	/* counter */
+      ATOMIC_INC_32 (&xasl_ent_cache.counter.miss, 1);	/* counter */
     }
 
 end:
   csect_exit (CSECT_QPROC_XASL_CACHE);
 
   return ent;
+
+promote:
+  /* the entry has to be deleted; look it up again holding the section
+     exclusively since it may change while the section is released */
+  csect_exit (CSECT_QPROC_XASL_CACHE);
+  as_writer = true;
+  goto retry;
 }
 
 /*
@@ -12381,6 +15245,10 @@ qexec_end_use_of_xasl_cache_ent (THREAD_ENTRY * thread_p,
 {
   XASL_CACHE_ENTRY *ent;
   int rc;
+  bool unused;
+#if defined(SERVER_MODE)
+  int rv;
+#endif /* SERVER_MODE */
 
   if (xasl_ent_cache.max_entries <= 0)	/* check this condition first */
     {
@@ -12389,7 +15257,8 @@ qexec_end_use_of_xasl_cache_ent (THREAD_ENTRY * thread_p,
       return file_destroy (thread_p, &xasl_id->temp_vfid);
     }
 
-  if (csect_enter (thread_p, CSECT_QPROC_XASL_CACHE, INF_WAIT) != NO_ERROR)
+  if (csect_enter_as_reader (thread_p, CSECT_QPROC_XASL_CACHE, INF_WAIT) !=
+      NO_ERROR)
     {
       return ER_FAILED;
     }
@@ -12401,6 +15270,7 @@ qexec_end_use_of_xasl_cache_ent (THREAD_ENTRY * thread_p,
     {
       /* remove my transaction id from the entry and do compaction */
 #if defined(SERVER_MODE)
+      MUTEX_LOCK (rv, XASL_ENT_LATCH (ent));
       rc = qexec_remove_my_transaction_id (thread_p, ent);
 #else /* SA_MODE */
       rc = NO_ERROR;
@@ -12413,12 +15283,32 @@ qexec_end_use_of_xasl_cache_ent (THREAD_ENTRY * thread_p,
 	}
 
 #if defined(SERVER_MODE)
-      if (ent->deletion_marker && ent->last_ta_idx == 0)
+      unused = (ent->deletion_marker && ent->last_ta_idx == 0);
+      MUTEX_UNLOCK (XASL_ENT_LATCH (ent));
 #else /* SA_MODE */
-      if (ent->deletion_marker)
+      unused = ent->deletion_marker;
 #endif /* SERVER_MODE */
+
+      if (unused)
 	{
-	  (void) qexec_delete_xasl_cache_ent (thread_p, ent, NULL);
+	  /* deleting needs the section exclusively; another transaction may
+	     have started using or deleted the entry in the meantime */
+	  csect_exit (CSECT_QPROC_XASL_CACHE);
+	  if (csect_enter (thread_p, CSECT_QPROC_XASL_CACHE, INF_WAIT) !=
+	      NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
+
+	  ent = (XASL_CACHE_ENTRY *) mht_get (xasl_ent_cache.xid_ht, xasl_id);
+#if defined(SERVER_MODE)
+	  if (ent && ent->deletion_marker && ent->last_ta_idx == 0)
+#else /* SA_MODE */
+	  if (ent && ent->deletion_marker)
+#endif /* SERVER_MODE */
+	    {
+	      (void) qexec_delete_xasl_cache_ent (thread_p, ent, NULL);
+	    }
 	}
     }				/* if (ent) */
   else
@@ -12468,7 +15358,20 @@ qexec_check_xasl_cache_ent_by_xasl (THREAD_ENTRY * thread_p,
 
   ent = NULL;			/* init */
 
-  if (csect_enter (thread_p, CSECT_QPROC_XASL_CACHE, INF_WAIT) != NO_ERROR)
+#if defined (ENABLE_UNUSED_FUNCTION)
+  /* cache clones are kept in shared lists; keep the section exclusive */
+  if (clop != NULL)
+    {
+      if (csect_enter (thread_p, CSECT_QPROC_XASL_CACHE, INF_WAIT) !=
+	  NO_ERROR)
+	{
+	  return NULL;
+	}
+    }
+  else
+#endif /* ENABLE_UNUSED_FUNCTION */
+  if (csect_enter_as_reader (thread_p, CSECT_QPROC_XASL_CACHE, INF_WAIT) !=
+	NO_ERROR)
     {
       return NULL;
     }
@@ -12480,7 +15383,19 @@ qexec_check_xasl_cache_ent_by_xasl (THREAD_ENTRY * thread_p,
     {
       if (ent->deletion_marker)
 	{
-	  (void) qexec_delete_xasl_cache_ent (thread_p, ent, NULL);
+	  /* deleting needs the section exclusively; look the entry up
+	     again since it may change while the section is released */
+	  csect_exit (CSECT_QPROC_XASL_CACHE);
+	  if (csect_enter (thread_p, CSECT_QPROC_XASL_CACHE, INF_WAIT) !=
+	      NO_ERROR)
+	    {
+	      return NULL;
+	    }
+	  ent = (XASL_CACHE_ENTRY *) mht_get (xasl_ent_cache.xid_ht, xasl_id);
+	  if (ent && ent->deletion_marker)
+	    {
+	      (void) qexec_delete_xasl_cache_ent (thread_p, ent, NULL);
+	    }
 	  ent = NULL;
 	}
 
@@ -14861,7 +17776,8 @@ qexec_listfile_orderby (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_file,
 	  list_id = qfile_sort_list_with_func (thread_p, list_id,
 					       orderby_list, Q_ALL,
 					       QFILE_FLAG_ALL,
-					       NULL, NULL, NULL, &ordby_info);
+					       NULL, NULL, NULL, &ordby_info,
+					       NO_SORT_LIMIT);
 
 	  if (ordby_info.ordbynum_pos != ordby_info.reserved)
 	    {
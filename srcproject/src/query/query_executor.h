@@ -536,6 +536,9 @@ struct xasl_node
 
   double cardinality;		/* estimated cardinality of result */
 
+  SCAN_STATS stats;		/* statistics for the query profile;
+				   not packed/unpacked, server side only */
+
   /* XASL cache related information */
   OID creator_oid;		/* OID of the user who created this XASL */
   int projected_size;		/* # of bytes per result tuple */
@@ -560,6 +563,7 @@ struct xasl_node
 #define XASL_EXEC_NODE           512	/* execution node */
 #define XASL_DO_NOT_SCAN        1024	/* do not scan */
 #define XASL_SPEC_VISITED       2048	/* spec has been visited */
+#define XASL_USE_HASH_AGGREGATE 4096	/* group by/distinct may use hashing */
 
 
 #define XASL_IS_FLAGED(x, f)        ((x)->flag & (int) (f))
@@ -599,6 +603,7 @@ struct xasl_state
   VAL_DESCR vd;			/* Value Descriptor */
   QUERY_ID query_id;		/* Query associated with XASL */
   int qp_xasl_line;		/* Error line */
+  bool profile;			/* gather statistics for the query profile */
 };				/* XASL Tree State Information */
 
 typedef struct xasl_parts_info XASL_PARTS_INFO;
@@ -434,10 +434,20 @@ struct qfile_tuple_value_position
 };
 
 /* List File Merge Information */
+typedef enum
+{
+  QFILE_MERGE_JOIN,		/* merge two sorted list files */
+  QFILE_HASH_JOIN		/* probe a hash table built on the inner list */
+} QFILE_JOIN_METHOD;
+
+/* maximum number of partitions a hash join splits a list file into */
+#define QFILE_HASH_JOIN_MAX_PARTITIONS  64
+
 typedef struct qfile_list_merge_info QFILE_LIST_MERGE_INFO;
 struct qfile_list_merge_info
 {
   JOIN_TYPE join_type;		/* inner, left, right or outer */
+  QFILE_JOIN_METHOD join_method;	/* merge or hash join */
   QPROC_SINGLE_FETCH single_fetch;	/* merge in single fetch mode */
   int ls_column_cnt;		/* join columns count */
   int ls_pos_cnt;		/* tuple value fetch count */
@@ -599,6 +609,7 @@ struct qfile_list_scan_id
   int curr_tplno;		/* current tuple number */
   QFILE_TUPLE_RECORD tplrec;	/* used for overflow tuple peeking */
   QFILE_LIST_ID list_id;	/* list file identifier */
+  bool bulk_read;		/* is the list read in bulk read mode? */
 };
 
 /* list file flag; denoting type and/or operation of the list file */
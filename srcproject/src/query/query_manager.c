@@ -48,6 +48,7 @@
 #include "remote_query.h"
 #endif
 #include "cluster_config.h"
+#include "perf_monitor.h"
 #include "thread_impl.h"
 
 #ifndef SERVER_MODE
@@ -71,6 +72,9 @@
 
 #define QMGR_TEMP_FILE_FREE_LIST_SIZE   100
 
+/* # of work memory pages a temp file asks for at a time */
+#define QMGR_WORK_MEM_CHUNK_PAGES       8
+
 /* For streaming queries */
 typedef struct query_async QMGR_ASYNC_QUERY;
 struct query_async
@@ -119,6 +123,17 @@ struct qmgr_tran_entry
 
   OID_BLOCK_LIST *modified_classes_p;	/* array of class OIDs */
 
+  bool profile_on;		/* profile the queries of the transaction */
+  bool profile_started_stats;	/* execution statistics were started for
+				   the profile */
+  char *profile_p;		/* profile of the last query, not yet
+				   sent to the client */
+
+  int work_mem_pages;		/* work memory granted to the queries */
+  int work_mem_peak;		/* most work memory held by the last query */
+  int work_mem_spill_pages;	/* pages the last query spilled to temp
+				   volumes */
+
 #if defined (SERVER_MODE)
   THREAD_ENTRY *wait_thread_p;
   int active_sync_query_count;
@@ -151,10 +166,13 @@ struct qmgr_query_table
   MUTEX_T temp_file_free_mutex;
   QMGR_TEMP_FILE *temp_file_free_list;
   int temp_file_free_count;
+
+  int work_mem_pages;		/* work memory granted out of
+				   PRM_WORK_MEM_PAGES */
 };
 
 QMGR_QUERY_TABLE qmgr_Query_table = { NULL, 0, 0, 0, 0, 0, NULL, NULL, NULL,
-  MUTEX_INITIALIZER, NULL, 0
+  MUTEX_INITIALIZER, NULL, 0, 0
 };
 
 static int qmgr_Query_id_count;	/* global query identifier count */
@@ -218,6 +236,13 @@ static int qmgr_free_query_temp_file_by_query_entry (THREAD_ENTRY * thread_p,
 						     QMGR_QUERY_ENTRY * qptr,
 						     int tran_idx);
 static QMGR_TEMP_FILE *qmgr_allocate_tempfile_with_buffer (void);
+static int qmgr_grant_work_mem_pages (int *used_pages_p, int max_pages,
+				      int npages);
+static void qmgr_return_work_mem (int tran_index, int npages);
+static int qmgr_extend_temp_file_membuf (THREAD_ENTRY * thread_p,
+					 QMGR_TEMP_FILE * tfile_vfid_p);
+static void qmgr_free_temp_file_work_mem (int tran_index,
+					  QMGR_TEMP_FILE * tfile_vfid_p);
 
 #if defined (SERVER_MODE)
 static void qmgr_execute_async_select (THREAD_ENTRY * thread_p,
@@ -230,17 +255,40 @@ static QFILE_LIST_ID *qmgr_process_async_select (THREAD_ENTRY * thread_p,
 						 QMGR_QUERY_ENTRY * q_ptr,
 						 int dbval_cnt,
 						 const DB_VALUE * dbval_ptr);
+static void qmgr_release_stream_producer (QMGR_QUERY_ENTRY * query_p);
 #endif
 
 static bool
 qmgr_is_page_in_temp_file_buffer (PAGE_PTR page_p,
 				  QMGR_TEMP_FILE * temp_file_p)
 {
-  return (temp_file_p != NULL
-	  && temp_file_p->membuf_last >= 0
-	  && temp_file_p->membuf
-	  && page_p >= temp_file_p->membuf[0]
-	  && page_p <= temp_file_p->membuf[temp_file_p->membuf_last]);
+  QMGR_WORK_MEM_CHUNK *chunk_p;
+  int last;
+
+  if (temp_file_p == NULL || temp_file_p->membuf_last < 0
+      || temp_file_p->membuf == NULL)
+    {
+      return false;
+    }
+
+  /* the pages allocated with the temp file are contiguous */
+  last = MIN (temp_file_p->membuf_last, PRM_TEMP_MEM_BUFFER_PAGES - 1);
+  if (last >= 0 && page_p >= temp_file_p->membuf[0]
+      && page_p <= temp_file_p->membuf[last])
+    {
+      return true;
+    }
+
+  for (chunk_p = temp_file_p->work_mem_chunks; chunk_p != NULL;
+       chunk_p = chunk_p->next)
+    {
+      if (page_p >= chunk_p->first_page && page_p <= chunk_p->last_page)
+	{
+	  return true;
+	}
+    }
+
+  return false;
 }
 
 
@@ -827,6 +875,12 @@ qmgr_initialize_tran_entry (QMGR_TRAN_ENTRY * tran_entry_p)
 #endif
 
   tran_entry_p->modified_classes_p = NULL;
+  tran_entry_p->profile_on = false;
+  tran_entry_p->profile_started_stats = false;
+  tran_entry_p->profile_p = NULL;
+  tran_entry_p->work_mem_pages = 0;
+  tran_entry_p->work_mem_peak = 0;
+  tran_entry_p->work_mem_spill_pages = 0;
   qmgr_initialize_mutex (&tran_entry_p->lock);
 }
 
@@ -936,6 +990,10 @@ qmgr_free_tran_entries (THREAD_ENTRY * thread_p)
     {
       qmgr_destroy_mutex (&tran_entry_p->lock);
       qmgr_free_query_entry_list (thread_p, tran_entry_p->query_entry_list_p);
+      if (tran_entry_p->profile_p != NULL)
+	{
+	  free_and_init (tran_entry_p->profile_p);
+	}
       tran_entry_p++;
     }
 
@@ -1854,8 +1912,6 @@ xqmgr_execute_query (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id_p,
 
 	}
 #endif
-      /* free xasl_stream allocated in the qfile_load_xasl() */
-      db_private_free_and_init (thread_p, query_p->xasl_data);
       /* ends for remote scan */
 
       /* check the number of the host variables for this XASL */
@@ -1877,6 +1933,14 @@ xqmgr_execute_query (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id_p,
 	  *flag_p &= ~ASYNC_EXEC;
 	}
 #endif
+
+      /* a synchronous query keeps the XASL stream until it is done, so that
+         a parallel scan can unpack private copies of the plan from it */
+      if (!is_sync_query)
+	{
+	  /* free xasl_stream allocated in the qfile_load_xasl() */
+	  db_private_free_and_init (thread_p, query_p->xasl_data);
+	}
     }
 
   /* If we've got the cached result, return it. Else, process the query */
@@ -2133,6 +2197,12 @@ end:
       query_p->xasl = NULL;
     }
 
+  /* free xasl_stream allocated in the qfile_load_xasl() */
+  if (query_p && query_p->xasl_data)
+    {
+      db_private_free_and_init (thread_p, query_p->xasl_data);
+    }
+
   /* save XASL tree */
   if (is_sync_query && cache_clone_p)
     {
@@ -2441,6 +2511,7 @@ xqmgr_end_query (THREAD_ENTRY * thread_p, QUERY_ID query_id)
       logtb_set_tran_index_interrupt (thread_p, tran_index, true);
       query_p->interrupt = true;
       query_p->propagate_interrupt = false;
+      qmgr_release_stream_producer (query_p);
       qmgr_unlock_mutex (&tran_entry_p->lock);
       query_p->nwaits++;
 
@@ -2596,6 +2667,311 @@ xqmgr_dump_query_cache (THREAD_ENTRY * thread_p, FILE * out_fp)
   (void) qfile_dump_list_cache_internal (thread_p, out_fp);
 }
 
+/*
+ * xqmgr_set_query_profile () - Turn the query profile of the transaction
+ *                              on or off
+ *   return: NO_ERROR, or ER_code
+ *   on(in): true to profile the following queries
+ *
+ * Note: The page and lock counters of the profile come from the execution
+ *       statistics of the transaction; they are started here unless the
+ *       client has already started them.
+ */
+int
+xqmgr_set_query_profile (THREAD_ENTRY * thread_p, bool on)
+{
+  QMGR_TRAN_ENTRY *tran_entry_p;
+  int tran_index;
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  tran_entry_p = &qmgr_Query_table.tran_entries_p[tran_index];
+
+  if (on)
+    {
+      if (!tran_entry_p->profile_on && mnt_server_get_stats (thread_p) == NULL)
+	{
+	  if (xmnt_server_start_stats (thread_p, false) != NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
+	  tran_entry_p->profile_started_stats = true;
+	}
+      tran_entry_p->profile_on = true;
+    }
+  else
+    {
+      if (tran_entry_p->profile_started_stats)
+	{
+	  xmnt_server_stop_stats (thread_p);
+	  tran_entry_p->profile_started_stats = false;
+	}
+      tran_entry_p->profile_on = false;
+      qmgr_save_query_profile (thread_p, NULL);
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * xqmgr_dump_query_profile () - Dump the profile of the last query of the
+ *                               transaction
+ *   return:
+ *   outfp(in)  :
+ *
+ * Note: The profile is dumped once; a statement which does not execute a
+ *       query dumps nothing.
+ */
+void
+xqmgr_dump_query_profile (THREAD_ENTRY * thread_p, FILE * out_fp)
+{
+  QMGR_TRAN_ENTRY *tran_entry_p;
+  char *profile_p;
+  int tran_index;
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  tran_entry_p = &qmgr_Query_table.tran_entries_p[tran_index];
+
+  qmgr_lock_mutex (thread_p, &tran_entry_p->lock);
+  profile_p = tran_entry_p->profile_p;
+  tran_entry_p->profile_p = NULL;
+  qmgr_unlock_mutex (&tran_entry_p->lock);
+
+  if (profile_p != NULL)
+    {
+      fputs (profile_p, out_fp);
+      free_and_init (profile_p);
+    }
+}
+
+/*
+ * qmgr_is_query_profile_on () - Are the queries of the transaction profiled?
+ *   return: true or false
+ */
+bool
+qmgr_is_query_profile_on (THREAD_ENTRY * thread_p)
+{
+  int tran_index;
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  if (tran_index < 0 || tran_index >= qmgr_Query_table.num_trans)
+    {
+      return false;
+    }
+
+  return qmgr_Query_table.tran_entries_p[tran_index].profile_on;
+}
+
+/*
+ * qmgr_save_query_profile () - Keep the profile of the last query until
+ *                              the client asks for it
+ *   return:
+ *   profile_p(in): profile text allocated with malloc, or NULL
+ */
+void
+qmgr_save_query_profile (THREAD_ENTRY * thread_p, char *profile_p)
+{
+  QMGR_TRAN_ENTRY *tran_entry_p;
+  char *old_profile_p;
+  int tran_index;
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  tran_entry_p = &qmgr_Query_table.tran_entries_p[tran_index];
+
+  qmgr_lock_mutex (thread_p, &tran_entry_p->lock);
+  old_profile_p = tran_entry_p->profile_p;
+  tran_entry_p->profile_p = profile_p;
+  qmgr_unlock_mutex (&tran_entry_p->lock);
+
+  if (old_profile_p != NULL)
+    {
+      free_and_init (old_profile_p);
+    }
+}
+
+/*
+ * qmgr_grant_work_mem_pages () - Add to a count of granted pages without
+ *                                going over its limit
+ *   return: number of pages granted, 0 .. npages
+ *   used_pages_p(in/out): pages granted so far
+ *   max_pages(in): limit
+ *   npages(in): pages wanted
+ */
+static int
+qmgr_grant_work_mem_pages (int *used_pages_p, int max_pages, int npages)
+{
+  int used_pages, granted;
+
+  do
+    {
+      used_pages = *(volatile int *) used_pages_p;
+      granted = MIN (npages, max_pages - used_pages);
+      if (granted <= 0)
+	{
+	  return 0;
+	}
+    }
+  while (!ATOMIC_CAS_32 (used_pages_p, used_pages, used_pages + granted));
+
+  return granted;
+}
+
+/*
+ * qmgr_reserve_work_mem () - Grant private memory to the queries of the
+ *                            transaction
+ *   return: number of pages granted, 0 .. npages
+ *   npages(in): pages wanted
+ *
+ * Note: The queries of a transaction hold at most PRM_QUERY_WORK_MEM_PAGES
+ *       pages and all of them together at most PRM_WORK_MEM_PAGES, for
+ *       intermediate list files and sort buffers. What is not granted has to
+ *       be spilled to temp volumes by the caller. The pages are given back
+ *       with qmgr_release_work_mem ().
+ */
+int
+qmgr_reserve_work_mem (THREAD_ENTRY * thread_p, int npages)
+{
+  QMGR_TRAN_ENTRY *tran_entry_p;
+  int tran_index, granted, server_granted;
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  if (npages <= 0 || tran_index < 0
+      || tran_index >= qmgr_Query_table.num_trans)
+    {
+      return 0;
+    }
+  tran_entry_p = &qmgr_Query_table.tran_entries_p[tran_index];
+
+  granted = qmgr_grant_work_mem_pages (&tran_entry_p->work_mem_pages,
+				       PRM_QUERY_WORK_MEM_PAGES, npages);
+  if (granted <= 0)
+    {
+      return 0;
+    }
+
+  server_granted = qmgr_grant_work_mem_pages (&qmgr_Query_table.
+					      work_mem_pages,
+					      PRM_WORK_MEM_PAGES, granted);
+  if (server_granted < granted)
+    {
+      (void) ATOMIC_INC_32 (&tran_entry_p->work_mem_pages,
+			    server_granted - granted);
+      granted = server_granted;
+    }
+
+  /* not exact under concurrent grants, but good enough for a statistic */
+  if (tran_entry_p->work_mem_pages > tran_entry_p->work_mem_peak)
+    {
+      tran_entry_p->work_mem_peak = tran_entry_p->work_mem_pages;
+    }
+
+  return granted;
+}
+
+/*
+ * qmgr_return_work_mem () - Give back work memory granted to a transaction
+ *   return:
+ *   tran_index(in):
+ *   npages(in):
+ */
+static void
+qmgr_return_work_mem (int tran_index, int npages)
+{
+  if (npages <= 0 || tran_index < 0
+      || tran_index >= qmgr_Query_table.num_trans)
+    {
+      return;
+    }
+
+  (void) ATOMIC_INC_32 (&qmgr_Query_table.tran_entries_p[tran_index].
+			work_mem_pages, -npages);
+  (void) ATOMIC_INC_32 (&qmgr_Query_table.work_mem_pages, -npages);
+}
+
+/*
+ * qmgr_release_work_mem () - Give back work memory granted by
+ *                            qmgr_reserve_work_mem ()
+ *   return:
+ *   npages(in):
+ */
+void
+qmgr_release_work_mem (THREAD_ENTRY * thread_p, int npages)
+{
+  qmgr_return_work_mem (LOG_FIND_THREAD_TRAN_INDEX (thread_p), npages);
+}
+
+/*
+ * qmgr_add_work_mem_spill () - Count pages of intermediate results which
+ *                              did not fit in the work memory
+ *   return:
+ *   npages(in):
+ */
+void
+qmgr_add_work_mem_spill (THREAD_ENTRY * thread_p, int npages)
+{
+  int tran_index, i;
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  if (tran_index >= 0 && tran_index < qmgr_Query_table.num_trans)
+    {
+      (void) ATOMIC_INC_32 (&qmgr_Query_table.tran_entries_p[tran_index].
+			    work_mem_spill_pages, npages);
+    }
+
+  for (i = 0; i < npages; i++)
+    {
+      mnt_qm_spill_pages (thread_p);
+    }
+}
+
+/*
+ * qmgr_start_work_mem_stats () - Start the work memory statistics of a query
+ *   return:
+ */
+void
+qmgr_start_work_mem_stats (THREAD_ENTRY * thread_p)
+{
+  QMGR_TRAN_ENTRY *tran_entry_p;
+  int tran_index;
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  if (tran_index < 0 || tran_index >= qmgr_Query_table.num_trans)
+    {
+      return;
+    }
+  tran_entry_p = &qmgr_Query_table.tran_entries_p[tran_index];
+
+  /* the results of earlier queries may still hold some */
+  tran_entry_p->work_mem_peak = tran_entry_p->work_mem_pages;
+  tran_entry_p->work_mem_spill_pages = 0;
+}
+
+/*
+ * qmgr_get_work_mem_stats () - Work memory statistics of the last query
+ *   return:
+ *   peak_pages(out): most work memory pages held
+ *   spill_pages(out): pages spilled to temp volumes
+ */
+void
+qmgr_get_work_mem_stats (THREAD_ENTRY * thread_p, int *peak_pages,
+			 int *spill_pages)
+{
+  QMGR_TRAN_ENTRY *tran_entry_p;
+  int tran_index;
+
+  *peak_pages = 0;
+  *spill_pages = 0;
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  if (tran_index < 0 || tran_index >= qmgr_Query_table.num_trans)
+    {
+      return;
+    }
+  tran_entry_p = &qmgr_Query_table.tran_entries_p[tran_index];
+
+  *peak_pages = tran_entry_p->work_mem_peak;
+  *spill_pages = tran_entry_p->work_mem_spill_pages;
+}
+
 /*
  *       	       TRANSACTION COORDINATION ROUTINES
  */
@@ -2695,6 +3071,23 @@ qmgr_clear_trans_wakeup (THREAD_ENTRY * thread_p, int tran_index,
       tran_entry_p->modified_classes_p = NULL;
     }
 
+  /* the profile setting belongs to the client of the transaction */
+  if (is_tran_died)
+    {
+      if (tran_entry_p->profile_p != NULL)
+	{
+	  free_and_init (tran_entry_p->profile_p);
+	}
+      if (tran_entry_p->profile_started_stats)
+	{
+	  /* otherwise the statistics of the index would be kept on, and
+	     with them the statistics of the whole server */
+	  mnt_server_stop_tran_stats (tran_index);
+	  tran_entry_p->profile_started_stats = false;
+	}
+      tran_entry_p->profile_on = false;
+    }
+
   qmgr_unlock_mutex (&tran_entry_p->lock);
 
   if (tran_entry_p->query_entry_list_p == NULL)
@@ -3207,8 +3600,17 @@ qmgr_get_new_page (THREAD_ENTRY * thread_p, VPID * vpid_p,
       return NULL;
     }
 
+  if (tfile_vfid_p->membuf_last >= tfile_vfid_p->membuf_npages - 1
+      && tfile_vfid_p->membuf != NULL
+      && VFID_ISNULL (&tfile_vfid_p->temp_vfid))
+    {
+      /* memory buffer is full; try to grow it out of the work memory
+         before spilling to a temp volume */
+      (void) qmgr_extend_temp_file_membuf (thread_p, tfile_vfid_p);
+    }
+
   /* first page, return memory buffer instead real temp file page */
-  if (tfile_vfid_p->membuf_last < PRM_TEMP_MEM_BUFFER_PAGES - 1)
+  if (tfile_vfid_p->membuf_last < tfile_vfid_p->membuf_npages - 1)
     {
       vpid_p->volid = NULL_VOLID;
       vpid_p->pageid = ++(tfile_vfid_p->membuf_last);
@@ -3241,6 +3643,11 @@ qmgr_get_new_page (THREAD_ENTRY * thread_p, VPID * vpid_p,
 		  ER_QPROC_OUT_OF_TEMP_SPACE, 0);
 	}
     }
+  else if (tfile_vfid_p->membuf != NULL)
+    {
+      /* an intermediate result did not fit in memory */
+      qmgr_add_work_mem_spill (thread_p, 1);
+    }
 
   return page_p;
 }
@@ -3423,6 +3830,126 @@ qmgr_allocate_tempfile_with_buffer (void)
   return tempfile_p;
 }
 
+/*
+ * qmgr_extend_temp_file_membuf () - Add work memory pages to the memory
+ *                                   buffer of a temp file
+ *   return: NO_ERROR, or ER_FAILED if no page could be added
+ *   tfile_vfid_p(in):
+ *
+ * Note: The new pages are addressed like the first PRM_TEMP_MEM_BUFFER_PAGES
+ *       ones, by (NULL_VOLID, index in membuf). Since the page pointers
+ *       embedded in the temp file have no room for them, membuf is moved to
+ *       an array large enough for the whole query grant the first time.
+ *       A failure is not an error; the caller spills to a temp volume.
+ */
+static int
+qmgr_extend_temp_file_membuf (THREAD_ENTRY * thread_p,
+			      QMGR_TEMP_FILE * tfile_vfid_p)
+{
+  QMGR_WORK_MEM_CHUNK *chunk_p;
+  PAGE_PTR *membuf, page_p;
+  int max_npages, npages, i;
+  size_t size;
+  QFILE_PAGE_HEADER pgheader = { 0, NULL_PAGEID, NULL_PAGEID, 0, NULL_PAGEID,
+    NULL_VOLID, NULL_VOLID, NULL_VOLID
+  };
+
+  max_npages = PRM_TEMP_MEM_BUFFER_PAGES + PRM_QUERY_WORK_MEM_PAGES;
+  npages = MIN (QMGR_WORK_MEM_CHUNK_PAGES,
+		max_npages - tfile_vfid_p->membuf_npages);
+  npages = qmgr_reserve_work_mem (thread_p, npages);
+  if (npages <= 0)
+    {
+      return ER_FAILED;
+    }
+
+  if (tfile_vfid_p->work_mem_chunks == NULL)
+    {
+      membuf = (PAGE_PTR *) malloc (sizeof (PAGE_PTR) * max_npages);
+      if (membuf == NULL)
+	{
+	  qmgr_release_work_mem (thread_p, npages);
+	  return ER_FAILED;
+	}
+      memcpy (membuf, tfile_vfid_p->membuf,
+	      sizeof (PAGE_PTR) * tfile_vfid_p->membuf_npages);
+    }
+  else
+    {
+      membuf = tfile_vfid_p->membuf;
+    }
+
+  size = DB_ALIGN (sizeof (QMGR_WORK_MEM_CHUNK), MAX_ALIGNMENT);
+  size += (size_t) DB_PAGESIZE *npages;
+  chunk_p = (QMGR_WORK_MEM_CHUNK *) malloc (size);
+  if (chunk_p == NULL)
+    {
+      if (membuf != tfile_vfid_p->membuf)
+	{
+	  free_and_init (membuf);
+	}
+      qmgr_release_work_mem (thread_p, npages);
+      return ER_FAILED;
+    }
+
+  page_p = (PAGE_PTR) chunk_p + DB_ALIGN (sizeof (QMGR_WORK_MEM_CHUNK),
+					  MAX_ALIGNMENT);
+  chunk_p->npages = npages;
+  chunk_p->first_page = page_p;
+  for (i = 0; i < npages; i++)
+    {
+      membuf[tfile_vfid_p->membuf_npages + i] = page_p;
+      qmgr_put_page_header (page_p, &pgheader);
+      page_p += DB_PAGESIZE;
+    }
+  chunk_p->last_page = page_p - DB_PAGESIZE;
+
+  /* other threads may be reading the list file; publish the pages before
+     they can be handed out */
+  chunk_p->next = tfile_vfid_p->work_mem_chunks;
+  tfile_vfid_p->membuf = membuf;
+  tfile_vfid_p->work_mem_chunks = chunk_p;
+  MEMORY_BARRIER ();
+  tfile_vfid_p->membuf_npages += npages;
+
+  return NO_ERROR;
+}
+
+/*
+ * qmgr_free_temp_file_work_mem () - Give back the work memory pages of a
+ *                                   temp file
+ *   return:
+ *   tran_index(in): transaction the pages were granted to
+ *   tfile_vfid_p(in):
+ */
+static void
+qmgr_free_temp_file_work_mem (int tran_index, QMGR_TEMP_FILE * tfile_vfid_p)
+{
+  QMGR_WORK_MEM_CHUNK *chunk_p, *next_chunk_p;
+  int npages;
+
+  if (tfile_vfid_p->work_mem_chunks == NULL)
+    {
+      return;
+    }
+
+  npages = 0;
+  for (chunk_p = tfile_vfid_p->work_mem_chunks; chunk_p != NULL;
+       chunk_p = next_chunk_p)
+    {
+      next_chunk_p = chunk_p->next;
+      npages += chunk_p->npages;
+      free_and_init (chunk_p);
+    }
+  tfile_vfid_p->work_mem_chunks = NULL;
+
+  /* membuf was moved out of the temp file by qmgr_extend_temp_file_membuf */
+  free_and_init (tfile_vfid_p->membuf);
+  tfile_vfid_p->membuf_npages = PRM_TEMP_MEM_BUFFER_PAGES;
+
+  qmgr_return_work_mem (tran_index, npages);
+}
+
 /*
  * qmgr_create_new_temp_file () -
  *   return:
@@ -3489,6 +4016,8 @@ qmgr_create_new_temp_file (THREAD_ENTRY * thread_p, QUERY_ID query_id)
 
   tfile_vfid_p->total_count = 0;
   tfile_vfid_p->membuf_last = -1;
+  tfile_vfid_p->membuf_npages = PRM_TEMP_MEM_BUFFER_PAGES;
+  tfile_vfid_p->work_mem_chunks = NULL;
   page_p = (PAGE_PTR) ((PAGE_PTR) tfile_vfid_p->membuf +
 		       DB_ALIGN (sizeof (PAGE_PTR) *
 				 PRM_TEMP_MEM_BUFFER_PAGES, MAX_ALIGNMENT));
@@ -3502,7 +4031,10 @@ qmgr_create_new_temp_file (THREAD_ENTRY * thread_p, QUERY_ID query_id)
 
 #if defined (SERVER_MODE)
   MUTEX_INIT (tfile_vfid_p->membuf_mutex);
+  COND_INIT (tfile_vfid_p->stream_cond);
   tfile_vfid_p->membuf_thread_p = NULL;
+  tfile_vfid_p->stream_lead_pages = 0;
+  tfile_vfid_p->stream_sent_pages = 0;
 #if 0				/* async wakeup */
   tfile_vfid_p->wait_page_ptr = NULL;
 #endif
@@ -3606,10 +4138,15 @@ qmgr_create_result_file (THREAD_ENTRY * thread_p, QUERY_ID query_id)
   tfile_vfid_p->total_count = 0;
   tfile_vfid_p->membuf_last = PRM_TEMP_MEM_BUFFER_PAGES - 1;
   tfile_vfid_p->membuf = NULL;
+  tfile_vfid_p->membuf_npages = PRM_TEMP_MEM_BUFFER_PAGES;
+  tfile_vfid_p->work_mem_chunks = NULL;
 
 #if defined (SERVER_MODE)
   MUTEX_INIT (tfile_vfid_p->membuf_mutex);
+  COND_INIT (tfile_vfid_p->stream_cond);
   tfile_vfid_p->membuf_thread_p = NULL;
+  tfile_vfid_p->stream_lead_pages = 0;
+  tfile_vfid_p->stream_sent_pages = 0;
 #endif
 
 #if 0				/* async wakeup */
@@ -3745,8 +4282,11 @@ qmgr_free_query_temp_file (THREAD_ENTRY * thread_p, QUERY_ID query_id)
 	    }
 	  MUTEX_UNLOCK (temp->membuf_mutex);
 	  MUTEX_DESTROY (temp->membuf_mutex);
+	  COND_DESTROY (temp->stream_cond);
 #endif
 
+	  qmgr_free_temp_file_work_mem (tran_index, temp);
+
 	  if (temp->temp_file_type != FILE_QUERY_AREA)
 	    {
 	      MUTEX_LOCK (rv, qmgr_Query_table.temp_file_free_mutex);
@@ -3850,8 +4390,11 @@ qmgr_free_query_temp_file_by_query_entry (THREAD_ENTRY * thread_p,
 
 	  MUTEX_UNLOCK (temp->membuf_mutex);
 	  MUTEX_DESTROY (temp->membuf_mutex);
+	  COND_DESTROY (temp->stream_cond);
 #endif
 
+	  qmgr_free_temp_file_work_mem (tran_index, temp);
+
 	  if (temp->temp_file_type != FILE_QUERY_AREA)
 	    {
 	      MUTEX_LOCK (rv, qmgr_Query_table.temp_file_free_mutex);
@@ -3966,8 +4509,11 @@ qmgr_free_list_temp_file (THREAD_ENTRY * thread_p, QUERY_ID query_id,
 
       MUTEX_UNLOCK (tfile_vfid_p->membuf_mutex);
       MUTEX_DESTROY (tfile_vfid_p->membuf_mutex);
+      COND_DESTROY (tfile_vfid_p->stream_cond);
 #endif
 
+      qmgr_free_temp_file_work_mem (tran_index, tfile_vfid_p);
+
       if (tfile_vfid_p->temp_file_type != FILE_QUERY_AREA)
 	{
 	  MUTEX_LOCK (rv, qmgr_Query_table.temp_file_free_mutex);
@@ -4356,6 +4902,33 @@ qmgr_interrupt_query (THREAD_ENTRY * thread_p, QUERY_ID query_id)
 
 #if defined (SERVER_MODE)
 
+/*
+ * qmgr_release_stream_producer () - Let a streaming query that waits for its
+ *                                   client go on
+ *   return:
+ *   query_p(in): query entry
+ *
+ * Note: Called when nobody will fetch the pages of the result anymore. The
+ *       callers hold query locks, and the producer takes them while holding
+ *       membuf_mutex, so the condition is signalled without membuf_mutex;
+ *       qfile_wait_for_stream_client() re-checks the limit at least once a
+ *       second, which covers a signal sent just before it waits.
+ */
+static void
+qmgr_release_stream_producer (QMGR_QUERY_ENTRY * query_p)
+{
+  QMGR_TEMP_FILE *tfile_vfid_p;
+
+  if (query_p->list_id == NULL || query_p->list_id->tfile_vfid == NULL)
+    {
+      return;
+    }
+
+  tfile_vfid_p = query_p->list_id->tfile_vfid;
+  tfile_vfid_p->stream_lead_pages = 0;
+  COND_BROADCAST (tfile_vfid_p->stream_cond);
+}
+
 /*
  * xqmgr_sync_query () -
  *   return:
@@ -4420,6 +4993,12 @@ xqmgr_sync_query (THREAD_ENTRY * thread_p, QUERY_ID query_id, int wait,
     {
       if (query_p->query_mode != QUERY_COMPLETED)
 	{
+	  /*
+	   * Nobody fetches pages while we wait for the query to end;
+	   * lift the lead limit or a streaming producer waits forever.
+	   */
+	  qmgr_release_stream_producer (query_p);
+
 	  query_p->nwaits++;
 	  rv = COND_WAIT (query_p->cond, query_p->lock);
 	  query_p->nwaits--;
@@ -4713,6 +5292,8 @@ qmgr_process_async_select (THREAD_ENTRY * thread_p,
   xasl_state.query_id = query_p->query_id;
   /* initialize error line */
   xasl_state.qp_xasl_line = 0;
+  /* async selects are not profiled */
+  xasl_state.profile = false;
 
   /*
    * If this streaming query will require post-processing such as
@@ -4861,6 +5442,13 @@ qmgr_process_async_select (THREAD_ENTRY * thread_p,
 	  return (QFILE_LIST_ID *) NULL;
 	}
 
+      /*
+       * The result pages are shipped to the client while they are being
+       * produced; do not let the query run too far ahead of the client.
+       */
+      query_p->list_id->tfile_vfid->stream_lead_pages =
+	PRM_ASYNC_QUERY_LEAD_PAGES;
+
       /* copy and return query result file identifier */
       if (qfile_copy_list_id (tmp_list_p, query_p->list_id, true) != NO_ERROR)
 	{
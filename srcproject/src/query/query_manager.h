@@ -60,6 +60,19 @@ typedef enum
   QMGR_TRAN_TERMINATED		/* Terminated transaction */
 } QMGR_TRAN_STATUS;
 
+/*
+ * Memory pages a temp file gets from the work memory once its first
+ * PRM_TEMP_MEM_BUFFER_PAGES pages are used up; the pages follow the header.
+ */
+typedef struct qmgr_work_mem_chunk QMGR_WORK_MEM_CHUNK;
+struct qmgr_work_mem_chunk
+{
+  QMGR_WORK_MEM_CHUNK *next;
+  int npages;
+  PAGE_PTR first_page;
+  PAGE_PTR last_page;
+};
+
 typedef struct qmgr_temp_file QMGR_TEMP_FILE;
 struct qmgr_temp_file
 {
@@ -75,9 +88,14 @@ struct qmgr_temp_file
   int total_count;		/* total number of file pages alloc'd */
   int membuf_last;
   PAGE_PTR *membuf;
+  int membuf_npages;		/* # of memory pages, granted ones included */
+  QMGR_WORK_MEM_CHUNK *work_mem_chunks;	/* granted memory pages */
 #ifdef SERVER_MODE
   MUTEX_T membuf_mutex;
   THREAD_ENTRY *membuf_thread_p;
+  int stream_lead_pages;	/* max pages produced ahead of the client */
+  int stream_sent_pages;	/* # of pages sent to the client */
+  COND_T stream_cond;		/* signalled when the client fetches pages */
 #if 0				/* async wakeup */
   PAGE_PTR wait_page_ptr;
 #endif
@@ -211,6 +229,15 @@ extern int qmgr_get_query_error_with_id (THREAD_ENTRY * thread_p,
 extern int qmgr_get_query_error_with_entry (QMGR_QUERY_ENTRY * query_entryp);
 extern void qmgr_set_query_error (THREAD_ENTRY * thread_p, QUERY_ID query_id);
 extern void qmgr_setup_empty_list_file (char *page_buf);
+extern bool qmgr_is_query_profile_on (THREAD_ENTRY * thread_p);
+extern void qmgr_save_query_profile (THREAD_ENTRY * thread_p,
+				     char *profile_p);
+extern int qmgr_reserve_work_mem (THREAD_ENTRY * thread_p, int npages);
+extern void qmgr_release_work_mem (THREAD_ENTRY * thread_p, int npages);
+extern void qmgr_add_work_mem_spill (THREAD_ENTRY * thread_p, int npages);
+extern void qmgr_start_work_mem_stats (THREAD_ENTRY * thread_p);
+extern void qmgr_get_work_mem_stats (THREAD_ENTRY * thread_p,
+				     int *peak_pages, int *spill_pages);
 extern int
 remote_get_list_file_page (THREAD_ENTRY * thread_p,
 			   int remote_node_id,
@@ -5330,6 +5330,172 @@ qdata_evaluate_aggregate_list (THREAD_ENTRY * thread_p,
   return NO_ERROR;
 }
 
+/*
+ * qdata_pack_aggregate_list () - pack the running state of an aggregate list
+ *   return: packed state, or NULL
+ *   agg_list(in): Aggregate expression node list
+ *   size(out)   : size of the packed state
+ *
+ * Note: The state is malloc'ed, not taken from the private heap, so that
+ * it outlives the private heap of the thread that computed it. The caller
+ * frees it. Only COUNT(*), COUNT, SUM, AVG, MIN and MAX without DISTINCT
+ * can be packed.
+ */
+char *
+qdata_pack_aggregate_list (THREAD_ENTRY * thread_p,
+			   AGGREGATE_TYPE * agg_list_p, int *size_p)
+{
+  AGGREGATE_TYPE *agg_p;
+  char *state_p, *ptr;
+  int size;
+
+  size = 0;
+  for (agg_p = agg_list_p; agg_p != NULL; agg_p = agg_p->next)
+    {
+      size += OR_INT_SIZE + or_db_value_size (agg_p->value);
+    }
+
+  state_p = (char *) malloc (MAX (size, OR_INT_SIZE));
+  if (state_p == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY,
+	      1, MAX (size, OR_INT_SIZE));
+      return NULL;
+    }
+
+  ptr = state_p;
+  for (agg_p = agg_list_p; agg_p != NULL; agg_p = agg_p->next)
+    {
+      ptr = or_pack_int (ptr, agg_p->curr_cnt);
+      ptr = or_pack_db_value (ptr, agg_p->value);
+    }
+
+  *size_p = size;
+  return state_p;
+}
+
+/*
+ * qdata_merge_aggregate_list () - merge a packed aggregate state into an
+ *                                 aggregate list
+ *   return: NO_ERROR, or ER_code
+ *   agg_list(in): Aggregate expression node list
+ *   state(in)   : state packed by qdata_pack_aggregate_list () from a
+ *                 list of the same aggregates
+ *
+ * Note: Used to combine the partial results of the threads of a parallel
+ * scan. The merged list is then finalized as usual.
+ */
+int
+qdata_merge_aggregate_list (THREAD_ENTRY * thread_p,
+			    AGGREGATE_TYPE * agg_list_p, char *state_p)
+{
+  AGGREGATE_TYPE *agg_p;
+  DB_VALUE dbval;
+  PR_TYPE *pr_type_p;
+  TP_DOMAIN *result_domain;
+  char *ptr;
+  int curr_cnt;
+  int copy_opr;
+
+  ptr = state_p;
+  for (agg_p = agg_list_p; agg_p != NULL; agg_p = agg_p->next)
+    {
+      ptr = or_unpack_int (ptr, &curr_cnt);
+      ptr = or_unpack_db_value (ptr, &dbval);
+
+      if (agg_p->function == PT_COUNT_STAR)
+	{
+	  agg_p->curr_cnt += curr_cnt;
+	  pr_clear_value (&dbval);
+	  continue;
+	}
+
+      if (curr_cnt < 1 || DB_IS_NULL (&dbval))
+	{
+	  /* the thread found no values */
+	  pr_clear_value (&dbval);
+	  continue;
+	}
+
+      copy_opr = false;
+      switch (agg_p->function)
+	{
+	case PT_COUNT:
+	  DB_MAKE_INT (agg_p->value,
+		       DB_GET_INT (agg_p->value) + DB_GET_INT (&dbval));
+	  break;
+
+	case PT_MIN:
+	  copy_opr = (agg_p->curr_cnt < 1
+		      || (*(agg_p->domain->type->cmpval)) (agg_p->value,
+							   &dbval, NULL, 0,
+							   1, 1, NULL) > 0);
+	  break;
+
+	case PT_MAX:
+	  copy_opr = (agg_p->curr_cnt < 1
+		      || (*(agg_p->domain->type->cmpval)) (agg_p->value,
+							   &dbval, NULL, 0,
+							   1, 1, NULL) < 0);
+	  break;
+
+	case PT_AVG:
+	case PT_SUM:
+	  if (agg_p->curr_cnt < 1)
+	    {
+	      /* take the type of the partial sum, as the first operand
+	         does in qdata_evaluate_aggregate_list () */
+	      if (db_value_domain_init (agg_p->value,
+					DB_VALUE_DOMAIN_TYPE (&dbval),
+					DB_DEFAULT_PRECISION,
+					DB_DEFAULT_SCALE) != NO_ERROR)
+		{
+		  pr_clear_value (&dbval);
+		  return ER_FAILED;
+		}
+	      copy_opr = true;
+	    }
+	  else
+	    {
+	      result_domain = ((agg_p->domain->type->id == DB_TYPE_NUMERIC) ?
+			       NULL : agg_p->domain);
+	      if (qdata_add_dbval (agg_p->value, &dbval, agg_p->value,
+				   result_domain) != NO_ERROR)
+		{
+		  pr_clear_value (&dbval);
+		  return ER_FAILED;
+		}
+	    }
+	  break;
+
+	default:
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE,
+		  0);
+	  pr_clear_value (&dbval);
+	  return ER_FAILED;
+	}
+
+      if (copy_opr)
+	{
+	  /* copy the partial result to aggregate node */
+	  pr_clear_value (agg_p->value);
+	  pr_type_p = PR_TYPE_FROM_ID (DB_VALUE_DOMAIN_TYPE (agg_p->value));
+	  if (pr_type_p == NULL)
+	    {
+	      pr_clear_value (&dbval);
+	      return ER_FAILED;
+	    }
+
+	  (*(pr_type_p->setval)) (agg_p->value, &dbval, true);
+	}
+
+      agg_p->curr_cnt += curr_cnt;
+      pr_clear_value (&dbval);
+    }
+
+  return NO_ERROR;
+}
+
 /*
  * qdata_evaluate_aggregate_optimize () -
  *   return:
@@ -151,6 +151,12 @@ extern int qdata_initialize_aggregate_list (THREAD_ENTRY * thread_p,
 extern int qdata_evaluate_aggregate_list (THREAD_ENTRY * thread_p,
 					  AGGREGATE_TYPE * agg_list,
 					  VAL_DESCR * vd);
+extern char *qdata_pack_aggregate_list (THREAD_ENTRY * thread_p,
+					AGGREGATE_TYPE * agg_list,
+					int *size);
+extern int qdata_merge_aggregate_list (THREAD_ENTRY * thread_p,
+				       AGGREGATE_TYPE * agg_list,
+				       char *state);
 extern int qdata_evaluate_aggregate_optimize (THREAD_ENTRY * thread_p,
 					      AGGREGATE_TYPE * agg_ptr,
 					      HFID * hfid, int node_id);
@@ -169,6 +169,23 @@ static SCAN_CODE scan_handle_single_scan (THREAD_ENTRY * thread_p,
 					  QP_SCAN_FUNC next_scan);
 static SCAN_CODE scan_prev_scan_local (THREAD_ENTRY * thread_p,
 				       SCAN_ID * scan_id);
+static int scan_get_page_range (THREAD_ENTRY * thread_p,
+				HEAP_PAGE_DISPATCHER * dispatcher,
+				VPID * first_vpid, VPID * end_vpid);
+static SCAN_CODE scan_start_heap_page_range (THREAD_ENTRY * thread_p,
+					     HEAP_SCAN_ID * hsidp);
+static SCAN_CODE scan_next_heap_page_range (THREAD_ENTRY * thread_p,
+					    SCAN_ID * scan_id,
+					    RECDES * recdes);
+static HEAP_SCAN_BATCH *scan_alloc_heap_batch (THREAD_ENTRY * thread_p,
+					       PRED_EXPR * pr);
+static SCAN_CODE scan_fill_heap_batch (THREAD_ENTRY * thread_p,
+				       SCAN_ID * scan_id);
+static SCAN_CODE scan_next_heap_batch (THREAD_ENTRY * thread_p,
+				       SCAN_ID * scan_id,
+				       FILTER_INFO * data_filter);
+static int scan_read_heap_rest_values (THREAD_ENTRY * thread_p,
+				       SCAN_ID * scan_id, RECDES * recdes);
 
 
 /*
@@ -1578,6 +1595,9 @@ scan_init_scan_id (SCAN_ID * scan_id, int readonly_scan, int fixed,
   /* value list and descriptor */
   scan_id->val_list = val_list;	/* points to the XASL tree */
   scan_id->vd = vd;		/* set value descriptor pointer */
+
+  /* the caller turns the statistics on when the query is profiled */
+  memset (&scan_id->stats, 0, sizeof (SCAN_STATS));
 }
 
 /*
@@ -1672,6 +1692,24 @@ scan_open_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
 
   hsidp->lock_hint = lock_hint;
 
+  /* a parallel scan attaches its page dispatcher after the open */
+  hsidp->dispatcher = NULL;
+  hsidp->skip_lock = false;
+  VPID_SET_NULL (&hsidp->range_end_vpid);
+
+  /* a data filter made of simple comparisons is evaluated over the rows
+     of a page together */
+  hsidp->batch = NULL;
+  if (pr != NULL && readonly_scan && fixed && !grouped)
+    {
+      hsidp->batch = scan_alloc_heap_batch (thread_p, pr);
+    }
+
+  /* scans of a heap large enough to flush the page buffer do not keep
+     their pages in the buffer */
+  hsidp->bulk_read =
+    pgbuf_is_bulk_read_size (file_get_numpages (thread_p, &hfid->vfid));
+
   return NO_ERROR;
 }
 
@@ -2212,6 +2250,10 @@ scan_start_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
   LLIST_SCAN_ID *llsidp;
   SET_SCAN_ID *ssidp;
 
+  if (scan_id->stats.on)
+    {
+      scan_id->stats.num_starts++;
+    }
 
   switch (scan_id->type)
     {
@@ -2220,6 +2262,11 @@ scan_start_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 
       hsidp = &scan_id->s.hsid;
       UT_CAST_TO_NULL_HEAP_OID (&hsidp->hfid, &hsidp->curr_oid);
+      if (hsidp->batch != NULL)
+	{
+	  hsidp->batch->nrecs = 0;
+	  hsidp->batch->curr = 0;
+	}
       if (scan_id->grouped)
 	{
 	  ret = heap_scanrange_start (thread_p, &hsidp->scan_range,
@@ -2231,6 +2278,20 @@ scan_start_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	    }
 	  hsidp->scanrange_inited = true;
 	}
+      else if (hsidp->skip_lock)
+	{
+	  /* a helper of a parallel scan; only latches the heap pages */
+	  ret = heap_scancache_start_without_lock (thread_p,
+						   &hsidp->scan_cache,
+						   &hsidp->hfid,
+						   &hsidp->cls_oid,
+						   scan_id->fixed);
+	  if (ret != NO_ERROR)
+	    {
+	      goto exit_on_error;
+	    }
+	  hsidp->scancache_inited = true;
+	}
       else
 	{
 	  /* A new argument(is_indexscan = false) is appended */
@@ -2426,6 +2487,11 @@ scan_reset_scan_block (THREAD_ENTRY * thread_p, SCAN_ID * s_id)
 	  s_id->position =
 	    (s_id->direction == S_FORWARD) ? S_BEFORE : S_AFTER;
 	  OID_SET_NULL (&s_id->s.hsid.curr_oid);
+	  if (s_id->s.hsid.batch != NULL)
+	    {
+	      s_id->s.hsid.batch->nrecs = 0;
+	      s_id->s.hsid.batch->curr = 0;
+	    }
 	}
       break;
 
@@ -2642,7 +2708,15 @@ scan_end_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	{
 	  if (hsidp->scancache_inited)
 	    {
-	      (void) heap_scancache_end (thread_p, &hsidp->scan_cache);
+	      if (hsidp->skip_lock)
+		{
+		  (void) heap_scancache_end_without_lock (thread_p,
+							  &hsidp->scan_cache);
+		}
+	      else
+		{
+		  (void) heap_scancache_end (thread_p, &hsidp->scan_cache);
+		}
 	    }
 	}
 
@@ -2725,6 +2799,13 @@ scan_close_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
   switch (scan_id->type)
     {
     case S_HEAP_SCAN:
+      if (scan_id->s.hsid.batch != NULL)
+	{
+	  eval_batch_pred_free (thread_p, scan_id->s.hsid.batch->pred);
+	  db_private_free_and_init (thread_p, scan_id->s.hsid.batch);
+	}
+      break;
+
     case S_CLASS_ATTR_SCAN:
       break;
 
@@ -2806,8 +2887,20 @@ scan_next_scan_local (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 			     scan_id->vd, &hsidp->cls_oid,
 			     0, NULL, NULL, NULL);
 
+      if (hsidp->batch != NULL && !scan_id->grouped
+	  && scan_id->direction == S_FORWARD
+	  && scan_id->qualification == QPROC_QUALIFIED)
+	{
+	  return scan_next_heap_batch (thread_p, scan_id, &data_filter);
+	}
+
       while (1)
 	{
+	  if (hsidp->bulk_read)
+	    {
+	      pgbuf_start_bulk_read (thread_p);
+	    }
+
 	  /* get next object */
 	  if (scan_id->grouped)
 	    {
@@ -2826,10 +2919,19 @@ scan_next_scan_local (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	      if (scan_id->direction == S_FORWARD)
 		{
 		  /* move forward */
-		  sp_scan =
-		    heap_next (thread_p, &hsidp->hfid, &hsidp->cls_oid,
-			       &hsidp->curr_oid, &recdes, &hsidp->scan_cache,
-			       scan_id->fixed);
+		  if (hsidp->dispatcher != NULL)
+		    {
+		      /* only the page ranges given by the dispatcher */
+		      sp_scan = scan_next_heap_page_range (thread_p, scan_id,
+							   &recdes);
+		    }
+		  else
+		    {
+		      sp_scan =
+			heap_next (thread_p, &hsidp->hfid, &hsidp->cls_oid,
+				   &hsidp->curr_oid, &recdes,
+				   &hsidp->scan_cache, scan_id->fixed);
+		    }
 		}
 	      else
 		{
@@ -2841,11 +2943,17 @@ scan_next_scan_local (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 		}
 	    }
 
+	  if (hsidp->bulk_read)
+	    {
+	      pgbuf_end_bulk_read (thread_p);
+	    }
+
 	  if (sp_scan != S_SUCCESS)
 	    {
 	      /* scan error or end of scan */
 	      return (sp_scan == S_END) ? S_END : S_ERROR;
 	    }
+	  scan_id->stats.read_rows++;
 
 	  /* evaluate the predicates to see if the object qualifies */
 	  ev_res = eval_data_filter (thread_p, &hsidp->curr_oid, &recdes,
@@ -2893,29 +3001,10 @@ scan_next_scan_local (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 		}
 	    }
 
-	  if (hsidp->rest_regu_list)
+	  if (scan_read_heap_rest_values (thread_p, scan_id, &recdes)
+	      != NO_ERROR)
 	    {
-	      /* read the rest of the values from the heap into the attribute
-	         cache */
-	      if (heap_attrinfo_read_dbvalues (thread_p, &hsidp->curr_oid,
-					       &recdes,
-					       hsidp->rest_attrs.attr_cache)
-		  != NO_ERROR)
-		{
-		  return S_ERROR;
-		}
-
-	      /* fetch the rest of the values from the object instance */
-	      if (scan_id->val_list)
-		{
-		  if (fetch_val_list (thread_p, hsidp->rest_regu_list,
-				      scan_id->vd, &hsidp->cls_oid,
-				      &hsidp->curr_oid, NULL,
-				      PEEK) != NO_ERROR)
-		    {
-		      return S_ERROR;
-		    }
-		}
+	      return S_ERROR;
 	    }
 
 	  return S_SUCCESS;
@@ -3183,6 +3272,7 @@ scan_next_scan_local (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	      /* scan error or end of scan */
 	      return (sp_scan == S_END) ? S_END : S_ERROR;
 	    }
+	  scan_id->stats.read_rows++;
 
 	  /* We need to check if the instance is from the class that we
 	     are interested in. Index scans that use B-tree for unique
@@ -3344,6 +3434,7 @@ scan_next_scan_local (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
       while ((qp_scan = qfile_scan_list_next (thread_p, &llsidp->lsid,
 					      &tplrec, PEEK)) == S_SUCCESS)
 	{
+	  scan_id->stats.read_rows++;
 
 	  /* fetch the values for the predicate from the tuple */
 	  if (scan_id->val_list)
@@ -3748,7 +3839,445 @@ exit_on_error:
 SCAN_CODE
 scan_next_scan (THREAD_ENTRY * thread_p, SCAN_ID * s_id)
 {
-  return scan_handle_single_scan (thread_p, s_id, scan_next_scan_local);
+  SCAN_STATS begin;
+  SCAN_CODE status;
+
+  if (!s_id->stats.on)
+    {
+      return scan_handle_single_scan (thread_p, s_id, scan_next_scan_local);
+    }
+
+  scan_stats_begin (thread_p, &begin);
+  status = scan_handle_single_scan (thread_p, s_id, scan_next_scan_local);
+  scan_stats_end (thread_p, &begin, &s_id->stats);
+
+  if (status == S_SUCCESS)
+    {
+      s_id->stats.qualified_rows++;
+    }
+
+  return status;
+}
+
+/*
+ * scan_stats_begin () - Take the counters at the beginning of a profiled
+ *                       operation
+ *   return: none
+ *   begin(out): current time and counters of the transaction
+ *
+ * Note: The page and lock counters come from the execution statistics of
+ *       the transaction, which are started when profiling is turned on.
+ */
+void
+scan_stats_begin (THREAD_ENTRY * thread_p, SCAN_STATS * begin)
+{
+  MNT_SERVER_EXEC_STATS *mnt_stats;
+  struct timeval now;
+
+  (void) gettimeofday (&now, NULL);
+  begin->elapsed_usec = (UINT64) now.tv_sec * 1000000 + now.tv_usec;
+
+  mnt_stats = mnt_server_get_stats (thread_p);
+  if (mnt_stats != NULL)
+    {
+      begin->num_fetches = mnt_stats->pb_num_fetches;
+      begin->num_ioreads = mnt_stats->pb_num_ioreads;
+      begin->num_lock_waits = mnt_stats->lk_num_waited_on_pages
+	+ mnt_stats->lk_num_waited_on_objects;
+    }
+  else
+    {
+      begin->num_fetches = 0;
+      begin->num_ioreads = 0;
+      begin->num_lock_waits = 0;
+    }
+}
+
+/*
+ * scan_stats_end () - Add what a profiled operation consumed to its
+ *                     statistics
+ *   return: none
+ *   begin(in): counters taken by scan_stats_begin ()
+ *   stats(in/out): statistics of the scan or XASL node
+ */
+void
+scan_stats_end (THREAD_ENTRY * thread_p, const SCAN_STATS * begin,
+		SCAN_STATS * stats)
+{
+  SCAN_STATS end;
+
+  scan_stats_begin (thread_p, &end);
+
+  stats->elapsed_usec += end.elapsed_usec - begin->elapsed_usec;
+  /* the transaction counters are 32 bits wide and may wrap around */
+  stats->num_fetches +=
+    (unsigned int) (end.num_fetches - begin->num_fetches);
+  stats->num_ioreads +=
+    (unsigned int) (end.num_ioreads - begin->num_ioreads);
+  stats->num_lock_waits +=
+    (unsigned int) (end.num_lock_waits - begin->num_lock_waits);
+}
+
+/*
+ * scan_get_page_range () - take the next range of heap pages
+ *   return: NO_ERROR, or ER_code
+ *   dispatcher(in): page dispatcher of the parallel scan
+ *   first_vpid(out): first page of the range, NULL when no pages are left
+ *   end_vpid(out): page following the range, NULL at the end of the heap
+ */
+static int
+scan_get_page_range (THREAD_ENTRY * thread_p,
+		     HEAP_PAGE_DISPATCHER * dispatcher, VPID * first_vpid,
+		     VPID * end_vpid)
+{
+  int ret = NO_ERROR;
+#if defined (SERVER_MODE)
+  int rv;
+#endif /* SERVER_MODE */
+
+  MUTEX_LOCK (rv, dispatcher->lock);
+  *first_vpid = dispatcher->next_vpid;
+  if (!VPID_ISNULL (&dispatcher->next_vpid))
+    {
+      ret = heap_vpid_skip (thread_p, &dispatcher->hfid,
+			    &dispatcher->next_vpid, dispatcher->range_pages);
+      if (ret != NO_ERROR)
+	{
+	  /* stop handing out pages; the failing scan reports the error */
+	  VPID_SET_NULL (&dispatcher->next_vpid);
+	}
+    }
+  *end_vpid = dispatcher->next_vpid;
+  MUTEX_UNLOCK (dispatcher->lock);
+
+  return ret;
+}
+
+/*
+ * scan_start_heap_page_range () - position a parallel heap scan at the
+ *                                 start of its next range of pages
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   hsidp(in/out): Heap scan identifier
+ */
+static SCAN_CODE
+scan_start_heap_page_range (THREAD_ENTRY * thread_p, HEAP_SCAN_ID * hsidp)
+{
+  VPID first_vpid;
+
+  if (scan_get_page_range (thread_p, hsidp->dispatcher, &first_vpid,
+			   &hsidp->range_end_vpid) != NO_ERROR)
+    {
+      return S_ERROR;
+    }
+  if (VPID_ISNULL (&first_vpid))
+    {
+      return S_END;
+    }
+
+  hsidp->curr_oid.volid = first_vpid.volid;
+  hsidp->curr_oid.pageid = first_vpid.pageid;
+  hsidp->curr_oid.slotid = -1;
+
+  return S_SUCCESS;
+}
+
+/*
+ * scan_next_heap_page_range () - move a parallel heap scan forward
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   scan_id(in/out): Scan identifier
+ *   recdes(out): record descriptor of the next object
+ *
+ * Note: The scan reads the current range of pages up to its end, then
+ * takes the next range from the dispatcher. S_END is returned once the
+ * dispatcher has no pages left.
+ */
+static SCAN_CODE
+scan_next_heap_page_range (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
+			   RECDES * recdes)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  SCAN_CODE sp_scan;
+
+  while (1)
+    {
+      if (OID_ISNULL (&hsidp->curr_oid))
+	{
+	  /* the current range is done */
+	  sp_scan = scan_start_heap_page_range (thread_p, hsidp);
+	  if (sp_scan != S_SUCCESS)
+	    {
+	      return sp_scan;
+	    }
+	}
+
+      sp_scan = heap_next_until (thread_p, &hsidp->hfid, &hsidp->cls_oid,
+				 &hsidp->curr_oid, recdes, &hsidp->scan_cache,
+				 scan_id->fixed, &hsidp->range_end_vpid);
+      if (sp_scan != S_END)
+	{
+	  return sp_scan;
+	}
+    }
+}
+
+/*
+ * scan_read_heap_rest_values () - fetch the values of the attributes not
+ *                                 used by the predicates of a heap scan
+ *   return: NO_ERROR, or ER_code
+ *   scan_id(in/out): Scan identifier
+ *   recdes(in): record of the current object
+ */
+static int
+scan_read_heap_rest_values (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
+			    RECDES * recdes)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+
+  if (hsidp->rest_regu_list)
+    {
+      /* read the rest of the values from the heap into the attribute
+         cache */
+      if (heap_attrinfo_read_dbvalues (thread_p, &hsidp->curr_oid, recdes,
+				       hsidp->rest_attrs.attr_cache)
+	  != NO_ERROR)
+	{
+	  return ER_FAILED;
+	}
+
+      /* fetch the rest of the values from the object instance */
+      if (scan_id->val_list)
+	{
+	  if (fetch_val_list (thread_p, hsidp->rest_regu_list,
+			      scan_id->vd, &hsidp->cls_oid,
+			      &hsidp->curr_oid, NULL, PEEK) != NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
+	}
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * scan_alloc_heap_batch () - allocate the batch of a heap scan
+ *   return: batch, or NULL if the data filter is not evaluated in batch
+ *   pr(in): data filter of the scan
+ */
+static HEAP_SCAN_BATCH *
+scan_alloc_heap_batch (THREAD_ENTRY * thread_p, PRED_EXPR * pr)
+{
+  HEAP_SCAN_BATCH *batch;
+  EVAL_BATCH_PRED *batch_pred;
+
+  batch_pred = eval_batch_pred_create (thread_p, pr);
+  if (batch_pred == NULL)
+    {
+      return NULL;
+    }
+
+  batch = (HEAP_SCAN_BATCH *) db_private_alloc (thread_p,
+						sizeof (HEAP_SCAN_BATCH));
+  if (batch == NULL)
+    {
+      eval_batch_pred_free (thread_p, batch_pred);
+      return NULL;
+    }
+
+  batch->pred = batch_pred;
+  batch->nrecs = 0;
+  batch->curr = 0;
+
+  return batch;
+}
+
+/*
+ * scan_fill_heap_batch () - peek the next rows of a heap scan and evaluate
+ *                           the data filter over them
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   scan_id(in/out): Scan identifier
+ *
+ * Note: The rows of a batch come from one page, which stays fixed in the
+ * scan cache while they are returned. An object stored away from its home
+ * makes a batch of its own.
+ */
+static SCAN_CODE
+scan_fill_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  HEAP_SCAN_BATCH *batch = hsidp->batch;
+  const VPID *stop_vpid = NULL;
+  SCAN_CODE sp_scan;
+  int i;
+
+  /* continue after the last row of the previous batch */
+  if (batch->nrecs > 0)
+    {
+      hsidp->curr_oid = batch->oids[batch->nrecs - 1];
+    }
+  batch->nrecs = 0;
+  batch->curr = 0;
+
+  if (hsidp->bulk_read)
+    {
+      pgbuf_start_bulk_read (thread_p);
+    }
+
+  while (1)
+    {
+      if (hsidp->dispatcher != NULL)
+	{
+	  /* only the page ranges given by the dispatcher */
+	  if (OID_ISNULL (&hsidp->curr_oid))
+	    {
+	      sp_scan = scan_start_heap_page_range (thread_p, hsidp);
+	      if (sp_scan != S_SUCCESS)
+		{
+		  break;
+		}
+	    }
+	  stop_vpid = &hsidp->range_end_vpid;
+	}
+
+      sp_scan = heap_next_batch (thread_p, &hsidp->hfid, &hsidp->cls_oid,
+				 &hsidp->curr_oid, &hsidp->scan_cache,
+				 stop_vpid, batch->oids, batch->recdes,
+				 EVAL_BATCH_SIZE, &batch->nrecs);
+      if (sp_scan == S_SUCCESS && batch->nrecs == 0)
+	{
+	  /* the next object is not stored at its home */
+	  sp_scan = heap_next_until (thread_p, &hsidp->hfid, &hsidp->cls_oid,
+				     &hsidp->curr_oid, &batch->recdes[0],
+				     &hsidp->scan_cache, scan_id->fixed,
+				     stop_vpid);
+	  if (sp_scan == S_SUCCESS)
+	    {
+	      batch->oids[0] = hsidp->curr_oid;
+	      batch->nrecs = 1;
+	    }
+	}
+
+      if (sp_scan != S_END || hsidp->dispatcher == NULL)
+	{
+	  break;
+	}
+    }
+
+  if (hsidp->bulk_read)
+    {
+      pgbuf_end_bulk_read (thread_p);
+    }
+
+  if (sp_scan != S_SUCCESS)
+    {
+      batch->nrecs = 0;
+      return sp_scan;
+    }
+
+  if (eval_batch_pred_start (thread_p, batch->pred, scan_id->vd) != NO_ERROR)
+    {
+      return S_ERROR;
+    }
+  for (i = 0; i < batch->nrecs; i++)
+    {
+      if (heap_attrinfo_read_dbvalues (thread_p, &batch->oids[i],
+				       &batch->recdes[i],
+				       hsidp->pred_attrs.attr_cache)
+	  != NO_ERROR
+	  || eval_batch_pred_add_row (thread_p, batch->pred,
+				      scan_id->vd) != NO_ERROR)
+	{
+	  return S_ERROR;
+	}
+    }
+  eval_batch_pred_evaluate (batch->pred);
+
+  return S_SUCCESS;
+}
+
+/*
+ * scan_next_heap_batch () - move a heap scan filtered in batch forward
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   scan_id(in/out): Scan identifier
+ *   data_filter(in): data filter of the scan
+ *
+ * Note: The rows the batch could not decide are evaluated by the data
+ * filter one at a time, as the regular heap scan does.
+ */
+static SCAN_CODE
+scan_next_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
+		      FILTER_INFO * data_filter)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  HEAP_SCAN_BATCH *batch = hsidp->batch;
+  RECDES *recdes;
+  SCAN_CODE sp_scan;
+  DB_LOGICAL ev_res;
+  int row;
+
+  while (1)
+    {
+      if (batch->curr >= batch->nrecs)
+	{
+	  sp_scan = scan_fill_heap_batch (thread_p, scan_id);
+	  if (sp_scan != S_SUCCESS)
+	    {
+	      /* scan error or end of scan */
+	      return (sp_scan == S_END) ? S_END : S_ERROR;
+	    }
+	}
+
+      row = batch->curr++;
+      scan_id->stats.read_rows++;
+      if (batch->pred->result[row] == V_FALSE)
+	{
+	  continue;		/* not qualified, continue to the next tuple */
+	}
+
+      hsidp->curr_oid = batch->oids[row];
+      recdes = &batch->recdes[row];
+
+      if (batch->pred->result[row] == V_TRUE)
+	{
+	  /* the attribute cache holds the last row of the batch; read the
+	     predicate values of this row back for its regu variables */
+	  if (hsidp->scan_pred.regu_list && scan_id->val_list)
+	    {
+	      if (heap_attrinfo_read_dbvalues (thread_p, &hsidp->curr_oid,
+					       recdes,
+					       hsidp->pred_attrs.attr_cache)
+		  != NO_ERROR
+		  || fetch_val_list (thread_p, hsidp->scan_pred.regu_list,
+				     scan_id->vd, &hsidp->cls_oid,
+				     &hsidp->curr_oid, NULL,
+				     PEEK) != NO_ERROR)
+		{
+		  return S_ERROR;
+		}
+	    }
+	}
+      else
+	{
+	  /* evaluate the predicates to see if the object qualifies */
+	  ev_res = eval_data_filter (thread_p, &hsidp->curr_oid, recdes,
+				     data_filter);
+	  if (ev_res == V_ERROR)
+	    {
+	      return S_ERROR;
+	    }
+	  if (ev_res != V_TRUE)
+	    {
+	      continue;		/* not qualified, continue to the next tuple */
+	    }
+	}
+
+      if (scan_read_heap_rest_values (thread_p, scan_id, recdes) != NO_ERROR)
+	{
+	  return S_ERROR;
+	}
+
+      return S_SUCCESS;
+    }
 }
 
 /*
@@ -4092,3 +4621,64 @@ scan_finalize (void)
     }
   scan_Iscan_oid_buf_list_count = 0;
 }
+
+/*
+ * scan_init_page_dispatcher () - initialize the page dispatcher of a
+ *                                parallel heap scan
+ *   return: NO_ERROR, or ER_code
+ *   dispatcher(out): page dispatcher
+ *   hfid(in): heap file to scan
+ *   range_pages(in): number of pages handed out at a time
+ */
+int
+scan_init_page_dispatcher (HEAP_PAGE_DISPATCHER * dispatcher,
+			   const HFID * hfid, int range_pages)
+{
+#if defined (SERVER_MODE)
+  if (MUTEX_INIT (dispatcher->lock) != NO_ERROR)
+    {
+      return ER_FAILED;
+    }
+#endif /* SERVER_MODE */
+
+  dispatcher->hfid = *hfid;	/* bitwise copy */
+  dispatcher->next_vpid.volid = hfid->vfid.volid;
+  dispatcher->next_vpid.pageid = hfid->hpgid;
+  dispatcher->range_pages = MAX (range_pages, 1);
+
+  return NO_ERROR;
+}
+
+/*
+ * scan_end_page_dispatcher () - free the page dispatcher of a parallel
+ *                               heap scan
+ *   return: none
+ *   dispatcher(in): page dispatcher
+ */
+void
+scan_end_page_dispatcher (HEAP_PAGE_DISPATCHER * dispatcher)
+{
+#if defined (SERVER_MODE)
+  (void) MUTEX_DESTROY (dispatcher->lock);
+#endif /* SERVER_MODE */
+}
+
+/*
+ * scan_is_page_dispatcher_done () - have all the pages been handed out?
+ *   return: true if there are no pages left
+ *   dispatcher(in): page dispatcher
+ */
+bool
+scan_is_page_dispatcher_done (HEAP_PAGE_DISPATCHER * dispatcher)
+{
+  bool done;
+#if defined (SERVER_MODE)
+  int rv;
+#endif /* SERVER_MODE */
+
+  MUTEX_LOCK (rv, dispatcher->lock);
+  done = VPID_ISNULL (&dispatcher->next_vpid);
+  MUTEX_UNLOCK (dispatcher->lock);
+
+  return done;
+}
@@ -48,6 +48,29 @@ typedef enum
   S_METHOD_SCAN
 } SCAN_TYPE;
 
+/* Hands out runs of consecutive pages of the heap chain to the threads of
+   a parallel heap scan. Each thread takes a new range whenever it has
+   finished the previous one. */
+typedef struct heap_page_dispatcher HEAP_PAGE_DISPATCHER;
+struct heap_page_dispatcher
+{
+  MUTEX_T lock;
+  HFID hfid;			/* heap file identifier */
+  VPID next_vpid;		/* first page of the next range, NULL at end */
+  int range_pages;		/* number of pages in a range */
+};
+
+/* rows of a heap page the data filter is evaluated over together */
+typedef struct heap_scan_batch HEAP_SCAN_BATCH;
+struct heap_scan_batch
+{
+  EVAL_BATCH_PRED *pred;	/* data filter, evaluated in batch */
+  OID oids[EVAL_BATCH_SIZE];	/* objects of the rows */
+  RECDES recdes[EVAL_BATCH_SIZE];	/* records peeked from the page */
+  int nrecs;			/* number of rows in the batch */
+  int curr;			/* next row to return */
+};
+
 typedef struct heap_scan_id HEAP_SCAN_ID;
 struct heap_scan_id
 {
@@ -63,7 +86,12 @@ struct heap_scan_id
   bool caches_inited;		/* are the caches initialized?? */
   bool scancache_inited;
   bool scanrange_inited;
+  bool bulk_read;		/* is the heap read in bulk read mode? */
   int lock_hint;		/* lock hint */
+  HEAP_PAGE_DISPATCHER *dispatcher;	/* page ranges of a parallel scan */
+  bool skip_lock;		/* the class is locked by another thread */
+  VPID range_end_vpid;		/* page following the current range */
+  HEAP_SCAN_BATCH *batch;	/* rows filtered in batch, or NULL */
 };				/* Regular Heap File Scan Identifier */
 
 typedef struct key_val_range KEY_VAL_RANGE;
@@ -169,6 +197,21 @@ struct scan_result_cache_struct
 #define SCAN_CACHE_IS_EMPTY(c)  ((c).buffer == NULL )
 #define SCAN_CACHE_RESET(c)     ((c).buffer=NULL,(c).current=NULL,(c).size=0)
 
+/* execution statistics of a scan or an XASL node for the query profile;
+   times and counters are only gathered while the query is profiled */
+typedef struct scan_stats SCAN_STATS;
+struct scan_stats
+{
+  bool on;			/* gather the statistics */
+  unsigned int num_starts;	/* how many times it was started */
+  UINT64 elapsed_usec;		/* elapsed time in microseconds */
+  UINT64 num_fetches;		/* page fixes */
+  UINT64 num_ioreads;		/* pages read from disk */
+  UINT64 num_lock_waits;	/* lock waits on pages and objects */
+  UINT64 read_rows;		/* rows read */
+  UINT64 qualified_rows;	/* rows qualified */
+};
+
 typedef struct scan_id_struct SCAN_ID;
 struct scan_id_struct
 {
@@ -203,6 +246,7 @@ struct scan_id_struct
   VAL_DESCR *vd;		/* value descriptor */
   SCAN_RESULT_CACHE cache;	/* for scan cache */
   QFILE_LIST_SCAN_ID *scan_id;	/* for list scan */
+  SCAN_STATS stats;		/* statistics for the query profile */
 
   union
   {
@@ -324,7 +368,15 @@ extern SCAN_CODE scan_prev_scan (THREAD_ENTRY * thread_p, SCAN_ID * s_id);
 extern void scan_save_scan_pos (SCAN_ID * s_id, SCAN_POS * scan_pos);
 extern SCAN_CODE scan_jump_scan_pos (THREAD_ENTRY * thread_p, SCAN_ID * s_id,
 				     SCAN_POS * scan_pos);
+extern void scan_stats_begin (THREAD_ENTRY * thread_p, SCAN_STATS * begin);
+extern void scan_stats_end (THREAD_ENTRY * thread_p, const SCAN_STATS * begin,
+			    SCAN_STATS * stats);
 extern void scan_initialize (void);
 extern void scan_finalize (void);
+extern int scan_init_page_dispatcher (HEAP_PAGE_DISPATCHER * dispatcher,
+				      const HFID * hfid, int range_pages);
+extern void scan_end_page_dispatcher (HEAP_PAGE_DISPATCHER * dispatcher);
+extern bool scan_is_page_dispatcher_done (HEAP_PAGE_DISPATCHER *
+					  dispatcher);
 
 #endif /* _SCAN_MANAGER_H_ */
@@ -1650,6 +1650,7 @@ stx_build_xasl_node (THREAD_ENTRY * thread_p, char *ptr, XASL_NODE * xasl)
 
   /* initialize query_in_progress flag */
   xasl->query_in_progress = false;
+  memset (&xasl->stats, 0, sizeof (SCAN_STATS));
 
   ptr = or_unpack_int (ptr, (int *) &xasl->type);
 
@@ -2712,6 +2713,8 @@ stx_build_ls_merge_info (THREAD_ENTRY * thread_p, char *ptr,
 
   ptr = or_unpack_int (ptr, (int *) &list_merge_info->join_type);
 
+  ptr = or_unpack_int (ptr, (int *) &list_merge_info->join_method);
+
   ptr = or_unpack_int (ptr, &single_fetch);
   list_merge_info->single_fetch = (QPROC_SINGLE_FETCH) single_fetch;
 
@@ -11708,6 +11708,7 @@ static int
 btree_find_next_index_record (THREAD_ENTRY * thread_p, BTREE_SCAN * bts)
 {
   char *header_ptr;
+  VPID next_vpid;
   int key_cnt;
   PAGE_PTR temp_page = NULL;
   int ret = NO_ERROR;
@@ -11802,6 +11803,13 @@ again:
 	  bts->C_page = NULL;
 	  goto again;
 	}
+
+      /* read the next leaf page ahead while this page is being scanned */
+      BTREE_GET_NODE_NEXT_VPID (header_ptr, &next_vpid);
+      if (!VPID_ISNULL (&next_vpid))
+	{
+	  pgbuf_request_prefetch (thread_p, &next_vpid, 1);
+	}
     }
 
 end:
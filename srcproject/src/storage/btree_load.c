@@ -2222,7 +2222,7 @@ btree_index_sort (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args,
   return sort_listfile (thread_p, sort_args->hfids[0].vfid.volid,
 			est_inp_pg_cnt, &btree_sort_get_next, sort_args,
 			out_func, out_args, compare_driver, sort_args,
-			SORT_DUP);
+			SORT_DUP, NO_SORT_LIMIT);
 }
 
 /*
@@ -42,6 +42,8 @@
 #include "slotted_page.h"
 #include "overflow_file.h"
 #include "boot_sr.h"
+#include "perf_monitor.h"
+#include "query_manager.h"
 
 #define SORT_INIT_INPUT_PAGE_EST 50	/* initial input page count estimate */
 
@@ -73,6 +75,12 @@
 
 #define SORT_SWAP_PTR(a,b) { char **temp; temp = a; a = b; b = temp; }
 
+/* max # of threads sorting the internal memory together */
+#define SORT_MAX_PARALLEL_DEGREE 16
+
+/* min # of records each thread gets in a parallel internal sort */
+#define SORT_PARALLEL_MIN_RECS 4096
+
 #define SORT_CHECK_DUPLICATE(a, b)  \
     do {                          \
         if (cmp == 0) {           \
@@ -129,6 +137,8 @@ struct sort_param
   int tot_runs;			/* Total number of runs */
   int tot_buffers;		/* Size of internal memory used in terms of
 				   number of buffers it occupies */
+  int work_mem_pages;		/* part of tot_buffers granted out of the
+				   work memory of the query */
   int tot_tempfiles;		/* Total number of temporary files */
   int half_files;		/* Half number of temporary files */
   int in_half;			/* Which half of temp files is for input */
@@ -147,6 +157,49 @@ struct sort_param
   /* Estimated number of pages in each temp file (used in initialization) */
   int tmp_file_pgs;
 
+  /* Number of threads which may sort the internal memory together */
+  int parallel_degree;
+};
+
+typedef struct sort_topn SORT_TOPN;
+struct sort_topn
+{				/* bounded heap for top-N sorting */
+  char **heap;			/* Records kept so far; heap[0] is the one
+				   that sorts last */
+  int limit;			/* Maximum number of records to keep */
+  int count;			/* Number of records kept */
+  int replay_pos;		/* Next kept record to hand to the regular
+				   sort when falling back to it */
+  long mem_size;		/* Memory used by the kept records */
+  long max_mem_size;		/* Memory the kept records may use */
+
+  SORT_CMP_FUNC *cmp_fn;
+  void *cmp_arg;
+
+  /* Original input function, used when falling back to the regular sort */
+  SORT_GET_FUNC *get_fn;
+  void *get_arg;
+};
+
+typedef struct sort_parallel_task SORT_PARALLEL_TASK;
+struct sort_parallel_task
+{				/* a part of a parallel internal sort */
+  SORT_PARAM *sort_param;
+  SORT_DUP_OPTION option;
+
+  /* run generation: the records to sort and the area to sort them with */
+  char **base;
+  char **otherbase;
+  long numrecs;
+
+  /* merge: the sorted ranges of records to merge into dest */
+  int nsrc;
+  char **src[SORT_MAX_PARALLEL_DEGREE];
+  long src_numrecs[SORT_MAX_PARALLEL_DEGREE];
+  char **dest;
+  long dest_numrecs;
+
+  int error;
 };
 
 typedef struct sort_rec_list SORT_REC_LIST;
@@ -215,6 +268,16 @@ static int sort_inphase_sort (THREAD_ENTRY * thread_p,
 			      SORT_PARAM * sort_param,
 			      SORT_GET_FUNC * get_next, void *arguments,
 			      SORT_DUP_OPTION option);
+static void sort_topn_sift_up (SORT_TOPN * topn, int pos);
+static void sort_topn_sift_down (SORT_TOPN * topn, int pos, int count);
+static int sort_topn_add (SORT_TOPN * topn, const RECDES * recdes);
+static void sort_topn_clear (SORT_TOPN * topn);
+static int sort_inphase_topn (THREAD_ENTRY * thread_p, SORT_TOPN * topn,
+			      SORT_GET_FUNC * get_fn, void *get_arg,
+			      SORT_PUT_FUNC * put_fn, void *put_arg,
+			      bool * is_overflow);
+static SORT_STATUS sort_topn_get_next (THREAD_ENTRY * thread_p,
+				       RECDES * recdes, void *arg);
 static int sort_exphase_merge_elim_dup (THREAD_ENTRY * thread_p,
 					SORT_PARAM * sort_param);
 static int sort_exphase_merge (THREAD_ENTRY * thread_p,
@@ -245,6 +308,17 @@ static int sort_run_sort (char ***base, long limit, long sort_numrecs,
 			  char **otherbase,
 			  SORT_CMP_FUNC * cmp_fn, void *cmp_arg,
 			  SORT_DUP_OPTION option, long *srun_limit);
+static int sort_run_sort_parallel (THREAD_ENTRY * thread_p,
+				   SORT_PARAM * sort_param, char ***base,
+				   long limit, long sort_numrecs,
+				   char **otherbase, SORT_DUP_OPTION option,
+				   long *srun_limit);
+#if defined(SERVER_MODE)
+static void sort_run_sort_task (THREAD_ENTRY * thread_p, void *arg);
+static void sort_run_merge_task (THREAD_ENTRY * thread_p, void *arg);
+static long sort_run_lower_bound (char **run, long numrecs, char **key,
+				  SORT_CMP_FUNC * compare, void *comp_arg);
+#endif /* SERVER_MODE */
 static int sort_run_add_new (FILE_CONTENTS * file_contents, int num_pages);
 static void sort_run_remove_first (FILE_CONTENTS * file_contents);
 static void sort_run_flip (char **start, char **stop);
@@ -1326,6 +1400,261 @@ sort_run_sort (char ***base, long limit, long sort_numrecs, char **otherbase,
   return NO_ERROR;
 }
 
+/*
+ * sort_run_sort_parallel () - Sort the records of the internal memory with
+ *                             several threads
+ *   return: NO_ERROR, or ER_code
+ *   sort_param(in): sort parameters
+ *   base(in/out): pointer to the element at the base of the table
+ *   limit(in): numrecs of before current sort
+ *   sort_numrecs(in): numrecs of after privious sort
+ *   otherbase(in): pointer to alternate area suffecient to store base-limit
+ *   option(in): duplication option
+ *   srun_limit(out): numrecs of after current sort
+ *
+ * Note: The records are split in one part per thread and the parts are
+ *       sorted concurrently by sort_run_sort (). The sorted parts are then
+ *       merged concurrently: the key space is split in ranges by keys
+ *       sampled from the largest part, and each thread merges one range
+ *       of every part into its place in otherbase. Duplicates are chained
+ *       or eliminated as sort_run_sort () does, since all the records with
+ *       the same key fall in the same range. Only the internal memory of
+ *       the sort is used, whatever the number of threads.
+ *
+ *       Small tables, tables extending an already sorted one, and
+ *       standalone mode use sort_run_sort () alone.
+ */
+static int
+sort_run_sort_parallel (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param,
+			char ***base, long limit, long sort_numrecs,
+			char **otherbase, SORT_DUP_OPTION option,
+			long *srun_limit)
+{
+#if defined(SERVER_MODE)
+  SORT_PARALLEL_TASK tasks[SORT_MAX_PARALLEL_DEGREE];
+  void *args[SORT_MAX_PARALLEL_DEGREE];
+  long pos[SORT_MAX_PARALLEL_DEGREE][SORT_MAX_PARALLEL_DEGREE + 1];
+  char **splitter;
+  long start, dest_pos, total;
+  int degree, largest, i, j;
+
+  degree = (int) MIN (sort_param->parallel_degree,
+		      limit / SORT_PARALLEL_MIN_RECS);
+  if (sort_numrecs == 0 && degree > 1)
+    {
+      mnt_sort_parallel_runs (thread_p);
+
+      /* STEP 1: sort a part of the records in each thread */
+      for (i = 0; i < degree; i++)
+	{
+	  start = limit * i / degree;
+	  tasks[i].sort_param = sort_param;
+	  tasks[i].option = option;
+	  tasks[i].base = &(*base)[start];
+	  tasks[i].otherbase = &otherbase[start];
+	  tasks[i].numrecs = limit * (i + 1) / degree - start;
+	  tasks[i].error = NO_ERROR;
+	  args[i] = &tasks[i];
+	}
+
+      thread_run_parallel (thread_p, sort_run_sort_task, args, degree);
+
+      /* STEP 2: gather the sorted parts in base, each at its own place */
+      largest = 0;
+      for (i = 0; i < degree; i++)
+	{
+	  if (tasks[i].error != NO_ERROR)
+	    {
+	      return tasks[i].error;
+	    }
+
+	  start = limit * i / degree;
+	  if (tasks[i].base != &(*base)[start])
+	    {
+	      memmove (&(*base)[start], tasks[i].base,
+		       tasks[i].numrecs * sizeof (char *));
+	      tasks[i].base = &(*base)[start];
+	    }
+
+	  if (tasks[i].numrecs > tasks[largest].numrecs)
+	    {
+	      largest = i;
+	    }
+	}
+
+      /* STEP 3: split the key space in one range per thread */
+      for (i = 0; i < degree; i++)
+	{
+	  pos[i][0] = 0;
+	  pos[i][degree] = tasks[i].numrecs;
+	}
+      for (j = 1; j < degree; j++)
+	{
+	  splitter =
+	    &tasks[largest].base[tasks[largest].numrecs * j / degree];
+	  for (i = 0; i < degree; i++)
+	    {
+	      start = pos[i][j - 1];
+	      pos[i][j] = start
+		+ sort_run_lower_bound (&tasks[i].base[start],
+					tasks[i].numrecs - start, splitter,
+					sort_param->cmp_fn, sort_param->cmp_arg);
+	    }
+	}
+
+      /* STEP 4: merge each range of all the parts in a thread */
+      dest_pos = 0;
+      for (j = 0; j < degree; j++)
+	{
+	  tasks[j].nsrc = degree;
+	  tasks[j].dest = &otherbase[dest_pos];
+	  tasks[j].dest_numrecs = 0;
+	  tasks[j].error = NO_ERROR;
+	  for (i = 0; i < degree; i++)
+	    {
+	      tasks[j].src[i] = &tasks[i].base[pos[i][j]];
+	      tasks[j].src_numrecs[i] = pos[i][j + 1] - pos[i][j];
+	      dest_pos += tasks[j].src_numrecs[i];
+	    }
+	}
+
+      thread_run_parallel (thread_p, sort_run_merge_task, args, degree);
+
+      /* STEP 5: close the gaps left by the chained or eliminated
+       * duplicates */
+      total = 0;
+      for (j = 0; j < degree; j++)
+	{
+	  if (tasks[j].dest != &otherbase[total])
+	    {
+	      memmove (&otherbase[total], tasks[j].dest,
+		       tasks[j].dest_numrecs * sizeof (char *));
+	    }
+	  total += tasks[j].dest_numrecs;
+	}
+
+      *base = otherbase;
+      *srun_limit = total;
+
+      return NO_ERROR;
+    }
+#endif /* SERVER_MODE */
+
+  return sort_run_sort (base, limit, sort_numrecs, otherbase,
+			sort_param->cmp_fn, sort_param->cmp_arg, option,
+			srun_limit);
+}
+
+#if defined(SERVER_MODE)
+/*
+ * sort_run_sort_task () - Sort a part of a parallel internal sort
+ *   return: void
+ *   arg(in): the SORT_PARALLEL_TASK
+ */
+static void
+sort_run_sort_task (THREAD_ENTRY * thread_p, void *arg)
+{
+  SORT_PARALLEL_TASK *task = (SORT_PARALLEL_TASK *) arg;
+
+  task->error = sort_run_sort (&task->base, task->numrecs, 0,
+			       task->otherbase, task->sort_param->cmp_fn,
+			       task->sort_param->cmp_arg, task->option,
+			       &task->numrecs);
+}
+
+/*
+ * sort_run_merge_task () - Merge a key range of a parallel internal sort
+ *   return: void
+ *   arg(in): the SORT_PARALLEL_TASK
+ */
+static void
+sort_run_merge_task (THREAD_ENTRY * thread_p, void *arg)
+{
+  SORT_PARALLEL_TASK *task = (SORT_PARALLEL_TASK *) arg;
+  SORT_CMP_FUNC *compare = task->sort_param->cmp_fn;
+  void *comp_arg = task->sort_param->cmp_arg;
+  char **src[SORT_MAX_PARALLEL_DEGREE];
+  long left[SORT_MAX_PARALLEL_DEGREE];
+  char **dest = task->dest;
+  long n = 0;
+  int i, min;
+
+  for (i = 0; i < task->nsrc; i++)
+    {
+      src[i] = task->src[i];
+      left[i] = task->src_numrecs[i];
+    }
+
+  for (;;)
+    {
+      min = -1;
+      for (i = 0; i < task->nsrc; i++)
+	{
+	  if (left[i] > 0
+	      && (min == -1 || (*compare) (src[i], src[min], comp_arg) < 0))
+	    {
+	      min = i;
+	    }
+	}
+
+      if (min == -1)
+	{
+	  break;
+	}
+
+      if (n > 0 && (*compare) (src[min], &dest[n - 1], comp_arg) == 0)
+	{
+	  /* same key as the previous record */
+	  if (task->option == SORT_DUP)
+	    {
+	      sort_append (src[min], &dest[n - 1]);
+	    }
+	}
+      else
+	{
+	  dest[n++] = *src[min];
+	}
+
+      src[min]++;
+      left[min]--;
+    }
+
+  task->dest_numrecs = n;
+}
+
+/*
+ * sort_run_lower_bound () - Find the first record of a sorted run which does
+ *                           not sort before a key
+ *   return: position of the record, numrecs if there is none
+ *   run(in): sorted run of records
+ *   numrecs(in): number of records in the run
+ *   key(in): the key
+ *   compare(in): comparison function
+ *   comp_arg(in): arguments to the comparison function
+ */
+static long
+sort_run_lower_bound (char **run, long numrecs, char **key,
+		      SORT_CMP_FUNC * compare, void *comp_arg)
+{
+  long low = 0, high = numrecs, mid;
+
+  while (low < high)
+    {
+      mid = low + (high - low) / 2;
+      if ((*compare) (&run[mid], key, comp_arg) < 0)
+	{
+	  low = mid + 1;
+	}
+      else
+	{
+	  high = mid;
+	}
+    }
+
+  return low;
+}
+#endif /* SERVER_MODE */
+
 /*
  * sort_listfile () - Perform sorting
  *   return:
@@ -1359,23 +1688,63 @@ sort_run_sort (char ***base, long limit, long sort_numrecs, char **otherbase,
  *               neither precedes the other.
  *   cmp_arg(in): arguments to the cmp_fn function
  *   option(in):
+ *   limit(in): if positive, only the first "limit" items on the sorted
+ *              order are needed; NO_SORT_LIMIT otherwise
+ *
+ * Note: When a limit is given and duplicates are allowed, the items are
+ *       first sorted by keeping only the "limit" best of them in memory,
+ *       without writing any run to temporary files. If those do not fit
+ *       in the sort buffer, the items kept so far are handed to the
+ *       regular sort which goes on with the rest of the input.
  */
 int
 sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt,
 	       SORT_GET_FUNC * get_fn, void *get_arg, SORT_PUT_FUNC * put_fn,
 	       void *put_arg, SORT_CMP_FUNC * cmp_fn, void *cmp_arg,
-	       SORT_DUP_OPTION option)
+	       SORT_DUP_OPTION option, int limit)
 {
   SORT_PARAM sort_param;
+  SORT_TOPN topn;
+  bool is_overflow;
   INT32 input_pages;
   int error = NO_ERROR;
   int i, j;
   int file_pg_cnt_est;
 
+  topn.heap = NULL;
+  topn.count = 0;
+  topn.replay_pos = 0;
+  topn.cmp_fn = cmp_fn;
+  topn.cmp_arg = cmp_arg;
+
+  if (limit > 0 && option == SORT_DUP)
+    {
+      topn.limit = limit;
+      topn.max_mem_size = (long) PRM_SR_NBUFFERS * DB_PAGESIZE;
+
+      error = sort_inphase_topn (thread_p, &topn, get_fn, get_arg, put_fn,
+				 put_arg, &is_overflow);
+      if (error != NO_ERROR || is_overflow == false)
+	{
+	  sort_topn_clear (&topn);
+	  return error;
+	}
+
+      /* The kept items are read again by the regular sort before it goes on
+       * with the rest of the input.
+       */
+      topn.get_fn = get_fn;
+      topn.get_arg = get_arg;
+      get_fn = &sort_topn_get_next;
+      get_arg = &topn;
+    }
+
   sort_param.cmp_fn = cmp_fn;
   sort_param.cmp_arg = cmp_arg;
   sort_param.put_fn = put_fn;
   sort_param.put_arg = put_arg;
+  sort_param.parallel_degree =
+    MIN (thread_num_parallel_workers () + 1, SORT_MAX_PARALLEL_DEGREE);
 
   input_pages = ((est_inp_pg_cnt > 0)
 		 ? est_inp_pg_cnt + MAX ((int) (est_inp_pg_cnt * 0.1), 2)
@@ -1391,17 +1760,33 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt,
     (((int) (((double) 4096) / DB_PAGESIZE) * PRM_SR_NBUFFERS), input_pages);
   sort_param.tot_buffers = MAX (4, sort_param.tot_buffers);
 
+  /* If the work memory of the query allows it, take enough buffers to keep
+   * the whole input in memory, so that no run is written to temp files.
+   */
+  sort_param.work_mem_pages = 0;
+  if (input_pages > sort_param.tot_buffers)
+    {
+      sort_param.work_mem_pages =
+	qmgr_reserve_work_mem (thread_p,
+			       MIN (input_pages, PRM_QUERY_WORK_MEM_PAGES)
+			       - sort_param.tot_buffers);
+      sort_param.tot_buffers += sort_param.work_mem_pages;
+    }
+
   sort_param.internal_memory = (char *) malloc (sort_param.tot_buffers *
 						DB_PAGESIZE);
   if (sort_param.internal_memory == NULL)
     {
       sort_param.tot_buffers = 4;
+      qmgr_release_work_mem (thread_p, sort_param.work_mem_pages);
+      sort_param.work_mem_pages = 0;
       sort_param.internal_memory =
 	(char *) malloc (sort_param.tot_buffers * DB_PAGESIZE);
     }
 
   if (sort_param.internal_memory == NULL)
     {
+      sort_topn_clear (&topn);
       return ER_OUT_OF_VIRTUAL_MEMORY;
     }
 
@@ -1431,6 +1816,8 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt,
 	    }
 
 	  free_and_init (sort_param.internal_memory);
+	  qmgr_release_work_mem (thread_p, sort_param.work_mem_pages);
+	  sort_topn_clear (&topn);
 	  return ER_OUT_OF_VIRTUAL_MEMORY;
 	}
 
@@ -1493,6 +1880,7 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt,
 		       true) != NO_ERROR)
 		    {
 		      sort_return_used_resources (thread_p, &sort_param);
+		      sort_topn_clear (&topn);
 		      return er_errid ();
 		    }
 		}
@@ -1511,10 +1899,333 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt,
     }
 
   sort_return_used_resources (thread_p, &sort_param);
+  sort_topn_clear (&topn);
 
   return (error);
 }
 
+/*
+ * sort_topn_sift_up () - Move a kept record towards the top of the heap
+ *   return:
+ *   topn(in): top-N sort information
+ *   pos(in): heap position of the record
+ *
+ * Note: The heap keeps on its top the record which sorts last, so that it
+ *       is the one to be replaced by a record that sorts before it.
+ */
+static void
+sort_topn_sift_up (SORT_TOPN * topn, int pos)
+{
+  char **heap = topn->heap;
+  char *rec;
+  int parent;
+
+  rec = heap[pos];
+  while (pos > 0)
+    {
+      parent = (pos - 1) / 2;
+      if ((*topn->cmp_fn) (&heap[parent], &rec, topn->cmp_arg) >= 0)
+	{
+	  break;
+	}
+      heap[pos] = heap[parent];
+      pos = parent;
+    }
+  heap[pos] = rec;
+}
+
+/*
+ * sort_topn_sift_down () - Move a kept record towards the bottom of the heap
+ *   return:
+ *   topn(in): top-N sort information
+ *   pos(in): heap position of the record
+ *   count(in): number of records in the heap
+ */
+static void
+sort_topn_sift_down (SORT_TOPN * topn, int pos, int count)
+{
+  char **heap = topn->heap;
+  char *rec;
+  int child;
+
+  rec = heap[pos];
+  for (;;)
+    {
+      child = 2 * pos + 1;
+      if (child >= count)
+	{
+	  break;
+	}
+      if (child + 1 < count
+	  && (*topn->cmp_fn) (&heap[child + 1], &heap[child],
+			      topn->cmp_arg) > 0)
+	{
+	  child++;
+	}
+      if ((*topn->cmp_fn) (&heap[child], &rec, topn->cmp_arg) <= 0)
+	{
+	  break;
+	}
+      heap[pos] = heap[child];
+      pos = child;
+    }
+  heap[pos] = rec;
+}
+
+/*
+ * sort_topn_add () - Keep a record if it is among the best ones seen so far
+ *   return: NO_ERROR, or ER_code
+ *   topn(in): top-N sort information
+ *   recdes(in): the record to consider
+ */
+static int
+sort_topn_add (SORT_TOPN * topn, const RECDES * recdes)
+{
+  char *item_ptr;
+  char *rec;
+
+  if (topn->count == topn->limit)
+    {
+      rec = recdes->data;
+      if ((*topn->cmp_fn) (&rec, &topn->heap[0], topn->cmp_arg) >= 0)
+	{
+	  /* sorts after all the kept records; not needed */
+	  return NO_ERROR;
+	}
+    }
+
+  item_ptr = (char *) malloc (SORT_RECORD_LENGTH_SIZE + recdes->length);
+  if (item_ptr == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      (size_t) (SORT_RECORD_LENGTH_SIZE + recdes->length));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+  item_ptr += SORT_RECORD_LENGTH_SIZE;
+  memcpy (item_ptr, recdes->data, recdes->length);
+  SORT_RECORD_LENGTH (item_ptr) = recdes->length;
+  topn->mem_size += SORT_RECORD_LENGTH_SIZE + recdes->length;
+
+  if (topn->count == topn->limit)
+    {
+      /* replace the record which sorts last */
+      rec = topn->heap[0];
+      topn->mem_size -= SORT_RECORD_LENGTH_SIZE + SORT_RECORD_LENGTH (rec);
+      free (rec - SORT_RECORD_LENGTH_SIZE);
+
+      topn->heap[0] = item_ptr;
+      sort_topn_sift_down (topn, 0, topn->count);
+    }
+  else
+    {
+      topn->heap[topn->count] = item_ptr;
+      sort_topn_sift_up (topn, topn->count);
+      topn->count++;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * sort_topn_clear () - Free the records kept by the top-N sort
+ *   return:
+ *   topn(in): top-N sort information
+ */
+static void
+sort_topn_clear (SORT_TOPN * topn)
+{
+  int i;
+
+  if (topn->heap == NULL)
+    {
+      return;
+    }
+
+  for (i = topn->replay_pos; i < topn->count; i++)
+    {
+      free (topn->heap[i] - SORT_RECORD_LENGTH_SIZE);
+    }
+  free_and_init (topn->heap);
+  topn->count = 0;
+  topn->replay_pos = 0;
+}
+
+/*
+ * sort_inphase_topn () - Sort by keeping only the first records in memory
+ *   return: NO_ERROR, or ER_code
+ *   topn(in): top-N sort information
+ *   get_fn(in): user-supplied function: provides the temporary record for
+ *               the given input record
+ *   get_arg(in): arguments for get_fn
+ *   put_fn(in): user-supplied function: outputs the sorted records
+ *   put_arg(in): arguments for put_fn
+ *   is_overflow(out): true if the kept records did not fit in memory and
+ *                     the regular sort must take over
+ *
+ * Note: The input is read once; only the topn->limit records which sort
+ *       first are kept, in a heap. Nothing is written to temporary files.
+ *       On overflow the kept records are left in topn for
+ *       sort_topn_get_next ().
+ */
+static int
+sort_inphase_topn (THREAD_ENTRY * thread_p, SORT_TOPN * topn,
+		   SORT_GET_FUNC * get_fn, void *get_arg,
+		   SORT_PUT_FUNC * put_fn, void *put_arg, bool * is_overflow)
+{
+  SORT_STATUS status;
+  RECDES temp_recdes;
+  char *area;
+  int area_size;
+  char *rec;
+  int i;
+  int error = NO_ERROR;
+
+  *is_overflow = false;
+  topn->mem_size = (long) topn->limit * sizeof (char *);
+  if (topn->mem_size > topn->max_mem_size)
+    {
+      /* too many records to keep; let the regular sort do it all */
+      *is_overflow = true;
+      return NO_ERROR;
+    }
+
+  topn->heap = (char **) malloc (topn->limit * sizeof (char *));
+  area_size = DB_PAGESIZE;
+  area = (char *) malloc (area_size);
+  if (topn->heap == NULL || area == NULL)
+    {
+      error = ER_OUT_OF_VIRTUAL_MEMORY;
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error, 1,
+	      (size_t) (topn->limit * sizeof (char *)));
+      goto exit_on_end;
+    }
+
+  temp_recdes.area_size = area_size;
+  temp_recdes.data = area;
+
+  for (;;)
+    {
+      status = (*get_fn) (thread_p, &temp_recdes, get_arg);
+      if (status == SORT_NOMORE_RECS)
+	{
+	  break;
+	}
+
+      switch (status)
+	{
+	case SORT_SUCCESS:
+	  error = sort_topn_add (topn, &temp_recdes);
+	  if (error != NO_ERROR)
+	    {
+	      goto exit_on_end;
+	    }
+	  if (topn->mem_size > topn->max_mem_size)
+	    {
+	      *is_overflow = true;
+	      goto exit_on_end;
+	    }
+	  break;
+
+	case SORT_REC_DOESNT_FIT:
+	  /* get the same record again into a bigger area */
+	  free_and_init (area);
+	  area_size = DB_ALIGN (temp_recdes.length, MAX_ALIGNMENT);
+	  area = (char *) malloc (area_size);
+	  if (area == NULL)
+	    {
+	      error = ER_OUT_OF_VIRTUAL_MEMORY;
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error, 1,
+		      (size_t) area_size);
+	      goto exit_on_end;
+	    }
+	  temp_recdes.area_size = area_size;
+	  temp_recdes.data = area;
+	  break;
+
+	case SORT_ERROR_OCCURRED:
+	  error = er_errid ();
+	  goto exit_on_end;
+
+	default:
+	  /* This should never happen */
+	  error = ER_GENERIC_ERROR;
+	  er_set (ER_FATAL_ERROR_SEVERITY, ARG_FILE_LINE, error, 0);
+	  goto exit_on_end;
+	}
+    }
+
+  /* Sort the heap in place; the records then come in the sorted order */
+  for (i = topn->count - 1; i > 0; i--)
+    {
+      rec = topn->heap[0];
+      topn->heap[0] = topn->heap[i];
+      topn->heap[i] = rec;
+      sort_topn_sift_down (topn, 0, i);
+    }
+
+  for (i = 0; i < topn->count; i++)
+    {
+      temp_recdes.data = topn->heap[i];
+      temp_recdes.length = SORT_RECORD_LENGTH (topn->heap[i]);
+
+      error = (*put_fn) (thread_p, &temp_recdes, put_arg);
+      if (error != NO_ERROR)
+	{
+	  if (error == SORT_PUT_STOP)
+	    {
+	      error = NO_ERROR;
+	    }
+	  break;
+	}
+    }
+
+exit_on_end:
+
+  if (area)
+    {
+      free_and_init (area);
+    }
+
+  return error;
+}
+
+/*
+ * sort_topn_get_next () - Input function used when the top-N sort falls
+ *                         back to the regular sort
+ *   return: SORT_STATUS
+ *   recdes(in): temporary record descriptor
+ *   arg(in): top-N sort information
+ *
+ * Note: Hands out the records kept by the top-N sort first, then the rest
+ *       of the input from the original input function.
+ */
+static SORT_STATUS
+sort_topn_get_next (THREAD_ENTRY * thread_p, RECDES * recdes, void *arg)
+{
+  SORT_TOPN *topn;
+  char *rec;
+
+  topn = (SORT_TOPN *) arg;
+
+  if (topn->replay_pos < topn->count)
+    {
+      rec = topn->heap[topn->replay_pos];
+      recdes->length = SORT_RECORD_LENGTH (rec);
+      if (recdes->length > recdes->area_size)
+	{
+	  return SORT_REC_DOESNT_FIT;
+	}
+
+      memcpy (recdes->data, rec, recdes->length);
+      free (rec - SORT_RECORD_LENGTH_SIZE);
+      topn->replay_pos++;
+
+      return SORT_SUCCESS;
+    }
+
+  return (*topn->get_fn) (thread_p, recdes, topn->get_arg);
+}
+
 /*
  * sort_inphase_sort () - Internal sorting phase
  *   return:
@@ -1556,11 +2267,6 @@ sort_inphase_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param,
   char **index_buff;		/* buffer area to sort indexes. */
   int i;
   int error = NO_ERROR;
-  SORT_CMP_FUNC *compare;
-  void *comp_arg;
-
-  compare = sort_param->cmp_fn;
-  comp_arg = sort_param->cmp_arg;
 
   /* Initialize the current pages of all temp files to 0 */
   for (i = 0; i < sort_param->half_files; i++)
@@ -1633,9 +2339,10 @@ sort_inphase_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param,
 	      /* Perform internal sorting and flush the run */
 
 	      index_area++;
-	      error = sort_run_sort (&index_area, numrecs, sort_numrecs,
-				     index_buff, compare, comp_arg, option,
-				     &numrecs);
+	      error = sort_run_sort_parallel (thread_p, sort_param,
+					      &index_area, numrecs,
+					      sort_numrecs, index_buff,
+					      option, &numrecs);
 	      if (error != NO_ERROR)
 		{
 		  goto exit_on_error;
@@ -1849,8 +2556,9 @@ sort_inphase_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param,
          in the internal memory */
 
       index_area++;
-      error = sort_run_sort (&index_area, numrecs, sort_numrecs, index_buff,
-			     compare, comp_arg, option, &numrecs);
+      error = sort_run_sort_parallel (thread_p, sort_param, &index_area,
+				      numrecs, sort_numrecs, index_buff,
+				      option, &numrecs);
       if (error != NO_ERROR)
 	{
 	  goto exit_on_error;
@@ -3893,6 +4601,12 @@ sort_return_used_resources (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param)
       free_and_init (sort_param->internal_memory);
     }
 
+  if (sort_param->work_mem_pages > 0)
+    {
+      qmgr_release_work_mem (thread_p, sort_param->work_mem_pages);
+      sort_param->work_mem_pages = 0;
+    }
+
   for (k = 0; k < sort_param->tot_tempfiles; k++)
     {
       if (sort_param->temp[k].volid != NULL_VOLID)
@@ -4044,6 +4758,9 @@ sort_write_area (THREAD_ENTRY * thread_p, VFID * vfid, int first_page,
       page_ptr = (PAGE_PTR) ((char *) page_ptr + DB_PAGESIZE);
     }
 
+  /* the sort buffers could not hold all of the input */
+  qmgr_add_work_mem_spill (thread_p, num_pages);
+
   return NO_ERROR;
 }
 
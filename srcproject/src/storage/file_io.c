@@ -158,6 +158,9 @@
 #define FILEIO_GET_FILE_SIZE(pagesize, npages)  \
   (((off_t)(pagesize)) * ((off_t)(npages)))
 
+/* max # of pages written by a system call of fileio_writev () */
+#define FILEIO_MAX_WRITEV_PAGES            64
+
 #define FILEIO_BACKUP_NO_ZIP_HEADER_VERSION        1
 #define FILEIO_BACKUP_CURRENT_HEADER_VERSION       2
 #define FILEIO_CHECK_FOR_INTERRUPT_INTERVAL       100
@@ -3546,7 +3549,7 @@ fileio_write (THREAD_ENTRY * thread_p, int vol_fd, void *io_page_p,
 #endif
 
   fileio_compensate_flush (thread_p, vol_fd, 1);
-  mnt_file_iowrites (thread_p);
+  mnt_file_iowrites (thread_p, 1);
   return io_page_p;
 }
 
@@ -3831,7 +3834,7 @@ fileio_write_pages (THREAD_ENTRY * thread_p, int vol_fd, char *io_pages_p,
     }
 
   fileio_compensate_flush (thread_p, vol_fd, num_pages);
-  mnt_file_iowrites (thread_p);
+  mnt_file_iowrites (thread_p, 1);
   return io_pages_p;
 }
 
@@ -3854,13 +3857,55 @@ fileio_write_pages (THREAD_ENTRY * thread_p, int vol_fd, char *io_pages_p,
  *            io_pgptr[1]  -->> start_pageid + 1
  *                        ...
  *            io_pgptr[npages - 1] -->> start_pageid + npages - 1
+ *
+ *       On Linux, the server gathers up to FILEIO_MAX_WRITEV_PAGES pages
+ *       into a single pwritev () call. A failed or short vectored write is
+ *       retried page by page, so that the error is reported for the page.
  */
 void *
 fileio_writev (THREAD_ENTRY * thread_p, int vol_fd, void **io_page_array,
 	       PAGEID start_page_id, DKNPAGES npages, size_t page_size)
 {
   int i;
+#if defined(SERVER_MODE) && defined(LINUX) && !defined(USE_AIO)
+  struct iovec iov[FILEIO_MAX_WRITEV_PAGES];
+  ssize_t nbytes;
+  int j, n;
+
+  for (i = 0; i < npages; i += n)
+    {
+      n = MIN (npages - i, FILEIO_MAX_WRITEV_PAGES);
+      for (j = 0; j < n; j++)
+	{
+	  iov[j].iov_base = io_page_array[i + j];
+	  iov[j].iov_len = page_size;
+	}
 
+      do
+	{
+	  nbytes = pwritev (vol_fd, iov, n,
+			    FILEIO_GET_FILE_SIZE (page_size,
+						  start_page_id + i));
+	}
+      while (nbytes < 0 && errno == EINTR);
+
+      if (nbytes != (ssize_t) (page_size * n))
+	{
+	  for (j = 0; j < n; j++)
+	    {
+	      if (fileio_write (thread_p, vol_fd, io_page_array[i + j],
+				start_page_id + i + j, page_size) == NULL)
+		{
+		  return NULL;
+		}
+	    }
+	  continue;
+	}
+
+      fileio_compensate_flush (thread_p, vol_fd, n);
+      mnt_file_iowrites (thread_p, n);
+    }
+#else /* SERVER_MODE && LINUX && !USE_AIO */
   for (i = 0; i < npages; i++)
     {
       if (fileio_write (thread_p, vol_fd, io_page_array[i], start_page_id + i,
@@ -3869,6 +3914,7 @@ fileio_writev (THREAD_ENTRY * thread_p, int vol_fd, void **io_page_array,
 	  return NULL;
 	}
     }
+#endif /* SERVER_MODE && LINUX && !USE_AIO */
 
   return io_page_array[0];
 }
@@ -3914,10 +3960,7 @@ fileio_synchronize (THREAD_ENTRY * thread_p, int vol_fd, char *vlabel)
 #endif
     }
 
-  if (0 < PRM_MNT_WAITING_THREAD)
-    {
-      gettimeofday (&start_time, NULL);
-    }
+  gettimeofday (&start_time, NULL);
 #if defined(SERVER_MODE) && !defined(WINDOWS) && defined(USE_AIO)
   bzero (&cb, sizeof (cb));
   cb.aio_fildes = vol_fd;
@@ -3925,6 +3968,7 @@ fileio_synchronize (THREAD_ENTRY * thread_p, int vol_fd, char *vlabel)
 #else /* USE_AIO */
   ret = fsync (vol_fd);
 #endif /* USE_AIO */
+  mnt_lat_record (thread_p, MNT_LAT_FILE_SYNC, 0, &start_time);
   if (0 < PRM_MNT_WAITING_THREAD)
     {
       gettimeofday (&end_time, NULL);
@@ -4374,7 +4418,7 @@ fileio_write_user_area (THREAD_ENTRY * thread_p, int vol_fd, PAGEID page_id,
     }
 
   fileio_compensate_flush (thread_p, vol_fd, 1);
-  mnt_file_iowrites (thread_p);
+  mnt_file_iowrites (thread_p, 1);
   return area_p;
 }
 #endif
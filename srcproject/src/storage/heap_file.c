@@ -550,6 +550,11 @@ static int heap_vpid_next (const HFID * hfid, PAGE_PTR pgptr,
 			   VPID * next_vpid);
 static int heap_vpid_prev (const HFID * hfid, PAGE_PTR pgptr,
 			   VPID * prev_vpid);
+static SCAN_CODE heap_next_internal (THREAD_ENTRY * thread_p,
+				     const HFID * hfid, OID * class_oid,
+				     OID * next_oid, RECDES * recdes,
+				     HEAP_SCANCACHE * scan_cache,
+				     int ispeeking, const VPID * stop_vpid);
 
 static HFID *heap_create_internal (THREAD_ENTRY * thread_p, HFID * hfid,
 				   int exp_npgs, const OID * class_oid,
@@ -4992,6 +4997,37 @@ heap_vpid_next (const HFID * hfid, PAGE_PTR pgptr, VPID * next_vpid)
   return ret;
 }
 
+/*
+ * heap_vpid_skip () - Move forward along the heap chain
+ *   return: NO_ERROR
+ *   hfid(in): Object heap file identifier
+ *   vpid(in/out): Page to start from. Set to the page npages ahead in the
+ *                 chain, or to NULL when the chain ends before that
+ *   npages(in): Number of pages to move
+ */
+int
+heap_vpid_skip (THREAD_ENTRY * thread_p, const HFID * hfid, VPID * vpid,
+		int npages)
+{
+  PAGE_PTR pgptr;
+  int i;
+
+  for (i = 0; i < npages && !VPID_ISNULL (vpid); i++)
+    {
+      pgptr = heap_scan_pb_lock_and_fetch (thread_p, vpid, OLD_PAGE, S_LOCK,
+					   NULL);
+      if (pgptr == NULL)
+	{
+	  return ER_FAILED;
+	}
+
+      (void) heap_vpid_next (hfid, pgptr, vpid);
+      pgbuf_unfix_and_init (thread_p, pgptr);
+    }
+
+  return NO_ERROR;
+}
+
 /*
  * heap_vpid_prev () - Find previous page of heap
  *   return: NO_ERROR
@@ -8871,6 +8907,31 @@ heap_scancache_start (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache,
 					is_indexscan, lock_hint);
 }
 
+/*
+ * heap_scancache_start_without_lock () - Start caching information for a
+ *                                        heap scan without locking the class
+ *   return: NO_ERROR
+ *   scan_cache(in/out): Scan cache
+ *   hfid(in): Heap file identifier of the scan cache
+ *   class_oid(in): Class identifier of the scanned instances
+ *   cache_last_fix_page(in): Wheater or not to cache the last fetched page
+ *
+ * Note: The caller must make sure that the class is locked for the whole
+ *       scan by another scan of the same transaction, as done for the helper
+ *       threads of a parallel heap scan. The scan only latches heap pages;
+ *       it must be ended with heap_scancache_end_without_lock ().
+ */
+int
+heap_scancache_start_without_lock (THREAD_ENTRY * thread_p,
+				   HEAP_SCANCACHE * scan_cache,
+				   const HFID * hfid, const OID * class_oid,
+				   int cache_last_fix_page)
+{
+  return heap_scancache_start_internal (thread_p, scan_cache, hfid, class_oid,
+					cache_last_fix_page, false, false,
+					LOCKHINT_NONE);
+}
+
 /*
  * heap_scancache_start_modify () - Start caching information for heap
  *                                modifications
@@ -9360,6 +9421,24 @@ heap_scancache_end (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache)
   return NO_ERROR;
 }
 
+/*
+ * heap_scancache_end_without_lock () - Stop caching information for a heap
+ *                                      scan started without a lock
+ *   return: NO_ERROR
+ *   scan_cache(in/out): Scan cache
+ *
+ * Note: The space statistics are not updated either; the scan may have
+ *       seen only a part of the heap.
+ */
+int
+heap_scancache_end_without_lock (THREAD_ENTRY * thread_p,
+				 HEAP_SCANCACHE * scan_cache)
+{
+  OID_SET_NULL (&scan_cache->class_oid);
+
+  return heap_scancache_quick_end (thread_p, scan_cache);
+}
+
 /*
  * heap_scancache_end_when_scan_will_resume () -
  *   return:
@@ -10196,7 +10275,57 @@ heap_next (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
 	   OID * next_oid, RECDES * recdes, HEAP_SCANCACHE * scan_cache,
 	   int ispeeking)
 {
-  VPID vpid;
+  return heap_next_internal (thread_p, hfid, class_oid, next_oid, recdes,
+			     scan_cache, ispeeking, NULL);
+}
+
+/*
+ * heap_next_until () - Retrieve or peek next object before a given page
+ *   return: SCAN_CODE (Either of S_SUCCESS, S_DOESNT_FIT, S_END, S_ERROR)
+ *   hfid(in):
+ *   class_oid(in):
+ *   next_oid(in/out): Object identifier of current record.
+ *                     Will be set to next available record or NULL_OID when
+ *                     there is not one.
+ *   recdes(in/out): Pointer to a record descriptor. Will be modified to
+ *                   describe the new record.
+ *   scan_cache(in/out): Scan cache or NULL
+ *   ispeeking(in): PEEK when the object is peeked, scan_cache cannot be NULL
+ *                  COPY when the object is copied
+ *   stop_vpid(in): page the scan stops at
+ *
+ * Note: Same as heap_next () except that S_END is returned when the scan
+ *       would move to stop_vpid, so that a range of the heap chain can be
+ *       scanned on its own.
+ */
+SCAN_CODE
+heap_next_until (THREAD_ENTRY * thread_p, const HFID * hfid,
+		 OID * class_oid, OID * next_oid, RECDES * recdes,
+		 HEAP_SCANCACHE * scan_cache, int ispeeking,
+		 const VPID * stop_vpid)
+{
+  return heap_next_internal (thread_p, hfid, class_oid, next_oid, recdes,
+			     scan_cache, ispeeking, stop_vpid);
+}
+
+/*
+ * heap_next_internal () - Retrieve or peek next object
+ *   return: SCAN_CODE (Either of S_SUCCESS, S_DOESNT_FIT, S_END, S_ERROR)
+ *   hfid(in):
+ *   class_oid(in):
+ *   next_oid(in/out):
+ *   recdes(in/out):
+ *   scan_cache(in/out):
+ *   ispeeking(in):
+ *   stop_vpid(in): page the scan stops at, or NULL
+ */
+static SCAN_CODE
+heap_next_internal (THREAD_ENTRY * thread_p, const HFID * hfid,
+		    OID * class_oid, OID * next_oid, RECDES * recdes,
+		    HEAP_SCANCACHE * scan_cache, int ispeeking,
+		    const VPID * stop_vpid)
+{
+  VPID vpid, next_vpid;
   VPID *vpidptr_incache;
   PAGE_PTR pgptr = NULL;
   INT16 type = REC_UNKNOWN;
@@ -10329,6 +10458,14 @@ heap_next (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
 		      scan_cache->pgptr = NULL;
 		      return S_ERROR;
 		    }
+
+		  /* Read the next page of the heap ahead while this page is
+		     being scanned */
+		  if (heap_vpid_next (hfid, pgptr, &next_vpid) == NO_ERROR
+		      && !VPID_ISNULL (&next_vpid))
+		    {
+		      pgbuf_request_prefetch (thread_p, &next_vpid, 1);
+		    }
 		}
 	    }
 	  else
@@ -10377,7 +10514,8 @@ heap_next (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
 		  oid.volid = vpid.volid;
 		  oid.pageid = vpid.pageid;
 		  oid.slotid = -1;
-		  if (oid.pageid == NULL_PAGEID)
+		  if (oid.pageid == NULL_PAGEID
+		      || (stop_vpid != NULL && VPID_EQ (&vpid, stop_vpid)))
 		    {
 		      OID_SET_NULL (next_oid);
 		      return scan;
@@ -10636,6 +10774,197 @@ heap_next (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
   return scan;
 }
 
+/*
+ * heap_next_batch () - Peek the next objects stored in a page
+ *   return: SCAN_CODE (Either of S_SUCCESS, S_END, S_ERROR)
+ *   hfid(in):
+ *   class_oid(in):
+ *   next_oid(in/out): Object identifier of current record.
+ *                     Will be set to the last object peeked, or NULL_OID
+ *                     when there is not one.
+ *   scan_cache(in/out): Scan cache which keeps the last page fixed
+ *   stop_vpid(in): page the scan stops at, or NULL
+ *   oids(out): object identifiers of the objects peeked
+ *   recdes(out): records of the objects peeked
+ *   max_nrecs(in): max number of objects to peek
+ *   nrecs(out): number of objects peeked
+ *
+ * Note: The objects are peeked from a single page, which stays fixed in
+ *       scan_cache until the next call with it, so the records remain
+ *       valid together. The batch ends before an object that is not
+ *       stored at its home; when such an object comes first, S_SUCCESS is
+ *       returned with no objects and next_oid positioned just before it,
+ *       so that heap_next () retrieves it.
+ */
+SCAN_CODE
+heap_next_batch (THREAD_ENTRY * thread_p, const HFID * hfid,
+		 OID * class_oid, OID * next_oid, HEAP_SCANCACHE * scan_cache,
+		 const VPID * stop_vpid, OID * oids, RECDES * recdes,
+		 int max_nrecs, int *nrecs)
+{
+  VPID vpid, next_vpid;
+  VPID *vpidptr_incache;
+  PAGE_PTR pgptr = NULL;
+  INT16 type;
+  OID oid;
+  RECDES peek_recdes;
+  SCAN_CODE scan = S_SUCCESS;
+  INT16 start_slotid;
+
+  *nrecs = 0;
+
+  if (scan_cache == NULL || scan_cache->cache_last_fix_page == false)
+    {
+      er_set (ER_FATAL_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
+      return S_ERROR;
+    }
+
+  hfid = &scan_cache->hfid;
+  if (!OID_ISNULL (&scan_cache->class_oid))
+    {
+      class_oid = &scan_cache->class_oid;
+    }
+
+  if (OID_ISNULL (next_oid))
+    {
+      /* Retrieve the first object  of the heap */
+      oid.volid = hfid->vfid.volid;
+      oid.pageid = hfid->hpgid;
+      oid.slotid = 0;		/* i.e., will get slot 1 */
+    }
+  else
+    {
+      oid = *next_oid;
+    }
+
+  while (true)
+    {
+      vpid.volid = oid.volid;
+      vpid.pageid = oid.pageid;
+
+      /* Use the page of the previous scan whenever possible */
+      pgptr = NULL;
+      if (scan_cache->pgptr != NULL)
+	{
+	  vpidptr_incache = pgbuf_get_vpid_ptr (scan_cache->pgptr);
+	  if (VPID_EQ (&vpid, vpidptr_incache))
+	    {
+	      /* We can skip the fetch operation */
+	      pgptr = scan_cache->pgptr;
+	      scan_cache->pgptr = NULL;
+	    }
+	  else
+	    {
+	      /* Free the previous scan page */
+	      pgbuf_unfix_and_init (thread_p, scan_cache->pgptr);
+	    }
+	}
+      if (pgptr == NULL)
+	{
+	  pgptr = heap_scan_pb_lock_and_fetch (thread_p, &vpid, OLD_PAGE,
+					       S_LOCK, scan_cache);
+	  if (pgptr == NULL)
+	    {
+	      if (er_errid () == ER_PB_BAD_PAGEID)
+		{
+		  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			  ER_HEAP_UNKNOWN_OBJECT, 3, oid.volid, oid.pageid,
+			  oid.slotid);
+		}
+	      return S_ERROR;
+	    }
+	  if (heap_scancache_update_hinted_when_lots_space (thread_p,
+							    scan_cache,
+							    pgptr)
+	      != NO_ERROR)
+	    {
+	      pgbuf_unfix_and_init (thread_p, pgptr);
+	      return S_ERROR;
+	    }
+
+	  /* Read the next page of the heap ahead while this page is
+	     being scanned */
+	  if (heap_vpid_next (hfid, pgptr, &next_vpid) == NO_ERROR
+	      && !VPID_ISNULL (&next_vpid))
+	    {
+	      pgbuf_request_prefetch (thread_p, &next_vpid, 1);
+	    }
+	}
+
+      start_slotid = oid.slotid;
+      while (*nrecs < max_nrecs
+	     && (scan = spage_next_record (pgptr, &oid.slotid, &peek_recdes,
+					   PEEK)) == S_SUCCESS)
+	{
+	  if (oid.slotid == HEAP_HEADER_AND_CHAIN_SLOTID)
+	    {
+	      continue;
+	    }
+
+	  type = spage_get_record_type (pgptr, oid.slotid);
+	  if (type == REC_NEWHOME || type == REC_ASSIGN_ADDRESS
+	      || type == REC_UNKNOWN)
+	    {
+	      continue;
+	    }
+	  if (type != REC_HOME)
+	    {
+	      /* relocated and multipage objects are left to heap_next () */
+	      break;
+	    }
+
+	  if (class_oid == NULL || OID_ISNULL (class_oid)
+	      || or_isinstance (&peek_recdes, class_oid) == true)
+	    {
+	      oids[*nrecs] = oid;
+	      recdes[*nrecs] = peek_recdes;
+	      (*nrecs)++;
+	    }
+	}
+
+      if (*nrecs >= max_nrecs)
+	{
+	  scan = S_SUCCESS;
+	}
+
+      if (*nrecs > 0 || scan == S_SUCCESS)
+	{
+	  /* Save the page for the records and a future scan */
+	  scan_cache->pgptr = pgptr;
+	  if (*nrecs > 0)
+	    {
+	      *next_oid = oids[*nrecs - 1];
+	    }
+	  else
+	    {
+	      next_oid->volid = vpid.volid;
+	      next_oid->pageid = vpid.pageid;
+	      next_oid->slotid = start_slotid;
+	    }
+	  return S_SUCCESS;
+	}
+
+      if (scan != S_END)
+	{
+	  pgbuf_unfix_and_init (thread_p, pgptr);
+	  return scan;
+	}
+
+      /* Find next page of heap */
+      (void) heap_vpid_next (hfid, pgptr, &vpid);
+      pgbuf_unfix_and_init (thread_p, pgptr);
+      oid.volid = vpid.volid;
+      oid.pageid = vpid.pageid;
+      oid.slotid = -1;
+      if (oid.pageid == NULL_PAGEID
+	  || (stop_vpid != NULL && VPID_EQ (&vpid, stop_vpid)))
+	{
+	  OID_SET_NULL (next_oid);
+	  return S_END;
+	}
+    }
+}
+
 /*
  * heap_prev () - Retrieve or peek previous object
  *   return: SCAN_CODE (Either of S_SUCCESS, S_DOESNT_FIT, S_END, S_ERROR)
@@ -241,6 +241,11 @@ extern int heap_scancache_start (THREAD_ENTRY * thread_p,
 				 const HFID * hfid, const OID * class_oid,
 				 int cache_last_fix_page, int is_indexscan,
 				 int lock_hint);
+extern int heap_scancache_start_without_lock (THREAD_ENTRY * thread_p,
+					      HEAP_SCANCACHE * scan_cache,
+					      const HFID * hfid,
+					      const OID * class_oid,
+					      int cache_last_fix_page);
 extern int heap_scancache_start_modify (THREAD_ENTRY * thread_p,
 					HEAP_SCANCACHE * scan_cache,
 					const HFID * hfid,
@@ -248,6 +253,8 @@ extern int heap_scancache_start_modify (THREAD_ENTRY * thread_p,
 extern int heap_scancache_quick_start (HEAP_SCANCACHE * scan_cache);
 extern int heap_scancache_end (THREAD_ENTRY * thread_p,
 			       HEAP_SCANCACHE * scan_cache);
+extern int heap_scancache_end_without_lock (THREAD_ENTRY * thread_p,
+					    HEAP_SCANCACHE * scan_cache);
 extern int heap_scancache_end_when_scan_will_resume (THREAD_ENTRY * thread_p,
 						     HEAP_SCANCACHE *
 						     scan_cache);
@@ -269,6 +276,17 @@ extern SCAN_CODE heap_get_with_class_oid (THREAD_ENTRY * thread_p,
 extern SCAN_CODE heap_next (THREAD_ENTRY * thread_p, const HFID * hfid,
 			    OID * class_oid, OID * next_oid, RECDES * recdes,
 			    HEAP_SCANCACHE * scan_cache, int ispeeking);
+extern SCAN_CODE heap_next_until (THREAD_ENTRY * thread_p, const HFID * hfid,
+				  OID * class_oid, OID * next_oid,
+				  RECDES * recdes, HEAP_SCANCACHE * scan_cache,
+				  int ispeeking, const VPID * stop_vpid);
+extern int heap_vpid_skip (THREAD_ENTRY * thread_p, const HFID * hfid,
+			   VPID * vpid, int npages);
+extern SCAN_CODE heap_next_batch (THREAD_ENTRY * thread_p, const HFID * hfid,
+				  OID * class_oid, OID * next_oid,
+				  HEAP_SCANCACHE * scan_cache,
+				  const VPID * stop_vpid, OID * oids,
+				  RECDES * recdes, int max_nrecs, int *nrecs);
 extern SCAN_CODE heap_prev (THREAD_ENTRY * thread_p, const HFID * hfid,
 			    OID * class_oid, OID * prev_oid, RECDES * recdes,
 			    HEAP_SCANCACHE * scan_cache, int ispeeking);
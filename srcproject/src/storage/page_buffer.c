@@ -164,6 +164,50 @@
 #define PGBUF_HASH_VALUE(vpid)                                          \
   (((vpid)->pageid | ((unsigned int)(vpid)->volid) << 24) % PGBUF_HASH_SIZE)
 
+/* maximum number of optimistic (mutex-free) walks of a buffer hash chain
+   before falling back to the hash_mutex protected search */
+#define PGBUF_HASH_OPT_READ_MAX_RETRY      3
+
+/*
+ * Every modification of a buffer hash chain is enclosed by these macros
+ * while holding hash_mutex. The version of the hash anchor is odd while the
+ * chain is being modified, so that an optimistic reader can detect that
+ * the chain has been changed during its walk (seqlock).
+ */
+#if defined(SERVER_MODE)
+#define PGBUF_HASH_CHAIN_BEGIN_UPDATE(hash_anchor) \
+  do { \
+    (hash_anchor)->version++; \
+    MEMORY_BARRIER (); \
+  } while (0)
+
+#define PGBUF_HASH_CHAIN_END_UPDATE(hash_anchor) \
+  do { \
+    MEMORY_BARRIER (); \
+    (hash_anchor)->version++; \
+  } while (0)
+#else /* SERVER_MODE */
+#define PGBUF_HASH_CHAIN_BEGIN_UPDATE(hash_anchor)
+#define PGBUF_HASH_CHAIN_END_UPDATE(hash_anchor)
+#endif /* SERVER_MODE */
+
+/* max # of adjacent pages written at once by a victim candidate flusher */
+#define PGBUF_FLUSH_MAX_COALESCE_PAGES     32
+
+/* fraction of the checkpoint interval over which checkpoint writes are
+ * spread, the longest they are spread (msec) and the longest a paced
+ * checkpoint sleeps at once (msec) */
+#define PGBUF_CHKPT_COMPLETION_TARGET      0.5
+#define PGBUF_CHKPT_MAX_SPREAD_MSEC        (10 * 60 * 1000)
+#define PGBUF_CHKPT_MAX_SLEEP_MSEC         100
+
+/* # of read-ahead requests that can be queued for the read-ahead daemon */
+#define PGBUF_PREFETCH_QUEUE_SIZE          64
+
+/* # of consecutive sequential page fixes of a transaction that starts
+   read-ahead of the following pages */
+#define PGBUF_PREFETCH_SEQ_THRESHOLD       4
+
 #if defined(SERVER_MODE)
 
 #define MUTEX_LOCK_VIA_BUSY_WAIT(rv, m) \
@@ -239,6 +283,9 @@ typedef struct pgbuf_lru_list PGBUF_LRU_LIST;
 typedef struct pgbuf_invalid_list PGBUF_INVALID_LIST;
 typedef struct pgbuf_victim_candidate_list PGBUF_VICTIM_CANDIDATE_LIST;
 
+typedef struct pgbuf_prefetch_request PGBUF_PREFETCH_REQUEST;
+typedef struct pgbuf_prefetch_queue PGBUF_PREFETCH_QUEUE;
+
 typedef struct pgbuf_buffer_pool PGBUF_BUFFER_POOL;
 
 /* BCB holder entry */
@@ -296,7 +343,10 @@ struct pgbuf_bcb
   bool dirty;			/* Is page dirty ? */
   bool avoid_victim;
   bool async_flush_request;
+  bool bulk_read;		/* brought in and fixed only by bulk reads */
+  bool read_ahead;		/* read ahead and not fixed by anyone yet */
   int zone;			/* BCB zone */
+  int lru_idx;			/* index of the LRU list holding the BCB */
   LOG_LSA oldest_unflush_lsa;	/* The oldest LSA record of the page
 				   that has not been written to disk */
   PGBUF_IOPAGE_BUFFER *iopage_buffer;	/* pointer to iopage buffer structure */
@@ -338,6 +388,8 @@ struct pgbuf_buffer_hash
 #if defined(SERVER_MODE)
   MUTEX_T hash_mutex;		/* hash mutex for the integrity of buffer hash
 				   chain and buffer lock chain. */
+  volatile unsigned int version;	/* version of buffer hash chain.
+					   odd while the chain is modified */
 #endif				/* SERVER_MODE */
   PGBUF_BCB *hash_next;		/* the anchor of buffer hash chain */
   PGBUF_BUFFER_LOCK *lock_next;	/* the anchor of buffer lock chain */
@@ -353,6 +405,17 @@ struct pgbuf_lru_list
   PGBUF_BCB *LRU_bottom;	/* bottom of the LRU list */
   PGBUF_BCB *LRU_middle;	/* the last of LRU_1_Zone */
   int LRU_1_zone_cnt;
+
+#if defined(CUBRID_DEBUG)
+  /* statistics of the LRU list for pgbuf_dump (). they are updated
+     atomically, without LRU_mutex, since any thread may fix a page of the
+     list. the server wide totals are kept by the MNT statistics */
+  unsigned int num_fetches;	/* # of page fixes by the owner threads */
+  unsigned int num_hits;	/* # of page fixes found in the buffer */
+  unsigned int num_victims;	/* # of victims taken by the owner threads */
+  unsigned int num_steals;	/* # of victims taken by other threads */
+  unsigned int num_victim_search;	/* # of BCBs examined for victims */
+#endif				/* CUBRID_DEBUG */
 };
 
 /* buffer invalid BCB list : single linked list */
@@ -366,6 +429,24 @@ struct pgbuf_invalid_list
   int invalid_cnt;		/* # of entries in invalid BCB list */
 };
 
+/* page read-ahead request : a run of pages to be read */
+struct pgbuf_prefetch_request
+{
+  VPID vpid;			/* the first page of the run */
+  int npages;			/* # of pages of the run */
+};
+
+/* page read-ahead request queue : circular array */
+struct pgbuf_prefetch_queue
+{
+#if defined(SERVER_MODE)
+  MUTEX_T queue_mutex;		/* mutex for the integrity of the queue */
+#endif				/* SERVER_MODE */
+  int head;			/* index of the oldest request */
+  int cnt;			/* # of queued requests */
+  PGBUF_PREFETCH_REQUEST requests[PGBUF_PREFETCH_QUEUE_SIZE];
+};
+
 /* The buffer Pool */
 struct pgbuf_buffer_pool
 {
@@ -379,9 +460,9 @@ struct pgbuf_buffer_pool
   PGBUF_BUFFER_LOCK *buf_lock_table;	/* buffer lock table */
   PGBUF_IOPAGE_BUFFER *iopage_table;	/* IO page table */
   int num_LRU_list;
-  int last_flushed_LRU_list_idx;
   PGBUF_LRU_LIST *buf_LRU_list;
   PGBUF_INVALID_LIST buf_invalid_list;	/* buffer invalid BCB list */
+  PGBUF_PREFETCH_QUEUE prefetch_queue;	/* page read-ahead requests */
 
   /*
    * the structures for maintaining information on BCB holders.
@@ -516,8 +597,15 @@ static int pgbuf_unlatch_bcb_upon_unfix (THREAD_ENTRY * thread_p,
 static int pgbuf_block_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr,
 			    int request_mode, int request_fcnt);
 #endif /* NDEBUG */
-static PGBUF_BCB *pgbuf_search_hash_chain (PGBUF_BUFFER_HASH * hash_anchor,
+static PGBUF_BCB *pgbuf_search_hash_chain (THREAD_ENTRY * thread_p,
+					   PGBUF_BUFFER_HASH * hash_anchor,
 					   const VPID * vpid);
+static int *pgbuf_get_bulk_read_cnt (THREAD_ENTRY * thread_p);
+#if defined(SERVER_MODE)
+static bool pgbuf_is_resident (const VPID * vpid);
+static void pgbuf_detect_sequential_fix (THREAD_ENTRY * thread_p,
+					 const VPID * vpid);
+#endif /* SERVER_MODE */
 static int pgbuf_insert_into_hash_chain (PGBUF_BUFFER_HASH * hash_anchor,
 					 PGBUF_BCB * bufptr);
 static int pgbuf_delete_from_hash_chain (PGBUF_BCB * bufptr);
@@ -537,22 +625,41 @@ static int pgbuf_victimize_bcb (THREAD_ENTRY * thread_p,
 static int pgbuf_flush_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr,
 			    int synchronous,
 			    const char *caller_file, int caller_line);
+static int pgbuf_end_flush_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr,
+				const char *caller_file, int caller_line);
 #else /* NDEBUG */
 static PGBUF_BCB *pgbuf_allocate_bcb (THREAD_ENTRY * thread_p,
 				      const VPID * vpid);
 static int pgbuf_victimize_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr);
 static int pgbuf_flush_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr,
 			    int synchronous);
+static int pgbuf_end_flush_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr);
 #endif /* NDEBUG */
 static int pgbuf_invalidate_bcb (PGBUF_BCB * bufptr);
 static PGBUF_BCB *pgbuf_get_bcb_from_invalid_list (void);
 static int pgbuf_put_bcb_into_invalid_list (PGBUF_BCB * bufptr);
-static int pgbuf_get_lru_index (const VPID * vpid);
-static PGBUF_BCB *pgbuf_get_victim_from_lru_list (const VPID * vpid);
+static int pgbuf_get_lru_index (THREAD_ENTRY * thread_p, const VPID * vpid);
+static PGBUF_BCB *pgbuf_get_victim_from_lru_shard (int lru_idx, bool wait,
+						   int *search_cnt,
+						   bool * is_busy);
+static PGBUF_BCB *pgbuf_get_victim_from_lru_list (THREAD_ENTRY * thread_p,
+						  const VPID * vpid);
 static int pgbuf_invalidate_bcb_from_lru (PGBUF_BCB * bufptr);
-static int pgbuf_relocate_top_lru (PGBUF_BCB * bufptr);
+static int pgbuf_relocate_top_lru (THREAD_ENTRY * thread_p,
+				   PGBUF_BCB * bufptr);
+static int pgbuf_relocate_bottom_lru (THREAD_ENTRY * thread_p,
+				     PGBUF_BCB * bufptr);
 static int pgbuf_flush_page_with_wal (THREAD_ENTRY * thread_p,
 				      PGBUF_BCB * bufptr);
+static void pgbuf_set_bcb_flushed (PGBUF_BCB * bufptr);
+static int pgbuf_compare_victim_list (const void *p1, const void *p2);
+static int pgbuf_compare_dirty_page_table (const void *p1, const void *p2);
+#if defined(SERVER_MODE)
+static void pgbuf_pace_check_point (THREAD_ENTRY * thread_p,
+				    struct timeval *start_tv,
+				    PAGEID start_log_pageid, int spread_msec,
+				    int nflushed, int npages);
+#endif /* SERVER_MODE */
 static bool pgbuf_is_exist_blocked_reader_writer (PGBUF_BCB * bufptr);
 static bool pgbuf_is_exist_blocked_reader_writer_victim (PGBUF_BCB * bufptr);
 #if !defined(NDEBUG)
@@ -724,6 +831,10 @@ pgbuf_initialize (void)
       goto error;
     }
 
+  MUTEX_INIT (pgbuf_Pool.prefetch_queue.queue_mutex);
+  pgbuf_Pool.prefetch_queue.head = 0;
+  pgbuf_Pool.prefetch_queue.cnt = 0;
+
   pgbuf_Pool.check_for_interrupts = false;
   MUTEX_INIT (pgbuf_Pool.volinfo_mutex);
   pgbuf_Pool.last_perm_volid = LOG_MAX_DBVOLID;
@@ -819,6 +930,9 @@ pgbuf_finalize (void)
   /* final task for invalid BCB list */
   MUTEX_DESTROY (pgbuf_Pool.buf_invalid_list.invalid_mutex);
 
+  /* final task for read-ahead request queue */
+  MUTEX_DESTROY (pgbuf_Pool.prefetch_queue.queue_mutex);
+
   /* final task for tran_holder_info */
   for (i = 0; i < MAX_NTRANS; i++)
     {
@@ -937,6 +1051,9 @@ pgbuf_fix_release (THREAD_ENTRY * thread_p, const VPID * vpid, int newpg,
 {
   PGBUF_BUFFER_HASH *hash_anchor;
   PGBUF_BCB *bufptr;
+#if defined(CUBRID_DEBUG)
+  PGBUF_LRU_LIST *lru_list;
+#endif /* CUBRID_DEBUG */
   int buf_lock_acquired;
   int waitsecs;
 #if defined(SERVER_MODE)
@@ -992,7 +1109,7 @@ try_again:
   hash_anchor = &pgbuf_Pool.buf_hash_table[PGBUF_HASH_VALUE (vpid)];
 
   buf_lock_acquired = false;
-  bufptr = pgbuf_search_hash_chain (hash_anchor, vpid);
+  bufptr = pgbuf_search_hash_chain (thread_p, hash_anchor, vpid);
 
   if (bufptr == NULL)
     {
@@ -1087,6 +1204,19 @@ try_again:
 
   /* At this place, the caller is holding bufptr->BCB_mutex */
 
+  /* A page is recycled ahead of the others as long as only bulk readers
+   * have used it since it was brought in.
+   */
+  if (*pgbuf_get_bulk_read_cnt (thread_p) == 0)
+    {
+      bufptr->bulk_read = false;
+    }
+  else if (buf_lock_acquired || bufptr->read_ahead)
+    {
+      bufptr->bulk_read = true;
+    }
+  bufptr->read_ahead = false;
+
   /* Latch Pass */
 #if !defined (NDEBUG)
   if (pgbuf_latch_bcb_upon_fix (thread_p, bufptr, request_mode,
@@ -1139,8 +1269,23 @@ try_again:
     }
 
   /* Record number of fetches in statistics */
+#if defined(CUBRID_DEBUG)
+  lru_list = &pgbuf_Pool.buf_LRU_list[pgbuf_get_lru_index (thread_p, vpid)];
+  (void) ATOMIC_INC_32 (&lru_list->num_fetches, 1);
+  if (buf_lock_acquired == false)
+    {
+      (void) ATOMIC_INC_32 (&lru_list->num_hits, 1);
+    }
+#endif /* CUBRID_DEBUG */
   mnt_pb_fetches (thread_p);
 
+#if defined(SERVER_MODE)
+  if (newpg != NEW_PAGE && request_mode == PGBUF_LATCH_READ)
+    {
+      pgbuf_detect_sequential_fix (thread_p, vpid);
+    }
+#endif /* SERVER_MODE */
+
   return (PAGE_PTR) (&(bufptr->iopage_buffer->iopage.page[0]));
 }
 
@@ -1560,6 +1705,289 @@ pgbuf_invalidate (THREAD_ENTRY * thread_p, PAGE_PTR pgptr)
   return NO_ERROR;
 }
 
+/*
+ * pgbuf_is_bulk_read_size () - Check if a scan of the given size should be
+ *				read in bulk read mode
+ *   return: true if bulk read mode is recommended
+ *   npages(in): estimated # of pages to be scanned
+ *
+ * Note: A scan is read in bulk read mode when it would replace more than
+ *       PRM_PB_BULK_READ_RATIO of the page buffer. Zero disables it.
+ */
+bool
+pgbuf_is_bulk_read_size (int npages)
+{
+  if (PRM_PB_BULK_READ_RATIO <= 0.0f || npages <= 0)
+    {
+      return false;
+    }
+
+  return (npages > PRM_PB_BULK_READ_RATIO * pgbuf_Pool.num_buffers);
+}
+
+/*
+ * pgbuf_start_bulk_read () - Start bulk read mode of the thread
+ *   return: void
+ *
+ * Note: The pages brought in by the thread in bulk read mode are put on
+ *       the bottom of the LRU list when they are unfixed, instead of the
+ *       top. The next page replacement of the thread picks them first, so a
+ *       large sequential scan recycles a few buffers of its own instead of
+ *       flushing out the working set of the other transactions.
+ *       Calls may be nested and must be paired with pgbuf_end_bulk_read ().
+ */
+void
+pgbuf_start_bulk_read (THREAD_ENTRY * thread_p)
+{
+  (*pgbuf_get_bulk_read_cnt (thread_p))++;
+}
+
+/*
+ * pgbuf_end_bulk_read () - End bulk read mode of the thread
+ *   return: void
+ */
+void
+pgbuf_end_bulk_read (THREAD_ENTRY * thread_p)
+{
+  int *bulk_read_cnt;
+
+  bulk_read_cnt = pgbuf_get_bulk_read_cnt (thread_p);
+  assert (*bulk_read_cnt > 0);
+  (*bulk_read_cnt)--;
+}
+
+/*
+ * pgbuf_get_bulk_read_cnt () - Bulk read mode counter of the thread
+ *   return: pointer to the counter
+ *
+ * Note: Bulk read mode is kept per thread rather than per transaction,
+ *       since the helpers of a parallel scan run under the transaction
+ *       of the requester and start and end it concurrently.
+ */
+static int *
+pgbuf_get_bulk_read_cnt (THREAD_ENTRY * thread_p)
+{
+#if defined(SERVER_MODE)
+  if (thread_p == NULL)
+    {
+      thread_p = thread_get_thread_entry_info ();
+    }
+
+  return &thread_p->pgbuf_bulk_read_cnt;
+#else /* SERVER_MODE */
+  static int bulk_read_cnt = 0;
+
+  return &bulk_read_cnt;
+#endif /* SERVER_MODE */
+}
+
+/*
+ * pgbuf_request_prefetch () - Request to read pages ahead
+ *   return: void
+ *   vpid(in): the first page to be read
+ *   npages(in): # of pages to be read from vpid
+ *
+ * Note: The pages are read into the buffer pool by the read-ahead daemon
+ *       while the caller goes on with the pages before them. This is just
+ *       a hint: the request is dropped when read-ahead is disabled by
+ *       PRM_PB_READ_AHEAD_PAGES or the request queue is full, and the pages
+ *       which are already in the buffer pool or not allocated are skipped.
+ *       The leading pages already in the buffer pool are skipped before
+ *       the request is queued, so that a scan over cached pages neither
+ *       takes the queue mutex nor wakes up the daemon.
+ */
+void
+pgbuf_request_prefetch (THREAD_ENTRY * thread_p, const VPID * vpid,
+			int npages)
+{
+#if defined(SERVER_MODE)
+  PGBUF_PREFETCH_QUEUE *queue;
+  PGBUF_PREFETCH_REQUEST *request;
+  VPID first_vpid;
+  int rv;
+
+  if (PRM_PB_READ_AHEAD_PAGES <= 0 || npages <= 0 || VPID_ISNULL (vpid)
+      || pgbuf_is_temporary_volume (vpid->volid) == true)
+    {
+      return;
+    }
+
+  npages = MIN (npages, PRM_PB_READ_AHEAD_PAGES);
+  first_vpid = *vpid;
+  while (pgbuf_is_resident (&first_vpid) == true)
+    {
+      first_vpid.pageid++;
+      if (--npages <= 0)
+	{
+	  return;
+	}
+    }
+
+  queue = &pgbuf_Pool.prefetch_queue;
+
+  MUTEX_LOCK (rv, queue->queue_mutex);
+  if (queue->cnt >= PGBUF_PREFETCH_QUEUE_SIZE)
+    {
+      /* the daemon is behind the readers; forget about it */
+      MUTEX_UNLOCK (queue->queue_mutex);
+      return;
+    }
+
+  request = &queue->requests[(queue->head + queue->cnt)
+			     % PGBUF_PREFETCH_QUEUE_SIZE];
+  request->vpid = first_vpid;
+  request->npages = npages;
+  queue->cnt++;
+  MUTEX_UNLOCK (queue->queue_mutex);
+
+  mnt_pb_prefetch_requests (thread_p);
+
+  thread_wakeup_page_prefetch_thread ();
+#endif /* SERVER_MODE */
+}
+
+/*
+ * pgbuf_prefetch_pages () - Read the requested pages ahead
+ *   return: void
+ *
+ * Note: This function is called by the read-ahead daemon. It reads the
+ *       pages of the queued requests into the buffer pool until the queue
+ *       is empty. A page read ahead is left unfixed on the top of the LRU
+ *       list of the daemon, so that it survives until the requester fixes
+ *       it. The first fix of the page by a bulk reader makes it a bulk read
+ *       page as if the bulk reader had read it by itself.
+ */
+void
+pgbuf_prefetch_pages (THREAD_ENTRY * thread_p)
+{
+#if defined(SERVER_MODE)
+  PGBUF_PREFETCH_QUEUE *queue;
+  PGBUF_PREFETCH_REQUEST request;
+  PGBUF_BCB *bufptr;
+  PAGE_PTR pgptr;
+  VPID vpid;
+  DISK_ISVALID valid;
+  int i, rv;
+
+  queue = &pgbuf_Pool.prefetch_queue;
+
+  while (!thread_p->shutdown)
+    {
+      MUTEX_LOCK (rv, queue->queue_mutex);
+      if (queue->cnt <= 0)
+	{
+	  MUTEX_UNLOCK (queue->queue_mutex);
+	  break;
+	}
+      request = queue->requests[queue->head];
+      queue->head = (queue->head + 1) % PGBUF_PREFETCH_QUEUE_SIZE;
+      queue->cnt--;
+      MUTEX_UNLOCK (queue->queue_mutex);
+
+      vpid = request.vpid;
+      for (i = 0; i < request.npages && !thread_p->shutdown;
+	   i++, vpid.pageid++)
+	{
+	  if (pgbuf_is_resident (&vpid) == true)
+	    {
+	      continue;
+	    }
+
+	  /* stop at the end of the volume or at the first page which is not
+	     allocated; there is nothing worth reading behind it */
+	  valid = disk_isvalid_page (thread_p, vpid.volid, vpid.pageid);
+	  if (valid != DISK_VALID)
+	    {
+	      er_clear ();
+	      break;
+	    }
+
+	  pgptr = pgbuf_fix (thread_p, &vpid, OLD_PAGE, PGBUF_LATCH_READ,
+			     PGBUF_CONDITIONAL_LATCH);
+	  if (pgptr == NULL)
+	    {
+	      er_clear ();
+	      continue;
+	    }
+
+	  CAST_PGPTR_TO_BFPTR (bufptr, pgptr);
+	  MUTEX_LOCK (rv, bufptr->BCB_mutex);
+	  bufptr->read_ahead = true;
+	  MUTEX_UNLOCK (bufptr->BCB_mutex);
+
+	  pgbuf_unfix (thread_p, pgptr);
+	  mnt_pb_prefetch_reads (thread_p);
+	}
+    }
+#endif /* SERVER_MODE */
+}
+
+#if defined(SERVER_MODE)
+/*
+ * pgbuf_detect_sequential_fix () - Detect a sequential read of pages
+ *   return: void
+ *   vpid(in): page identifier fixed for read
+ *
+ * Note: When a thread fixes PGBUF_PREFETCH_SEQ_THRESHOLD pages in a row
+ *       in the order of page identifiers, the next PRM_PB_READ_AHEAD_PAGES
+ *       pages are requested to be read ahead. The window is refilled every
+ *       time the thread consumes half of it.
+ */
+static void
+pgbuf_detect_sequential_fix (THREAD_ENTRY * thread_p, const VPID * vpid)
+{
+  VPID start_vpid;
+  int window;
+
+  if (thread_p == NULL)
+    {
+      thread_p = thread_get_thread_entry_info ();
+    }
+
+  window = PRM_PB_READ_AHEAD_PAGES;
+  if (window <= 0
+      || LOG_FIND_THREAD_TRAN_INDEX (thread_p) == LOG_SYSTEM_TRAN_INDEX)
+    {
+      /* the system threads including the read-ahead daemon itself
+         are not traced */
+      return;
+    }
+
+  if (vpid->volid == thread_p->pgbuf_seq_last_vpid.volid
+      && vpid->pageid == thread_p->pgbuf_seq_last_vpid.pageid)
+    {
+      return;
+    }
+
+  if (vpid->volid == thread_p->pgbuf_seq_last_vpid.volid
+      && vpid->pageid == thread_p->pgbuf_seq_last_vpid.pageid + 1)
+    {
+      thread_p->pgbuf_seq_fix_cnt++;
+    }
+  else
+    {
+      thread_p->pgbuf_seq_fix_cnt = 0;
+      thread_p->pgbuf_seq_prefetch_pageid = NULL_PAGEID;
+    }
+  thread_p->pgbuf_seq_last_vpid = *vpid;
+
+  if (thread_p->pgbuf_seq_fix_cnt < PGBUF_PREFETCH_SEQ_THRESHOLD
+      || thread_p->pgbuf_seq_prefetch_pageid - vpid->pageid > window / 2)
+    {
+      return;
+    }
+
+  start_vpid.volid = vpid->volid;
+  start_vpid.pageid =
+    MAX (vpid->pageid, thread_p->pgbuf_seq_prefetch_pageid) + 1;
+  thread_p->pgbuf_seq_prefetch_pageid = vpid->pageid + window;
+
+  pgbuf_request_prefetch (thread_p, &start_vpid,
+			  thread_p->pgbuf_seq_prefetch_pageid
+			  - start_vpid.pageid + 1);
+}
+#endif /* SERVER_MODE */
+
 /*
  * pgbuf_invalidate_temporary_file () -
  *   return:
@@ -1590,7 +2018,7 @@ pgbuf_invalidate_temporary_file (VOLID volid, PAGEID first_pageid,
 
       /* fix page */
       hash_anchor = &pgbuf_Pool.buf_hash_table[PGBUF_HASH_VALUE (&vpid)];
-      bufptr = pgbuf_search_hash_chain (hash_anchor, &vpid);
+      bufptr = pgbuf_search_hash_chain (NULL, hash_anchor, &vpid);
       if (bufptr == NULL)
 	{
 	  MUTEX_UNLOCK (hash_anchor->hash_mutex);
@@ -1995,64 +2423,90 @@ pgbuf_flush_all_unfixed_and_set_lsa_as_null (THREAD_ENTRY * thread_p,
 /*
  * pgbuf_flush_victim_candidate () - Flush victim candidates
  *   return: NO_ERROR, or ER_code
+ *   flush_ratio(in): ratio of each LRU list to be checked
+ *   flusher_idx(in): index of the flusher among num_flushers flushers
+ *   num_flushers(in): # of the flushers sharing the LRU lists
  *
  * Note: This function flushes at most VictimCleanCount buffers that might
  *       become victim candidates in the near future.
+ *
+ *       The LRU lists are divided among the flushers. The flusher flushes
+ *       the candidates of the lists whose index modulo num_flushers is
+ *       flusher_idx, so that the flushers never compete for the same
+ *       buffers. The candidates of all the lists are written in the order
+ *       of VPID after the log is forced once up to the largest page LSA of
+ *       them, and adjacent pages are written by a single vectored write.
  */
 #if !defined(NDEBUG)
 int
 pgbuf_flush_victim_candidate_debug (THREAD_ENTRY * thread_p,
-				    float flush_ratio,
+				    float flush_ratio, int flusher_idx,
+				    int num_flushers,
 				    const char *caller_file, int caller_line)
 #else /* NDEBUG */
 int
-pgbuf_flush_victim_candidate (THREAD_ENTRY * thread_p, float flush_ratio)
+pgbuf_flush_victim_candidate (THREAD_ENTRY * thread_p, float flush_ratio,
+			      int flusher_idx, int num_flushers)
 #endif				/* NDEBUG */
 {
   PGBUF_BCB *bufptr;
   PGBUF_BCB *prev_bufptr;
+  PGBUF_LRU_LIST *lru_list;
   PGBUF_VICTIM_CANDIDATE_LIST *victim_cand_list;
-  int i, clean_count, cand_count, check_count, total_flushed_count;
-  int lru_idx, start_lru_idx;
+  void *io_page_array[PGBUF_FLUSH_MAX_COALESCE_PAGES];
+  LOG_LSA flush_upto_lsa;
+  LOG_LSA *page_lsa;
+  int i, j, k, clean_count, list_cand_count, cand_count, check_count;
+  int total_flushed_count, num_lists, lru_idx;
+  int error = NO_ERROR;
 #if defined(SERVER_MODE)
   int rv;
 #endif /* SERVER_MODE */
 
+  assert (flush_ratio == PGBUF_VICTIM_FLUSH_MAX_RATIO
+	  || flush_ratio == PGBUF_VICTIM_FLUSH_MIN_RATIO);
+  assert (num_flushers > 0 && flusher_idx >= 0
+	  && flusher_idx < num_flushers);
+
+  if (flusher_idx >= pgbuf_Pool.num_LRU_list)
+    {
+      /* there are more flushers than LRU lists */
+      return NO_ERROR;
+    }
+  num_lists = ((pgbuf_Pool.num_LRU_list - flusher_idx - 1) / num_flushers
+	       + 1);
+
   mnt_pb_victims (thread_p);
 
   er_set (ER_NOTIFICATION_SEVERITY, ARG_FILE_LINE,
 	  ER_LOG_FLUSH_VICTIM_STARTED, 0);
   er_log_debug (ARG_FILE_LINE, "start flush victim candidates\n");
 
-  assert (flush_ratio == PGBUF_VICTIM_FLUSH_MAX_RATIO
-	  || flush_ratio == PGBUF_VICTIM_FLUSH_MIN_RATIO);
   check_count = MAX (1, (int) (PGBUF_LRU_SIZE * flush_ratio));
 
   victim_cand_list = ((PGBUF_VICTIM_CANDIDATE_LIST *)
 		      malloc (sizeof (PGBUF_VICTIM_CANDIDATE_LIST)
-			      * check_count));
+			      * check_count * num_lists));
   if (victim_cand_list == NULL)
     {
       er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
-	      sizeof (PGBUF_VICTIM_CANDIDATE_LIST) * check_count);
+	      sizeof (PGBUF_VICTIM_CANDIDATE_LIST) * check_count * num_lists);
       return ER_OUT_OF_VIRTUAL_MEMORY;
     }
 
-  total_flushed_count = 0;
-  lru_idx = ((pgbuf_Pool.last_flushed_LRU_list_idx + 1)
-	     % pgbuf_Pool.num_LRU_list);
-  start_lru_idx = lru_idx;
-
-  do
+  /* phase 1: collect the victim candidates of the LRU lists */
+  cand_count = 0;
+  for (lru_idx = flusher_idx; lru_idx < pgbuf_Pool.num_LRU_list;
+       lru_idx += num_flushers)
     {
-      clean_count = cand_count = 0;
+      lru_list = &pgbuf_Pool.buf_LRU_list[lru_idx];
+      clean_count = list_cand_count = 0;
 
-      MUTEX_LOCK_VIA_BUSY_WAIT (rv,
-				pgbuf_Pool.buf_LRU_list[lru_idx].LRU_mutex);
-      bufptr = pgbuf_Pool.buf_LRU_list[lru_idx].LRU_bottom;
+      MUTEX_LOCK_VIA_BUSY_WAIT (rv, lru_list->LRU_mutex);
+      bufptr = lru_list->LRU_bottom;
 
       while ((bufptr != NULL) && (bufptr->zone != PGBUF_LRU_1_ZONE)
-	     && ((clean_count + cand_count) < check_count))
+	     && ((clean_count + list_cand_count) < check_count))
 	{
 	  if (bufptr->fcnt != 0)
 	    {			/* BCB is in fixed state */
@@ -2060,10 +2514,9 @@ pgbuf_flush_victim_candidate (THREAD_ENTRY * thread_p, float flush_ratio)
 	       * the possibility of checking if it is a victim candidate.
 	       */
 	      prev_bufptr = bufptr->prev_BCB;
-	      if (bufptr == pgbuf_Pool.buf_LRU_list[lru_idx].LRU_bottom)
+	      if (bufptr == lru_list->LRU_bottom)
 		{
-		  pgbuf_Pool.buf_LRU_list[lru_idx].LRU_bottom =
-		    bufptr->prev_BCB;
+		  lru_list->LRU_bottom = bufptr->prev_BCB;
 		}
 
 	      if (bufptr->prev_BCB != NULL)
@@ -2090,96 +2543,252 @@ pgbuf_flush_victim_candidate (THREAD_ENTRY * thread_p, float flush_ratio)
 	    }
 	  else
 	    {
-	      if (cand_count >= check_count)
-		{
-		  assert (0);
-		  break;
-		}
-
 	      /* save victim candidate information temporarily. */
 	      victim_cand_list[cand_count].bufptr = bufptr;
 	      victim_cand_list[cand_count].vpid = bufptr->vpid;
 	      LSA_COPY (&victim_cand_list[cand_count].recLSA,
 			&bufptr->oldest_unflush_lsa);
 	      cand_count++;
+	      list_cand_count++;
 	    }
 	  bufptr = bufptr->prev_BCB;
 	}
-      MUTEX_UNLOCK (pgbuf_Pool.buf_LRU_list[lru_idx].LRU_mutex);
-
-      /* for each victim candidate, do flush task */
-      for (i = 0; i < cand_count; i++)
-	{
-	  bufptr = victim_cand_list[i].bufptr;
+      MUTEX_UNLOCK (lru_list->LRU_mutex);
+    }
 
-	  MUTEX_LOCK_VIA_BUSY_WAIT (rv, bufptr->BCB_mutex);
-	  /* flush condition check */
-	  if (!VPID_EQ (&bufptr->vpid, &victim_cand_list[i].vpid)
-	      || bufptr->dirty == false
-	      || (bufptr->zone != PGBUF_LRU_2_ZONE
-		  && bufptr->zone != PGBUF_LRU_1_ZONE)
-	      || bufptr->latch_mode != PGBUF_NO_LATCH
-	      || !(LSA_EQ (&bufptr->oldest_unflush_lsa,
-			   &victim_cand_list[i].recLSA)))
-	    {
-	      MUTEX_UNLOCK (bufptr->BCB_mutex);
-	      continue;
-	    }
+  /* phase 2: latch the candidates which are still to be flushed,
+   * in the order of their location on the disk
+   */
+  qsort (victim_cand_list, cand_count, sizeof (PGBUF_VICTIM_CANDIDATE_LIST),
+	 pgbuf_compare_victim_list);
 
-	  /* pgbuf_flush_bcb() will release bufptr->BCB_mutex
-	   * regardless of its return value.
-	   */
-#if !defined(NDEBUG)
-	  if (pgbuf_flush_bcb (thread_p, bufptr, false,
-			       caller_file, caller_line) != NO_ERROR)
-#else /* NDEBUG */
-	  if (pgbuf_flush_bcb (thread_p, bufptr, false) != NO_ERROR)
-#endif /* NDEBUG */
-	    {
-	      if (victim_cand_list != NULL)
-		{
-		  free_and_init (victim_cand_list);
-		}
-	      er_set (ER_NOTIFICATION_SEVERITY, ARG_FILE_LINE,
-		      ER_LOG_FLUSH_VICTIM_FINISHED, 1, total_flushed_count);
-	      return ER_FAILED;
-	    }
+  LSA_SET_NULL (&flush_upto_lsa);
+  j = 0;
+  for (i = 0; i < cand_count; i++)
+    {
+      bufptr = victim_cand_list[i].bufptr;
 
-	  total_flushed_count++;
+      MUTEX_LOCK_VIA_BUSY_WAIT (rv, bufptr->BCB_mutex);
+      /* flush condition check */
+      if (!VPID_EQ (&bufptr->vpid, &victim_cand_list[i].vpid)
+	  || bufptr->dirty == false
+	  || (bufptr->zone != PGBUF_LRU_2_ZONE
+	      && bufptr->zone != PGBUF_LRU_1_ZONE)
+	  || bufptr->latch_mode != PGBUF_NO_LATCH
+	  || !(LSA_EQ (&bufptr->oldest_unflush_lsa,
+		       &victim_cand_list[i].recLSA)))
+	{
+	  MUTEX_UNLOCK (bufptr->BCB_mutex);
+	  continue;
 	}
 
-      /* Note that we don't hold the mutex, however it will not be an issue.
-       * Also note that we are updating the last_flushed_LRU_list_idx
-       * whether the list has flushed or not.
+      /* Writers are blocked by the flush latch, so the page LSA does not
+       * change until the page is written.
        */
-      pgbuf_Pool.last_flushed_LRU_list_idx = lru_idx;
+      bufptr->latch_mode = PGBUF_LATCH_FLUSH;
+      bufptr->async_flush_request = false;
+      page_lsa = &bufptr->iopage_buffer->iopage.prv.lsa;
+      if (LSA_ISNULL (&flush_upto_lsa) || LSA_LT (&flush_upto_lsa, page_lsa))
+	{
+	  LSA_COPY (&flush_upto_lsa, page_lsa);
+	}
+      MUTEX_UNLOCK (bufptr->BCB_mutex);
 
-      lru_idx = (lru_idx + 1) % pgbuf_Pool.num_LRU_list;
+      victim_cand_list[j++] = victim_cand_list[i];
     }
-  while (lru_idx != start_lru_idx);	/* check if we've visited all of the lists */
+  cand_count = j;
 
-  if (victim_cand_list != NULL)
+  /* phase 3: confirm WAL protocol for all the latched pages at once */
+  if (cand_count > 0)
     {
-      free_and_init (victim_cand_list);
+      logpb_flush_log_for_wal (thread_p, &flush_upto_lsa);
     }
 
-  er_log_debug (ARG_FILE_LINE, "pgbuf_flush_victim_candidate: "
-		"flush %d pages from (%d) to (%d) list.",
-		total_flushed_count, start_lru_idx,
-		pgbuf_Pool.last_flushed_LRU_list_idx);
-
-  er_set (ER_NOTIFICATION_SEVERITY, ARG_FILE_LINE,
-	  ER_LOG_FLUSH_VICTIM_FINISHED, 1, total_flushed_count);
-  er_log_debug (ARG_FILE_LINE, "end flush victim candidates\n");
+  /* phase 4: write each run of adjacent pages and release the latches */
+  total_flushed_count = 0;
+  for (i = 0; i < cand_count; i = j)
+    {
+      for (j = i + 1;
+	   j < cand_count && j - i < PGBUF_FLUSH_MAX_COALESCE_PAGES
+	   && victim_cand_list[j].vpid.volid == victim_cand_list[i].vpid.volid
+	   && (victim_cand_list[j].vpid.pageid
+	       == victim_cand_list[j - 1].vpid.pageid + 1); j++)
+	{
+	  ;
+	}
 
-  return NO_ERROR;
-}
+      for (k = i; k < j; k++)
+	{
+	  io_page_array[k - i] =
+	    &victim_cand_list[k].bufptr->iopage_buffer->iopage;
+	}
+
+      if (error == NO_ERROR
+	  && fileio_writev (thread_p,
+			    fileio_get_volume_descriptor (victim_cand_list[i].
+							  vpid.volid),
+			    io_page_array, victim_cand_list[i].vpid.pageid,
+			    j - i, IO_PAGESIZE) == NULL)
+	{
+	  /* stop writing, but release the latches of the rest */
+	  error = ER_FAILED;
+	}
+
+      for (k = i; k < j; k++)
+	{
+	  bufptr = victim_cand_list[k].bufptr;
+	  if (error == NO_ERROR)
+	    {
+	      /* Record number of writes in statistics */
+	      mnt_pb_iowrites (thread_p);
+	      pgbuf_set_bcb_flushed (bufptr);
+	      total_flushed_count++;
+	    }
+	  else
+	    {
+	      MUTEX_LOCK_VIA_BUSY_WAIT (rv, bufptr->BCB_mutex);
+	    }
+
+	  /* bufptr->BCB_mutex is released in the following function */
+#if !defined(NDEBUG)
+	  if (pgbuf_end_flush_bcb (thread_p, bufptr, caller_file, caller_line)
+	      != NO_ERROR)
+#else /* NDEBUG */
+	  if (pgbuf_end_flush_bcb (thread_p, bufptr) != NO_ERROR)
+#endif /* NDEBUG */
+	    {
+	      error = ER_FAILED;
+	    }
+	}
+    }
+
+  free_and_init (victim_cand_list);
+
+  er_log_debug (ARG_FILE_LINE, "pgbuf_flush_victim_candidate: "
+		"flush %d pages from %d lists of flusher (%d).",
+		total_flushed_count, num_lists, flusher_idx);
+
+  er_set (ER_NOTIFICATION_SEVERITY, ARG_FILE_LINE,
+	  ER_LOG_FLUSH_VICTIM_FINISHED, 1, total_flushed_count);
+  er_log_debug (ARG_FILE_LINE, "end flush victim candidates\n");
+
+  return error;
+}
+
+/*
+ * pgbuf_compare_victim_list () - Compare the pages of two victim candidates
+ *   return: negative, zero, or positive as the page of p1 is located before,
+ *           at, or after the page of p2
+ *   p1(in): victim candidate
+ *   p2(in): victim candidate
+ */
+static int
+pgbuf_compare_victim_list (const void *p1, const void *p2)
+{
+  const VPID *vpid1, *vpid2;
+
+  vpid1 = &((const PGBUF_VICTIM_CANDIDATE_LIST *) p1)->vpid;
+  vpid2 = &((const PGBUF_VICTIM_CANDIDATE_LIST *) p2)->vpid;
+
+  if (vpid1->volid != vpid2->volid)
+    {
+      return vpid1->volid - vpid2->volid;
+    }
+
+  return ((vpid1->pageid < vpid2->pageid) ? -1
+	  : ((vpid1->pageid > vpid2->pageid) ? 1 : 0));
+}
+
+/*
+ * pgbuf_compare_dirty_page_table () - Compare the oldest unflushed LSAs of
+ *                                     two dirty page table entries
+ *   return: negative, zero, or positive as the page of p1 was dirtied
+ *           before, at, or after the page of p2
+ *   p1(in): dirty page table entry
+ *   p2(in): dirty page table entry
+ */
+static int
+pgbuf_compare_dirty_page_table (const void *p1, const void *p2)
+{
+  const LOG_LSA *lsa1, *lsa2;
+
+  lsa1 = &((const PGBUF_VICTIM_CANDIDATE_LIST *) p1)->recLSA;
+  lsa2 = &((const PGBUF_VICTIM_CANDIDATE_LIST *) p2)->recLSA;
+
+  if (LSA_LT (lsa1, lsa2))
+    {
+      return -1;
+    }
+
+  return LSA_EQ (lsa1, lsa2) ? 0 : 1;
+}
+
+#if defined(SERVER_MODE)
+/*
+ * pgbuf_pace_check_point () - Sleep while a checkpoint is ahead of its
+ *                             flush schedule
+ *   return: void
+ *   start_tv(in): time the checkpoint flush started
+ *   start_log_pageid(in): log append page when the checkpoint flush started
+ *   spread_msec(in): checkpoint interval
+ *   nflushed(in): # of dirty page table entries processed so far
+ *   npages(in): # of entries in the dirty page table
+ *
+ * Note: The writes are scheduled to finish within
+ *       PGBUF_CHKPT_COMPLETION_TARGET of the checkpoint interval, but no
+ *       later than PGBUF_CHKPT_MAX_SPREAD_MSEC, since the redo point only
+ *       advances when the checkpoint record is written after the flush.
+ *       When the log grows fast enough to reach checkpoint_every_npages
+ *       before that, the schedule is shortened to the time that log
+ *       generation rate leaves until the next checkpoint, so that the redo
+ *       point keeps up with the log. The writes themselves still go through
+ *       the flush control token bucket.
+ */
+static void
+pgbuf_pace_check_point (THREAD_ENTRY * thread_p, struct timeval *start_tv,
+			PAGEID start_log_pageid, int spread_msec,
+			int nflushed, int npages)
+{
+  struct timeval now_tv, diff_tv;
+  double elapsed_msec, deadline_msec, log_deadline_msec, target_msec;
+  PAGEID log_npages;
+
+  while (thread_p == NULL || !thread_p->shutdown)
+    {
+      (void) gettimeofday (&now_tv, NULL);
+      DIFF_TIMEVAL (*start_tv, now_tv, diff_tv);
+      elapsed_msec = diff_tv.tv_sec * 1000.0 + diff_tv.tv_usec / 1000.0;
+
+      deadline_msec = (double) spread_msec;
+      log_npages = log_Gl.hdr.append_lsa.pageid - start_log_pageid;
+      if (PRM_LOG_CHECKPOINT_NPAGES > 0 && log_npages > 0)
+	{
+	  log_deadline_msec = (elapsed_msec * PRM_LOG_CHECKPOINT_NPAGES
+			       / log_npages);
+	  deadline_msec = MIN (deadline_msec, log_deadline_msec);
+	}
+      deadline_msec = MIN (deadline_msec * PGBUF_CHKPT_COMPLETION_TARGET,
+			   PGBUF_CHKPT_MAX_SPREAD_MSEC);
+
+      target_msec = deadline_msec * nflushed / npages;
+      if (elapsed_msec >= target_msec)
+	{
+	  return;
+	}
+
+      target_msec = MIN (target_msec - elapsed_msec,
+			 PGBUF_CHKPT_MAX_SLEEP_MSEC);
+      thread_sleep (0, MAX (1000, (int) (target_msec * 1000)));
+    }
+}
+#endif /* SERVER_MODE */
 
 /*
  * pgbuf_flush_check_point () - Flush any unfixed dirty page whose lsa
  *                                      is smaller than the last checkpoint lsa
  *   return: void
  *   last_chkpt_lsa(in): Last checkpoint log sequence address
+ *   spread_msec(in): Interval over which the writes are spread, or 0
  *   smallest_lsa(out): Smallest LSA of a dirty buffer in buffer pool
  *
  * Note: The function flushes and dirty unfixed page whose LSA is smaller that
@@ -2187,34 +2796,106 @@ pgbuf_flush_victim_candidate (THREAD_ENTRY * thread_p, float flush_ratio)
  *       dirty buffers which were not flushed.
  *       This function is used by the log and recovery manager when a
  *       checkpoint is issued.
+ *
+ *       The dirty pages are collected into a dirty page table and flushed in
+ *       the order of their oldest_unflush_lsa, so the redo point advances
+ *       with every page written. When spread_msec is given, the writes are
+ *       paced over the interval (see pgbuf_pace_check_point); the flush
+ *       stops early on shutdown and the pages left are accounted for in
+ *       smallest_lsa.
  */
 #if !defined(NDEBUG)
 void
 pgbuf_flush_check_point_debug (THREAD_ENTRY * thread_p,
 			       const LOG_LSA * last_chkpt_lsa,
-			       LOG_LSA * smallest_lsa,
+			       int spread_msec, LOG_LSA * smallest_lsa,
 			       const char *caller_file, int caller_line)
 #else /* NDEBUG */
 void
 pgbuf_flush_check_point (THREAD_ENTRY * thread_p,
 			 const LOG_LSA * last_chkpt_lsa,
-			 LOG_LSA * smallest_lsa)
+			 int spread_msec, LOG_LSA * smallest_lsa)
 #endif				/* NDEBUG */
 {
   PGBUF_BCB *bufptr;
-  int bufid;
+  PGBUF_VICTIM_CANDIDATE_LIST *dirty_page_table;
+  int bufid, npages, i;
 #if defined(SERVER_MODE)
   int rv;
+  struct timeval start_tv;
+  PAGEID start_log_pageid;
 #endif /* SERVER_MODE */
 
   /* Things must be truly flushed up to this lsa */
   logpb_flush_log_for_wal (thread_p, last_chkpt_lsa);
   LSA_SET_NULL (smallest_lsa);
 
-  /* Now, flush all unfixed dirty buffers */
+  dirty_page_table = ((PGBUF_VICTIM_CANDIDATE_LIST *)
+		      malloc (sizeof (PGBUF_VICTIM_CANDIDATE_LIST)
+			      * pgbuf_Pool.num_buffers));
+  if (dirty_page_table == NULL)
+    {
+      /* nothing is flushed, but smallest_lsa is still computed below */
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      sizeof (PGBUF_VICTIM_CANDIDATE_LIST) * pgbuf_Pool.num_buffers);
+    }
+
+  /* build the dirty page table */
+  npages = 0;
   for (bufid = 0; bufid < pgbuf_Pool.num_buffers; bufid++)
     {
       bufptr = PGBUF_FIND_BCB_PTR (bufid);
+      MUTEX_LOCK_VIA_BUSY_WAIT (rv, bufptr->BCB_mutex);
+      if (bufptr->dirty == false || LSA_ISNULL (&bufptr->oldest_unflush_lsa))
+	{
+	  MUTEX_UNLOCK (bufptr->BCB_mutex);
+	  continue;
+	}
+
+      if (dirty_page_table != NULL
+	  && LSA_LE (&bufptr->oldest_unflush_lsa, last_chkpt_lsa))
+	{
+	  dirty_page_table[npages].bufptr = bufptr;
+	  dirty_page_table[npages].vpid = bufptr->vpid;
+	  LSA_COPY (&dirty_page_table[npages].recLSA,
+		    &bufptr->oldest_unflush_lsa);
+	  npages++;
+	}
+      else if (LSA_ISNULL (smallest_lsa)
+	       || LSA_LT (&bufptr->oldest_unflush_lsa, smallest_lsa))
+	{
+	  /* get the smallest oldest_unflush_lsa */
+	  LSA_COPY (smallest_lsa, &bufptr->oldest_unflush_lsa);
+	}
+      MUTEX_UNLOCK (bufptr->BCB_mutex);
+    }
+
+  if (dirty_page_table == NULL)
+    {
+      return;
+    }
+
+  qsort (dirty_page_table, npages, sizeof (PGBUF_VICTIM_CANDIDATE_LIST),
+	 pgbuf_compare_dirty_page_table);
+
+#if defined(SERVER_MODE)
+  (void) gettimeofday (&start_tv, NULL);
+  start_log_pageid = log_Gl.hdr.append_lsa.pageid;
+#endif /* SERVER_MODE */
+
+  /* Now, flush the unfixed dirty buffers from the oldest one */
+  for (i = 0; i < npages; i++)
+    {
+      bufptr = dirty_page_table[i].bufptr;
+
+#if defined(SERVER_MODE)
+      if (thread_p != NULL && thread_p->shutdown)
+	{
+	  /* keep the rest for the next checkpoint */
+	  break;
+	}
+#endif /* SERVER_MODE */
+
       MUTEX_LOCK_VIA_BUSY_WAIT (rv, bufptr->BCB_mutex);
       /* flush condition check */
       if (bufptr->dirty == false || LSA_ISNULL (&bufptr->oldest_unflush_lsa))
@@ -2224,7 +2905,8 @@ pgbuf_flush_check_point (THREAD_ENTRY * thread_p,
 	}
 
       /* flush when buffer is not fixed or was fixed by reader */
-      if (LSA_LE (&bufptr->oldest_unflush_lsa, last_chkpt_lsa)
+      if (VPID_EQ (&bufptr->vpid, &dirty_page_table[i].vpid)
+	  && LSA_LE (&bufptr->oldest_unflush_lsa, last_chkpt_lsa)
 	  && (bufptr->latch_mode == PGBUF_NO_LATCH
 	      || bufptr->latch_mode == PGBUF_LATCH_READ
 	      || bufptr->latch_mode == PGBUF_LATCH_FLUSH))
@@ -2237,22 +2919,50 @@ pgbuf_flush_check_point (THREAD_ENTRY * thread_p,
 #endif /* NDEBUG */
 
 #if defined(SERVER_MODE)
-	  /* Checkpoint Thread is writing data pages slowly to avoid IO burst */
-	  thread_sleep (0, 1 * 1000);	/* 1 msec */
+	  if (spread_msec > 0)
+	    {
+	      /* nothing to wait for after the last page */
+	      if (i + 1 < npages)
+		{
+		  pgbuf_pace_check_point (thread_p, &start_tv,
+					  start_log_pageid, spread_msec,
+					  i + 1, npages);
+		}
+	    }
+	  else
+	    {
+	      /* Checkpoint Thread is writing data pages slowly to avoid IO
+	       * burst */
+	      thread_sleep (0, 1 * 1000);	/* 1 msec */
+	    }
 #endif
 	}
       else
 	{
-	  /* get the smallest oldest_unflush_lsa */
+	  /* get the smallest oldest_unflush_lsa. The LSA recorded in the
+	   * table is used, since the page may have been flushed and dirtied
+	   * again after the table was built. */
 	  if (LSA_ISNULL (smallest_lsa)
-	      || LSA_LT (&bufptr->oldest_unflush_lsa, smallest_lsa))
+	      || LSA_LT (&dirty_page_table[i].recLSA, smallest_lsa))
 	    {
-	      LSA_COPY (smallest_lsa, &bufptr->oldest_unflush_lsa);
+	      LSA_COPY (smallest_lsa, &dirty_page_table[i].recLSA);
 	    }
 
 	  MUTEX_UNLOCK (bufptr->BCB_mutex);
 	}
     }
+
+  /* the entries left behind are not flushed */
+  for (; i < npages; i++)
+    {
+      if (LSA_ISNULL (smallest_lsa)
+	  || LSA_LT (&dirty_page_table[i].recLSA, smallest_lsa))
+	{
+	  LSA_COPY (smallest_lsa, &dirty_page_table[i].recLSA);
+	}
+    }
+
+  free_and_init (dirty_page_table);
 }
 
 /*
@@ -2303,7 +3013,7 @@ pgbuf_copy_to_area (THREAD_ENTRY * thread_p, const VPID * vpid,
 
   /* Is this a resident page ? */
   hash_anchor = &(pgbuf_Pool.buf_hash_table[PGBUF_HASH_VALUE (vpid)]);
-  bufptr = pgbuf_search_hash_chain (hash_anchor, vpid);
+  bufptr = pgbuf_search_hash_chain (thread_p, hash_anchor, vpid);
 
   if (bufptr == NULL)
     {
@@ -2410,7 +3120,7 @@ pgbuf_copy_from_area (THREAD_ENTRY * thread_p, const VPID * vpid,
 
   /* Is this a resident page ? */
   hash_anchor = &(pgbuf_Pool.buf_hash_table[PGBUF_HASH_VALUE (vpid)]);
-  bufptr = pgbuf_search_hash_chain (hash_anchor, vpid);
+  bufptr = pgbuf_search_hash_chain (thread_p, hash_anchor, vpid);
 
   if (bufptr == NULL)
     {
@@ -3011,7 +3721,10 @@ pgbuf_initialize_bcb_table (void)
       bufptr->dirty = false;
       bufptr->avoid_victim = false;
       bufptr->async_flush_request = false;
+      bufptr->bulk_read = false;
+      bufptr->read_ahead = false;
       bufptr->zone = PGBUF_INVALID_ZONE;
+      bufptr->lru_idx = 0;
       LSA_SET_NULL (&bufptr->oldest_unflush_lsa);
 
       /* link BCB and iopage buffer */
@@ -3054,6 +3767,9 @@ pgbuf_initialize_hash_table (void)
   for (i = 0; i < hashsize; i++)
     {
       MUTEX_INIT (pgbuf_Pool.buf_hash_table[i].hash_mutex);
+#if defined(SERVER_MODE)
+      pgbuf_Pool.buf_hash_table[i].version = 0;
+#endif /* SERVER_MODE */
       pgbuf_Pool.buf_hash_table[i].hash_next = NULL;
       pgbuf_Pool.buf_hash_table[i].lock_next = NULL;
     }
@@ -3104,7 +3820,6 @@ pgbuf_initialize_lru_list (void)
   int i;
 
   /* set the number of LRU lists */
-  pgbuf_Pool.last_flushed_LRU_list_idx = -1;
   pgbuf_Pool.num_LRU_list = PRM_PB_NUM_LRU_CHAINS;
   if (pgbuf_Pool.num_LRU_list == 0)
     {
@@ -3131,6 +3846,13 @@ pgbuf_initialize_lru_list (void)
       pgbuf_Pool.buf_LRU_list[i].LRU_bottom = NULL;
       pgbuf_Pool.buf_LRU_list[i].LRU_middle = NULL;
       pgbuf_Pool.buf_LRU_list[i].LRU_1_zone_cnt = 0;
+#if defined(CUBRID_DEBUG)
+      pgbuf_Pool.buf_LRU_list[i].num_fetches = 0;
+      pgbuf_Pool.buf_LRU_list[i].num_hits = 0;
+      pgbuf_Pool.buf_LRU_list[i].num_victims = 0;
+      pgbuf_Pool.buf_LRU_list[i].num_steals = 0;
+      pgbuf_Pool.buf_LRU_list[i].num_victim_search = 0;
+#endif /* CUBRID_DEBUG */
     }
 
   return NO_ERROR;
@@ -3883,7 +4605,14 @@ pgbuf_unlatch_bcb_upon_unfix (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr)
 	  && pgbuf_is_exist_blocked_reader_writer (bufptr) == false
 	  && bufptr->zone != PGBUF_LRU_1_ZONE)
 	{
-	  (void) pgbuf_relocate_top_lru (bufptr);
+	  if (bufptr->bulk_read == true)
+	    {
+	      (void) pgbuf_relocate_bottom_lru (thread_p, bufptr);
+	    }
+	  else
+	    {
+	      (void) pgbuf_relocate_top_lru (thread_p, bufptr);
+	    }
 	}
     }
 
@@ -3973,6 +4702,7 @@ pgbuf_block_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr,
 {
 #if defined(SERVER_MODE)
   THREAD_ENTRY *cur_thrd_entry, *thrd_entry;
+  struct timeval wait_start_time;
   int r;
 
   /* caller is holding bufptr->BCB_mutex */
@@ -4012,9 +4742,12 @@ pgbuf_block_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr,
 	}
     }
 
+  gettimeofday (&wait_start_time, NULL);
+
   if (request_mode == PGBUF_LATCH_FLUSH || request_mode == PGBUF_LATCH_VICTIM)
     {
       pgbuf_sleep (cur_thrd_entry, &bufptr->BCB_mutex);
+      mnt_lat_record (thread_p, MNT_LAT_PGBUF_FIX_WAIT, 0, &wait_start_time);
 
       if (cur_thrd_entry->resume_status != THREAD_PGBUF_RESUMED)
 	{
@@ -4060,11 +4793,13 @@ pgbuf_block_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr,
        * When the request is waken up, the request is treated as a victim.
        */
 #if !defined(NDEBUG)
-      if (pgbuf_timed_sleep (thread_p, bufptr, cur_thrd_entry,
-			     caller_file, caller_line) != NO_ERROR)
+      r = pgbuf_timed_sleep (thread_p, bufptr, cur_thrd_entry,
+			     caller_file, caller_line);
 #else /* NDEBUG */
-      if (pgbuf_timed_sleep (thread_p, bufptr, cur_thrd_entry) != NO_ERROR)
+      r = pgbuf_timed_sleep (thread_p, bufptr, cur_thrd_entry);
 #endif /* NDEBUG */
+      mnt_lat_record (thread_p, MNT_LAT_PGBUF_FIX_WAIT, 0, &wait_start_time);
+      if (r != NO_ERROR)
 	{
 	  return ER_FAILED;
 	}
@@ -4509,19 +5244,38 @@ pgbuf_wakeup_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr)
  *   return: if success, BCB pointer, otherwise NULL
  *   hash_anchor(in):
  *   vpid(in):
+ *
+ * Note: The chain is first walked without hash_mutex. The version of the
+ *       hash anchor is sampled before and after the walk, and the walk is
+ *       retried when the chain has been modified in the meantime. Only when
+ *       the page is not resident, or the optimistic walk keeps failing,
+ *       the chain is searched again while holding hash_mutex.
  */
 static PGBUF_BCB *
-pgbuf_search_hash_chain (PGBUF_BUFFER_HASH * hash_anchor, const VPID * vpid)
+pgbuf_search_hash_chain (THREAD_ENTRY * thread_p,
+			 PGBUF_BUFFER_HASH * hash_anchor, const VPID * vpid)
 {
   PGBUF_BCB *bufptr;
 #if defined(SERVER_MODE)
   int ret;
   int loop_cnt;
+  int retry_cnt = 0;
+  unsigned int version;
 #endif
 
 /* one_phase: no hash-chain mutex */
 one_phase:
 
+#if defined(SERVER_MODE)
+  version = hash_anchor->version;
+  MEMORY_BARRIER ();
+  if (version & 1)
+    {
+      /* the chain is being modified */
+      goto retry_one_phase;
+    }
+#endif /* SERVER_MODE */
+
   bufptr = hash_anchor->hash_next;
   while (bufptr != NULL)
     {
@@ -4543,6 +5297,8 @@ one_phase:
 	      if (ret != TRYLOCK_EBUSY)
 		{
 		  /* give up one_phase */
+		  bufptr->avoid_victim = false;
+		  mnt_pb_hash_opt_fallbacks (thread_p);
 		  goto two_phase;
 		}
 
@@ -4563,8 +5319,11 @@ one_phase:
 	    {
 	      /* updated or replaced */
 	      MUTEX_UNLOCK (bufptr->BCB_mutex);
-	      /* retry one_phase */
+#if defined(SERVER_MODE)
+	      goto retry_one_phase;
+#else /* SERVER_MODE */
 	      goto one_phase;
+#endif /* SERVER_MODE */
 	    }
 	  break;
 	}
@@ -4573,10 +5332,29 @@ one_phase:
 
   if (bufptr != NULL)
     {
+      mnt_pb_hash_opt_hits (thread_p);
       return bufptr;
     }
 
 #if defined(SERVER_MODE)
+  MEMORY_BARRIER ();
+  if (hash_anchor->version == version)
+    {
+      /* The chain was not changed during the walk.
+       * The page is not resident, hash_mutex is needed to lock the page.
+       */
+      goto two_phase;
+    }
+
+retry_one_phase:
+
+  mnt_pb_hash_opt_retries (thread_p);
+  if (++retry_cnt < PGBUF_HASH_OPT_READ_MAX_RETRY)
+    {
+      goto one_phase;
+    }
+  mnt_pb_hash_opt_fallbacks (thread_p);
+
 /* two_phase: hold hash-chain mutex */
 two_phase:
 #endif
@@ -4646,6 +5424,35 @@ try_again:
   return bufptr;
 }
 
+#if defined(SERVER_MODE)
+/*
+ * pgbuf_is_resident () - Check if the page is in the buffer pool
+ *   return: true/false
+ *   vpid(in): page identifier
+ *
+ * Note: The hash chain is walked without hash_mutex, so the answer is just
+ *       a hint which may be already stale when the function returns.
+ */
+static bool
+pgbuf_is_resident (const VPID * vpid)
+{
+  PGBUF_BUFFER_HASH *hash_anchor;
+  PGBUF_BCB *bufptr;
+
+  hash_anchor = &pgbuf_Pool.buf_hash_table[PGBUF_HASH_VALUE (vpid)];
+  for (bufptr = hash_anchor->hash_next; bufptr != NULL;
+       bufptr = bufptr->hash_next)
+    {
+      if (VPID_EQ (&(bufptr->vpid), vpid))
+	{
+	  return true;
+	}
+    }
+
+  return false;
+}
+#endif /* SERVER_MODE */
+
 /*
  * pgbuf_insert_into_hash_chain () - Inserts BCB into the hash chain
  *   return: NO_ERROR
@@ -4667,8 +5474,10 @@ pgbuf_insert_into_hash_chain (PGBUF_BUFFER_HASH * hash_anchor,
 
   /* Note that the caller is not holding bufptr->BCB_mutex */
   MUTEX_LOCK (rv, hash_anchor->hash_mutex);
+  PGBUF_HASH_CHAIN_BEGIN_UPDATE (hash_anchor);
   bufptr->hash_next = hash_anchor->hash_next;
   hash_anchor->hash_next = bufptr;
+  PGBUF_HASH_CHAIN_END_UPDATE (hash_anchor);
 
   /*
    * hash_anchor->hash_mutex is not released at this place.
@@ -4737,6 +5546,7 @@ pgbuf_delete_from_hash_chain (PGBUF_BCB * bufptr)
 	}
 
       /* disconnect the BCB from the buffer hash chain */
+      PGBUF_HASH_CHAIN_BEGIN_UPDATE (hash_anchor);
       if (prev_bufptr == NULL)
 	{
 	  hash_anchor->hash_next = curr_bufptr->hash_next;
@@ -4747,6 +5557,7 @@ pgbuf_delete_from_hash_chain (PGBUF_BCB * bufptr)
 	}
 
       curr_bufptr->hash_next = NULL;
+      PGBUF_HASH_CHAIN_END_UPDATE (hash_anchor);
       MUTEX_UNLOCK (hash_anchor->hash_mutex);
       VPID_SET_NULL (&(bufptr->vpid));
 
@@ -4966,7 +5777,7 @@ try_again:
    * that is, invalid BCB list is empty,
    * allocate a BCB from the bottom of LRU list
    */
-  bufptr = pgbuf_get_victim_from_lru_list (vpid);
+  bufptr = pgbuf_get_victim_from_lru_list (thread_p, vpid);
   if (bufptr != NULL)
     {
       /* the caller is holding bufptr->BCB_mutex. */
@@ -5294,87 +6105,14 @@ pgbuf_flush_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, int synchronous)
       /* all the blocked flushers on the BCB waiting queue
        * have been waken up in pgbuf_flush_page_with_wal().
        */
-      if (bufptr->fcnt == 0)
-	{
-#if defined(SERVER_MODE)
-	  if (bufptr->latch_mode == PGBUF_LATCH_FLUSH_INVALID)
-	    {
-	      if (bufptr->next_wait_thrd == NULL)
-		{
-		  /* There is no blocked threads(or transactions). */
-		  /* Therefore, invalidate the BCB */
-		  if (pgbuf_delete_from_hash_chain (bufptr) != NO_ERROR)
-		    {
-		      return ER_FAILED;
-		    }
-
-		  /*
-		   * If above function returns success,
-		   * the caller is still holding bufptr->BCB_mutex.
-		   * Otherwise, the caller does not hold bufptr->BCB_mutex.
-		   */
-
-		  /* Now, the caller is holding bufptr->BCB_mutex. */
-		  /* bufptr->BCB_mutex will be released in following function. */
-		  pgbuf_put_bcb_into_invalid_list (bufptr);
-		}
-	      else
-		{
-		  /* only writer might be blocked */
-		  bufptr->latch_mode = PGBUF_NO_LATCH;
-		  if (bufptr->next_wait_thrd != NULL)
-		    {
-		      /* wake up blocked threads(or transactions). */
-#if !defined(NDEBUG)
-		      if (pgbuf_wakeup_bcb (thread_p, bufptr,
-					    caller_file,
-					    caller_line) != NO_ERROR)
-#else /* NDEBUG */
-		      if (pgbuf_wakeup_bcb (thread_p, bufptr) != NO_ERROR)
-#endif /* NDEBUG */
-			{
-			  return ER_FAILED;
-			}
-
-		      /* Above function released BCB_mutex unconditionally. */
-		    }
-		  else
-		    {
-		      MUTEX_UNLOCK (bufptr->BCB_mutex);
-		    }
-		}
-	    }
-	  else
-	    {
-	      bufptr->latch_mode = PGBUF_NO_LATCH;
-	      if (bufptr->next_wait_thrd != NULL)
-		{
-		  /* wake up blocked threads(or transactions) */
 #if !defined(NDEBUG)
-		  if (pgbuf_wakeup_bcb (thread_p, bufptr,
-					caller_file, caller_line) != NO_ERROR)
+      if (pgbuf_end_flush_bcb (thread_p, bufptr, caller_file, caller_line)
+	  != NO_ERROR)
 #else /* NDEBUG */
-		  if (pgbuf_wakeup_bcb (thread_p, bufptr) != NO_ERROR)
+      if (pgbuf_end_flush_bcb (thread_p, bufptr) != NO_ERROR)
 #endif /* NDEBUG */
-		    {
-		      return ER_FAILED;
-		    }
-		  /* Above function released BCB_mutex unconditionally. */
-		}
-	      else
-		{
-		  MUTEX_UNLOCK (bufptr->BCB_mutex);
-		}
-	    }
-#else /* SERVER_MODE */
-	  bufptr->latch_mode = PGBUF_NO_LATCH;
-	  MUTEX_UNLOCK (bufptr->BCB_mutex);
-#endif /* SERVER_MODE */
-	}
-      else
 	{
-	  bufptr->latch_mode = PGBUF_LATCH_READ;
-	  MUTEX_UNLOCK (bufptr->BCB_mutex);
+	  return ER_FAILED;
 	}
     }
   else
@@ -5428,6 +6166,113 @@ pgbuf_flush_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, int synchronous)
   return NO_ERROR;
 }
 
+/*
+ * pgbuf_end_flush_bcb () - Release the flush latch of the buffer
+ *   return: NO_ERROR, or ER_code
+ *   bufptr(in): pointer to buffer page
+ *
+ * Note: The caller has written the page holding the flush latch and holds
+ *       bufptr->BCB_mutex. If there is no fixer of the page, the latch is
+ *       released and the blocked threads are woken up, and the BCB is
+ *       invalidated if it has been requested during the flush. Otherwise,
+ *       the page is left to the readers fixing it.
+ *
+ *       Before return, it releases BCB mutex.
+ */
+#if !defined(NDEBUG)
+static int
+pgbuf_end_flush_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr,
+		     const char *caller_file, int caller_line)
+#else /* NDEBUG */
+static int
+pgbuf_end_flush_bcb (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr)
+#endif				/* NDEBUG */
+{
+  if (bufptr->fcnt == 0)
+    {
+#if defined(SERVER_MODE)
+      if (bufptr->latch_mode == PGBUF_LATCH_FLUSH_INVALID)
+	{
+	  if (bufptr->next_wait_thrd == NULL)
+	    {
+	      /* There is no blocked threads(or transactions). */
+	      /* Therefore, invalidate the BCB */
+	      if (pgbuf_delete_from_hash_chain (bufptr) != NO_ERROR)
+		{
+		  return ER_FAILED;
+		}
+
+	      /*
+	       * If above function returns success,
+	       * the caller is still holding bufptr->BCB_mutex.
+	       * Otherwise, the caller does not hold bufptr->BCB_mutex.
+	       */
+
+	      /* Now, the caller is holding bufptr->BCB_mutex. */
+	      /* bufptr->BCB_mutex will be released in following function. */
+	      pgbuf_put_bcb_into_invalid_list (bufptr);
+	    }
+	  else
+	    {
+	      /* only writer might be blocked */
+	      bufptr->latch_mode = PGBUF_NO_LATCH;
+	      if (bufptr->next_wait_thrd != NULL)
+		{
+		  /* wake up blocked threads(or transactions). */
+#if !defined(NDEBUG)
+		  if (pgbuf_wakeup_bcb (thread_p, bufptr,
+					caller_file, caller_line) != NO_ERROR)
+#else /* NDEBUG */
+		  if (pgbuf_wakeup_bcb (thread_p, bufptr) != NO_ERROR)
+#endif /* NDEBUG */
+		    {
+		      return ER_FAILED;
+		    }
+
+		  /* Above function released BCB_mutex unconditionally. */
+		}
+	      else
+		{
+		  MUTEX_UNLOCK (bufptr->BCB_mutex);
+		}
+	    }
+	}
+      else
+	{
+	  bufptr->latch_mode = PGBUF_NO_LATCH;
+	  if (bufptr->next_wait_thrd != NULL)
+	    {
+	      /* wake up blocked threads(or transactions) */
+#if !defined(NDEBUG)
+	      if (pgbuf_wakeup_bcb (thread_p, bufptr,
+				    caller_file, caller_line) != NO_ERROR)
+#else /* NDEBUG */
+	      if (pgbuf_wakeup_bcb (thread_p, bufptr) != NO_ERROR)
+#endif /* NDEBUG */
+		{
+		  return ER_FAILED;
+		}
+	      /* Above function released BCB_mutex unconditionally. */
+	    }
+	  else
+	    {
+	      MUTEX_UNLOCK (bufptr->BCB_mutex);
+	    }
+	}
+#else /* SERVER_MODE */
+      bufptr->latch_mode = PGBUF_NO_LATCH;
+      MUTEX_UNLOCK (bufptr->BCB_mutex);
+#endif /* SERVER_MODE */
+    }
+  else
+    {
+      bufptr->latch_mode = PGBUF_LATCH_READ;
+      MUTEX_UNLOCK (bufptr->BCB_mutex);
+    }
+
+  return NO_ERROR;
+}
+
 /*
  * pgbuf_get_bcb_from_invalid_list () - Get BCB from buffer invalid list
  *   return: If success, a newly allocated BCB, otherwise NULL
@@ -5506,52 +6351,85 @@ pgbuf_put_bcb_into_invalid_list (PGBUF_BCB * bufptr)
 }
 
 /*
- * pgbuf_get_lru_index () - Get the index of the LRU list for the given VPID
+ * pgbuf_get_lru_index () - Get the index of the LRU list owned by the
+ *			    current thread
  *   return: the index of the LRU index
+ *   thread_p(in):
  *   vpid(in): VPID
+ *
+ * Note: In the server, every worker thread owns one of the LRU lists (the
+ *       lists are shared when there are more threads than lists). Pages
+ *       brought in by the thread are placed on its list, and victims are
+ *       searched there first. Without threads, the list is chosen by VPID.
  */
 static int
-pgbuf_get_lru_index (const VPID * vpid)
+pgbuf_get_lru_index (THREAD_ENTRY * thread_p, const VPID * vpid)
 {
   int lru_idx;
 
+#if defined(SERVER_MODE)
+  if (thread_p == NULL)
+    {
+      thread_p = thread_get_thread_entry_info ();
+    }
+
+  lru_idx = thread_p->index % pgbuf_Pool.num_LRU_list;
+#else /* SERVER_MODE */
   lru_idx = vpid->pageid % pgbuf_Pool.num_LRU_list;
+#endif /* SERVER_MODE */
 
   return lru_idx;
 }
 
 /*
- * pgbuf_get_victim_from_lru_list () - Get victim BCB from the bottom of
- *				       LRU list
+ * pgbuf_get_victim_from_lru_shard () - Get victim BCB from the bottom of
+ *					the given LRU list
  *   return: If success, BCB, otherwise NULL
- *   vpid(in):
+ *   lru_idx(in): index of the LRU list
+ *   wait(in): if false, the list is skipped when its LRU_mutex is busy
+ *   search_cnt(out): # of examined BCBs is added
+ *   is_busy(out): set to true if the list was skipped
  *
  * Note: This fuction disconnects BCB from the bottom of the LRU list and
  *       returns it if its fcnt == 0. If its fcnt != 0, makes bufptr->PrevBCB
- *       LRU_bottom and retry. While this processing, the caller must be the
- *       holder of the LRU list.
+ *       LRU_bottom and retry. The BCB_mutex of the victim is not held.
  */
 static PGBUF_BCB *
-pgbuf_get_victim_from_lru_list (const VPID * vpid)
+pgbuf_get_victim_from_lru_shard (int lru_idx, bool wait, int *search_cnt,
+				 bool * is_busy)
 {
   PGBUF_BCB *bufptr, *tmp_buf_p;
-  int lru_idx;
+  PGBUF_LRU_LIST *lru_list;
   int check_count;
 #if defined(SERVER_MODE)
   int rv;
 #endif /* SERVER_MODE */
 
-  lru_idx = pgbuf_get_lru_index (vpid);
+  lru_list = &pgbuf_Pool.buf_LRU_list[lru_idx];
 
   /* check if LRU list is empty */
-  if (pgbuf_Pool.buf_LRU_list[lru_idx].LRU_bottom == NULL)
+  if (lru_list->LRU_bottom == NULL)
     {
       return NULL;
     }
 
-  MUTEX_LOCK_VIA_BUSY_WAIT (rv, pgbuf_Pool.buf_LRU_list[lru_idx].LRU_mutex);
+#if defined(SERVER_MODE)
+  if (wait == false)
+    {
+      rv = MUTEX_TRYLOCK (lru_list->LRU_mutex);
+      if (rv != TRYLOCK_SUCCESS)
+	{
+	  *is_busy = true;
+	  return NULL;
+	}
+    }
+  else
+    {
+      MUTEX_LOCK_VIA_BUSY_WAIT (rv, lru_list->LRU_mutex);
+    }
+#endif /* SERVER_MODE */
 
-  while ((bufptr = pgbuf_Pool.buf_LRU_list[lru_idx].LRU_bottom) != NULL)
+  while ((bufptr = lru_list->LRU_bottom) != NULL)
     {
       tmp_buf_p = bufptr;
       check_count =
@@ -5561,6 +6439,7 @@ pgbuf_get_victim_from_lru_list (const VPID * vpid)
       while (tmp_buf_p != NULL && check_count > 0)
 	{
 	  check_count--;
+	  (*search_cnt)++;
 	  if (tmp_buf_p->dirty == false)
 	    {
 	      bufptr = tmp_buf_p;
@@ -5570,19 +6449,19 @@ pgbuf_get_victim_from_lru_list (const VPID * vpid)
 	}
 
       /* disconnect bufptr from the LRU list */
-      if (pgbuf_Pool.buf_LRU_list[lru_idx].LRU_top == bufptr)
+      if (lru_list->LRU_top == bufptr)
 	{
-	  pgbuf_Pool.buf_LRU_list[lru_idx].LRU_top = bufptr->next_BCB;
+	  lru_list->LRU_top = bufptr->next_BCB;
 	}
 
-      if (pgbuf_Pool.buf_LRU_list[lru_idx].LRU_bottom == bufptr)
+      if (lru_list->LRU_bottom == bufptr)
 	{
-	  pgbuf_Pool.buf_LRU_list[lru_idx].LRU_bottom = bufptr->prev_BCB;
+	  lru_list->LRU_bottom = bufptr->prev_BCB;
 	}
 
-      if (pgbuf_Pool.buf_LRU_list[lru_idx].LRU_middle == bufptr)
+      if (lru_list->LRU_middle == bufptr)
 	{
-	  pgbuf_Pool.buf_LRU_list[lru_idx].LRU_middle = bufptr->prev_BCB;
+	  lru_list->LRU_middle = bufptr->prev_BCB;
 	}
 
       if (bufptr->next_BCB != NULL)
@@ -5598,16 +6477,16 @@ pgbuf_get_victim_from_lru_list (const VPID * vpid)
       bufptr->prev_BCB = bufptr->next_BCB = NULL;
       if (bufptr->zone == PGBUF_LRU_1_ZONE)
 	{
-	  pgbuf_Pool.buf_LRU_list[lru_idx].LRU_1_zone_cnt -= 1;
+	  lru_list->LRU_1_zone_cnt -= 1;
 	}
 
       bufptr->zone = PGBUF_VOID_ZONE;
 
 #if defined(SERVER_MODE)
-      if (pgbuf_Pool.buf_LRU_list[lru_idx].LRU_bottom != NULL
-	  && pgbuf_Pool.buf_LRU_list[lru_idx].LRU_bottom->dirty == true)
+      if (lru_list->LRU_bottom != NULL
+	  && lru_list->LRU_bottom->dirty == true)
 	{
-	  thread_wakeup_page_flush_thread ();
+	  thread_wakeup_page_flush_thread (lru_idx);
 	}
 #endif /* SERVER_MODE */
 
@@ -5617,10 +6496,78 @@ pgbuf_get_victim_from_lru_list (const VPID * vpid)
 	}
     }
 
-  MUTEX_UNLOCK (pgbuf_Pool.buf_LRU_list[lru_idx].LRU_mutex);
+  MUTEX_UNLOCK (lru_list->LRU_mutex);
+
+  return (bufptr);
+}
+
+/*
+ * pgbuf_get_victim_from_lru_list () - Get victim BCB from the LRU lists
+ *   return: If success, BCB, otherwise NULL
+ *   thread_p(in):
+ *   vpid(in):
+ *
+ * Note: The LRU list owned by the current thread is searched first. If it
+ *       has no victim or another thread is holding its LRU_mutex, a victim
+ *       is stolen from the other lists whose LRU_mutex is free. Only when
+ *       every list was skipped by busy LRU_mutex, the lists are searched
+ *       again waiting for the mutex. The caller will hold BCB_mutex of the
+ *       returned BCB.
+ */
+static PGBUF_BCB *
+pgbuf_get_victim_from_lru_list (THREAD_ENTRY * thread_p, const VPID * vpid)
+{
+  PGBUF_BCB *bufptr = NULL;
+  int own_lru_idx, lru_idx;
+  int i, search_cnt = 0;
+  bool wait, is_busy;
+#if defined(SERVER_MODE)
+  int rv;
+#endif /* SERVER_MODE */
+
+  own_lru_idx = pgbuf_get_lru_index (thread_p, vpid);
+
+  for (wait = false;; wait = true)
+    {
+      is_busy = false;
+      for (i = 0; i < pgbuf_Pool.num_LRU_list && bufptr == NULL; i++)
+	{
+	  lru_idx = (own_lru_idx + i) % pgbuf_Pool.num_LRU_list;
+	  bufptr = pgbuf_get_victim_from_lru_shard (lru_idx, wait,
+						    &search_cnt, &is_busy);
+	}
+
+      if (bufptr != NULL || is_busy == false || wait == true)
+	{
+	  break;
+	}
+    }
+
+#if defined(CUBRID_DEBUG)
+  (void) ATOMIC_INC_32 (&pgbuf_Pool.buf_LRU_list[own_lru_idx].
+			num_victim_search, search_cnt);
+#endif /* CUBRID_DEBUG */
+  mnt_pb_lru_victim_search (thread_p, search_cnt);
 
   if (bufptr != NULL)
     {
+      if (lru_idx == own_lru_idx)
+	{
+#if defined(CUBRID_DEBUG)
+	  (void) ATOMIC_INC_32 (&pgbuf_Pool.buf_LRU_list[own_lru_idx].
+				num_victims, 1);
+#endif /* CUBRID_DEBUG */
+	  mnt_pb_lru_victims (thread_p);
+	}
+      else
+	{
+#if defined(CUBRID_DEBUG)
+	  (void) ATOMIC_INC_32 (&pgbuf_Pool.buf_LRU_list[lru_idx].num_steals,
+				1);
+#endif /* CUBRID_DEBUG */
+	  mnt_pb_lru_steals (thread_p);
+	}
+
       MUTEX_LOCK_VIA_BUSY_WAIT (rv, bufptr->BCB_mutex);
     }
 
@@ -5642,7 +6589,7 @@ pgbuf_invalidate_bcb_from_lru (PGBUF_BCB * bufptr)
   int rv;
 #endif /* SERVER_MODE */
 
-  lru_idx = pgbuf_get_lru_index (&bufptr->vpid);
+  lru_idx = bufptr->lru_idx;
 
   /* the caller is holding bufptr->BCB_mutex */
   /* delete the bufptr from the LRU list */
@@ -5689,13 +6636,16 @@ pgbuf_invalidate_bcb_from_lru (PGBUF_BCB * bufptr)
 /*
  * pgbuf_relocate_top_lru () - Relocate given BCB into the top of LRU list
  *   return: NO_ERROR
+ *   thread_p(in):
  *   bufptr(in): pointer to buffer page
  *
  * Note: This function puts BCB to the top of the LRU list.
  *       While this processing, the caller must be the holder of the LRU list.
+ *       A BCB in LRU_2_Zone stays in its list. A BCB not in any list joins
+ *       the list owned by the current thread.
  */
 static int
-pgbuf_relocate_top_lru (PGBUF_BCB * bufptr)
+pgbuf_relocate_top_lru (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr)
 {
   int lru_idx;
 #if defined(SERVER_MODE)
@@ -5704,7 +6654,15 @@ pgbuf_relocate_top_lru (PGBUF_BCB * bufptr)
 
   assert (bufptr->zone != PGBUF_LRU_1_ZONE);
 
-  lru_idx = pgbuf_get_lru_index (&bufptr->vpid);
+  if (bufptr->zone == PGBUF_LRU_2_ZONE)
+    {
+      lru_idx = bufptr->lru_idx;
+    }
+  else
+    {
+      lru_idx = pgbuf_get_lru_index (thread_p, &bufptr->vpid);
+      bufptr->lru_idx = lru_idx;
+    }
 
   /* the caller is holding bufptr->BCB_mutex */
   MUTEX_LOCK_VIA_BUSY_WAIT (rv, pgbuf_Pool.buf_LRU_list[lru_idx].LRU_mutex);
@@ -5776,6 +6734,69 @@ pgbuf_relocate_top_lru (PGBUF_BCB * bufptr)
   return NO_ERROR;
 }
 
+/*
+ * pgbuf_relocate_bottom_lru () - Relocate given BCB into the bottom of LRU
+ *				  list
+ *   return: NO_ERROR
+ *   thread_p(in):
+ *   bufptr(in): pointer to buffer page
+ *
+ * Note: This function puts a BCB used only by bulk readers to the bottom
+ *       of the LRU list owned by the current thread, so that it becomes the
+ *       next victim. A BCB already in LRU_2_Zone is left in place.
+ */
+static int
+pgbuf_relocate_bottom_lru (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr)
+{
+  PGBUF_LRU_LIST *lru_list;
+  int lru_idx;
+#if defined(SERVER_MODE)
+  int rv;
+#endif /* SERVER_MODE */
+
+  assert (bufptr->zone != PGBUF_LRU_1_ZONE);
+
+  if (bufptr->zone == PGBUF_LRU_2_ZONE)
+    {
+      lru_idx = bufptr->lru_idx;
+    }
+  else
+    {
+      lru_idx = pgbuf_get_lru_index (thread_p, &bufptr->vpid);
+    }
+  lru_list = &pgbuf_Pool.buf_LRU_list[lru_idx];
+
+  /* the caller is holding bufptr->BCB_mutex */
+  MUTEX_LOCK_VIA_BUSY_WAIT (rv, lru_list->LRU_mutex);
+
+  if (bufptr->zone == PGBUF_LRU_2_ZONE)
+    {
+      /* do not promote it */
+      MUTEX_UNLOCK (lru_list->LRU_mutex);
+      return NO_ERROR;
+    }
+
+  /* put BCB into the bottom of the LRU list */
+  bufptr->next_BCB = NULL;
+  bufptr->prev_BCB = lru_list->LRU_bottom;
+  if (lru_list->LRU_bottom == NULL)
+    {
+      lru_list->LRU_top = bufptr;
+    }
+  else
+    {
+      (lru_list->LRU_bottom)->next_BCB = bufptr;
+    }
+  lru_list->LRU_bottom = bufptr;
+
+  bufptr->lru_idx = lru_idx;
+  bufptr->zone = PGBUF_LRU_2_ZONE;
+
+  MUTEX_UNLOCK (lru_list->LRU_mutex);
+
+  return NO_ERROR;
+}
+
 /*
  * pgbuf_flush_page_with_wal () - Writes the buffer image into the disk
  *   return: NO_ERROR, or ER_code
@@ -5788,11 +6809,6 @@ pgbuf_relocate_top_lru (PGBUF_BCB * bufptr)
 static int
 pgbuf_flush_page_with_wal (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr)
 {
-#if defined(SERVER_MODE)
-  THREAD_ENTRY *thrd_entry;
-  int rv;
-#endif /* SERVER_MODE */
-
   /* the caller is holding bufptr->BCB_mutex */
 
   /* bufptr->latch_mode == PGBUF_LATCH_FLUSH/PGBUF_LATCH_VICTIM */
@@ -5815,6 +6831,27 @@ pgbuf_flush_page_with_wal (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr)
       return ER_FAILED;
     }
 
+  pgbuf_set_bcb_flushed (bufptr);
+
+  return NO_ERROR;
+}
+
+/*
+ * pgbuf_set_bcb_flushed () - Mark the buffer as written to the disk
+ *   return: void
+ *   bufptr(in): pointer to buffer page
+ *
+ * Note: The caller has written the page holding the flush or victim latch.
+ *       The function holds bufptr->BCB_mutex and does not release it.
+ */
+static void
+pgbuf_set_bcb_flushed (PGBUF_BCB * bufptr)
+{
+#if defined(SERVER_MODE)
+  THREAD_ENTRY *thrd_entry;
+  int rv;
+#endif /* SERVER_MODE */
+
   /* bufptr->latch_mode == PGBUF_LATCH_FLUSH, PGBUF_LATCH_VICTIM,
    *                       PGBUF_LATCH_FLUSH_INVALID,
    *                       PGBUF_LATCH_VICTIM_INVALID
@@ -5834,8 +6871,6 @@ pgbuf_flush_page_with_wal (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr)
       pgbuf_wakeup_uncond (thrd_entry);
     }
 #endif /* SERVER_MODE */
-
-  return NO_ERROR;
 }
 
 /*
@@ -6120,6 +7155,7 @@ static void
 pgbuf_dump (void)
 {
   PGBUF_BCB *bufptr;
+  PGBUF_LRU_LIST *lru_list;
   int bufid, i;
   int consistent;
   int nfetched = 0;
@@ -6222,6 +7258,21 @@ pgbuf_dump (void)
 
   (void) fprintf (stdout, "Number of fetched buffers = %d\n"
 		  "Number of dirty buffers = %d\n", nfetched, ndirty);
+
+  /* dump statistics of each LRU list */
+  (void) fprintf (stdout, " LRU  Fetches     Hits Hit_ratio  Victims   Steals"
+		  "   Search\n");
+  for (i = 0; i < pgbuf_Pool.num_LRU_list; i++)
+    {
+      lru_list = &pgbuf_Pool.buf_LRU_list[i];
+      (void) fprintf (stdout, "%4d %8u %8u %9.2f %8u %8u %8u\n", i,
+		      lru_list->num_fetches, lru_list->num_hits,
+		      (lru_list->num_fetches > 0
+		       ? (100.0 * lru_list->num_hits / lru_list->num_fetches)
+		       : 0.0),
+		      lru_list->num_victims, lru_list->num_steals,
+		      lru_list->num_victim_search);
+    }
 }
 
 /*
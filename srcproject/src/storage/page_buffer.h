@@ -162,18 +162,24 @@ extern int pgbuf_flush_all_unfixed_and_set_lsa_as_null_debug (THREAD_ENTRY *
 							      int
 							      caller_line);
 
-#define pgbuf_flush_victim_candidate(thread_p, flush_ratio) \
-	pgbuf_flush_victim_candidate_debug(thread_p, flush_ratio, __FILE__, __LINE__)
+#define pgbuf_flush_victim_candidate(thread_p, flush_ratio, flusher_idx, \
+				     num_flushers) \
+	pgbuf_flush_victim_candidate_debug(thread_p, flush_ratio, flusher_idx, \
+					   num_flushers, __FILE__, __LINE__)
 extern int pgbuf_flush_victim_candidate_debug (THREAD_ENTRY * thread_p,
 					       float flush_ratio,
+					       int flusher_idx,
+					       int num_flushers,
 					       const char *caller_file,
 					       int caller_line);
 
-#define pgbuf_flush_check_point(thread_p, last_chkpt_lsa, smallest_lsa) \
-	pgbuf_flush_check_point_debug(thread_p, last_chkpt_lsa, smallest_lsa, \
-				      __FILE__, __LINE__)
+#define pgbuf_flush_check_point(thread_p, last_chkpt_lsa, spread_msec, \
+				smallest_lsa) \
+	pgbuf_flush_check_point_debug(thread_p, last_chkpt_lsa, spread_msec, \
+				      smallest_lsa, __FILE__, __LINE__)
 extern void pgbuf_flush_check_point_debug (THREAD_ENTRY * thread_p,
 					   const LOG_LSA * last_chkpt_lsa,
+					   int spread_msec,
 					   LOG_LSA * smallest_lsa,
 					   const char *caller_file,
 					   int caller_line);
@@ -184,10 +190,11 @@ extern int pgbuf_flush_all_unfixed_and_set_lsa_as_null (THREAD_ENTRY *
 							thread_p,
 							VOLID volid);
 extern int pgbuf_flush_victim_candidate (THREAD_ENTRY * thread_p,
-					 float flush_ratio);
+					 float flush_ratio, int flusher_idx,
+					 int num_flushers);
 extern void pgbuf_flush_check_point (THREAD_ENTRY * thread_p,
 				     const LOG_LSA * last_chkpt_lsa,
-				     LOG_LSA * smallest_lsa);
+				     int spread_msec, LOG_LSA * smallest_lsa);
 #endif /* NDEBUG */
 extern void *pgbuf_copy_to_area (THREAD_ENTRY * thread_p, const VPID * vpid,
 				 int start_offset, int length, void *area,
@@ -219,6 +226,12 @@ extern bool pgbuf_is_lsa_temporary (PAGE_PTR pgptr);
 extern void pgbuf_invalidate_temporary_file (VOLID volid, PAGEID first_pageid,
 					     DKNPAGES npages,
 					     bool need_invalidate);
+extern bool pgbuf_is_bulk_read_size (int npages);
+extern void pgbuf_start_bulk_read (THREAD_ENTRY * thread_p);
+extern void pgbuf_end_bulk_read (THREAD_ENTRY * thread_p);
+extern void pgbuf_request_prefetch (THREAD_ENTRY * thread_p,
+				    const VPID * vpid, int npages);
+extern void pgbuf_prefetch_pages (THREAD_ENTRY * thread_p);
 #if defined(CUBRID_DEBUG)
 extern void pgbuf_dump_if_any_fixed (void);
 #endif
@@ -67,6 +67,12 @@ do { \
 /* define critical section array */
 CSS_CRITICAL_SECTION css_Csect_array[CRITICAL_SECTION_COUNT];
 
+/* latency histogram id of a critical section, -1 if not in the array */
+#define CSECT_LAT_ID(cs_ptr) \
+  (((cs_ptr) >= css_Csect_array \
+    && (cs_ptr) < css_Csect_array + CRITICAL_SECTION_COUNT) \
+   ? (int) ((cs_ptr) - css_Csect_array) : -1)
+
 static const char *css_Csect_name[CRITICAL_SECTION_COUNT] = {
   "ER_LOG_FILE",
   "ER_MSG_CACHE",
@@ -212,6 +218,7 @@ csect_initialize_entry (int cs_index)
   cs_ptr = &css_Csect_array[cs_index];
   cs_ptr->cs_index = cs_index;
   cs_ptr->name = css_Csect_name[cs_index];
+  mnt_lat_set_name (MNT_LAT_CSECT_WAIT, cs_index, cs_ptr->name);
   return csect_initialize_critical_section (cs_ptr);
 }
 
@@ -547,6 +554,8 @@ csect_enter_critical_section (THREAD_ENTRY * thread_p,
 {
   int error_code = NO_ERROR, r;
   struct timeval start_time, end_time, elapsed_time;
+  struct timeval wait_start_time;
+  bool is_waited = false;
 
   assert (cs_ptr != NULL);
 
@@ -582,6 +591,11 @@ csect_enter_critical_section (THREAD_ENTRY * thread_p,
 	}
       else
 	{
+	  if (!is_waited)
+	    {
+	      gettimeofday (&wait_start_time, NULL);
+	      is_waited = true;
+	    }
 	  if (wait_secs == INF_WAIT)
 	    {
 	      cs_ptr->waiting_writers++;
@@ -713,6 +727,12 @@ csect_enter_critical_section (THREAD_ENTRY * thread_p,
       return ER_CSS_PTHREAD_MUTEX_UNLOCK;
     }
 
+  if (is_waited)
+    {
+      mnt_lat_record (thread_p, MNT_LAT_CSECT_WAIT, CSECT_LAT_ID (cs_ptr),
+		      &wait_start_time);
+    }
+
   if (MONITOR_WAITING_THREAD (elapsed_time))
     {
       if (cs_ptr->cs_index > 0)
@@ -768,6 +788,8 @@ csect_enter_critical_section_as_reader (THREAD_ENTRY * thread_p,
 {
   int error_code = NO_ERROR, r;
   struct timeval start_time, end_time, elapsed_time;
+  struct timeval wait_start_time;
+  bool is_waited = false;
 
   assert (cs_ptr != NULL);
 
@@ -805,6 +827,11 @@ csect_enter_critical_section_as_reader (THREAD_ENTRY * thread_p,
 		 && cs_ptr->owner == NULL_THREAD_T))
 	{
 	  /* reader should wait writer(s). */
+	  if (!is_waited)
+	    {
+	      gettimeofday (&wait_start_time, NULL);
+	      is_waited = true;
+	    }
 	  if (wait_secs == INF_WAIT)
 	    {
 	      cs_ptr->total_nwaits++;
@@ -939,6 +966,12 @@ csect_enter_critical_section_as_reader (THREAD_ENTRY * thread_p,
       return ER_CSS_PTHREAD_MUTEX_UNLOCK;
     }
 
+  if (is_waited)
+    {
+      mnt_lat_record (thread_p, MNT_LAT_CSECT_WAIT, CSECT_LAT_ID (cs_ptr),
+		      &wait_start_time);
+    }
+
   if (MONITOR_WAITING_THREAD (elapsed_time))
     {
       if (cs_ptr->cs_index > 0)
@@ -993,6 +1026,8 @@ csect_demote_critical_section (THREAD_ENTRY * thread_p,
 {
   int error_code = NO_ERROR, r;
   struct timeval start_time, end_time, elapsed_time;
+  struct timeval wait_start_time;
+  bool is_waited = false;
 
   assert (cs_ptr != NULL);
 
@@ -1052,6 +1087,11 @@ csect_demote_critical_section (THREAD_ENTRY * thread_p,
       while (cs_ptr->rwlock < 0 || cs_ptr->waiting_writers > 0)
 	{
 	  /* reader should wait writer(s). */
+	  if (!is_waited)
+	    {
+	      gettimeofday (&wait_start_time, NULL);
+	      is_waited = true;
+	    }
 	  if (wait_secs == INF_WAIT)
 	    {
 	      cs_ptr->total_nwaits++;
@@ -1204,6 +1244,12 @@ csect_demote_critical_section (THREAD_ENTRY * thread_p,
       return ER_CSS_PTHREAD_MUTEX_UNLOCK;
     }
 
+  if (is_waited)
+    {
+      mnt_lat_record (thread_p, MNT_LAT_CSECT_WAIT, CSECT_LAT_ID (cs_ptr),
+		      &wait_start_time);
+    }
+
   if (MONITOR_WAITING_THREAD (elapsed_time))
     {
       if (cs_ptr->cs_index > 0)
@@ -1258,6 +1304,8 @@ csect_promote_critical_section (THREAD_ENTRY * thread_p,
 {
   int error_code = NO_ERROR, r;
   struct timeval start_time, end_time, elapsed_time;
+  struct timeval wait_start_time;
+  bool is_waited = false;
 
   assert (cs_ptr != NULL);
 
@@ -1309,6 +1357,11 @@ csect_promote_critical_section (THREAD_ENTRY * thread_p,
 	}
       else
 	{
+	  if (!is_waited)
+	    {
+	      gettimeofday (&wait_start_time, NULL);
+	      is_waited = true;
+	    }
 	  if (wait_secs == INF_WAIT)
 	    {
 	      cs_ptr->waiting_writers++;
@@ -1410,6 +1463,12 @@ csect_promote_critical_section (THREAD_ENTRY * thread_p,
       return ER_CSS_PTHREAD_MUTEX_UNLOCK;
     }
 
+  if (is_waited)
+    {
+      mnt_lat_record (thread_p, MNT_LAT_CSECT_WAIT, CSECT_LAT_ID (cs_ptr),
+		      &wait_start_time);
+    }
+
   if (MONITOR_WAITING_THREAD (elapsed_time))
     {
       if (cs_ptr->cs_index > 0)
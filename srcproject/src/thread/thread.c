@@ -89,8 +89,44 @@ struct thread_manager
   bool initialized;
 };
 
-/* deadlock + checkpoint + oob + page flush + log flush + flush control */
-static const int PREDEFINED_DAEMON_THREAD_NUM = 6;
+/* deadlock + checkpoint + oob + page flush + log flush + flush control
+   + page prefetch */
+static const int PREDEFINED_DAEMON_THREAD_NUM = 7;
+
+/* max # of page flush daemon threads; PRM_PB_NUM_FLUSH_THREADS - 1 of them
+   are started in addition to the predefined daemon threads */
+#define THREAD_MAX_PAGE_FLUSH_THREADS 16
+
+/* max # of parallel worker daemon threads; PRM_MAX_PARALLEL_WORKERS of them
+   are started in addition to the predefined daemon threads */
+#define THREAD_MAX_PARALLEL_WORKERS 16
+
+/* max # of connection I/O daemon threads; PRM_CSS_NUM_IO_THREADS of them
+   are started in addition to the predefined daemon threads (Linux only) */
+#define THREAD_MAX_CONN_IO_THREADS 16
+
+/* a set of tasks handed to the parallel workers by thread_run_parallel () */
+typedef struct thread_parallel_job THREAD_PARALLEL_JOB;
+struct thread_parallel_job
+{
+  MUTEX_T lock;
+  COND_T cond;
+  int num_running;		/* tasks not yet finished by the workers */
+};
+
+typedef struct thread_parallel_worker THREAD_PARALLEL_WORKER;
+struct thread_parallel_worker
+{
+  int thread_index;
+  bool is_busy;			/* reserved by a requester; protected by
+				   thread_Parallel_workers_lock */
+  MUTEX_T lock;			/* protects the task below */
+  COND_T cond;
+  THREAD_PARALLEL_FUNC *func;	/* task to run, NULL if none */
+  void *arg;
+  int tran_index;		/* transaction of the requester */
+  THREAD_PARALLEL_JOB *job;
+};
 
 static const int THREAD_RETRY_MAX_SLAM_TIMES = 10;
 
@@ -112,13 +148,24 @@ static DAEMON_THREAD_MONITOR thread_Checkpoint_thread =
   { 0, false, false, false, MUTEX_INITIALIZER, COND_INITIALIZER };
 static DAEMON_THREAD_MONITOR thread_Oob_thread =
   { 0, true, true, false, MUTEX_INITIALIZER, COND_INITIALIZER };
-static DAEMON_THREAD_MONITOR thread_Page_flush_thread =
-  { 0, false, false, false, MUTEX_INITIALIZER, COND_INITIALIZER };
+static DAEMON_THREAD_MONITOR
+  thread_Page_flush_thread[THREAD_MAX_PAGE_FLUSH_THREADS];
+static int thread_Num_page_flush_threads = 1;
 static DAEMON_THREAD_MONITOR thread_Flush_control_thread =
   { 0, false, false, false, MUTEX_INITIALIZER, COND_INITIALIZER };
+static DAEMON_THREAD_MONITOR thread_Page_prefetch_thread =
+  { 0, false, false, false, MUTEX_INITIALIZER, COND_INITIALIZER };
 DAEMON_THREAD_MONITOR thread_Log_flush_thread =
   { 0, false, false, false, MUTEX_INITIALIZER, COND_INITIALIZER };
 
+static THREAD_PARALLEL_WORKER
+  thread_Parallel_workers[THREAD_MAX_PARALLEL_WORKERS];
+static int thread_Num_parallel_workers = 0;
+static MUTEX_T thread_Parallel_workers_lock = MUTEX_INITIALIZER;
+
+static DAEMON_THREAD_MONITOR thread_Conn_io_thread[THREAD_MAX_CONN_IO_THREADS];
+static int thread_Num_conn_io_threads = 0;
+
 #if defined(WINDOWS)
 /*
  * Because WINDOWS threads don't have static mutex initializer,
@@ -140,6 +187,9 @@ static unsigned __stdcall thread_checkpoint_thread (void *);
 static unsigned __stdcall thread_page_flush_thread (void *);
 static unsigned __stdcall thread_flush_control_thread (void *);
 static unsigned __stdcall thread_log_flush_thread (void *);
+static unsigned __stdcall thread_page_prefetch_thread (void *);
+static unsigned __stdcall thread_parallel_worker_thread (void *);
+static unsigned __stdcall thread_conn_io_thread (void *);
 static int css_initialize_sync_object (void);
 #else /* WINDOWS */
 static void *thread_deadlock_detect_thread (void *);
@@ -147,7 +197,11 @@ static void *thread_checkpoint_thread (void *);
 static void *thread_page_flush_thread (void *);
 static void *thread_flush_control_thread (void *);
 static void *thread_log_flush_thread (void *);
+static void *thread_page_prefetch_thread (void *);
+static void *thread_parallel_worker_thread (void *);
+static void *thread_conn_io_thread (void *);
 #endif /* WINDOWS */
+static void thread_wakeup_parallel_workers (void);
 
 static int thread_wakeup_internal (THREAD_ENTRY * thread_p, int resume_reason,
 				   bool had_mutex);
@@ -290,6 +344,44 @@ thread_initialize_manager (void)
       css_initialize_sync_object ();
 #endif /* WINDOWS */
 
+      for (i = 0; i < THREAD_MAX_PAGE_FLUSH_THREADS; i++)
+	{
+	  r = COND_INIT (thread_Page_flush_thread[i].cond);
+	  if (r != 0)
+	    {
+	      er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+				   ER_CSS_PTHREAD_COND_INIT, 0);
+	      return ER_CSS_PTHREAD_COND_INIT;
+	    }
+	  r = MUTEX_INIT (thread_Page_flush_thread[i].lock);
+	  if (r != 0)
+	    {
+	      er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+				   ER_CSS_PTHREAD_MUTEX_INIT, 0);
+	      return ER_CSS_PTHREAD_MUTEX_INIT;
+	    }
+	}
+
+      for (i = 0; i < THREAD_MAX_PARALLEL_WORKERS; i++)
+	{
+	  r = COND_INIT (thread_Parallel_workers[i].cond);
+	  if (r != 0)
+	    {
+	      er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+				   ER_CSS_PTHREAD_COND_INIT, 0);
+	      return ER_CSS_PTHREAD_COND_INIT;
+	    }
+	  r = MUTEX_INIT (thread_Parallel_workers[i].lock);
+	  if (r != 0)
+	    {
+	      er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+				   ER_CSS_PTHREAD_MUTEX_INIT, 0);
+	      return ER_CSS_PTHREAD_MUTEX_INIT;
+	    }
+	  thread_Parallel_workers[i].is_busy = false;
+	  thread_Parallel_workers[i].func = NULL;
+	}
+
 #ifdef CHECK_MUTEX
       r = MUTEXATTR_SETTYPE (mattr, PTHREAD_MUTEX_ERRORCHECK);
       if (r != 0)
@@ -321,7 +413,19 @@ thread_initialize_manager (void)
 
   /* calculate the number of thread from the number of clients */
   thread_Manager.num_workers = PRM_CSS_MAX_CLIENTS * 2;
-  thread_Manager.num_daemons = PREDEFINED_DAEMON_THREAD_NUM;
+  thread_Num_page_flush_threads =
+    MAX (1, MIN (PRM_PB_NUM_FLUSH_THREADS, THREAD_MAX_PAGE_FLUSH_THREADS));
+  thread_Num_parallel_workers =
+    MAX (0, MIN (PRM_MAX_PARALLEL_WORKERS, THREAD_MAX_PARALLEL_WORKERS));
+#if defined(LINUX)
+  thread_Num_conn_io_threads =
+    MAX (0, MIN (PRM_CSS_NUM_IO_THREADS, THREAD_MAX_CONN_IO_THREADS));
+#else /* LINUX */
+  thread_Num_conn_io_threads = 0;
+#endif /* LINUX */
+  thread_Manager.num_daemons =
+    PREDEFINED_DAEMON_THREAD_NUM + thread_Num_page_flush_threads - 1
+    + thread_Num_parallel_workers + thread_Num_conn_io_threads;
   thread_Manager.num_total =
     thread_Manager.num_workers + thread_Manager.num_daemons
     + 1 /* master thread */ ;
@@ -377,7 +481,7 @@ thread_initialize_manager (void)
 int
 thread_start_workers (void)
 {
-  int thread_index, r;
+  int thread_index, i, r;
   THREAD_ENTRY *thread_p;
 #if !defined(WINDOWS)
   THREAD_ATTR_T thread_attr;
@@ -562,10 +666,44 @@ thread_start_workers (void)
       return ER_CSS_PTHREAD_MUTEX_UNLOCK;
     }
 
-  /* start page flush daemon thread */
-  thread_Page_flush_thread.thread_index = thread_index++;
+  /* start page flush daemon threads */
+  for (i = 0; i < thread_Num_page_flush_threads; i++)
+    {
+      thread_Page_flush_thread[i].thread_index = thread_index++;
+      thread_p =
+	&thread_Manager.thread_array[thread_Page_flush_thread[i].thread_index];
+      MUTEX_LOCK (r, thread_p->th_entry_lock);
+      if (r != 0)
+	{
+	  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			       ER_CSS_PTHREAD_MUTEX_LOCK, 0);
+	  return ER_CSS_PTHREAD_MUTEX_LOCK;
+	}
+
+      r = THREAD_CREATE (thread_p->thread_handle, &thread_attr,
+			 thread_page_flush_thread, thread_p,
+			 &(thread_p->tid));
+      if (r != 0)
+	{
+	  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			       ER_CSS_PTHREAD_CREATE, 0);
+	  MUTEX_UNLOCK (thread_p->th_entry_lock);
+	  return ER_CSS_PTHREAD_CREATE;
+	}
+
+      r = MUTEX_UNLOCK (thread_p->th_entry_lock);
+      if (r != 0)
+	{
+	  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			       ER_CSS_PTHREAD_MUTEX_UNLOCK, 0);
+	  return ER_CSS_PTHREAD_MUTEX_UNLOCK;
+	}
+    }
+
+  /* start flush control daemon thread */
+  thread_Flush_control_thread.thread_index = thread_index++;
   thread_p =
-    &thread_Manager.thread_array[thread_Page_flush_thread.thread_index];
+    &thread_Manager.thread_array[thread_Flush_control_thread.thread_index];
   MUTEX_LOCK (r, thread_p->th_entry_lock);
   if (r != 0)
     {
@@ -575,7 +713,7 @@ thread_start_workers (void)
     }
 
   r = THREAD_CREATE (thread_p->thread_handle, &thread_attr,
-		     thread_page_flush_thread, thread_p, &(thread_p->tid));
+		     thread_flush_control_thread, thread_p, &(thread_p->tid));
   if (r != 0)
     {
       er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
@@ -592,10 +730,10 @@ thread_start_workers (void)
       return ER_CSS_PTHREAD_MUTEX_UNLOCK;
     }
 
-  /* start flush control daemon thread */
-  thread_Flush_control_thread.thread_index = thread_index++;
+  /* start log flush thread */
+  thread_Log_flush_thread.thread_index = thread_index++;
   thread_p =
-    &thread_Manager.thread_array[thread_Flush_control_thread.thread_index];
+    &thread_Manager.thread_array[thread_Log_flush_thread.thread_index];
   MUTEX_LOCK (r, thread_p->th_entry_lock);
   if (r != 0)
     {
@@ -605,7 +743,7 @@ thread_start_workers (void)
     }
 
   r = THREAD_CREATE (thread_p->thread_handle, &thread_attr,
-		     thread_flush_control_thread, thread_p, &(thread_p->tid));
+		     thread_log_flush_thread, thread_p, &(thread_p->tid));
   if (r != 0)
     {
       er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
@@ -622,10 +760,10 @@ thread_start_workers (void)
       return ER_CSS_PTHREAD_MUTEX_UNLOCK;
     }
 
-  /* start log flush thread */
-  thread_Log_flush_thread.thread_index = thread_index++;
+  /* start page prefetch daemon thread */
+  thread_Page_prefetch_thread.thread_index = thread_index++;
   thread_p =
-    &thread_Manager.thread_array[thread_Log_flush_thread.thread_index];
+    &thread_Manager.thread_array[thread_Page_prefetch_thread.thread_index];
   MUTEX_LOCK (r, thread_p->th_entry_lock);
   if (r != 0)
     {
@@ -635,7 +773,8 @@ thread_start_workers (void)
     }
 
   r = THREAD_CREATE (thread_p->thread_handle, &thread_attr,
-		     thread_log_flush_thread, thread_p, &(thread_p->tid));
+		     thread_page_prefetch_thread, thread_p,
+		     &(thread_p->tid));
   if (r != 0)
     {
       er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
@@ -652,6 +791,73 @@ thread_start_workers (void)
       return ER_CSS_PTHREAD_MUTEX_UNLOCK;
     }
 
+  /* start parallel worker daemon threads */
+  for (i = 0; i < thread_Num_parallel_workers; i++)
+    {
+      thread_Parallel_workers[i].thread_index = thread_index++;
+      thread_p =
+	&thread_Manager.thread_array[thread_Parallel_workers[i].thread_index];
+      MUTEX_LOCK (r, thread_p->th_entry_lock);
+      if (r != 0)
+	{
+	  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			       ER_CSS_PTHREAD_MUTEX_LOCK, 0);
+	  return ER_CSS_PTHREAD_MUTEX_LOCK;
+	}
+
+      r = THREAD_CREATE (thread_p->thread_handle, &thread_attr,
+			 thread_parallel_worker_thread, thread_p,
+			 &(thread_p->tid));
+      if (r != 0)
+	{
+	  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			       ER_CSS_PTHREAD_CREATE, 0);
+	  MUTEX_UNLOCK (thread_p->th_entry_lock);
+	  return ER_CSS_PTHREAD_CREATE;
+	}
+
+      r = MUTEX_UNLOCK (thread_p->th_entry_lock);
+      if (r != 0)
+	{
+	  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			       ER_CSS_PTHREAD_MUTEX_UNLOCK, 0);
+	  return ER_CSS_PTHREAD_MUTEX_UNLOCK;
+	}
+    }
+
+  /* start connection I/O daemon threads */
+  for (i = 0; i < thread_Num_conn_io_threads; i++)
+    {
+      thread_Conn_io_thread[i].thread_index = thread_index++;
+      thread_p =
+	&thread_Manager.thread_array[thread_Conn_io_thread[i].thread_index];
+      MUTEX_LOCK (r, thread_p->th_entry_lock);
+      if (r != 0)
+	{
+	  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			       ER_CSS_PTHREAD_MUTEX_LOCK, 0);
+	  return ER_CSS_PTHREAD_MUTEX_LOCK;
+	}
+
+      r = THREAD_CREATE (thread_p->thread_handle, &thread_attr,
+			 thread_conn_io_thread, thread_p, &(thread_p->tid));
+      if (r != 0)
+	{
+	  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			       ER_CSS_PTHREAD_CREATE, 0);
+	  MUTEX_UNLOCK (thread_p->th_entry_lock);
+	  return ER_CSS_PTHREAD_CREATE;
+	}
+
+      r = MUTEX_UNLOCK (thread_p->th_entry_lock);
+      if (r != 0)
+	{
+	  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			       ER_CSS_PTHREAD_MUTEX_UNLOCK, 0);
+	  return ER_CSS_PTHREAD_MUTEX_UNLOCK;
+	}
+    }
+
   /* destroy thread_attribute */
   r = THREAD_ATTR_DESTROY (thread_attr);
   if (r != 0)
@@ -765,7 +971,7 @@ thread_stop_active_daemons (void)
   assert (thread_Manager.initialized == true);
 
   count = 0;
-  for (i = 0; i < PREDEFINED_DAEMON_THREAD_NUM; i++)
+  for (i = 0; i < thread_Manager.num_daemons; i++)
     {
       idx = thread_Manager.num_workers + i + 1;	/* 1 for master thread */
       thread_p = &thread_Manager.thread_array[idx];
@@ -775,13 +981,15 @@ thread_stop_active_daemons (void)
   thread_wakeup_deadlock_detect_thread ();
   thread_wakeup_checkpoint_thread ();
   thread_wakeup_oob_handler_thread ();
-  thread_wakeup_page_flush_thread ();
+  thread_wakeup_page_flush_thread (-1);
   thread_wakeup_flush_control_thread ();
   thread_wakeup_log_flush_thread ();
+  thread_wakeup_page_prefetch_thread ();
+  thread_wakeup_parallel_workers ();
 
 loop:
   repeat_loop = false;
-  for (i = 0; i < PREDEFINED_DAEMON_THREAD_NUM; i++)
+  for (i = 0; i < thread_Manager.num_daemons; i++)
     {
       idx = thread_Manager.num_workers + i + 1;	/* 1 for master thread */
       thread_p = &thread_Manager.thread_array[idx];
@@ -943,6 +1151,10 @@ thread_initialize_entry (THREAD_ENTRY * entry_p)
 
   entry_p->lockwait = NULL;
   entry_p->lockwait_state = -1;
+  entry_p->lk_free_entry_list = NULL;
+  entry_p->lk_num_free_entries = 0;
+  entry_p->lk_free_res_list = NULL;
+  entry_p->lk_num_free_res = 0;
   entry_p->query_entry = NULL;
   entry_p->tran_next_wait = NULL;
 
@@ -961,6 +1173,11 @@ thread_initialize_entry (THREAD_ENTRY * entry_p)
   entry_p->log_data_length = 0;
   entry_p->log_data_ptr = NULL;
 
+  entry_p->pgbuf_bulk_read_cnt = 0;
+  VPID_SET_NULL (&entry_p->pgbuf_seq_last_vpid);
+  entry_p->pgbuf_seq_fix_cnt = 0;
+  entry_p->pgbuf_seq_prefetch_pageid = NULL_PAGEID;
+
   entry_p->xasl_pack_info_ptr = NULL;
 
   return NO_ERROR;
@@ -2171,14 +2388,14 @@ css_initialize_sync_object (void)
       return ER_CSS_PTHREAD_MUTEX_INIT;
     }
 
-  r = COND_INIT (thread_Page_flush_thread.cond);
+  r = COND_INIT (thread_Flush_control_thread.cond);
   if (r != 0)
     {
       er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
 			   ER_CSS_PTHREAD_COND_INIT, 0);
       return ER_CSS_PTHREAD_COND_INIT;
     }
-  r = MUTEX_INIT (thread_Page_flush_thread.lock);
+  r = MUTEX_INIT (thread_Flush_control_thread.lock);
   if (r != 0)
     {
       er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
@@ -2186,14 +2403,14 @@ css_initialize_sync_object (void)
       return ER_CSS_PTHREAD_MUTEX_INIT;
     }
 
-  r = COND_INIT (thread_Flush_control_thread.cond);
+  r = COND_INIT (thread_Log_flush_thread.cond);
   if (r != 0)
     {
       er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
 			   ER_CSS_PTHREAD_COND_INIT, 0);
       return ER_CSS_PTHREAD_COND_INIT;
     }
-  r = MUTEX_INIT (thread_Flush_control_thread.lock);
+  r = MUTEX_INIT (thread_Log_flush_thread.lock);
   if (r != 0)
     {
       er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
@@ -2201,14 +2418,14 @@ css_initialize_sync_object (void)
       return ER_CSS_PTHREAD_MUTEX_INIT;
     }
 
-  r = COND_INIT (thread_Log_flush_thread.cond);
+  r = COND_INIT (thread_Page_prefetch_thread.cond);
   if (r != 0)
     {
       er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
 			   ER_CSS_PTHREAD_COND_INIT, 0);
       return ER_CSS_PTHREAD_COND_INIT;
     }
-  r = MUTEX_INIT (thread_Log_flush_thread.lock);
+  r = MUTEX_INIT (thread_Page_prefetch_thread.lock);
   if (r != 0)
     {
       er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE,
@@ -2240,6 +2457,14 @@ thread_deadlock_detect_thread (void *arg_p)
   int thrd_index;
   bool state;
   int lockwait_count;
+#if defined(WINDOWS)
+  int to = 0;
+#else /* WINDOWS */
+  struct timespec to = {
+    0, 0
+  };
+  struct timeval now;
+#endif /* WINDOWS */
 
   tsd_ptr = (THREAD_ENTRY *) arg_p;
   /* wait until THREAD_CREATE() finish */
@@ -2257,20 +2482,26 @@ thread_deadlock_detect_thread (void *arg_p)
     {
       er_clear ();
 
+      /* search the deadlock cycles closed by new lock waiters */
+      lock_detect_new_waiter_deadlock (tsd_ptr);
+
       /* check if the lock-wait thread exists */
       thread_p = thread_find_first_lockwait_entry (&thrd_index);
       if (thread_p == (THREAD_ENTRY *) NULL)
 	{
 	  /* none is lock-waiting */
 	  MUTEX_LOCK (rv, thread_Deadlock_detect_thread.lock);
-	  thread_Deadlock_detect_thread.is_running = false;
-	  COND_WAIT (thread_Deadlock_detect_thread.cond,
-		     thread_Deadlock_detect_thread.lock);
+	  if (lock_has_new_lock_waiters () == false)
+	    {
+	      thread_Deadlock_detect_thread.is_running = false;
+	      COND_WAIT (thread_Deadlock_detect_thread.cond,
+			 thread_Deadlock_detect_thread.lock);
 #if defined(WINDOWS)
-	  MUTEX_LOCK (rv, thread_Deadlock_detect_thread.lock);
+	      MUTEX_LOCK (rv, thread_Deadlock_detect_thread.lock);
 #endif /* WINDOWS */
 
-	  thread_Deadlock_detect_thread.is_running = true;
+	      thread_Deadlock_detect_thread.is_running = true;
+	    }
 
 	  MUTEX_UNLOCK (thread_Deadlock_detect_thread.lock);
 	  continue;
@@ -2297,7 +2528,29 @@ thread_deadlock_detect_thread (void *arg_p)
 	{
 	  (void) lock_detect_local_deadlock (tsd_ptr);
 	}
-      thread_sleep (0, 500000);
+
+      /* wait for a new lock waiter until the next timeout check */
+#if defined(WINDOWS)
+      to = 500;
+#else /* WINDOWS */
+      gettimeofday (&now, NULL);
+      to.tv_sec = now.tv_sec + (now.tv_usec + 500000) / 1000000;
+      to.tv_nsec = ((now.tv_usec + 500000) % 1000000) * 1000;
+#endif /* WINDOWS */
+
+      MUTEX_LOCK (rv, thread_Deadlock_detect_thread.lock);
+      if (lock_has_new_lock_waiters () == false)
+	{
+	  thread_Deadlock_detect_thread.is_running = false;
+	  COND_TIMEDWAIT (thread_Deadlock_detect_thread.cond,
+			  thread_Deadlock_detect_thread.lock, to);
+#if defined(WINDOWS)
+	  MUTEX_LOCK (rv, thread_Deadlock_detect_thread.lock);
+#endif /* WINDOWS */
+
+	  thread_Deadlock_detect_thread.is_running = true;
+	}
+      MUTEX_UNLOCK (thread_Deadlock_detect_thread.lock);
     }
 
   er_clear ();
@@ -2433,6 +2686,9 @@ thread_wakeup_oob_handler_thread (void)
  * thread_page_flush_thread() -
  *   return:
  *   arg_p(in):
+ *
+ * Note: There are thread_Num_page_flush_threads page flush daemons. Each of
+ *       them flushes the victim candidates of its own share of the LRU lists.
  */
 #if defined(WINDOWS)
 static unsigned __stdcall
@@ -2458,6 +2714,8 @@ thread_page_flush_thread (void *arg_p)
   int tmp_usec;
 #endif /* WINDOWS */
   int wakeup_interval;
+  int flusher_idx;
+  DAEMON_THREAD_MONITOR *monitor;
 
   tsd_ptr = (THREAD_ENTRY *) arg_p;
   /* wait until THREAD_CREATE() finishes */
@@ -2468,7 +2726,19 @@ thread_page_flush_thread (void *arg_p)
   tsd_ptr->type = TT_DAEMON;	/* daemon thread */
   tsd_ptr->status = TS_RUN;	/* set thread stat as RUN */
 
-  thread_Page_flush_thread.is_running = true;
+  for (flusher_idx = 0; flusher_idx < thread_Num_page_flush_threads;
+       flusher_idx++)
+    {
+      if (thread_Page_flush_thread[flusher_idx].thread_index
+	  == tsd_ptr->index)
+	{
+	  break;
+	}
+    }
+  assert (flusher_idx < thread_Num_page_flush_threads);
+  monitor = &thread_Page_flush_thread[flusher_idx];
+
+  monitor->is_running = true;
 
   thread_set_current_tran_index (tsd_ptr, LOG_SYSTEM_TRAN_INDEX);
 
@@ -2500,45 +2770,45 @@ thread_page_flush_thread (void *arg_p)
 #endif /* WINDOWS */
 	}
 
-      MUTEX_LOCK (rv, thread_Page_flush_thread.lock);
-      thread_Page_flush_thread.is_running = false;
+      MUTEX_LOCK (rv, monitor->lock);
+      monitor->is_running = false;
 
       if (wakeup_interval > 0)
 	{
 	  do
 	    {
-	      rv = COND_TIMEDWAIT (thread_Page_flush_thread.cond,
-				   thread_Page_flush_thread.lock,
+	      rv = COND_TIMEDWAIT (monitor->cond, monitor->lock,
 				   wakeup_time);
 	    }
 	  while (rv == 0);
 	}
       else
 	{
-	  COND_WAIT (thread_Page_flush_thread.cond,
-		     thread_Page_flush_thread.lock);
+	  COND_WAIT (monitor->cond, monitor->lock);
 	}
 
 #if defined(WINDOWS)
-      MUTEX_LOCK (rv, thread_Page_flush_thread.lock);
+      MUTEX_LOCK (rv, monitor->lock);
 #endif /* WINDOWS */
 
-      thread_Page_flush_thread.is_running = true;
+      monitor->is_running = true;
 
-      MUTEX_UNLOCK (thread_Page_flush_thread.lock);
+      MUTEX_UNLOCK (monitor->lock);
 
       if (tsd_ptr->shutdown)
 	{
 	  break;
 	}
 
-      pgbuf_flush_victim_candidate (tsd_ptr, PGBUF_VICTIM_FLUSH_MIN_RATIO);
+      pgbuf_flush_victim_candidate (tsd_ptr, PGBUF_VICTIM_FLUSH_MIN_RATIO,
+				    flusher_idx,
+				    thread_Num_page_flush_threads);
     }
 
   er_clear ();
   tsd_ptr->status = TS_DEAD;
 
-  thread_Page_flush_thread.is_running = false;
+  monitor->is_running = false;
 
 #if defined(WINDOWS)
   return 0;
@@ -2550,23 +2820,449 @@ thread_page_flush_thread (void *arg_p)
 /*
  * thread_wakeup_page_flush_thread() -
  *   return:
+ *   lru_idx(in): index of the LRU list which needs to be flushed, or -1
+ *
+ * Note: Only the flusher which owns the LRU list is signaled. All of the
+ *       flushers are signaled if lru_idx is -1.
  */
 void
-thread_wakeup_page_flush_thread (void)
+thread_wakeup_page_flush_thread (int lru_idx)
 {
+  DAEMON_THREAD_MONITOR *monitor;
+  int i, rv;
+
+  for (i = 0; i < thread_Num_page_flush_threads; i++)
+    {
+      if (lru_idx >= 0 && i != lru_idx % thread_Num_page_flush_threads)
+	{
+	  continue;
+	}
+
+      monitor = &thread_Page_flush_thread[i];
+      if (monitor->is_running)
+	{
+	  continue;
+	}
+
+      MUTEX_LOCK (rv, monitor->lock);
+      if (!monitor->is_running)
+	{
+	  COND_SIGNAL (monitor->cond);
+	}
+      MUTEX_UNLOCK (monitor->lock);
+    }
+}
+
+/*
+ * thread_page_prefetch_thread() - read-ahead daemon
+ *   return:
+ *   arg_p(in):
+ *
+ * Note: The daemon reads the pages requested by pgbuf_request_prefetch ()
+ *       into the buffer pool, so that the scans find their next pages
+ *       there instead of waiting for the disk. It sleeps until it is woken
+ *       up by a new request. A request which was queued while the daemon
+ *       was still running could miss its wakeup, so the daemon also wakes
+ *       up periodically.
+ */
+#if defined(WINDOWS)
+static unsigned __stdcall
+thread_page_prefetch_thread (void *arg_p)
+#else /* WINDOWS */
+static void *
+thread_page_prefetch_thread (void *arg_p)
+#endif				/* WINDOWS */
+{
+#if !defined(HPUX)
+  THREAD_ENTRY *tsd_ptr;
+#endif /* !HPUX */
   int rv;
+  struct timeval cur_time = {
+    0, 0
+  };
+#if defined(WINDOWS)
+  int wakeup_time = 0;
+#else /* WINDOWS */
+  struct timespec wakeup_time = {
+    0, 0
+  };
+  int tmp_usec;
+#endif /* WINDOWS */
+  const int wakeup_interval = 100;	/* msec */
+
+  tsd_ptr = (THREAD_ENTRY *) arg_p;
+  /* wait until THREAD_CREATE() finishes */
+  MUTEX_LOCK (rv, tsd_ptr->th_entry_lock);
+  MUTEX_UNLOCK (tsd_ptr->th_entry_lock);
 
-  if (thread_Page_flush_thread.is_running)
+  thread_set_thread_entry_info (tsd_ptr);	/* save TSD */
+  tsd_ptr->type = TT_DAEMON;	/* daemon thread */
+  tsd_ptr->status = TS_RUN;	/* set thread stat as RUN */
+
+  thread_Page_prefetch_thread.is_running = true;
+
+  thread_set_current_tran_index (tsd_ptr, LOG_SYSTEM_TRAN_INDEX);
+
+  while (!tsd_ptr->shutdown)
+    {
+      er_clear ();
+
+      gettimeofday (&cur_time, NULL);
+#if defined(WINDOWS)
+      wakeup_time = wakeup_interval;
+#else /* WINDOWS */
+      wakeup_time.tv_sec = cur_time.tv_sec + (wakeup_interval / 1000);
+      tmp_usec = cur_time.tv_usec + (wakeup_interval % 1000) * 1000;
+      if (tmp_usec >= 1000000)
+	{
+	  wakeup_time.tv_sec += 1;
+	  tmp_usec -= 1000000;
+	}
+      wakeup_time.tv_nsec = tmp_usec * 1000;
+#endif /* WINDOWS */
+
+      MUTEX_LOCK (rv, thread_Page_prefetch_thread.lock);
+      thread_Page_prefetch_thread.is_running = false;
+
+      COND_TIMEDWAIT (thread_Page_prefetch_thread.cond,
+		      thread_Page_prefetch_thread.lock, wakeup_time);
+
+#if defined(WINDOWS)
+      MUTEX_LOCK (rv, thread_Page_prefetch_thread.lock);
+#endif /* WINDOWS */
+
+      thread_Page_prefetch_thread.is_running = true;
+
+      MUTEX_UNLOCK (thread_Page_prefetch_thread.lock);
+
+      if (tsd_ptr->shutdown)
+	{
+	  break;
+	}
+
+      pgbuf_prefetch_pages (tsd_ptr);
+    }
+
+  er_clear ();
+  tsd_ptr->status = TS_DEAD;
+
+  thread_Page_prefetch_thread.is_running = false;
+
+#if defined(WINDOWS)
+  return 0;
+#else /* WINDOWS */
+  return NULL;
+#endif /* WINDOWS */
+}
+
+/*
+ * thread_wakeup_page_prefetch_thread() -
+ *   return:
+ */
+void
+thread_wakeup_page_prefetch_thread (void)
+{
+  int rv;
+
+  if (thread_Page_prefetch_thread.is_running)
     {
       return;
     }
 
-  MUTEX_LOCK (rv, thread_Page_flush_thread.lock);
-  if (!thread_Page_flush_thread.is_running)
+  MUTEX_LOCK (rv, thread_Page_prefetch_thread.lock);
+  if (!thread_Page_prefetch_thread.is_running)
     {
-      COND_SIGNAL (thread_Page_flush_thread.cond);
+      COND_SIGNAL (thread_Page_prefetch_thread.cond);
+    }
+  MUTEX_UNLOCK (thread_Page_prefetch_thread.lock);
+}
+
+/*
+ * thread_parallel_worker_thread() - parallel worker daemon
+ *   return:
+ *   arg_p(in):
+ *
+ * Note: The daemon sleeps until thread_run_parallel () hands it a task,
+ *       runs the task on behalf of the requester's transaction and tells
+ *       the requester when it is done.
+ */
+#if defined(WINDOWS)
+static unsigned __stdcall
+thread_parallel_worker_thread (void *arg_p)
+#else /* WINDOWS */
+static void *
+thread_parallel_worker_thread (void *arg_p)
+#endif				/* WINDOWS */
+{
+#if !defined(HPUX)
+  THREAD_ENTRY *tsd_ptr;
+#endif /* !HPUX */
+  THREAD_PARALLEL_WORKER *worker_p = NULL;
+  THREAD_PARALLEL_FUNC *func;
+  THREAD_PARALLEL_JOB *job_p;
+  void *arg;
+  int i, rv;
+
+  tsd_ptr = (THREAD_ENTRY *) arg_p;
+  /* wait until THREAD_CREATE() finishes */
+  MUTEX_LOCK (rv, tsd_ptr->th_entry_lock);
+  MUTEX_UNLOCK (tsd_ptr->th_entry_lock);
+
+  thread_set_thread_entry_info (tsd_ptr);	/* save TSD */
+  tsd_ptr->type = TT_DAEMON;	/* daemon thread */
+  tsd_ptr->status = TS_RUN;	/* set thread stat as RUN */
+
+  for (i = 0; i < thread_Num_parallel_workers; i++)
+    {
+      if (thread_Parallel_workers[i].thread_index == tsd_ptr->index)
+	{
+	  worker_p = &thread_Parallel_workers[i];
+	  break;
+	}
+    }
+  assert (worker_p != NULL);
+
+  thread_set_current_tran_index (tsd_ptr, LOG_SYSTEM_TRAN_INDEX);
+
+  while (worker_p != NULL)
+    {
+      er_clear ();
+
+      MUTEX_LOCK (rv, worker_p->lock);
+      while (worker_p->func == NULL && !tsd_ptr->shutdown)
+	{
+	  COND_WAIT (worker_p->cond, worker_p->lock);
+#if defined(WINDOWS)
+	  MUTEX_LOCK (rv, worker_p->lock);
+#endif /* WINDOWS */
+	}
+      func = worker_p->func;
+      arg = worker_p->arg;
+      job_p = worker_p->job;
+      worker_p->func = NULL;
+      MUTEX_UNLOCK (worker_p->lock);
+
+      if (func == NULL)
+	{
+	  /* shutdown */
+	  break;
+	}
+
+      thread_set_current_tran_index (tsd_ptr, worker_p->tran_index);
+      (*func) (tsd_ptr, arg);
+      thread_set_current_tran_index (tsd_ptr, LOG_SYSTEM_TRAN_INDEX);
+
+      MUTEX_LOCK (rv, thread_Parallel_workers_lock);
+      worker_p->is_busy = false;
+      MUTEX_UNLOCK (thread_Parallel_workers_lock);
+
+      /* the requester may free the job as soon as it is unlocked */
+      MUTEX_LOCK (rv, job_p->lock);
+      if (--job_p->num_running == 0)
+	{
+	  COND_SIGNAL (job_p->cond);
+	}
+      MUTEX_UNLOCK (job_p->lock);
+    }
+
+  er_clear ();
+  tsd_ptr->status = TS_DEAD;
+
+#if defined(WINDOWS)
+  return 0;
+#else /* WINDOWS */
+  return NULL;
+#endif /* WINDOWS */
+}
+
+/*
+ * thread_wakeup_parallel_workers() - wake up the parallel workers to see
+ *                                    their shutdown request
+ *   return:
+ */
+static void
+thread_wakeup_parallel_workers (void)
+{
+  int i, rv;
+
+  for (i = 0; i < thread_Num_parallel_workers; i++)
+    {
+      MUTEX_LOCK (rv, thread_Parallel_workers[i].lock);
+      COND_SIGNAL (thread_Parallel_workers[i].cond);
+      MUTEX_UNLOCK (thread_Parallel_workers[i].lock);
+    }
+}
+
+/*
+ * thread_conn_io_thread() - connection I/O daemon
+ *   return:
+ *   arg_p(in):
+ *
+ * Note: Each of the thread_Num_conn_io_threads daemons watches its share of
+ *       the client sockets and queues the requests read from them. See
+ *       css_connection_io_handler ().
+ */
+#if defined(WINDOWS)
+static unsigned __stdcall
+thread_conn_io_thread (void *arg_p)
+#else /* WINDOWS */
+static void *
+thread_conn_io_thread (void *arg_p)
+#endif				/* WINDOWS */
+{
+#if !defined(HPUX)
+  THREAD_ENTRY *tsd_ptr;
+#endif /* !HPUX */
+  int io_index, rv;
+
+  tsd_ptr = (THREAD_ENTRY *) arg_p;
+  /* wait until THREAD_CREATE() finishes */
+  MUTEX_LOCK (rv, tsd_ptr->th_entry_lock);
+  MUTEX_UNLOCK (tsd_ptr->th_entry_lock);
+
+  thread_set_thread_entry_info (tsd_ptr);	/* save TSD */
+  tsd_ptr->type = TT_DAEMON;	/* daemon thread */
+  tsd_ptr->status = TS_RUN;	/* set thread stat as RUN */
+
+  for (io_index = 0; io_index < thread_Num_conn_io_threads; io_index++)
+    {
+      if (thread_Conn_io_thread[io_index].thread_index == tsd_ptr->index)
+	{
+	  break;
+	}
+    }
+  assert (io_index < thread_Num_conn_io_threads);
+
+  thread_set_current_tran_index (tsd_ptr, LOG_SYSTEM_TRAN_INDEX);
+
+#if defined(LINUX)
+  css_connection_io_handler (tsd_ptr, io_index);
+#endif /* LINUX */
+
+  er_clear ();
+  tsd_ptr->status = TS_DEAD;
+
+#if defined(WINDOWS)
+  return 0;
+#else /* WINDOWS */
+  return NULL;
+#endif /* WINDOWS */
+}
+
+/*
+ * thread_num_conn_io_threads() - number of connection I/O daemon threads
+ *   return:
+ */
+int
+thread_num_conn_io_threads (void)
+{
+  return thread_Num_conn_io_threads;
+}
+
+/*
+ * thread_num_parallel_workers() - number of parallel worker threads
+ *   return:
+ */
+int
+thread_num_parallel_workers (void)
+{
+  return thread_Num_parallel_workers;
+}
+
+/*
+ * thread_run_parallel() - run a set of tasks on the parallel workers
+ *   return: void
+ *   thread_p(in): requester
+ *   func(in): task function
+ *   args(in): argument of each task
+ *   ntasks(in): number of tasks
+ *
+ * Note: The tasks are handed to the idle parallel workers, which run them
+ *       on behalf of the requester's transaction. The first task, and any
+ *       task no idle worker is left for, are run by the requester itself,
+ *       so the requester never waits for a worker to become free. Returns
+ *       when all the tasks are done; the tasks report their errors through
+ *       their arguments.
+ */
+void
+thread_run_parallel (THREAD_ENTRY * thread_p, THREAD_PARALLEL_FUNC * func,
+		     void **args, int ntasks)
+{
+  THREAD_PARALLEL_JOB job;
+  THREAD_PARALLEL_WORKER *worker_p;
+  int reserved[THREAD_MAX_PARALLEL_WORKERS];
+  int num_reserved = 0;
+  int i, rv;
+
+  if (thread_p == NULL)
+    {
+      thread_p = thread_get_thread_entry_info ();
+    }
+
+  if (ntasks > 1 && thread_Num_parallel_workers > 0
+      && MUTEX_INIT (job.lock) == NO_ERROR)
+    {
+      if (COND_INIT (job.cond) != 0)
+	{
+	  (void) MUTEX_DESTROY (job.lock);
+	}
+      else
+	{
+	  MUTEX_LOCK (rv, thread_Parallel_workers_lock);
+	  for (i = 0; i < thread_Num_parallel_workers
+	       && num_reserved < ntasks - 1; i++)
+	    {
+	      if (thread_Parallel_workers[i].is_busy == false)
+		{
+		  thread_Parallel_workers[i].is_busy = true;
+		  reserved[num_reserved++] = i;
+		}
+	    }
+	  MUTEX_UNLOCK (thread_Parallel_workers_lock);
+
+	  if (num_reserved == 0)
+	    {
+	      (void) MUTEX_DESTROY (job.lock);
+	      (void) COND_DESTROY (job.cond);
+	    }
+	}
+    }
+
+  job.num_running = num_reserved;
+  for (i = 0; i < num_reserved; i++)
+    {
+      worker_p = &thread_Parallel_workers[reserved[i]];
+
+      MUTEX_LOCK (rv, worker_p->lock);
+      worker_p->func = func;
+      worker_p->arg = args[i + 1];
+      worker_p->tran_index = thread_p->tran_index;
+      worker_p->job = &job;
+      COND_SIGNAL (worker_p->cond);
+      MUTEX_UNLOCK (worker_p->lock);
+    }
+
+  (*func) (thread_p, args[0]);
+  for (i = num_reserved + 1; i < ntasks; i++)
+    {
+      (*func) (thread_p, args[i]);
+    }
+
+  if (num_reserved > 0)
+    {
+      MUTEX_LOCK (rv, job.lock);
+      while (job.num_running > 0)
+	{
+	  COND_WAIT (job.cond, job.lock);
+#if defined(WINDOWS)
+	  MUTEX_LOCK (rv, job.lock);
+#endif /* WINDOWS */
+	}
+      MUTEX_UNLOCK (job.lock);
+
+      (void) MUTEX_DESTROY (job.lock);
+      (void) COND_DESTROY (job.cond);
     }
-  MUTEX_UNLOCK (thread_Page_flush_thread.lock);
 }
 
 #if defined(WINDOWS)
@@ -2782,8 +3478,8 @@ thread_log_flush_thread (void *arg_p)
   int diff_wait_time;
   int min_wait_time;
   int ret;
-  bool have_wake_up_thread;
   int flushed;
+  LOG_LSA flushed_lsa;
 #if !defined(WINDOWS)
   int temp_wait_usec;
 #endif
@@ -2836,15 +3532,22 @@ thread_log_flush_thread (void *arg_p)
       LFT_wait_time.tv_nsec = temp_wait_usec * 1000;
 #endif /* WINDOWS */
 
-      thread_Log_flush_thread.is_log_flush_force = false;
       thread_Log_flush_thread.is_running = false;
 
-      ret = COND_TIMEDWAIT (thread_Log_flush_thread.cond,
-			    thread_Log_flush_thread.lock, LFT_wait_time);
+      if (thread_Log_flush_thread.is_log_flush_force)
+	{
+	  /* a committer asked for a flush while the last one was running */
+	  ret = TIMEDWAIT_GET_LK;
+	}
+      else
+	{
+	  ret = COND_TIMEDWAIT (thread_Log_flush_thread.cond,
+				thread_Log_flush_thread.lock, LFT_wait_time);
 
 #if defined(WINDOWS)
-      MUTEX_LOCK (rv, thread_Log_flush_thread.lock);
+	  MUTEX_LOCK (rv, thread_Log_flush_thread.lock);
 #endif /* WINDOWS */
+	}
 
       thread_Log_flush_thread.is_running = true;
 
@@ -2873,10 +3576,7 @@ thread_log_flush_thread (void *arg_p)
 		    gc_elapsed, repl_elapsed, work_elapsed, diff_wait_time);
 #endif /* CUBRID_DEBUG */
 
-      MUTEX_LOCK (rv, group_commit_info->gc_mutex);
-
       is_background_flush = false;
-      have_wake_up_thread = false;
       if (ret == TIMEDWAIT_TIMEOUT)
 	{
 	  if (thread_Log_flush_thread.is_log_flush_force)
@@ -2924,6 +3624,14 @@ thread_log_flush_thread (void *arg_p)
 #endif
 	}
 
+      thread_Log_flush_thread.is_log_flush_force = false;
+
+      /*
+       * Committers keep on appending and queueing up for the next flush
+       * while this one is being written and synchronized.
+       */
+      MUTEX_UNLOCK (thread_Log_flush_thread.lock);
+
       if (is_background_flush)
 	{
 	  LOG_MUTEX_LOCK (rv, log_Gl.flush_info.flush_mutex);
@@ -2942,6 +3650,15 @@ thread_log_flush_thread (void *arg_p)
 	  log_Gl.flush_info.flush_type = LOG_FLUSH_DIRECT;
 	  flushed = logpb_flush_all_append_pages_helper (tsd_ptr);
 	  log_Gl.flush_info.flush_type = LOG_FLUSH_NORMAL;
+	  if (flushed == 0)
+	    {
+	      /* nothing was dirty, everything appended is on disk */
+	      LSA_COPY (&flushed_lsa, &log_Gl.hdr.append_lsa);
+	    }
+	  else
+	    {
+	      LSA_COPY (&flushed_lsa, &log_Gl.append.nxio_lsa);
+	    }
 	  LOG_CS_EXIT ();
 
 	  if (flushed > 0)
@@ -2957,31 +3674,12 @@ thread_log_flush_thread (void *arg_p)
 					     log_Name_active);
 		}
 	    }
-	  have_wake_up_thread = true;
-	}
-
-      if (have_wake_up_thread)
-	{
-#if defined(WINDOWS)
-	  int loop;
-
-	  for (loop = 0; loop != group_commit_info->waiters; ++loop)
-	    {
-	      COND_BROADCAST (group_commit_info->gc_cond);
-	    }
-#else /* WINDOWS */
-	  COND_BROADCAST (group_commit_info->gc_cond);
-#endif /* WINDOWS */
 
-#if defined(CUBRID_DEBUG)
-	  er_log_debug (ARG_FILE_LINE,
-			"css_log_flush_thread: "
-			"[%d]send signal - waiters(%d) \n",
-			(int) THREAD_ID (), group_commit_info->waiters);
-#endif /* CUBRID_DEBUG */
-	  group_commit_info->waiters = 0;
+	  /* wake up only the committers covered by this flush */
+	  logpb_wakeup_commit_waiters (&flushed_lsa);
 	}
-      MUTEX_UNLOCK (group_commit_info->gc_mutex);
+
+      MUTEX_LOCK (rv, thread_Log_flush_thread.lock);
     }
 
   thread_Log_flush_thread.is_valid = false;
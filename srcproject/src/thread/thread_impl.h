@@ -37,12 +37,15 @@
 #include "error_manager.h"
 #include "adjustable_array.h"
 #include "system_parameter.h"
+#include "storage_common.h"
 #endif /* SERVER_MODE */
 
 #if !defined(SERVER_MODE)
 #define thread_get_thread_entry_info()  (NULL)
 #define thread_num_worker_threads()  (1)
 #define thread_num_total_threads()   (1)
+#define thread_num_parallel_workers()  (0)
+#define thread_num_conn_io_threads()  (0)
 
 typedef void THREAD_ENTRY;
 #else /* !SERVER_MODE */
@@ -127,6 +130,10 @@ struct thread_entry
   double lockwait_stime;	/* time in miliseconds */
   int lockwait_nsecs;
   int lockwait_state;
+  void *lk_free_entry_list;	/* thread cache of free lock entries */
+  int lk_num_free_entries;
+  void *lk_free_res_list;	/* thread cache of free lock resources */
+  int lk_num_free_res;
   void *query_entry;
   struct thread_entry *tran_next_wait;
   struct thread_entry *worker_thrd_list;	/* worker thrd on jobq list */
@@ -135,6 +142,14 @@ struct thread_entry
   void *log_zip_redo;
   char *log_data_ptr;
   int log_data_length;
+
+  /* page reads of this thread; a transaction may scan with several
+     threads (see thread_run_parallel ()) */
+  int pgbuf_bulk_read_cnt;	/* > 0 while in bulk read mode */
+  VPID pgbuf_seq_last_vpid;	/* the last page fixed for read */
+  int pgbuf_seq_fix_cnt;	/* # of consecutive sequential fixes */
+  PAGEID pgbuf_seq_prefetch_pageid;	/* the last page requested to read
+					   ahead */
 };
 
 #define DOES_THREAD_RESUME_DUE_TO_SHUTDOWN(thread_p) \
@@ -156,6 +171,9 @@ typedef void *CSS_THREAD_ARG;
 
 typedef int (*CSS_THREAD_FN) (THREAD_ENTRY * thrd, CSS_THREAD_ARG);
 
+/* a task run by thread_run_parallel () */
+typedef void THREAD_PARALLEL_FUNC (THREAD_ENTRY * thread_p, void *arg);
+
 extern DAEMON_THREAD_MONITOR thread_Log_flush_thread;
 
 #if !defined(HPUX)
@@ -228,7 +246,13 @@ extern int thread_has_threads (THREAD_ENTRY *caller, int tran_index, int client_
 extern bool thread_set_check_interrupt (THREAD_ENTRY * thread_p, bool flag);
 extern void thread_wakeup_deadlock_detect_thread (void);
 extern void thread_wakeup_log_flush_thread (void);
-extern void thread_wakeup_page_flush_thread (void);
+extern void thread_wakeup_page_flush_thread (int lru_idx);
+extern void thread_wakeup_page_prefetch_thread (void);
+extern int thread_num_parallel_workers (void);
+extern int thread_num_conn_io_threads (void);
+extern void thread_run_parallel (THREAD_ENTRY * thread_p,
+				 THREAD_PARALLEL_FUNC * func, void **args,
+				 int ntasks);
 extern void thread_wakeup_flush_control_thread (void);
 extern THREAD_ENTRY *thread_find_first_lockwait_entry (int *thrd_index);
 extern THREAD_ENTRY *thread_find_next_lockwait_entry (int *thrd_index);
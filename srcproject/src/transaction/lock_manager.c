@@ -106,6 +106,7 @@ do {    entry_ptr->tran_index = -1;                             \
         entry_ptr->history = NULL;                              \
         entry_ptr->recent = NULL;                               \
         entry_ptr->mlk_count = 0;                               \
+        entry_ptr->fastpath = false;                            \
 } while (0)
 
 /* initialize lock entry as granted state */
@@ -122,6 +123,7 @@ do {    entry_ptr->tran_index = (tran_index);                   \
         entry_ptr->history = NULL;                              \
         entry_ptr->recent = NULL;                               \
         entry_ptr->mlk_count = 0;                               \
+        entry_ptr->fastpath = false;                            \
 } while (0)
 
 /* initialize lock entry as blocked state */
@@ -139,6 +141,7 @@ do {    entry_ptr->tran_index = (tran_index);                   \
         entry_ptr->history = NULL;                              \
         entry_ptr->recent = NULL;                               \
         entry_ptr->mlk_count = 0;                               \
+        entry_ptr->fastpath = false;                            \
 } while (0)
 
 /* initialize lock entry as non2pl state */
@@ -155,6 +158,7 @@ do {    entry_ptr->tran_index = (tran_index);                   \
         entry_ptr->history = NULL;                              \
         entry_ptr->recent = NULL;                               \
         entry_ptr->mlk_count = 0;                               \
+        entry_ptr->fastpath = false;                            \
 } while (0)
 
 /* initialize lock resource as free state */
@@ -169,6 +173,7 @@ do {    MUTEX_INIT(((res_ptr)->res_mutex));                     \
         res_ptr->waiter = NULL;                                 \
         res_ptr->non2pl = NULL;                                 \
         res_ptr->hash_next = NULL;                              \
+        res_ptr->fastpath_count = 0;                            \
 } while (0)
 
 /* initialize lock resource as allocated state */
@@ -407,6 +412,9 @@ struct lk_WFG_node
   int tran_edge_seq_num;
   bool checked_by_deadlock_detector;
   bool DL_victim;
+  bool DL_new_waiter;		/* queued for the deadlock detector */
+  struct lk_res *wait_res;	/* resource the transaction waits for */
+  double wait_msec;		/* lock wait start time (msec) */
 };
 
 typedef struct lk_WFG_edge LK_WFG_EDGE;
@@ -419,6 +427,25 @@ struct lk_WFG_edge
   time_t edge_wait_stime;
 };
 
+/* search state of the deadlock detection for new lock waiters */
+typedef struct lk_DL_search LK_DL_SEARCH;
+struct lk_DL_search
+{
+  int *mark;			/* 0: not visited, 1: on the stack, 2: done */
+  int *stack_pos;		/* position in the search stack */
+  int *first_edge;		/* first outgoing edge */
+  int *last_edge;		/* next to the last outgoing edge */
+  int *current;			/* next outgoing edge to follow */
+  int *holder_flag;		/* the incoming edge is to a lock holder */
+  double *wait_msec;		/* lock wait start time of the edges */
+  int *stack;			/* search stack */
+  int top;
+  int *edge_to;			/* waited transaction of each edge */
+  int *edge_holder;		/* holder flag of each edge */
+  int num_edges;
+  int max_edges;
+};
+
 typedef struct lk_deadlock_victim LK_DEADLOCK_VICTIM;
 struct lk_deadlock_victim
 {
@@ -447,6 +474,7 @@ struct lk_res
   LK_ENTRY *waiter;		/* lock waiter list */
   LK_ENTRY *non2pl;		/* non2pl list */
   LK_RES *hash_next;		/* for hash chain */
+  int fastpath_count;		/* # of fast path holders and pins */
 };
 
 /*
@@ -507,6 +535,20 @@ struct lk_tran_lock
   bool is_instant_duration;
 };
 
+/*
+ * Fast path of class intention locks
+ *
+ * IS and IX class locks are granted without the res_mutex of the class
+ * while no transaction requests a stronger lock on a class hashed to the
+ * same strong slot. Such locks are kept only in the class hold list of the
+ * transaction and are moved into the lock table by the strong requester.
+ */
+#define LK_FASTPATH_STRONG_SLOTS 1024
+#define LK_FASTPATH_STRONG_SLOT(hash_index) \
+  ((hash_index) % LK_FASTPATH_STRONG_SLOTS)
+#define LK_IS_WEAK_CLASS_MODE(mode) \
+  ((mode) == NULL_LOCK || (mode) == IS_LOCK || (mode) == IX_LOCK)
+
 /*
  * Lock Manager Global Data Structure
  */
@@ -550,6 +592,14 @@ struct lk_global_data
 #if defined(LK_DUMP)
   bool dump_level;
 #endif				/* LK_DUMP */
+
+  /* # of strong class lock requests per slot */
+  int fastpath_strong_count[LK_FASTPATH_STRONG_SLOTS];
+
+  /* lock waiters not yet checked by the deadlock detector */
+  MUTEX_T DL_new_waiter_mutex;
+  int *DL_new_waiters;
+  int DL_num_new_waiters;
 };
 
 LK_GLOBAL_DATA lk_Gl = {
@@ -599,6 +649,15 @@ static const int LK_SLEEP_MAX_COUNT = 3;
 /* TODO : change const */
 #define LK_MAX_VICTIM_COUNT  300
 
+/* thread caches of free lock entries and lock resource entries:
+ * the max # of entries a thread keeps, and the # of entries moved between
+ * a thread cache and the global free list at once */
+#define LK_THREAD_CACHE_SIZE  32
+#define LK_THREAD_CACHE_BATCH 16
+
+/* max # of resources visited by a hash chain search without hash mutex */
+#define LK_LATCH_FREE_SEARCH_MAX_HOPS 64
+
 /* transaction WFG edge related constants */
 static const int LK_MIN_TWFG_EDGE_COUNT = 200;
 /* TODO : change const */
@@ -637,9 +696,15 @@ static void lk_free_all_scanid_bit (void);
 static LK_RES *lock_alloc_resource (void);
 static void lock_free_resource (LK_RES * res_ptr);
 static int lock_alloc_resource_block (void);
+static void lock_clear_thread_caches (void);
+static LK_RES *lock_find_resource_latch_free (LK_HASH * hash_anchor,
+					      const OID * oid);
 static LK_ENTRY *lock_alloc_entry (void);
 static void lock_free_entry (LK_ENTRY * entry_ptr);
 static int lock_alloc_entry_block (void);
+static bool lock_retire_resource_oid (LK_RES * res_ptr);
+static void lock_abandon_new_resource (LK_HASH * hash_anchor,
+				       LK_RES * res_ptr);
 static int lock_dealloc_resource (LK_RES * res_ptr);
 static void lock_insert_into_tran_hold_list (LK_ENTRY * entry_ptr);
 static int lock_delete_from_tran_hold_list (LK_ENTRY * entry_ptr);
@@ -674,6 +739,23 @@ static int lock_internal_hold_lock_object_instant (int tran_index,
 						   const OID * oid,
 						   const OID * class_oid,
 						   LOCK lock);
+static LK_RES *lock_fastpath_pin_resource (LK_HASH * hash_anchor,
+					   const OID * oid);
+static void lock_fastpath_unpin_resource (LK_RES * res_ptr);
+static bool lock_fastpath_lock_class (THREAD_ENTRY * thread_p,
+				      int tran_index, const OID * class_oid,
+				      LOCK lock, LK_ENTRY ** entry_addr_ptr,
+				      LK_ENTRY * class_entry);
+static bool lock_fastpath_unlock_class (THREAD_ENTRY * thread_p,
+					LK_ENTRY * entry_ptr);
+static void lock_fastpath_transfer (LK_RES * res_ptr, int tran_index);
+static int lock_internal_lock_object_in_table (THREAD_ENTRY * thread_p,
+					       int tran_index,
+					       const OID * oid,
+					       const OID * class_oid,
+					       LOCK lock, int waitsecs,
+					       LK_ENTRY ** entry_addr_ptr,
+					       LK_ENTRY * class_entry);
 static int lock_internal_perform_lock_object (THREAD_ENTRY * thread_p,
 					      int tran_index, const OID * oid,
 					      const OID * class_oid,
@@ -713,6 +795,16 @@ static int lock_add_WFG_edge (int from_tran_index, int to_tran_index,
 static void lock_select_deadlock_victim (THREAD_ENTRY * thread_p, int s,
 					 int t);
 static void lock_dump_deadlock_victims (THREAD_ENTRY * thread_p);
+static void lock_add_new_lock_waiter (int tran_index);
+static int lock_DL_add_edge (LK_DL_SEARCH * search, int to_tran_index,
+			     int holder_flag);
+static int lock_DL_push (LK_DL_SEARCH * search, int tran_index,
+			 int holder_flag);
+static bool lock_DL_select_victim (THREAD_ENTRY * thread_p,
+				   LK_DL_SEARCH * search, int s, int t,
+				   int holder_flag);
+static void lock_DL_record_detect_time (THREAD_ENTRY * thread_p,
+					double elapsed_msec);
 static int lock_compare_lock_info (const void *lockinfo1,
 				   const void *lockinfo2);
 static void lock_dump_resource (THREAD_ENTRY * thread_p, FILE * outfp,
@@ -1025,7 +1117,21 @@ lock_initialize_deadlock_detection (void)
       lk_Gl.TWFG_node[i].DL_victim = false;
       lk_Gl.TWFG_node[i].checked_by_deadlock_detector = false;
       lk_Gl.TWFG_node[i].thrd_wait_stime = 0;
+      lk_Gl.TWFG_node[i].DL_new_waiter = false;
+      lk_Gl.TWFG_node[i].wait_res = NULL;
+      lk_Gl.TWFG_node[i].wait_msec = 0;
+    }
+
+  /* allocate the queue of new lock waiters */
+  MUTEX_INIT (lk_Gl.DL_new_waiter_mutex);
+  lk_Gl.DL_new_waiters = (int *) malloc (sizeof (int) * lk_Gl.num_trans);
+  if (lk_Gl.DL_new_waiters == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY,
+	      1, (sizeof (int) * lk_Gl.num_trans));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
     }
+  lk_Gl.DL_num_new_waiters = 0;
 
   /* initialize other related fields */
   lk_Gl.TWFG_edge = (LK_WFG_EDGE *) NULL;
@@ -1168,12 +1274,24 @@ lock_alloc_resource (void)
   int count_try_alloc_entry;
   int count_try_alloc_table;
   LK_RES *res_ptr;
-  int rv;
+  THREAD_ENTRY *thread_p;
+  int i, rv;
 
   /* The caller is holding a hash mutex. The reason for holding
    * the hash mutex is to prevent other transactions from
    * allocating lock resource entry on the same lock resource.
    */
+  /* 0. allocate a lock resource entry from the thread cache */
+  thread_p = thread_get_thread_entry_info ();
+  if (thread_p != NULL && thread_p->lk_free_res_list != NULL)
+    {
+      res_ptr = (LK_RES *) thread_p->lk_free_res_list;
+      thread_p->lk_free_res_list = res_ptr->hash_next;
+      thread_p->lk_num_free_res--;
+      ATOMIC_INC_32 (&lk_Gl.num_obj_res_allocated, 1);
+      return res_ptr;
+    }
+
   /* 1. allocate a lock resource entry from the free list if possible */
   count_try_alloc_entry = 0;
 
@@ -1185,7 +1303,19 @@ try_alloc_entry_again:
     {
       res_ptr = lk_Gl.obj_free_res_list;
       lk_Gl.obj_free_res_list = res_ptr->hash_next;
-      lk_Gl.num_obj_res_allocated++;
+      ATOMIC_INC_32 (&lk_Gl.num_obj_res_allocated, 1);
+
+      /* move a batch of free entries into the thread cache */
+      for (i = 1; thread_p != NULL && i < LK_THREAD_CACHE_BATCH
+	   && lk_Gl.obj_free_res_list != (LK_RES *) NULL; i++)
+	{
+	  LK_RES *cached = lk_Gl.obj_free_res_list;
+
+	  lk_Gl.obj_free_res_list = cached->hash_next;
+	  cached->hash_next = (LK_RES *) thread_p->lk_free_res_list;
+	  thread_p->lk_free_res_list = cached;
+	  thread_p->lk_num_free_res++;
+	}
 
       MUTEX_UNLOCK (lk_Gl.obj_free_res_list_mutex);
 #if defined(LK_DUMP)
@@ -1220,7 +1350,7 @@ try_alloc_table_again:
       /* Now, the lock resource free list is not empty. */
       res_ptr = lk_Gl.obj_free_res_list;
       lk_Gl.obj_free_res_list = res_ptr->hash_next;
-      lk_Gl.num_obj_res_allocated++;
+      ATOMIC_INC_32 (&lk_Gl.num_obj_res_allocated, 1);
 
       MUTEX_UNLOCK (lk_Gl.obj_free_res_list_mutex);
 #if defined(LK_DUMP)
@@ -1272,7 +1402,9 @@ try_alloc_table_again:
 static void
 lock_free_resource (LK_RES * res_ptr)
 {
-  int rv;
+  THREAD_ENTRY *thread_p;
+  LK_RES *cached;
+  int i, rv;
 #if defined(LK_DUMP)
   if (lk_Gl.dump_level >= 2)
     {
@@ -1284,16 +1416,36 @@ lock_free_resource (LK_RES * res_ptr)
   /* set the lock resource entry as free state */
   res_ptr->type = LOCK_RESOURCE_OBJECT;
   OID_SET_NULL (&res_ptr->oid);
+  ATOMIC_INC_32 (&lk_Gl.num_obj_res_allocated, -1);
+
+  /* keep it in the thread cache if there is room */
+  thread_p = thread_get_thread_entry_info ();
+  if (thread_p != NULL && thread_p->lk_num_free_res < LK_THREAD_CACHE_SIZE)
+    {
+      res_ptr->hash_next = (LK_RES *) thread_p->lk_free_res_list;
+      thread_p->lk_free_res_list = res_ptr;
+      thread_p->lk_num_free_res++;
+      return;
+    }
 
-  /* connect it into the free list of lock resource entries */
+  /* connect it into the free list of lock resource entries,
+   * together with a batch of the thread cache */
   MUTEX_LOCK (rv, lk_Gl.obj_free_res_list_mutex);
 
   res_ptr->hash_next = lk_Gl.obj_free_res_list;
   lk_Gl.obj_free_res_list = res_ptr;
-  lk_Gl.num_obj_res_allocated--;
 
-  MUTEX_UNLOCK (lk_Gl.obj_free_res_list_mutex);
+  for (i = 0; thread_p != NULL && i < LK_THREAD_CACHE_BATCH; i++)
+    {
+      cached = (LK_RES *) thread_p->lk_free_res_list;
+      thread_p->lk_free_res_list = cached->hash_next;
+      thread_p->lk_num_free_res--;
+
+      cached->hash_next = lk_Gl.obj_free_res_list;
+      lk_Gl.obj_free_res_list = cached;
+    }
 
+  MUTEX_UNLOCK (lk_Gl.obj_free_res_list_mutex);
 }
 #endif /* SERVER_MODE */
 
@@ -1383,10 +1535,22 @@ lock_alloc_entry (void)
   int count_try_alloc_entry;
   int count_try_alloc_table;
   LK_ENTRY *entry_ptr;
-  int rv;
+  THREAD_ENTRY *thread_p;
+  int i, rv;
 
   /* The caller is holding a resource mutex */
 
+  /* 0. allocate a lock entry from the thread cache */
+  thread_p = thread_get_thread_entry_info ();
+  if (thread_p != NULL && thread_p->lk_free_entry_list != NULL)
+    {
+      entry_ptr = (LK_ENTRY *) thread_p->lk_free_entry_list;
+      thread_p->lk_free_entry_list = entry_ptr->next;
+      thread_p->lk_num_free_entries--;
+      memset (&entry_ptr->scanid_bitset, 0, PRM_LK_MAX_SCANID_BIT / 8);
+      return entry_ptr;
+    }
+
   /* 1. allocate an lock entry from the free list */
   count_try_alloc_entry = 0;
 
@@ -1405,6 +1569,19 @@ lock_alloc_entry (void)
     {
       entry_ptr = lk_Gl.obj_free_entry_list;
       lk_Gl.obj_free_entry_list = entry_ptr->next;
+
+      /* move a batch of free entries into the thread cache */
+      for (i = 1; thread_p != NULL && i < LK_THREAD_CACHE_BATCH
+	   && lk_Gl.obj_free_entry_list != (LK_ENTRY *) NULL; i++)
+	{
+	  LK_ENTRY *cached = lk_Gl.obj_free_entry_list;
+
+	  lk_Gl.obj_free_entry_list = cached->next;
+	  cached->next = (LK_ENTRY *) thread_p->lk_free_entry_list;
+	  thread_p->lk_free_entry_list = cached;
+	  thread_p->lk_num_free_entries++;
+	}
+
       MUTEX_UNLOCK (lk_Gl.obj_free_entry_list_mutex);
 #if defined(LK_DUMP)
       if (lk_Gl.dump_level >= 2)
@@ -1478,8 +1655,10 @@ lock_alloc_entry (void)
 static void
 lock_free_entry (LK_ENTRY * entry_ptr)
 {
-  int rv;
+  int i, rv;
   LK_ACQUISITION_HISTORY *history, *next;
+  THREAD_ENTRY *thread_p;
+  LK_ENTRY *cached;
 
 #if defined(LK_DUMP)
   if (lk_Gl.dump_level >= 2)
@@ -1502,10 +1681,32 @@ lock_free_entry (LK_ENTRY * entry_ptr)
   entry_ptr->history = NULL;
   entry_ptr->recent = NULL;
 
-  /* connect it into free entry list */
+  /* keep it in the thread cache if there is room */
+  thread_p = thread_get_thread_entry_info ();
+  if (thread_p != NULL
+      && thread_p->lk_num_free_entries < LK_THREAD_CACHE_SIZE)
+    {
+      entry_ptr->next = (LK_ENTRY *) thread_p->lk_free_entry_list;
+      thread_p->lk_free_entry_list = entry_ptr;
+      thread_p->lk_num_free_entries++;
+      return;
+    }
+
+  /* connect it into free entry list, together with a batch of the thread
+   * cache */
   MUTEX_LOCK (rv, lk_Gl.obj_free_entry_list_mutex);
   entry_ptr->next = lk_Gl.obj_free_entry_list;
   lk_Gl.obj_free_entry_list = entry_ptr;
+
+  for (i = 0; thread_p != NULL && i < LK_THREAD_CACHE_BATCH; i++)
+    {
+      cached = (LK_ENTRY *) thread_p->lk_free_entry_list;
+      thread_p->lk_free_entry_list = cached->next;
+      thread_p->lk_num_free_entries--;
+
+      cached->next = lk_Gl.obj_free_entry_list;
+      lk_Gl.obj_free_entry_list = cached;
+    }
   MUTEX_UNLOCK (lk_Gl.obj_free_entry_list_mutex);
 }
 #endif /* SERVER_MODE */
@@ -1573,6 +1774,145 @@ lock_alloc_entry_block (void)
 }
 #endif /* SERVER_MODE */
 
+#if defined(SERVER_MODE)
+/*
+ * lock_clear_thread_caches - Forget the free entries cached by threads
+ *
+ * return:
+ *
+ * Note:This function is called when the lock entry blocks and the lock
+ *     resource blocks are freed. The cached entries belong to the blocks.
+ */
+static void
+lock_clear_thread_caches (void)
+{
+  THREAD_ENTRY *thread_p;
+  int i;
+
+  for (i = 0; i < thread_num_total_threads (); i++)
+    {
+      thread_p = thread_find_entry_by_index (i);
+      thread_p->lk_free_entry_list = NULL;
+      thread_p->lk_num_free_entries = 0;
+      thread_p->lk_free_res_list = NULL;
+      thread_p->lk_num_free_res = 0;
+    }
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_find_resource_latch_free - Find the lock resource entry of an object
+ *                                 without holding the hash mutex
+ *
+ * return: the lock resource entry with its res_mutex held, or NULL
+ *
+ *   hash_anchor(in): hash chain of the object
+ *   oid(in): object identifier
+ *
+ * Note:Lock resource entries are never returned to the system while the
+ *     lock manager is active, so a hash chain can be traversed without its
+ *     hash mutex. The resource entry found is checked again under its
+ *     res_mutex: the OID of a resource entry is set while the res_mutex is
+ *     held until the entry is connected into the hash chain, and is reset
+ *     before the res_mutex is released when the entry is removed from it.
+ *     Since concurrent updates may lead the traversal away from the chain,
+ *     NULL only means that the chain has to be searched again holding the
+ *     hash mutex.
+ */
+static LK_RES *
+lock_find_resource_latch_free (LK_HASH * hash_anchor, const OID * oid)
+{
+  LK_RES *res_ptr;
+  int hops, rv;
+
+  res_ptr = hash_anchor->hash_next;
+  for (hops = 0; res_ptr != (LK_RES *) NULL
+       && hops < LK_LATCH_FREE_SEARCH_MAX_HOPS; hops++)
+    {
+      if (OID_EQ (&res_ptr->oid, oid))
+	{
+	  MUTEX_LOCK (rv, res_ptr->res_mutex);
+	  if (OID_EQ (&res_ptr->oid, oid))
+	    {
+	      return res_ptr;
+	    }
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
+	  return (LK_RES *) NULL;
+	}
+      res_ptr = res_ptr->hash_next;
+    }
+
+  return (LK_RES *) NULL;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_retire_resource_oid - Reset the OID of a resource entry that is
+ *                            about to be removed from the hash chain
+ *
+ * return: true if the entry may be removed, false if it is pinned
+ *
+ *   res_ptr(in):
+ *
+ * Note:The caller is holding the res_mutex. A fast path locker pins the
+ *     resource entry before it checks the OID again, and this function
+ *     resets the OID before it checks the pins, so either the locker sees
+ *     the reset OID or the entry is kept in the hash chain.
+ */
+static bool
+lock_retire_resource_oid (LK_RES * res_ptr)
+{
+  OID oid;
+
+  COPY_OID (&oid, &res_ptr->oid);
+  OID_SET_NULL (&res_ptr->oid);
+  MEMORY_BARRIER ();
+
+  if (res_ptr->fastpath_count > 0)
+    {
+      COPY_OID (&res_ptr->oid, &oid);
+      return false;
+    }
+
+  return true;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_abandon_new_resource - Give up a resource entry that has been
+ *                             allocated by a failed lock request
+ *
+ * return: nothing
+ *
+ *   hash_anchor(in): hash chain of the object
+ *   res_ptr(in): empty resource entry
+ *
+ * Note:The caller is holding the hash_mutex and the res_mutex, both of
+ *     which are released here. If a fast path locker has pinned the entry
+ *     meanwhile, the empty entry is connected into the hash chain and is
+ *     deallocated when the last pin is released.
+ */
+static void
+lock_abandon_new_resource (LK_HASH * hash_anchor, LK_RES * res_ptr)
+{
+  if (lock_retire_resource_oid (res_ptr) == false)
+    {
+      res_ptr->hash_next = hash_anchor->hash_next;
+      hash_anchor->hash_next = res_ptr;
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+      MUTEX_UNLOCK (hash_anchor->hash_mutex);
+      return;
+    }
+
+  MUTEX_UNLOCK (res_ptr->res_mutex);
+  MUTEX_UNLOCK (hash_anchor->hash_mutex);
+  lock_free_resource (res_ptr);
+}
+#endif /* SERVER_MODE */
+
 #if defined(SERVER_MODE)
 /*
  * lock_dealloc_resource - Deallocate lock resource entry
@@ -1687,9 +2027,18 @@ lock_dealloc_resource (LK_RES * res_ptr)
 	}
     }
 
-  /* I hold hash_mutex and res_mutex
-   * remove the resource entry from the hash chain
+  /* I hold hash_mutex and res_mutex.
+   * latch-free searchers must not take it after res_mutex is released,
+   * and it must stay while a fast path locker pins it.
    */
+  if (lock_retire_resource_oid (res_ptr) == false)
+    {
+      MUTEX_UNLOCK (hash_anchor->hash_mutex);
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+      return NO_ERROR;
+    }
+
+  /* remove the resource entry from the hash chain */
   if (prev == (LK_RES *) NULL)
     {
       hash_anchor->hash_next = res_ptr->hash_next;
@@ -2714,12 +3063,23 @@ lock_suspend (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr, int waitsecs)
   lk_Gl.TWFG_node[entry_ptr->tran_index].thrd_wait_stime =
     (time_t) (entry_ptr->thrd_entry->lockwait_stime / 1000);
 
+  /* add the new edges of the wait-for graph */
+  lk_Gl.TWFG_node[entry_ptr->tran_index].wait_msec =
+    entry_ptr->thrd_entry->lockwait_stime;
+  lk_Gl.TWFG_node[entry_ptr->tran_index].wait_res = entry_ptr->res_head;
+  lock_add_new_lock_waiter (entry_ptr->tran_index);
+
   /* wakeup the dealock detect thread */
   thread_wakeup_deadlock_detect_thread ();
 
   /* suspend the worker thread (transaction) */
   thread_suspend_wakeup_and_unlock_entry (entry_ptr->thrd_entry,
 					  THREAD_LOCK_SUSPENDED);
+  mnt_lat_record (entry_ptr->thrd_entry, MNT_LAT_LOCK_WAIT, 0, &tv);
+
+  /* remove the edges of the wait-for graph */
+  lk_Gl.TWFG_node[entry_ptr->tran_index].wait_res = NULL;
+
   if (entry_ptr->thrd_entry->resume_status == THREAD_RESUME_DUE_TO_INTERRUPT)
     {
       /* a shutdown thread wakes me up */
@@ -3722,6 +4082,13 @@ lock_internal_hold_lock_object_instant (int tran_index, const OID * oid,
   hash_index = LK_OBJ_LOCK_HASH (oid);
   hash_anchor = &lk_Gl.obj_hash_table[hash_index];
 
+  /* try to find the lockable object without holding hash_mutex */
+  res_ptr = lock_find_resource_latch_free (hash_anchor, oid);
+  if (res_ptr != (LK_RES *) NULL)
+    {
+      goto res_mutex_held;
+    }
+
   MUTEX_LOCK (rv, hash_anchor->hash_mutex);
 
   /* find the lockable object in the hash chain */
@@ -3747,8 +4114,15 @@ lock_internal_hold_lock_object_instant (int tran_index, const OID * oid,
   /* release lock hash mutex */
   MUTEX_UNLOCK (hash_anchor->hash_mutex);
 
+res_mutex_held:
   /* Note: I am holding resource mutex only */
 
+  /* fast path locks on the class have to be seen by the check */
+  if (res_ptr->type == LOCK_RESOURCE_CLASS)
+    {
+      lock_fastpath_transfer (res_ptr, NULL_TRAN_INDEX);
+    }
+
   /* find the lock entry of current transaction */
   entry_ptr = res_ptr->holder;
   for (; entry_ptr != (LK_ENTRY *) NULL; entry_ptr = entry_ptr->next)
@@ -3825,1450 +4199,1676 @@ lock_internal_hold_lock_object_instant (int tran_index, const OID * oid,
 
 #if defined(SERVER_MODE)
 /*
- * lock_internal_perform_lock_object - Performs actual object lock operation
- *
- * return: one of following values
- *              LK_GRANTED
- *              LK_NOTGRANTED_DUE_ABORTED
- *              LK_NOTGRANTED_DUE_TIMEOUT
- *              LK_NOTGRANTED_DUE_ERROR
+ * lock_fastpath_pin_resource - Pin the lock resource entry of a class
  *
- *   tran_index(in):
- *   oid(in):
- *   class_oid(in):
- *   lock(in):
- *   waitsecs(in):
- *   entry_addr_ptr(in):
- *   class_entry(in):
+ * return: pinned resource entry or NULL
  *
- * Note:lock an object whose id is pointed by oid with given lock mode 'lock'.
+ *   hash_anchor(in): hash chain of the class
+ *   oid(in): class identifier
  *
- *     If cond_flag is true and the object has already been locked
- *     by other transaction, then return LK_NOTGRANTED;
- *     else this transaction is suspended until it can acquire the lock.
+ * Note:The hash chain is traversed without any mutex (see
+ *     lock_find_resource_latch_free). A pinned resource entry is not
+ *     removed from the hash chain (see lock_retire_resource_oid).
  */
-static int
-lock_internal_perform_lock_object (THREAD_ENTRY * thread_p, int tran_index,
-				   const OID * oid, const OID * class_oid,
-				   LOCK lock, int waitsecs,
-				   LK_ENTRY ** entry_addr_ptr,
-				   LK_ENTRY * class_entry)
+static LK_RES *
+lock_fastpath_pin_resource (LK_HASH * hash_anchor, const OID * oid)
 {
-  TRAN_ISOLATION isolation;
-  int granted;
-  unsigned int hash_index;
-  LK_HASH *hash_anchor;
-  int ret_val;
-  LOCK group_mode, old_mode, new_mode;	/* lock mode */
   LK_RES *res_ptr;
-  LK_ENTRY *entry_ptr = (LK_ENTRY *) NULL;
-  LK_ENTRY *wait_entry_ptr = (LK_ENTRY *) NULL;
-  LK_ENTRY *prev, *curr, *i;
-  bool lock_conversion = false;
-  THREAD_ENTRY *thrd_entry;
-  int rv;
-  LK_ACQUISITION_HISTORY *history;
-  LK_TRAN_LOCK *tran_lock;
-  bool is_instant_duration;
-  int compat1, compat2;
+  int hops;
 
-  if (thread_p == NULL)
+  res_ptr = hash_anchor->hash_next;
+  for (hops = 0; res_ptr != (LK_RES *) NULL
+       && hops < LK_LATCH_FREE_SEARCH_MAX_HOPS; hops++)
     {
-      thread_p = thread_get_thread_entry_info ();
+      if (OID_EQ (&res_ptr->oid, oid))
+	{
+	  ATOMIC_INC_32 (&res_ptr->fastpath_count, 1);
+	  if (OID_EQ (&res_ptr->oid, oid)
+	      && res_ptr->type == LOCK_RESOURCE_CLASS)
+	    {
+	      return res_ptr;
+	    }
+	  lock_fastpath_unpin_resource (res_ptr);
+	  return (LK_RES *) NULL;
+	}
+      res_ptr = res_ptr->hash_next;
     }
 
-  thrd_entry = thread_p;
+  return (LK_RES *) NULL;
+}
+#endif /* SERVER_MODE */
 
-  new_mode = group_mode = old_mode = NULL_LOCK;
-#if defined(LK_DUMP)
-  if (lk_Gl.dump_level >= 1)
+#if defined(SERVER_MODE)
+/*
+ * lock_fastpath_unpin_resource - Release a pin of a lock resource entry
+ *
+ * return: nothing
+ *
+ *   res_ptr(in):
+ *
+ * Note:The caller is not holding any mutex. The resource entry is
+ *     deallocated if the last pin is released and it is empty.
+ */
+static void
+lock_fastpath_unpin_resource (LK_RES * res_ptr)
+{
+  int rv;
+
+  if (ATOMIC_INC_32 (&res_ptr->fastpath_count, -1) > 0)
     {
-      fprintf (stderr,
-	       "LK_DUMP::lk_internal_lock_object()\n"
-	       "  tran(%2d) : oid(%2d|%3d|%3d), class_oid(%2d|%3d|%3d), LOCK(%7s) waitsecs(%d)\n",
-	       tran_index,
-	       oid->volid, oid->pageid, oid->slotid,
-	       class_oid ? class_oid->volid : -1,
-	       class_oid ? class_oid->pageid : -1,
-	       class_oid ? class_oid->slotid : -1,
-	       LOCK_TO_LOCKMODE_STRING (lock), waitsecs);
+      return;
     }
-#endif /* LK_DUMP */
-
-  /* isolation */
-  isolation = logtb_find_isolation (tran_index);
-
-  /* initialize */
-  *entry_addr_ptr = (LK_ENTRY *) NULL;
-
-#if defined(SERVER_MODE) && defined(DIAG_DEVEL)
-  SET_DIAG_VALUE (diag_executediag, DIAG_OBJ_TYPE_LOCK_REQUEST, 1,
-		  DIAG_VAL_SETTYPE_INC, NULL);
-#endif /* SERVER_MODE && DIAG_DEVEL */
-
-  /* get current locking phase */
-  tran_lock = &lk_Gl.tran_lock_table[tran_index];
-  is_instant_duration = tran_lock->is_instant_duration;
-
-start:
 
-  if (class_oid != NULL && !OID_IS_ROOTOID (class_oid))
+  MUTEX_LOCK (rv, res_ptr->res_mutex);
+  if (res_ptr->fastpath_count == 0 && !OID_ISNULL (&res_ptr->oid)
+      && res_ptr->holder == NULL && res_ptr->waiter == NULL
+      && res_ptr->non2pl == NULL)
     {
-      /* instance lock request */
-      /* 1. do lock escalation if it is needed. */
-      granted =
-	lock_escalate_if_needed (thread_p, class_entry, tran_index, waitsecs);
-      if (granted != LK_GRANTED)
-	{
-	  /* The reason for the lock escalation failure
-	   * - lock timeout, deadlock victim or interrupt
-	   * - shortage of lock resource entries or lock entries
-	   */
-	  return granted;
-	}
-      /* 2. check if an implicit lock has been acquired */
-      if (lock_get_object_lock (class_oid, oid_Root_class_oid, tran_index) >=
-	  lock)
-	{
-	  mnt_lk_re_requested_on_objects (thread_p);	/* monitoring */
-	  return LK_GRANTED;
-	}
+      (void) lock_dealloc_resource (res_ptr);
+    }
+  else
+    {
+      MUTEX_UNLOCK (res_ptr->res_mutex);
     }
+}
+#endif /* SERVER_MODE */
 
-  /* check if the lockable object is in object lock table */
-  hash_index = LK_OBJ_LOCK_HASH (oid);
-  hash_anchor = &lk_Gl.obj_hash_table[hash_index];
+#if defined(SERVER_MODE)
+/*
+ * lock_fastpath_lock_class - Grant an intention lock on a class without
+ *                            holding the res_mutex of the class
+ *
+ * return: true if the lock is granted
+ *
+ *   tran_index(in):
+ *   class_oid(in):
+ *   lock(in): IS_LOCK or IX_LOCK
+ *   entry_addr_ptr(out):
+ *   class_entry(in): root class lock entry
+ *
+ * Note:The lock is granted when the class is already in the lock table,
+ *     all the holders and waiters of the class are intention locks and no
+ *     stronger lock is requested in the strong slot of the class. The lock
+ *     entry is kept only in the class hold list of the transaction and it
+ *     pins the resource entry of the class. The strong slot is checked
+ *     while holding the hold_mutex, which a strong requester holds while it
+ *     moves the entry into the lock table (see lock_fastpath_transfer).
+ *
+ *     Lock requests which need the lock acquisition history or the manual
+ *     duration locks are not granted here.
+ */
+static bool
+lock_fastpath_lock_class (THREAD_ENTRY * thread_p, int tran_index,
+			  const OID * class_oid, LOCK lock,
+			  LK_ENTRY ** entry_addr_ptr, LK_ENTRY * class_entry)
+{
+  TRAN_ISOLATION isolation;
+  LK_TRAN_LOCK *tran_lock;
+  unsigned int hash_index;
+  int *strong_count;
+  LK_RES *res_ptr;
+  LK_ENTRY *entry_ptr, *new_entry;
+  LOCK old_mode;
+  int rv;
 
-  /* hold hash_mutex */
-  MUTEX_LOCK (rv, hash_anchor->hash_mutex);
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  if (tran_lock->is_instant_duration)
+    {
+      return false;
+    }
 
-  /* find the lockable object in the hash chain */
-  res_ptr = hash_anchor->hash_next;
-  for (; res_ptr != (LK_RES *) NULL; res_ptr = res_ptr->hash_next)
+  isolation = logtb_find_isolation (tran_index);
+  if (isolation == TRAN_REP_CLASS_COMMIT_INSTANCE
+      || isolation == TRAN_COMMIT_CLASS_COMMIT_INSTANCE
+      || isolation == TRAN_COMMIT_CLASS_UNCOMMIT_INSTANCE)
     {
-      if (OID_EQ (&res_ptr->oid, oid))
+      return false;
+    }
+
+  hash_index = LK_OBJ_LOCK_HASH (class_oid);
+  strong_count =
+    &lk_Gl.fastpath_strong_count[LK_FASTPATH_STRONG_SLOT (hash_index)];
+  if (*strong_count > 0)
+    {
+      return false;
+    }
+
+  /* the first lock on the class is granted in the lock table */
+  res_ptr = lock_fastpath_pin_resource (&lk_Gl.obj_hash_table[hash_index],
+					class_oid);
+  if (res_ptr == (LK_RES *) NULL)
+    {
+      return false;
+    }
+
+  new_entry = lock_alloc_entry ();
+  if (new_entry == (LK_ENTRY *) NULL)
+    {
+      lock_fastpath_unpin_resource (res_ptr);
+      return false;
+    }
+
+  MUTEX_LOCK (rv, tran_lock->hold_mutex);
+
+  if (*strong_count > 0
+      || !LK_IS_WEAK_CLASS_MODE (res_ptr->total_holders_mode)
+      || !LK_IS_WEAK_CLASS_MODE (res_ptr->total_waiters_mode))
+    {
+      goto not_granted;
+    }
+
+  for (entry_ptr = tran_lock->class_hold_list; entry_ptr != NULL;
+       entry_ptr = entry_ptr->tran_next)
+    {
+      if (entry_ptr->res_head == res_ptr)
 	{
 	  break;
 	}
     }
 
-  if (res_ptr == (LK_RES *) NULL)
+  if (entry_ptr != (LK_ENTRY *) NULL)
     {
-      /* the lockable object is NOT in the hash chain */
-      /* the lock request can be granted. */
-
-      /* allocate a lock resource entry */
-      res_ptr = lock_alloc_resource ();
-      if (res_ptr == (LK_RES *) NULL)
+      if (entry_ptr->fastpath == false)
 	{
-	  MUTEX_UNLOCK (hash_anchor->hash_mutex);
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ALLOC_RESOURCE,
-		  1, "lock resource entry");
-	  return LK_NOTGRANTED_DUE_ERROR;
+	  /* the lock is kept in the lock table */
+	  goto not_granted;
 	}
-      /* initialize the lock resource entry */
-      LK_INIT_RES_ALLOCATED (res_ptr, oid, class_oid, NULL_LOCK);
 
-      /* hold res_mutex */
-      MUTEX_LOCK (rv, res_ptr->res_mutex);
+      /* lock conversion of my fast path lock; it keeps its own pin */
+      old_mode = entry_ptr->granted_mode;
+      entry_ptr->granted_mode = lock_Conv[lock][old_mode];
+      entry_ptr->count += 1;
+      MUTEX_UNLOCK (tran_lock->hold_mutex);
 
-      /* Note: I am holding hash_mutex and res_mutex. */
-      if (LK_NON2PL_LOCK_REQUEST (res_ptr, isolation, lock))
+      lock_free_entry (new_entry);
+      lock_fastpath_unpin_resource (res_ptr);
+
+      if (entry_ptr->granted_mode != old_mode)
 	{
-	  /* It might be requested by clients */
-	  entry_ptr = lock_add_non2pl_lock (res_ptr, tran_index, lock);
-	  if (entry_ptr == (LK_ENTRY *) NULL)
-	    {
-	      MUTEX_UNLOCK (res_ptr->res_mutex);
-	      MUTEX_UNLOCK (hash_anchor->hash_mutex);
-	      lock_free_resource (res_ptr);
-	      return LK_NOTGRANTED_DUE_ERROR;
-	    }
+	  mnt_lk_converted_on_objects (thread_p);
 	}
       else
 	{
-	  /* allocate a lock entry */
-	  entry_ptr = lock_alloc_entry ();
-	  if (entry_ptr == (LK_ENTRY *) NULL)
-	    {
-	      MUTEX_UNLOCK (res_ptr->res_mutex);
-	      MUTEX_UNLOCK (hash_anchor->hash_mutex);
-	      lock_free_resource (res_ptr);
-	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ALLOC_RESOURCE,
-		      1, "lock heap entry");
-	      return LK_NOTGRANTED_DUE_ERROR;
-	    }
-	  /* initialize the lock entry as granted state */
-	  LK_INIT_ENTRY_GRANTED (entry_ptr, tran_index, res_ptr, lock);
-	  if (is_instant_duration)
-	    {
-	      entry_ptr->mlk_count++;
-	    }
-
-	  /* add the lock entry into the holder list */
-	  res_ptr->holder = entry_ptr;
+	  mnt_lk_re_requested_on_objects (thread_p);
+	}
+      *entry_addr_ptr = entry_ptr;
+      return true;
+    }
 
-	  /* to manage granules */
-	  entry_ptr->class_entry = class_entry;
-	  if (class_entry)
-	    {
-	      class_entry->ngranules++;
-	    }
+  LK_INIT_ENTRY_GRANTED (new_entry, tran_index, res_ptr, lock);
+  new_entry->thrd_entry = thread_p;
+  new_entry->fastpath = true;
 
-	  /* add the lock entry into the transaction hold list */
-	  lock_insert_into_tran_hold_list (entry_ptr);
+  /* to manage granules */
+  new_entry->class_entry = class_entry;
+  if (class_entry)
+    {
+      class_entry->ngranules++;
+    }
 
-	  res_ptr->total_holders_mode = lock;
+  /* add the lock entry into the transaction hold list */
+  new_entry->tran_next = tran_lock->class_hold_list;
+  tran_lock->class_hold_list = new_entry;
+  tran_lock->class_hold_count += 1;
 
-	  /* Record number of acquired locks */
-	  mnt_lk_acquired_on_objects (thread_p);
-#if defined(LK_TRACE_OBJECT)
-	  LK_MSG_LOCK_ACQUIRED (entry_ptr);
-#endif /* LK_TRACE_OBJECT */
+  MUTEX_UNLOCK (tran_lock->hold_mutex);
 
-	  if (NEED_LOCK_ACQUISITION_HISTORY (isolation, entry_ptr))
-	    {
-	      history = (LK_ACQUISITION_HISTORY *)
-		malloc (sizeof (LK_ACQUISITION_HISTORY));
-	      if (history == NULL)
-		{
-		  MUTEX_UNLOCK (res_ptr->res_mutex);
-		  MUTEX_UNLOCK (hash_anchor->hash_mutex);
-		  return LK_NOTGRANTED_DUE_ERROR;
-		}
+  /* Record number of acquired locks */
+  mnt_lk_acquired_on_objects (thread_p);
 
-	      RECORD_LOCK_ACQUISITION_HISTORY (entry_ptr, history, lock);
-	    }
-	}
+  *entry_addr_ptr = new_entry;
+  return true;
 
-      /* connect the lock resource entry into the hash chain */
-      res_ptr->hash_next = hash_anchor->hash_next;
-      hash_anchor->hash_next = res_ptr;
+not_granted:
+  MUTEX_UNLOCK (tran_lock->hold_mutex);
+  lock_free_entry (new_entry);
+  lock_fastpath_unpin_resource (res_ptr);
+  return false;
+}
+#endif /* SERVER_MODE */
 
-      /* release all mutexes */
-      MUTEX_UNLOCK (res_ptr->res_mutex);
-      MUTEX_UNLOCK (hash_anchor->hash_mutex);
+#if defined(SERVER_MODE)
+/*
+ * lock_fastpath_unlock_class - Release a fast path lock on a class
+ *
+ * return: true if released, false if the lock is in the lock table
+ *
+ *   entry_ptr(in): class lock entry of the current transaction
+ *
+ * Note:The caller is not holding any mutex.
+ */
+static bool
+lock_fastpath_unlock_class (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr)
+{
+  LK_TRAN_LOCK *tran_lock;
+  LK_RES *res_ptr;
+  int rv;
 
-      *entry_addr_ptr = entry_ptr;
-      return LK_GRANTED;
+  tran_lock = &lk_Gl.tran_lock_table[entry_ptr->tran_index];
+  MUTEX_LOCK (rv, tran_lock->hold_mutex);
+  if (entry_ptr->fastpath == false)
+    {
+      /* a strong requester has moved it into the lock table */
+      MUTEX_UNLOCK (tran_lock->hold_mutex);
+      return false;
     }
+  entry_ptr->fastpath = false;
+  MUTEX_UNLOCK (tran_lock->hold_mutex);
 
-  /* the lockable object exists in the hash chain
-   * So, check whether I am a holder of the object.
+  /* the entry is neither fast path nor in the holder list, so that it is
+   * not seen by lock_fastpath_transfer from now on.
    */
+  res_ptr = entry_ptr->res_head;
+  (void) lock_delete_from_tran_hold_list (entry_ptr);
 
-  /* hold lock resource mutex */
-  MUTEX_LOCK (rv, res_ptr->res_mutex);
-  /* release lock hash mutex */
-  MUTEX_UNLOCK (hash_anchor->hash_mutex);
+  /* to manage granules */
+  if (entry_ptr->class_entry)
+    {
+      entry_ptr->class_entry->ngranules--;
+    }
+  lock_free_entry (entry_ptr);
 
-  /* Note: I am holding res_mutex only */
+  lock_fastpath_unpin_resource (res_ptr);
 
-  /* find the lock entry of current transaction */
-  entry_ptr = res_ptr->holder;
-  while (entry_ptr != (LK_ENTRY *) NULL)
+  return true;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_fastpath_transfer - Move fast path locks on a class into the lock
+ *                          table
+ *
+ * return: nothing
+ *
+ *   res_ptr(in): resource entry of the class
+ *   tran_index(in): transaction whose lock is moved, or NULL_TRAN_INDEX
+ *                   for all transactions
+ *
+ * Note:The caller is holding the res_mutex. The moved entries are granted
+ *     holders of the resource and are seen by lock conflict checks and by
+ *     the deadlock detector.
+ */
+static void
+lock_fastpath_transfer (LK_RES * res_ptr, int tran_index)
+{
+  LK_TRAN_LOCK *tran_lock;
+  LK_ENTRY *entry_ptr;
+  int i, first, last;
+  int rv;
+
+  if (res_ptr->fastpath_count <= 0)
     {
-      if (entry_ptr->tran_index == tran_index)
-	{
-	  break;
-	}
-      entry_ptr = entry_ptr->next;
+      return;
     }
 
-  if (entry_ptr == NULL)
+  if (tran_index == NULL_TRAN_INDEX)
     {
-      /* The object exists in the hash chain &
-       * I am not a lock holder of the lockable object.
-       */
-      /* 1. I am not a holder & my request can be granted. */
-      assert (lock >= NULL_LOCK && res_ptr->total_waiters_mode >= NULL_LOCK
-	      && res_ptr->total_holders_mode >= NULL_LOCK);
-      compat1 = lock_Comp[lock][res_ptr->total_waiters_mode];
-      compat2 = lock_Comp[lock][res_ptr->total_holders_mode];
-      assert (compat1 != DB_NA && compat2 != DB_NA);
+      first = 0;
+      last = lk_Gl.num_trans - 1;
+    }
+  else
+    {
+      first = last = tran_index;
+    }
 
-      if (compat1 == true && compat2 == true)
+  for (i = first; i <= last && res_ptr->fastpath_count > 0; i++)
+    {
+      tran_lock = &lk_Gl.tran_lock_table[i];
+      MUTEX_LOCK (rv, tran_lock->hold_mutex);
+
+      for (entry_ptr = tran_lock->class_hold_list; entry_ptr != NULL;
+	   entry_ptr = entry_ptr->tran_next)
 	{
-	  if (LK_NON2PL_LOCK_REQUEST (res_ptr, isolation, lock))
+	  if (entry_ptr->fastpath && entry_ptr->res_head == res_ptr)
 	    {
-	      entry_ptr = lock_add_non2pl_lock (res_ptr, tran_index, lock);
-	      if (entry_ptr == (LK_ENTRY *) NULL)
-		{
-		  MUTEX_UNLOCK (res_ptr->res_mutex);
-		  return LK_NOTGRANTED_DUE_ERROR;
-		}
-	      MUTEX_UNLOCK (res_ptr->res_mutex);
-	      *entry_addr_ptr = entry_ptr;
-	      return LK_GRANTED;
+	      break;
 	    }
+	}
 
-	  /* allocate a lock entry */
-	  entry_ptr = lock_alloc_entry ();
-	  if (entry_ptr == (LK_ENTRY *) NULL)
-	    {
-	      MUTEX_UNLOCK (res_ptr->res_mutex);
-	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ALLOC_RESOURCE,
-		      1, "lock heap entry");
-	      return LK_NOTGRANTED_DUE_ERROR;
-	    }
-	  /* initialize the lock entry as granted state */
-	  LK_INIT_ENTRY_GRANTED (entry_ptr, tran_index, res_ptr, lock);
-	  if (is_instant_duration)
-	    {
-	      entry_ptr->mlk_count++;
-	    }
-	  /* to manage granules */
-	  entry_ptr->class_entry = class_entry;
-	  if (class_entry)
-	    {
-	      class_entry->ngranules++;
-	    }
-
-	  /* add the lock entry into the holder list */
+      if (entry_ptr != (LK_ENTRY *) NULL)
+	{
+	  entry_ptr->fastpath = false;
 	  lock_position_holder_entry (res_ptr, entry_ptr);
 
-	  /* change total_holders_mode (total mode of holder list) */
-	  assert (lock >= NULL_LOCK
+	  assert (entry_ptr->granted_mode >= NULL_LOCK
 		  && res_ptr->total_holders_mode >= NULL_LOCK);
 	  res_ptr->total_holders_mode =
-	    lock_Conv[lock][res_ptr->total_holders_mode];
+	    lock_Conv[entry_ptr->granted_mode][res_ptr->total_holders_mode];
 	  assert (res_ptr->total_holders_mode != NA_LOCK);
 
-	  /* add the lock entry into the transaction hold list */
-	  lock_insert_into_tran_hold_list (entry_ptr);
+	  /* the pin is replaced by the holder entry */
+	  ATOMIC_INC_32 (&res_ptr->fastpath_count, -1);
+	}
 
-	  lock_update_non2pl_list (res_ptr, tran_index, lock);
+      MUTEX_UNLOCK (tran_lock->hold_mutex);
+    }
+}
+#endif /* SERVER_MODE */
 
-	  /* Record number of acquired locks */
-	  mnt_lk_acquired_on_objects (thread_p);
-#if defined(LK_TRACE_OBJECT)
-	  LK_MSG_LOCK_ACQUIRED (entry_ptr);
-#endif /* LK_TRACE_OBJECT */
+#if defined(SERVER_MODE)
+/*
+ * lock_internal_perform_lock_object - Performs actual object lock operation
+ *
+ * return: one of following values
+ *              LK_GRANTED
+ *              LK_NOTGRANTED_DUE_ABORTED
+ *              LK_NOTGRANTED_DUE_TIMEOUT
+ *              LK_NOTGRANTED_DUE_ERROR
+ *
+ *   tran_index(in):
+ *   oid(in):
+ *   class_oid(in):
+ *   lock(in):
+ *   waitsecs(in):
+ *   entry_addr_ptr(in):
+ *   class_entry(in):
+ *
+ * Note:IS and IX locks on a class are granted by the fast path if possible.
+ *     A stronger class lock request closes the fast path of its strong
+ *     slot and moves the fast path locks on the class into the lock table
+ *     before it is performed, so that it waits for them in the lock table.
+ *     Other lock requests are performed in the lock table.
+ */
+static int
+lock_internal_perform_lock_object (THREAD_ENTRY * thread_p, int tran_index,
+				   const OID * oid, const OID * class_oid,
+				   LOCK lock, int waitsecs,
+				   LK_ENTRY ** entry_addr_ptr,
+				   LK_ENTRY * class_entry)
+{
+  unsigned int hash_index;
+  LK_HASH *hash_anchor;
+  LK_RES *res_ptr;
+  LK_ENTRY *own_entry;
+  int *strong_count;
+  int granted;
+  int rv;
 
-	  if (NEED_LOCK_ACQUISITION_HISTORY (isolation, entry_ptr))
-	    {
-	      history = (LK_ACQUISITION_HISTORY *)
-		malloc (sizeof (LK_ACQUISITION_HISTORY));
-	      if (history == NULL)
-		{
-		  MUTEX_UNLOCK (res_ptr->res_mutex);
-		  return LK_NOTGRANTED_DUE_ERROR;
-		}
+  if (OID_IS_ROOTOID (oid)
+      || (class_oid != NULL && !OID_IS_ROOTOID (class_oid)))
+    {
+      /* root class lock or instance lock */
+      return lock_internal_lock_object_in_table (thread_p, tran_index, oid,
+						 class_oid, lock, waitsecs,
+						 entry_addr_ptr, class_entry);
+    }
 
-	      RECORD_LOCK_ACQUISITION_HISTORY (entry_ptr, history, lock);
-	    }
+  if (thread_p == NULL)
+    {
+      thread_p = thread_get_thread_entry_info ();
+    }
 
-	  MUTEX_UNLOCK (res_ptr->res_mutex);
-	  *entry_addr_ptr = entry_ptr;
+  if (lock == IS_LOCK || lock == IX_LOCK)
+    {
+      *entry_addr_ptr = (LK_ENTRY *) NULL;
+      if (lock_fastpath_lock_class (thread_p, tran_index, oid, lock,
+				    entry_addr_ptr, class_entry) == true)
+	{
 	  return LK_GRANTED;
 	}
 
-      /* 2. I am not a holder & my request cannot be granted. */
-      if (LK_NON2PL_LOCK_REQUEST (res_ptr, isolation, lock))
+      /* my fast path lock on the class must be in the lock table first */
+      own_entry = lock_find_class_entry (tran_index, oid);
+      if (own_entry != (LK_ENTRY *) NULL && own_entry->fastpath)
 	{
-	  entry_ptr = lock_add_non2pl_lock (res_ptr, tran_index,
-					    INCON_NON_TWO_PHASE_LOCK);
-	  if (entry_ptr == (LK_ENTRY *) NULL)
-	    {
-	      MUTEX_UNLOCK (res_ptr->res_mutex);
-	      return LK_NOTGRANTED_DUE_ERROR;
-	    }
-	  else
-	    {
-	      MUTEX_UNLOCK (res_ptr->res_mutex);
-	      *entry_addr_ptr = entry_ptr;
-	      return LK_GRANTED;
-	    }
+	  res_ptr = own_entry->res_head;
+	  MUTEX_LOCK (rv, res_ptr->res_mutex);
+	  lock_fastpath_transfer (res_ptr, tran_index);
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
 	}
 
-      if (waitsecs == LK_ZERO_WAIT || waitsecs == LK_FORCE_ZERO_WAIT)
-	{
-	  MUTEX_UNLOCK (res_ptr->res_mutex);
-	  if (waitsecs == LK_ZERO_WAIT)
-	    {
-	      if (entry_ptr == NULL)
-		{
-		  entry_ptr = lock_alloc_entry ();
-		  if (entry_ptr == (LK_ENTRY *) NULL)
-		    {
-		      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
-			      ER_LK_ALLOC_RESOURCE, 1, "lock heap entry");
-		      return LK_NOTGRANTED_DUE_ERROR;
-		    }
-		  LK_INIT_ENTRY_BLOCKED (entry_ptr, thread_p, tran_index,
-					 res_ptr, lock);
-		  if (is_instant_duration
-		      /* && lock_Comp[lock][NULL_LOCK] == true */ )
-		    {
-		      entry_ptr->mlk_count++;
-		    }
-		}
-	      (void) lock_set_error_for_timeout (thread_p, entry_ptr);
+      return lock_internal_lock_object_in_table (thread_p, tran_index, oid,
+						 class_oid, lock, waitsecs,
+						 entry_addr_ptr, class_entry);
+    }
 
-	      lock_free_entry (entry_ptr);
-	    }
-	  return LK_NOTGRANTED_DUE_TIMEOUT;
-	}
+  hash_index = LK_OBJ_LOCK_HASH (oid);
+  hash_anchor = &lk_Gl.obj_hash_table[hash_index];
+  strong_count =
+    &lk_Gl.fastpath_strong_count[LK_FASTPATH_STRONG_SLOT (hash_index)];
 
-      /* check if another thread is waiting for the same resource
-       */
-      wait_entry_ptr = res_ptr->waiter;
-      while (wait_entry_ptr != (LK_ENTRY *) NULL)
+  /* close the fast path of the slot */
+  ATOMIC_INC_32 (strong_count, 1);
+
+  /* move the fast path locks on the class into the lock table */
+  res_ptr = lock_find_resource_latch_free (hash_anchor, oid);
+  if (res_ptr == (LK_RES *) NULL)
+    {
+      MUTEX_LOCK (rv, hash_anchor->hash_mutex);
+      for (res_ptr = hash_anchor->hash_next; res_ptr != (LK_RES *) NULL;
+	   res_ptr = res_ptr->hash_next)
 	{
-	  if (wait_entry_ptr->tran_index == tran_index)
+	  if (OID_EQ (&res_ptr->oid, oid))
 	    {
+	      MUTEX_LOCK (rv, res_ptr->res_mutex);
 	      break;
 	    }
-	  wait_entry_ptr = wait_entry_ptr->next;
 	}
+      MUTEX_UNLOCK (hash_anchor->hash_mutex);
+    }
+  if (res_ptr != (LK_RES *) NULL)
+    {
+      lock_fastpath_transfer (res_ptr, NULL_TRAN_INDEX);
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+    }
 
-      if (wait_entry_ptr != NULL)
-	{
-	  er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
-		  ER_LK_MANY_LOCK_WAIT_TRAN, 1, tran_index);
-	  thread_lock_entry (thrd_entry);
-	  thread_lock_entry (wait_entry_ptr->thrd_entry);
-	  if (wait_entry_ptr->thrd_entry->lockwait == NULL)
-	    {
-	      /*  */
-	      thread_unlock_entry (wait_entry_ptr->thrd_entry);
-	      thread_unlock_entry (thrd_entry);
-	      MUTEX_UNLOCK (res_ptr->res_mutex);
-	      goto start;
-	    }
-
-	  thrd_entry->tran_next_wait =
-	    wait_entry_ptr->thrd_entry->tran_next_wait;
-	  wait_entry_ptr->thrd_entry->tran_next_wait = thrd_entry;
+  granted = lock_internal_lock_object_in_table (thread_p, tran_index, oid,
+						class_oid, lock, waitsecs,
+						entry_addr_ptr, class_entry);
 
-	  thread_unlock_entry (wait_entry_ptr->thrd_entry);
-	  MUTEX_UNLOCK (res_ptr->res_mutex);
+  /* a granted strong lock keeps the fast path closed by itself */
+  ATOMIC_INC_32 (strong_count, -1);
 
-	  while (1)
-	    {
-	      thread_suspend_wakeup_and_unlock_entry (thrd_entry,
-						      THREAD_LOCK_SUSPENDED);
+  return granted;
+}
+#endif /* SERVER_MODE */
 
-	      if (entry_ptr->thrd_entry->resume_status ==
-		  THREAD_RESUME_DUE_TO_INTERRUPT
-		  && entry_ptr->thrd_entry->interrupted)
-		{
-		  /* In case the shutdown thread wakes me up,
-		   * I keep being suspended and waiting until the lock holder
-		   * wakes me up, because it is too dangerous to continue
-		   * process with a lock not granted.
-		   */
-		  continue;
-		}
-	      else if (entry_ptr->thrd_entry->resume_status !=
-		       THREAD_LOCK_RESUMED)
-		{
-		  assert (0);
-		}
+#if defined(SERVER_MODE)
+/*
+ * lock_internal_lock_object_in_table - Performs object lock operation in
+ *                                      the lock table
+ *
+ * return: one of following values
+ *              LK_GRANTED
+ *              LK_NOTGRANTED_DUE_ABORTED
+ *              LK_NOTGRANTED_DUE_TIMEOUT
+ *              LK_NOTGRANTED_DUE_ERROR
+ *
+ *   tran_index(in):
+ *   oid(in):
+ *   class_oid(in):
+ *   lock(in):
+ *   waitsecs(in):
+ *   entry_addr_ptr(in):
+ *   class_entry(in):
+ *
+ * Note:lock an object whose id is pointed by oid with given lock mode 'lock'.
+ *
+ *     If cond_flag is true and the object has already been locked
+ *     by other transaction, then return LK_NOTGRANTED;
+ *     else this transaction is suspended until it can acquire the lock.
+ */
+static int
+lock_internal_lock_object_in_table (THREAD_ENTRY * thread_p, int tran_index,
+				    const OID * oid, const OID * class_oid,
+				    LOCK lock, int waitsecs,
+				    LK_ENTRY ** entry_addr_ptr,
+				    LK_ENTRY * class_entry)
+{
+  TRAN_ISOLATION isolation;
+  int granted;
+  unsigned int hash_index;
+  LK_HASH *hash_anchor;
+  int ret_val;
+  LOCK group_mode, old_mode, new_mode;	/* lock mode */
+  LK_RES *res_ptr;
+  LK_ENTRY *entry_ptr = (LK_ENTRY *) NULL;
+  LK_ENTRY *wait_entry_ptr = (LK_ENTRY *) NULL;
+  LK_ENTRY *prev, *curr, *i;
+  bool lock_conversion = false;
+  THREAD_ENTRY *thrd_entry;
+  int rv;
+  LK_ACQUISITION_HISTORY *history;
+  LK_TRAN_LOCK *tran_lock;
+  bool is_instant_duration;
+  int compat1, compat2;
 
-	      break;
-	    }
+  if (thread_p == NULL)
+    {
+      thread_p = thread_get_thread_entry_info ();
+    }
 
-	  goto start;
-	}
+  thrd_entry = thread_p;
 
-      /* allocate a lock entry. */
-      entry_ptr = lock_alloc_entry ();
-      if (entry_ptr == (LK_ENTRY *) NULL)
-	{
-	  MUTEX_UNLOCK (res_ptr->res_mutex);
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ALLOC_RESOURCE,
-		  1, "lock heap entry");
-	  return LK_NOTGRANTED_DUE_ERROR;
-	}
-      /* initialize the lock entry as blocked state */
-      LK_INIT_ENTRY_BLOCKED (entry_ptr, thread_p, tran_index, res_ptr, lock);
-      if (is_instant_duration)
-	{
-	  entry_ptr->mlk_count++;
-	}
+  new_mode = group_mode = old_mode = NULL_LOCK;
+#if defined(LK_DUMP)
+  if (lk_Gl.dump_level >= 1)
+    {
+      fprintf (stderr,
+	       "LK_DUMP::lk_internal_lock_object()\n"
+	       "  tran(%2d) : oid(%2d|%3d|%3d), class_oid(%2d|%3d|%3d), LOCK(%7s) waitsecs(%d)\n",
+	       tran_index,
+	       oid->volid, oid->pageid, oid->slotid,
+	       class_oid ? class_oid->volid : -1,
+	       class_oid ? class_oid->pageid : -1,
+	       class_oid ? class_oid->slotid : -1,
+	       LOCK_TO_LOCKMODE_STRING (lock), waitsecs);
+    }
+#endif /* LK_DUMP */
 
-      /* append the lock request at the end of the waiter */
-      prev = (LK_ENTRY *) NULL;
-      for (i = res_ptr->waiter; i != (LK_ENTRY *) NULL;)
-	{
-	  prev = i;
-	  i = i->next;
-	}
-      if (prev == (LK_ENTRY *) NULL)
-	{
-	  res_ptr->waiter = entry_ptr;
-	}
-      else
-	{
-	  prev->next = entry_ptr;
-	}
+  /* isolation */
+  isolation = logtb_find_isolation (tran_index);
 
-      /* change total_waiters_mode (total mode of waiting waiter) */
-      assert (lock >= NULL_LOCK && res_ptr->total_waiters_mode >= NULL_LOCK);
-      res_ptr->total_waiters_mode =
-	lock_Conv[lock][res_ptr->total_waiters_mode];
-      assert (res_ptr->total_waiters_mode != NA_LOCK);
+  /* initialize */
+  *entry_addr_ptr = (LK_ENTRY *) NULL;
 
-      goto blocked;
+#if defined(SERVER_MODE) && defined(DIAG_DEVEL)
+  SET_DIAG_VALUE (diag_executediag, DIAG_OBJ_TYPE_LOCK_REQUEST, 1,
+		  DIAG_VAL_SETTYPE_INC, NULL);
+#endif /* SERVER_MODE && DIAG_DEVEL */
 
-    }				/* end of a new lock request */
+  /* get current locking phase */
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  is_instant_duration = tran_lock->is_instant_duration;
 
-  if (LK_NON2PL_LOCK_REQUEST (res_ptr, isolation, lock))
+start:
+
+  if (class_oid != NULL && !OID_IS_ROOTOID (class_oid))
     {
-      if (entry_ptr->granted_mode == NX_LOCK
-	  || entry_ptr->granted_mode == X_LOCK)
+      /* instance lock request */
+      /* 1. do lock escalation if it is needed. */
+      granted =
+	lock_escalate_if_needed (thread_p, class_entry, tran_index, waitsecs);
+      if (granted != LK_GRANTED)
 	{
-	  /* The conversioned mode might be the same with the current mode. */
-	  /* The only exception case is followings.
-	     When the current mode is NX_LOCK and thr request mode is U_LOCK,
-	     the conversioned mode will be X_LOCK.
-	     In this case, however, the intention of U_LOCK of Uncommitted Read
-	     isolation is only having the intent of READ.
-	     Therefore, the U_LOCK request of this case can be granted
-	     without acquiring it.
+	  /* The reason for the lock escalation failure
+	   * - lock timeout, deadlock victim or interrupt
+	   * - shortage of lock resource entries or lock entries
 	   */
-	  MUTEX_UNLOCK (res_ptr->res_mutex);
+	  return granted;
+	}
+      /* 2. check if an implicit lock has been acquired */
+      if (lock_get_object_lock (class_oid, oid_Root_class_oid, tran_index) >=
+	  lock)
+	{
 	  mnt_lk_re_requested_on_objects (thread_p);	/* monitoring */
-	  *entry_addr_ptr = entry_ptr;
 	  return LK_GRANTED;
 	}
-      /* entry_ptr->granted_mode != NX_LOCK &&
-         entry_ptr->granted_mode != X_LOCK
-       */
-      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE, ER_LK_FAULT_GRANTED_MODE, 5,
-	      res_ptr->oid.volid, res_ptr->oid.pageid, res_ptr->oid.slotid,
-	      entry_ptr->tran_index,
-	      LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode));
     }
 
-  /* The object exists in the hash chain &
-   * I am a lock holder of the lockable object.
-   */
-  lock_conversion = true;
-  old_mode = entry_ptr->granted_mode;
-  assert (lock >= NULL_LOCK && entry_ptr->granted_mode >= NULL_LOCK);
-  new_mode = lock_Conv[lock][entry_ptr->granted_mode];
-  assert (new_mode != NA_LOCK);
+  /* check if the lockable object is in object lock table */
+  hash_index = LK_OBJ_LOCK_HASH (oid);
+  hash_anchor = &lk_Gl.obj_hash_table[hash_index];
 
-  if (new_mode == entry_ptr->granted_mode)
+  /* try to find the lockable object without holding hash_mutex */
+  res_ptr = lock_find_resource_latch_free (hash_anchor, oid);
+  if (res_ptr != (LK_RES *) NULL)
     {
-      /* a request with either a less exclusive or an equal mode of lock */
-      entry_ptr->count += 1;
-      if (is_instant_duration)
-	{
-	  compat1 = lock_Comp[lock][entry_ptr->granted_mode];
-	  assert (compat1 != DB_NA);
+      goto res_mutex_held;
+    }
 
-	  if ((lock >= IX_LOCK
-	       && (entry_ptr->mlk_count == 0
-		   && entry_ptr->granted_mode >= IX_LOCK)) && compat1 != true)
-	    {
-	      /* if the lock is already aquired with incompatible mode by current transaction,
-	         remove instant instance locks */
-	      lock_stop_instant_lock_mode (thread_p, tran_index, false);
-	    }
-	  else
-	    {
-	      entry_ptr->mlk_count++;
-	    }
-	}
+  /* hold hash_mutex */
+  MUTEX_LOCK (rv, hash_anchor->hash_mutex);
 
-      if (NEED_LOCK_ACQUISITION_HISTORY (isolation, entry_ptr))
+  /* find the lockable object in the hash chain */
+  res_ptr = hash_anchor->hash_next;
+  for (; res_ptr != (LK_RES *) NULL; res_ptr = res_ptr->hash_next)
+    {
+      if (OID_EQ (&res_ptr->oid, oid))
 	{
-	  history = (LK_ACQUISITION_HISTORY *)
-	    malloc (sizeof (LK_ACQUISITION_HISTORY));
-	  if (history == NULL)
-	    {
-	      MUTEX_UNLOCK (res_ptr->res_mutex);
-	      return LK_NOTGRANTED_DUE_ERROR;
-	    }
-
-	  RECORD_LOCK_ACQUISITION_HISTORY (entry_ptr, history, lock);
+	  break;
 	}
-
-      MUTEX_UNLOCK (res_ptr->res_mutex);
-      mnt_lk_re_requested_on_objects (thread_p);	/* monitoring */
-      *entry_addr_ptr = entry_ptr;
-      return LK_GRANTED;
     }
 
-  /* check the compatibility with other holders' granted mode */
-  group_mode = NULL_LOCK;
-  for (i = res_ptr->holder; i != (LK_ENTRY *) NULL; i = i->next)
+  if (res_ptr == (LK_RES *) NULL)
     {
-      if (i != entry_ptr)
+      /* the lockable object is NOT in the hash chain */
+      /* the lock request can be granted. */
+
+      /* allocate a lock resource entry */
+      res_ptr = lock_alloc_resource ();
+      if (res_ptr == (LK_RES *) NULL)
 	{
-	  assert (i->granted_mode >= NULL_LOCK && group_mode >= NULL_LOCK);
-	  group_mode = lock_Conv[i->granted_mode][group_mode];
-	  assert (group_mode != NA_LOCK);
+	  MUTEX_UNLOCK (hash_anchor->hash_mutex);
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ALLOC_RESOURCE,
+		  1, "lock resource entry");
+	  return LK_NOTGRANTED_DUE_ERROR;
 	}
-    }
+      /* hold res_mutex before the OID is set (see
+       * lock_find_resource_latch_free) */
+      MUTEX_LOCK (rv, res_ptr->res_mutex);
 
-  assert (new_mode >= NULL_LOCK && group_mode >= NULL_LOCK);
-  compat1 = lock_Comp[new_mode][group_mode];
-  assert (compat1 != DB_NA);
+      /* initialize the lock resource entry */
+      LK_INIT_RES_ALLOCATED (res_ptr, oid, class_oid, NULL_LOCK);
 
-  if (compat1 == true)
-    {
-      if (NEED_LOCK_ACQUISITION_HISTORY (isolation, entry_ptr))
+      /* Note: I am holding hash_mutex and res_mutex. */
+      if (LK_NON2PL_LOCK_REQUEST (res_ptr, isolation, lock))
 	{
-	  history = (LK_ACQUISITION_HISTORY *)
-	    malloc (sizeof (LK_ACQUISITION_HISTORY));
-	  if (history == NULL)
+	  /* It might be requested by clients */
+	  entry_ptr = lock_add_non2pl_lock (res_ptr, tran_index, lock);
+	  if (entry_ptr == (LK_ENTRY *) NULL)
 	    {
-	      MUTEX_UNLOCK (res_ptr->res_mutex);
+	      lock_abandon_new_resource (hash_anchor, res_ptr);
 	      return LK_NOTGRANTED_DUE_ERROR;
 	    }
-
-	  RECORD_LOCK_ACQUISITION_HISTORY (entry_ptr, history, lock);
 	}
+      else
+	{
+	  /* allocate a lock entry */
+	  entry_ptr = lock_alloc_entry ();
+	  if (entry_ptr == (LK_ENTRY *) NULL)
+	    {
+	      lock_abandon_new_resource (hash_anchor, res_ptr);
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ALLOC_RESOURCE,
+		      1, "lock heap entry");
+	      return LK_NOTGRANTED_DUE_ERROR;
+	    }
+	  /* initialize the lock entry as granted state */
+	  LK_INIT_ENTRY_GRANTED (entry_ptr, tran_index, res_ptr, lock);
+	  if (is_instant_duration)
+	    {
+	      entry_ptr->mlk_count++;
+	    }
 
-      entry_ptr->granted_mode = new_mode;
-      entry_ptr->count += 1;
+	  /* add the lock entry into the holder list */
+	  res_ptr->holder = entry_ptr;
 
-      assert (lock >= NULL_LOCK && res_ptr->total_holders_mode >= NULL_LOCK);
-      res_ptr->total_holders_mode =
-	lock_Conv[lock][res_ptr->total_holders_mode];
-      assert (res_ptr->total_holders_mode != NA_LOCK);
+	  /* to manage granules */
+	  entry_ptr->class_entry = class_entry;
+	  if (class_entry)
+	    {
+	      class_entry->ngranules++;
+	    }
 
-      lock_update_non2pl_list (res_ptr, tran_index, lock);
-      MUTEX_UNLOCK (res_ptr->res_mutex);
+	  /* add the lock entry into the transaction hold list */
+	  lock_insert_into_tran_hold_list (entry_ptr);
 
-      goto lock_conversion_treatement;
-    }
+	  res_ptr->total_holders_mode = lock;
 
-  /* I am a holder & my request cannot be granted. */
-  if (waitsecs == LK_ZERO_WAIT || waitsecs == LK_FORCE_ZERO_WAIT)
-    {
-      MUTEX_UNLOCK (res_ptr->res_mutex);
-      if (waitsecs == LK_ZERO_WAIT)
-	{
-	  (void) lock_set_error_for_timeout (thread_p, entry_ptr);
+	  /* Record number of acquired locks */
+	  mnt_lk_acquired_on_objects (thread_p);
+#if defined(LK_TRACE_OBJECT)
+	  LK_MSG_LOCK_ACQUIRED (entry_ptr);
+#endif /* LK_TRACE_OBJECT */
+
+	  if (NEED_LOCK_ACQUISITION_HISTORY (isolation, entry_ptr))
+	    {
+	      history = (LK_ACQUISITION_HISTORY *)
+		malloc (sizeof (LK_ACQUISITION_HISTORY));
+	      if (history == NULL)
+		{
+		  MUTEX_UNLOCK (res_ptr->res_mutex);
+		  MUTEX_UNLOCK (hash_anchor->hash_mutex);
+		  return LK_NOTGRANTED_DUE_ERROR;
+		}
+
+	      RECORD_LOCK_ACQUISITION_HISTORY (entry_ptr, history, lock);
+	    }
 	}
-      return LK_NOTGRANTED_DUE_TIMEOUT;
-    }
 
-  /* Upgrader Positioning Rule (UPR) */
-
-  /* check if another thread is waiting for the same resource
-   */
-  if (entry_ptr->blocked_mode != NULL_LOCK)
-    {
-      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE, ER_LK_MANY_LOCK_WAIT_TRAN,
-	      1, tran_index);
-      thread_lock_entry (thrd_entry);
-      thread_lock_entry (entry_ptr->thrd_entry);
-
-      if (entry_ptr->thrd_entry->lockwait == NULL)
-	{
-	  thread_unlock_entry (entry_ptr->thrd_entry);
-	  thread_unlock_entry (thrd_entry);
-	  MUTEX_UNLOCK (res_ptr->res_mutex);
-	  goto start;
-	}
-
-      thrd_entry->tran_next_wait = entry_ptr->thrd_entry->tran_next_wait;
-      entry_ptr->thrd_entry->tran_next_wait = thrd_entry;
-
-      thread_unlock_entry (entry_ptr->thrd_entry);
+      /* connect the lock resource entry into the hash chain */
+      res_ptr->hash_next = hash_anchor->hash_next;
+      MEMORY_BARRIER ();
+      hash_anchor->hash_next = res_ptr;
 
+      /* release all mutexes */
       MUTEX_UNLOCK (res_ptr->res_mutex);
+      MUTEX_UNLOCK (hash_anchor->hash_mutex);
 
-      thread_suspend_wakeup_and_unlock_entry (thrd_entry,
-					      THREAD_LOCK_SUSPENDED);
-      if (thrd_entry->resume_status == THREAD_RESUME_DUE_TO_INTERRUPT)
-	{
-	  /* a shutdown thread wakes me up */
-	  return LK_NOTGRANTED_DUE_ERROR;
-	}
-      else if (thrd_entry->resume_status != THREAD_LOCK_RESUMED)
-	{
-	  /* wake up with other reason */
-	  assert (0);
-
-	  return LK_NOTGRANTED_DUE_ERROR;
-	}
-      else
-	{
-	  assert (thrd_entry->resume_status == THREAD_LOCK_RESUMED);
-	}
-
-      goto start;
-    }
-
-  entry_ptr->blocked_mode = new_mode;
-  entry_ptr->count += 1;
-  entry_ptr->thrd_entry = thread_p;
-
-  assert (lock >= NULL_LOCK && res_ptr->total_holders_mode >= NULL_LOCK);
-  res_ptr->total_holders_mode = lock_Conv[lock][res_ptr->total_holders_mode];
-  assert (res_ptr->total_holders_mode != NA_LOCK);
-
-  /* remove the lock entry from the holder list */
-  prev = (LK_ENTRY *) NULL;
-  curr = res_ptr->holder;
-  while ((curr != (LK_ENTRY *) NULL) && (curr != entry_ptr))
-    {
-      prev = curr;
-      curr = curr->next;
-    }
-  if (prev == (LK_ENTRY *) NULL)
-    {
-      res_ptr->holder = entry_ptr->next;
-    }
-  else
-    {
-      prev->next = entry_ptr->next;
+      *entry_addr_ptr = entry_ptr;
+      return LK_GRANTED;
     }
 
-  /* position the lock entry in the holder list according to UPR */
-  lock_position_holder_entry (res_ptr, entry_ptr);
+  /* the lockable object exists in the hash chain
+   * So, check whether I am a holder of the object.
+   */
 
-blocked:
+  /* hold lock resource mutex */
+  MUTEX_LOCK (rv, res_ptr->res_mutex);
+  /* release lock hash mutex */
+  MUTEX_UNLOCK (hash_anchor->hash_mutex);
 
-  /* LK_CANWAIT(waitsecs) : waitsecs > 0 */
-  mnt_lk_waited_on_objects (thread_p);
-#if defined(LK_TRACE_OBJECT)
-  LK_MSG_LOCK_WAITFOR (entry_ptr);
-#endif /* LK_TRACE_OBJECT */
+res_mutex_held:
+  /* Note: I am holding res_mutex only */
 
-  (void) thread_lock_entry (entry_ptr->thrd_entry);
-  MUTEX_UNLOCK (res_ptr->res_mutex);
-  ret_val = lock_suspend (thread_p, entry_ptr, waitsecs);
-  if (ret_val != LOCK_RESUMED)
+  /* find the lock entry of current transaction */
+  entry_ptr = res_ptr->holder;
+  while (entry_ptr != (LK_ENTRY *) NULL)
     {
-      /* Following three cases are possible.
-       * 1. lock timeout 2. deadlock victim  3. interrupt
-       * In any case, current thread must remove the wait info.
-       */
-      lock_internal_perform_unlock_object (thread_p, entry_ptr, false, false);
-
-      if (ret_val == LOCK_RESUMED_ABORTED)
-	{
-	  return LK_NOTGRANTED_DUE_ABORTED;
-	}
-      else if (ret_val == LOCK_RESUMED_INTERRUPT)
-	{
-	  return LK_NOTGRANTED_DUE_ERROR;
-	}
-      else			/* LOCK_RESUMED_TIMEOUT || LOCK_SUSPENDED */
+      if (entry_ptr->tran_index == tran_index)
 	{
-	  return LK_NOTGRANTED_DUE_TIMEOUT;
+	  break;
 	}
+      entry_ptr = entry_ptr->next;
     }
 
-  if (NEED_LOCK_ACQUISITION_HISTORY (isolation, entry_ptr))
+  if (entry_ptr == NULL)
     {
-      history = (LK_ACQUISITION_HISTORY *)
-	malloc (sizeof (LK_ACQUISITION_HISTORY));
-      if (history == NULL)
-	{
-	  return LK_NOTGRANTED_DUE_ERROR;
-	}
-
-      RECORD_LOCK_ACQUISITION_HISTORY (entry_ptr, history, lock);
-    }
-
-  /* The transaction now got the lock on the object */
-lock_conversion_treatement:
+      /* The object exists in the hash chain &
+       * I am not a lock holder of the lockable object.
+       */
+      /* 1. I am not a holder & my request can be granted. */
+      assert (lock >= NULL_LOCK && res_ptr->total_waiters_mode >= NULL_LOCK
+	      && res_ptr->total_holders_mode >= NULL_LOCK);
+      compat1 = lock_Comp[lock][res_ptr->total_waiters_mode];
+      compat2 = lock_Comp[lock][res_ptr->total_holders_mode];
+      assert (compat1 != DB_NA && compat2 != DB_NA);
 
-  if (entry_ptr->res_head->type == LOCK_RESOURCE_CLASS
-      && lock_conversion == true)
-    {
-      new_mode = entry_ptr->granted_mode;
-      switch (old_mode)
+      if (compat1 == true && compat2 == true)
 	{
-	case IS_LOCK:
-	  if (new_mode == X_LOCK
-	      || ((new_mode == S_LOCK || new_mode == SIX_LOCK)
-		  && (isolation == TRAN_REP_CLASS_COMMIT_INSTANCE
-		      || isolation == TRAN_COMMIT_CLASS_COMMIT_INSTANCE)))
+	  if (LK_NON2PL_LOCK_REQUEST (res_ptr, isolation, lock))
 	    {
-	      lock_remove_all_inst_locks (thread_p, tran_index, oid, S_LOCK);
+	      entry_ptr = lock_add_non2pl_lock (res_ptr, tran_index, lock);
+	      if (entry_ptr == (LK_ENTRY *) NULL)
+		{
+		  MUTEX_UNLOCK (res_ptr->res_mutex);
+		  return LK_NOTGRANTED_DUE_ERROR;
+		}
+	      MUTEX_UNLOCK (res_ptr->res_mutex);
+	      *entry_addr_ptr = entry_ptr;
+	      return LK_GRANTED;
 	    }
-	  break;
 
-	case IX_LOCK:
-	  if (new_mode == SIX_LOCK
-	      && (isolation == TRAN_REP_CLASS_COMMIT_INSTANCE
-		  || isolation == TRAN_COMMIT_CLASS_COMMIT_INSTANCE))
+	  /* allocate a lock entry */
+	  entry_ptr = lock_alloc_entry ();
+	  if (entry_ptr == (LK_ENTRY *) NULL)
 	    {
-	      lock_remove_all_inst_locks (thread_p, tran_index, oid, S_LOCK);
+	      MUTEX_UNLOCK (res_ptr->res_mutex);
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ALLOC_RESOURCE,
+		      1, "lock heap entry");
+	      return LK_NOTGRANTED_DUE_ERROR;
 	    }
-	  else if (new_mode == X_LOCK)
+	  /* initialize the lock entry as granted state */
+	  LK_INIT_ENTRY_GRANTED (entry_ptr, tran_index, res_ptr, lock);
+	  if (is_instant_duration)
 	    {
-	      lock_remove_all_inst_locks (thread_p, tran_index, oid, X_LOCK);
+	      entry_ptr->mlk_count++;
+	    }
+	  /* to manage granules */
+	  entry_ptr->class_entry = class_entry;
+	  if (class_entry)
+	    {
+	      class_entry->ngranules++;
 	    }
-	  break;
 
-	case SIX_LOCK:
-	  /* new_mode == X_LOCK */
-	  lock_remove_all_inst_locks (thread_p, tran_index, oid, X_LOCK);
-	  break;
+	  /* add the lock entry into the holder list */
+	  lock_position_holder_entry (res_ptr, entry_ptr);
 
-	default:
-	  break;
-	}
+	  /* change total_holders_mode (total mode of holder list) */
+	  assert (lock >= NULL_LOCK
+		  && res_ptr->total_holders_mode >= NULL_LOCK);
+	  res_ptr->total_holders_mode =
+	    lock_Conv[lock][res_ptr->total_holders_mode];
+	  assert (res_ptr->total_holders_mode != NA_LOCK);
 
-      mnt_lk_converted_on_objects (thread_p);
+	  /* add the lock entry into the transaction hold list */
+	  lock_insert_into_tran_hold_list (entry_ptr);
+
+	  lock_update_non2pl_list (res_ptr, tran_index, lock);
+
+	  /* Record number of acquired locks */
+	  mnt_lk_acquired_on_objects (thread_p);
 #if defined(LK_TRACE_OBJECT)
-      LK_MSG_LOCK_CONVERTED (entry_ptr);
+	  LK_MSG_LOCK_ACQUIRED (entry_ptr);
 #endif /* LK_TRACE_OBJECT */
-    }
 
-  if (lock_conversion == false)
-    {
-      /* to manage granules */
-      entry_ptr->class_entry = class_entry;
-      if (class_entry)
-	{
-	  class_entry->ngranules++;
+	  if (NEED_LOCK_ACQUISITION_HISTORY (isolation, entry_ptr))
+	    {
+	      history = (LK_ACQUISITION_HISTORY *)
+		malloc (sizeof (LK_ACQUISITION_HISTORY));
+	      if (history == NULL)
+		{
+		  MUTEX_UNLOCK (res_ptr->res_mutex);
+		  return LK_NOTGRANTED_DUE_ERROR;
+		}
+
+	      RECORD_LOCK_ACQUISITION_HISTORY (entry_ptr, history, lock);
+	    }
+
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
+	  *entry_addr_ptr = entry_ptr;
+	  return LK_GRANTED;
 	}
-    }
 
-  *entry_addr_ptr = entry_ptr;
-  return LK_GRANTED;
-}
-#endif /* SERVER_MODE */
+      /* 2. I am not a holder & my request cannot be granted. */
+      if (LK_NON2PL_LOCK_REQUEST (res_ptr, isolation, lock))
+	{
+	  entry_ptr = lock_add_non2pl_lock (res_ptr, tran_index,
+					    INCON_NON_TWO_PHASE_LOCK);
+	  if (entry_ptr == (LK_ENTRY *) NULL)
+	    {
+	      MUTEX_UNLOCK (res_ptr->res_mutex);
+	      return LK_NOTGRANTED_DUE_ERROR;
+	    }
+	  else
+	    {
+	      MUTEX_UNLOCK (res_ptr->res_mutex);
+	      *entry_addr_ptr = entry_ptr;
+	      return LK_GRANTED;
+	    }
+	}
 
-#if defined(SERVER_MODE)
-/*
- * lock_internal_perform_unlock_object - Performs actual object unlock operation
- *
- * return:
- *
- *   entry_ptr(in):
- *   release_flag(in):
- *   move_to_non2pl(in):
- *
- * Note:Unlock a lock specified by entry_ptr.
- *     Therefore, for the 2 phase locking, the caller must unlock from leaf
- *     to root or atomically all locks to which the transaction is related.
- *
- *     if release_flag is true, release the lock item.
- *     Otherwise, just decrement the lock count for supporting isolation level.
- */
-static void
-lock_internal_perform_unlock_object (THREAD_ENTRY * thread_p,
-				     LK_ENTRY * entry_ptr, int release_flag,
-				     int move_to_non2pl)
-{
-  int tran_index;
-  LK_RES *res_ptr;
-  LK_ENTRY *i;
-  LK_ENTRY *prev, *curr;
-  LK_ENTRY *from_whom;
-  LOCK mode;
-  int rv;
-
-#if defined(LK_DUMP)
-  if (lk_Gl.dump_level >= 1)
-    {
-      fprintf (stderr,
-	       "LK_DUMP::lk_internal_unlock_object()\n"
-	       "  tran(%2d) : oid(%2d|%3d|%3d), class_oid(%2d|%3d|%3d), LOCK(%7s)\n",
-	       entry_ptr->tran_index,
-	       entry_ptr->res_head->oid.volid,
-	       entry_ptr->res_head->oid.pageid,
-	       entry_ptr->res_head->oid.slotid,
-	       entry_ptr->res_head->class_oid.volid,
-	       entry_ptr->res_head->class_oid.pageid,
-	       entry_ptr->res_head->class_oid.slotid,
-	       LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode));
-    }
-#endif /* LK_DUMP */
-
-  if (entry_ptr == (LK_ENTRY *) NULL)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_BAD_ARGUMENT, 2,
-	      "lk_internal_unlock_object", "NULL entry pointer");
-      return;
-    }
-
-  if (release_flag == false)
-    {
-      if (entry_ptr->blocked_mode != NULL_LOCK)
-	{
-	  entry_ptr->count -= 1;	/* still, might be count > 0 */
-	}
-      else
+      if (waitsecs == LK_ZERO_WAIT || waitsecs == LK_FORCE_ZERO_WAIT)
 	{
-	  entry_ptr->count -= 1;
-	  if (entry_ptr->count > 0)
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
+	  if (waitsecs == LK_ZERO_WAIT)
 	    {
-	      return;
-	    }
-	}
-    }
-
-  /* hold resource mutex */
-  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
-  res_ptr = entry_ptr->res_head;
-  MUTEX_LOCK (rv, res_ptr->res_mutex);
+	      if (entry_ptr == NULL)
+		{
+		  entry_ptr = lock_alloc_entry ();
+		  if (entry_ptr == (LK_ENTRY *) NULL)
+		    {
+		      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			      ER_LK_ALLOC_RESOURCE, 1, "lock heap entry");
+		      return LK_NOTGRANTED_DUE_ERROR;
+		    }
+		  LK_INIT_ENTRY_BLOCKED (entry_ptr, thread_p, tran_index,
+					 res_ptr, lock);
+		  if (is_instant_duration
+		      /* && lock_Comp[lock][NULL_LOCK] == true */ )
+		    {
+		      entry_ptr->mlk_count++;
+		    }
+		}
+	      (void) lock_set_error_for_timeout (thread_p, entry_ptr);
 
-  /* check if the transaction is in the holder list */
-  prev = (LK_ENTRY *) NULL;
-  curr = res_ptr->holder;
-  while (curr != (LK_ENTRY *) NULL)
-    {
-      if (curr->tran_index == tran_index)
-	{
-	  break;
+	      lock_free_entry (entry_ptr);
+	    }
+	  return LK_NOTGRANTED_DUE_TIMEOUT;
 	}
-      prev = curr;
-      curr = curr->next;
-    }
 
-  if (curr == (LK_ENTRY *) NULL)
-    {
-      /* the transaction is not in the holder list, check the waiter. */
-      prev = (LK_ENTRY *) NULL;
-      curr = res_ptr->waiter;
-      while (curr != (LK_ENTRY *) NULL)
+      /* check if another thread is waiting for the same resource
+       */
+      wait_entry_ptr = res_ptr->waiter;
+      while (wait_entry_ptr != (LK_ENTRY *) NULL)
 	{
-	  if (curr->tran_index == tran_index)
+	  if (wait_entry_ptr->tran_index == tran_index)
 	    {
 	      break;
 	    }
-	  prev = curr;
-	  curr = curr->next;
+	  wait_entry_ptr = wait_entry_ptr->next;
 	}
 
-      if (curr != (LK_ENTRY *) NULL)
+      if (wait_entry_ptr != NULL)
 	{
-	  /* get the next lock waiter */
-	  from_whom = curr->next;
-
-	  /* remove the lock entry from the waiter */
-	  if (prev == (LK_ENTRY *) NULL)
-	    {
-	      res_ptr->waiter = curr->next;
-	    }
-	  else
+	  er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
+		  ER_LK_MANY_LOCK_WAIT_TRAN, 1, tran_index);
+	  thread_lock_entry (thrd_entry);
+	  thread_lock_entry (wait_entry_ptr->thrd_entry);
+	  if (wait_entry_ptr->thrd_entry->lockwait == NULL)
 	    {
-	      prev->next = curr->next;
+	      /*  */
+	      thread_unlock_entry (wait_entry_ptr->thrd_entry);
+	      thread_unlock_entry (thrd_entry);
+	      MUTEX_UNLOCK (res_ptr->res_mutex);
+	      goto start;
 	    }
 
-	  /* free the lock entry */
-	  lock_free_entry (curr);
+	  thrd_entry->tran_next_wait =
+	    wait_entry_ptr->thrd_entry->tran_next_wait;
+	  wait_entry_ptr->thrd_entry->tran_next_wait = thrd_entry;
 
-	  if (from_whom != (LK_ENTRY *) NULL)
-	    {
-	      /* grant blocked waiter & change total_waiters_mode */
-	      lock_grant_blocked_waiter_partial (thread_p, res_ptr,
-						 from_whom);
-	    }
-	  else
+	  thread_unlock_entry (wait_entry_ptr->thrd_entry);
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
+
+	  while (1)
 	    {
-	      /* change only total_waiters_mode */
-	      mode = NULL_LOCK;
-	      for (i = res_ptr->waiter; i != (LK_ENTRY *) NULL; i = i->next)
+	      thread_suspend_wakeup_and_unlock_entry (thrd_entry,
+						      THREAD_LOCK_SUSPENDED);
+
+	      if (entry_ptr->thrd_entry->resume_status ==
+		  THREAD_RESUME_DUE_TO_INTERRUPT
+		  && entry_ptr->thrd_entry->interrupted)
 		{
-		  assert (i->blocked_mode >= NULL_LOCK && mode >= NULL_LOCK);
-		  mode = lock_Conv[i->blocked_mode][mode];
-		  assert (mode != NA_LOCK);
+		  /* In case the shutdown thread wakes me up,
+		   * I keep being suspended and waiting until the lock holder
+		   * wakes me up, because it is too dangerous to continue
+		   * process with a lock not granted.
+		   */
+		  continue;
 		}
-	      res_ptr->total_waiters_mode = mode;
+	      else if (entry_ptr->thrd_entry->resume_status !=
+		       THREAD_LOCK_RESUMED)
+		{
+		  assert (0);
+		}
+
+	      break;
 	    }
+
+	  goto start;
 	}
-      else
+
+      /* allocate a lock entry. */
+      entry_ptr = lock_alloc_entry ();
+      if (entry_ptr == (LK_ENTRY *) NULL)
 	{
-	  /* The transaction is neither the lock holder nor the lock waiter */
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_LOST_TRANSACTION, 4,
-		  tran_index,
-		  res_ptr->oid.volid, res_ptr->oid.pageid,
-		  res_ptr->oid.slotid);
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ALLOC_RESOURCE,
+		  1, "lock heap entry");
+	  return LK_NOTGRANTED_DUE_ERROR;
+	}
+      /* initialize the lock entry as blocked state */
+      LK_INIT_ENTRY_BLOCKED (entry_ptr, thread_p, tran_index, res_ptr, lock);
+      if (is_instant_duration)
+	{
+	  entry_ptr->mlk_count++;
 	}
 
-      MUTEX_UNLOCK (res_ptr->res_mutex);
+      /* append the lock request at the end of the waiter */
+      prev = (LK_ENTRY *) NULL;
+      for (i = res_ptr->waiter; i != (LK_ENTRY *) NULL;)
+	{
+	  prev = i;
+	  i = i->next;
+	}
+      if (prev == (LK_ENTRY *) NULL)
+	{
+	  res_ptr->waiter = entry_ptr;
+	}
+      else
+	{
+	  prev->next = entry_ptr;
+	}
 
-      return;
-    }
+      /* change total_waiters_mode (total mode of waiting waiter) */
+      assert (lock >= NULL_LOCK && res_ptr->total_waiters_mode >= NULL_LOCK);
+      res_ptr->total_waiters_mode =
+	lock_Conv[lock][res_ptr->total_waiters_mode];
+      assert (res_ptr->total_waiters_mode != NA_LOCK);
 
-  /* The transaction is in the holder list. Consult the holder list. */
+      goto blocked;
 
-  /* remove the entry from the holder list */
-  if (prev == (LK_ENTRY *) NULL)
-    {
-      res_ptr->holder = curr->next;
-    }
-  else
-    {
-      prev->next = curr->next;
-    }
+    }				/* end of a new lock request */
 
-  if (release_flag == false && curr->count > 0)
-    {
-      /* The current transaction was a blocked holder.
-       * lock timeout is called or it is selected as a deadlock victim
-       */
-      curr->blocked_mode = NULL_LOCK;
-      lock_position_holder_entry (res_ptr, entry_ptr);
-    }
-  else
+  if (LK_NON2PL_LOCK_REQUEST (res_ptr, isolation, lock))
     {
-      /* remove the lock entry from the transaction lock hold list */
-      (void) lock_delete_from_tran_hold_list (curr);
-
-      /* to manage granules */
-      if (curr->class_entry)
-	{
-	  curr->class_entry->ngranules--;
-	}
-
-      /* If it's not the end of transaction, it's a non2pl lock */
-      if (release_flag == false && move_to_non2pl == true)
+      if (entry_ptr->granted_mode == NX_LOCK
+	  || entry_ptr->granted_mode == X_LOCK)
 	{
-	  (void) lock_add_non2pl_lock (res_ptr, tran_index,
-				       curr->granted_mode);
+	  /* The conversioned mode might be the same with the current mode. */
+	  /* The only exception case is followings.
+	     When the current mode is NX_LOCK and thr request mode is U_LOCK,
+	     the conversioned mode will be X_LOCK.
+	     In this case, however, the intention of U_LOCK of Uncommitted Read
+	     isolation is only having the intent of READ.
+	     Therefore, the U_LOCK request of this case can be granted
+	     without acquiring it.
+	   */
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
+	  mnt_lk_re_requested_on_objects (thread_p);	/* monitoring */
+	  *entry_addr_ptr = entry_ptr;
+	  return LK_GRANTED;
 	}
-      /* free the lock entry */
-      lock_free_entry (curr);
+      /* entry_ptr->granted_mode != NX_LOCK &&
+         entry_ptr->granted_mode != X_LOCK
+       */
+      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE, ER_LK_FAULT_GRANTED_MODE, 5,
+	      res_ptr->oid.volid, res_ptr->oid.pageid, res_ptr->oid.slotid,
+	      entry_ptr->tran_index,
+	      LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode));
     }
 
-  /* change total_holders_mode */
-  mode = NULL_LOCK;
-  for (i = res_ptr->holder; i != (LK_ENTRY *) NULL; i = i->next)
-    {
-      assert (i->granted_mode >= NULL_LOCK && mode >= NULL_LOCK);
-      mode = lock_Conv[i->granted_mode][mode];
-      assert (mode != NA_LOCK);
-
-      assert (i->blocked_mode >= NULL_LOCK && mode >= NULL_LOCK);
-      mode = lock_Conv[i->blocked_mode][mode];
-      assert (mode != NA_LOCK);
-    }
-  res_ptr->total_holders_mode = mode;
+  /* The object exists in the hash chain &
+   * I am a lock holder of the lockable object.
+   */
+  lock_conversion = true;
+  old_mode = entry_ptr->granted_mode;
+  assert (lock >= NULL_LOCK && entry_ptr->granted_mode >= NULL_LOCK);
+  new_mode = lock_Conv[lock][entry_ptr->granted_mode];
+  assert (new_mode != NA_LOCK);
 
-  if (res_ptr->holder == NULL && res_ptr->waiter == NULL)
+  if (new_mode == entry_ptr->granted_mode)
     {
-      if (res_ptr->non2pl == NULL)
+      /* a request with either a less exclusive or an equal mode of lock */
+      entry_ptr->count += 1;
+      if (is_instant_duration)
 	{
-	  /* if resource entry is empty, deallocate it. */
-	  (void) lock_dealloc_resource (res_ptr);
+	  compat1 = lock_Comp[lock][entry_ptr->granted_mode];
+	  assert (compat1 != DB_NA);
+
+	  if ((lock >= IX_LOCK
+	       && (entry_ptr->mlk_count == 0
+		   && entry_ptr->granted_mode >= IX_LOCK)) && compat1 != true)
+	    {
+	      /* if the lock is already aquired with incompatible mode by current transaction,
+	         remove instant instance locks */
+	      lock_stop_instant_lock_mode (thread_p, tran_index, false);
+	    }
+	  else
+	    {
+	      entry_ptr->mlk_count++;
+	    }
 	}
-      else
+
+      if (NEED_LOCK_ACQUISITION_HISTORY (isolation, entry_ptr))
 	{
-	  MUTEX_UNLOCK (res_ptr->res_mutex);
+	  history = (LK_ACQUISITION_HISTORY *)
+	    malloc (sizeof (LK_ACQUISITION_HISTORY));
+	  if (history == NULL)
+	    {
+	      MUTEX_UNLOCK (res_ptr->res_mutex);
+	      return LK_NOTGRANTED_DUE_ERROR;
+	    }
+
+	  RECORD_LOCK_ACQUISITION_HISTORY (entry_ptr, history, lock);
 	}
-    }
-  else
-    {
-      /* grant blocked holders and blocked waiters */
-      lock_grant_blocked_holder (thread_p, res_ptr);
 
-      (void) lock_grant_blocked_waiter (thread_p, res_ptr);
       MUTEX_UNLOCK (res_ptr->res_mutex);
+      mnt_lk_re_requested_on_objects (thread_p);	/* monitoring */
+      *entry_addr_ptr = entry_ptr;
+      return LK_GRANTED;
     }
-}
-#endif /* SERVER_MODE */
-
-/*
- *  Private Functions Group: demote, unlock and remove locks
- *
- *   - lock_internal_demote_shared_class_lock()
- *   - lock_internal_demote_update_inst_lock()
- *   - lock_demote_shared_class_lock()
- *   - lock_demote_all_shared_class_locks()
- *   - lock_unlock_shared_class_lock()
- *   - lock_unlock_shared_inst_lock()
- *   - lock_remove_all_class_locks()
- *   - lock_remove_all_inst_locks()
- */
-
-#if defined(SERVER_MODE)
-/*
- * lock_internal_demote_shared_class_lock - Demote the shared class lock
- *
- * return: error code
- *
- *   entry_ptr(in):
- *
- * Note:This function demotes the lock mode of given class lock
- *     if the lock mode is shared lock. After the demotion, this function
- *     grants the blocked requestors if the blocked lock mode is grantable.
- *
- *     demote shared class lock (S_LOCK => IS_LOCK, SIX_LOCK => IX_LOCK)
- */
-static int
-lock_internal_demote_shared_class_lock (THREAD_ENTRY * thread_p,
-					LK_ENTRY * entry_ptr)
-{
-  LK_RES *res_ptr;		/* lock resource entry pointer */
-  LK_ENTRY *check, *i;		/* lock entry pointer     */
-  LOCK total_mode;
-  int rv;
-
-  /* The caller is not holding any mutex */
-
-  res_ptr = entry_ptr->res_head;
-  MUTEX_LOCK (rv, res_ptr->res_mutex);
 
-  /* find the given lock entry in the holder list */
-  for (check = res_ptr->holder; check != NULL; check = check->next)
+  /* check the compatibility with other holders' granted mode */
+  group_mode = NULL_LOCK;
+  for (i = res_ptr->holder; i != (LK_ENTRY *) NULL; i = i->next)
     {
-      if (check == entry_ptr)
+      if (i != entry_ptr)
 	{
-	  break;
+	  assert (i->granted_mode >= NULL_LOCK && group_mode >= NULL_LOCK);
+	  group_mode = lock_Conv[i->granted_mode][group_mode];
+	  assert (group_mode != NA_LOCK);
 	}
     }
-  if (check == (LK_ENTRY *) NULL)
-    {				/* not found */
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
-	      ER_LK_NOTFOUND_IN_LOCK_HOLDER_LIST, 5,
-	      LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
-	      entry_ptr->tran_index,
-	      res_ptr->oid.volid, res_ptr->oid.pageid, res_ptr->oid.slotid);
-      MUTEX_UNLOCK (res_ptr->res_mutex);
-      return ER_LK_NOTFOUND_IN_LOCK_HOLDER_LIST;
-    }
 
-#if defined(LK_DUMP)
-  if (lk_Gl.dump_level >= 1)
-    {
-      fprintf (stderr, "LK_DUMP::lk_internal_demote_shared_class_lock()\n"
-	       "  tran(%2d) : oid(%d|%d|%d), class_oid(%d|%d|%d), LOCK(%7s -> %7s)\n",
-	       entry_ptr->tran_index,
-	       entry_ptr->res_head->oid.volid,
-	       entry_ptr->res_head->oid.pageid,
-	       entry_ptr->res_head->oid.slotid,
-	       entry_ptr->res_head->class_oid.volid,
-	       entry_ptr->res_head->class_oid.pageid,
-	       entry_ptr->res_head->class_oid.slotid,
-	       LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
-	       entry_ptr->granted_mode == S_LOCK ?
-	       LOCK_TO_LOCKMODE_STRING (IS_LOCK) :
-	       (entry_ptr->granted_mode == X_LOCK ?
-		LOCK_TO_LOCKMODE_STRING (IX_LOCK) :
-		LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode)));
-    }
-#endif /* LK_DUMP */
+  assert (new_mode >= NULL_LOCK && group_mode >= NULL_LOCK);
+  compat1 = lock_Comp[new_mode][group_mode];
+  assert (compat1 != DB_NA);
 
-  /* demote the shared class lock(granted mode) of the lock entry */
-  switch (check->granted_mode)
+  if (compat1 == true)
     {
-    case S_LOCK:
-      check->granted_mode = IS_LOCK;
-      break;
+      if (NEED_LOCK_ACQUISITION_HISTORY (isolation, entry_ptr))
+	{
+	  history = (LK_ACQUISITION_HISTORY *)
+	    malloc (sizeof (LK_ACQUISITION_HISTORY));
+	  if (history == NULL)
+	    {
+	      MUTEX_UNLOCK (res_ptr->res_mutex);
+	      return LK_NOTGRANTED_DUE_ERROR;
+	    }
 
-    case SIX_LOCK:
-      check->granted_mode = IX_LOCK;
-      break;
+	  RECORD_LOCK_ACQUISITION_HISTORY (entry_ptr, history, lock);
+	}
 
-    default:
+      entry_ptr->granted_mode = new_mode;
+      entry_ptr->count += 1;
+
+      assert (lock >= NULL_LOCK && res_ptr->total_holders_mode >= NULL_LOCK);
+      res_ptr->total_holders_mode =
+	lock_Conv[lock][res_ptr->total_holders_mode];
+      assert (res_ptr->total_holders_mode != NA_LOCK);
+
+      lock_update_non2pl_list (res_ptr, tran_index, lock);
       MUTEX_UNLOCK (res_ptr->res_mutex);
-      return NO_ERROR;
+
+      goto lock_conversion_treatement;
     }
 
-  /* change total_holders_mode */
-  total_mode = NULL_LOCK;
-  for (i = res_ptr->holder; i != NULL; i = i->next)
+  /* I am a holder & my request cannot be granted. */
+  if (waitsecs == LK_ZERO_WAIT || waitsecs == LK_FORCE_ZERO_WAIT)
     {
-      assert (i->granted_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
-      total_mode = lock_Conv[i->granted_mode][total_mode];
-      assert (total_mode != NA_LOCK);
-
-      assert (i->blocked_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
-      total_mode = lock_Conv[i->blocked_mode][total_mode];
-      assert (total_mode != NA_LOCK);
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+      if (waitsecs == LK_ZERO_WAIT)
+	{
+	  (void) lock_set_error_for_timeout (thread_p, entry_ptr);
+	}
+      return LK_NOTGRANTED_DUE_TIMEOUT;
     }
-  res_ptr->total_holders_mode = total_mode;
-
-  /* grant the blocked holders and blocked waiters */
-  lock_grant_blocked_holder (thread_p, res_ptr);
-  (void) lock_grant_blocked_waiter (thread_p, res_ptr);
 
-  MUTEX_UNLOCK (res_ptr->res_mutex);
+  /* Upgrader Positioning Rule (UPR) */
 
-  return NO_ERROR;
-}
-#endif /* SERVER_MODE */
+  /* check if another thread is waiting for the same resource
+   */
+  if (entry_ptr->blocked_mode != NULL_LOCK)
+    {
+      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE, ER_LK_MANY_LOCK_WAIT_TRAN,
+	      1, tran_index);
+      thread_lock_entry (thrd_entry);
+      thread_lock_entry (entry_ptr->thrd_entry);
 
-#if defined(SERVER_MODE)
-/*
- * lock_internal_demote_update_inst_lock - Demote the update instance lock
- *
- * return: error code
- *
- *   entry_ptr(in):
- *
- * Note:This function demotes the lock mode of given instance lock
- *     if the lock mode is update lock. After the demotion, this function
- *     grants the blocked requestors if the blocked lock mode is grantable.
- *
- *     demote update instance lock (U_LOCK => S_LOCK/NS_LOCK)
- */
-static int
-lock_internal_demote_update_inst_lock (THREAD_ENTRY * thread_p,
-				       LK_ENTRY * entry_ptr)
-{
-  LK_RES *res_ptr;		/* lock resource entry pointer */
-  LK_ENTRY *check, *i;		/* lock entry pointer */
-  LOCK total_mode;
-  int rv;
+      if (entry_ptr->thrd_entry->lockwait == NULL)
+	{
+	  thread_unlock_entry (entry_ptr->thrd_entry);
+	  thread_unlock_entry (thrd_entry);
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
+	  goto start;
+	}
 
-  /* The caller is not holding any mutex */
+      thrd_entry->tran_next_wait = entry_ptr->thrd_entry->tran_next_wait;
+      entry_ptr->thrd_entry->tran_next_wait = thrd_entry;
 
-  res_ptr = entry_ptr->res_head;
-  MUTEX_LOCK (rv, res_ptr->res_mutex);
+      thread_unlock_entry (entry_ptr->thrd_entry);
 
-  /* find the given lock entry in the holder list */
-  for (check = res_ptr->holder; check != NULL; check = check->next)
-    {
-      if (check == entry_ptr)
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+
+      thread_suspend_wakeup_and_unlock_entry (thrd_entry,
+					      THREAD_LOCK_SUSPENDED);
+      if (thrd_entry->resume_status == THREAD_RESUME_DUE_TO_INTERRUPT)
 	{
-	  break;
+	  /* a shutdown thread wakes me up */
+	  return LK_NOTGRANTED_DUE_ERROR;
+	}
+      else if (thrd_entry->resume_status != THREAD_LOCK_RESUMED)
+	{
+	  /* wake up with other reason */
+	  assert (0);
+
+	  return LK_NOTGRANTED_DUE_ERROR;
+	}
+      else
+	{
+	  assert (thrd_entry->resume_status == THREAD_LOCK_RESUMED);
 	}
+
+      goto start;
     }
-  if (check == (LK_ENTRY *) NULL)
-    {				/* not found */
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
-	      ER_LK_NOTFOUND_IN_LOCK_HOLDER_LIST, 5,
-	      LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
-	      entry_ptr->tran_index,
-	      res_ptr->oid.volid, res_ptr->oid.pageid, res_ptr->oid.slotid);
-      MUTEX_UNLOCK (res_ptr->res_mutex);
-      return ER_LK_NOTFOUND_IN_LOCK_HOLDER_LIST;
+
+  entry_ptr->blocked_mode = new_mode;
+  entry_ptr->count += 1;
+  entry_ptr->thrd_entry = thread_p;
+
+  assert (lock >= NULL_LOCK && res_ptr->total_holders_mode >= NULL_LOCK);
+  res_ptr->total_holders_mode = lock_Conv[lock][res_ptr->total_holders_mode];
+  assert (res_ptr->total_holders_mode != NA_LOCK);
+
+  /* remove the lock entry from the holder list */
+  prev = (LK_ENTRY *) NULL;
+  curr = res_ptr->holder;
+  while ((curr != (LK_ENTRY *) NULL) && (curr != entry_ptr))
+    {
+      prev = curr;
+      curr = curr->next;
+    }
+  if (prev == (LK_ENTRY *) NULL)
+    {
+      res_ptr->holder = entry_ptr->next;
+    }
+  else
+    {
+      prev->next = entry_ptr->next;
     }
 
-#if defined(LK_DUMP)
-  if (lk_Gl.dump_level >= 1)
+  /* position the lock entry in the holder list according to UPR */
+  lock_position_holder_entry (res_ptr, entry_ptr);
+
+blocked:
+
+  /* LK_CANWAIT(waitsecs) : waitsecs > 0 */
+  mnt_lk_waited_on_objects (thread_p);
+#if defined(LK_TRACE_OBJECT)
+  LK_MSG_LOCK_WAITFOR (entry_ptr);
+#endif /* LK_TRACE_OBJECT */
+
+  (void) thread_lock_entry (entry_ptr->thrd_entry);
+  MUTEX_UNLOCK (res_ptr->res_mutex);
+  ret_val = lock_suspend (thread_p, entry_ptr, waitsecs);
+  if (ret_val != LOCK_RESUMED)
     {
-      fprintf (stderr, "LK_DUMP::lk_internal_demote_update_inst_lock()\n"
-	       "  tran(%2d) : oid(%d|%d|%d), class_oid(%d|%d|%d), LOCK(%7s -> %7s)\n",
-	       entry_ptr->tran_index,
-	       entry_ptr->res_head->oid.volid,
-	       entry_ptr->res_head->oid.pageid,
-	       entry_ptr->res_head->oid.slotid,
-	       entry_ptr->res_head->class_oid.volid,
-	       entry_ptr->res_head->class_oid.pageid,
-	       entry_ptr->res_head->class_oid.slotid,
-	       LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
-	       (entry_ptr->granted_mode == U_LOCK &&
-		logtb_find_current_isolation () == TRAN_SERIALIZABLE) ?
-	       LOCK_TO_LOCKMODE_STRING (S_LOCK) :
-	       (logtb_find_current_isolation () ==
-		TRAN_REP_CLASS_REP_INSTANCE ?
-		LOCK_TO_LOCKMODE_STRING (NS_LOCK) :
-		LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode)));
+      /* Following three cases are possible.
+       * 1. lock timeout 2. deadlock victim  3. interrupt
+       * In any case, current thread must remove the wait info.
+       */
+      lock_internal_perform_unlock_object (thread_p, entry_ptr, false, false);
+
+      if (ret_val == LOCK_RESUMED_ABORTED)
+	{
+	  return LK_NOTGRANTED_DUE_ABORTED;
+	}
+      else if (ret_val == LOCK_RESUMED_INTERRUPT)
+	{
+	  return LK_NOTGRANTED_DUE_ERROR;
+	}
+      else			/* LOCK_RESUMED_TIMEOUT || LOCK_SUSPENDED */
+	{
+	  return LK_NOTGRANTED_DUE_TIMEOUT;
+	}
     }
-#endif /* LK_DUMP */
 
-  /* check and update granted mode of the lock entry */
-  if (check->granted_mode == U_LOCK)
+  if (NEED_LOCK_ACQUISITION_HISTORY (isolation, entry_ptr))
     {
-      switch (logtb_find_current_isolation (thread_p))
+      history = (LK_ACQUISITION_HISTORY *)
+	malloc (sizeof (LK_ACQUISITION_HISTORY));
+      if (history == NULL)
 	{
-	case TRAN_SERIALIZABLE:
-	  check->granted_mode = S_LOCK;
+	  return LK_NOTGRANTED_DUE_ERROR;
+	}
+
+      RECORD_LOCK_ACQUISITION_HISTORY (entry_ptr, history, lock);
+    }
+
+  /* The transaction now got the lock on the object */
+lock_conversion_treatement:
+
+  if (entry_ptr->res_head->type == LOCK_RESOURCE_CLASS
+      && lock_conversion == true)
+    {
+      new_mode = entry_ptr->granted_mode;
+      switch (old_mode)
+	{
+	case IS_LOCK:
+	  if (new_mode == X_LOCK
+	      || ((new_mode == S_LOCK || new_mode == SIX_LOCK)
+		  && (isolation == TRAN_REP_CLASS_COMMIT_INSTANCE
+		      || isolation == TRAN_COMMIT_CLASS_COMMIT_INSTANCE)))
+	    {
+	      lock_remove_all_inst_locks (thread_p, tran_index, oid, S_LOCK);
+	    }
 	  break;
 
-	case TRAN_REP_CLASS_REP_INSTANCE:
-	  check->granted_mode = NS_LOCK;
+	case IX_LOCK:
+	  if (new_mode == SIX_LOCK
+	      && (isolation == TRAN_REP_CLASS_COMMIT_INSTANCE
+		  || isolation == TRAN_COMMIT_CLASS_COMMIT_INSTANCE))
+	    {
+	      lock_remove_all_inst_locks (thread_p, tran_index, oid, S_LOCK);
+	    }
+	  else if (new_mode == X_LOCK)
+	    {
+	      lock_remove_all_inst_locks (thread_p, tran_index, oid, X_LOCK);
+	    }
+	  break;
+
+	case SIX_LOCK:
+	  /* new_mode == X_LOCK */
+	  lock_remove_all_inst_locks (thread_p, tran_index, oid, X_LOCK);
 	  break;
 
 	default:
-	  MUTEX_UNLOCK (res_ptr->res_mutex);
-	  return NO_ERROR;
+	  break;
 	}
-    }
-  else
-    {
-      MUTEX_UNLOCK (res_ptr->res_mutex);
-      return NO_ERROR;
+
+      mnt_lk_converted_on_objects (thread_p);
+#if defined(LK_TRACE_OBJECT)
+      LK_MSG_LOCK_CONVERTED (entry_ptr);
+#endif /* LK_TRACE_OBJECT */
     }
 
-  /* change total_holders_mode */
-  total_mode = NULL_LOCK;
-  for (i = res_ptr->holder; i != NULL; i = i->next)
+  if (lock_conversion == false)
     {
-      assert (i->granted_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
-      total_mode = lock_Conv[i->granted_mode][total_mode];
-      assert (total_mode != NA_LOCK);
-
-      assert (i->blocked_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
-      total_mode = lock_Conv[i->blocked_mode][total_mode];
-      assert (total_mode != NA_LOCK);
+      /* to manage granules */
+      entry_ptr->class_entry = class_entry;
+      if (class_entry)
+	{
+	  class_entry->ngranules++;
+	}
     }
-  res_ptr->total_holders_mode = total_mode;
-
-  /* grant the blocked holders and the blocked waiters */
-  lock_grant_blocked_holder (thread_p, res_ptr);
-  (void) lock_grant_blocked_waiter (thread_p, res_ptr);
-
-  MUTEX_UNLOCK (res_ptr->res_mutex);
 
-  return NO_ERROR;
+  *entry_addr_ptr = entry_ptr;
+  return LK_GRANTED;
 }
 #endif /* SERVER_MODE */
 
 #if defined(SERVER_MODE)
 /*
- * lock_demote_shared_class_lock -  Demote one shared class lock
+ * lock_internal_perform_unlock_object - Performs actual object unlock operation
  *
  * return:
  *
- *   tran_index(in):
- *   class_oid(in):
+ *   entry_ptr(in):
+ *   release_flag(in):
+ *   move_to_non2pl(in):
  *
- * Note:This function finds the lock entry whose lock object id is same
- *     with the given class_oid in the transaction lock hold list. And then,
- *     demote the class lock if the class lock is shared mode.
+ * Note:Unlock a lock specified by entry_ptr.
+ *     Therefore, for the 2 phase locking, the caller must unlock from leaf
+ *     to root or atomically all locks to which the transaction is related.
+ *
+ *     if release_flag is true, release the lock item.
+ *     Otherwise, just decrement the lock count for supporting isolation level.
  */
 static void
-lock_demote_shared_class_lock (THREAD_ENTRY * thread_p, int tran_index,
-			       const OID * class_oid)
+lock_internal_perform_unlock_object (THREAD_ENTRY * thread_p,
+				     LK_ENTRY * entry_ptr, int release_flag,
+				     int move_to_non2pl)
 {
-  LK_ENTRY *entry_ptr;
+  int tran_index;
+  LK_RES *res_ptr;
+  LK_ENTRY *i;
+  LK_ENTRY *prev, *curr;
+  LK_ENTRY *from_whom;
+  LOCK mode;
+  int rv;
 
-  /* The caller is not holding any mutex */
+#if defined(LK_DUMP)
+  if (lk_Gl.dump_level >= 1)
+    {
+      fprintf (stderr,
+	       "LK_DUMP::lk_internal_unlock_object()\n"
+	       "  tran(%2d) : oid(%2d|%3d|%3d), class_oid(%2d|%3d|%3d), LOCK(%7s)\n",
+	       entry_ptr->tran_index,
+	       entry_ptr->res_head->oid.volid,
+	       entry_ptr->res_head->oid.pageid,
+	       entry_ptr->res_head->oid.slotid,
+	       entry_ptr->res_head->class_oid.volid,
+	       entry_ptr->res_head->class_oid.pageid,
+	       entry_ptr->res_head->class_oid.slotid,
+	       LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode));
+    }
+#endif /* LK_DUMP */
 
-  /* demote only one class lock */
-  entry_ptr = lock_find_class_entry (tran_index, class_oid);
-  if (entry_ptr != (LK_ENTRY *) NULL)
+  if (entry_ptr == (LK_ENTRY *) NULL)
     {
-      enum
-      { SKIP, DEMOTE, DECREMENT_COUNT };
-      int demote = SKIP;
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_BAD_ARGUMENT, 2,
+	      "lk_internal_unlock_object", "NULL entry pointer");
+      return;
+    }
 
-      /* I think there's no need to acquire the mutex here. */
-      if (entry_ptr->history)
+  if (release_flag == false)
+    {
+      if (entry_ptr->blocked_mode != NULL_LOCK)
 	{
-	  LK_ACQUISITION_HISTORY *prev, *last, *p;
+	  entry_ptr->count -= 1;	/* still, might be count > 0 */
+	}
+      else
+	{
+	  entry_ptr->count -= 1;
+	  if (entry_ptr->count > 0)
+	    {
+	      return;
+	    }
+	}
+    }
 
-	  last = entry_ptr->recent;
-	  prev = last->prev;
+  /* a fast path lock on a class is released without the lock table */
+  if (entry_ptr->fastpath
+      && (release_flag == true || move_to_non2pl == false)
+      && lock_fastpath_unlock_class (thread_p, entry_ptr) == true)
+    {
+      return;
+    }
 
-	  if ((last->req_mode == S_LOCK || last->req_mode == SIX_LOCK)
-	      && (entry_ptr->granted_mode == S_LOCK
-		  || entry_ptr->granted_mode == SIX_LOCK))
+  /* hold resource mutex */
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  res_ptr = entry_ptr->res_head;
+  MUTEX_LOCK (rv, res_ptr->res_mutex);
+  if (entry_ptr->fastpath)
+    {
+      lock_fastpath_transfer (res_ptr, entry_ptr->tran_index);
+    }
+
+  /* check if the transaction is in the holder list */
+  prev = (LK_ENTRY *) NULL;
+  curr = res_ptr->holder;
+  while (curr != (LK_ENTRY *) NULL)
+    {
+      if (curr->tran_index == tran_index)
+	{
+	  break;
+	}
+      prev = curr;
+      curr = curr->next;
+    }
+
+  if (curr == (LK_ENTRY *) NULL)
+    {
+      /* the transaction is not in the holder list, check the waiter. */
+      prev = (LK_ENTRY *) NULL;
+      curr = res_ptr->waiter;
+      while (curr != (LK_ENTRY *) NULL)
+	{
+	  if (curr->tran_index == tran_index)
 	    {
-	      p = entry_ptr->history;
-	      while (p != last)
-		{
-		  if (p->req_mode == S_LOCK || p->req_mode == SIX_LOCK)
-		    {
-		      break;
-		    }
-		  p = p->next;
-		}
+	      break;
+	    }
+	  prev = curr;
+	  curr = curr->next;
+	}
 
-	      if (p != last)
-		{
-		  /* do not demote shared class lock */
-		}
-	      else
-		{
-		  demote = DEMOTE;
-		}
+      if (curr != (LK_ENTRY *) NULL)
+	{
+	  /* get the next lock waiter */
+	  from_whom = curr->next;
+
+	  /* remove the lock entry from the waiter */
+	  if (prev == (LK_ENTRY *) NULL)
+	    {
+	      res_ptr->waiter = curr->next;
 	    }
-	  else if (entry_ptr->granted_mode == IS_LOCK
-		   && last->req_mode == IS_LOCK && entry_ptr->history != last)
+	  else
 	    {
-	      /* has > 1 IS_LOCK */
-	      demote = DECREMENT_COUNT;
+	      prev->next = curr->next;
 	    }
 
-	  /* free the last node */
-	  if (prev == NULL)
+	  /* free the lock entry */
+	  lock_free_entry (curr);
+
+	  if (from_whom != (LK_ENTRY *) NULL)
 	    {
-	      entry_ptr->history = NULL;
-	      entry_ptr->recent = NULL;
+	      /* grant blocked waiter & change total_waiters_mode */
+	      lock_grant_blocked_waiter_partial (thread_p, res_ptr,
+						 from_whom);
 	    }
 	  else
 	    {
-	      prev->next = NULL;
-	      entry_ptr->recent = prev;
+	      /* change only total_waiters_mode */
+	      mode = NULL_LOCK;
+	      for (i = res_ptr->waiter; i != (LK_ENTRY *) NULL; i = i->next)
+		{
+		  assert (i->blocked_mode >= NULL_LOCK && mode >= NULL_LOCK);
+		  mode = lock_Conv[i->blocked_mode][mode];
+		  assert (mode != NA_LOCK);
+		}
+	      res_ptr->total_waiters_mode = mode;
 	    }
-	  free_and_init (last);
 	}
       else
 	{
-	  if (entry_ptr->granted_mode == S_LOCK
-	      || entry_ptr->granted_mode == SIX_LOCK)
-	    {
-	      demote = DEMOTE;
-	    }
+	  /* The transaction is neither the lock holder nor the lock waiter */
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_LOST_TRANSACTION, 4,
+		  tran_index,
+		  res_ptr->oid.volid, res_ptr->oid.pageid,
+		  res_ptr->oid.slotid);
 	}
 
-      if (demote == DEMOTE)
-	{
-	  (void) lock_internal_demote_shared_class_lock (thread_p, entry_ptr);
-	}
-      else if (demote == DECREMENT_COUNT
-	       || entry_ptr->granted_mode == S_LOCK
-	       || entry_ptr->granted_mode == SIX_LOCK)
-	{
-	  entry_ptr->count--;
-	}
+      MUTEX_UNLOCK (res_ptr->res_mutex);
 
+      return;
     }
-}
-#endif /* SERVER_MODE */
-
-#if defined(SERVER_MODE)
-/*
- * lock_demote_all_shared_class_locks - Demote all shared class locks
- *
- * return:
- *
- *   tran_index(in):
- *
- * Note:This function demotes all shared class locks that are held
- *     by the given transaction.
- */
-static void
-lock_demote_all_shared_class_locks (THREAD_ENTRY * thread_p, int tran_index)
-{
-  LK_TRAN_LOCK *tran_lock;
-  LK_ENTRY *curr, *next;
 
-  /* When this function is called, only one thread is executing
-   * for the transaction. (transaction : thread = 1 : 1)
-   * Therefore, there is no need to hold tran_lock->hold_mutex.
-   */
+  /* The transaction is in the holder list. Consult the holder list. */
 
-  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  /* remove the entry from the holder list */
+  if (prev == (LK_ENTRY *) NULL)
+    {
+      res_ptr->holder = curr->next;
+    }
+  else
+    {
+      prev->next = curr->next;
+    }
 
-  /* 1. demote general class locks */
-  curr = tran_lock->class_hold_list;
-  while (curr != (LK_ENTRY *) NULL)
+  if (release_flag == false && curr->count > 0)
     {
-      next = curr->tran_next;
-      if (curr->granted_mode == S_LOCK || curr->granted_mode == SIX_LOCK)
+      /* The current transaction was a blocked holder.
+       * lock timeout is called or it is selected as a deadlock victim
+       */
+      curr->blocked_mode = NULL_LOCK;
+      lock_position_holder_entry (res_ptr, entry_ptr);
+    }
+  else
+    {
+      /* remove the lock entry from the transaction lock hold list */
+      (void) lock_delete_from_tran_hold_list (curr);
+
+      /* to manage granules */
+      if (curr->class_entry)
 	{
-	  (void) lock_internal_demote_shared_class_lock (thread_p, curr);
+	  curr->class_entry->ngranules--;
 	}
-      curr = next;
-    }
 
-  /* 2. demote root class lock */
-  curr = tran_lock->root_class_hold;
-  if (curr != (LK_ENTRY *) NULL)
-    {
-      if (curr->granted_mode == S_LOCK || curr->granted_mode == SIX_LOCK)
+      /* If it's not the end of transaction, it's a non2pl lock */
+      if (release_flag == false && move_to_non2pl == true)
 	{
-	  (void) lock_internal_demote_shared_class_lock (thread_p, curr);
+	  (void) lock_add_non2pl_lock (res_ptr, tran_index,
+				       curr->granted_mode);
 	}
+      /* free the lock entry */
+      lock_free_entry (curr);
     }
-}
-#endif /* SERVER_MODE */
 
-#if defined(SERVER_MODE)
-/*
- * lock_internal_demote_shared_inst_lock -
- *
- * return:
- *
- *   entry_ptr(in):
- *
- * Note:demote S_LOCK -> NS_LOCK for instance in RR isolation level.
- */
-static int
-lock_internal_demote_shared_inst_lock (THREAD_ENTRY * thread_p,
-				       LK_ENTRY * entry_ptr)
-{
+  /* change total_holders_mode */
+  mode = NULL_LOCK;
+  for (i = res_ptr->holder; i != (LK_ENTRY *) NULL; i = i->next)
+    {
+      assert (i->granted_mode >= NULL_LOCK && mode >= NULL_LOCK);
+      mode = lock_Conv[i->granted_mode][mode];
+      assert (mode != NA_LOCK);
+
+      assert (i->blocked_mode >= NULL_LOCK && mode >= NULL_LOCK);
+      mode = lock_Conv[i->blocked_mode][mode];
+      assert (mode != NA_LOCK);
+    }
+  res_ptr->total_holders_mode = mode;
+
+  if (res_ptr->holder == NULL && res_ptr->waiter == NULL)
+    {
+      if (res_ptr->non2pl == NULL)
+	{
+	  /* if resource entry is empty, deallocate it. */
+	  (void) lock_dealloc_resource (res_ptr);
+	}
+      else
+	{
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
+	}
+    }
+  else
+    {
+      /* grant blocked holders and blocked waiters */
+      lock_grant_blocked_holder (thread_p, res_ptr);
+
+      (void) lock_grant_blocked_waiter (thread_p, res_ptr);
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+    }
+}
+#endif /* SERVER_MODE */
+
+/*
+ *  Private Functions Group: demote, unlock and remove locks
+ *
+ *   - lock_internal_demote_shared_class_lock()
+ *   - lock_internal_demote_update_inst_lock()
+ *   - lock_demote_shared_class_lock()
+ *   - lock_demote_all_shared_class_locks()
+ *   - lock_unlock_shared_class_lock()
+ *   - lock_unlock_shared_inst_lock()
+ *   - lock_remove_all_class_locks()
+ *   - lock_remove_all_inst_locks()
+ */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_internal_demote_shared_class_lock - Demote the shared class lock
+ *
+ * return: error code
+ *
+ *   entry_ptr(in):
+ *
+ * Note:This function demotes the lock mode of given class lock
+ *     if the lock mode is shared lock. After the demotion, this function
+ *     grants the blocked requestors if the blocked lock mode is grantable.
+ *
+ *     demote shared class lock (S_LOCK => IS_LOCK, SIX_LOCK => IX_LOCK)
+ */
+static int
+lock_internal_demote_shared_class_lock (THREAD_ENTRY * thread_p,
+					LK_ENTRY * entry_ptr)
+{
+  LK_RES *res_ptr;		/* lock resource entry pointer */
+  LK_ENTRY *check, *i;		/* lock entry pointer     */
+  LOCK total_mode;
+  int rv;
+
+  /* The caller is not holding any mutex */
+
+  if (entry_ptr->fastpath)
+    {
+      /* only IS and IX locks are granted by the fast path */
+      return NO_ERROR;
+    }
+
+  res_ptr = entry_ptr->res_head;
+  MUTEX_LOCK (rv, res_ptr->res_mutex);
+
+  /* find the given lock entry in the holder list */
+  for (check = res_ptr->holder; check != NULL; check = check->next)
+    {
+      if (check == entry_ptr)
+	{
+	  break;
+	}
+    }
+  if (check == (LK_ENTRY *) NULL)
+    {				/* not found */
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+	      ER_LK_NOTFOUND_IN_LOCK_HOLDER_LIST, 5,
+	      LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
+	      entry_ptr->tran_index,
+	      res_ptr->oid.volid, res_ptr->oid.pageid, res_ptr->oid.slotid);
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+      return ER_LK_NOTFOUND_IN_LOCK_HOLDER_LIST;
+    }
+
+#if defined(LK_DUMP)
+  if (lk_Gl.dump_level >= 1)
+    {
+      fprintf (stderr, "LK_DUMP::lk_internal_demote_shared_class_lock()\n"
+	       "  tran(%2d) : oid(%d|%d|%d), class_oid(%d|%d|%d), LOCK(%7s -> %7s)\n",
+	       entry_ptr->tran_index,
+	       entry_ptr->res_head->oid.volid,
+	       entry_ptr->res_head->oid.pageid,
+	       entry_ptr->res_head->oid.slotid,
+	       entry_ptr->res_head->class_oid.volid,
+	       entry_ptr->res_head->class_oid.pageid,
+	       entry_ptr->res_head->class_oid.slotid,
+	       LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
+	       entry_ptr->granted_mode == S_LOCK ?
+	       LOCK_TO_LOCKMODE_STRING (IS_LOCK) :
+	       (entry_ptr->granted_mode == X_LOCK ?
+		LOCK_TO_LOCKMODE_STRING (IX_LOCK) :
+		LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode)));
+    }
+#endif /* LK_DUMP */
+
+  /* demote the shared class lock(granted mode) of the lock entry */
+  switch (check->granted_mode)
+    {
+    case S_LOCK:
+      check->granted_mode = IS_LOCK;
+      break;
+
+    case SIX_LOCK:
+      check->granted_mode = IX_LOCK;
+      break;
+
+    default:
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+      return NO_ERROR;
+    }
+
+  /* change total_holders_mode */
+  total_mode = NULL_LOCK;
+  for (i = res_ptr->holder; i != NULL; i = i->next)
+    {
+      assert (i->granted_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
+      total_mode = lock_Conv[i->granted_mode][total_mode];
+      assert (total_mode != NA_LOCK);
+
+      assert (i->blocked_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
+      total_mode = lock_Conv[i->blocked_mode][total_mode];
+      assert (total_mode != NA_LOCK);
+    }
+  res_ptr->total_holders_mode = total_mode;
+
+  /* grant the blocked holders and blocked waiters */
+  lock_grant_blocked_holder (thread_p, res_ptr);
+  (void) lock_grant_blocked_waiter (thread_p, res_ptr);
+
+  MUTEX_UNLOCK (res_ptr->res_mutex);
+
+  return NO_ERROR;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_internal_demote_update_inst_lock - Demote the update instance lock
+ *
+ * return: error code
+ *
+ *   entry_ptr(in):
+ *
+ * Note:This function demotes the lock mode of given instance lock
+ *     if the lock mode is update lock. After the demotion, this function
+ *     grants the blocked requestors if the blocked lock mode is grantable.
+ *
+ *     demote update instance lock (U_LOCK => S_LOCK/NS_LOCK)
+ */
+static int
+lock_internal_demote_update_inst_lock (THREAD_ENTRY * thread_p,
+				       LK_ENTRY * entry_ptr)
+{
   LK_RES *res_ptr;		/* lock resource entry pointer */
   LK_ENTRY *check, *i;		/* lock entry pointer */
   LOCK total_mode;
@@ -5301,7 +5901,7 @@ lock_internal_demote_shared_inst_lock (THREAD_ENTRY * thread_p,
 #if defined(LK_DUMP)
   if (lk_Gl.dump_level >= 1)
     {
-      fprintf (stderr, "LK_DUMP::lk_internal_demote_shared_inst_lock()\n"
+      fprintf (stderr, "LK_DUMP::lk_internal_demote_update_inst_lock()\n"
 	       "  tran(%2d) : oid(%d|%d|%d), class_oid(%d|%d|%d), LOCK(%7s -> %7s)\n",
 	       entry_ptr->tran_index,
 	       entry_ptr->res_head->oid.volid,
@@ -5311,15 +5911,25 @@ lock_internal_demote_shared_inst_lock (THREAD_ENTRY * thread_p,
 	       entry_ptr->res_head->class_oid.pageid,
 	       entry_ptr->res_head->class_oid.slotid,
 	       LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
-	       LOCK_TO_LOCKMODE_STRING (NS_LOCK));
+	       (entry_ptr->granted_mode == U_LOCK &&
+		logtb_find_current_isolation () == TRAN_SERIALIZABLE) ?
+	       LOCK_TO_LOCKMODE_STRING (S_LOCK) :
+	       (logtb_find_current_isolation () ==
+		TRAN_REP_CLASS_REP_INSTANCE ?
+		LOCK_TO_LOCKMODE_STRING (NS_LOCK) :
+		LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode)));
     }
 #endif /* LK_DUMP */
 
   /* check and update granted mode of the lock entry */
-  if (check->granted_mode == S_LOCK)
+  if (check->granted_mode == U_LOCK)
     {
       switch (logtb_find_current_isolation (thread_p))
 	{
+	case TRAN_SERIALIZABLE:
+	  check->granted_mode = S_LOCK;
+	  break;
+
 	case TRAN_REP_CLASS_REP_INSTANCE:
 	  check->granted_mode = NS_LOCK;
 	  break;
@@ -5357,74 +5967,36 @@ lock_internal_demote_shared_inst_lock (THREAD_ENTRY * thread_p,
 
   return NO_ERROR;
 }
-
-/*
- * lock_demote_shared_inst_locks -
- *
- * return:
- *
- *   tran_index(in):
- *   scanid_bit(in):
- */
-static void
-lock_demote_shared_inst_locks (THREAD_ENTRY * thread_p, int tran_index,
-			       int scanid_bit)
-{
-  LK_TRAN_LOCK *tran_lock;
-  LK_ENTRY *curr, *next;
-  int x = 0;
-  tran_lock = &lk_Gl.tran_lock_table[tran_index];
-  for (curr = tran_lock->inst_hold_list; curr != NULL;)
-    {
-      next = curr->tran_next;
-      if (IS_SCANID_BIT_SET (curr->scanid_bitset, scanid_bit))
-	{
-	  if (curr->granted_mode == S_LOCK)
-	    {
-	      (void) lock_internal_demote_shared_inst_lock (thread_p, curr);
-	    }
-	}
-      else
-	{
-	  x = lock_find_scanid_bit (curr->scanid_bitset);
-	  if (x >= 0 && scanid_bit >= 0 && scanid_bit > x)
-	    {
-	      break;
-	    }
-	}
-      curr = next;
-    }
-}
 #endif /* SERVER_MODE */
 
+#if defined(SERVER_MODE)
 /*
- * lk_unlock_shared_class_lock: Unlock one shared class lock
+ * lock_demote_shared_class_lock -  Demote one shared class lock
  *
- * return :
+ * return:
  *
  *   tran_index(in):
  *   class_oid(in):
  *
- * Note:
- *     This function finds the lock entry whose lock object id is same
+ * Note:This function finds the lock entry whose lock object id is same
  *     with the given class_oid in the transaction lock hold list. And then,
- *     unlock the class lock if the class lock is shared mode.
- *     If the class lock mode is IS_LOCK or S_LOCK, unlock it,
- *     If the class lock mode is SIX_LOCK, demote it to IX_LOCK.
+ *     demote the class lock if the class lock is shared mode.
  */
-#if defined(SERVER_MODE)
 static void
-lock_unlock_shared_class_lock (THREAD_ENTRY * thread_p, int tran_index,
+lock_demote_shared_class_lock (THREAD_ENTRY * thread_p, int tran_index,
 			       const OID * class_oid)
 {
   LK_ENTRY *entry_ptr;
 
+  /* The caller is not holding any mutex */
+
+  /* demote only one class lock */
   entry_ptr = lock_find_class_entry (tran_index, class_oid);
   if (entry_ptr != (LK_ENTRY *) NULL)
     {
       enum
-      { SKIP, UNLOCK, DEMOTE };
-      int demote_unlock = SKIP;
+      { SKIP, DEMOTE, DECREMENT_COUNT };
+      int demote = SKIP;
 
       /* I think there's no need to acquire the mutex here. */
       if (entry_ptr->history)
@@ -5434,18 +6006,14 @@ lock_unlock_shared_class_lock (THREAD_ENTRY * thread_p, int tran_index,
 	  last = entry_ptr->recent;
 	  prev = last->prev;
 
-	  if ((last->req_mode == IS_LOCK
-	       || last->req_mode == S_LOCK
-	       || last->req_mode == SIX_LOCK)
-	      && (entry_ptr->granted_mode == IS_LOCK
-		  || entry_ptr->granted_mode == S_LOCK
+	  if ((last->req_mode == S_LOCK || last->req_mode == SIX_LOCK)
+	      && (entry_ptr->granted_mode == S_LOCK
 		  || entry_ptr->granted_mode == SIX_LOCK))
 	    {
 	      p = entry_ptr->history;
 	      while (p != last)
 		{
-		  if (p->req_mode == IS_LOCK || p->req_mode == S_LOCK
-		      || p->req_mode == SIX_LOCK)
+		  if (p->req_mode == S_LOCK || p->req_mode == SIX_LOCK)
 		    {
 		      break;
 		    }
@@ -5454,14 +6022,19 @@ lock_unlock_shared_class_lock (THREAD_ENTRY * thread_p, int tran_index,
 
 	      if (p != last)
 		{
-		  /* do not demote or unlock shared class lock */
+		  /* do not demote shared class lock */
 		}
 	      else
 		{
-		  demote_unlock =
-		    (entry_ptr->granted_mode == SIX_LOCK) ? DEMOTE : UNLOCK;
+		  demote = DEMOTE;
 		}
 	    }
+	  else if (entry_ptr->granted_mode == IS_LOCK
+		   && last->req_mode == IS_LOCK && entry_ptr->history != last)
+	    {
+	      /* has > 1 IS_LOCK */
+	      demote = DECREMENT_COUNT;
+	    }
 
 	  /* free the last node */
 	  if (prev == NULL)
@@ -5478,27 +6051,18 @@ lock_unlock_shared_class_lock (THREAD_ENTRY * thread_p, int tran_index,
 	}
       else
 	{
-	  if (entry_ptr->granted_mode == IS_LOCK
-	      || entry_ptr->granted_mode == S_LOCK)
-	    {
-	      demote_unlock = UNLOCK;
-	    }
-	  else if (entry_ptr->granted_mode == SIX_LOCK)
+	  if (entry_ptr->granted_mode == S_LOCK
+	      || entry_ptr->granted_mode == SIX_LOCK)
 	    {
-	      demote_unlock = DEMOTE;
+	      demote = DEMOTE;
 	    }
 	}
 
-      if (demote_unlock == UNLOCK)
-	{
-	  lock_internal_perform_unlock_object (thread_p, entry_ptr, false,
-					       true);
-	}
-      else if (demote_unlock == DEMOTE)
+      if (demote == DEMOTE)
 	{
 	  (void) lock_internal_demote_shared_class_lock (thread_p, entry_ptr);
 	}
-      else if (entry_ptr->granted_mode == IS_LOCK
+      else if (demote == DECREMENT_COUNT
 	       || entry_ptr->granted_mode == S_LOCK
 	       || entry_ptr->granted_mode == SIX_LOCK)
 	{
@@ -5511,52 +6075,17 @@ lock_unlock_shared_class_lock (THREAD_ENTRY * thread_p, int tran_index,
 
 #if defined(SERVER_MODE)
 /*
- * lk_unlock_shared_inst_lock - Unlock one shared instance lock
- *
- * return:
- *
- *   tran_index(in):
- *   inst_oid(in):
- *
- * Note:This function finds the lock entry whose lock object id is same
- *     with the given inst_oid in the transaction lock hold list. And then,
- *     unlock the instance lock if the instance lock is shared lock.
- */
-static void
-lock_unlock_shared_inst_lock (THREAD_ENTRY * thread_p, int tran_index,
-			      const OID * inst_oid)
-{
-  LK_ENTRY *entry_ptr;
-
-  /* unlock the shared instance lock (NS_LOCK or S_LOCK) */
-  entry_ptr = lock_find_inst_entry (tran_index, inst_oid);
-  if (entry_ptr != (LK_ENTRY *) NULL)
-    {
-      if (entry_ptr->granted_mode <= S_LOCK)
-	{
-	  lock_internal_perform_unlock_object (thread_p, entry_ptr, false,
-					       true);
-	}
-    }
-}
-#endif /* SERVER_MODE */
-
-#if defined(SERVER_MODE)
-/*
- * lock_remove_all_class_locks - Remove class locks whose lock mode is lower
- *                        than the given lock mode
+ * lock_demote_all_shared_class_locks - Demote all shared class locks
  *
  * return:
  *
  *   tran_index(in):
- *   lock(in):
  *
- * Note:This function removes class locks whose lock mode is lower than
- *     the given lock mode.
+ * Note:This function demotes all shared class locks that are held
+ *     by the given transaction.
  */
 static void
-lock_remove_all_class_locks (THREAD_ENTRY * thread_p, int tran_index,
-			     LOCK lock)
+lock_demote_all_shared_class_locks (THREAD_ENTRY * thread_p, int tran_index)
 {
   LK_TRAN_LOCK *tran_lock;
   LK_ENTRY *curr, *next;
@@ -5568,285 +6097,363 @@ lock_remove_all_class_locks (THREAD_ENTRY * thread_p, int tran_index,
 
   tran_lock = &lk_Gl.tran_lock_table[tran_index];
 
-  /* remove class locks if given condition is satisfied */
+  /* 1. demote general class locks */
   curr = tran_lock->class_hold_list;
   while (curr != (LK_ENTRY *) NULL)
     {
       next = curr->tran_next;
-      if (curr->granted_mode <= lock)
+      if (curr->granted_mode == S_LOCK || curr->granted_mode == SIX_LOCK)
 	{
-	  lock_internal_perform_unlock_object (thread_p, curr, true, false);
+	  (void) lock_internal_demote_shared_class_lock (thread_p, curr);
 	}
       curr = next;
     }
 
-  /* remove root class lock if given condition is satisfied */
+  /* 2. demote root class lock */
   curr = tran_lock->root_class_hold;
-  if (curr != NULL)
+  if (curr != (LK_ENTRY *) NULL)
     {
-      if (curr->granted_mode <= lock)
+      if (curr->granted_mode == S_LOCK || curr->granted_mode == SIX_LOCK)
 	{
-	  lock_internal_perform_unlock_object (thread_p, curr, true, false);
+	  (void) lock_internal_demote_shared_class_lock (thread_p, curr);
 	}
     }
-
 }
 #endif /* SERVER_MODE */
 
 #if defined(SERVER_MODE)
 /*
- * lock_remove_all_inst_locks - Remove instance locks whose lock mode is lower
- *                        than the given lock mode
+ * lock_internal_demote_shared_inst_lock -
  *
  * return:
  *
- *   tran_index(in):
- *   class_oid(in):
- *   lock(in):
+ *   entry_ptr(in):
  *
- * Note:This function removes instance locks whose lock mode is lower than
- *     the given lock mode.
+ * Note:demote S_LOCK -> NS_LOCK for instance in RR isolation level.
  */
-void
-lock_remove_all_inst_locks (THREAD_ENTRY * thread_p, int tran_index,
-			    const OID * class_oid, LOCK lock)
+static int
+lock_internal_demote_shared_inst_lock (THREAD_ENTRY * thread_p,
+				       LK_ENTRY * entry_ptr)
 {
-  LK_TRAN_LOCK *tran_lock;
-  LK_ENTRY *curr, *next;
+  LK_RES *res_ptr;		/* lock resource entry pointer */
+  LK_ENTRY *check, *i;		/* lock entry pointer */
+  LOCK total_mode;
+  int rv;
 
+  /* The caller is not holding any mutex */
 
-  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  res_ptr = entry_ptr->res_head;
+  MUTEX_LOCK (rv, res_ptr->res_mutex);
 
-  /* remove instance locks if given condition is satisfied */
-  curr = tran_lock->inst_hold_list;
-  while (curr != (LK_ENTRY *) NULL)
+  /* find the given lock entry in the holder list */
+  for (check = res_ptr->holder; check != NULL; check = check->next)
     {
-      next = curr->tran_next;
-      if (class_oid == NULL || OID_ISNULL (class_oid)
-	  || OID_EQ (&curr->res_head->class_oid, class_oid))
+      if (check == entry_ptr)
 	{
-	  if (curr->granted_mode <= lock)
-	    {
-	      /* found : the same class_oid and interesting lock mode
-	       * --> unlock it.
-	       */
-	      lock_internal_perform_unlock_object (thread_p, curr, true,
-						   false);
-	    }
+	  break;
 	}
-      curr = next;
+    }
+  if (check == (LK_ENTRY *) NULL)
+    {				/* not found */
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+	      ER_LK_NOTFOUND_IN_LOCK_HOLDER_LIST, 5,
+	      LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
+	      entry_ptr->tran_index,
+	      res_ptr->oid.volid, res_ptr->oid.pageid, res_ptr->oid.slotid);
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+      return ER_LK_NOTFOUND_IN_LOCK_HOLDER_LIST;
     }
 
-}
-#endif /* SERVER_MODE */
+#if defined(LK_DUMP)
+  if (lk_Gl.dump_level >= 1)
+    {
+      fprintf (stderr, "LK_DUMP::lk_internal_demote_shared_inst_lock()\n"
+	       "  tran(%2d) : oid(%d|%d|%d), class_oid(%d|%d|%d), LOCK(%7s -> %7s)\n",
+	       entry_ptr->tran_index,
+	       entry_ptr->res_head->oid.volid,
+	       entry_ptr->res_head->oid.pageid,
+	       entry_ptr->res_head->oid.slotid,
+	       entry_ptr->res_head->class_oid.volid,
+	       entry_ptr->res_head->class_oid.pageid,
+	       entry_ptr->res_head->class_oid.slotid,
+	       LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
+	       LOCK_TO_LOCKMODE_STRING (NS_LOCK));
+    }
+#endif /* LK_DUMP */
 
-#if defined(SERVER_MODE)
-/*
- * lock_find_scanid_bit -
- *
- * return:
- *
- *   scanid_bit(in):
- */
-static int
-lock_find_scanid_bit (unsigned char *scanid_bit)
-{
-  int i;
-  for (i = 0; i < PRM_LK_MAX_SCANID_BIT; i++)
+  /* check and update granted mode of the lock entry */
+  if (check->granted_mode == S_LOCK)
     {
-      if (IS_SCANID_BIT_SET (scanid_bit, i))
+      switch (logtb_find_current_isolation (thread_p))
 	{
-	  return i;
+	case TRAN_REP_CLASS_REP_INSTANCE:
+	  check->granted_mode = NS_LOCK;
+	  break;
+
+	default:
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
+	  return NO_ERROR;
 	}
     }
-  return -1;
+  else
+    {
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+      return NO_ERROR;
+    }
+
+  /* change total_holders_mode */
+  total_mode = NULL_LOCK;
+  for (i = res_ptr->holder; i != NULL; i = i->next)
+    {
+      assert (i->granted_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
+      total_mode = lock_Conv[i->granted_mode][total_mode];
+      assert (total_mode != NA_LOCK);
+
+      assert (i->blocked_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
+      total_mode = lock_Conv[i->blocked_mode][total_mode];
+      assert (total_mode != NA_LOCK);
+    }
+  res_ptr->total_holders_mode = total_mode;
+
+  /* grant the blocked holders and the blocked waiters */
+  lock_grant_blocked_holder (thread_p, res_ptr);
+  (void) lock_grant_blocked_waiter (thread_p, res_ptr);
+
+  MUTEX_UNLOCK (res_ptr->res_mutex);
+
+  return NO_ERROR;
 }
 
 /*
- * lock_remove_all_inst_locks_with_scanid -
+ * lock_demote_shared_inst_locks -
  *
  * return:
  *
  *   tran_index(in):
  *   scanid_bit(in):
- *   lock(in):
- *
- * Note:
  */
 static void
-lock_remove_all_inst_locks_with_scanid (THREAD_ENTRY * thread_p,
-					int tran_index, int scanid_bit,
-					LOCK lock)
+lock_demote_shared_inst_locks (THREAD_ENTRY * thread_p, int tran_index,
+			       int scanid_bit)
 {
   LK_TRAN_LOCK *tran_lock;
   LK_ENTRY *curr, *next;
-  bool unlock;
-  int x;
-
-
+  int x = 0;
   tran_lock = &lk_Gl.tran_lock_table[tran_index];
-
-  /* remove instance locks if given condition is satisfied */
-  curr = tran_lock->inst_hold_list;
-  while (curr != (LK_ENTRY *) NULL)
+  for (curr = tran_lock->inst_hold_list; curr != NULL;)
     {
       next = curr->tran_next;
-      if (IS_SCANID_BIT_SET (curr->scanid_bitset, scanid_bit)
-	  && curr->granted_mode <= lock)
+      if (IS_SCANID_BIT_SET (curr->scanid_bitset, scanid_bit))
 	{
-	  unlock = false;
-
-	  /* I think there's no need to acquire the mutex here. */
-
-	  if (curr->history)
+	  if (curr->granted_mode == S_LOCK)
 	    {
-	      LK_ACQUISITION_HISTORY *prev, *last, *p;
-
-	      last = curr->recent;
-	      prev = last->prev;
-	      if ((last->req_mode == S_LOCK || last->req_mode == NS_LOCK)
-		  && (curr->granted_mode == S_LOCK
-		      || curr->granted_mode == NS_LOCK))
-		{
-		  p = curr->history;
-		  while (p != last)
-		    {
-		      if (p->req_mode == S_LOCK || p->req_mode == NS_LOCK)
-			{
-			  break;
-			}
-		      p = p->next;
-		    }
+	      (void) lock_internal_demote_shared_inst_lock (thread_p, curr);
+	    }
+	}
+      else
+	{
+	  x = lock_find_scanid_bit (curr->scanid_bitset);
+	  if (x >= 0 && scanid_bit >= 0 && scanid_bit > x)
+	    {
+	      break;
+	    }
+	}
+      curr = next;
+    }
+}
+#endif /* SERVER_MODE */
 
-		  if (p != last)
-		    {
-		      /* do not unlock shared instance lock */
-		    }
-		  else
+/*
+ * lk_unlock_shared_class_lock: Unlock one shared class lock
+ *
+ * return :
+ *
+ *   tran_index(in):
+ *   class_oid(in):
+ *
+ * Note:
+ *     This function finds the lock entry whose lock object id is same
+ *     with the given class_oid in the transaction lock hold list. And then,
+ *     unlock the class lock if the class lock is shared mode.
+ *     If the class lock mode is IS_LOCK or S_LOCK, unlock it,
+ *     If the class lock mode is SIX_LOCK, demote it to IX_LOCK.
+ */
+#if defined(SERVER_MODE)
+static void
+lock_unlock_shared_class_lock (THREAD_ENTRY * thread_p, int tran_index,
+			       const OID * class_oid)
+{
+  LK_ENTRY *entry_ptr;
+
+  entry_ptr = lock_find_class_entry (tran_index, class_oid);
+  if (entry_ptr != (LK_ENTRY *) NULL)
+    {
+      enum
+      { SKIP, UNLOCK, DEMOTE };
+      int demote_unlock = SKIP;
+
+      /* I think there's no need to acquire the mutex here. */
+      if (entry_ptr->history)
+	{
+	  LK_ACQUISITION_HISTORY *prev, *last, *p;
+
+	  last = entry_ptr->recent;
+	  prev = last->prev;
+
+	  if ((last->req_mode == IS_LOCK
+	       || last->req_mode == S_LOCK
+	       || last->req_mode == SIX_LOCK)
+	      && (entry_ptr->granted_mode == IS_LOCK
+		  || entry_ptr->granted_mode == S_LOCK
+		  || entry_ptr->granted_mode == SIX_LOCK))
+	    {
+	      p = entry_ptr->history;
+	      while (p != last)
+		{
+		  if (p->req_mode == IS_LOCK || p->req_mode == S_LOCK
+		      || p->req_mode == SIX_LOCK)
 		    {
-		      unlock = true;
+		      break;
 		    }
+		  p = p->next;
 		}
 
-	      /* free the last node */
-	      if (prev == NULL)
+	      if (p != last)
 		{
-		  curr->history = NULL;
-		  curr->recent = NULL;
+		  /* do not demote or unlock shared class lock */
 		}
 	      else
 		{
-		  prev->next = NULL;
-		  curr->recent = prev;
-		}
-	      free_and_init (last);
-	    }
-	  else
-	    {
-	      if (curr->granted_mode == S_LOCK
-		  || curr->granted_mode == NS_LOCK)
-		{
-		  unlock = true;
+		  demote_unlock =
+		    (entry_ptr->granted_mode == SIX_LOCK) ? DEMOTE : UNLOCK;
 		}
 	    }
 
-	  if (unlock)
+	  /* free the last node */
+	  if (prev == NULL)
 	    {
-	      lock_internal_perform_unlock_object (thread_p, curr, false,
-						   false);
+	      entry_ptr->history = NULL;
+	      entry_ptr->recent = NULL;
 	    }
-	  else if (curr->granted_mode == S_LOCK
-		   || curr->granted_mode == NS_LOCK)
+	  else
 	    {
-	      curr->count--;
+	      prev->next = NULL;
+	      entry_ptr->recent = prev;
 	    }
-
+	  free_and_init (last);
 	}
       else
 	{
-	  x = lock_find_scanid_bit (curr->scanid_bitset);
-	  if (x >= 0 && scanid_bit >= 0 && scanid_bit > x)
+	  if (entry_ptr->granted_mode == IS_LOCK
+	      || entry_ptr->granted_mode == S_LOCK)
 	    {
-	      break;
+	      demote_unlock = UNLOCK;
+	    }
+	  else if (entry_ptr->granted_mode == SIX_LOCK)
+	    {
+	      demote_unlock = DEMOTE;
 	    }
 	}
-      curr = next;
+
+      if (demote_unlock == UNLOCK)
+	{
+	  lock_internal_perform_unlock_object (thread_p, entry_ptr, false,
+					       true);
+	}
+      else if (demote_unlock == DEMOTE)
+	{
+	  (void) lock_internal_demote_shared_class_lock (thread_p, entry_ptr);
+	}
+      else if (entry_ptr->granted_mode == IS_LOCK
+	       || entry_ptr->granted_mode == S_LOCK
+	       || entry_ptr->granted_mode == SIX_LOCK)
+	{
+	  entry_ptr->count--;
+	}
+
     }
 }
 #endif /* SERVER_MODE */
 
+#if defined(SERVER_MODE)
 /*
- *  Private Functions Group: non two pahse locks
+ * lk_unlock_shared_inst_lock - Unlock one shared instance lock
  *
- *   - lk_remove_non2pl()
- *   - lk_update_non2pl_list()
+ * return:
+ *
+ *   tran_index(in):
+ *   inst_oid(in):
+ *
+ * Note:This function finds the lock entry whose lock object id is same
+ *     with the given inst_oid in the transaction lock hold list. And then,
+ *     unlock the instance lock if the instance lock is shared lock.
  */
+static void
+lock_unlock_shared_inst_lock (THREAD_ENTRY * thread_p, int tran_index,
+			      const OID * inst_oid)
+{
+  LK_ENTRY *entry_ptr;
+
+  /* unlock the shared instance lock (NS_LOCK or S_LOCK) */
+  entry_ptr = lock_find_inst_entry (tran_index, inst_oid);
+  if (entry_ptr != (LK_ENTRY *) NULL)
+    {
+      if (entry_ptr->granted_mode <= S_LOCK)
+	{
+	  lock_internal_perform_unlock_object (thread_p, entry_ptr, false,
+					       true);
+	}
+    }
+}
+#endif /* SERVER_MODE */
 
 #if defined(SERVER_MODE)
 /*
- * lock_remove_non2pl -
+ * lock_remove_all_class_locks - Remove class locks whose lock mode is lower
+ *                        than the given lock mode
  *
  * return:
  *
- *   non2pl(in):
  *   tran_index(in):
+ *   lock(in):
+ *
+ * Note:This function removes class locks whose lock mode is lower than
+ *     the given lock mode.
  */
 static void
-lock_remove_non2pl (LK_ENTRY * non2pl, int tran_index)
+lock_remove_all_class_locks (THREAD_ENTRY * thread_p, int tran_index,
+			     LOCK lock)
 {
-  LK_RES *res_ptr;
-  LK_ENTRY *prev, *curr;
-  int rv;
+  LK_TRAN_LOCK *tran_lock;
+  LK_ENTRY *curr, *next;
 
-  /* The given non2pl entry has already been removed from
-   * the transaction non2pl list.
-   * Therefore, This function removes the given non2pl entry
-   * from the resource non2pl list and then frees the entry.
+  /* When this function is called, only one thread is executing
+   * for the transaction. (transaction : thread = 1 : 1)
+   * Therefore, there is no need to hold tran_lock->hold_mutex.
    */
 
-  res_ptr = non2pl->res_head;
-  MUTEX_LOCK (rv, res_ptr->res_mutex);
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
 
-  /* find the given non2pl in non2pl list of resource entry */
-  prev = (LK_ENTRY *) NULL;
-  curr = res_ptr->non2pl;
+  /* remove class locks if given condition is satisfied */
+  curr = tran_lock->class_hold_list;
   while (curr != (LK_ENTRY *) NULL)
     {
-      if (curr->tran_index == tran_index)
+      next = curr->tran_next;
+      if (curr->granted_mode <= lock)
 	{
-	  break;
+	  lock_internal_perform_unlock_object (thread_p, curr, true, false);
 	}
-      prev = curr;
-      curr = curr->next;
-    }
-  if (curr == (LK_ENTRY *) NULL)
-    {				/* not found */
-      MUTEX_UNLOCK (res_ptr->res_mutex);
-      return;
-    }
-
-  /* found : remove it */
-  if (prev == (LK_ENTRY *) NULL)
-    {
-      res_ptr->non2pl = curr->next;
-    }
-  else
-    {
-      prev->next = curr->next;
+      curr = next;
     }
-  /* (void)lk_delete_from_tran_non2pl_list(curr); */
-
-  /* free the lock entry */
-  lock_free_entry (curr);
 
-  if (res_ptr->holder == NULL && res_ptr->waiter == NULL
-      && res_ptr->non2pl == NULL)
-    {
-      (void) lock_dealloc_resource (res_ptr);
-    }
-  else
+  /* remove root class lock if given condition is satisfied */
+  curr = tran_lock->root_class_hold;
+  if (curr != NULL)
     {
-      MUTEX_UNLOCK (res_ptr->res_mutex);
+      if (curr->granted_mode <= lock)
+	{
+	  lock_internal_perform_unlock_object (thread_p, curr, true, false);
+	}
     }
 
 }
@@ -5854,1164 +6461,1423 @@ lock_remove_non2pl (LK_ENTRY * non2pl, int tran_index)
 
 #if defined(SERVER_MODE)
 /*
- * lock_update_non2pl_list -
+ * lock_remove_all_inst_locks - Remove instance locks whose lock mode is lower
+ *                        than the given lock mode
  *
  * return:
  *
- *   res_ptr(in):
  *   tran_index(in):
+ *   class_oid(in):
  *   lock(in):
+ *
+ * Note:This function removes instance locks whose lock mode is lower than
+ *     the given lock mode.
  */
-static void
-lock_update_non2pl_list (LK_RES * res_ptr, int tran_index, LOCK lock)
+void
+lock_remove_all_inst_locks (THREAD_ENTRY * thread_p, int tran_index,
+			    const OID * class_oid, LOCK lock)
 {
-  LK_ENTRY *prev;
-  LK_ENTRY *curr;
-  LK_ENTRY *next;
   LK_TRAN_LOCK *tran_lock;
-  int rv;
-  int compat;
+  LK_ENTRY *curr, *next;
 
-  /* The caller is holding a resource mutex */
 
-  prev = (LK_ENTRY *) NULL;
-  curr = res_ptr->non2pl;
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+
+  /* remove instance locks if given condition is satisfied */
+  curr = tran_lock->inst_hold_list;
   while (curr != (LK_ENTRY *) NULL)
     {
-      if (curr->tran_index == tran_index)
-	{			/* same transaction */
-	  /* remove current non2pl entry */
-	  next = curr->next;
-	  if (prev == (LK_ENTRY *) NULL)
-	    {
-	      res_ptr->non2pl = curr->next;
-	    }
-	  else
-	    {
-	      prev->next = curr->next;
-	    }
-	  (void) lock_delete_from_tran_non2pl_list (curr);
-	  lock_free_entry (curr);
-	  curr = next;
-	}
-      else
-	{			/* different transaction */
-	  if (curr->granted_mode != INCON_NON_TWO_PHASE_LOCK)
+      next = curr->tran_next;
+      if (class_oid == NULL || OID_ISNULL (class_oid)
+	  || OID_EQ (&curr->res_head->class_oid, class_oid))
+	{
+	  if (curr->granted_mode <= lock)
 	    {
-	      /* The transaction with the released lock must decache the lock
-	       * object since an incompatible locks has been acquired.
-	       * This implies that the transaction with the released lock
-	       * may not be serializable (repeatable read consistent) any longer.
+	      /* found : the same class_oid and interesting lock mode
+	       * --> unlock it.
 	       */
-	      assert (lock >= NULL_LOCK && curr->granted_mode >= NULL_LOCK);
-	      compat = lock_Comp[lock][curr->granted_mode];
-	      assert (compat != DB_NA);
-
-	      if (compat == false)
-		{
-		  curr->granted_mode = INCON_NON_TWO_PHASE_LOCK;
-		  tran_lock = &lk_Gl.tran_lock_table[curr->tran_index];
-		  MUTEX_LOCK (rv, tran_lock->non2pl_mutex);
-		  tran_lock->num_incons_non2pl += 1;
-		  MUTEX_UNLOCK (tran_lock->non2pl_mutex);
-		}
+	      lock_internal_perform_unlock_object (thread_p, curr, true,
+						   false);
 	    }
-	  prev = curr;
-	  curr = curr->next;
 	}
+      curr = next;
     }
 
 }
 #endif /* SERVER_MODE */
 
-/*
- *  Private Functions Group: local deadlock detection and resolution
- *
- *   - lk_add_WFG_edge()
- */
-
 #if defined(SERVER_MODE)
 /*
- * lock_add_WFG_edge -
- *
- * return: error code
+ * lock_find_scanid_bit -
  *
- *   from_tran_index(in): waiting transaction index
- *   to_tran_index(in): waited transaction index
- *   holder_flag(in): true(if to_tran_index is Holder), false(otherwise)
- *   edge_wait_stime(in):
+ * return:
  *
- * Note:add an edge to WFG which represents that
- *     'from_tran_index' transaction waits for 'to_tran_index' transaction.
+ *   scanid_bit(in):
  */
 static int
-lock_add_WFG_edge (int from_tran_index, int to_tran_index,
-		   int holder_flag, time_t edge_wait_stime)
+lock_find_scanid_bit (unsigned char *scanid_bit)
 {
-  int prev, curr;
   int i;
-  int alloc_idx;
-  char *temp_ptr;
-
-  /* check if the transactions has been selected as victims */
-  /* Note that the transactions might be old deadlock victims */
-  if (lk_Gl.TWFG_node[from_tran_index].DL_victim == true
-      || lk_Gl.TWFG_node[to_tran_index].DL_victim == true)
-    {
-      return NO_ERROR;
-    }
-
-  /* increment global edge sequence number */
-  lk_Gl.global_edge_seq_num++;
-
-  if (lk_Gl.TWFG_node[from_tran_index].checked_by_deadlock_detector == false)
-    {
-      /* a new transaction started */
-      if (lk_Gl.TWFG_node[from_tran_index].first_edge != -1)
-	{
-	  prev = -1;
-	  curr = lk_Gl.TWFG_node[from_tran_index].first_edge;
-	  while (curr != -1)
-	    {
-	      prev = curr;
-	      curr = lk_Gl.TWFG_edge[curr].next;
-	    }
-	  lk_Gl.TWFG_edge[prev].next = lk_Gl.TWFG_free_edge_idx;
-	  lk_Gl.TWFG_free_edge_idx =
-	    lk_Gl.TWFG_node[from_tran_index].first_edge;
-	  lk_Gl.TWFG_node[from_tran_index].first_edge = -1;
-	}
-      lk_Gl.TWFG_node[from_tran_index].checked_by_deadlock_detector = true;
-      lk_Gl.TWFG_node[from_tran_index].tran_edge_seq_num =
-	lk_Gl.global_edge_seq_num;
-    }
-
-  if (lk_Gl.TWFG_node[to_tran_index].checked_by_deadlock_detector == false)
+  for (i = 0; i < PRM_LK_MAX_SCANID_BIT; i++)
     {
-      /* a new transaction started */
-      if (lk_Gl.TWFG_node[to_tran_index].first_edge != -1)
-	{
-	  prev = -1;
-	  curr = lk_Gl.TWFG_node[to_tran_index].first_edge;
-	  while (curr != -1)
-	    {
-	      prev = curr;
-	      curr = lk_Gl.TWFG_edge[curr].next;
-	    }
-	  lk_Gl.TWFG_edge[prev].next = lk_Gl.TWFG_free_edge_idx;
-	  lk_Gl.TWFG_free_edge_idx =
-	    lk_Gl.TWFG_node[to_tran_index].first_edge;
-	  lk_Gl.TWFG_node[to_tran_index].first_edge = -1;
-	}
-      lk_Gl.TWFG_node[to_tran_index].checked_by_deadlock_detector = true;
-      lk_Gl.TWFG_node[to_tran_index].tran_edge_seq_num =
-	lk_Gl.global_edge_seq_num;
-    }
-
-  /* NOTE the following description..
-   * According to the above code, whenever it is identified that
-   * a transaction has been terminated during deadlock detection,
-   * the transaction is checked again as a new transaction. And,
-   * the current edge is based on the current active transactions.
-   */
-
-  if (lk_Gl.TWFG_free_edge_idx == -1)
-    {				/* too many WFG edges */
-      if (lk_Gl.max_TWFG_edge == LK_MIN_TWFG_EDGE_COUNT)
-	{
-	  lk_Gl.max_TWFG_edge = LK_MID_TWFG_EDGE_COUNT;
-	  for (i = LK_MIN_TWFG_EDGE_COUNT; i < lk_Gl.max_TWFG_edge; i++)
-	    {
-	      lk_Gl.TWFG_edge[i].to_tran_index = -1;
-	      lk_Gl.TWFG_edge[i].next = (i + 1);
-	    }
-	  lk_Gl.TWFG_edge[lk_Gl.max_TWFG_edge - 1].next = -1;
-	  lk_Gl.TWFG_free_edge_idx = LK_MIN_TWFG_EDGE_COUNT;
-	}
-      else if (lk_Gl.max_TWFG_edge == LK_MID_TWFG_EDGE_COUNT)
-	{
-	  temp_ptr = (char *) lk_Gl.TWFG_edge;
-	  lk_Gl.max_TWFG_edge = LK_MAX_TWFG_EDGE_COUNT;
-	  lk_Gl.TWFG_edge =
-	    (LK_WFG_EDGE *) malloc (SIZEOF_LK_WFG_EDGE * lk_Gl.max_TWFG_edge);
-	  if (lk_Gl.TWFG_edge == (LK_WFG_EDGE *) NULL)
-	    {
-	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
-		      ER_OUT_OF_VIRTUAL_MEMORY, 1,
-		      (SIZEOF_LK_WFG_EDGE * lk_Gl.max_TWFG_edge));
-	      return ER_OUT_OF_VIRTUAL_MEMORY;	/* no method */
-	    }
-	  (void) memcpy ((char *) lk_Gl.TWFG_edge, temp_ptr,
-			 (SIZEOF_LK_WFG_EDGE * LK_MID_TWFG_EDGE_COUNT));
-	  for (i = LK_MID_TWFG_EDGE_COUNT; i < lk_Gl.max_TWFG_edge; i++)
-	    {
-	      lk_Gl.TWFG_edge[i].to_tran_index = -1;
-	      lk_Gl.TWFG_edge[i].next = (i + 1);
-	    }
-	  lk_Gl.TWFG_edge[lk_Gl.max_TWFG_edge - 1].next = -1;
-	  lk_Gl.TWFG_free_edge_idx = LK_MID_TWFG_EDGE_COUNT;
-	}
-      else
+      if (IS_SCANID_BIT_SET (scanid_bit, i))
 	{
-#if defined(CUBRID_DEBUG)
-	  er_log_debug (ARG_FILE_LINE, "So many TWFG edges are used..\n");
-#endif /* CUBRID_DEBUG */
-	  return ER_FAILED;	/* no method */
+	  return i;
 	}
     }
-
-  /* allocate free WFG edge */
-  alloc_idx = lk_Gl.TWFG_free_edge_idx;
-  lk_Gl.TWFG_free_edge_idx = lk_Gl.TWFG_edge[alloc_idx].next;
-
-  /* set WFG edge with given information */
-  lk_Gl.TWFG_edge[alloc_idx].to_tran_index = to_tran_index;
-  lk_Gl.TWFG_edge[alloc_idx].edge_seq_num = lk_Gl.global_edge_seq_num;
-  lk_Gl.TWFG_edge[alloc_idx].holder_flag = holder_flag;
-  lk_Gl.TWFG_edge[alloc_idx].edge_wait_stime = edge_wait_stime;
-
-  /* connect the WFG edge into WFG */
-  lk_Gl.TWFG_edge[alloc_idx].next =
-    lk_Gl.TWFG_node[from_tran_index].first_edge;
-  lk_Gl.TWFG_node[from_tran_index].first_edge = alloc_idx;
-
-  return NO_ERROR;
+  return -1;
 }
-#endif /* SERVER_MODE */
 
-#if defined(SERVER_MODE)
 /*
- * lock_select_deadlock_victim -
+ * lock_remove_all_inst_locks_with_scanid -
  *
  * return:
  *
- *   s(in):
- *   t(in):
+ *   tran_index(in):
+ *   scanid_bit(in):
+ *   lock(in):
  *
  * Note:
  */
 static void
-lock_select_deadlock_victim (THREAD_ENTRY * thread_p, int s, int t)
+lock_remove_all_inst_locks_with_scanid (THREAD_ENTRY * thread_p,
+					int tran_index, int scanid_bit,
+					LOCK lock)
 {
-  LK_WFG_NODE *TWFG_node;
-  LK_WFG_EDGE *TWFG_edge;
-  TRANID tranid;
-  int can_timeout;
-  int u, v, w;
-  bool false_dd_cycle = false;
-  bool lock_holder_found = false;
-  bool inact_trans_found = false;
-  int tot_WFG_nodes;
-#if defined(CUBRID_DEBUG)
-  int num_WFG_nodes;
-  int WFG_nidx;
-  int tran_index_area[20];
-  int *tran_index_set = &tran_index_area[0];
-#endif
+  LK_TRAN_LOCK *tran_lock;
+  LK_ENTRY *curr, *next;
+  bool unlock;
+  int x;
 
-  /* simple notation */
-  TWFG_node = lk_Gl.TWFG_node;
-  TWFG_edge = lk_Gl.TWFG_edge;
 
-  /*
-   * check if current deadlock cycle is false deadlock cycle
-   */
-  tot_WFG_nodes = 0;
-  if (TWFG_node[t].current == -1)
-    {
-      /* old WFG edge : remove it */
-      TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
-      false_dd_cycle = true;
-    }
-  else
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+
+  /* remove instance locks if given condition is satisfied */
+  curr = tran_lock->inst_hold_list;
+  while (curr != (LK_ENTRY *) NULL)
     {
-      if (TWFG_node[t].checked_by_deadlock_detector == false
-	  || TWFG_node[t].thrd_wait_stime == 0
-	  || (TWFG_node[t].thrd_wait_stime >
-	      TWFG_edge[TWFG_node[t].current].edge_wait_stime))
-	{
-	  /* old transaction, not lockwait state, or incorrect WFG edge */
-	  /* remove all outgoing edges */
-	  TWFG_node[t].first_edge = -1;
-	  TWFG_node[t].current = -1;
-	  /* remove incoming edge */
-	  TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
-	  false_dd_cycle = true;
-	}
-      else
+      next = curr->tran_next;
+      if (IS_SCANID_BIT_SET (curr->scanid_bitset, scanid_bit)
+	  && curr->granted_mode <= lock)
 	{
-	  if (TWFG_edge[TWFG_node[s].current].edge_seq_num
-	      < TWFG_node[t].tran_edge_seq_num)
+	  unlock = false;
+
+	  /* I think there's no need to acquire the mutex here. */
+
+	  if (curr->history)
 	    {
-	      /* old WFG edge : remove it */
-	      TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
-	      false_dd_cycle = true;
+	      LK_ACQUISITION_HISTORY *prev, *last, *p;
+
+	      last = curr->recent;
+	      prev = last->prev;
+	      if ((last->req_mode == S_LOCK || last->req_mode == NS_LOCK)
+		  && (curr->granted_mode == S_LOCK
+		      || curr->granted_mode == NS_LOCK))
+		{
+		  p = curr->history;
+		  while (p != last)
+		    {
+		      if (p->req_mode == S_LOCK || p->req_mode == NS_LOCK)
+			{
+			  break;
+			}
+		      p = p->next;
+		    }
+
+		  if (p != last)
+		    {
+		      /* do not unlock shared instance lock */
+		    }
+		  else
+		    {
+		      unlock = true;
+		    }
+		}
+
+	      /* free the last node */
+	      if (prev == NULL)
+		{
+		  curr->history = NULL;
+		  curr->recent = NULL;
+		}
+	      else
+		{
+		  prev->next = NULL;
+		  curr->recent = prev;
+		}
+	      free_and_init (last);
 	    }
 	  else
 	    {
-	      tot_WFG_nodes += 1;
+	      if (curr->granted_mode == S_LOCK
+		  || curr->granted_mode == NS_LOCK)
+		{
+		  unlock = true;
+		}
 	    }
-	}
-    }
-  for (v = s; v != t;)
-    {
-      u = lk_Gl.TWFG_node[v].ancestor;
-      if (TWFG_node[v].current == -1)
-	{
-	  /* old WFG edge : remove it */
-	  TWFG_edge[TWFG_node[u].current].to_tran_index = -2;
-	  false_dd_cycle = true;
-	}
-      else
-	{
-	  if (TWFG_node[v].checked_by_deadlock_detector == false
-	      || TWFG_node[v].thrd_wait_stime == 0
-	      || (TWFG_node[v].thrd_wait_stime >
-		  TWFG_edge[TWFG_node[v].current].edge_wait_stime))
+
+	  if (unlock)
 	    {
-	      /* old transaction, not lockwait state, or incorrect WFG edge */
-	      /* remove all outgoing edges */
-	      TWFG_node[v].first_edge = -1;
-	      TWFG_node[v].current = -1;
-	      /* remove incoming edge */
-	      TWFG_edge[TWFG_node[u].current].to_tran_index = -2;
-	      false_dd_cycle = true;
+	      lock_internal_perform_unlock_object (thread_p, curr, false,
+						   false);
 	    }
-	  else
+	  else if (curr->granted_mode == S_LOCK
+		   || curr->granted_mode == NS_LOCK)
 	    {
-	      if (TWFG_edge[TWFG_node[u].current].edge_seq_num
-		  < TWFG_node[v].tran_edge_seq_num)
-		{
-		  /* old WFG edge : remove it */
-		  TWFG_edge[TWFG_node[u].current].to_tran_index = -2;
-		  false_dd_cycle = true;
-		}
-	      else
-		{
-		  tot_WFG_nodes += 1;
-		}
+	      curr->count--;
 	    }
-	}
-      v = u;
-    }
 
-  if (false_dd_cycle == true)
-    {				/* clear deadlock cycle */
-      for (v = s; v != t;)
+	}
+      else
 	{
-	  w = TWFG_node[v].ancestor;
-	  TWFG_node[v].ancestor = -1;
-	  v = w;
+	  x = lock_find_scanid_bit (curr->scanid_bitset);
+	  if (x >= 0 && scanid_bit >= 0 && scanid_bit > x)
+	    {
+	      break;
+	    }
 	}
-      return;
+      curr = next;
     }
+}
+#endif /* SERVER_MODE */
 
-  /*
-     Victim Selection Strategy
-     1) Must be lock holder.
-     2) Must be active transaction.
-     3) Prefer a transaction with a closer timeout.
-     4) Prefer the youngest transaction.
+/*
+ *  Private Functions Group: non two pahse locks
+ *
+ *   - lk_remove_non2pl()
+ *   - lk_update_non2pl_list()
+ */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_remove_non2pl -
+ *
+ * return:
+ *
+ *   non2pl(in):
+ *   tran_index(in):
+ */
+static void
+lock_remove_non2pl (LK_ENTRY * non2pl, int tran_index)
+{
+  LK_RES *res_ptr;
+  LK_ENTRY *prev, *curr;
+  int rv;
+
+  /* The given non2pl entry has already been removed from
+   * the transaction non2pl list.
+   * Therefore, This function removes the given non2pl entry
+   * from the resource non2pl list and then frees the entry.
    */
-#if defined(CUBRID_DEBUG)
-  num_WFG_nodes = tot_WFG_nodes;
-  if (num_WFG_nodes > 20)
+
+  res_ptr = non2pl->res_head;
+  MUTEX_LOCK (rv, res_ptr->res_mutex);
+
+  /* find the given non2pl in non2pl list of resource entry */
+  prev = (LK_ENTRY *) NULL;
+  curr = res_ptr->non2pl;
+  while (curr != (LK_ENTRY *) NULL)
     {
-      tran_index_set = (int *) malloc (sizeof (int) * num_WFG_nodes);
-      if (tran_index_set == NULL)
+      if (curr->tran_index == tran_index)
 	{
-	  num_WFG_nodes = 20;
-	  tran_index_set = &tran_index_area[0];
+	  break;
 	}
+      prev = curr;
+      curr = curr->next;
+    }
+  if (curr == (LK_ENTRY *) NULL)
+    {				/* not found */
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+      return;
     }
-  WFG_nidx = 0;
 
-  if (TWFG_node[t].checked_by_deadlock_detector == false)
+  /* found : remove it */
+  if (prev == (LK_ENTRY *) NULL)
     {
-      er_log_debug (ARG_FILE_LINE,
-		    "transaction(index=%d) is old in deadlock cycle\n", t);
+      res_ptr->non2pl = curr->next;
     }
-#endif /* CUBRID_DEBUG */
-  if (TWFG_edge[TWFG_node[s].current].holder_flag)
+  else
     {
-      tranid = logtb_find_tranid (t);
-      if (logtb_is_active (thread_p, tranid) == false)
-	{
-	  victims[victim_count].tran_index = NULL_TRAN_INDEX;
-	  inact_trans_found = true;
-#if defined(CUBRID_DEBUG)
-	  er_log_debug (ARG_FILE_LINE,
-			"Inactive transaction is found in a deadlock cycle\n"
-			"(tran_index=%d, tranid=%d, state=%s)\n",
-			t, tranid, log_state_string (logtb_find_state (t)));
-	  tran_index_set[WFG_nidx] = t;
-	  WFG_nidx += 1;
-#endif /* CUBRID_DEBUG */
-	}
-      else
-	{
-	  victims[victim_count].tran_index = t;
-	  victims[victim_count].tranid = tranid;
-	  victims[victim_count].can_timeout =
-	    LK_CAN_TIMEOUT (logtb_find_wait_secs (t));
-	  lock_holder_found = true;
-	}
+      prev->next = curr->next;
+    }
+  /* (void)lk_delete_from_tran_non2pl_list(curr); */
+
+  /* free the lock entry */
+  lock_free_entry (curr);
+
+  if (res_ptr->holder == NULL && res_ptr->waiter == NULL
+      && res_ptr->non2pl == NULL)
+    {
+      (void) lock_dealloc_resource (res_ptr);
     }
   else
     {
-      victims[victim_count].tran_index = NULL_TRAN_INDEX;
-#if defined(CUBRID_DEBUG)
-      tran_index_set[WFG_nidx] = t;
-      WFG_nidx += 1;
-#endif
+      MUTEX_UNLOCK (res_ptr->res_mutex);
     }
 
-  for (v = s; v != t;)
-    {
-#if defined(CUBRID_DEBUG)
-      if (TWFG_node[v].checked_by_deadlock_detector == false)
-	{
-	  er_log_debug (ARG_FILE_LINE,
-			"transaction(index=%d) is old in deadlock cycle\n",
-			v);
-	}
-#endif /* CUBRID_DEBUG */
-      if (TWFG_node[v].candidate == true)
-	{
-	  tranid = logtb_find_tranid (v);
-	  if (logtb_is_active (thread_p, tranid) == false)
-	    {
-	      inact_trans_found = true;
-#if defined(CUBRID_DEBUG)
-	      er_log_debug (ARG_FILE_LINE,
-			    "Inactive transaction is found in a deadlock cycle\n"
-			    "(tran_index=%d, tranid=%d, state=%s)\n",
-			    v, tranid,
-			    log_state_string (logtb_find_state (v)));
-	      tran_index_set[WFG_nidx] = v;
-	      WFG_nidx += 1;
-#endif /* CUBRID_DEBUG */
-	    }
-	  else
-	    {
-	      lock_holder_found = true;
-	      can_timeout = LK_CAN_TIMEOUT (logtb_find_wait_secs (v));
-	      if (victims[victim_count].tran_index == NULL_TRAN_INDEX
-		  || (victims[victim_count].can_timeout == false
-		      && can_timeout == true)
-		  || (victims[victim_count].can_timeout == can_timeout
-		      && LK_ISYOUNGER (tranid, victims[victim_count].tranid)))
-		{
-		  victims[victim_count].tran_index = v;
-		  victims[victim_count].tranid = tranid;
-		  victims[victim_count].can_timeout = can_timeout;
-		}
-	    }
-	}
-#if defined(CUBRID_DEBUG)
-      else
-	{			/* TWFG_node[v].candidate == false */
-	  tran_index_set[WFG_nidx] = v;
-	  WFG_nidx += 1;
-	}
-#endif
-      w = TWFG_node[v].ancestor;
-      TWFG_node[v].ancestor = -1;
-      v = w;
-    }
-
-  if (victims[victim_count].tran_index != NULL_TRAN_INDEX)
-    {
-#if defined(CUBRID_DEBUG)
-      if (TWFG_node[victims[victim_count].tran_index].
-	  checked_by_deadlock_detector == false)
-	{
-	  er_log_debug (ARG_FILE_LINE,
-			"victim(index=%d) is old in deadlock cycle\n",
-			victims[victim_count].tran_index);
-	}
-#endif /* CUBRID_DEBUG */
-      TWFG_node[victims[victim_count].tran_index].current = -1;
-      victim_count++;
-    }
-  else
-    {
-#if defined(CUBRID_DEBUG)
-      er_log_debug (ARG_FILE_LINE, "No victim in deadlock cycle....\n");
-      if (lock_holder_foumnd == false)
-	{
-	  er_log_debug (ARG_FILE_LINE,
-			"Any Lock holder is not found in deadlock cycle.\n");
-	}
-      if (inact_trans_found == true)
-	{
-	  er_log_debug (ARG_FILE_LINE,
-			"Inactive transactions are found in deadlock cycle.\n");
-	}
-      er_log_debug (ARG_FILE_LINE,
-		    "total_edges=%d, free_edge_idx=%d, global_edge_seq=%d\n",
-		    lk_Gl.max_TWFG_edge, lk_Gl.TWFG_free_edge_idx,
-		    lk_Gl.global_edge_seq_num);
-      er_log_debug (ARG_FILE_LINE,
-		    "# of WFG nodes in deadlock cycle = %d (%d printed)\n",
-		    tot_WFG_nodes, num_WFG_nodes);
-      for (WFG_nidx = 0; WFG_nidx < num_WFG_nodes; WFG_nidx++)
-	{
-	  er_log_debug (ARG_FILE_LINE, "%3d ", tran_index_set[WFG_nidx]);
-	  if ((WFG_nidx + 1) == num_WFG_nodes || (WFG_nidx % 10) == 9)
-	    {
-	      er_log_debug (ARG_FILE_LINE, "\n");
-	    }
-	}
-#endif /* CUBRID_DEBUG */
-      /* wait for some short time */
-      /* TODO: remove const 1000 */
-      thread_sleep (0, 1000);	/* sleep for 1000 micro seconds */
-    }
 }
 #endif /* SERVER_MODE */
 
 #if defined(SERVER_MODE)
 /*
- * lock_dump_deadlock_victims -
+ * lock_update_non2pl_list -
  *
  * return:
+ *
+ *   res_ptr(in):
+ *   tran_index(in):
+ *   lock(in):
  */
 static void
-lock_dump_deadlock_victims (THREAD_ENTRY * thread_p)
+lock_update_non2pl_list (LK_RES * res_ptr, int tran_index, LOCK lock)
 {
-  int k, count;
+  LK_ENTRY *prev;
+  LK_ENTRY *curr;
+  LK_ENTRY *next;
+  LK_TRAN_LOCK *tran_lock;
+  int rv;
+  int compat;
 
-  /*
-     lk_Gl.dump_level_when_deadlock
-     0: Don't print anything about deadlock informatin.
-     1: Print only the transaction indexes of deadlock victims.
-     2: Number 1 and deadlock solve functions
-     3: Number 2 and dump lock tables
-     cf) Print only the transactions involved in the cycle and the
-     selected victims (not possible at the current time)
-   */
-  if (lk_Gl.dump_level_when_deadlock == 1)
-    {				/* level 1 */
-      fprintf (stderr, "..... deadlock victims list begin ......\n");
-      fprintf (stderr, "## global_edge_seq_num = %d\n",
-	       lk_Gl.global_edge_seq_num);
-      fprintf (stderr, "## DL victim count = %d\n", victim_count);
-      fprintf (stderr, "## DL victims like followings:\n");
-      for (k = 0; k < victim_count; k++)
-	{
-	  fprintf (stderr, "%3d ", victims[k].tran_index);
-	  if ((k % 10) == 9)
+  /* The caller is holding a resource mutex */
+
+  prev = (LK_ENTRY *) NULL;
+  curr = res_ptr->non2pl;
+  while (curr != (LK_ENTRY *) NULL)
+    {
+      if (curr->tran_index == tran_index)
+	{			/* same transaction */
+	  /* remove current non2pl entry */
+	  next = curr->next;
+	  if (prev == (LK_ENTRY *) NULL)
 	    {
-	      fprintf (stderr, "\n");
+	      res_ptr->non2pl = curr->next;
 	    }
-	}
-      fprintf (stderr, "\n..... deadlock victims list end ......\n\n");
-    }
-  else
-    {				/* level 2 or 3 */
-      fprintf (stderr, "..... deadlock victims list begin ......\n");
-      fprintf (stderr, "## global_edge_seq_num = %d\n",
-	       lk_Gl.global_edge_seq_num);
-      fprintf (stderr, "## DL victim count = %d\n", victim_count);
-      fprintf (stderr, "## DL victims like followings:\n");
-      /* print aborted transactions (deadlock victims) */
-      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				       MSGCAT_SET_LOCK,
-				       MSGCAT_LK_DEADLOCK_ABORT_HDR));
-      count = 0;
-      for (k = 0; k < victim_count; k++)
-	{
-	  if (!victims[k].can_timeout)
+	  else
 	    {
-	      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
-					       MSGCAT_SET_LOCK,
-					       MSGCAT_LK_DEADLOCK_ABORT),
-		       victims[k].tran_index);
-	      if ((count % 10) == 9)
-		{
-		  fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
-						   MSGCAT_SET_LOCK,
-						   MSGCAT_LK_NEWLINE));
-		}
-	      count++;
+	      prev->next = curr->next;
 	    }
+	  (void) lock_delete_from_tran_non2pl_list (curr);
+	  lock_free_entry (curr);
+	  curr = next;
 	}
-      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				       MSGCAT_SET_LOCK, MSGCAT_LK_NEWLINE));
-      /* print timeout transactions (deadlock victims) */
-      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				       MSGCAT_SET_LOCK,
-				       MSGCAT_LK_DEADLOCK_TIMEOUT_HDR));
-      count = 0;
-      for (k = 0; k < victim_count; k++)
-	{
-	  if (victims[k].can_timeout)
+      else
+	{			/* different transaction */
+	  if (curr->granted_mode != INCON_NON_TWO_PHASE_LOCK)
 	    {
-	      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
-					       MSGCAT_SET_LOCK,
-					       MSGCAT_LK_DEADLOCK_TIMEOUT),
-		       victims[k].tran_index);
-	      if ((count % 10) == 9)
+	      /* The transaction with the released lock must decache the lock
+	       * object since an incompatible locks has been acquired.
+	       * This implies that the transaction with the released lock
+	       * may not be serializable (repeatable read consistent) any longer.
+	       */
+	      assert (lock >= NULL_LOCK && curr->granted_mode >= NULL_LOCK);
+	      compat = lock_Comp[lock][curr->granted_mode];
+	      assert (compat != DB_NA);
+
+	      if (compat == false)
 		{
-		  fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
-						   MSGCAT_SET_LOCK,
-						   MSGCAT_LK_NEWLINE));
+		  curr->granted_mode = INCON_NON_TWO_PHASE_LOCK;
+		  tran_lock = &lk_Gl.tran_lock_table[curr->tran_index];
+		  MUTEX_LOCK (rv, tran_lock->non2pl_mutex);
+		  tran_lock->num_incons_non2pl += 1;
+		  MUTEX_UNLOCK (tran_lock->non2pl_mutex);
 		}
-	      count++;
-	    }
-	}
-      fprintf (stderr, "\n..... deadlock victims list end ......\n\n");
-
-      /* dump object lock table */
-      if (lk_Gl.dump_level_when_deadlock == 3)
-	{
-	  if (lk_Gl.dump_lock_table_count < 100)
-	    {
-	      lk_Gl.dump_lock_table_count++;
-	    }
-	  else
-	    {
-	      xlock_dump (thread_p, NULL);
-	      lk_Gl.dump_lock_table_count = 0;
 	    }
+	  prev = curr;
+	  curr = curr->next;
 	}
     }
+
 }
 #endif /* SERVER_MODE */
 
 /*
- *  Private Functions Group: miscellaneous functions
+ *  Private Functions Group: local deadlock detection and resolution
  *
- *   - lk_lockinfo_compare()
- *   - lk_dump_res()
- *   - lk_consistent_res()
- *   - lk_consistent_tran_lock()
+ *   - lk_add_WFG_edge()
  */
 
 #if defined(SERVER_MODE)
 /*
- * lock_compare_lock_info -
+ * lock_add_WFG_edge -
  *
- * return:
+ * return: error code
  *
- *   lockinfo1(in):
- *   lockinfo2(in):
+ *   from_tran_index(in): waiting transaction index
+ *   to_tran_index(in): waited transaction index
+ *   holder_flag(in): true(if to_tran_index is Holder), false(otherwise)
+ *   edge_wait_stime(in):
  *
- * Note:compare two OID of lockable objects.
+ * Note:add an edge to WFG which represents that
+ *     'from_tran_index' transaction waits for 'to_tran_index' transaction.
  */
 static int
-lock_compare_lock_info (const void *lockinfo1, const void *lockinfo2)
-{
-  const OID *oid1;
-  const OID *oid2;
-
-  oid1 = &(((LK_LOCKINFO *) (lockinfo1))->oid);
-  oid2 = &(((LK_LOCKINFO *) (lockinfo2))->oid);
-
-  return oid_compare (oid1, oid2);
-}
-#endif /* SERVER_MODE */
-
-#if defined(SERVER_MODE)
-/*
- * lock_dump_resource - Dump locks acquired on a resource
- *
- * return:
- *
- *   outfp(in): FILE stream where to dump the lock resource entry.
- *   res_ptr(in): pointer to lock resource entry
- *
- * Note:Dump contents of the lock resource entry pointed by res_ptr.
- */
-static void
-lock_dump_resource (THREAD_ENTRY * thread_p, FILE * outfp, LK_RES * res_ptr)
+lock_add_WFG_edge (int from_tran_index, int to_tran_index,
+		   int holder_flag, time_t edge_wait_stime)
 {
-  LK_ENTRY *entry_ptr;
-  char *classname;		/* Name of the class */
-  int num_holders, num_blocked_holders, num_waiters;
-  char time_val[64];
+  int prev, curr;
+  int i;
+  int alloc_idx;
+  char *temp_ptr;
 
-  memset (time_val, 0, sizeof (time_val));
+  /* check if the transactions has been selected as victims */
+  /* Note that the transactions might be old deadlock victims */
+  if (lk_Gl.TWFG_node[from_tran_index].DL_victim == true
+      || lk_Gl.TWFG_node[to_tran_index].DL_victim == true)
+    {
+      return NO_ERROR;
+    }
 
-  /* dump object identifier */
-  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				  MSGCAT_SET_LOCK,
-				  MSGCAT_LK_RES_OID), res_ptr->oid.volid,
-	   res_ptr->oid.pageid, res_ptr->oid.slotid);
+  /* increment global edge sequence number */
+  lk_Gl.global_edge_seq_num++;
 
-  /* dump object type related information */
-  switch (res_ptr->type)
+  if (lk_Gl.TWFG_node[from_tran_index].checked_by_deadlock_detector == false)
     {
-    case LOCK_RESOURCE_ROOT_CLASS:
-      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				      MSGCAT_SET_LOCK,
-				      MSGCAT_LK_RES_ROOT_CLASS_TYPE));
-      break;
-    case LOCK_RESOURCE_CLASS:
-      classname = heap_get_class_name (thread_p, &res_ptr->oid);
-      if (classname == NULL)
+      /* a new transaction started */
+      if (lk_Gl.TWFG_node[from_tran_index].first_edge != -1)
 	{
-	  /* We must stop processing if an interrupt occurs */
-	  if (er_errid () == ER_INTERRUPTED)
+	  prev = -1;
+	  curr = lk_Gl.TWFG_node[from_tran_index].first_edge;
+	  while (curr != -1)
 	    {
-	      return;
+	      prev = curr;
+	      curr = lk_Gl.TWFG_edge[curr].next;
 	    }
+	  lk_Gl.TWFG_edge[prev].next = lk_Gl.TWFG_free_edge_idx;
+	  lk_Gl.TWFG_free_edge_idx =
+	    lk_Gl.TWFG_node[from_tran_index].first_edge;
+	  lk_Gl.TWFG_node[from_tran_index].first_edge = -1;
 	}
-      else
-	{
-	  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-					  MSGCAT_SET_LOCK,
-					  MSGCAT_LK_RES_CLASS_TYPE),
-		   classname);
-	  free_and_init (classname);
-	}
-      break;
-    case LOCK_RESOURCE_INSTANCE:
-      classname = heap_get_class_name (thread_p, &res_ptr->class_oid);
-      if (classname == NULL)
+      lk_Gl.TWFG_node[from_tran_index].checked_by_deadlock_detector = true;
+      lk_Gl.TWFG_node[from_tran_index].tran_edge_seq_num =
+	lk_Gl.global_edge_seq_num;
+    }
+
+  if (lk_Gl.TWFG_node[to_tran_index].checked_by_deadlock_detector == false)
+    {
+      /* a new transaction started */
+      if (lk_Gl.TWFG_node[to_tran_index].first_edge != -1)
 	{
-	  /* We must stop processing if an interrupt occurs */
-	  if (er_errid () == ER_INTERRUPTED)
+	  prev = -1;
+	  curr = lk_Gl.TWFG_node[to_tran_index].first_edge;
+	  while (curr != -1)
 	    {
-	      return;
+	      prev = curr;
+	      curr = lk_Gl.TWFG_edge[curr].next;
 	    }
+	  lk_Gl.TWFG_edge[prev].next = lk_Gl.TWFG_free_edge_idx;
+	  lk_Gl.TWFG_free_edge_idx =
+	    lk_Gl.TWFG_node[to_tran_index].first_edge;
+	  lk_Gl.TWFG_node[to_tran_index].first_edge = -1;
 	}
-      else
-	{
-	  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-					  MSGCAT_SET_LOCK,
-					  MSGCAT_LK_RES_INSTANCE_TYPE),
-		   res_ptr->class_oid.volid, res_ptr->class_oid.pageid,
-		   res_ptr->class_oid.slotid, classname);
-	  free_and_init (classname);
-	}
-      break;
-    default:
-      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				      MSGCAT_SET_LOCK,
-				      MSGCAT_LK_RES_UNKNOWN_TYPE));
+      lk_Gl.TWFG_node[to_tran_index].checked_by_deadlock_detector = true;
+      lk_Gl.TWFG_node[to_tran_index].tran_edge_seq_num =
+	lk_Gl.global_edge_seq_num;
     }
 
-  /* dump total modes of holders and waiters */
-  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				  MSGCAT_SET_LOCK,
-				  MSGCAT_LK_RES_TOTAL_MODE),
-	   LOCK_TO_LOCKMODE_STRING (res_ptr->total_holders_mode),
-	   LOCK_TO_LOCKMODE_STRING (res_ptr->total_waiters_mode));
+  /* NOTE the following description..
+   * According to the above code, whenever it is identified that
+   * a transaction has been terminated during deadlock detection,
+   * the transaction is checked again as a new transaction. And,
+   * the current edge is based on the current active transactions.
+   */
 
-  num_holders = num_blocked_holders = 0;
-  if (res_ptr->holder != (LK_ENTRY *) NULL)
-    {
-      entry_ptr = res_ptr->holder;
-      while (entry_ptr != NULL)
+  if (lk_Gl.TWFG_free_edge_idx == -1)
+    {				/* too many WFG edges */
+      if (lk_Gl.max_TWFG_edge == LK_MIN_TWFG_EDGE_COUNT)
 	{
-	  if (entry_ptr->blocked_mode == NULL_LOCK)
+	  lk_Gl.max_TWFG_edge = LK_MID_TWFG_EDGE_COUNT;
+	  for (i = LK_MIN_TWFG_EDGE_COUNT; i < lk_Gl.max_TWFG_edge; i++)
 	    {
-	      num_holders++;
+	      lk_Gl.TWFG_edge[i].to_tran_index = -1;
+	      lk_Gl.TWFG_edge[i].next = (i + 1);
 	    }
-	  else
+	  lk_Gl.TWFG_edge[lk_Gl.max_TWFG_edge - 1].next = -1;
+	  lk_Gl.TWFG_free_edge_idx = LK_MIN_TWFG_EDGE_COUNT;
+	}
+      else if (lk_Gl.max_TWFG_edge == LK_MID_TWFG_EDGE_COUNT)
+	{
+	  temp_ptr = (char *) lk_Gl.TWFG_edge;
+	  lk_Gl.max_TWFG_edge = LK_MAX_TWFG_EDGE_COUNT;
+	  lk_Gl.TWFG_edge =
+	    (LK_WFG_EDGE *) malloc (SIZEOF_LK_WFG_EDGE * lk_Gl.max_TWFG_edge);
+	  if (lk_Gl.TWFG_edge == (LK_WFG_EDGE *) NULL)
 	    {
-	      num_blocked_holders++;
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+		      ER_OUT_OF_VIRTUAL_MEMORY, 1,
+		      (SIZEOF_LK_WFG_EDGE * lk_Gl.max_TWFG_edge));
+	      return ER_OUT_OF_VIRTUAL_MEMORY;	/* no method */
 	    }
-	  entry_ptr = entry_ptr->next;
+	  (void) memcpy ((char *) lk_Gl.TWFG_edge, temp_ptr,
+			 (SIZEOF_LK_WFG_EDGE * LK_MID_TWFG_EDGE_COUNT));
+	  for (i = LK_MID_TWFG_EDGE_COUNT; i < lk_Gl.max_TWFG_edge; i++)
+	    {
+	      lk_Gl.TWFG_edge[i].to_tran_index = -1;
+	      lk_Gl.TWFG_edge[i].next = (i + 1);
+	    }
+	  lk_Gl.TWFG_edge[lk_Gl.max_TWFG_edge - 1].next = -1;
+	  lk_Gl.TWFG_free_edge_idx = LK_MID_TWFG_EDGE_COUNT;
 	}
-    }
-  num_waiters = 0;
-  if (res_ptr->waiter != (LK_ENTRY *) NULL)
-    {
-      entry_ptr = res_ptr->waiter;
-      while (entry_ptr != (LK_ENTRY *) NULL)
+      else
 	{
-	  num_waiters++;
-	  entry_ptr = entry_ptr->next;
+#if defined(CUBRID_DEBUG)
+	  er_log_debug (ARG_FILE_LINE, "So many TWFG edges are used..\n");
+#endif /* CUBRID_DEBUG */
+	  return ER_FAILED;	/* no method */
 	}
     }
 
-  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				  MSGCAT_SET_LOCK,
-				  MSGCAT_LK_RES_LOCK_COUNT), num_holders,
-	   num_blocked_holders, num_waiters);
+  /* allocate free WFG edge */
+  alloc_idx = lk_Gl.TWFG_free_edge_idx;
+  lk_Gl.TWFG_free_edge_idx = lk_Gl.TWFG_edge[alloc_idx].next;
 
-  /* dump holders */
-  if (num_holders > 0)
-    {
-      /* dump non blocked holders */
-      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				      MSGCAT_SET_LOCK,
-				      MSGCAT_LK_RES_NON_BLOCKED_HOLDER_HEAD));
-      entry_ptr = res_ptr->holder;
-      while (entry_ptr != (LK_ENTRY *) NULL)
-	{
-	  if (entry_ptr->blocked_mode == NULL_LOCK)
-	    {
-	      if (res_ptr->type == LOCK_RESOURCE_INSTANCE)
-		{
-		  fprintf (outfp,
-			   msgcat_message (MSGCAT_CATALOG_CUBRID,
-					   MSGCAT_SET_LOCK,
-					   MSGCAT_LK_RES_NON_BLOCKED_HOLDER_ENTRY),
-			   "", entry_ptr->tran_index,
-			   LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
-			   entry_ptr->count);
-		}
-	      else
-		{
-		  fprintf (outfp,
-			   msgcat_message (MSGCAT_CATALOG_CUBRID,
-					   MSGCAT_SET_LOCK,
-					   MSGCAT_LK_RES_NON_BLOCKED_HOLDER_ENTRY_WITH_GRANULE),
-			   "", entry_ptr->tran_index,
-			   LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
-			   entry_ptr->count, entry_ptr->ngranules);
-		}
-	    }
-	  entry_ptr = entry_ptr->next;
-	}
-    }
+  /* set WFG edge with given information */
+  lk_Gl.TWFG_edge[alloc_idx].to_tran_index = to_tran_index;
+  lk_Gl.TWFG_edge[alloc_idx].edge_seq_num = lk_Gl.global_edge_seq_num;
+  lk_Gl.TWFG_edge[alloc_idx].holder_flag = holder_flag;
+  lk_Gl.TWFG_edge[alloc_idx].edge_wait_stime = edge_wait_stime;
 
-  if (num_blocked_holders > 0)
-    {
-      /* dump blocked holders */
-      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				      MSGCAT_SET_LOCK,
-				      MSGCAT_LK_RES_BLOCKED_HOLDER_HEAD));
-      entry_ptr = res_ptr->holder;
-      while (entry_ptr != (LK_ENTRY *) NULL)
-	{
-	  if (entry_ptr->blocked_mode != NULL_LOCK)
-	    {
-	      time_t stime =
-		(time_t) (entry_ptr->thrd_entry->lockwait_stime / 1000);
-#if defined(WINDOWS)
-	      strcpy (time_val, ctime (&stime));
-#else /* WINDOWS */
-	      if (ctime_r (&stime, time_val) == NULL)
-		{
-		  strcpy (time_val, "???");
-		}
-#endif /* WINDOWS */
-	      if (time_val[strlen (time_val) - 1] == '\n')
-		{
-		  time_val[strlen (time_val) - 1] = 0;
-		}
-	      if (res_ptr->type == LOCK_RESOURCE_INSTANCE)
-		{
-		  fprintf (outfp,
-			   msgcat_message (MSGCAT_CATALOG_CUBRID,
-					   MSGCAT_SET_LOCK,
-					   MSGCAT_LK_RES_BLOCKED_HOLDER_ENTRY),
-			   "", entry_ptr->tran_index,
-			   LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
-			   entry_ptr->count, "",
-			   LOCK_TO_LOCKMODE_STRING (entry_ptr->blocked_mode),
-			   "", time_val, "",
-			   entry_ptr->thrd_entry->lockwait_nsecs);
-		}
-	      else
-		{
-		  fprintf (outfp,
-			   msgcat_message (MSGCAT_CATALOG_CUBRID,
-					   MSGCAT_SET_LOCK,
-					   MSGCAT_LK_RES_BLOCKED_HOLDER_ENTRY_WITH_GRANULE),
-			   "", entry_ptr->tran_index,
-			   LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
-			   entry_ptr->count, entry_ptr->ngranules, "",
-			   LOCK_TO_LOCKMODE_STRING (entry_ptr->blocked_mode),
-			   "", time_val, "",
-			   entry_ptr->thrd_entry->lockwait_nsecs);
-		}
-	    }
-	  entry_ptr = entry_ptr->next;
-	}
-    }
-
-  /* dump blocked waiters */
-  if (res_ptr->waiter != (LK_ENTRY *) NULL)
-    {
-      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				      MSGCAT_SET_LOCK,
-				      MSGCAT_LK_RES_BLOCKED_WAITER_HEAD));
-      entry_ptr = res_ptr->waiter;
-      while (entry_ptr != (LK_ENTRY *) NULL)
-	{
-	  time_t stime =
-	    (time_t) (entry_ptr->thrd_entry->lockwait_stime / 1000);
-#if defined(WINDOWS)
-	  strcpy (time_val, ctime (&stime));
-#else /* WINDOWS */
-	  ctime_r (&stime, time_val);
-#endif /* WINDOWS */
-	  if (time_val[strlen (time_val) - 1] == '\n')
-	    {
-	      time_val[strlen (time_val) - 1] = 0;
-	    }
-	  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-					  MSGCAT_SET_LOCK,
-					  MSGCAT_LK_RES_BLOCKED_WAITER_ENTRY),
-		   "", entry_ptr->tran_index,
-		   LOCK_TO_LOCKMODE_STRING (entry_ptr->blocked_mode), "",
-		   time_val, "", entry_ptr->thrd_entry->lockwait_nsecs);
-	  entry_ptr = entry_ptr->next;
-	}
-    }
-
-  /* dump non two phase locks */
-  if (res_ptr->non2pl != NULL)
-    {
-      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				      MSGCAT_SET_LOCK,
-				      MSGCAT_LK_RES_NON2PL_RELEASED_HEAD));
-      entry_ptr = res_ptr->non2pl;
-      while (entry_ptr != (LK_ENTRY *) NULL)
-	{
-	  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-					  MSGCAT_SET_LOCK,
-					  MSGCAT_LK_RES_NON2PL_RELEASED_ENTRY),
-		   "", entry_ptr->tran_index,
-		   ((entry_ptr->granted_mode ==
-		     INCON_NON_TWO_PHASE_LOCK) ? "INCON_NON_TWO_PHASE_LOCK" :
-		    LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode)));
-	  entry_ptr = entry_ptr->next;
-	}
-    }
-  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
-				  MSGCAT_SET_LOCK, MSGCAT_LK_NEWLINE));
+  /* connect the WFG edge into WFG */
+  lk_Gl.TWFG_edge[alloc_idx].next =
+    lk_Gl.TWFG_node[from_tran_index].first_edge;
+  lk_Gl.TWFG_node[from_tran_index].first_edge = alloc_idx;
 
+  return NO_ERROR;
 }
 #endif /* SERVER_MODE */
 
-#if defined(ENABLE_UNUSED_FUNCTION)
 #if defined(SERVER_MODE)
 /*
- * lock_check_consistent_resource - Check if the lock resource entry is consistent
+ * lock_select_deadlock_victim -
  *
- * return: true/false
+ * return:
  *
- *   res_ptr(in):
+ *   s(in):
+ *   t(in):
  *
- * Note:Verify if a lock entry is consistent. At least one waiter must be
- *     waiting on at least one transaction holding a lock, otherwise,
- *     an inconsistent entry exist. Some waiters may be waiting on waiters.
+ * Note:
  */
-static bool
-lock_check_consistent_resource (THREAD_ENTRY * thread_p, LK_RES * res_ptr)
+static void
+lock_select_deadlock_victim (THREAD_ENTRY * thread_p, int s, int t)
 {
-  LOCK total_mode;
-  LK_ENTRY *i, *j;
-  const char *msg_str;
-  int rv;
-
-  /* hold resource mutex */
-  MUTEX_LOCK (rv, res_ptr->res_mutex);
-
-  /* check total_holders_mode (total mode of lock holders) */
-  total_mode = NULL_LOCK;
-  for (i = res_ptr->holder; i != NULL; i = i->next)
-    {
-      assert (i->granted_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
-      total_mode = lock_Conv[i->granted_mode][total_mode];
-      assert (total_mode != NA_LOCK);
+  LK_WFG_NODE *TWFG_node;
+  LK_WFG_EDGE *TWFG_edge;
+  TRANID tranid;
+  int can_timeout;
+  int u, v, w;
+  bool false_dd_cycle = false;
+  bool lock_holder_found = false;
+  bool inact_trans_found = false;
+  int tot_WFG_nodes;
+#if defined(CUBRID_DEBUG)
+  int num_WFG_nodes;
+  int WFG_nidx;
+  int tran_index_area[20];
+  int *tran_index_set = &tran_index_area[0];
+#endif
 
-      assert (i->blocked_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
-      total_mode = lock_Conv[i->blocked_mode][total_mode];
-      assert (total_mode != NA_LOCK);
-    }
-  if (total_mode != res_ptr->total_holders_mode)
-    {
-      msg_str = "lk_consistent_res: total mode of holders is inconsistent.";
-      goto inconsistent;
-    }
+  /* simple notation */
+  TWFG_node = lk_Gl.TWFG_node;
+  TWFG_edge = lk_Gl.TWFG_edge;
 
-  /* check total_waiters_mode (total mode of lock waiters) */
-  total_mode = NULL_LOCK;
-  for (i = res_ptr->waiter; i != NULL; i = i->next)
-    {
-      assert (i->blocked_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
-      total_mode = lock_Conv[i->blocked_mode][total_mode];
-      assert (total_mode != NA_LOCK);
-    }
-  if (total_mode != res_ptr->total_waiters_mode)
+  /*
+   * check if current deadlock cycle is false deadlock cycle
+   */
+  tot_WFG_nodes = 0;
+  if (TWFG_node[t].current == -1)
     {
-      msg_str = "lk_consistent_res: total mode of waiters is incons.";
-      goto inconsistent;
+      /* old WFG edge : remove it */
+      TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
+      false_dd_cycle = true;
     }
-
-  /* check holders : lock information */
-  for (i = res_ptr->holder; i != NULL; i = i->next)
+  else
     {
-      /* check res_head */
-      if (i->res_head != res_ptr)
-	{
-	  msg_str = "lk_consistent_res: res_head of a holder is incons.";
-	  goto inconsistent;
-	}
-      /* check tran_index */
-      for (j = res_ptr->holder; j != NULL && j != i; j = j->next)
-	{
-	  if (j->tran_index == i->tran_index)
-	    {
-	      msg_str =
-		"lk_consistent_res: tran_index of a holder is incons. (1)";
-	      goto inconsistent;
-	    }
-	}
-      for (j = res_ptr->waiter; j != NULL; j = j->next)
+      if (TWFG_node[t].checked_by_deadlock_detector == false
+	  || TWFG_node[t].thrd_wait_stime == 0
+	  || (TWFG_node[t].thrd_wait_stime >
+	      TWFG_edge[TWFG_node[t].current].edge_wait_stime))
 	{
-	  if (j->tran_index == i->tran_index)
-	    {
-	      msg_str =
-		"lk_consistent_res: tran_index of a holder is incons. (2)";
-	      goto inconsistent;
-	    }
+	  /* old transaction, not lockwait state, or incorrect WFG edge */
+	  /* remove all outgoing edges */
+	  TWFG_node[t].first_edge = -1;
+	  TWFG_node[t].current = -1;
+	  /* remove incoming edge */
+	  TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
+	  false_dd_cycle = true;
 	}
-      for (j = res_ptr->non2pl; j != NULL; j = j->next)
+      else
 	{
-	  if (j->tran_index == i->tran_index)
+	  if (TWFG_edge[TWFG_node[s].current].edge_seq_num
+	      < TWFG_node[t].tran_edge_seq_num)
 	    {
-	      msg_str =
-		"lk_consistent_res: tran_index of a holder is incons. (3)";
-	      goto inconsistent;
+	      /* old WFG edge : remove it */
+	      TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
+	      false_dd_cycle = true;
 	    }
-	}
-      /* check thrd_entry */
-      if (i->blocked_mode != NULL_LOCK)
-	{
-	  if (i->thrd_entry == NULL)
+	  else
 	    {
-	      msg_str =
-		"lk_consistent_res: thrd_entry of a blocked holder is incons.";
-	      goto inconsistent;
+	      tot_WFG_nodes += 1;
 	    }
 	}
     }
-
-  /* check lock waiters */
-  for (i = res_ptr->waiter; i != NULL; i = i->next)
+  for (v = s; v != t;)
     {
-      /* check res_head */
-      if (i->res_head != res_ptr)
+      u = lk_Gl.TWFG_node[v].ancestor;
+      if (TWFG_node[v].current == -1)
 	{
-	  msg_str = "lk_consistent_res: res_head of a waiter is incons.";
-	  goto inconsistent;
+	  /* old WFG edge : remove it */
+	  TWFG_edge[TWFG_node[u].current].to_tran_index = -2;
+	  false_dd_cycle = true;
 	}
-      /* check tran_index */
-      for (j = res_ptr->holder; j != NULL; j = j->next)
+      else
 	{
-	  if (j->tran_index == i->tran_index)
+	  if (TWFG_node[v].checked_by_deadlock_detector == false
+	      || TWFG_node[v].thrd_wait_stime == 0
+	      || (TWFG_node[v].thrd_wait_stime >
+		  TWFG_edge[TWFG_node[v].current].edge_wait_stime))
 	    {
-	      msg_str =
-		"lk_consistent_res: tran_index of a waiter is incons. (1)";
-	      goto inconsistent;
-	    }
-	}
-      for (j = res_ptr->waiter; j != NULL && j != i; j = j->next)
-	{
-	  if (j->tran_index == i->tran_index)
+	      /* old transaction, not lockwait state, or incorrect WFG edge */
+	      /* remove all outgoing edges */
+	      TWFG_node[v].first_edge = -1;
+	      TWFG_node[v].current = -1;
+	      /* remove incoming edge */
+	      TWFG_edge[TWFG_node[u].current].to_tran_index = -2;
+	      false_dd_cycle = true;
+	    }
+	  else
 	    {
-	      msg_str =
-		"lk_consistent_res: tran_index of a waiter is incons. (2)";
-	      goto inconsistent;
+	      if (TWFG_edge[TWFG_node[u].current].edge_seq_num
+		  < TWFG_node[v].tran_edge_seq_num)
+		{
+		  /* old WFG edge : remove it */
+		  TWFG_edge[TWFG_node[u].current].to_tran_index = -2;
+		  false_dd_cycle = true;
+		}
+	      else
+		{
+		  tot_WFG_nodes += 1;
+		}
 	    }
 	}
-      for (j = res_ptr->non2pl; j != NULL; j = j->next)
+      v = u;
+    }
+
+  if (false_dd_cycle == true)
+    {				/* clear deadlock cycle */
+      for (v = s; v != t;)
 	{
-	  if (j->tran_index == i->tran_index)
-	    {
-	      msg_str =
-		"lk_consistent_res: tran_index of a waiter is incons. (3)";
-	      goto inconsistent;
-	    }
+	  w = TWFG_node[v].ancestor;
+	  TWFG_node[v].ancestor = -1;
+	  v = w;
 	}
-      /* check lock mode */
-      if (i->blocked_mode == NULL_LOCK)
+      return;
+    }
+
+  /*
+     Victim Selection Strategy
+     1) Must be lock holder.
+     2) Must be active transaction.
+     3) Prefer a transaction with a closer timeout.
+     4) Prefer the youngest transaction.
+   */
+#if defined(CUBRID_DEBUG)
+  num_WFG_nodes = tot_WFG_nodes;
+  if (num_WFG_nodes > 20)
+    {
+      tran_index_set = (int *) malloc (sizeof (int) * num_WFG_nodes);
+      if (tran_index_set == NULL)
 	{
-	  msg_str = "lk_consistent_res: blocked_mode of a waiter is incons.";
-	  goto inconsistent;
+	  num_WFG_nodes = 20;
+	  tran_index_set = &tran_index_area[0];
 	}
-      /* check thrd_entry */
-      if (i->thrd_entry == NULL)
+    }
+  WFG_nidx = 0;
+
+  if (TWFG_node[t].checked_by_deadlock_detector == false)
+    {
+      er_log_debug (ARG_FILE_LINE,
+		    "transaction(index=%d) is old in deadlock cycle\n", t);
+    }
+#endif /* CUBRID_DEBUG */
+  if (TWFG_edge[TWFG_node[s].current].holder_flag)
+    {
+      tranid = logtb_find_tranid (t);
+      if (logtb_is_active (thread_p, tranid) == false)
 	{
-	  msg_str = "lk_consistent_res: thrd_entry of a waiter is incons.";
-	  goto inconsistent;
+	  victims[victim_count].tran_index = NULL_TRAN_INDEX;
+	  inact_trans_found = true;
+#if defined(CUBRID_DEBUG)
+	  er_log_debug (ARG_FILE_LINE,
+			"Inactive transaction is found in a deadlock cycle\n"
+			"(tran_index=%d, tranid=%d, state=%s)\n",
+			t, tranid, log_state_string (logtb_find_state (t)));
+	  tran_index_set[WFG_nidx] = t;
+	  WFG_nidx += 1;
+#endif /* CUBRID_DEBUG */
+	}
+      else
+	{
+	  victims[victim_count].tran_index = t;
+	  victims[victim_count].tranid = tranid;
+	  victims[victim_count].can_timeout =
+	    LK_CAN_TIMEOUT (logtb_find_wait_secs (t));
+	  lock_holder_found = true;
 	}
     }
+  else
+    {
+      victims[victim_count].tran_index = NULL_TRAN_INDEX;
+#if defined(CUBRID_DEBUG)
+      tran_index_set[WFG_nidx] = t;
+      WFG_nidx += 1;
+#endif
+    }
 
-  /* check non2pl locks */
-  for (i = res_ptr->non2pl; i != NULL; i = i->next)
+  for (v = s; v != t;)
     {
-      /* check tran_index */
-      for (j = res_ptr->holder; j != NULL; j = j->next)
+#if defined(CUBRID_DEBUG)
+      if (TWFG_node[v].checked_by_deadlock_detector == false)
 	{
-	  if (j->tran_index == i->tran_index)
-	    {
-	      msg_str =
-		"lk_consistent_res: tran_index of a non2pl is incons. (1)";
-	      goto inconsistent;
-	    }
+	  er_log_debug (ARG_FILE_LINE,
+			"transaction(index=%d) is old in deadlock cycle\n",
+			v);
 	}
-      for (j = res_ptr->waiter; j != NULL; j = j->next)
+#endif /* CUBRID_DEBUG */
+      if (TWFG_node[v].candidate == true)
 	{
-	  if (j->tran_index == i->tran_index)
+	  tranid = logtb_find_tranid (v);
+	  if (logtb_is_active (thread_p, tranid) == false)
 	    {
-	      msg_str =
-		"lk_consistent_res: tran_index of a non2pl is incons. (2)";
-	      goto inconsistent;
+	      inact_trans_found = true;
+#if defined(CUBRID_DEBUG)
+	      er_log_debug (ARG_FILE_LINE,
+			    "Inactive transaction is found in a deadlock cycle\n"
+			    "(tran_index=%d, tranid=%d, state=%s)\n",
+			    v, tranid,
+			    log_state_string (logtb_find_state (v)));
+	      tran_index_set[WFG_nidx] = v;
+	      WFG_nidx += 1;
+#endif /* CUBRID_DEBUG */
+	    }
+	  else
+	    {
+	      lock_holder_found = true;
+	      can_timeout = LK_CAN_TIMEOUT (logtb_find_wait_secs (v));
+	      if (victims[victim_count].tran_index == NULL_TRAN_INDEX
+		  || (victims[victim_count].can_timeout == false
+		      && can_timeout == true)
+		  || (victims[victim_count].can_timeout == can_timeout
+		      && LK_ISYOUNGER (tranid, victims[victim_count].tranid)))
+		{
+		  victims[victim_count].tran_index = v;
+		  victims[victim_count].tranid = tranid;
+		  victims[victim_count].can_timeout = can_timeout;
+		}
 	    }
 	}
-      for (j = res_ptr->non2pl; j != NULL && j != i; j = j->next)
+#if defined(CUBRID_DEBUG)
+      else
+	{			/* TWFG_node[v].candidate == false */
+	  tran_index_set[WFG_nidx] = v;
+	  WFG_nidx += 1;
+	}
+#endif
+      w = TWFG_node[v].ancestor;
+      TWFG_node[v].ancestor = -1;
+      v = w;
+    }
+
+  if (victims[victim_count].tran_index != NULL_TRAN_INDEX)
+    {
+#if defined(CUBRID_DEBUG)
+      if (TWFG_node[victims[victim_count].tran_index].
+	  checked_by_deadlock_detector == false)
 	{
-	  if (j->tran_index == i->tran_index)
+	  er_log_debug (ARG_FILE_LINE,
+			"victim(index=%d) is old in deadlock cycle\n",
+			victims[victim_count].tran_index);
+	}
+#endif /* CUBRID_DEBUG */
+      TWFG_node[victims[victim_count].tran_index].current = -1;
+      victim_count++;
+    }
+  else
+    {
+#if defined(CUBRID_DEBUG)
+      er_log_debug (ARG_FILE_LINE, "No victim in deadlock cycle....\n");
+      if (lock_holder_foumnd == false)
+	{
+	  er_log_debug (ARG_FILE_LINE,
+			"Any Lock holder is not found in deadlock cycle.\n");
+	}
+      if (inact_trans_found == true)
+	{
+	  er_log_debug (ARG_FILE_LINE,
+			"Inactive transactions are found in deadlock cycle.\n");
+	}
+      er_log_debug (ARG_FILE_LINE,
+		    "total_edges=%d, free_edge_idx=%d, global_edge_seq=%d\n",
+		    lk_Gl.max_TWFG_edge, lk_Gl.TWFG_free_edge_idx,
+		    lk_Gl.global_edge_seq_num);
+      er_log_debug (ARG_FILE_LINE,
+		    "# of WFG nodes in deadlock cycle = %d (%d printed)\n",
+		    tot_WFG_nodes, num_WFG_nodes);
+      for (WFG_nidx = 0; WFG_nidx < num_WFG_nodes; WFG_nidx++)
+	{
+	  er_log_debug (ARG_FILE_LINE, "%3d ", tran_index_set[WFG_nidx]);
+	  if ((WFG_nidx + 1) == num_WFG_nodes || (WFG_nidx % 10) == 9)
 	    {
-	      msg_str =
-		"lk_consistent_res: tran_index of a non2pl is incons. (3)";
-	      goto inconsistent;
+	      er_log_debug (ARG_FILE_LINE, "\n");
 	    }
 	}
+#endif /* CUBRID_DEBUG */
+      /* wait for some short time */
+      /* TODO: remove const 1000 */
+      thread_sleep (0, 1000);	/* sleep for 1000 micro seconds */
     }
-
-  /* consistent */
-  MUTEX_UNLOCK (res_ptr->res_mutex);
-  return true;
-
-inconsistent:
-  lock_dump_resource (thread_p, stdout, res_ptr);
-  MUTEX_UNLOCK (res_ptr->res_mutex);
-  er_log_debug (ARG_FILE_LINE, msg_str);
-  return false;
 }
 #endif /* SERVER_MODE */
 
 #if defined(SERVER_MODE)
 /*
- * lock_check_consistent_tran_lock - Check consistency of transaction lock info entry
- *
- * return: true/false
- *
- *   tran_lock(in): ponter to the transaction lock information entry
+ * lock_dump_deadlock_victims -
  *
- * Note:check if the given transaction lock information enrtry is consistent.
+ * return:
  */
-static bool
-lock_check_consistent_tran_lock (LK_TRAN_LOCK * tran_lock)
+static void
+lock_dump_deadlock_victims (THREAD_ENTRY * thread_p)
 {
-  int count;
-  LK_ENTRY *i;
-  int rv;
-
-  /* hold transaction hold mutex */
-  MUTEX_LOCK (rv, tran_lock->hold_mutex);
+  int k, count;
 
-  /* check held locks */
-  /* check inst_hold_count and class_hold_count */
-  for (count = 0, i = tran_lock->inst_hold_list; i != NULL; i = i->tran_next)
-    {
-      count++;
-    }
-  if (count != tran_lock->inst_hold_count)
-    {
-      MUTEX_UNLOCK (tran_lock->hold_mutex);
-      er_log_debug (ARG_FILE_LINE,
+  /*
+     lk_Gl.dump_level_when_deadlock
+     0: Don't print anything about deadlock informatin.
+     1: Print only the transaction indexes of deadlock victims.
+     2: Number 1 and deadlock solve functions
+     3: Number 2 and dump lock tables
+     cf) Print only the transactions involved in the cycle and the
+     selected victims (not possible at the current time)
+   */
+  if (lk_Gl.dump_level_when_deadlock == 1)
+    {				/* level 1 */
+      fprintf (stderr, "..... deadlock victims list begin ......\n");
+      fprintf (stderr, "## global_edge_seq_num = %d\n",
+	       lk_Gl.global_edge_seq_num);
+      fprintf (stderr, "## DL victim count = %d\n", victim_count);
+      fprintf (stderr, "## DL victims like followings:\n");
+      for (k = 0; k < victim_count; k++)
+	{
+	  fprintf (stderr, "%3d ", victims[k].tran_index);
+	  if ((k % 10) == 9)
+	    {
+	      fprintf (stderr, "\n");
+	    }
+	}
+      fprintf (stderr, "\n..... deadlock victims list end ......\n\n");
+    }
+  else
+    {				/* level 2 or 3 */
+      fprintf (stderr, "..... deadlock victims list begin ......\n");
+      fprintf (stderr, "## global_edge_seq_num = %d\n",
+	       lk_Gl.global_edge_seq_num);
+      fprintf (stderr, "## DL victim count = %d\n", victim_count);
+      fprintf (stderr, "## DL victims like followings:\n");
+      /* print aborted transactions (deadlock victims) */
+      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				       MSGCAT_SET_LOCK,
+				       MSGCAT_LK_DEADLOCK_ABORT_HDR));
+      count = 0;
+      for (k = 0; k < victim_count; k++)
+	{
+	  if (!victims[k].can_timeout)
+	    {
+	      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
+					       MSGCAT_SET_LOCK,
+					       MSGCAT_LK_DEADLOCK_ABORT),
+		       victims[k].tran_index);
+	      if ((count % 10) == 9)
+		{
+		  fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
+						   MSGCAT_SET_LOCK,
+						   MSGCAT_LK_NEWLINE));
+		}
+	      count++;
+	    }
+	}
+      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				       MSGCAT_SET_LOCK, MSGCAT_LK_NEWLINE));
+      /* print timeout transactions (deadlock victims) */
+      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				       MSGCAT_SET_LOCK,
+				       MSGCAT_LK_DEADLOCK_TIMEOUT_HDR));
+      count = 0;
+      for (k = 0; k < victim_count; k++)
+	{
+	  if (victims[k].can_timeout)
+	    {
+	      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
+					       MSGCAT_SET_LOCK,
+					       MSGCAT_LK_DEADLOCK_TIMEOUT),
+		       victims[k].tran_index);
+	      if ((count % 10) == 9)
+		{
+		  fprintf (stdout, msgcat_message (MSGCAT_CATALOG_CUBRID,
+						   MSGCAT_SET_LOCK,
+						   MSGCAT_LK_NEWLINE));
+		}
+	      count++;
+	    }
+	}
+      fprintf (stderr, "\n..... deadlock victims list end ......\n\n");
+
+      /* dump object lock table */
+      if (lk_Gl.dump_level_when_deadlock == 3)
+	{
+	  if (lk_Gl.dump_lock_table_count < 100)
+	    {
+	      lk_Gl.dump_lock_table_count++;
+	    }
+	  else
+	    {
+	      xlock_dump (thread_p, NULL);
+	      lk_Gl.dump_lock_table_count = 0;
+	    }
+	}
+    }
+}
+#endif /* SERVER_MODE */
+
+/*
+ *  Private Functions Group: miscellaneous functions
+ *
+ *   - lk_lockinfo_compare()
+ *   - lk_dump_res()
+ *   - lk_consistent_res()
+ *   - lk_consistent_tran_lock()
+ */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_compare_lock_info -
+ *
+ * return:
+ *
+ *   lockinfo1(in):
+ *   lockinfo2(in):
+ *
+ * Note:compare two OID of lockable objects.
+ */
+static int
+lock_compare_lock_info (const void *lockinfo1, const void *lockinfo2)
+{
+  const OID *oid1;
+  const OID *oid2;
+
+  oid1 = &(((LK_LOCKINFO *) (lockinfo1))->oid);
+  oid2 = &(((LK_LOCKINFO *) (lockinfo2))->oid);
+
+  return oid_compare (oid1, oid2);
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_dump_resource - Dump locks acquired on a resource
+ *
+ * return:
+ *
+ *   outfp(in): FILE stream where to dump the lock resource entry.
+ *   res_ptr(in): pointer to lock resource entry
+ *
+ * Note:Dump contents of the lock resource entry pointed by res_ptr.
+ */
+static void
+lock_dump_resource (THREAD_ENTRY * thread_p, FILE * outfp, LK_RES * res_ptr)
+{
+  LK_ENTRY *entry_ptr;
+  char *classname;		/* Name of the class */
+  int num_holders, num_blocked_holders, num_waiters;
+  char time_val[64];
+
+  memset (time_val, 0, sizeof (time_val));
+
+  /* dump object identifier */
+  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				  MSGCAT_SET_LOCK,
+				  MSGCAT_LK_RES_OID), res_ptr->oid.volid,
+	   res_ptr->oid.pageid, res_ptr->oid.slotid);
+
+  /* dump object type related information */
+  switch (res_ptr->type)
+    {
+    case LOCK_RESOURCE_ROOT_CLASS:
+      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				      MSGCAT_SET_LOCK,
+				      MSGCAT_LK_RES_ROOT_CLASS_TYPE));
+      break;
+    case LOCK_RESOURCE_CLASS:
+      classname = heap_get_class_name (thread_p, &res_ptr->oid);
+      if (classname == NULL)
+	{
+	  /* We must stop processing if an interrupt occurs */
+	  if (er_errid () == ER_INTERRUPTED)
+	    {
+	      return;
+	    }
+	}
+      else
+	{
+	  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+					  MSGCAT_SET_LOCK,
+					  MSGCAT_LK_RES_CLASS_TYPE),
+		   classname);
+	  free_and_init (classname);
+	}
+      break;
+    case LOCK_RESOURCE_INSTANCE:
+      classname = heap_get_class_name (thread_p, &res_ptr->class_oid);
+      if (classname == NULL)
+	{
+	  /* We must stop processing if an interrupt occurs */
+	  if (er_errid () == ER_INTERRUPTED)
+	    {
+	      return;
+	    }
+	}
+      else
+	{
+	  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+					  MSGCAT_SET_LOCK,
+					  MSGCAT_LK_RES_INSTANCE_TYPE),
+		   res_ptr->class_oid.volid, res_ptr->class_oid.pageid,
+		   res_ptr->class_oid.slotid, classname);
+	  free_and_init (classname);
+	}
+      break;
+    default:
+      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				      MSGCAT_SET_LOCK,
+				      MSGCAT_LK_RES_UNKNOWN_TYPE));
+    }
+
+  /* dump total modes of holders and waiters */
+  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				  MSGCAT_SET_LOCK,
+				  MSGCAT_LK_RES_TOTAL_MODE),
+	   LOCK_TO_LOCKMODE_STRING (res_ptr->total_holders_mode),
+	   LOCK_TO_LOCKMODE_STRING (res_ptr->total_waiters_mode));
+
+  num_holders = num_blocked_holders = 0;
+  if (res_ptr->holder != (LK_ENTRY *) NULL)
+    {
+      entry_ptr = res_ptr->holder;
+      while (entry_ptr != NULL)
+	{
+	  if (entry_ptr->blocked_mode == NULL_LOCK)
+	    {
+	      num_holders++;
+	    }
+	  else
+	    {
+	      num_blocked_holders++;
+	    }
+	  entry_ptr = entry_ptr->next;
+	}
+    }
+  num_waiters = 0;
+  if (res_ptr->waiter != (LK_ENTRY *) NULL)
+    {
+      entry_ptr = res_ptr->waiter;
+      while (entry_ptr != (LK_ENTRY *) NULL)
+	{
+	  num_waiters++;
+	  entry_ptr = entry_ptr->next;
+	}
+    }
+
+  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				  MSGCAT_SET_LOCK,
+				  MSGCAT_LK_RES_LOCK_COUNT), num_holders,
+	   num_blocked_holders, num_waiters);
+
+  /* dump holders */
+  if (num_holders > 0)
+    {
+      /* dump non blocked holders */
+      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				      MSGCAT_SET_LOCK,
+				      MSGCAT_LK_RES_NON_BLOCKED_HOLDER_HEAD));
+      entry_ptr = res_ptr->holder;
+      while (entry_ptr != (LK_ENTRY *) NULL)
+	{
+	  if (entry_ptr->blocked_mode == NULL_LOCK)
+	    {
+	      if (res_ptr->type == LOCK_RESOURCE_INSTANCE)
+		{
+		  fprintf (outfp,
+			   msgcat_message (MSGCAT_CATALOG_CUBRID,
+					   MSGCAT_SET_LOCK,
+					   MSGCAT_LK_RES_NON_BLOCKED_HOLDER_ENTRY),
+			   "", entry_ptr->tran_index,
+			   LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
+			   entry_ptr->count);
+		}
+	      else
+		{
+		  fprintf (outfp,
+			   msgcat_message (MSGCAT_CATALOG_CUBRID,
+					   MSGCAT_SET_LOCK,
+					   MSGCAT_LK_RES_NON_BLOCKED_HOLDER_ENTRY_WITH_GRANULE),
+			   "", entry_ptr->tran_index,
+			   LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
+			   entry_ptr->count, entry_ptr->ngranules);
+		}
+	    }
+	  entry_ptr = entry_ptr->next;
+	}
+    }
+
+  if (num_blocked_holders > 0)
+    {
+      /* dump blocked holders */
+      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				      MSGCAT_SET_LOCK,
+				      MSGCAT_LK_RES_BLOCKED_HOLDER_HEAD));
+      entry_ptr = res_ptr->holder;
+      while (entry_ptr != (LK_ENTRY *) NULL)
+	{
+	  if (entry_ptr->blocked_mode != NULL_LOCK)
+	    {
+	      time_t stime =
+		(time_t) (entry_ptr->thrd_entry->lockwait_stime / 1000);
+#if defined(WINDOWS)
+	      strcpy (time_val, ctime (&stime));
+#else /* WINDOWS */
+	      if (ctime_r (&stime, time_val) == NULL)
+		{
+		  strcpy (time_val, "???");
+		}
+#endif /* WINDOWS */
+	      if (time_val[strlen (time_val) - 1] == '\n')
+		{
+		  time_val[strlen (time_val) - 1] = 0;
+		}
+	      if (res_ptr->type == LOCK_RESOURCE_INSTANCE)
+		{
+		  fprintf (outfp,
+			   msgcat_message (MSGCAT_CATALOG_CUBRID,
+					   MSGCAT_SET_LOCK,
+					   MSGCAT_LK_RES_BLOCKED_HOLDER_ENTRY),
+			   "", entry_ptr->tran_index,
+			   LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
+			   entry_ptr->count, "",
+			   LOCK_TO_LOCKMODE_STRING (entry_ptr->blocked_mode),
+			   "", time_val, "",
+			   entry_ptr->thrd_entry->lockwait_nsecs);
+		}
+	      else
+		{
+		  fprintf (outfp,
+			   msgcat_message (MSGCAT_CATALOG_CUBRID,
+					   MSGCAT_SET_LOCK,
+					   MSGCAT_LK_RES_BLOCKED_HOLDER_ENTRY_WITH_GRANULE),
+			   "", entry_ptr->tran_index,
+			   LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
+			   entry_ptr->count, entry_ptr->ngranules, "",
+			   LOCK_TO_LOCKMODE_STRING (entry_ptr->blocked_mode),
+			   "", time_val, "",
+			   entry_ptr->thrd_entry->lockwait_nsecs);
+		}
+	    }
+	  entry_ptr = entry_ptr->next;
+	}
+    }
+
+  /* dump blocked waiters */
+  if (res_ptr->waiter != (LK_ENTRY *) NULL)
+    {
+      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				      MSGCAT_SET_LOCK,
+				      MSGCAT_LK_RES_BLOCKED_WAITER_HEAD));
+      entry_ptr = res_ptr->waiter;
+      while (entry_ptr != (LK_ENTRY *) NULL)
+	{
+	  time_t stime =
+	    (time_t) (entry_ptr->thrd_entry->lockwait_stime / 1000);
+#if defined(WINDOWS)
+	  strcpy (time_val, ctime (&stime));
+#else /* WINDOWS */
+	  ctime_r (&stime, time_val);
+#endif /* WINDOWS */
+	  if (time_val[strlen (time_val) - 1] == '\n')
+	    {
+	      time_val[strlen (time_val) - 1] = 0;
+	    }
+	  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+					  MSGCAT_SET_LOCK,
+					  MSGCAT_LK_RES_BLOCKED_WAITER_ENTRY),
+		   "", entry_ptr->tran_index,
+		   LOCK_TO_LOCKMODE_STRING (entry_ptr->blocked_mode), "",
+		   time_val, "", entry_ptr->thrd_entry->lockwait_nsecs);
+	  entry_ptr = entry_ptr->next;
+	}
+    }
+
+  /* dump non two phase locks */
+  if (res_ptr->non2pl != NULL)
+    {
+      fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				      MSGCAT_SET_LOCK,
+				      MSGCAT_LK_RES_NON2PL_RELEASED_HEAD));
+      entry_ptr = res_ptr->non2pl;
+      while (entry_ptr != (LK_ENTRY *) NULL)
+	{
+	  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+					  MSGCAT_SET_LOCK,
+					  MSGCAT_LK_RES_NON2PL_RELEASED_ENTRY),
+		   "", entry_ptr->tran_index,
+		   ((entry_ptr->granted_mode ==
+		     INCON_NON_TWO_PHASE_LOCK) ? "INCON_NON_TWO_PHASE_LOCK" :
+		    LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode)));
+	  entry_ptr = entry_ptr->next;
+	}
+    }
+  fprintf (outfp, msgcat_message (MSGCAT_CATALOG_CUBRID,
+				  MSGCAT_SET_LOCK, MSGCAT_LK_NEWLINE));
+
+}
+#endif /* SERVER_MODE */
+
+#if defined(ENABLE_UNUSED_FUNCTION)
+#if defined(SERVER_MODE)
+/*
+ * lock_check_consistent_resource - Check if the lock resource entry is consistent
+ *
+ * return: true/false
+ *
+ *   res_ptr(in):
+ *
+ * Note:Verify if a lock entry is consistent. At least one waiter must be
+ *     waiting on at least one transaction holding a lock, otherwise,
+ *     an inconsistent entry exist. Some waiters may be waiting on waiters.
+ */
+static bool
+lock_check_consistent_resource (THREAD_ENTRY * thread_p, LK_RES * res_ptr)
+{
+  LOCK total_mode;
+  LK_ENTRY *i, *j;
+  const char *msg_str;
+  int rv;
+
+  /* hold resource mutex */
+  MUTEX_LOCK (rv, res_ptr->res_mutex);
+
+  /* check total_holders_mode (total mode of lock holders) */
+  total_mode = NULL_LOCK;
+  for (i = res_ptr->holder; i != NULL; i = i->next)
+    {
+      assert (i->granted_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
+      total_mode = lock_Conv[i->granted_mode][total_mode];
+      assert (total_mode != NA_LOCK);
+
+      assert (i->blocked_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
+      total_mode = lock_Conv[i->blocked_mode][total_mode];
+      assert (total_mode != NA_LOCK);
+    }
+  if (total_mode != res_ptr->total_holders_mode)
+    {
+      msg_str = "lk_consistent_res: total mode of holders is inconsistent.";
+      goto inconsistent;
+    }
+
+  /* check total_waiters_mode (total mode of lock waiters) */
+  total_mode = NULL_LOCK;
+  for (i = res_ptr->waiter; i != NULL; i = i->next)
+    {
+      assert (i->blocked_mode >= NULL_LOCK && total_mode >= NULL_LOCK);
+      total_mode = lock_Conv[i->blocked_mode][total_mode];
+      assert (total_mode != NA_LOCK);
+    }
+  if (total_mode != res_ptr->total_waiters_mode)
+    {
+      msg_str = "lk_consistent_res: total mode of waiters is incons.";
+      goto inconsistent;
+    }
+
+  /* check holders : lock information */
+  for (i = res_ptr->holder; i != NULL; i = i->next)
+    {
+      /* check res_head */
+      if (i->res_head != res_ptr)
+	{
+	  msg_str = "lk_consistent_res: res_head of a holder is incons.";
+	  goto inconsistent;
+	}
+      /* check tran_index */
+      for (j = res_ptr->holder; j != NULL && j != i; j = j->next)
+	{
+	  if (j->tran_index == i->tran_index)
+	    {
+	      msg_str =
+		"lk_consistent_res: tran_index of a holder is incons. (1)";
+	      goto inconsistent;
+	    }
+	}
+      for (j = res_ptr->waiter; j != NULL; j = j->next)
+	{
+	  if (j->tran_index == i->tran_index)
+	    {
+	      msg_str =
+		"lk_consistent_res: tran_index of a holder is incons. (2)";
+	      goto inconsistent;
+	    }
+	}
+      for (j = res_ptr->non2pl; j != NULL; j = j->next)
+	{
+	  if (j->tran_index == i->tran_index)
+	    {
+	      msg_str =
+		"lk_consistent_res: tran_index of a holder is incons. (3)";
+	      goto inconsistent;
+	    }
+	}
+      /* check thrd_entry */
+      if (i->blocked_mode != NULL_LOCK)
+	{
+	  if (i->thrd_entry == NULL)
+	    {
+	      msg_str =
+		"lk_consistent_res: thrd_entry of a blocked holder is incons.";
+	      goto inconsistent;
+	    }
+	}
+    }
+
+  /* check lock waiters */
+  for (i = res_ptr->waiter; i != NULL; i = i->next)
+    {
+      /* check res_head */
+      if (i->res_head != res_ptr)
+	{
+	  msg_str = "lk_consistent_res: res_head of a waiter is incons.";
+	  goto inconsistent;
+	}
+      /* check tran_index */
+      for (j = res_ptr->holder; j != NULL; j = j->next)
+	{
+	  if (j->tran_index == i->tran_index)
+	    {
+	      msg_str =
+		"lk_consistent_res: tran_index of a waiter is incons. (1)";
+	      goto inconsistent;
+	    }
+	}
+      for (j = res_ptr->waiter; j != NULL && j != i; j = j->next)
+	{
+	  if (j->tran_index == i->tran_index)
+	    {
+	      msg_str =
+		"lk_consistent_res: tran_index of a waiter is incons. (2)";
+	      goto inconsistent;
+	    }
+	}
+      for (j = res_ptr->non2pl; j != NULL; j = j->next)
+	{
+	  if (j->tran_index == i->tran_index)
+	    {
+	      msg_str =
+		"lk_consistent_res: tran_index of a waiter is incons. (3)";
+	      goto inconsistent;
+	    }
+	}
+      /* check lock mode */
+      if (i->blocked_mode == NULL_LOCK)
+	{
+	  msg_str = "lk_consistent_res: blocked_mode of a waiter is incons.";
+	  goto inconsistent;
+	}
+      /* check thrd_entry */
+      if (i->thrd_entry == NULL)
+	{
+	  msg_str = "lk_consistent_res: thrd_entry of a waiter is incons.";
+	  goto inconsistent;
+	}
+    }
+
+  /* check non2pl locks */
+  for (i = res_ptr->non2pl; i != NULL; i = i->next)
+    {
+      /* check tran_index */
+      for (j = res_ptr->holder; j != NULL; j = j->next)
+	{
+	  if (j->tran_index == i->tran_index)
+	    {
+	      msg_str =
+		"lk_consistent_res: tran_index of a non2pl is incons. (1)";
+	      goto inconsistent;
+	    }
+	}
+      for (j = res_ptr->waiter; j != NULL; j = j->next)
+	{
+	  if (j->tran_index == i->tran_index)
+	    {
+	      msg_str =
+		"lk_consistent_res: tran_index of a non2pl is incons. (2)";
+	      goto inconsistent;
+	    }
+	}
+      for (j = res_ptr->non2pl; j != NULL && j != i; j = j->next)
+	{
+	  if (j->tran_index == i->tran_index)
+	    {
+	      msg_str =
+		"lk_consistent_res: tran_index of a non2pl is incons. (3)";
+	      goto inconsistent;
+	    }
+	}
+    }
+
+  /* consistent */
+  MUTEX_UNLOCK (res_ptr->res_mutex);
+  return true;
+
+inconsistent:
+  lock_dump_resource (thread_p, stdout, res_ptr);
+  MUTEX_UNLOCK (res_ptr->res_mutex);
+  er_log_debug (ARG_FILE_LINE, msg_str);
+  return false;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_check_consistent_tran_lock - Check consistency of transaction lock info entry
+ *
+ * return: true/false
+ *
+ *   tran_lock(in): ponter to the transaction lock information entry
+ *
+ * Note:check if the given transaction lock information enrtry is consistent.
+ */
+static bool
+lock_check_consistent_tran_lock (LK_TRAN_LOCK * tran_lock)
+{
+  int count;
+  LK_ENTRY *i;
+  int rv;
+
+  /* hold transaction hold mutex */
+  MUTEX_LOCK (rv, tran_lock->hold_mutex);
+
+  /* check held locks */
+  /* check inst_hold_count and class_hold_count */
+  for (count = 0, i = tran_lock->inst_hold_list; i != NULL; i = i->tran_next)
+    {
+      count++;
+    }
+  if (count != tran_lock->inst_hold_count)
+    {
+      MUTEX_UNLOCK (tran_lock->hold_mutex);
+      er_log_debug (ARG_FILE_LINE,
 		    "lk_consistent_tran_lock: inst_hold_count incorrect.");
       return false;
     }
@@ -7189,6 +8055,12 @@ lock_finalize (void)
     {
       free_and_init (lk_Gl.TWFG_node);
     }
+  if (lk_Gl.DL_new_waiters != NULL)
+    {
+      free_and_init (lk_Gl.DL_new_waiters);
+      MUTEX_DESTROY (lk_Gl.DL_new_waiter_mutex);
+    }
+  lk_Gl.DL_num_new_waiters = 0;
 
   /* transaction lock information table */
   /* deallocate memory space for transaction lock table */
@@ -7205,6 +8077,9 @@ lock_finalize (void)
   /* reset the number of transactions */
   lk_Gl.num_trans = 0;
 
+  /* the thread caches point into the blocks freed below */
+  lock_clear_thread_caches ();
+
   /* object lock entry list */
   /* deallocate memory space for object lock entry block list */
   while (lk_Gl.obj_entry_block_list != (LK_ENTRY_BLOCK *) NULL)
@@ -8831,87 +9706,279 @@ lock_unlock_scan (THREAD_ENTRY * thread_p, const OID * class_oid,
     default:			/* TRAN_UNKNOWN_ISOLATION */
       er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_UNKNOWN_ISOLATION, 2,
 	      isolation, tran_index);
-      break;
+      break;
+    }
+#endif /* !SERVER_MODE */
+}
+
+
+/*
+ * lock_unlock_classes_lock_hint - Unlock many hinted classes according to
+ *                             transaction isolation level
+ *
+ * return: nothing..
+ *
+ *   lockhint(in): Description of hinted classses
+ *
+ */
+void
+lock_unlock_classes_lock_hint (THREAD_ENTRY * thread_p,
+			       LC_LOCKHINT * lockhint)
+{
+#if !defined (SERVER_MODE)
+  return;
+#else /* !SERVER_MODE */
+  int tran_index;		/* transaction table index */
+  TRAN_ISOLATION isolation;	/* transaction isolation level */
+  int i;
+
+  if (lockhint == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_BAD_ARGUMENT, 2,
+	      "lk_unlock_classes_lockhint", "NULL lockhint pointer");
+      return;
+    }
+
+  /* If there is nothing to unlock, returns */
+  if (lockhint->num_classes <= 0)
+    {
+      return;
+    }
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  isolation = logtb_find_isolation (tran_index);
+
+  switch (isolation)
+    {
+    case TRAN_SERIALIZABLE:
+    case TRAN_REP_CLASS_REP_INSTANCE:
+      return;			/* nothing to do */
+
+    case TRAN_REP_CLASS_COMMIT_INSTANCE:
+      /* class: demote shared class locks */
+      for (i = 0; i < lockhint->num_classes; i++)
+	{
+	  if (OID_ISNULL (&lockhint->classes[i].oid)
+	      || lockhint->classes[i].lock == NULL_LOCK)
+	    {
+	      continue;
+	    }
+	  lock_demote_shared_class_lock (thread_p, tran_index,
+					 &lockhint->classes[i].oid);
+	}
+      return;
+
+    case TRAN_REP_CLASS_UNCOMMIT_INSTANCE:
+      return;			/* nothing to do */
+
+    case TRAN_COMMIT_CLASS_COMMIT_INSTANCE:
+    case TRAN_COMMIT_CLASS_UNCOMMIT_INSTANCE:
+      /* class: remove shared class locks */
+      for (i = 0; i < lockhint->num_classes; i++)
+	{
+	  if (OID_ISNULL (&lockhint->classes[i].oid)
+	      || lockhint->classes[i].lock == NULL_LOCK)
+	    {
+	      continue;
+	    }
+	  lock_unlock_shared_class_lock (thread_p, tran_index,
+					 &lockhint->classes[i].oid);
+	}
+      lock_unlock_shared_class_lock (thread_p, tran_index,
+				     oid_Root_class_oid);
+      break;
+
+    default:			/* TRAN_UNKNOWN_ISOLATION */
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_UNKNOWN_ISOLATION, 2,
+	      isolation, tran_index);
+      return;
+    }
+#endif /* !SERVER_MODE */
+}
+
+/*
+ * lock_unlock_all - Release all locks of current transaction
+ *
+ * return: nothing
+ *
+ * Note:Release all locks acquired by the current transaction.
+ *
+ *      This function must be called at the end of the transaction.
+ */
+void
+lock_unlock_all (THREAD_ENTRY * thread_p)
+{
+#if !defined (SERVER_MODE)
+  lk_Standalone_has_xlock = false;
+  pgbuf_unfix_all (thread_p);
+
+  return;
+#else /* !SERVER_MODE */
+  int tran_index;
+  LK_TRAN_LOCK *tran_lock;
+  LK_ENTRY *entry_ptr;
+  int rv;
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+
+  /* remove all instance locks */
+  entry_ptr = tran_lock->inst_hold_list;
+  while (entry_ptr != (LK_ENTRY *) NULL)
+    {
+      lock_internal_perform_unlock_object (thread_p, entry_ptr, true, false);
+      entry_ptr = tran_lock->inst_hold_list;
+    }
+
+  /* remove all class locks */
+  entry_ptr = tran_lock->class_hold_list;
+  while (entry_ptr != (LK_ENTRY *) NULL)
+    {
+      lock_internal_perform_unlock_object (thread_p, entry_ptr, true, false);
+      entry_ptr = tran_lock->class_hold_list;
+    }
+
+  /* remove root class lock */
+  entry_ptr = tran_lock->root_class_hold;
+  if (entry_ptr != NULL)
+    {
+      lock_internal_perform_unlock_object (thread_p, entry_ptr, true, false);
+    }
+
+  /* remove non2pl locks */
+  while (tran_lock->non2pl_list != (LK_ENTRY *) NULL)
+    {
+      /* remove the non2pl entry from transaction non2pl list */
+      entry_ptr = tran_lock->non2pl_list;
+      tran_lock->non2pl_list = entry_ptr->tran_next;
+      if (entry_ptr->granted_mode == INCON_NON_TWO_PHASE_LOCK)
+	{
+	  tran_lock->num_incons_non2pl -= 1;
+	}
+      /* remove the non2pl entry from resource non2pl list and free it */
+      lock_remove_non2pl (entry_ptr, tran_index);
+    }
+
+  /* communication with deadlock detector */
+  if (lk_Gl.TWFG_node[tran_index].checked_by_deadlock_detector)
+    {
+      lk_Gl.TWFG_node[tran_index].checked_by_deadlock_detector = false;
+    }
+  if (lk_Gl.TWFG_node[tran_index].DL_victim)
+    {
+      MUTEX_LOCK (rv, lk_Gl.DL_detection_mutex);
+      lk_Gl.TWFG_node[tran_index].DL_victim = false;
+      MUTEX_UNLOCK (lk_Gl.DL_detection_mutex);
+    }
+
+  pgbuf_unfix_all (thread_p);
+#endif /* !SERVER_MODE */
+}
+
+/*
+ * lock_unlock_by_isolation_level - Release some of the locks of the current
+ *                              transaction according to its isolation  level
+ *
+ * return: nothing
+ *
+ * Note:Release some of the locks acquired by the current transaction
+ *     according to its isolation level.
+ */
+void
+lock_unlock_by_isolation_level (THREAD_ENTRY * thread_p)
+{
+#if !defined (SERVER_MODE)
+  return;
+#else /* !SERVER_MODE */
+  int tran_index;		/* transaction table index */
+  TRAN_ISOLATION isolation;	/* transaction isolation level */
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  isolation = logtb_find_isolation (tran_index);
+
+  switch (isolation)
+    {
+    case TRAN_SERIALIZABLE:
+    case TRAN_REP_CLASS_REP_INSTANCE:
+      return;			/* Nothing to release */
+
+    case TRAN_REP_CLASS_COMMIT_INSTANCE:
+    case TRAN_REP_CLASS_UNCOMMIT_INSTANCE:
+      /* remove all shared instance locks, demote all shared class locks */
+      lock_remove_all_inst_locks (thread_p, tran_index, (OID *) NULL, S_LOCK);
+      lock_demote_all_shared_class_locks (thread_p, tran_index);
+      return;
+
+    case TRAN_COMMIT_CLASS_COMMIT_INSTANCE:
+    case TRAN_COMMIT_CLASS_UNCOMMIT_INSTANCE:
+      /* remove all shared instance locks, remove all shared class locks */
+      lock_remove_all_inst_locks (thread_p, tran_index, (OID *) NULL, S_LOCK);
+      lock_remove_all_class_locks (thread_p, tran_index, S_LOCK);
+      return;
+
+    default:			/* TRAN_UNKNOWN_ISOLATION */
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_UNKNOWN_ISOLATION, 2,
+	      isolation, tran_index);
+      return;
     }
 #endif /* !SERVER_MODE */
 }
 
-
 /*
- * lock_unlock_classes_lock_hint - Unlock many hinted classes according to
- *                             transaction isolation level
- *
- * return: nothing..
- *
- *   lockhint(in): Description of hinted classses
+ * lock_demote_all_update_inst_locks -
  *
+ * return: nothing
  */
 void
-lock_unlock_classes_lock_hint (THREAD_ENTRY * thread_p,
-			       LC_LOCKHINT * lockhint)
+lock_demote_all_update_inst_locks (THREAD_ENTRY * thread_p)
 {
 #if !defined (SERVER_MODE)
   return;
 #else /* !SERVER_MODE */
   int tran_index;		/* transaction table index */
   TRAN_ISOLATION isolation;	/* transaction isolation level */
-  int i;
-
-  if (lockhint == NULL)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_BAD_ARGUMENT, 2,
-	      "lk_unlock_classes_lockhint", "NULL lockhint pointer");
-      return;
-    }
+  LK_TRAN_LOCK *tran_lock;
+  LK_ENTRY *curr, *next;
 
-  /* If there is nothing to unlock, returns */
-  if (lockhint->num_classes <= 0)
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  isolation = logtb_find_isolation (tran_index);
+  if (LK_UNCOMMITTED_READ_ISOLATION (isolation))
     {
-      return;
+      return;			/* There is no update lock */
     }
 
-  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
-  isolation = logtb_find_isolation (tran_index);
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
 
   switch (isolation)
     {
     case TRAN_SERIALIZABLE:
     case TRAN_REP_CLASS_REP_INSTANCE:
-      return;			/* nothing to do */
-
-    case TRAN_REP_CLASS_COMMIT_INSTANCE:
-      /* class: demote shared class locks */
-      for (i = 0; i < lockhint->num_classes; i++)
+      /* demote U_LOCK to S_LOCK/NS_LOCK */
+      for (curr = tran_lock->inst_hold_list; curr != (LK_ENTRY *) NULL;)
 	{
-	  if (OID_ISNULL (&lockhint->classes[i].oid)
-	      || lockhint->classes[i].lock == NULL_LOCK)
+	  next = curr->tran_next;
+	  if (curr->granted_mode == U_LOCK)
 	    {
-	      continue;
+	      (void) lock_internal_demote_update_inst_lock (thread_p, curr);
 	    }
-	  lock_demote_shared_class_lock (thread_p, tran_index,
-					 &lockhint->classes[i].oid);
+	  curr = next;
 	}
       return;
 
-    case TRAN_REP_CLASS_UNCOMMIT_INSTANCE:
-      return;			/* nothing to do */
-
+    case TRAN_REP_CLASS_COMMIT_INSTANCE:
     case TRAN_COMMIT_CLASS_COMMIT_INSTANCE:
-    case TRAN_COMMIT_CLASS_UNCOMMIT_INSTANCE:
-      /* class: remove shared class locks */
-      for (i = 0; i < lockhint->num_classes; i++)
+      /* remove U_LOCK */
+      for (curr = tran_lock->inst_hold_list; curr != (LK_ENTRY *) NULL;)
 	{
-	  if (OID_ISNULL (&lockhint->classes[i].oid)
-	      || lockhint->classes[i].lock == NULL_LOCK)
+	  next = curr->tran_next;
+	  if (curr->granted_mode == U_LOCK)
 	    {
-	      continue;
+	      lock_internal_perform_unlock_object (thread_p, curr, true,
+						   false);
 	    }
-	  lock_unlock_shared_class_lock (thread_p, tran_index,
-					 &lockhint->classes[i].oid);
+	  curr = next;
 	}
-      lock_unlock_shared_class_lock (thread_p, tran_index,
-				     oid_Root_class_oid);
-      break;
+      return;
 
     default:			/* TRAN_UNKNOWN_ISOLATION */
       er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_UNKNOWN_ISOLATION, 2,
@@ -8922,1169 +9989,1586 @@ lock_unlock_classes_lock_hint (THREAD_ENTRY * thread_p,
 }
 
 /*
- * lock_unlock_all - Release all locks of current transaction
+ * lock_get_object_lock - Find the acquired lock mode
  *
- * return: nothing
+ * return:
  *
- * Note:Release all locks acquired by the current transaction.
+ *   oid(in): target object ientifier
+ *   class_oid(in): class identifier of the target object
+ *   tran_index(in): the transaction table index of target transaction.
  *
- *      This function must be called at the end of the transaction.
+ * Note:Find the acquired lock on the given object by the given transaction.
+ *     Currently, the value of the "tran_index" must not be NULL_TRAN_INDEX.
+ *
+ *     If this function is changed in order to allow NULL_TRAN_INDEX to be
+ *     transferred as the value of the "tran_index", this function will
+ *     find the resulting lock acquired by all transactions holding a lock
+ *     on the given OID (The most powerful lock, actually a combination of
+ *     the locks).
  */
-void
-lock_unlock_all (THREAD_ENTRY * thread_p)
+LOCK
+lock_get_object_lock (const OID * oid, const OID * class_oid, int tran_index)
 {
 #if !defined (SERVER_MODE)
-  lk_Standalone_has_xlock = false;
-  pgbuf_unfix_all (thread_p);
-
-  return;
+  return X_LOCK;
 #else /* !SERVER_MODE */
-  int tran_index;
+  LOCK lock_mode = NULL_LOCK;	/* return value */
   LK_TRAN_LOCK *tran_lock;
   LK_ENTRY *entry_ptr;
   int rv;
 
-  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  if (oid == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_BAD_ARGUMENT, 2,
+	      "lk_get_object_lock", "NULL OID pointer");
+      return NULL_LOCK;
+    }
+  if (tran_index == NULL_TRAN_INDEX)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_BAD_ARGUMENT, 2,
+	      "lk_get_object_lock", "NULL_TRAN_INDEX");
+      return NULL_LOCK;
+    }
+
+  /* get a pointer to transaction lock info entry */
   tran_lock = &lk_Gl.tran_lock_table[tran_index];
 
-  /* remove all instance locks */
-  entry_ptr = tran_lock->inst_hold_list;
-  while (entry_ptr != (LK_ENTRY *) NULL)
+  /*
+   * case 1: root class lock
+   */
+  /* get the granted lock mode acquired on the root class oid */
+  if (OID_EQ (oid, oid_Root_class_oid))
     {
-      lock_internal_perform_unlock_object (thread_p, entry_ptr, true, false);
-      entry_ptr = tran_lock->inst_hold_list;
+      MUTEX_LOCK (rv, tran_lock->hold_mutex);
+      if (tran_lock->root_class_hold != (LK_ENTRY *) NULL)
+	{
+	  lock_mode = tran_lock->root_class_hold->granted_mode;
+	}
+      MUTEX_UNLOCK (tran_lock->hold_mutex);
+      return lock_mode;		/* might be NULL_LOCK */
     }
 
-  /* remove all class locks */
-  entry_ptr = tran_lock->class_hold_list;
-  while (entry_ptr != (LK_ENTRY *) NULL)
+  /*
+   * case 2: general class lock
+   */
+  /* get the granted lock mode acquired on the given class oid */
+  if (class_oid == NULL || OID_EQ (class_oid, oid_Root_class_oid))
     {
-      lock_internal_perform_unlock_object (thread_p, entry_ptr, true, false);
+      MUTEX_LOCK (rv, tran_lock->hold_mutex);
       entry_ptr = tran_lock->class_hold_list;
+      for (; entry_ptr != (LK_ENTRY *) NULL; entry_ptr = entry_ptr->tran_next)
+	{
+	  if (OID_EQ (&entry_ptr->res_head->oid, oid))
+	    {			/* found */
+	      lock_mode = entry_ptr->granted_mode;
+	      break;
+	    }
+	}
+      MUTEX_UNLOCK (tran_lock->hold_mutex);
+      return lock_mode;		/* might be NULL_LOCK */
     }
 
-  /* remove root class lock */
-  entry_ptr = tran_lock->root_class_hold;
-  if (entry_ptr != NULL)
+  MUTEX_LOCK (rv, tran_lock->hold_mutex);
+  entry_ptr = tran_lock->class_hold_list;
+  for (; entry_ptr != (LK_ENTRY *) NULL; entry_ptr = entry_ptr->tran_next)
     {
-      lock_internal_perform_unlock_object (thread_p, entry_ptr, true, false);
+      if (OID_EQ (&entry_ptr->res_head->oid, class_oid))
+	{			/* found */
+	  lock_mode = entry_ptr->granted_mode;
+	  break;
+	}
+    }
+  /* If the class lock mode is S_LOCK or X_LOCK,
+   * the lock is held on the instance implicitly.
+   * In this case, there is no need to check instance lock.
+   * If the class lock mode is SIX_LOCK,
+   * S_LOCK is held on the instance implicitly.
+   * In this case, we must check for a possible X_LOCK on the instance.
+   * In other cases, we must check the lock held on the instance.
+   */
+  if (lock_mode != S_LOCK && lock_mode != X_LOCK)
+    {
+      if (lock_mode == SIX_LOCK)
+	{
+	  lock_mode = S_LOCK;
+	}
+      else
+	{
+	  lock_mode = NULL_LOCK;
+	}
+      entry_ptr = tran_lock->inst_hold_list;
+      for (; entry_ptr != (LK_ENTRY *) NULL; entry_ptr = entry_ptr->tran_next)
+	{
+	  if (OID_EQ (&entry_ptr->res_head->oid, oid)
+	      && OID_EQ (&entry_ptr->res_head->class_oid, class_oid))
+	    {			/* found */
+	      lock_mode = entry_ptr->granted_mode;
+	      break;
+	    }
+	}
     }
+  MUTEX_UNLOCK (tran_lock->hold_mutex);
+  return lock_mode;		/* might be NULL_LOCK */
+#endif /* !SERVER_MODE */
+}
 
-  /* remove non2pl locks */
-  while (tran_lock->non2pl_list != (LK_ENTRY *) NULL)
+/*
+ * lock_has_xlock - Does transaction have an exclusive lock on any resource ?
+ *
+ * return:
+ *
+ * Note:Find if the current transaction has any kind of exclusive lock
+ *     on any lock resource.
+ */
+bool
+lock_has_xlock (THREAD_ENTRY * thread_p)
+{
+#if !defined (SERVER_MODE)
+  return lk_Standalone_has_xlock;
+#else /* !SERVER_MODE */
+  int tran_index;
+  LK_TRAN_LOCK *tran_lock;
+  LOCK lock_mode;
+  LK_ENTRY *entry_ptr;
+  int rv;
+
+  /*
+   * Exclusive locks in this context mean IX_LOCK, SIX_LOCK and X_LOCK.
+   * NOTE that NX_LOCK and U_LOCK are excluded from exclusive locks.
+   * Because, NX_LOCK is only for next-key locking and U_LOCK is currently
+   * for reading the object.
+   */
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  MUTEX_LOCK (rv, tran_lock->hold_mutex);
+
+  /* 1. check root class lock */
+  if (tran_lock->root_class_hold != (LK_ENTRY *) NULL)
     {
-      /* remove the non2pl entry from transaction non2pl list */
-      entry_ptr = tran_lock->non2pl_list;
-      tran_lock->non2pl_list = entry_ptr->tran_next;
-      if (entry_ptr->granted_mode == INCON_NON_TWO_PHASE_LOCK)
+      lock_mode = tran_lock->root_class_hold->granted_mode;
+      if (lock_mode == X_LOCK || lock_mode == IX_LOCK
+	  || lock_mode == SIX_LOCK)
+	{
+	  MUTEX_UNLOCK (tran_lock->hold_mutex);
+	  return true;
+	}
+    }
+
+  /* 2. check general class locks */
+  entry_ptr = tran_lock->class_hold_list;
+  while (entry_ptr != (LK_ENTRY *) NULL)
+    {
+      lock_mode = entry_ptr->granted_mode;
+      if (lock_mode == X_LOCK || lock_mode == IX_LOCK
+	  || lock_mode == SIX_LOCK)
 	{
-	  tran_lock->num_incons_non2pl -= 1;
+	  MUTEX_UNLOCK (tran_lock->hold_mutex);
+	  return true;
 	}
-      /* remove the non2pl entry from resource non2pl list and free it */
-      lock_remove_non2pl (entry_ptr, tran_index);
+      entry_ptr = entry_ptr->tran_next;
     }
 
-  /* communication with deadlock detector */
-  if (lk_Gl.TWFG_node[tran_index].checked_by_deadlock_detector)
-    {
-      lk_Gl.TWFG_node[tran_index].checked_by_deadlock_detector = false;
-    }
-  if (lk_Gl.TWFG_node[tran_index].DL_victim)
-    {
-      MUTEX_LOCK (rv, lk_Gl.DL_detection_mutex);
-      lk_Gl.TWFG_node[tran_index].DL_victim = false;
-      MUTEX_UNLOCK (lk_Gl.DL_detection_mutex);
-    }
+  /* 3. checking instance locks is not needed. According to MGL ptotocol,
+   *    an exclusive class lock has been acquired with intention mode
+   *    before an exclusive instance is acquired.
+   */
 
-  pgbuf_unfix_all (thread_p);
+  MUTEX_UNLOCK (tran_lock->hold_mutex);
+  return false;
 #endif /* !SERVER_MODE */
 }
 
+#if defined(ENABLE_UNUSED_FUNCTION)
 /*
- * lock_unlock_by_isolation_level - Release some of the locks of the current
- *                              transaction according to its isolation  level
+ * lock_has_lock_transaction - Does transaction have any lock on any resource ?
  *
- * return: nothing
+ * return:
  *
- * Note:Release some of the locks acquired by the current transaction
- *     according to its isolation level.
+ *   tran_index(in):
+ *
+ * Note:Find if given transaction has any kind of lock.
+ *     Used by css_check_for_clients_down() to eliminate needless pinging.
  */
-void
-lock_unlock_by_isolation_level (THREAD_ENTRY * thread_p)
+bool
+lock_has_lock_transaction (int tran_index)
 {
 #if !defined (SERVER_MODE)
-  return;
+  return lk_Standalone_has_xlock;
 #else /* !SERVER_MODE */
-  int tran_index;		/* transaction table index */
-  TRAN_ISOLATION isolation;	/* transaction isolation level */
-
-  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
-  isolation = logtb_find_isolation (tran_index);
+  LK_TRAN_LOCK *tran_lock;
+  bool lock_hold;
+  int rv;
 
-  switch (isolation)
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  MUTEX_LOCK (rv, tran_lock->hold_mutex);
+  if (tran_lock->root_class_hold != (LK_ENTRY *) NULL
+      || tran_lock->class_hold_list != (LK_ENTRY *) NULL
+      || tran_lock->inst_hold_list != (LK_ENTRY *) NULL
+      || tran_lock->non2pl_list != (LK_ENTRY *) NULL)
     {
-    case TRAN_SERIALIZABLE:
-    case TRAN_REP_CLASS_REP_INSTANCE:
-      return;			/* Nothing to release */
-
-    case TRAN_REP_CLASS_COMMIT_INSTANCE:
-    case TRAN_REP_CLASS_UNCOMMIT_INSTANCE:
-      /* remove all shared instance locks, demote all shared class locks */
-      lock_remove_all_inst_locks (thread_p, tran_index, (OID *) NULL, S_LOCK);
-      lock_demote_all_shared_class_locks (thread_p, tran_index);
-      return;
-
-    case TRAN_COMMIT_CLASS_COMMIT_INSTANCE:
-    case TRAN_COMMIT_CLASS_UNCOMMIT_INSTANCE:
-      /* remove all shared instance locks, remove all shared class locks */
-      lock_remove_all_inst_locks (thread_p, tran_index, (OID *) NULL, S_LOCK);
-      lock_remove_all_class_locks (thread_p, tran_index, S_LOCK);
-      return;
-
-    default:			/* TRAN_UNKNOWN_ISOLATION */
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_UNKNOWN_ISOLATION, 2,
-	      isolation, tran_index);
-      return;
+      lock_hold = true;
+    }
+  else
+    {
+      lock_hold = false;
     }
+  MUTEX_UNLOCK (tran_lock->hold_mutex);
+
+  return lock_hold;
 #endif /* !SERVER_MODE */
 }
 
 /*
- * lock_demote_all_update_inst_locks -
+ * lock_is_waiting_transaction -
  *
- * return: nothing
+ * return:
+ *
+ *   tran_index(in):
  */
-void
-lock_demote_all_update_inst_locks (THREAD_ENTRY * thread_p)
+bool
+lock_is_waiting_transaction (int tran_index)
 {
 #if !defined (SERVER_MODE)
-  return;
+  return false;
 #else /* !SERVER_MODE */
-  int tran_index;		/* transaction table index */
-  TRAN_ISOLATION isolation;	/* transaction isolation level */
-  LK_TRAN_LOCK *tran_lock;
-  LK_ENTRY *curr, *next;
-
-  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
-  isolation = logtb_find_isolation (tran_index);
-  if (LK_UNCOMMITTED_READ_ISOLATION (isolation))
-    {
-      return;			/* There is no update lock */
-    }
-
-  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  THREAD_ENTRY *thrd_array[10];
+  int thrd_count, i;
+  THREAD_ENTRY *thrd_ptr;
 
-  switch (isolation)
+  thrd_count = thread_get_lockwait_entry (tran_index, &thrd_array[0]);
+  for (i = 0; i < thrd_count; i++)
     {
-    case TRAN_SERIALIZABLE:
-    case TRAN_REP_CLASS_REP_INSTANCE:
-      /* demote U_LOCK to S_LOCK/NS_LOCK */
-      for (curr = tran_lock->inst_hold_list; curr != (LK_ENTRY *) NULL;)
+      thrd_ptr = thrd_array[i];
+      (void) thread_lock_entry (thrd_ptr);
+      if (LK_IS_LOCKWAIT_THREAD (thrd_ptr))
 	{
-	  next = curr->tran_next;
-	  if (curr->granted_mode == U_LOCK)
-	    {
-	      (void) lock_internal_demote_update_inst_lock (thread_p, curr);
-	    }
-	  curr = next;
+	  (void) thread_unlock_entry (thrd_ptr);
+	  return true;
 	}
-      return;
-
-    case TRAN_REP_CLASS_COMMIT_INSTANCE:
-    case TRAN_COMMIT_CLASS_COMMIT_INSTANCE:
-      /* remove U_LOCK */
-      for (curr = tran_lock->inst_hold_list; curr != (LK_ENTRY *) NULL;)
+      else
 	{
-	  next = curr->tran_next;
-	  if (curr->granted_mode == U_LOCK)
+	  if (thrd_ptr->lockwait != NULL ||
+	      thrd_ptr->lockwait_state == (int) LOCK_SUSPENDED)
 	    {
-	      lock_internal_perform_unlock_object (thread_p, curr, true,
-						   false);
+	      /* some strange lock wait state.. */
+	      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
+		      ER_LK_STRANGE_LOCK_WAIT, 5, thrd_ptr->lockwait,
+		      thrd_ptr->lockwait_state, thrd_ptr->index,
+		      thrd_ptr->tid, thrd_ptr->tran_index);
 	    }
-	  curr = next;
 	}
-      return;
-
-    default:			/* TRAN_UNKNOWN_ISOLATION */
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_UNKNOWN_ISOLATION, 2,
-	      isolation, tran_index);
-      return;
+      (void) thread_unlock_entry (thrd_ptr);
     }
+
+  return false;
 #endif /* !SERVER_MODE */
 }
+#endif
 
 /*
- * lock_get_object_lock - Find the acquired lock mode
+ * lock_get_class_lock - Get a pointer to lock heap entry acquired by
+ *                        given transaction on given class object
  *
  * return:
  *
- *   oid(in): target object ientifier
- *   class_oid(in): class identifier of the target object
- *   tran_index(in): the transaction table index of target transaction.
- *
- * Note:Find the acquired lock on the given object by the given transaction.
- *     Currently, the value of the "tran_index" must not be NULL_TRAN_INDEX.
+ *   class_oid(in): target class object identifier
+ *   tran_index(in): target transaction
  *
- *     If this function is changed in order to allow NULL_TRAN_INDEX to be
- *     transferred as the value of the "tran_index", this function will
- *     find the resulting lock acquired by all transactions holding a lock
- *     on the given OID (The most powerful lock, actually a combination of
- *     the locks).
+ * Note:This function finds lock entry acquired by the given transaction
+ *     on the given class and then return a pointer to the lock entry.
  */
-LOCK
-lock_get_object_lock (const OID * oid, const OID * class_oid, int tran_index)
+LK_ENTRY *
+lock_get_class_lock (const OID * class_oid, int tran_index)
 {
 #if !defined (SERVER_MODE)
-  return X_LOCK;
+  return NULL;
 #else /* !SERVER_MODE */
-  LOCK lock_mode = NULL_LOCK;	/* return value */
   LK_TRAN_LOCK *tran_lock;
   LK_ENTRY *entry_ptr;
   int rv;
 
-  if (oid == NULL)
+  if (class_oid == NULL)
     {
       er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_BAD_ARGUMENT, 2,
-	      "lk_get_object_lock", "NULL OID pointer");
-      return NULL_LOCK;
+	      "lk_get_class_lock_ptr", "NULL ClassOID pointer");
+      return NULL;
     }
-  if (tran_index == NULL_TRAN_INDEX)
+  if (OID_ISNULL (class_oid))
     {
       er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_BAD_ARGUMENT, 2,
-	      "lk_get_object_lock", "NULL_TRAN_INDEX");
-      return NULL_LOCK;
+	      "lk_get_class_lock_ptr", "NULL_ClassOID");
+      return NULL;
     }
 
   /* get a pointer to transaction lock info entry */
   tran_lock = &lk_Gl.tran_lock_table[tran_index];
 
-  /*
-   * case 1: root class lock
-   */
-  /* get the granted lock mode acquired on the root class oid */
-  if (OID_EQ (oid, oid_Root_class_oid))
+  /* case 1: root class lock */
+  if (OID_EQ (class_oid, oid_Root_class_oid))
     {
       MUTEX_LOCK (rv, tran_lock->hold_mutex);
-      if (tran_lock->root_class_hold != (LK_ENTRY *) NULL)
+      entry_ptr = tran_lock->root_class_hold;
+      MUTEX_UNLOCK (tran_lock->hold_mutex);
+      return entry_ptr;		/* might be NULL */
+    }
+
+  /* case 2: general class lock */
+  MUTEX_LOCK (rv, tran_lock->hold_mutex);
+  entry_ptr = tran_lock->class_hold_list;
+  for (; entry_ptr != (LK_ENTRY *) NULL; entry_ptr = entry_ptr->tran_next)
+    {
+      if (OID_EQ (&entry_ptr->res_head->oid, class_oid))	/* found */
+	{
+	  break;
+	}
+    }
+  MUTEX_UNLOCK (tran_lock->hold_mutex);
+  return entry_ptr;		/* might be NULL */
+#endif /* !SERVER_MODE */
+}
+
+/*
+ * lock_force_timeout_lock_wait_transactions - All lock-wait transactions
+ *                               are forced to timeout
+ *
+ * return: nothing
+ *
+ * Note:All lock-waiting transacions are forced to timeout.
+ *     For this task, all lock-waiting threads are searched and
+ *     then the threads are forced to timeout.
+ */
+void
+lock_force_timeout_lock_wait_transactions (unsigned short stop_phase)
+{
+#if !defined (SERVER_MODE)
+  return;
+#else /* !SERVER_MODE */
+  int i;
+  THREAD_ENTRY *thrd;
+  CSS_CONN_ENTRY *conn_p;
+
+  for (i = 1; i < thread_num_total_threads (); i++)
+    {
+      thrd = thread_find_entry_by_index (i);
+
+      conn_p = thrd->conn_entry;
+      if ((stop_phase > THREAD_WORKER_STOP_PHASE_0 && conn_p == NULL) ||
+	  (conn_p && conn_p->stop_phase != stop_phase))
 	{
-	  lock_mode = tran_lock->root_class_hold->granted_mode;
+	  continue;
 	}
-      MUTEX_UNLOCK (tran_lock->hold_mutex);
-      return lock_mode;		/* might be NULL_LOCK */
-    }
 
-  /*
-   * case 2: general class lock
-   */
-  /* get the granted lock mode acquired on the given class oid */
-  if (class_oid == NULL || OID_EQ (class_oid, oid_Root_class_oid))
-    {
-      MUTEX_LOCK (rv, tran_lock->hold_mutex);
-      entry_ptr = tran_lock->class_hold_list;
-      for (; entry_ptr != (LK_ENTRY *) NULL; entry_ptr = entry_ptr->tran_next)
+      (void) thread_lock_entry (thrd);
+      if (LK_IS_LOCKWAIT_THREAD (thrd))
 	{
-	  if (OID_EQ (&entry_ptr->res_head->oid, oid))
-	    {			/* found */
-	      lock_mode = entry_ptr->granted_mode;
-	      break;
+	  /* wake up the thread */
+	  lock_resume ((LK_ENTRY *) thrd->lockwait, LOCK_RESUMED_TIMEOUT);
+	}
+      else
+	{
+	  if (thrd->lockwait != NULL
+	      || thrd->lockwait_state == (int) LOCK_SUSPENDED)
+	    {
+	      /* some strange lock wait state.. */
+	      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
+		      ER_LK_STRANGE_LOCK_WAIT, 5, thrd->lockwait,
+		      thrd->lockwait_state, thrd->index, thrd->tid,
+		      thrd->tran_index);
 	    }
+	  /* release the thread entry mutex */
+	  (void) thread_unlock_entry (thrd);
 	}
-      MUTEX_UNLOCK (tran_lock->hold_mutex);
-      return lock_mode;		/* might be NULL_LOCK */
     }
+  return;
+#endif /* !SERVER_MODE */
+}
 
-  MUTEX_LOCK (rv, tran_lock->hold_mutex);
-  entry_ptr = tran_lock->class_hold_list;
-  for (; entry_ptr != (LK_ENTRY *) NULL; entry_ptr = entry_ptr->tran_next)
-    {
-      if (OID_EQ (&entry_ptr->res_head->oid, class_oid))
-	{			/* found */
-	  lock_mode = entry_ptr->granted_mode;
-	  break;
-	}
-    }
-  /* If the class lock mode is S_LOCK or X_LOCK,
-   * the lock is held on the instance implicitly.
-   * In this case, there is no need to check instance lock.
-   * If the class lock mode is SIX_LOCK,
-   * S_LOCK is held on the instance implicitly.
-   * In this case, we must check for a possible X_LOCK on the instance.
-   * In other cases, we must check the lock held on the instance.
-   */
-  if (lock_mode != S_LOCK && lock_mode != X_LOCK)
+/*
+ * lock_force_timeout_expired_wait_transactions - Transaction is timeout if its waiting time has
+ *                           expired or it is interrupted
+ *
+ * return: true if the thread was timed out or
+ *                       false if the thread was not timed out.
+ *
+ *   thrd_entry(in): thread entry pointer
+ *
+ * Note:If the given thread is waiting on a lock to be granted, and
+ *     either its expiration time has expired or it is interrupted,
+ *     the thread is timed-out.
+ *     If NULL is given, it applies to all threads.
+ */
+bool
+lock_force_timeout_expired_wait_transactions (void *thrd_entry)
+{
+#if !defined (SERVER_MODE)
+  return true;
+#else /* !SERVER_MODE */
+  int i;
+  bool ignore;
+  THREAD_ENTRY *thrd;
+
+  if (thrd_entry != NULL)
     {
-      if (lock_mode == SIX_LOCK)
+      thrd = (THREAD_ENTRY *) thrd_entry;
+      (void) thread_lock_entry (thrd);
+      if (LK_IS_LOCKWAIT_THREAD (thrd))
 	{
-	  lock_mode = S_LOCK;
+	  struct timeval tv;
+	  double etime;
+	  (void) gettimeofday (&tv, NULL);
+	  etime = ((double) tv.tv_sec * 1000000 + tv.tv_usec) / 1000;
+	  if ((LK_CAN_TIMEOUT (thrd->lockwait_nsecs)
+	       && etime - thrd->lockwait_stime > thrd->lockwait_nsecs)
+	      || logtb_is_interrupted_tran (NULL, true, &ignore,
+					    thrd->tran_index))
+	    {
+	      /* wake up the thread */
+	      lock_resume ((LK_ENTRY *) thrd->lockwait, LOCK_RESUMED_TIMEOUT);
+	      return true;
+	    }
+	  else
+	    {
+	      /* release the thread entry mutex */
+	      (void) thread_unlock_entry (thrd);
+	      return false;
+	    }
 	}
       else
 	{
-	  lock_mode = NULL_LOCK;
+	  if (thrd->lockwait != NULL
+	      || thrd->lockwait_state == (int) LOCK_SUSPENDED)
+	    {
+	      /* some strange lock wait state.. */
+	      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
+		      ER_LK_STRANGE_LOCK_WAIT, 5, thrd->lockwait,
+		      thrd->lockwait_state, thrd->index, thrd->tid,
+		      thrd->tran_index);
+	    }
+	  /* release the thread entry mutex */
+	  (void) thread_unlock_entry (thrd);
+	  return false;
 	}
-      entry_ptr = tran_lock->inst_hold_list;
-      for (; entry_ptr != (LK_ENTRY *) NULL; entry_ptr = entry_ptr->tran_next)
+    }
+  else
+    {
+      for (i = 1; i < thread_num_total_threads (); i++)
 	{
-	  if (OID_EQ (&entry_ptr->res_head->oid, oid)
-	      && OID_EQ (&entry_ptr->res_head->class_oid, class_oid))
-	    {			/* found */
-	      lock_mode = entry_ptr->granted_mode;
-	      break;
+	  thrd = thread_find_entry_by_index (i);
+	  (void) thread_lock_entry (thrd);
+	  if (LK_IS_LOCKWAIT_THREAD (thrd))
+	    {
+	      struct timeval tv;
+	      double etime;
+	      (void) gettimeofday (&tv, NULL);
+	      etime = ((double) tv.tv_sec * 1000000 + tv.tv_usec) / 1000;
+	      if ((LK_CAN_TIMEOUT (thrd->lockwait_nsecs)
+		   && etime - thrd->lockwait_stime > thrd->lockwait_nsecs)
+		  || logtb_is_interrupted_tran (NULL, true, &ignore,
+						thrd->tran_index))
+		{
+		  /* wake up the thread */
+		  lock_resume ((LK_ENTRY *) thrd->lockwait,
+			       LOCK_RESUMED_TIMEOUT);
+		}
+	      else
+		{
+		  /* release the thread entry mutex */
+		  (void) thread_unlock_entry (thrd);
+		}
+	    }
+	  else
+	    {
+	      if (thrd->lockwait != NULL
+		  || thrd->lockwait_state == (int) LOCK_SUSPENDED)
+		{
+		  /* some strange lock wait state.. */
+		  er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
+			  ER_LK_STRANGE_LOCK_WAIT, 5, thrd->lockwait,
+			  thrd->lockwait_state, thrd->index, thrd->tid,
+			  thrd->tran_index);
+		}
+	      /* release the thread entry mutex */
+	      (void) thread_unlock_entry (thrd);
 	    }
 	}
+      return true;
     }
-  MUTEX_UNLOCK (tran_lock->hold_mutex);
-  return lock_mode;		/* might be NULL_LOCK */
 #endif /* !SERVER_MODE */
 }
 
 /*
- * lock_has_xlock - Does transaction have an exclusive lock on any resource ?
+ * lock_notify_isolation_incons - Notify of possible inconsistencies (no
+ *                             repeatable reads) due to transaction isolation
+ *                             level
  *
- * return:
+ * return: nothing.
  *
- * Note:Find if the current transaction has any kind of exclusive lock
- *     on any lock resource.
+ *   fun(in): Function to notify
+ *   args(in): Extra arguments for function
+ *
+ * Note:The current transaction is notified of any possible
+ *              inconsistencies due to its isolation level. For each possible
+ *              inconsistency the given function is called to decache any
+ *              copies of the object.
  */
-bool
-lock_has_xlock (THREAD_ENTRY * thread_p)
+void
+lock_notify_isolation_incons (THREAD_ENTRY * thread_p,
+			      bool (*fun) (const OID * oid, void *args),
+			      void *args)
 {
 #if !defined (SERVER_MODE)
-  return lk_Standalone_has_xlock;
+  return;
 #else /* !SERVER_MODE */
+  TRAN_ISOLATION isolation;
   int tran_index;
   LK_TRAN_LOCK *tran_lock;
-  LOCK lock_mode;
-  LK_ENTRY *entry_ptr;
+  LK_ENTRY *curr;
+  LK_ENTRY *prev;
+  bool ret_val;
   int rv;
 
-  /*
-   * Exclusive locks in this context mean IX_LOCK, SIX_LOCK and X_LOCK.
-   * NOTE that NX_LOCK and U_LOCK are excluded from exclusive locks.
-   * Because, NX_LOCK is only for next-key locking and U_LOCK is currently
-   * for reading the object.
-   */
   tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  isolation = logtb_find_isolation (tran_index);
+  if (isolation == TRAN_REP_CLASS_REP_INSTANCE
+      || isolation == TRAN_SERIALIZABLE)
+    {
+      return;			/* Nothing was released */
+    }
+
   tran_lock = &lk_Gl.tran_lock_table[tran_index];
-  MUTEX_LOCK (rv, tran_lock->hold_mutex);
+  MUTEX_LOCK (rv, tran_lock->non2pl_mutex);
 
-  /* 1. check root class lock */
-  if (tran_lock->root_class_hold != (LK_ENTRY *) NULL)
+  prev = (LK_ENTRY *) NULL;
+  curr = tran_lock->non2pl_list;
+  while (tran_lock->num_incons_non2pl > 0 && curr != (LK_ENTRY *) NULL)
     {
-      lock_mode = tran_lock->root_class_hold->granted_mode;
-      if (lock_mode == X_LOCK || lock_mode == IX_LOCK
-	  || lock_mode == SIX_LOCK)
+      if (curr->granted_mode != INCON_NON_TWO_PHASE_LOCK)
 	{
-	  MUTEX_UNLOCK (tran_lock->hold_mutex);
-	  return true;
+	  prev = curr;
+	  curr = curr->tran_next;
+	  continue;
+	}
+      /* curr->granted_mode == INCON_NON_TWO_PHASE_LOCK */
+      ret_val = (*fun) (&curr->res_head->oid, args);
+      if (ret_val != true)
+	{			/* the notification area is full */
+	  MUTEX_UNLOCK ((tran_lock->non2pl_mutex));
+	  return;		/* stop */
 	}
-    }
 
-  /* 2. check general class locks */
-  entry_ptr = tran_lock->class_hold_list;
-  while (entry_ptr != (LK_ENTRY *) NULL)
-    {
-      lock_mode = entry_ptr->granted_mode;
-      if (lock_mode == X_LOCK || lock_mode == IX_LOCK
-	  || lock_mode == SIX_LOCK)
+      /* ret_val == true: the non-2pl entry should be freed. */
+      /* 1. remove it from transaction non2pl list */
+      if (prev == (LK_ENTRY *) NULL)
+	{
+	  tran_lock->non2pl_list = curr->tran_next;
+	}
+      else
+	{
+	  prev->tran_next = curr->tran_next;
+	}
+
+      if (curr->granted_mode == INCON_NON_TWO_PHASE_LOCK)
 	{
-	  MUTEX_UNLOCK (tran_lock->hold_mutex);
-	  return true;
+	  tran_lock->num_incons_non2pl -= 1;
 	}
-      entry_ptr = entry_ptr->tran_next;
-    }
 
-  /* 3. checking instance locks is not needed. According to MGL ptotocol,
-   *    an exclusive class lock has been acquired with intention mode
-   *    before an exclusive instance is acquired.
-   */
+      /* 2. remove it from resource non2pl list and free it */
+      lock_remove_non2pl (curr, tran_index);
+    }
 
-  MUTEX_UNLOCK (tran_lock->hold_mutex);
-  return false;
+  /* release transaction non2pl mutex */
+  MUTEX_UNLOCK (tran_lock->non2pl_mutex);
+  return;
 #endif /* !SERVER_MODE */
 }
 
-#if defined(ENABLE_UNUSED_FUNCTION)
 /*
- * lock_has_lock_transaction - Does transaction have any lock on any resource ?
+ * lock_check_local_deadlock_detection - Check local deadlock detection interval
  *
  * return:
  *
- *   tran_index(in):
- *
- * Note:Find if given transaction has any kind of lock.
- *     Used by css_check_for_clients_down() to eliminate needless pinging.
+ * Note:check if the local deadlock detection should be performed.
  */
 bool
-lock_has_lock_transaction (int tran_index)
+lock_check_local_deadlock_detection (void)
 {
 #if !defined (SERVER_MODE)
-  return lk_Standalone_has_xlock;
+  return false;
 #else /* !SERVER_MODE */
-  LK_TRAN_LOCK *tran_lock;
-  bool lock_hold;
-  int rv;
-
-  tran_lock = &lk_Gl.tran_lock_table[tran_index];
-  MUTEX_LOCK (rv, tran_lock->hold_mutex);
-  if (tran_lock->root_class_hold != (LK_ENTRY *) NULL
-      || tran_lock->class_hold_list != (LK_ENTRY *) NULL
-      || tran_lock->inst_hold_list != (LK_ENTRY *) NULL
-      || tran_lock->non2pl_list != (LK_ENTRY *) NULL)
+  /* check deadlock detection interval */
+  if (difftime (time (NULL), lk_Gl.last_deadlock_run)
+      < PRM_LK_RUN_DEADLOCK_INTERVAL)
     {
-      lock_hold = true;
+      return false;
     }
   else
     {
-      lock_hold = false;
+      return true;
     }
-  MUTEX_UNLOCK (tran_lock->hold_mutex);
-
-  return lock_hold;
 #endif /* !SERVER_MODE */
 }
 
 /*
- * lock_is_waiting_transaction -
+ * lock_detect_local_deadlock - Run the local deadlock detection
  *
- * return:
+ * return: nothing
  *
- *   tran_index(in):
+ * Note:Run the deadlock detection. For every cycle either timeout or
+ *     abort a transaction. The timeout option is always preferred over
+ *     the unilaterally abort option. When the unilaterally abort option
+ *     is exercised, the youngest transaction in the cycle is selected.
+ *     The youngest transaction is hopefully the one that has done less work.
+ *
+ *     First, allocate heaps for WFG table from local memory.
+ *     Check whether deadlock(s) have been occurred or not.
+ *
+ *     Deadlock detection is peformed via exhaustive loop construction
+ *     which indicates the wait-for-relationship.
+ *     If deadlock is detected,
+ *     the first transaction which enables a cycle
+ *     when scanning from the first of object lock table to the last of it.
+ *
+ *     The deadlock of victims are waken up and aborted by themselves.
+ *
+ *     Last, free WFG framework.
  */
-bool
-lock_is_waiting_transaction (int tran_index)
+void
+lock_detect_local_deadlock (THREAD_ENTRY * thread_p)
 {
 #if !defined (SERVER_MODE)
-  return false;
+  return;
 #else /* !SERVER_MODE */
-  THREAD_ENTRY *thrd_array[10];
-  int thrd_count, i;
-  THREAD_ENTRY *thrd_ptr;
+  int k, s, t;
+  LK_RES_BLOCK *res_block;
+  LK_RES *res_ptr;
+  LK_ENTRY *hi, *hj;
+  LK_WFG_NODE *TWFG_node;
+  LK_WFG_EDGE *TWFG_edge;
+  int i, rv;
+  int compat1, compat2;
 
-  thrd_count = thread_get_lockwait_entry (tran_index, &thrd_array[0]);
-  for (i = 0; i < thrd_count; i++)
+  /* initialize deadlock detection related structures */
+
+  /* initialize transaction WFG node table..
+   * The current transaction might be old deadlock victim.
+   * And, the transaction may have not been aborted, until now.
+   * Even if the transaction(old deadlock victim) has not been aborted,
+   * set checked_by_deadlock_detector of the transaction to true.
+   */
+  for (i = 1; i < lk_Gl.num_trans; i++)
     {
-      thrd_ptr = thrd_array[i];
-      (void) thread_lock_entry (thrd_ptr);
-      if (LK_IS_LOCKWAIT_THREAD (thrd_ptr))
-	{
-	  (void) thread_unlock_entry (thrd_ptr);
-	  return true;
-	}
-      else
+      lk_Gl.TWFG_node[i].first_edge = -1;
+      lk_Gl.TWFG_node[i].tran_edge_seq_num = 0;
+      lk_Gl.TWFG_node[i].checked_by_deadlock_detector = true;
+    }
+
+  /* initialize transaction WFG edge table */
+  lk_Gl.TWFG_edge = &TWFG_edge_block[0];
+  lk_Gl.max_TWFG_edge = LK_MIN_TWFG_EDGE_COUNT;	/* initial value */
+  for (i = 0; i < LK_MIN_TWFG_EDGE_COUNT; i++)
+    {
+      lk_Gl.TWFG_edge[i].to_tran_index = -1;
+      lk_Gl.TWFG_edge[i].next = (i + 1);
+    }
+  lk_Gl.TWFG_edge[lk_Gl.max_TWFG_edge - 1].next = -1;
+  lk_Gl.TWFG_free_edge_idx = 0;
+
+  /* initialize global_edge_seq_num */
+  lk_Gl.global_edge_seq_num = 0;
+
+  /* initialize victim count */
+  victim_count = 0;		/* used as index of victims array */
+
+  /* hold the deadlock detection mutex */
+  MUTEX_LOCK (rv, lk_Gl.DL_detection_mutex);
+
+  /* lock-wait edge construction for object lock resource table */
+  MUTEX_LOCK (rv, lk_Gl.obj_res_block_list_mutex);
+
+  for (res_block = lk_Gl.obj_res_block_list;
+       res_block != NULL; res_block = res_block->next_block)
+    {
+      for (k = 0; k < res_block->count; k++)
 	{
-	  if (thrd_ptr->lockwait != NULL ||
-	      thrd_ptr->lockwait_state == (int) LOCK_SUSPENDED)
+	  /* If the holder list is empty, then the waiter list is also empty.
+	   * Therefore, res_block->block[k].waiter == NULL cannot be checked.
+	   */
+	  if (res_block->block[k].holder == (LK_ENTRY *) NULL)
+	    {
+	      if (res_block->block[k].waiter == (LK_ENTRY *) NULL)
+		{
+		  continue;
+		}
+	    }
+
+	  res_ptr = &res_block->block[k];
+
+	  /* hold resource mutex */
+	  MUTEX_LOCK (rv, res_ptr->res_mutex);
+
+	  if (res_ptr->holder == NULL)
+	    {
+	      if (res_ptr->waiter == NULL)
+		{
+		  MUTEX_UNLOCK (res_ptr->res_mutex);
+		  continue;
+		}
+	      else
+		{
+#if defined(CUBRID_DEBUG)
+		  FILE *lk_fp;
+		  time_t cur_time;
+
+		  lk_fp = fopen ("lock_waiter_only_info.log", "a")
+		    if (lk_fp != NULL)
+		    {
+		      cur_time = time (NULL);
+		      fprintf (lk_fp,
+			       "##########################################\n");
+		      fprintf (lk_fp, "# current time: %s\n",
+			       ctime (&cur_time));
+		      lock_dump_resource (lk_fp, res_ptr);
+		      fprintf (lk_fp,
+			       "##########################################\n");
+		      fclose (lk_fp);
+		    }
+#endif /* CUBRID_DEBUG */
+		  er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
+			  ER_LK_LOCK_WAITER_ONLY, 1,
+			  "lock_waiter_only_info.log");
+
+		  if (res_ptr->total_holders_mode != NULL_LOCK)
+		    {
+		      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
+			      ER_LK_TOTAL_HOLDERS_MODE, 1,
+			      res_ptr->total_holders_mode);
+		      res_ptr->total_holders_mode = NULL_LOCK;
+		    }
+		  (void) lock_grant_blocked_waiter (thread_p, res_ptr);
+		}
+	    }
+
+	  /* among holders */
+	  for (hi = res_ptr->holder; hi != NULL; hi = hi->next)
+	    {
+	      if (hi->blocked_mode == NULL_LOCK)
+		{
+		  break;
+		}
+	      for (hj = hi->next; hj != NULL; hj = hj->next)
+		{
+		  assert (hi->granted_mode >= NULL_LOCK
+			  && hi->blocked_mode >= NULL_LOCK);
+		  assert (hj->granted_mode >= NULL_LOCK
+			  && hj->blocked_mode >= NULL_LOCK);
+
+		  compat1 = lock_Comp[hj->blocked_mode][hi->granted_mode];
+		  compat2 = lock_Comp[hj->blocked_mode][hi->blocked_mode];
+		  assert (compat1 != DB_NA && compat2 != DB_NA);
+
+		  if (compat1 == false || compat2 == false)
+		    {
+		      (void) lock_add_WFG_edge (hj->tran_index,
+						hi->tran_index, true,
+						(time_t) (hj->thrd_entry->
+							  lockwait_stime /
+							  1000));
+		    }
+
+		  compat1 = lock_Comp[hi->blocked_mode][hj->granted_mode];
+		  assert (compat1 != DB_NA);
+
+		  if (compat1 == false)
+		    {
+		      (void) lock_add_WFG_edge (hi->tran_index,
+						hj->tran_index, true,
+						(time_t) (hi->thrd_entry->
+							  lockwait_stime /
+							  1000));
+		    }
+		}
+	    }
+
+	  /* from waiters in the waiter to holders */
+	  for (hi = res_ptr->holder; hi != NULL; hi = hi->next)
+	    {
+	      for (hj = res_ptr->waiter; hj != NULL; hj = hj->next)
+		{
+		  assert (hi->granted_mode >= NULL_LOCK
+			  && hi->blocked_mode >= NULL_LOCK);
+		  assert (hj->granted_mode >= NULL_LOCK
+			  && hj->blocked_mode >= NULL_LOCK);
+
+		  compat1 = lock_Comp[hj->blocked_mode][hi->granted_mode];
+		  compat2 = lock_Comp[hj->blocked_mode][hi->blocked_mode];
+		  assert (compat1 != DB_NA && compat2 != DB_NA);
+
+		  if (compat1 == false || compat2 == false)
+		    {
+		      (void) lock_add_WFG_edge (hj->tran_index,
+						hi->tran_index, true,
+						(time_t) (hj->thrd_entry->
+							  lockwait_stime /
+							  1000));
+		    }
+		}
+	    }
+
+	  /* from waiters in the waiter to other waiters in the waiter */
+	  for (hi = res_ptr->waiter; hi != NULL; hi = hi->next)
 	    {
-	      /* some strange lock wait state.. */
-	      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
-		      ER_LK_STRANGE_LOCK_WAIT, 5, thrd_ptr->lockwait,
-		      thrd_ptr->lockwait_state, thrd_ptr->index,
-		      thrd_ptr->tid, thrd_ptr->tran_index);
+	      for (hj = hi->next; hj != NULL; hj = hj->next)
+		{
+		  assert (hj->blocked_mode >= NULL_LOCK
+			  && hi->blocked_mode >= NULL_LOCK);
+
+		  compat1 = lock_Comp[hj->blocked_mode][hi->blocked_mode];
+		  assert (compat1 != DB_NA);
+
+		  if (compat1 == false)
+		    {
+		      (void) lock_add_WFG_edge (hj->tran_index,
+						hi->tran_index, false,
+						(time_t) (hj->thrd_entry->
+							  lockwait_stime /
+							  1000));
+		    }
+		}
 	    }
+
+	  /* release resource mutex */
+	  MUTEX_UNLOCK (res_ptr->res_mutex);
 	}
-      (void) thread_unlock_entry (thrd_ptr);
     }
 
-  return false;
-#endif /* !SERVER_MODE */
-}
-#endif
-
-/*
- * lock_get_class_lock - Get a pointer to lock heap entry acquired by
- *                        given transaction on given class object
- *
- * return:
- *
- *   class_oid(in): target class object identifier
- *   tran_index(in): target transaction
- *
- * Note:This function finds lock entry acquired by the given transaction
- *     on the given class and then return a pointer to the lock entry.
- */
-LK_ENTRY *
-lock_get_class_lock (const OID * class_oid, int tran_index)
-{
-#if !defined (SERVER_MODE)
-  return NULL;
-#else /* !SERVER_MODE */
-  LK_TRAN_LOCK *tran_lock;
-  LK_ENTRY *entry_ptr;
-  int rv;
+  MUTEX_UNLOCK (lk_Gl.obj_res_block_list_mutex);
 
-  if (class_oid == NULL)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_BAD_ARGUMENT, 2,
-	      "lk_get_class_lock_ptr", "NULL ClassOID pointer");
-      return NULL;
-    }
-  if (OID_ISNULL (class_oid))
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_BAD_ARGUMENT, 2,
-	      "lk_get_class_lock_ptr", "NULL_ClassOID");
-      return NULL;
-    }
+  /* release DL detection mutex */
+  MUTEX_UNLOCK (lk_Gl.DL_detection_mutex);
 
-  /* get a pointer to transaction lock info entry */
-  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  /* simple notation for using in the following statements */
+  TWFG_node = lk_Gl.TWFG_node;
+  TWFG_edge = lk_Gl.TWFG_edge;
 
-  /* case 1: root class lock */
-  if (OID_EQ (class_oid, oid_Root_class_oid))
-    {
-      MUTEX_LOCK (rv, tran_lock->hold_mutex);
-      entry_ptr = tran_lock->root_class_hold;
-      MUTEX_UNLOCK (tran_lock->hold_mutex);
-      return entry_ptr;		/* might be NULL */
-    }
+  /*
+   * deadlock detection and victim selection
+   */
 
-  /* case 2: general class lock */
-  MUTEX_LOCK (rv, tran_lock->hold_mutex);
-  entry_ptr = tran_lock->class_hold_list;
-  for (; entry_ptr != (LK_ENTRY *) NULL; entry_ptr = entry_ptr->tran_next)
+  for (k = 1; k < lk_Gl.num_trans; k++)
     {
-      if (OID_EQ (&entry_ptr->res_head->oid, class_oid))	/* found */
-	{
-	  break;
-	}
+      TWFG_node[k].current = TWFG_node[k].first_edge;
+      TWFG_node[k].ancestor = -1;
     }
-  MUTEX_UNLOCK (tran_lock->hold_mutex);
-  return entry_ptr;		/* might be NULL */
-#endif /* !SERVER_MODE */
-}
-
-/*
- * lock_force_timeout_lock_wait_transactions - All lock-wait transactions
- *                               are forced to timeout
- *
- * return: nothing
- *
- * Note:All lock-waiting transacions are forced to timeout.
- *     For this task, all lock-waiting threads are searched and
- *     then the threads are forced to timeout.
- */
-void
-lock_force_timeout_lock_wait_transactions (unsigned short stop_phase)
-{
-#if !defined (SERVER_MODE)
-  return;
-#else /* !SERVER_MODE */
-  int i;
-  THREAD_ENTRY *thrd;
-  CSS_CONN_ENTRY *conn_p;
-
-  for (i = 1; i < thread_num_total_threads (); i++)
+  for (k = 1; k < lk_Gl.num_trans; k++)
     {
-      thrd = thread_find_entry_by_index (i);
-
-      conn_p = thrd->conn_entry;
-      if ((stop_phase > THREAD_WORKER_STOP_PHASE_0 && conn_p == NULL) ||
-	  (conn_p && conn_p->stop_phase != stop_phase))
+      if (TWFG_node[k].current == -1)
 	{
 	  continue;
 	}
-
-      (void) thread_lock_entry (thrd);
-      if (LK_IS_LOCKWAIT_THREAD (thrd))
-	{
-	  /* wake up the thread */
-	  lock_resume ((LK_ENTRY *) thrd->lockwait, LOCK_RESUMED_TIMEOUT);
-	}
-      else
+      s = k;
+      TWFG_node[s].ancestor = -2;
+      for (; s != -2;)
 	{
-	  if (thrd->lockwait != NULL
-	      || thrd->lockwait_state == (int) LOCK_SUSPENDED)
+	  if (TWFG_node[s].checked_by_deadlock_detector == false
+	      || TWFG_node[s].thrd_wait_stime == 0
+	      || (TWFG_node[s].current != -1
+		  && (TWFG_node[s].thrd_wait_stime >
+		      TWFG_edge[TWFG_node[s].current].edge_wait_stime)))
 	    {
-	      /* some strange lock wait state.. */
-	      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
-		      ER_LK_STRANGE_LOCK_WAIT, 5, thrd->lockwait,
-		      thrd->lockwait_state, thrd->index, thrd->tid,
-		      thrd->tran_index);
+	      /* A new transaction started */
+	      TWFG_node[s].first_edge = -1;
+	      TWFG_node[s].current = -1;
 	    }
-	  /* release the thread entry mutex */
-	  (void) thread_unlock_entry (thrd);
-	}
-    }
-  return;
-#endif /* !SERVER_MODE */
-}
-
-/*
- * lock_force_timeout_expired_wait_transactions - Transaction is timeout if its waiting time has
- *                           expired or it is interrupted
- *
- * return: true if the thread was timed out or
- *                       false if the thread was not timed out.
- *
- *   thrd_entry(in): thread entry pointer
- *
- * Note:If the given thread is waiting on a lock to be granted, and
- *     either its expiration time has expired or it is interrupted,
- *     the thread is timed-out.
- *     If NULL is given, it applies to all threads.
- */
-bool
-lock_force_timeout_expired_wait_transactions (void *thrd_entry)
-{
-#if !defined (SERVER_MODE)
-  return true;
-#else /* !SERVER_MODE */
-  int i;
-  bool ignore;
-  THREAD_ENTRY *thrd;
 
-  if (thrd_entry != NULL)
-    {
-      thrd = (THREAD_ENTRY *) thrd_entry;
-      (void) thread_lock_entry (thrd);
-      if (LK_IS_LOCKWAIT_THREAD (thrd))
-	{
-	  struct timeval tv;
-	  double etime;
-	  (void) gettimeofday (&tv, NULL);
-	  etime = ((double) tv.tv_sec * 1000000 + tv.tv_usec) / 1000;
-	  if ((LK_CAN_TIMEOUT (thrd->lockwait_nsecs)
-	       && etime - thrd->lockwait_stime > thrd->lockwait_nsecs)
-	      || logtb_is_interrupted_tran (NULL, true, &ignore,
-					    thrd->tran_index))
+	  if (TWFG_node[s].current == -1)
 	    {
-	      /* wake up the thread */
-	      lock_resume ((LK_ENTRY *) thrd->lockwait, LOCK_RESUMED_TIMEOUT);
-	      return true;
+	      t = TWFG_node[s].ancestor;
+	      TWFG_node[s].ancestor = -1;
+	      s = t;
+	      if (s != -2)
+		{
+		  TWFG_node[s].current = TWFG_edge[TWFG_node[s].current].next;
+		}
+	      continue;
 	    }
-	  else
+
+	  t = TWFG_edge[TWFG_node[s].current].to_tran_index;
+
+	  if (t == -2)
+	    {			/* old WFG edge */
+	      TWFG_node[s].current = TWFG_edge[TWFG_node[s].current].next;
+	      continue;
+	    }
+
+	  if (TWFG_node[t].current == -1)
 	    {
-	      /* release the thread entry mutex */
-	      (void) thread_unlock_entry (thrd);
-	      return false;
+	      TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
+	      TWFG_node[s].current = TWFG_edge[TWFG_node[s].current].next;
+	      continue;
 	    }
-	}
-      else
-	{
-	  if (thrd->lockwait != NULL
-	      || thrd->lockwait_state == (int) LOCK_SUSPENDED)
+
+	  if (TWFG_node[t].checked_by_deadlock_detector == false
+	      || TWFG_node[t].thrd_wait_stime == 0
+	      || TWFG_node[t].thrd_wait_stime >
+	      TWFG_edge[TWFG_node[t].current].edge_wait_stime)
 	    {
-	      /* some strange lock wait state.. */
-	      er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
-		      ER_LK_STRANGE_LOCK_WAIT, 5, thrd->lockwait,
-		      thrd->lockwait_state, thrd->index, thrd->tid,
-		      thrd->tran_index);
+	      TWFG_node[t].first_edge = -1;
+	      TWFG_node[t].current = -1;
+	      TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
+	      TWFG_node[s].current = TWFG_edge[TWFG_node[s].current].next;
+	      continue;
 	    }
-	  /* release the thread entry mutex */
-	  (void) thread_unlock_entry (thrd);
-	  return false;
-	}
-    }
-  else
-    {
-      for (i = 1; i < thread_num_total_threads (); i++)
-	{
-	  thrd = thread_find_entry_by_index (i);
-	  (void) thread_lock_entry (thrd);
-	  if (LK_IS_LOCKWAIT_THREAD (thrd))
+
+	  if (TWFG_edge[TWFG_node[s].current].edge_seq_num <
+	      TWFG_node[t].tran_edge_seq_num)
+	    {			/* old WFG edge */
+	      TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
+	      TWFG_node[s].current = TWFG_edge[TWFG_node[s].current].next;
+	      continue;
+	    }
+
+	  if (TWFG_node[t].ancestor != -1)
 	    {
-	      struct timeval tv;
-	      double etime;
-	      (void) gettimeofday (&tv, NULL);
-	      etime = ((double) tv.tv_sec * 1000000 + tv.tv_usec) / 1000;
-	      if ((LK_CAN_TIMEOUT (thrd->lockwait_nsecs)
-		   && etime - thrd->lockwait_stime > thrd->lockwait_nsecs)
-		  || logtb_is_interrupted_tran (NULL, true, &ignore,
-						thrd->tran_index))
-		{
-		  /* wake up the thread */
-		  lock_resume ((LK_ENTRY *) thrd->lockwait,
-			       LOCK_RESUMED_TIMEOUT);
-		}
-	      else
+	      /* A deadlock cycle is found */
+	      lock_select_deadlock_victim (thread_p, s, t);
+	      if (victim_count >= LK_MAX_VICTIM_COUNT)
 		{
-		  /* release the thread entry mutex */
-		  (void) thread_unlock_entry (thrd);
+		  goto final;
 		}
 	    }
 	  else
 	    {
-	      if (thrd->lockwait != NULL
-		  || thrd->lockwait_state == (int) LOCK_SUSPENDED)
-		{
-		  /* some strange lock wait state.. */
-		  er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
-			  ER_LK_STRANGE_LOCK_WAIT, 5, thrd->lockwait,
-			  thrd->lockwait_state, thrd->index, thrd->tid,
-			  thrd->tran_index);
-		}
-	      /* release the thread entry mutex */
-	      (void) thread_unlock_entry (thrd);
+	      TWFG_node[t].ancestor = s;
+	      TWFG_node[t].candidate =
+		TWFG_edge[TWFG_node[s].current].holder_flag;
 	    }
+	  s = t;
 	}
-      return true;
     }
-#endif /* !SERVER_MODE */
-}
 
-/*
- * lock_notify_isolation_incons - Notify of possible inconsistencies (no
- *                             repeatable reads) due to transaction isolation
- *                             level
- *
- * return: nothing.
- *
- *   fun(in): Function to notify
- *   args(in): Extra arguments for function
- *
- * Note:The current transaction is notified of any possible
- *              inconsistencies due to its isolation level. For each possible
- *              inconsistency the given function is called to decache any
- *              copies of the object.
- */
-void
-lock_notify_isolation_incons (THREAD_ENTRY * thread_p,
-			      bool (*fun) (const OID * oid, void *args),
-			      void *args)
-{
-#if !defined (SERVER_MODE)
-  return;
-#else /* !SERVER_MODE */
-  TRAN_ISOLATION isolation;
-  int tran_index;
-  LK_TRAN_LOCK *tran_lock;
-  LK_ENTRY *curr;
-  LK_ENTRY *prev;
-  bool ret_val;
-  int rv;
+final:
 
-  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
-  isolation = logtb_find_isolation (tran_index);
-  if (isolation == TRAN_REP_CLASS_REP_INSTANCE
-      || isolation == TRAN_SERIALIZABLE)
+#if defined(SERVER_MODE) && defined(DIAG_DEVEL)
+  if (victim_count > 0)
     {
-      return;			/* Nothing was released */
+      SET_DIAG_VALUE (diag_executediag, DIAG_OBJ_TYPE_LOCK_DEADLOCK, 1,
+		      DIAG_VAL_SETTYPE_INC, NULL);
+#if 0				/* ACTIVITY PROFILE */
+      ADD_ACTIVITY_DATA (diag_executediag,
+			 DIAG_EVENTCLASS_TYPE_SERVER_LOCK_DEADLOCK, "", "",
+			 victim_count);
+#endif
     }
+#endif /* SERVER_MODE && DIAG_DEVEL */
 
-  tran_lock = &lk_Gl.tran_lock_table[tran_index];
-  MUTEX_LOCK (rv, tran_lock->non2pl_mutex);
+  /* dump deadlock victims according to dump level */
+  if (victim_count > 0 && lk_Gl.dump_level_when_deadlock)
+    {
+      lock_dump_deadlock_victims (thread_p);
+    }
 
-  prev = (LK_ENTRY *) NULL;
-  curr = tran_lock->non2pl_list;
-  while (tran_lock->num_incons_non2pl > 0 && curr != (LK_ENTRY *) NULL)
+
+  /* Now solve the deadlocks (cycles) by executing the cycle resolution
+   * function (e.g., aborting victim)
+   */
+  for (k = 0; k < victim_count; k++)
     {
-      if (curr->granted_mode != INCON_NON_TWO_PHASE_LOCK)
+      if (victims[k].can_timeout)
 	{
-	  prev = curr;
-	  curr = curr->tran_next;
-	  continue;
+	  (void) lock_wakeup_deadlock_victim_timeout (victims[k].tran_index);
 	}
-      /* curr->granted_mode == INCON_NON_TWO_PHASE_LOCK */
-      ret_val = (*fun) (&curr->res_head->oid, args);
-      if (ret_val != true)
-	{			/* the notification area is full */
-	  MUTEX_UNLOCK ((tran_lock->non2pl_mutex));
-	  return;		/* stop */
+      else
+	{
+	  (void) lock_wakeup_deadlock_victim_aborted (victims[k].tran_index);
 	}
+    }
 
-      /* ret_val == true: the non-2pl entry should be freed. */
-      /* 1. remove it from transaction non2pl list */
-      if (prev == (LK_ENTRY *) NULL)
+  /* deallocate memory space used for deadlock detection */
+  if (lk_Gl.max_TWFG_edge > LK_MID_TWFG_EDGE_COUNT)
+    {
+      free_and_init (lk_Gl.TWFG_edge);
+    }
+
+  if (victim_count == 0)
+    {
+      if (lk_Gl.no_victim_case_count < 60)
 	{
-	  tran_lock->non2pl_list = curr->tran_next;
+	  lk_Gl.no_victim_case_count += 1;
 	}
       else
 	{
-	  prev->tran_next = curr->tran_next;
-	}
+	  int worker_threads = 0;
+	  int suspended_threads = 0;
+	  int thrd_index;
+	  THREAD_ENTRY *thrd_ptr;
 
-      if (curr->granted_mode == INCON_NON_TWO_PHASE_LOCK)
-	{
-	  tran_lock->num_incons_non2pl -= 1;
-	}
+	  /* Make sure that we have threads available for another client
+	   * to execute, otherwise Panic...
+	   */
+	  thread_get_info_threads (NULL, &worker_threads, NULL,
+				   &suspended_threads);
+	  if (worker_threads == suspended_threads)
+	    {
+	      /* We must timeout at least one thread, so other clients can execute,
+	       * otherwise, the server will hang.
+	       */
+	      thrd_ptr = thread_find_first_lockwait_entry (&thrd_index);
+	      while (thrd_ptr != NULL)
+		{
+		  if (lock_wakeup_deadlock_victim_timeout
+		      (thrd_ptr->tran_index) == true)
+		    {
+		      break;
+		    }
+		  thrd_ptr = thread_find_next_lockwait_entry (&thrd_index);
+		}
 
-      /* 2. remove it from resource non2pl list and free it */
-      lock_remove_non2pl (curr, tran_index);
+	      if (thrd_ptr != NULL)
+		{
+		  er_set (ER_NOTIFICATION_SEVERITY, ARG_FILE_LINE,
+			  ER_LK_NOTENOUGH_ACTIVE_THREADS, 3, worker_threads,
+			  logtb_get_number_assigned_tran_indices (),
+			  thrd_ptr->tran_index);
+		}
+	    }
+	  lk_Gl.no_victim_case_count = 0;
+	}
     }
 
-  /* release transaction non2pl mutex */
-  MUTEX_UNLOCK (tran_lock->non2pl_mutex);
+  /* save the last deadlock run time */
+  lk_Gl.last_deadlock_run = time (NULL);
+
   return;
 #endif /* !SERVER_MODE */
 }
 
+#if defined(SERVER_MODE)
 /*
- * lock_check_local_deadlock_detection - Check local deadlock detection interval
+ * lock_add_new_lock_waiter - Queue a lock waiter for the deadlock detector
  *
- * return:
+ * return: nothing
  *
- * Note:check if the local deadlock detection should be performed.
+ *   tran_index(in): transaction which has started to wait
+ *
+ * Note:A deadlock cycle is closed by the last transaction which starts to
+ *     wait in it. Therefore, a new cycle can be found by searching the
+ *     wait-for graph only from new lock waiters.
  */
-bool
-lock_check_local_deadlock_detection (void)
+static void
+lock_add_new_lock_waiter (int tran_index)
 {
-#if !defined (SERVER_MODE)
-  return false;
-#else /* !SERVER_MODE */
-  /* check deadlock detection interval */
-  if (difftime (time (NULL), lk_Gl.last_deadlock_run)
-      < PRM_LK_RUN_DEADLOCK_INTERVAL)
-    {
-      return false;
-    }
-  else
+  int rv;
+
+  MUTEX_LOCK (rv, lk_Gl.DL_new_waiter_mutex);
+  if (lk_Gl.TWFG_node[tran_index].DL_new_waiter == false
+      && lk_Gl.DL_num_new_waiters < lk_Gl.num_trans)
     {
-      return true;
+      lk_Gl.TWFG_node[tran_index].DL_new_waiter = true;
+      lk_Gl.DL_new_waiters[lk_Gl.DL_num_new_waiters++] = tran_index;
     }
-#endif /* !SERVER_MODE */
+  MUTEX_UNLOCK (lk_Gl.DL_new_waiter_mutex);
 }
+#endif /* SERVER_MODE */
 
+#if defined(SERVER_MODE)
 /*
- * lock_detect_local_deadlock - Run the local deadlock detection
+ * lock_DL_add_edge - Add an outgoing edge of the last pushed transaction
  *
- * return: nothing
- *
- * Note:Run the deadlock detection. For every cycle either timeout or
- *     abort a transaction. The timeout option is always preferred over
- *     the unilaterally abort option. When the unilaterally abort option
- *     is exercised, the youngest transaction in the cycle is selected.
- *     The youngest transaction is hopefully the one that has done less work.
+ * return: error code
  *
- *     First, allocate heaps for WFG table from local memory.
- *     Check whether deadlock(s) have been occurred or not.
+ *   search(in/out):
+ *   to_tran_index(in): waited transaction index
+ *   holder_flag(in): true(if to_tran_index is Holder), false(otherwise)
+ */
+static int
+lock_DL_add_edge (LK_DL_SEARCH * search, int to_tran_index, int holder_flag)
+{
+  int *edge_to, *edge_holder;
+  int max_edges;
+
+  if (search->num_edges == search->max_edges)
+    {
+      max_edges = search->max_edges * 2;
+      edge_to = (int *) realloc (search->edge_to, sizeof (int) * max_edges);
+      if (edge_to == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY,
+		  1, sizeof (int) * max_edges);
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+      search->edge_to = edge_to;
+
+      edge_holder = (int *) realloc (search->edge_holder,
+				     sizeof (int) * max_edges);
+      if (edge_holder == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY,
+		  1, sizeof (int) * max_edges);
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+      search->edge_holder = edge_holder;
+      search->max_edges = max_edges;
+    }
+
+  search->edge_to[search->num_edges] = to_tran_index;
+  search->edge_holder[search->num_edges] = holder_flag;
+  search->num_edges++;
+
+  return NO_ERROR;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_DL_push - Push a lock waiter into the search stack
  *
- *     Deadlock detection is peformed via exhaustive loop construction
- *     which indicates the wait-for-relationship.
- *     If deadlock is detected,
- *     the first transaction which enables a cycle
- *     when scanning from the first of object lock table to the last of it.
+ * return: error code
  *
- *     The deadlock of victims are waken up and aborted by themselves.
+ *   search(in/out):
+ *   tran_index(in): lock waiter
+ *   holder_flag(in): the edge to the lock waiter is to a lock holder
  *
- *     Last, free WFG framework.
+ * Note:The outgoing edges of the lock waiter are read from the resource
+ *     which the lock waiter waits for. The same wait-for relationship as
+ *     in lock_detect_local_deadlock() is used.
  */
-void
-lock_detect_local_deadlock (THREAD_ENTRY * thread_p)
+static int
+lock_DL_push (LK_DL_SEARCH * search, int tran_index, int holder_flag)
 {
-#if !defined (SERVER_MODE)
-  return;
-#else /* !SERVER_MODE */
-  int k, s, t;
-  LK_RES_BLOCK *res_block;
   LK_RES *res_ptr;
-  LK_ENTRY *hi, *hj;
-  LK_WFG_NODE *TWFG_node;
-  LK_WFG_EDGE *TWFG_edge;
-  int i, rv;
+  LK_ENTRY *entry_ptr, *i;
+  bool in_holder, before;
+  LOCK mode;
   int compat1, compat2;
+  int error = NO_ERROR;
+  int rv;
 
-  /* initialize deadlock detection related structures */
+  search->mark[tran_index] = 1;
+  search->holder_flag[tran_index] = holder_flag;
+  search->stack_pos[tran_index] = search->top;
+  search->stack[search->top++] = tran_index;
 
-  /* initialize transaction WFG node table..
-   * The current transaction might be old deadlock victim.
-   * And, the transaction may have not been aborted, until now.
-   * Even if the transaction(old deadlock victim) has not been aborted,
-   * set checked_by_deadlock_detector of the transaction to true.
-   */
-  for (i = 1; i < lk_Gl.num_trans; i++)
-    {
-      lk_Gl.TWFG_node[i].first_edge = -1;
-      lk_Gl.TWFG_node[i].tran_edge_seq_num = 0;
-      lk_Gl.TWFG_node[i].checked_by_deadlock_detector = true;
-    }
+  search->first_edge[tran_index] = search->num_edges;
+  search->current[tran_index] = search->num_edges;
+  search->last_edge[tran_index] = search->num_edges;
+  search->wait_msec[tran_index] = lk_Gl.TWFG_node[tran_index].wait_msec;
 
-  /* initialize transaction WFG edge table */
-  lk_Gl.TWFG_edge = &TWFG_edge_block[0];
-  lk_Gl.max_TWFG_edge = LK_MIN_TWFG_EDGE_COUNT;	/* initial value */
-  for (i = 0; i < LK_MIN_TWFG_EDGE_COUNT; i++)
+  res_ptr = lk_Gl.TWFG_node[tran_index].wait_res;
+  if (res_ptr == (LK_RES *) NULL)
     {
-      lk_Gl.TWFG_edge[i].to_tran_index = -1;
-      lk_Gl.TWFG_edge[i].next = (i + 1);
+      return NO_ERROR;
     }
-  lk_Gl.TWFG_edge[lk_Gl.max_TWFG_edge - 1].next = -1;
-  lk_Gl.TWFG_free_edge_idx = 0;
-
-  /* initialize global_edge_seq_num */
-  lk_Gl.global_edge_seq_num = 0;
 
-  /* initialize victim count */
-  victim_count = 0;		/* used as index of victims array */
+  MUTEX_LOCK (rv, res_ptr->res_mutex);
 
-  /* hold the deadlock detection mutex */
-  MUTEX_LOCK (rv, lk_Gl.DL_detection_mutex);
+  /* find the blocked lock entry of the transaction */
+  in_holder = true;
+  for (entry_ptr = res_ptr->holder; entry_ptr != NULL;
+       entry_ptr = entry_ptr->next)
+    {
+      if (entry_ptr->tran_index == tran_index
+	  && entry_ptr->blocked_mode != NULL_LOCK)
+	{
+	  break;
+	}
+    }
+  if (entry_ptr == (LK_ENTRY *) NULL)
+    {
+      in_holder = false;
+      for (entry_ptr = res_ptr->waiter; entry_ptr != NULL;
+	   entry_ptr = entry_ptr->next)
+	{
+	  if (entry_ptr->tran_index == tran_index)
+	    {
+	      break;
+	    }
+	}
+    }
+  if (entry_ptr == (LK_ENTRY *) NULL)
+    {
+      /* not waiting any more */
+      MUTEX_UNLOCK (res_ptr->res_mutex);
+      return NO_ERROR;
+    }
 
-  /* lock-wait edge construction for object lock resource table */
-  MUTEX_LOCK (rv, lk_Gl.obj_res_block_list_mutex);
+  mode = entry_ptr->blocked_mode;
+  assert (mode >= NULL_LOCK);
 
-  for (res_block = lk_Gl.obj_res_block_list;
-       res_block != NULL; res_block = res_block->next_block)
+  if (in_holder == true)
     {
-      for (k = 0; k < res_block->count; k++)
+      /* a blocked holder waits for the holders behind it in their granted
+       * modes and for the blocked holders ahead of it in both modes.
+       */
+      before = true;
+      for (i = res_ptr->holder; i != NULL && error == NO_ERROR; i = i->next)
 	{
-	  /* If the holder list is empty, then the waiter list is also empty.
-	   * Therefore, res_block->block[k].waiter == NULL cannot be checked.
-	   */
-	  if (res_block->block[k].holder == (LK_ENTRY *) NULL)
+	  if (i == entry_ptr)
 	    {
-	      if (res_block->block[k].waiter == (LK_ENTRY *) NULL)
-		{
-		  continue;
-		}
+	      before = false;
+	      continue;
 	    }
+	  assert (i->granted_mode >= NULL_LOCK
+		  && i->blocked_mode >= NULL_LOCK);
 
-	  res_ptr = &res_block->block[k];
-
-	  /* hold resource mutex */
-	  MUTEX_LOCK (rv, res_ptr->res_mutex);
+	  compat1 = lock_Comp[mode][i->granted_mode];
+	  compat2 = (before) ? lock_Comp[mode][i->blocked_mode] : true;
+	  assert (compat1 != DB_NA && compat2 != DB_NA);
 
-	  if (res_ptr->holder == NULL)
+	  if (compat1 == false || compat2 == false)
 	    {
-	      if (res_ptr->waiter == NULL)
-		{
-		  MUTEX_UNLOCK (res_ptr->res_mutex);
-		  continue;
-		}
-	      else
-		{
-#if defined(CUBRID_DEBUG)
-		  FILE *lk_fp;
-		  time_t cur_time;
+	      error = lock_DL_add_edge (search, i->tran_index, true);
+	    }
+	}
+    }
+  else
+    {
+      /* a waiter waits for the holders and the waiters ahead of it */
+      for (i = res_ptr->holder; i != NULL && error == NO_ERROR; i = i->next)
+	{
+	  assert (i->granted_mode >= NULL_LOCK
+		  && i->blocked_mode >= NULL_LOCK);
 
-		  lk_fp = fopen ("lock_waiter_only_info.log", "a")
-		    if (lk_fp != NULL)
-		    {
-		      cur_time = time (NULL);
-		      fprintf (lk_fp,
-			       "##########################################\n");
-		      fprintf (lk_fp, "# current time: %s\n",
-			       ctime (&cur_time));
-		      lock_dump_resource (lk_fp, res_ptr);
-		      fprintf (lk_fp,
-			       "##########################################\n");
-		      fclose (lk_fp);
-		    }
-#endif /* CUBRID_DEBUG */
-		  er_set (ER_WARNING_SEVERITY, ARG_FILE_LINE,
-			  ER_LK_LOCK_WAITER_ONLY, 1,
-			  "lock_waiter_only_info.log");
+	  compat1 = lock_Comp[mode][i->granted_mode];
+	  compat2 = lock_Comp[mode][i->blocked_mode];
+	  assert (compat1 != DB_NA && compat2 != DB_NA);
 
-		  if (res_ptr->total_holders_mode != NULL_LOCK)
-		    {
-		      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE,
-			      ER_LK_TOTAL_HOLDERS_MODE, 1,
-			      res_ptr->total_holders_mode);
-		      res_ptr->total_holders_mode = NULL_LOCK;
-		    }
-		  (void) lock_grant_blocked_waiter (thread_p, res_ptr);
-		}
+	  if (compat1 == false || compat2 == false)
+	    {
+	      error = lock_DL_add_edge (search, i->tran_index, true);
 	    }
+	}
+      for (i = res_ptr->waiter; i != entry_ptr && error == NO_ERROR;
+	   i = i->next)
+	{
+	  assert (i->blocked_mode >= NULL_LOCK);
 
-	  /* among holders */
-	  for (hi = res_ptr->holder; hi != NULL; hi = hi->next)
+	  compat1 = lock_Comp[mode][i->blocked_mode];
+	  assert (compat1 != DB_NA);
+
+	  if (compat1 == false)
 	    {
-	      if (hi->blocked_mode == NULL_LOCK)
-		{
-		  break;
-		}
-	      for (hj = hi->next; hj != NULL; hj = hj->next)
-		{
-		  assert (hi->granted_mode >= NULL_LOCK
-			  && hi->blocked_mode >= NULL_LOCK);
-		  assert (hj->granted_mode >= NULL_LOCK
-			  && hj->blocked_mode >= NULL_LOCK);
+	      error = lock_DL_add_edge (search, i->tran_index, false);
+	    }
+	}
+    }
 
-		  compat1 = lock_Comp[hj->blocked_mode][hi->granted_mode];
-		  compat2 = lock_Comp[hj->blocked_mode][hi->blocked_mode];
-		  assert (compat1 != DB_NA && compat2 != DB_NA);
+  MUTEX_UNLOCK (res_ptr->res_mutex);
 
-		  if (compat1 == false || compat2 == false)
-		    {
-		      (void) lock_add_WFG_edge (hj->tran_index,
-						hi->tran_index, true,
-						(time_t) (hj->thrd_entry->
-							  lockwait_stime /
-							  1000));
-		    }
+  search->last_edge[tran_index] = search->num_edges;
 
-		  compat1 = lock_Comp[hi->blocked_mode][hj->granted_mode];
-		  assert (compat1 != DB_NA);
+  return error;
+}
+#endif /* SERVER_MODE */
 
-		  if (compat1 == false)
-		    {
-		      (void) lock_add_WFG_edge (hi->tran_index,
-						hj->tran_index, true,
-						(time_t) (hi->thrd_entry->
-							  lockwait_stime /
-							  1000));
-		    }
-		}
-	    }
+#if defined(SERVER_MODE)
+/*
+ * lock_DL_select_victim - Select a victim of the cycle in the search stack
+ *
+ * return: true if a victim has been selected
+ *
+ *   search(in):
+ *   s(in): transaction on the top of the search stack
+ *   t(in): transaction in the search stack waited by s
+ *   holder_flag(in): the edge from s to t is to a lock holder
+ *
+ * Note:The edges of the cycle have been read at different times. So the
+ *     cycle is a deadlock only if every transaction in it has been waiting
+ *     since its edges were read. The victim is selected in the same way as
+ *     lock_select_deadlock_victim() does.
+ */
+static bool
+lock_DL_select_victim (THREAD_ENTRY * thread_p, LK_DL_SEARCH * search,
+		       int s, int t, int holder_flag)
+{
+  LK_WFG_NODE *TWFG_node;
+  TRANID tranid;
+  int can_timeout;
+  int k, v;
+  double closed_msec;
+  struct timeval tv;
 
-	  /* from waiters in the waiter to holders */
-	  for (hi = res_ptr->holder; hi != NULL; hi = hi->next)
-	    {
-	      for (hj = res_ptr->waiter; hj != NULL; hj = hj->next)
-		{
-		  assert (hi->granted_mode >= NULL_LOCK
-			  && hi->blocked_mode >= NULL_LOCK);
-		  assert (hj->granted_mode >= NULL_LOCK
-			  && hj->blocked_mode >= NULL_LOCK);
+  TWFG_node = lk_Gl.TWFG_node;
 
-		  compat1 = lock_Comp[hj->blocked_mode][hi->granted_mode];
-		  compat2 = lock_Comp[hj->blocked_mode][hi->blocked_mode];
-		  assert (compat1 != DB_NA && compat2 != DB_NA);
+  /* check if current deadlock cycle is false deadlock cycle */
+  closed_msec = 0;
+  for (k = search->stack_pos[t]; k < search->top; k++)
+    {
+      v = search->stack[k];
+      if (TWFG_node[v].wait_res == NULL
+	  || TWFG_node[v].wait_msec != search->wait_msec[v])
+	{
+	  return false;
+	}
+      if (closed_msec < search->wait_msec[v])
+	{
+	  closed_msec = search->wait_msec[v];
+	}
+    }
 
-		  if (compat1 == false || compat2 == false)
-		    {
-		      (void) lock_add_WFG_edge (hj->tran_index,
-						hi->tran_index, true,
-						(time_t) (hj->thrd_entry->
-							  lockwait_stime /
-							  1000));
-		    }
-		}
-	    }
+  /*
+     Victim Selection Strategy
+     1) Must be lock holder.
+     2) Must be active transaction.
+     3) Prefer a transaction with a closer timeout.
+     4) Prefer the youngest transaction.
+   */
+  victims[victim_count].tran_index = NULL_TRAN_INDEX;
+  for (k = search->stack_pos[t]; k < search->top; k++)
+    {
+      v = search->stack[k];
+      if ((v == t ? holder_flag : search->holder_flag[v]) == false)
+	{
+	  continue;
+	}
 
-	  /* from waiters in the waiter to other waiters in the waiter */
-	  for (hi = res_ptr->waiter; hi != NULL; hi = hi->next)
-	    {
-	      for (hj = hi->next; hj != NULL; hj = hj->next)
-		{
-		  assert (hj->blocked_mode >= NULL_LOCK
-			  && hi->blocked_mode >= NULL_LOCK);
+      tranid = logtb_find_tranid (v);
+      if (logtb_is_active (thread_p, tranid) == false)
+	{
+	  continue;
+	}
 
-		  compat1 = lock_Comp[hj->blocked_mode][hi->blocked_mode];
-		  assert (compat1 != DB_NA);
+      can_timeout = LK_CAN_TIMEOUT (logtb_find_wait_secs (v));
+      if (victims[victim_count].tran_index == NULL_TRAN_INDEX
+	  || (victims[victim_count].can_timeout == false
+	      && can_timeout == true)
+	  || (victims[victim_count].can_timeout == can_timeout
+	      && LK_ISYOUNGER (tranid, victims[victim_count].tranid)))
+	{
+	  victims[victim_count].tran_index = v;
+	  victims[victim_count].tranid = tranid;
+	  victims[victim_count].can_timeout = can_timeout;
+	}
+    }
 
-		  if (compat1 == false)
-		    {
-		      (void) lock_add_WFG_edge (hj->tran_index,
-						hi->tran_index, false,
-						(time_t) (hj->thrd_entry->
-							  lockwait_stime /
-							  1000));
-		    }
-		}
-	    }
+  if (victims[victim_count].tran_index == NULL_TRAN_INDEX)
+    {
+      return false;
+    }
+  victim_count++;
 
-	  /* release resource mutex */
-	  MUTEX_UNLOCK (res_ptr->res_mutex);
-	}
+  /* the cycle was closed when the last transaction in it started to wait */
+  gettimeofday (&tv, NULL);
+  lock_DL_record_detect_time (thread_p,
+			      ((double) tv.tv_sec * 1000000 + tv.tv_usec)
+			      / 1000 - closed_msec);
+
+  return true;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_DL_record_detect_time - Record the time to detect a deadlock
+ *
+ * return: nothing
+ *
+ *   elapsed_msec(in): time from the closing of the cycle to its detection
+ */
+static void
+lock_DL_record_detect_time (THREAD_ENTRY * thread_p, double elapsed_msec)
+{
+  if (elapsed_msec < 1)
+    {
+      mnt_lk_dl_detect_1ms (thread_p);
+    }
+  else if (elapsed_msec < 10)
+    {
+      mnt_lk_dl_detect_10ms (thread_p);
+    }
+  else if (elapsed_msec < 100)
+    {
+      mnt_lk_dl_detect_100ms (thread_p);
+    }
+  else if (elapsed_msec < 1000)
+    {
+      mnt_lk_dl_detect_1s (thread_p);
+    }
+  else
+    {
+      mnt_lk_dl_detect_over_1s (thread_p);
     }
+}
+#endif /* SERVER_MODE */
 
-  MUTEX_UNLOCK (lk_Gl.obj_res_block_list_mutex);
+/*
+ * lock_has_new_lock_waiters - Check if there are lock waiters not yet
+ *                             checked by the deadlock detector
+ *
+ * return: true or false
+ */
+bool
+lock_has_new_lock_waiters (void)
+{
+#if !defined (SERVER_MODE)
+  return false;
+#else /* !SERVER_MODE */
+  return (lk_Gl.DL_num_new_waiters > 0);
+#endif /* !SERVER_MODE */
+}
 
-  /* release DL detection mutex */
-  MUTEX_UNLOCK (lk_Gl.DL_detection_mutex);
+/*
+ * lock_detect_new_waiter_deadlock - Run the deadlock detection for new lock
+ *                                   waiters
+ *
+ * return: nothing
+ *
+ * Note:The wait-for graph is kept incrementally: lock_suspend() records the
+ *     resource which a transaction waits for and queues the transaction,
+ *     and the record is removed when the transaction is resumed. The
+ *     outgoing edges of a lock waiter are derived from that resource.
+ *
+ *     A new deadlock cycle contains a new lock waiter, so the depth first
+ *     search runs only from the queued lock waiters and visits only the
+ *     part of the graph reachable from them. When a cycle is found, a
+ *     victim is selected and the search is done again without it. The
+ *     victims are handled as lock_detect_local_deadlock() does.
+ *
+ *     Cycles made by lock grants rather than by new lock waits are left
+ *     to the periodic lock_detect_local_deadlock().
+ */
+void
+lock_detect_new_waiter_deadlock (THREAD_ENTRY * thread_p)
+{
+#if !defined (SERVER_MODE)
+  return;
+#else /* !SERVER_MODE */
+  LK_DL_SEARCH search;
+  int *new_waiters, *area;
+  int num_new_waiters;
+  int num_trans;
+  int k, n, r, s, t, holder_flag;
+  bool found;
+  int rv;
 
-  /* simple notation for using in the following statements */
-  TWFG_node = lk_Gl.TWFG_node;
-  TWFG_edge = lk_Gl.TWFG_edge;
+  if (lk_Gl.DL_num_new_waiters == 0)
+    {
+      return;
+    }
 
-  /*
-   * deadlock detection and victim selection
-   */
+  num_trans = lk_Gl.num_trans;
+  area = (int *) malloc (sizeof (int) * num_trans * 8);
+  search.wait_msec = (double *) malloc (sizeof (double) * num_trans);
+  search.max_edges = num_trans * 2;
+  search.edge_to = (int *) malloc (sizeof (int) * search.max_edges);
+  search.edge_holder = (int *) malloc (sizeof (int) * search.max_edges);
+  if (area == NULL || search.wait_msec == NULL || search.edge_to == NULL
+      || search.edge_holder == NULL)
+    {
+      /* the periodic deadlock detection will find them */
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY,
+	      1, sizeof (int) * num_trans * 8);
+      goto end;
+    }
 
-  for (k = 1; k < lk_Gl.num_trans; k++)
+  search.mark = area;
+  search.stack_pos = area + num_trans;
+  search.first_edge = area + num_trans * 2;
+  search.last_edge = area + num_trans * 3;
+  search.current = area + num_trans * 4;
+  search.holder_flag = area + num_trans * 5;
+  search.stack = area + num_trans * 6;
+  new_waiters = area + num_trans * 7;
+  memset (search.mark, 0, sizeof (int) * num_trans);
+  search.top = 0;
+  search.num_edges = 0;
+
+  /* take the queued lock waiters */
+  MUTEX_LOCK (rv, lk_Gl.DL_new_waiter_mutex);
+  num_new_waiters = lk_Gl.DL_num_new_waiters;
+  for (k = 0; k < num_new_waiters; k++)
     {
-      TWFG_node[k].current = TWFG_node[k].first_edge;
-      TWFG_node[k].ancestor = -1;
+      new_waiters[k] = lk_Gl.DL_new_waiters[k];
+      lk_Gl.TWFG_node[new_waiters[k]].DL_new_waiter = false;
     }
-  for (k = 1; k < lk_Gl.num_trans; k++)
+  lk_Gl.DL_num_new_waiters = 0;
+  MUTEX_UNLOCK (lk_Gl.DL_new_waiter_mutex);
+
+  /* initialize victim count */
+  victim_count = 0;		/* used as index of victims array */
+
+  /* hold the deadlock detection mutex */
+  MUTEX_LOCK (rv, lk_Gl.DL_detection_mutex);
+
+  for (n = 0; n < num_new_waiters && victim_count < LK_MAX_VICTIM_COUNT;
+       n++)
     {
-      if (TWFG_node[k].current == -1)
+      r = new_waiters[n];
+
+    search_again:
+      if (search.mark[r] != 0 || lk_Gl.TWFG_node[r].wait_res == NULL
+	  || lk_Gl.TWFG_node[r].DL_victim == true)
 	{
 	  continue;
 	}
-      s = k;
-      TWFG_node[s].ancestor = -2;
-      for (; s != -2;)
+
+      if (lock_DL_push (&search, r, false) != NO_ERROR)
 	{
-	  if (TWFG_node[s].checked_by_deadlock_detector == false
-	      || TWFG_node[s].thrd_wait_stime == 0
-	      || (TWFG_node[s].current != -1
-		  && (TWFG_node[s].thrd_wait_stime >
-		      TWFG_edge[TWFG_node[s].current].edge_wait_stime)))
-	    {
-	      /* A new transaction started */
-	      TWFG_node[s].first_edge = -1;
-	      TWFG_node[s].current = -1;
-	    }
+	  break;
+	}
 
-	  if (TWFG_node[s].current == -1)
+      while (search.top > 0)
+	{
+	  s = search.stack[search.top - 1];
+	  if (search.current[s] == search.last_edge[s])
 	    {
-	      t = TWFG_node[s].ancestor;
-	      TWFG_node[s].ancestor = -1;
-	      s = t;
-	      if (s != -2)
-		{
-		  TWFG_node[s].current = TWFG_edge[TWFG_node[s].current].next;
-		}
+	      /* no cycle through s */
+	      search.mark[s] = 2;
+	      search.top--;
 	      continue;
 	    }
 
-	  t = TWFG_edge[TWFG_node[s].current].to_tran_index;
-
-	  if (t == -2)
-	    {			/* old WFG edge */
-	      TWFG_node[s].current = TWFG_edge[TWFG_node[s].current].next;
-	      continue;
-	    }
+	  t = search.edge_to[search.current[s]];
+	  holder_flag = search.edge_holder[search.current[s]];
+	  search.current[s]++;
 
-	  if (TWFG_node[t].current == -1)
+	  if (search.mark[t] == 2 || lk_Gl.TWFG_node[t].DL_victim == true)
 	    {
-	      TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
-	      TWFG_node[s].current = TWFG_edge[TWFG_node[s].current].next;
 	      continue;
 	    }
 
-	  if (TWFG_node[t].checked_by_deadlock_detector == false
-	      || TWFG_node[t].thrd_wait_stime == 0
-	      || TWFG_node[t].thrd_wait_stime >
-	      TWFG_edge[TWFG_node[t].current].edge_wait_stime)
+	  if (search.mark[t] == 1)
 	    {
-	      TWFG_node[t].first_edge = -1;
-	      TWFG_node[t].current = -1;
-	      TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
-	      TWFG_node[s].current = TWFG_edge[TWFG_node[s].current].next;
-	      continue;
-	    }
+	      /* A deadlock cycle is found */
+	      found = lock_DL_select_victim (thread_p, &search, s, t,
+					     holder_flag);
 
-	  if (TWFG_edge[TWFG_node[s].current].edge_seq_num <
-	      TWFG_node[t].tran_edge_seq_num)
-	    {			/* old WFG edge */
-	      TWFG_edge[TWFG_node[s].current].to_tran_index = -2;
-	      TWFG_node[s].current = TWFG_edge[TWFG_node[s].current].next;
-	      continue;
+	      /* search again from the lock waiter without the victim,
+	       * or give it up for a false cycle
+	       */
+	      while (search.top > 0)
+		{
+		  search.top--;
+		  search.mark[search.stack[search.top]] = (found) ? 0 : 2;
+		}
+	      if (found == true)
+		{
+		  search.mark[victims[victim_count - 1].tran_index] = 2;
+		  if (victim_count < LK_MAX_VICTIM_COUNT)
+		    {
+		      goto search_again;
+		    }
+		}
+	      break;
 	    }
 
-	  if (TWFG_node[t].ancestor != -1)
+	  if (lk_Gl.TWFG_node[t].wait_res == NULL)
 	    {
-	      /* A deadlock cycle is found */
-	      lock_select_deadlock_victim (thread_p, s, t);
-	      if (victim_count >= LK_MAX_VICTIM_COUNT)
-		{
-		  goto final;
-		}
+	      /* not a lock waiter */
+	      search.mark[t] = 2;
+	      continue;
 	    }
-	  else
+
+	  if (lock_DL_push (&search, t, holder_flag) != NO_ERROR)
 	    {
-	      TWFG_node[t].ancestor = s;
-	      TWFG_node[t].candidate =
-		TWFG_edge[TWFG_node[s].current].holder_flag;
+	      search.top = 0;
+	      n = num_new_waiters;
+	      break;
 	    }
-	  s = t;
 	}
     }
 
-final:
-
-#if defined(SERVER_MODE) && defined(DIAG_DEVEL)
-  if (victim_count > 0)
-    {
-      SET_DIAG_VALUE (diag_executediag, DIAG_OBJ_TYPE_LOCK_DEADLOCK, 1,
-		      DIAG_VAL_SETTYPE_INC, NULL);
-#if 0				/* ACTIVITY PROFILE */
-      ADD_ACTIVITY_DATA (diag_executediag,
-			 DIAG_EVENTCLASS_TYPE_SERVER_LOCK_DEADLOCK, "", "",
-			 victim_count);
-#endif
-    }
-#endif /* SERVER_MODE && DIAG_DEVEL */
+  /* release DL detection mutex */
+  MUTEX_UNLOCK (lk_Gl.DL_detection_mutex);
 
   /* dump deadlock victims according to dump level */
   if (victim_count > 0 && lk_Gl.dump_level_when_deadlock)
@@ -10092,10 +11576,7 @@ final:
       lock_dump_deadlock_victims (thread_p);
     }
 
-
-  /* Now solve the deadlocks (cycles) by executing the cycle resolution
-   * function (e.g., aborting victim)
-   */
+  /* solve the deadlocks by waking up the victims */
   for (k = 0; k < victim_count; k++)
     {
       if (victims[k].can_timeout)
@@ -10108,62 +11589,23 @@ final:
 	}
     }
 
-  /* deallocate memory space used for deadlock detection */
-  if (lk_Gl.max_TWFG_edge > LK_MID_TWFG_EDGE_COUNT)
+end:
+  if (area != NULL)
     {
-      free_and_init (lk_Gl.TWFG_edge);
+      free_and_init (area);
     }
-
-  if (victim_count == 0)
+  if (search.wait_msec != NULL)
     {
-      if (lk_Gl.no_victim_case_count < 60)
-	{
-	  lk_Gl.no_victim_case_count += 1;
-	}
-      else
-	{
-	  int worker_threads = 0;
-	  int suspended_threads = 0;
-	  int thrd_index;
-	  THREAD_ENTRY *thrd_ptr;
-
-	  /* Make sure that we have threads available for another client
-	   * to execute, otherwise Panic...
-	   */
-	  thread_get_info_threads (NULL, &worker_threads, NULL,
-				   &suspended_threads);
-	  if (worker_threads == suspended_threads)
-	    {
-	      /* We must timeout at least one thread, so other clients can execute,
-	       * otherwise, the server will hang.
-	       */
-	      thrd_ptr = thread_find_first_lockwait_entry (&thrd_index);
-	      while (thrd_ptr != NULL)
-		{
-		  if (lock_wakeup_deadlock_victim_timeout
-		      (thrd_ptr->tran_index) == true)
-		    {
-		      break;
-		    }
-		  thrd_ptr = thread_find_next_lockwait_entry (&thrd_index);
-		}
-
-	      if (thrd_ptr != NULL)
-		{
-		  er_set (ER_NOTIFICATION_SEVERITY, ARG_FILE_LINE,
-			  ER_LK_NOTENOUGH_ACTIVE_THREADS, 3, worker_threads,
-			  logtb_get_number_assigned_tran_indices (),
-			  thrd_ptr->tran_index);
-		}
-	    }
-	  lk_Gl.no_victim_case_count = 0;
-	}
+      free_and_init (search.wait_msec);
+    }
+  if (search.edge_to != NULL)
+    {
+      free_and_init (search.edge_to);
+    }
+  if (search.edge_holder != NULL)
+    {
+      free_and_init (search.edge_holder);
     }
-
-  /* save the last deadlock run time */
-  lk_Gl.last_deadlock_run = time (NULL);
-
-  return;
 #endif /* !SERVER_MODE */
 }
 
@@ -10713,8 +12155,15 @@ xlock_dump (THREAD_ENTRY * thread_p, FILE * outfp)
 	{
 	  MUTEX_LOCK (rv, res_ptr->res_mutex);
 
+	  /* fast path locks on the class have to be dumped as holders */
+	  if (res_ptr->type == LOCK_RESOURCE_CLASS)
+	    {
+	      lock_fastpath_transfer (res_ptr, NULL_TRAN_INDEX);
+	    }
+
 	  if (res_ptr->holder == NULL && res_ptr->waiter == NULL
-	      && res_ptr->non2pl == NULL)
+	      && res_ptr->non2pl == NULL
+	      && lock_retire_resource_oid (res_ptr) == true)
 	    {
 	      if (res_prev == (LK_RES *) NULL)
 		{
@@ -88,6 +88,7 @@ struct lk_entry
   LK_ACQUISITION_HISTORY *recent;	/* last node of history list        */
   int ngranules;		/* number of finer granules         */
   int mlk_count;		/* number of instant lock requests  */
+  bool fastpath;		/* granted without the lock table   */
   unsigned char scanid_bitset[1];	/* PRM_LK_MAX_SCANID_BIT/8];       */
 #else				/* not SERVER_MODE */
   int dummy;
@@ -172,6 +173,8 @@ lock_notify_isolation_incons (THREAD_ENTRY * thread_p,
 			      void *args);
 extern bool lock_check_local_deadlock_detection (void);
 extern void lock_detect_local_deadlock (THREAD_ENTRY * thread_p);
+extern bool lock_has_new_lock_waiters (void);
+extern void lock_detect_new_waiter_deadlock (THREAD_ENTRY * thread_p);
 extern int lock_reacquire_crash_locks (THREAD_ENTRY * thread_p,
 				       LK_ACQUIRED_LOCKS * acqlocks,
 				       int tran_index);
@@ -45,7 +45,7 @@ LOG_GLOBAL log_Gl = {
   {0, 0, 0, 0, 0, 0, 0, NULL, NULL},
   /* append */
   {NULL_VOLDES, {NULL_PAGEID, NULL_OFFSET},
-   {NULL_PAGEID, NULL_OFFSET}, NULL, NULL},
+   {NULL_PAGEID, NULL_OFFSET}, NULL, NULL, 0},
   /* hdr */
   {{'0'}, 0, 0, {'0'}, 0.0, 0, 0, 0, 0, 0, 0, 0, 0,
    {NULL_PAGEID, NULL_OFFSET},
@@ -98,7 +98,7 @@ LOG_GLOBAL log_Gl = {
    },
 
   /* group_commit_info */
-  {0, MUTEX_INITIALIZER, COND_INITIALIZER},
+  {0, MUTEX_INITIALIZER, {NULL_PAGEID, NULL_OFFSET}, NULL},
 
   /* log writer info */
   {NULL, MUTEX_INITIALIZER,
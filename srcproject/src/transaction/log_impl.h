@@ -470,13 +470,25 @@ struct log_flush_info
 #endif				/* SERVER_MODE */
 };
 
+typedef struct log_group_commit_waiter LOG_GROUP_COMMIT_WAITER;
+struct log_group_commit_waiter
+{
+  LOG_LSA commit_lsa;		/* Wait until the log is durable up to here */
+  bool is_durable;		/* Set by the flusher before waking up      */
+  COND_T cond;
+  LOG_GROUP_COMMIT_WAITER *next;
+};
+
 typedef struct log_group_commit_info LOG_GROUP_COMMIT_INFO;
 struct log_group_commit_info
 {
   /* group commit waiters count */
   int waiters;
   MUTEX_T gc_mutex;
-  COND_T gc_cond;
+  LOG_LSA durable_lsa;		/* The log is flushed and synchronized up
+				 * to this address
+				 */
+  LOG_GROUP_COMMIT_WAITER *waiter_list;	/* Ordered by commit_lsa */
 };
 
 typedef enum logwr_mode LOGWR_MODE;
@@ -528,7 +540,16 @@ struct log_append_info
   LOG_LSA prev_lsa;		/* Address of last append log record          */
   LOG_PAGE *log_pgptr;		/* The log page which is fixed                */
   LOG_PAGE *delayed_free_log_pgptr;	/* Delay freeing a log append page       */
+  volatile int num_copying;	/* Number of reserved record bodies that are
+				 * still being copied outside of LOG_CS
+				 */
+};
 
+typedef struct log_append_reservation LOG_APPEND_RESERVATION;
+struct log_append_reservation
+{
+  char *ptr;			/* Where the next reserved byte is copied     */
+  int length;			/* Reserved bytes not copied yet              */
 };
 
 typedef enum log_2pc_execute LOG_2PC_EXECUTE;
@@ -1501,6 +1522,7 @@ extern int logpb_flush_all_append_pages_helper (THREAD_ENTRY * thread_p);
 extern void logpb_flush_all_append_pages (THREAD_ENTRY * thread_p,
 					  LOG_FLUSH_TYPE flush_type);
 extern void logpb_invalid_all_append_pages (THREAD_ENTRY * thread_p);
+extern void logpb_wakeup_commit_waiters (const LOG_LSA * flushed_lsa);
 extern void logpb_flush_log_for_wal (THREAD_ENTRY * thread_p,
 				     const LOG_LSA * lsa_ptr);
 extern void logpb_force (THREAD_ENTRY * thread_p);
@@ -1511,6 +1533,14 @@ extern void logpb_append_data (THREAD_ENTRY * thread_p, int length,
 extern void logpb_append_crumbs (THREAD_ENTRY * thread_p, int num_crumbs,
 				 const LOG_CRUMB * crumbs);
 extern void logpb_end_append (THREAD_ENTRY * thread_p);
+extern bool logpb_reserve_append_data (THREAD_ENTRY * thread_p, int length,
+				       LOG_APPEND_RESERVATION * reserve);
+extern void logpb_copy_reserved_data (LOG_APPEND_RESERVATION * reserve,
+				      int length, const char *data);
+extern void logpb_copy_reserved_crumbs (LOG_APPEND_RESERVATION * reserve,
+					int num_crumbs,
+					const LOG_CRUMB * crumbs);
+extern void logpb_end_reserved_append (LOG_APPEND_RESERVATION * reserve);
 #if defined (ENABLE_UNUSED_FUNCTION)
 extern void logpb_remove_append (LOG_TDES * tdes);
 #endif
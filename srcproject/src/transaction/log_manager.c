@@ -2556,6 +2556,10 @@ log_append_undoredo_crumbs (THREAD_ENTRY * thread_p, LOG_RCVINDEX rcvindex,
 
   int undo_length = 0;
   int redo_length = 0;
+  int undo_copy_length;
+  int redo_copy_length;
+  LOG_APPEND_RESERVATION reserve;
+  bool is_reserved = false;
   int error_code = NO_ERROR;
 
   LOG_ZIP *zip_undo, *zip_redo;
@@ -2755,26 +2759,46 @@ log_append_undoredo_crumbs (THREAD_ENTRY * thread_p, LOG_RCVINDEX rcvindex,
 
   LOG_APPEND_SETDIRTY_ADD_ALIGN (thread_p, sizeof (*undoredo));
 
-  /* INSERT data */
-
-  if (is_undo_zip)
-    {
-      logpb_append_data (thread_p, (int) zip_undo->data_length,
-			 (char *) zip_undo->log_data);
-    }
-  else
+  /*
+   * When the data fits in the current append page, only reserve the room
+   * for it here and copy it after LOG_CS is released.
+   */
+  undo_copy_length = (is_undo_zip
+		      ? (int) zip_undo->data_length : undo_length);
+  redo_copy_length = (is_redo_zip
+		      ? (int) zip_redo->data_length : redo_length);
+  if (undo_copy_length + redo_copy_length > 0)
     {
-      logpb_append_crumbs (thread_p, num_undo_crumbs, undo_crumbs);
+      is_reserved =
+	logpb_reserve_append_data (thread_p,
+				   DB_ALIGN (undo_copy_length,
+					     DOUBLE_ALIGNMENT)
+				   + redo_copy_length, &reserve);
     }
 
-  if (is_redo_zip)
-    {
-      logpb_append_data (thread_p, (int) zip_redo->data_length,
-			 (char *) zip_redo->log_data);
-    }
-  else
+  /* INSERT data */
+
+  if (!is_reserved)
     {
-      logpb_append_crumbs (thread_p, num_redo_crumbs, redo_crumbs);
+      if (is_undo_zip)
+	{
+	  logpb_append_data (thread_p, (int) zip_undo->data_length,
+			     (char *) zip_undo->log_data);
+	}
+      else
+	{
+	  logpb_append_crumbs (thread_p, num_undo_crumbs, undo_crumbs);
+	}
+
+      if (is_redo_zip)
+	{
+	  logpb_append_data (thread_p, (int) zip_redo->data_length,
+			     (char *) zip_redo->log_data);
+	}
+      else
+	{
+	  logpb_append_crumbs (thread_p, num_redo_crumbs, redo_crumbs);
+	}
     }
 
   /* END append */
@@ -2794,6 +2818,33 @@ log_append_undoredo_crumbs (THREAD_ENTRY * thread_p, LOG_RCVINDEX rcvindex,
     }
 
   LOG_CS_EXIT ();
+
+  if (is_reserved)
+    {
+      if (is_undo_zip)
+	{
+	  logpb_copy_reserved_data (&reserve, (int) zip_undo->data_length,
+				    (char *) zip_undo->log_data);
+	}
+      else
+	{
+	  logpb_copy_reserved_crumbs (&reserve, num_undo_crumbs,
+				      undo_crumbs);
+	}
+
+      if (is_redo_zip)
+	{
+	  logpb_copy_reserved_data (&reserve, (int) zip_redo->data_length,
+				    (char *) zip_redo->log_data);
+	}
+      else
+	{
+	  logpb_copy_reserved_crumbs (&reserve, num_redo_crumbs,
+				      redo_crumbs);
+	}
+
+      logpb_end_reserved_append (&reserve);
+    }
 }
 
 /*
@@ -2824,6 +2875,8 @@ log_append_undo_crumbs (THREAD_ENTRY * thread_p, LOG_RCVINDEX rcvindex,
   int total_length = 0;
   LOG_ZIP *zip_undo;
   char *data_ptr = NULL;
+  LOG_APPEND_RESERVATION reserve;
+  bool is_reserved = false;
 
 #if defined(CUBRID_DEBUG)
   if (RV_fun[rcvindex].undofun == NULL)
@@ -2959,22 +3012,49 @@ log_append_undo_crumbs (THREAD_ENTRY * thread_p, LOG_RCVINDEX rcvindex,
 
   LOG_APPEND_SETDIRTY_ADD_ALIGN (thread_p, sizeof (*undo));
 
-  /* INSERT data */
+  /* INSERT data, or only reserve the room when it fits in the page */
 
-  if (is_zipped)
+  if (total_length > 0)
     {
-      logpb_append_data (thread_p, (int) zip_undo->data_length,
-			 (char *) zip_undo->log_data);
+      is_reserved =
+	logpb_reserve_append_data (thread_p,
+				   (is_zipped
+				    ? (int) zip_undo->data_length
+				    : total_length), &reserve);
     }
-  else
+
+  if (!is_reserved)
     {
-      logpb_append_crumbs (thread_p, num_crumbs, crumbs);
+      if (is_zipped)
+	{
+	  logpb_append_data (thread_p, (int) zip_undo->data_length,
+			     (char *) zip_undo->log_data);
+	}
+      else
+	{
+	  logpb_append_crumbs (thread_p, num_crumbs, crumbs);
+	}
     }
 
   /* END append */
   logpb_end_append (thread_p);
 
   LOG_CS_EXIT ();
+
+  if (is_reserved)
+    {
+      if (is_zipped)
+	{
+	  logpb_copy_reserved_data (&reserve, (int) zip_undo->data_length,
+				    (char *) zip_undo->log_data);
+	}
+      else
+	{
+	  logpb_copy_reserved_crumbs (&reserve, num_crumbs, crumbs);
+	}
+
+      logpb_end_reserved_append (&reserve);
+    }
 }
 
 /*
@@ -3025,6 +3105,8 @@ log_append_redo_crumbs (THREAD_ENTRY * thread_p, LOG_RCVINDEX rcvindex,
   int total_length = 0;
   LOG_ZIP *zip_redo;
   char *data_ptr = NULL;
+  LOG_APPEND_RESERVATION reserve;
+  bool is_reserved = false;
 
 #if defined(CUBRID_DEBUG)
   if (addr->pgptr == NULL)
@@ -3157,16 +3239,28 @@ log_append_redo_crumbs (THREAD_ENTRY * thread_p, LOG_RCVINDEX rcvindex,
 
   LOG_APPEND_SETDIRTY_ADD_ALIGN (thread_p, sizeof (*redo));
 
-  /* INSERT data */
+  /* INSERT data, or only reserve the room when it fits in the page */
 
-  if (is_zipped)
+  if (total_length > 0)
     {
-      logpb_append_data (thread_p, (int) zip_redo->data_length,
-			 (char *) zip_redo->log_data);
+      is_reserved =
+	logpb_reserve_append_data (thread_p,
+				   (is_zipped
+				    ? (int) zip_redo->data_length
+				    : total_length), &reserve);
     }
-  else
+
+  if (!is_reserved)
     {
-      logpb_append_crumbs (thread_p, num_crumbs, crumbs);
+      if (is_zipped)
+	{
+	  logpb_append_data (thread_p, (int) zip_redo->data_length,
+			     (char *) zip_redo->log_data);
+	}
+      else
+	{
+	  logpb_append_crumbs (thread_p, num_crumbs, crumbs);
+	}
     }
 
   /* END append */
@@ -3186,6 +3280,21 @@ log_append_redo_crumbs (THREAD_ENTRY * thread_p, LOG_RCVINDEX rcvindex,
     }
 
   LOG_CS_EXIT ();
+
+  if (is_reserved)
+    {
+      if (is_zipped)
+	{
+	  logpb_copy_reserved_data (&reserve, (int) zip_redo->data_length,
+				    (char *) zip_redo->log_data);
+	}
+      else
+	{
+	  logpb_copy_reserved_crumbs (&reserve, num_crumbs, crumbs);
+	}
+
+      logpb_end_reserved_append (&reserve);
+    }
 }
 
 /*
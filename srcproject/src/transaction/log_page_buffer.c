@@ -248,6 +248,7 @@ static void logpb_initialize_backup_info (void);
 static LOG_PAGE **logpb_writev_append_pages (THREAD_ENTRY * thread_p,
 					     LOG_PAGE ** to_flush,
 					     DKNPAGES npages);
+static void logpb_wait_for_reserved_copies (void);
 static int logpb_get_guess_archive_num (PAGEID pageid);
 static void logpb_set_unavailable_archive (int arv_num);
 static bool logpb_is_archive_available (int arv_num);
@@ -627,8 +628,10 @@ logpb_initialize_pool (THREAD_ENTRY * thread_p)
 
   MUTEX_INIT (log_Gl.chkpt_lsa_lock);
 
-  COND_INIT (group_commit_info->gc_cond);
   MUTEX_INIT (group_commit_info->gc_mutex);
+  group_commit_info->waiters = 0;
+  LSA_SET_NULL (&group_commit_info->durable_lsa);
+  group_commit_info->waiter_list = NULL;
 
   MUTEX_INIT (writer_info->wr_list_mutex);
 
@@ -718,7 +721,6 @@ logpb_finalize_pool (void)
   MUTEX_DESTROY (log_Gl.chkpt_lsa_lock);
 
   MUTEX_DESTROY (log_Gl.group_commit_info.gc_mutex);
-  COND_DESTROY (log_Gl.group_commit_info.gc_cond);
 
   logpb_finalize_writer_info ();
 }
@@ -1813,6 +1815,12 @@ logpb_fetch_page (THREAD_ENTRY * thread_p, PAGEID pageid,
 
   LOG_CS_ENTER_READ_MODE (thread_p);
 
+  if (pageid >= log_Gl.append.nxio_lsa.pageid)
+    {
+      /* the page may still receive a reserved record body */
+      logpb_wait_for_reserved_copies ();
+    }
+
 /*   assert(log_lpb_mutex_not_own()); */
   LOG_MUTEX_LOCK (rv, log_Pb.lpb_mutex);
 
@@ -1953,6 +1961,8 @@ logpb_write_page_to_disk (THREAD_ENTRY * thread_p, LOG_PAGE * log_pgptr,
 
   assert (log_pgptr != NULL);
 
+  logpb_wait_for_reserved_copies ();
+
   phy_pageid = logpb_to_physical_pageid (logical_pageid);
 
   /* log_Gl.append.vdes is only changed
@@ -2531,6 +2541,8 @@ logpb_writev_append_pages (THREAD_ENTRY * thread_p, LOG_PAGE ** to_flush,
 
   if (npages > 0)
     {
+      logpb_wait_for_reserved_copies ();
+
       /* Record number of writes in statistics */
       mnt_log_iowrites (thread_p);
 
@@ -2695,6 +2707,7 @@ logpb_flush_all_append_pages_helper (THREAD_ENTRY * thread_p)
   bool need_flush = true;
   int error_code = NO_ERROR;
   int flush_page_count = 0;
+  struct timeval flush_start_time;
 #if defined(CUBRID_DEBUG)
   struct timeval start_time = {
     0, 0
@@ -2757,6 +2770,15 @@ logpb_flush_all_append_pages_helper (THREAD_ENTRY * thread_p)
       return 0;
     }
 
+  /*
+   * Reserved record bodies are copied without LOG_CS. Since we hold it, no
+   * new reservation can start; let the pending copies land before the
+   * append pages are written and the end of file record is placed.
+   */
+  logpb_wait_for_reserved_copies ();
+
+  gettimeofday (&flush_start_time, NULL);
+
 #if !defined(NDEBUG)
   {
     const char *env_value;
@@ -3241,6 +3263,8 @@ logpb_flush_all_append_pages_helper (THREAD_ENTRY * thread_p)
     }
 #endif /* SERVER_MODE */
 
+  mnt_lat_record (thread_p, MNT_LAT_LOG_FLUSH, 0, &flush_start_time);
+
   return 1;
 
 error:
@@ -3298,6 +3322,9 @@ logpb_flush_all_append_pages (THREAD_ENTRY * thread_p,
   double elapsed;
   LOG_FLUSH_INFO *flush_info = &log_Gl.flush_info;
   LOG_GROUP_COMMIT_INFO *group_commit_info = &log_Gl.group_commit_info;
+  LOG_GROUP_COMMIT_WAITER waiter;
+  LOG_GROUP_COMMIT_WAITER **prev_waiter;
+  LOG_LSA commit_lsa;
 
 direct_flush:
 
@@ -3329,6 +3356,9 @@ direct_flush:
 				     log_Name_active);
 	}
 
+      /* committers waiting for the flusher may be covered by this flush */
+      logpb_wakeup_commit_waiters (&log_Gl.append.nxio_lsa);
+
       return;
     }
 
@@ -3346,6 +3376,9 @@ direct_flush:
 #endif /* CUBRID_DEBUG */
     }
 
+  /* Every log record appended so far has to become durable */
+  LSA_COPY (&commit_lsa, &log_Gl.hdr.append_lsa);
+
   LOG_CS_EXIT ();
 
   MUTEX_LOCK (rv, thread_Log_flush_thread.lock);
@@ -3373,8 +3406,27 @@ direct_flush:
   MUTEX_LOCK (rv, group_commit_info->gc_mutex);
   MUTEX_UNLOCK (thread_Log_flush_thread.lock);
 
-  if (!PRM_LOG_ASYNC_COMMIT || (flush_type == LOG_FLUSH_FORCE))
+  if ((!PRM_LOG_ASYNC_COMMIT || (flush_type == LOG_FLUSH_FORCE))
+      && LSA_LT (&group_commit_info->durable_lsa, &commit_lsa))
     {
+      /*
+       * Queue up in commit_lsa order. The flusher releases only the head of
+       * the list which has become durable; the others wait for the next
+       * flush while new records are being appended.
+       */
+      LSA_COPY (&waiter.commit_lsa, &commit_lsa);
+      waiter.is_durable = false;
+      COND_INIT (waiter.cond);
+
+      prev_waiter = &group_commit_info->waiter_list;
+      while (*prev_waiter != NULL
+	     && LSA_LE (&(*prev_waiter)->commit_lsa, &commit_lsa))
+	{
+	  prev_waiter = &(*prev_waiter)->next;
+	}
+      waiter.next = *prev_waiter;
+      *prev_waiter = &waiter;
+
       ++(group_commit_info->waiters);
 #if defined(CUBRID_DEBUG)
       er_log_debug (ARG_FILE_LINE,
@@ -3388,9 +3440,15 @@ direct_flush:
 	  gettimeofday (&start_time, NULL);
 	}
 
-      ret = COND_WAIT (group_commit_info->gc_cond,
-		       group_commit_info->gc_mutex);
-      assert (ret != TIMEDWAIT_TIMEOUT);
+      while (!waiter.is_durable)
+	{
+	  ret = COND_WAIT (waiter.cond, group_commit_info->gc_mutex);
+	  assert (ret != TIMEDWAIT_TIMEOUT);
+#if defined(WINDOWS)
+	  MUTEX_LOCK (rv, group_commit_info->gc_mutex);
+#endif /* WINDOWS */
+	}
+      COND_DESTROY (waiter.cond);
 
       if (LOG_IS_GROUP_COMMIT_ACTIVE () && (flush_type != LOG_FLUSH_FORCE))
 	{
@@ -3421,6 +3479,56 @@ direct_flush:
 #endif /* SERVER_MODE */
 }
 
+/*
+ * logpb_wakeup_commit_waiters - Wake up the committers whose log records
+ *                               have become durable
+ *
+ * return: nothing
+ *
+ *   flushed_lsa(in): The log is flushed and synchronized up to this address
+ *
+ * NOTE:The waiters are ordered by their commit address, so only the head of
+ *              the list is released. Committers which appended after the
+ *              flush started keep on waiting for the next flush.
+ */
+void
+logpb_wakeup_commit_waiters (const LOG_LSA * flushed_lsa)
+{
+#if defined(SERVER_MODE)
+  int rv;
+  LOG_GROUP_COMMIT_INFO *group_commit_info = &log_Gl.group_commit_info;
+  LOG_GROUP_COMMIT_WAITER *waiter;
+
+  MUTEX_LOCK (rv, group_commit_info->gc_mutex);
+
+  if (LSA_LT (&group_commit_info->durable_lsa, flushed_lsa))
+    {
+      LSA_COPY (&group_commit_info->durable_lsa, flushed_lsa);
+    }
+
+  while ((waiter = group_commit_info->waiter_list) != NULL
+	 && LSA_LE (&waiter->commit_lsa, &group_commit_info->durable_lsa))
+    {
+      group_commit_info->waiter_list = waiter->next;
+      --(group_commit_info->waiters);
+
+      waiter->is_durable = true;
+      COND_SIGNAL (waiter->cond);
+    }
+
+#if defined(CUBRID_DEBUG)
+  er_log_debug (ARG_FILE_LINE,
+		"logpb_wakeup_commit_waiters: "
+		"durable lsa(%d|%d) waiters(%d)\n",
+		group_commit_info->durable_lsa.pageid,
+		group_commit_info->durable_lsa.offset,
+		group_commit_info->waiters);
+#endif /* CUBRID_DEBUG */
+
+  MUTEX_UNLOCK (group_commit_info->gc_mutex);
+#endif /* SERVER_MODE */
+}
+
 /*
  * logpb_invalid_all_append_pages - Invalidate all append pages
  *
@@ -3819,6 +3927,165 @@ logpb_end_append (THREAD_ENTRY * thread_p)
     }
 }
 
+/*
+ * logpb_reserve_append_data - Reserve room for the body of the current log
+ *                             record in the current append page
+ *
+ * return: true if the room was reserved, false otherwise
+ *
+ *   length(in): Length of the body to reserve
+ *   reserve(out): The reservation
+ *
+ * NOTE: The body is reserved only when it and the log_rec header of the next
+ *       record fit in the current append page, so that logpb_end_append
+ *       does not need to move to a new page. The caller may then finish the
+ *       append, release LOG_CS and copy the body with
+ *       logpb_copy_reserved_data/logpb_copy_reserved_crumbs, followed by
+ *       logpb_end_reserved_append. When false is returned nothing has been
+ *       reserved and the body must be appended under LOG_CS as usual.
+ */
+bool
+logpb_reserve_append_data (THREAD_ENTRY * thread_p, int length,
+			   LOG_APPEND_RESERVATION * reserve)
+{
+  int end_offset;
+
+  assert (LOG_CS_OWN (thread_p));
+  assert (length > 0);
+
+  LOG_APPEND_ALIGN (thread_p, LOG_DONT_SET_DIRTY);
+
+  end_offset = DB_ALIGN (log_Gl.hdr.append_lsa.offset + length,
+			 DOUBLE_ALIGNMENT);
+  if (end_offset + (int) sizeof (struct log_rec) >= (int) LOGAREA_SIZE)
+    {
+      return false;
+    }
+
+  reserve->ptr = LOG_APPEND_PTR ();
+  reserve->length = length;
+
+  log_Gl.hdr.append_lsa.offset += length;
+  LOG_APPEND_ALIGN (thread_p, LOG_SET_DIRTY);
+
+  (void) ATOMIC_INC_32 (&log_Gl.append.num_copying, 1);
+
+  return true;
+}
+
+/*
+ * logpb_copy_reserved_data - Copy data into a reservation
+ *
+ * return: nothing
+ *
+ *   reserve(in/out): The reservation
+ *   length(in): Length of data to copy
+ *   data(in): Data to copy
+ *
+ * NOTE: Does not require LOG_CS. The data is glued the same way as
+ *       logpb_append_data does, aligning the reservation afterwards.
+ */
+void
+logpb_copy_reserved_data (LOG_APPEND_RESERVATION * reserve, int length,
+			  const char *data)
+{
+  int aligned_length;
+
+  if (length != 0 && data != NULL)
+    {
+      assert (length <= reserve->length);
+
+      memcpy (reserve->ptr, data, length);
+
+      aligned_length = MIN (DB_ALIGN (length, DOUBLE_ALIGNMENT),
+			    reserve->length);
+      reserve->ptr += aligned_length;
+      reserve->length -= aligned_length;
+    }
+}
+
+/*
+ * logpb_copy_reserved_crumbs - Copy crumbs of data into a reservation
+ *
+ * return: nothing
+ *
+ *   reserve(in/out): The reservation
+ *   num_crumbs(in): Number of crumbs
+ *   crumbs(in): The crumbs (length + data)
+ *
+ * NOTE: Does not require LOG_CS. The crumbs are glued the same way as
+ *       logpb_append_crumbs does, aligning the reservation afterwards.
+ */
+void
+logpb_copy_reserved_crumbs (LOG_APPEND_RESERVATION * reserve,
+			    int num_crumbs, const LOG_CRUMB * crumbs)
+{
+  int length = 0;
+  int aligned_length;
+  int i;
+
+  if (num_crumbs != 0)
+    {
+      for (i = 0; i < num_crumbs; i++)
+	{
+	  assert (length + crumbs[i].length <= reserve->length);
+
+	  memcpy (reserve->ptr + length, crumbs[i].data, crumbs[i].length);
+	  length += crumbs[i].length;
+	}
+
+      aligned_length = MIN (DB_ALIGN (length, DOUBLE_ALIGNMENT),
+			    reserve->length);
+      reserve->ptr += aligned_length;
+      reserve->length -= aligned_length;
+    }
+}
+
+/*
+ * logpb_end_reserved_append - Finish copying a reservation
+ *
+ * return: nothing
+ *
+ *   reserve(in/out): The reservation
+ *
+ * NOTE: Publishes the copied body. From here on the page may be flushed.
+ */
+void
+logpb_end_reserved_append (LOG_APPEND_RESERVATION * reserve)
+{
+  assert (reserve->length == 0);
+
+  reserve->ptr = NULL;
+
+  MEMORY_BARRIER ();
+  (void) ATOMIC_INC_32 (&log_Gl.append.num_copying, -1);
+}
+
+/*
+ * logpb_wait_for_reserved_copies - Wait until every reserved record body has
+ *                                  been copied
+ *
+ * return: nothing
+ *
+ * NOTE: The caller must hold LOG_CS (in either mode), so that no new
+ *       reservation can be made while waiting. Copiers never need LOG_CS,
+ *       thus the wait is bounded by a few memcpy calls.
+ */
+static void
+logpb_wait_for_reserved_copies (void)
+{
+#if defined(SERVER_MODE)
+  while (log_Gl.append.num_copying > 0)
+    {
+      thread_sleep (0, 10);
+    }
+
+  MEMORY_BARRIER ();
+#else /* SERVER_MODE */
+  assert (log_Gl.append.num_copying == 0);
+#endif /* SERVER_MODE */
+}
+
 #if defined (ENABLE_UNUSED_FUNCTION)
 /*
  * logpb_remove_append - Remove the appending of current log record
@@ -5147,7 +5414,8 @@ logpb_archive_active_log (THREAD_ENTRY * thread_p, bool force_archive)
 	  smallest_lsa.offset = 0;
 
 #if !defined(SERVER_MODE)
-	  pgbuf_flush_check_point (thread_p, &smallest_lsa, &newsmallest_lsa);
+	  pgbuf_flush_check_point (thread_p, &smallest_lsa, 0,
+				   &newsmallest_lsa);
 	  if (fileio_synchronize_all (thread_p, false) != NO_ERROR)
 	    {
 	      LSA_SET_NULL (&newsmallest_lsa);
@@ -5159,7 +5427,7 @@ logpb_archive_active_log (THREAD_ENTRY * thread_p, bool force_archive)
 	   */
 	  if (!BO_IS_SERVER_RESTARTED ())
 	    {
-	      pgbuf_flush_check_point (thread_p, &smallest_lsa,
+	      pgbuf_flush_check_point (thread_p, &smallest_lsa, 0,
 				       &newsmallest_lsa);
 	      if (fileio_synchronize_all (thread_p, false) != NO_ERROR)
 		{
@@ -5682,7 +5950,8 @@ logpb_remove_archive_to_page_id (THREAD_ENTRY * thread_p,
   flush_upto_lsa.pageid = LOGPB_NEXT_ARCHIVE_PAGE_ID;
   flush_upto_lsa.offset = NULL_OFFSET;
 
-  pgbuf_flush_check_point (thread_p, &flush_upto_lsa, &newflush_upto_lsa);
+  pgbuf_flush_check_point (thread_p, &flush_upto_lsa, 0,
+			   &newflush_upto_lsa);
 
   if ((!LSA_ISNULL (&newflush_upto_lsa)
        && LSA_LT (&newflush_upto_lsa, &flush_upto_lsa))
@@ -6325,6 +6594,7 @@ logpb_checkpoint (THREAD_ENTRY * thread_p)
   int rv;
 #endif /* SERVER_MODE */
   int error_code = NO_ERROR;
+  int spread_msec = 0;
   LOG_FLUSH_INFO *flush_info = &log_Gl.flush_info;
 
   LOG_CS_ENTER (thread_p);
@@ -6418,8 +6688,21 @@ logpb_checkpoint (THREAD_ENTRY * thread_p)
 
   er_log_debug (ARG_FILE_LINE,
 		"logpb_checkpoint: call pbbuf_flush_check_point()\n");
-  pgbuf_flush_victim_candidate (thread_p, PGBUF_VICTIM_FLUSH_MAX_RATIO);
-  pgbuf_flush_check_point (thread_p, &flush_upto_lsa, &tmp_chkpt.redo_lsa);
+  pgbuf_flush_victim_candidate (thread_p, PGBUF_VICTIM_FLUSH_MAX_RATIO,
+				0, 1);
+
+#if defined(SERVER_MODE)
+  /* The checkpoint daemon spreads the data page writes over the checkpoint
+   * interval. Other callers (restart, shutdown) flush without pacing. */
+  if (thread_p != NULL && thread_p->type == TT_DAEMON)
+    {
+      /* the interval has no upper bound; keep it from overflowing */
+      spread_msec = (int) MIN ((INT64) PRM_LOG_CHECKPOINT_INTERVAL_MINUTES
+			       * 60 * 1000, INT_MAX);
+    }
+#endif /* SERVER_MODE */
+  pgbuf_flush_check_point (thread_p, &flush_upto_lsa, spread_msec,
+			   &tmp_chkpt.redo_lsa);
 
   er_log_debug (ARG_FILE_LINE,
 		"logpb_checkpoint: call fileio_synchronize_all()\n");
@@ -6432,7 +6715,10 @@ logpb_checkpoint (THREAD_ENTRY * thread_p)
   LOG_CS_ENTER (thread_p);
   flush_info->flush_type = LOG_FLUSH_DIRECT;
 
-  if (LSA_ISNULL (&tmp_chkpt.redo_lsa))
+  /* pages dirtied while the data pages were flushed are not known to the
+   * flush, so the redo never starts after the checkpoint record */
+  if (LSA_ISNULL (&tmp_chkpt.redo_lsa)
+      || LSA_GT (&tmp_chkpt.redo_lsa, &newchkpt_lsa))
     {
       LSA_COPY (&tmp_chkpt.redo_lsa, &newchkpt_lsa);
     }
@@ -10225,7 +10511,7 @@ logpb_fatal_error (THREAD_ENTRY * thread_p, bool logexit,
 	   * Flush as much as you can without forcing the current unfinish log
 	   * record.
 	   */
-	  pgbuf_flush_check_point (thread_p, &tmp_lsa1, &tmp_lsa2);
+	  pgbuf_flush_check_point (thread_p, &tmp_lsa1, 0, &tmp_lsa2);
 	  infatal = false;
 	}
     }